@@ -0,0 +1,200 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Merged view of the statistics of an allocation_telemetry at one point in time.
+ *
+ *              Bucket i of a histogram counts the values in (2^(i-1), 2^i]; the last bucket also
+ *              counts everything larger.
+ */
+struct allocation_snapshot
+{
+    constexpr static const std::size_t histogram_buckets = 48;
+    using HistogramType = std::array<std::uint64_t, histogram_buckets>;
+
+    std::string   name;
+    std::uint64_t allocations      = 0;
+    std::uint64_t deallocations    = 0;
+    std::uint64_t allocatedBytes   = 0;
+    std::uint64_t deallocatedBytes = 0;
+    std::uint64_t liveBytes        = 0;
+    std::uint64_t peakBytes        = 0;
+
+    /* Requested sizes, in bytes */
+    HistogramType sizeHistogram{};
+
+    /* Time between allocation and deallocation of the sampled allocations, in nanoseconds */
+    HistogramType lifetimeHistogram{};
+    std::uint64_t lifetimeSamples = 0;
+    std::uint64_t lifetimeSumNs   = 0;
+
+    [[nodiscard]] std::string to_json() const;
+    [[nodiscard]] std::string to_prometheus() const;
+};
+
+
+/**
+ * \brief       Allocation statistics of a group of containers, such as those of one element type or
+ *              of one subsystem, fed by instrumented_allocator.
+ *
+ *              Each thread records into its own cache-line aligned shard, with plain loads and
+ *              stores instead of read-modify-writes, so recording never contends. The shards are
+ *              only merged when a snapshot is taken. Live bytes are also cached per thread and
+ *              folded into a shared counter once they drift by flush_threshold bytes, which bounds
+ *              how far the peak can be under-estimated to flush_threshold bytes per thread.
+ *              Lifetimes are timed for about one allocation in lifetime_sample_period per thread,
+ *              where each sample_page_size bytes requested count as one more allocation, so that
+ *              the rare large blocks are still sampled.
+ */
+class allocation_telemetry
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType      = std::size_t;
+    using TimestampType = std::uint64_t;
+
+    constexpr static const SizeType      max_threads            = 256;
+    constexpr static const std::int64_t  lifetime_sample_period = 64;
+    constexpr static const SizeType      sample_page_size       = 4096;
+    constexpr static const std::int64_t  flush_threshold        = std::int64_t{256} * 1024;
+    constexpr static const SizeType histogram_buckets = allocation_snapshot::histogram_buckets;
+
+    /* Timestamp of an allocation whose lifetime is not sampled */
+    constexpr static const TimestampType unsampled = 0;
+
+private:
+    using CounterType = std::atomic<std::uint64_t>;
+
+    struct alignas(cache_line_size) shard
+    {
+        CounterType               deallocations{0};
+        CounterType               allocatedBytes{0};
+        CounterType               deallocatedBytes{0};
+        CounterType               lifetimeSamples{0};
+        CounterType               lifetimeSumNs{0};
+        std::atomic<std::int64_t> flushedBytes{0};
+        std::atomic<std::int64_t> sampleCountdown{lifetime_sample_period};
+
+        std::array<CounterType, histogram_buckets> sizeHistogram{};
+        std::array<CounterType, histogram_buckets> lifetimeHistogram{};
+    };
+
+    struct thread_registration
+    {
+        ~thread_registration();
+    };
+
+    /* Index of the shard shared, with read-modify-writes, by the threads that found none free */
+    constexpr static const SizeType shared_index = max_threads;
+    constexpr static const SizeType no_index     = max_threads + 1;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit allocation_telemetry(std::string name_);
+    ~allocation_telemetry();
+
+    allocation_telemetry(const allocation_telemetry&) = delete;
+    allocation_telemetry& operator=(const allocation_telemetry&) = delete;
+    allocation_telemetry(allocation_telemetry&&)                 = delete;
+    allocation_telemetry& operator=(allocation_telemetry&&) = delete;
+
+    [[nodiscard]] static allocation_telemetry& global();
+
+
+    /*********************************************************************************************/
+    /* Recording ------------------------------------------------------------------------------- */
+    [[nodiscard]] TimestampType record_allocation(SizeType bytes_) noexcept;
+    void                        record_untimed_allocation(SizeType bytes_) noexcept;
+    void record_deallocation(SizeType bytes_, TimestampType timestamp_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Reporting ------------------------------------------------------------------------------- */
+    [[nodiscard]] const std::string&  name() const noexcept;
+    [[nodiscard]] allocation_snapshot snapshot() const;
+
+    void export_json(const std::filesystem::path& path_) const;
+    void export_prometheus(const std::filesystem::path& path_) const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] shard* count_allocation(SizeType bytes_) noexcept;
+    [[nodiscard]] shard* local_shard(SizeType index_) noexcept;
+    [[nodiscard]] shard* create_shard(SizeType index_) noexcept;
+    void                 flush(shard& shard_) noexcept;
+    void                 add_live_bytes(std::int64_t bytes_) noexcept;
+
+    [[nodiscard]] static SizeType      thread_index() noexcept;
+    [[nodiscard]] static SizeType&     local_index() noexcept;
+    [[nodiscard]] static TimestampType now() noexcept;
+    [[nodiscard]] static SizeType      bucket(std::uint64_t value_) noexcept;
+    static void bump(CounterType& counter_, std::uint64_t value_, bool isShared_) noexcept;
+    static void write_file(const std::filesystem::path& path_, const std::string& contents_);
+
+    [[nodiscard]] static std::array<std::atomic<bool>, max_threads>& owned_indices() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::string m_name;
+
+    /* One shard per thread index, created by the first thread using it, plus the shared one */
+    std::array<std::atomic<shard*>, max_threads + 1> m_shards{};
+
+    alignas(cache_line_size) std::atomic<std::int64_t> m_liveBytes{0};
+    std::atomic<std::int64_t> m_peakBytes{0};
+};
+
+
+}        // namespace pel
+
+#include "./allocation_telemetry.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
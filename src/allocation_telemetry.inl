@@ -0,0 +1,698 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./allocation_telemetry.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define ALLOCATION_TELEMETRY_CLASS_SCOPE__ allocation_telemetry
+#define ALLOCATION_SNAPSHOT_CLASS_SCOPE__  allocation_snapshot
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty set of statistics.
+ *              Must outlive every allocation recorded into it.
+ *
+ * \param       name_: Name under which the statistics are exported.
+ *************************************************************************************************/
+inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::allocation_telemetry(std::string name_)
+: m_name{std::move(name_)}
+{
+}
+
+
+inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::~allocation_telemetry()
+{
+    for(std::atomic<shard*>& slot : m_shards)
+    {
+        delete slot.load(std::memory_order_acquire);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the statistics used by default-constructed instrumented allocators.
+ *************************************************************************************************/
+[[nodiscard]] inline allocation_telemetry&
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::global()
+{
+    static allocation_telemetry telemetry("global");
+    return telemetry;
+}
+
+
+
+/*************************************************************************************************/
+/* RECORDING ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Record an allocation on the calling thread's shard, and decide whether its lifetime
+ *              is sampled.
+ *
+ * \param       bytes_: Size requested by the container, in bytes.
+ *
+ * \retval      TimestampType: Time of the allocation if its lifetime is sampled, unsampled
+ *                             otherwise. To be given back to record_deallocation().
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::TimestampType
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::record_allocation(SizeType bytes_) noexcept
+{
+    shard* local = count_allocation(bytes_);
+    if(local == nullptr)
+    {
+        return unsampled;
+    }
+
+    /* A data race on the countdown of the shared shard only shifts which allocation is sampled */
+    const std::int64_t countdown = local->sampleCountdown.load(std::memory_order_relaxed) - 1
+                                   - static_cast<std::int64_t>(bytes_ / sample_page_size);
+    if(countdown > 0)
+    {
+        local->sampleCountdown.store(countdown, std::memory_order_relaxed);
+        return unsampled;
+    }
+    local->sampleCountdown.store(lifetime_sample_period, std::memory_order_relaxed);
+    return now();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Record an allocation whose lifetime is never sampled, which spares the countdown
+ *              and the clock reads.
+ *              Its deallocation is recorded with unsampled as timestamp.
+ *
+ * \param       bytes_: Size requested by the container, in bytes.
+ *************************************************************************************************/
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::record_untimed_allocation(SizeType bytes_) noexcept
+{
+    static_cast<void>(count_allocation(bytes_));
+}
+
+
+
+/*************************************************************************************************/
+/* STATISTICS ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Record a deallocation on the calling thread's shard, which need not be the one that
+ *              recorded the allocation.
+ *
+ * \param       bytes_:     Size given to record_allocation().
+ * \param       timestamp_: Value returned by record_allocation().
+ *************************************************************************************************/
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::record_deallocation(SizeType      bytes_,
+                                                        TimestampType timestamp_) noexcept
+{
+    const SizeType index = thread_index();
+    shard*         local = local_shard(index);
+    if(local == nullptr)
+    {
+        return;
+    }
+
+    const bool isShared = index == shared_index;
+    bump(local->deallocations, 1, isShared);
+    bump(local->deallocatedBytes, bytes_, isShared);
+
+    if(isShared)
+    {
+        add_live_bytes(-static_cast<std::int64_t>(bytes_));
+    }
+    else
+    {
+        flush(*local);
+    }
+
+    if(timestamp_ != unsampled)
+    {
+        const TimestampType current  = now();
+        const std::uint64_t lifetime = current > timestamp_ ? current - timestamp_ : 0;
+        bump(local->lifetimeSamples, 1, isShared);
+        bump(local->lifetimeSumNs, lifetime, isShared);
+        bump(local->lifetimeHistogram[bucket(lifetime)], 1, isShared);
+    }
+}
+
+
+[[nodiscard]] inline const std::string&
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::name() const noexcept
+{
+    return m_name;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Merge the shards of every thread.
+ *              Recording threads are not stopped, so the counters of a snapshot taken while they
+ *              run may be a few operations apart from each other.
+ *************************************************************************************************/
+[[nodiscard]] inline allocation_snapshot
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::snapshot() const
+{
+    allocation_snapshot merged;
+    merged.name = m_name;
+
+    for(const std::atomic<shard*>& slot : m_shards)
+    {
+        const shard* current = slot.load(std::memory_order_acquire);
+        if(current == nullptr)
+        {
+            continue;
+        }
+
+        merged.deallocations += current->deallocations.load(std::memory_order_relaxed);
+        merged.allocatedBytes += current->allocatedBytes.load(std::memory_order_relaxed);
+        merged.deallocatedBytes += current->deallocatedBytes.load(std::memory_order_relaxed);
+        merged.lifetimeSamples += current->lifetimeSamples.load(std::memory_order_relaxed);
+        merged.lifetimeSumNs += current->lifetimeSumNs.load(std::memory_order_relaxed);
+        for(SizeType i = 0; i < histogram_buckets; ++i)
+        {
+            merged.sizeHistogram[i] += current->sizeHistogram[i].load(std::memory_order_relaxed);
+            merged.lifetimeHistogram[i] +=
+              current->lifetimeHistogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    /* Every allocation is counted in exactly one bucket, which saves a counter when recording */
+    for(const std::uint64_t count : merged.sizeHistogram)
+    {
+        merged.allocations += count;
+    }
+
+    /* Memory freed by another thread than the one that allocated it can be seen first */
+    merged.liveBytes = merged.allocatedBytes > merged.deallocatedBytes
+                         ? merged.allocatedBytes - merged.deallocatedBytes
+                         : 0;
+    const std::int64_t peak = m_peakBytes.load(std::memory_order_relaxed);
+    merged.peakBytes        = std::max(static_cast<std::uint64_t>(std::max<std::int64_t>(peak, 0)),
+                                merged.liveBytes);
+    return merged;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write a snapshot to a file as a JSON object.
+ *              The file is replaced atomically, so readers never see it half-written.
+ *
+ * \throws      std::runtime_error("Could not write telemetry file")
+ *************************************************************************************************/
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::export_json(const std::filesystem::path& path_) const
+{
+    write_file(path_, snapshot().to_json());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write a snapshot to a file in the Prometheus text exposition format, for example
+ *              for the textfile collector of the node exporter.
+ *              The file is replaced atomically, so readers never see it half-written.
+ *
+ * \throws      std::runtime_error("Could not write telemetry file")
+ *************************************************************************************************/
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::export_prometheus(const std::filesystem::path& path_) const
+{
+    write_file(path_, snapshot().to_prometheus());
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Add an allocation to the byte counters and the size histogram.
+ *
+ * \retval      shard*: Shard the allocation was recorded on, null if it went unrecorded.
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::shard*
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::count_allocation(SizeType bytes_) noexcept
+{
+    const SizeType index = thread_index();
+    shard*         local = local_shard(index);
+    if(local == nullptr)
+    {
+        return nullptr;
+    }
+
+    const bool isShared = index == shared_index;
+    bump(local->allocatedBytes, bytes_, isShared);
+    bump(local->sizeHistogram[bucket(bytes_)], 1, isShared);
+
+    if(isShared)
+    {
+        add_live_bytes(static_cast<std::int64_t>(bytes_));
+    }
+    else
+    {
+        flush(*local);
+    }
+    return local;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the shard of the calling thread's index, creating it on first use.
+ *
+ * \retval      shard*: Null only if the shard could not be allocated, in which case the operation
+ *                      goes unrecorded.
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::shard*
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::local_shard(SizeType index_) noexcept
+{
+    shard* current = m_shards[index_].load(std::memory_order_acquire);
+    return current != nullptr ? current : create_shard(index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create the shard of a thread index.
+ *              The shared index can be used by several threads at once, so creating it can race.
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::shard*
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::create_shard(SizeType index_) noexcept
+{
+    shard* created = new(std::nothrow) shard;
+    if(created == nullptr)
+    {
+        return nullptr;
+    }
+
+    shard* expected = nullptr;
+    if(m_shards[index_].compare_exchange_strong(
+         expected, created, std::memory_order_acq_rel, std::memory_order_acquire)
+       == false)
+    {
+        delete created;
+        return expected;
+    }
+    return created;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Fold the bytes a thread allocated or freed since it last did into the shared live
+ *              counter, once they drifted by flush_threshold either way.
+ *              The drift is derived from the byte counters, so recording keeps no extra state.
+ *************************************************************************************************/
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::flush(shard& shard_) noexcept
+{
+    const std::uint64_t net = shard_.allocatedBytes.load(std::memory_order_relaxed)
+                              - shard_.deallocatedBytes.load(std::memory_order_relaxed);
+    const std::int64_t flushed = shard_.flushedBytes.load(std::memory_order_relaxed);
+    const std::int64_t drift   = static_cast<std::int64_t>(net) - flushed;
+    if(drift >= flush_threshold || drift <= -flush_threshold)
+    {
+        add_live_bytes(drift);
+        shard_.flushedBytes.store(flushed + drift, std::memory_order_relaxed);
+    }
+}
+
+
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::add_live_bytes(std::int64_t bytes_) noexcept
+{
+    const std::int64_t live = m_liveBytes.fetch_add(bytes_, std::memory_order_relaxed) + bytes_;
+
+    std::int64_t peak = m_peakBytes.load(std::memory_order_relaxed);
+    while(live > peak
+          && m_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed) == false)
+    {
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the calling thread's index, claiming a free one on first use.
+ *              The index is handed back when the thread exits; threads that find none free, or
+ *              that allocate while exiting, use the shared index.
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::SizeType
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::thread_index() noexcept
+{
+    SizeType& index = local_index();
+    if(index != no_index)
+    {
+        return index;
+    }
+
+    index = shared_index;
+    for(SizeType i = 0; i < max_threads; ++i)
+    {
+        std::atomic<bool>& isOwned = owned_indices()[i];
+        bool               expected = false;
+        if(isOwned.load(std::memory_order_relaxed) == false
+           && isOwned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if(index != shared_index)
+    {
+        static thread_local thread_registration registration;
+        static_cast<void>(registration);
+    }
+    return index;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Hand the thread's index back, and record anything it still does in the shared
+ *              shard.
+ *************************************************************************************************/
+inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::thread_registration::~thread_registration()
+{
+    SizeType& index = local_index();
+
+    /* Release, so that the next owner of the index sees every counter written here */
+    owned_indices()[index].store(false, std::memory_order_release);
+    index = shared_index;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the calling thread's index, or no_index before it claimed one.
+ *              Trivially destructible, so that it stays usable after the registration is destroyed.
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::SizeType&
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::local_index() noexcept
+{
+    static thread_local SizeType index = no_index;
+    return index;
+}
+
+
+[[nodiscard]] inline std::array<std::atomic<bool>, ALLOCATION_TELEMETRY_CLASS_SCOPE__::max_threads>&
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::owned_indices() noexcept
+{
+    static std::array<std::atomic<bool>, max_threads> indices{};
+    return indices;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Read the clock timing lifetimes, in nanoseconds. Never returns unsampled.
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::TimestampType
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::now() noexcept
+{
+    const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    const auto ticks   = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    return std::max<TimestampType>(static_cast<TimestampType>(ticks), unsampled + 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the histogram bucket of a value: i for values in (2^(i-1), 2^i].
+ *************************************************************************************************/
+[[nodiscard]] inline ALLOCATION_TELEMETRY_CLASS_SCOPE__::SizeType
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::bucket(std::uint64_t value_) noexcept
+{
+    return std::min<SizeType>(std::bit_width(value_ <= 1 ? 0 : value_ - 1), histogram_buckets - 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Add to a counter of a shard.
+ *              A thread's own shard only has one writer, so a load and a store are enough; the
+ *              shared shard needs a read-modify-write.
+ *************************************************************************************************/
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::bump(CounterType&  counter_,
+                                         std::uint64_t value_,
+                                         bool          isShared_) noexcept
+{
+    if(isShared_)
+    {
+        counter_.fetch_add(value_, std::memory_order_relaxed);
+    }
+    else
+    {
+        counter_.store(counter_.load(std::memory_order_relaxed) + value_,
+                       std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace a file by writing a temporary file next to it, then renaming it.
+ *
+ * \throws      std::runtime_error("Could not write telemetry file")
+ *************************************************************************************************/
+inline void
+ALLOCATION_TELEMETRY_CLASS_SCOPE__::write_file(const std::filesystem::path& path_,
+                                               const std::string&           contents_)
+{
+    std::filesystem::path temporary = path_;
+    temporary += ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << contents_;
+        file.close();
+        if(file.fail())
+        {
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            throw std::runtime_error("Could not write telemetry file");
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path_, error);
+    if(error)
+    {
+        std::filesystem::remove(temporary, error);
+        throw std::runtime_error("Could not write telemetry file");
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* ALLOCATION SNAPSHOT ------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the snapshot as a JSON object.
+ *              Histograms are arrays of counts, bucket i counting the values in (2^(i-1), 2^i].
+ *************************************************************************************************/
+[[nodiscard]] inline std::string
+ALLOCATION_SNAPSHOT_CLASS_SCOPE__::to_json() const
+{
+    std::ostringstream stream;
+
+    stream << "{\"name\":\"";
+    for(const char character : name)
+    {
+        if(character == '"' || character == '\\')
+        {
+            stream << '\\' << character;
+        }
+        else if(static_cast<unsigned char>(character) < 0x20)
+        {
+            constexpr const char* digits = "0123456789abcdef";
+            stream << "\\u00" << digits[(character >> 4) & 0xF] << digits[character & 0xF];
+        }
+        else
+        {
+            stream << character;
+        }
+    }
+
+    const auto writeHistogram = [&stream](const HistogramType& histogram_) {
+        stream << '[';
+        for(std::size_t i = 0; i < histogram_buckets; ++i)
+        {
+            stream << (i == 0 ? "" : ",") << histogram_[i];
+        }
+        stream << ']';
+    };
+
+    stream << "\",\"allocations\":" << allocations << ",\"deallocations\":" << deallocations
+           << ",\"allocated_bytes\":" << allocatedBytes
+           << ",\"deallocated_bytes\":" << deallocatedBytes << ",\"live_bytes\":" << liveBytes
+           << ",\"peak_bytes\":" << peakBytes << ",\"size_histogram\":";
+    writeHistogram(sizeHistogram);
+    stream << ",\"lifetime_samples\":" << lifetimeSamples
+           << ",\"lifetime_sum_ns\":" << lifetimeSumNs << ",\"lifetime_histogram_ns\":";
+    writeHistogram(lifetimeHistogram);
+    stream << '}';
+
+    return stream.str();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the snapshot in the Prometheus text exposition format.
+ *              Every metric is labeled with the name of the telemetry; sizes are in bytes and
+ *              lifetimes in seconds.
+ *************************************************************************************************/
+[[nodiscard]] inline std::string
+ALLOCATION_SNAPSHOT_CLASS_SCOPE__::to_prometheus() const
+{
+    std::string label = "{telemetry=\"";
+    for(const char character : name)
+    {
+        if(character == '\n')
+        {
+            label += "\\n";
+            continue;
+        }
+        if(character == '"' || character == '\\')
+        {
+            label += '\\';
+        }
+        label += character;
+    }
+    label += '"';
+
+    const auto toString = [](double value_) {
+        char buffer[32];
+        return std::string(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value_).ptr);
+    };
+
+    std::ostringstream stream;
+    const auto         writeMetric = [&stream, &label](const char* metric_,
+                                               const char* type_,
+                                               const char* help_,
+                                               std::uint64_t value_) {
+        stream << "# HELP " << metric_ << ' ' << help_ << "\n# TYPE " << metric_ << ' ' << type_
+               << '\n'
+               << metric_ << label << "} " << value_ << '\n';
+    };
+    const auto writeHistogram = [&stream, &label](const char*          metric_,
+                                                  const char*          help_,
+                                                  const HistogramType& histogram_,
+                                                  const auto&          bound_,
+                                                  const std::string&   sum_) {
+        stream << "# HELP " << metric_ << ' ' << help_ << "\n# TYPE " << metric_
+               << " histogram\n";
+
+        /* The last bucket also holds larger values, so it is only reported under +Inf */
+        std::uint64_t cumulative = 0;
+        for(std::size_t i = 0; i + 1 < histogram_buckets; ++i)
+        {
+            cumulative += histogram_[i];
+            stream << metric_ << "_bucket" << label << ",le=\"" << bound_(i) << "\"} "
+                   << cumulative << '\n';
+        }
+        cumulative += histogram_[histogram_buckets - 1];
+        stream << metric_ << "_bucket" << label << ",le=\"+Inf\"} " << cumulative << '\n'
+               << metric_ << "_sum" << label << "} " << sum_ << '\n'
+               << metric_ << "_count" << label << "} " << cumulative << '\n';
+    };
+
+    writeMetric("pel_allocations_total", "counter", "Number of allocations.", allocations);
+    writeMetric("pel_deallocations_total", "counter", "Number of deallocations.", deallocations);
+    writeMetric(
+      "pel_allocated_bytes_total", "counter", "Bytes requested by allocations.", allocatedBytes);
+    writeMetric("pel_deallocated_bytes_total",
+                "counter",
+                "Bytes given back by deallocations.",
+                deallocatedBytes);
+    writeMetric("pel_live_bytes", "gauge", "Bytes currently allocated.", liveBytes);
+    writeMetric("pel_peak_bytes", "gauge", "Highest number of bytes allocated at once.", peakBytes);
+
+    writeHistogram(
+      "pel_allocation_size_bytes",
+      "Size of the allocations.",
+      sizeHistogram,
+      [](std::size_t i_) { return std::uint64_t{1} << i_; },
+      std::to_string(allocatedBytes));
+    writeHistogram(
+      "pel_allocation_lifetime_seconds",
+      "Time between allocation and deallocation, for a sample of the allocations.",
+      lifetimeHistogram,
+      [&toString](std::size_t i_) {
+          return toString(static_cast<double>(std::uint64_t{1} << i_) / 1e9);
+      },
+      toString(static_cast<double>(lifetimeSumNs) / 1e9));
+
+    return stream.str();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef ALLOCATION_TELEMETRY_CLASS_SCOPE__
+#undef ALLOCATION_SNAPSHOT_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
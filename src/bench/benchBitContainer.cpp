@@ -0,0 +1,198 @@
+/**
+ * @file    container_base/src/bench/benchBitContainer.cpp
+ *
+ * Random bit reads, population counts, bitwise and, and walks over the set bits of a sparse set in
+ * bit_container against std::vector<bool> and std::bitset, across sizes, followed by the cost of
+ * rank and select queries through bit_rank_index.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/bit_container.hpp"
+#include "src/bit_rank_index.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* Whole-container operations process about this many bits per measurement */
+constexpr std::size_t processed_bits = std::size_t{1} << 28;
+constexpr std::size_t lookup_count   = std::size_t{1} << 22;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+template<typename BitsType>
+void
+fill(BitsType& bits_, std::size_t length_, std::uint64_t percent_, std::uint64_t seed_)
+{
+    for(std::size_t i = 0; i < length_; ++i)
+    {
+        bits_[i] = split_mix(seed_) % 100 < percent_;
+    }
+}
+
+/* Print the three contenders of one operation, std::vector<bool> being the baseline */
+void
+print_results(const std::string& operation_,
+              double             vector_,
+              double             bitset_,
+              double             packed_,
+              std::size_t        operations_)
+{
+    pel::bench::print_result("std::vector<bool>, " + operation_, vector_, operations_);
+    pel::bench::print_result("std::bitset,       " + operation_, bitset_, operations_, vector_);
+    pel::bench::print_result("bit_container,     " + operation_, packed_, operations_, vector_);
+}
+
+template<std::size_t Bits>
+void
+run()
+{
+    pel::bench::print_title(std::to_string(Bits) + " bits, per bit or per lookup");
+
+    const std::size_t rounds = std::max<std::size_t>(processed_bits / Bits, 1);
+    const std::size_t total  = rounds * Bits;
+
+    /* Half of the bits set for the dense operations, one in a hundred for the walks */
+    std::vector<bool>    vector(Bits), otherVector(Bits), sparseVector(Bits);
+    auto                 bitset       = std::make_unique<std::bitset<Bits>>();
+    auto                 otherBitset  = std::make_unique<std::bitset<Bits>>();
+    auto                 sparseBitset = std::make_unique<std::bitset<Bits>>();
+    pel::bit_container<> packed(Bits), otherPacked(Bits), sparsePacked(Bits);
+    fill(vector, Bits, 50, 1);
+    fill(*bitset, Bits, 50, 1);
+    fill(packed, Bits, 50, 1);
+    fill(otherVector, Bits, 50, 2);
+    fill(*otherBitset, Bits, 50, 2);
+    fill(otherPacked, Bits, 50, 2);
+    fill(sparseVector, Bits, 1, 3);
+    fill(*sparseBitset, Bits, 1, 3);
+    fill(sparsePacked, Bits, 1, 3);
+
+    std::uint64_t            state = 4;
+    std::vector<std::size_t> indices(lookup_count);
+    for(std::size_t& index : indices)
+    {
+        index = split_mix(state) % Bits;
+    }
+    const auto lookups = [&indices](const auto& bits_) {
+        return pel::bench::best_of(3, [&]() {
+            std::size_t found = 0;
+            for(const std::size_t index : indices)
+            {
+                found += bits_[index] ? 1U : 0U;
+            }
+            pel::bench::do_not_optimize(found);
+        });
+    };
+    print_results("random read", lookups(vector), lookups(*bitset), lookups(packed), lookup_count);
+
+    const auto repeat = [rounds](auto&& pass_) {
+        return pel::bench::best_of(3, [&]() {
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                pass_();
+            }
+        });
+    };
+    print_results(
+      "count",
+      repeat([&]() {
+          pel::bench::do_not_optimize(std::count(vector.begin(), vector.end(), true));
+      }),
+      repeat([&]() { pel::bench::do_not_optimize(bitset->count()); }),
+      repeat([&]() { pel::bench::do_not_optimize(packed.count()); }),
+      total);
+
+    print_results(
+      "and",
+      repeat([&]() {
+          for(std::size_t i = 0; i < Bits; ++i)
+          {
+              vector[i] = vector[i] && otherVector[i];
+          }
+          pel::bench::do_not_optimize(vector);
+      }),
+      repeat([&]() {
+          *bitset &= *otherBitset;
+          pel::bench::do_not_optimize(*bitset);
+      }),
+      repeat([&]() {
+          packed &= otherPacked;
+          pel::bench::do_not_optimize(packed);
+      }),
+      total);
+
+    /* Neither standard container can skip empty words: test every bit */
+    const auto walk = [&](const auto& bits_) {
+        return repeat([&]() {
+            std::size_t sum = 0;
+            for(std::size_t i = 0; i < Bits; ++i)
+            {
+                sum += bits_[i] ? i : 0;
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+    };
+    print_results("walk set bits (1%)",
+                  walk(sparseVector),
+                  walk(*sparseBitset),
+                  repeat([&]() {
+                      std::size_t sum = 0;
+                      for(std::size_t i = sparsePacked.find_first(); i < Bits;
+                          i             = sparsePacked.find_next(i))
+                      {
+                          sum += i;
+                      }
+                      pel::bench::do_not_optimize(sum);
+                  }),
+                  total);
+
+    const pel::bit_rank_index<pel::bit_container<>> index(packed);
+    const double rank = pel::bench::best_of(3, [&]() {
+        std::size_t sum = 0;
+        for(const std::size_t position : indices)
+        {
+            sum += index.rank(position);
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    std::vector<std::size_t> ranks(lookup_count);
+    for(std::size_t& target : ranks)
+    {
+        target = split_mix(state) % index.count();
+    }
+    const double select = pel::bench::best_of(3, [&]() {
+        std::size_t sum = 0;
+        for(const std::size_t target : ranks)
+        {
+            sum += index.select(target);
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    pel::bench::print_result("bit_rank_index, rank", rank, lookup_count);
+    pel::bench::print_result("bit_rank_index, select", select, lookup_count);
+}
+}        // namespace
+
+int
+main()
+{
+    run<std::size_t{1} << 12>();
+    run<std::size_t{1} << 16>();
+    run<std::size_t{1} << 20>();
+    run<std::size_t{1} << 24>();
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file    container_base/src/bench/benchBtreeMap.cpp
+ *
+ * Random and ascending insertion, random lookups, in-order scans and random erasure in btree_map
+ * against std::map, from maps that fit in L1 to maps much larger than the last-level cache.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/btree_map.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* Every measurement performs about this many operations */
+constexpr std::size_t operation_count = std::size_t{1} << 20;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+template<typename MapType>
+void
+measure(const char*                       label_,
+        const std::vector<std::uint64_t>& keys_,
+        const std::vector<std::uint64_t>& sortedKeys_,
+        std::array<double, 5>&            baseline_)
+{
+    const std::size_t rounds = std::max<std::size_t>(operation_count / keys_.size(), 1);
+    const std::size_t total  = rounds * keys_.size();
+
+    const auto fill = [](const std::vector<std::uint64_t>& order_, std::size_t rounds_) {
+        for(std::size_t r = 0; r < rounds_; ++r)
+        {
+            MapType map;
+            for(const std::uint64_t key : order_)
+            {
+                map.try_emplace(key, key);
+            }
+            pel::bench::do_not_optimize(map);
+        }
+    };
+    const double randomInsert    = pel::bench::best_of(3, [&]() { fill(keys_, rounds); });
+    const double ascendingInsert = pel::bench::best_of(3, [&]() { fill(sortedKeys_, rounds); });
+
+    MapType map;
+    for(const std::uint64_t key : keys_)
+    {
+        map.try_emplace(key, key);
+    }
+
+    const double find = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            for(const std::uint64_t key : keys_)
+            {
+                sum += map.find(key)->second;
+            }
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    const double scan = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            for(const auto& [key, value] : map)
+            {
+                sum += value;
+            }
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    const double erase = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            MapType copy = map;
+            for(const std::uint64_t key : keys_)
+            {
+                copy.erase(key);
+            }
+            pel::bench::do_not_optimize(copy);
+        }
+    });
+
+    const std::array<double, 5> results{randomInsert, ascendingInsert, find, scan, erase};
+    const bool                  isBaseline = baseline_[0] == 0.0;
+    if(isBaseline)
+    {
+        baseline_ = results;
+    }
+
+    constexpr std::array<const char*, 5> names{
+      " insert (random)", " insert (ascending)", " find", " scan", " copy + erase all"};
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        pel::bench::print_result(std::string(label_) + names[i],
+                                 results[i],
+                                 total,
+                                 isBaseline ? 0.0 : baseline_[i]);
+    }
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 4>{256, 4096, 65536, 1048576})
+    {
+        pel::bench::print_title(std::to_string(size) + " keys, per element");
+
+        std::uint64_t              state = 1;
+        std::vector<std::uint64_t> keys(size);
+        for(std::uint64_t& key : keys)
+        {
+            key = split_mix(state);
+        }
+        std::vector<std::uint64_t> sortedKeys = keys;
+        std::sort(sortedKeys.begin(), sortedKeys.end());
+
+        std::array<double, 5> baseline{};
+        measure<std::map<std::uint64_t, std::uint64_t>>("std::map ", keys, sortedKeys, baseline);
+        measure<pel::btree_map<std::uint64_t, std::uint64_t>>(
+          "btree_map", keys, sortedKeys, baseline);
+    }
+    return 0;
+}
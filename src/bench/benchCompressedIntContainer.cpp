@@ -0,0 +1,169 @@
+/**
+ * @file    container_base/src/bench/benchCompressedIntContainer.cpp
+ *
+ * Memory use, building, full scans (through the iterator and block by block) and random reads of
+ * compressed_int_container against an uncompressed std::vector, for integer sequences that
+ * compress well, poorly, and not at all.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/compressed_int_container.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t value_count  = std::size_t{1} << 22;
+constexpr std::size_t lookup_count = std::size_t{1} << 20;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+template<typename IntegerType>
+void
+measure(const std::string& title_, const std::vector<IntegerType>& values_)
+{
+    pel::bench::print_title(title_ + ", per value");
+
+    using compressed = pel::compressed_int_container<IntegerType>;
+
+    const double vectorBuild = pel::bench::best_of(3, [&]() {
+        std::vector<IntegerType> copy;
+        for(const IntegerType value : values_)
+        {
+            copy.push_back(value);
+        }
+        pel::bench::do_not_optimize(copy);
+    });
+    const double compressedBuild = pel::bench::best_of(3, [&]() {
+        compressed copy;
+        for(const IntegerType value : values_)
+        {
+            copy.push_back(value);
+        }
+        pel::bench::do_not_optimize(copy);
+    });
+
+    const compressed packed(values_.begin(), values_.end());
+    const auto       rawBytes = static_cast<double>(values_.size() * sizeof(IntegerType));
+    std::cout << "  memory: " << std::fixed << std::setprecision(2)
+              << static_cast<double>(packed.compressed_bytes()) * 8.0
+                   / static_cast<double>(values_.size())
+              << " bits per value, " << rawBytes / static_cast<double>(packed.compressed_bytes())
+              << "x smaller than std::vector\n";
+
+    const double vectorScan = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const IntegerType value : values_)
+        {
+            sum += static_cast<std::uint64_t>(value);
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double iteratorScan = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const IntegerType value : packed)
+        {
+            sum += static_cast<std::uint64_t>(value);
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double blockScan = pel::bench::best_of(3, [&]() {
+        std::array<IntegerType, compressed::values_per_block> buffer{};
+        std::uint64_t                                         sum = 0;
+        for(std::size_t block = 0; block < packed.block_count(); ++block)
+        {
+            const std::size_t decoded = packed.decode_block(block, buffer);
+            for(std::size_t i = 0; i < decoded; ++i)
+            {
+                sum += static_cast<std::uint64_t>(buffer[i]);
+            }
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    std::uint64_t            state = 7;
+    std::vector<std::size_t> indices(lookup_count);
+    for(std::size_t& index : indices)
+    {
+        index = split_mix(state) % values_.size();
+    }
+    const auto lookups = [&indices](const auto& container_) {
+        return pel::bench::best_of(3, [&]() {
+            std::uint64_t sum = 0;
+            for(const std::size_t index : indices)
+            {
+                sum += static_cast<std::uint64_t>(container_[index]);
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+    };
+    const double vectorLookup     = lookups(values_);
+    const double compressedLookup = lookups(packed);
+
+    const std::size_t count = values_.size();
+    pel::bench::print_result("std::vector push_back", vectorBuild, count);
+    pel::bench::print_result("compressed push_back", compressedBuild, count, vectorBuild);
+    pel::bench::print_result("std::vector scan", vectorScan, count);
+    pel::bench::print_result("compressed scan, iterator", iteratorScan, count, vectorScan);
+    pel::bench::print_result("compressed scan, decode_block", blockScan, count, vectorScan);
+    pel::bench::print_result("std::vector random read", vectorLookup, lookup_count);
+    pel::bench::print_result("compressed random read", compressedLookup, lookup_count,
+                             vectorLookup);
+}
+}        // namespace
+
+int
+main()
+{
+    std::uint64_t state = 1;
+
+    /* Sorted IDs with small gaps: delta-coded on a few bits */
+    std::vector<std::uint32_t> ids(value_count);
+    std::uint32_t              id = 0;
+    for(std::uint32_t& value : ids)
+    {
+        id += 1 + static_cast<std::uint32_t>(split_mix(state) % 16);
+        value = id;
+    }
+    measure("Sorted 32-bit IDs, gaps of 1 to 16", ids);
+
+    /* Timestamps in nanoseconds, about a microsecond apart */
+    std::vector<std::int64_t> stamps(value_count);
+    std::int64_t              stamp = 1'700'000'000'000'000'000;
+    for(std::int64_t& value : stamps)
+    {
+        stamp += 900 + static_cast<std::int64_t>(split_mix(state) % 200);
+        value = stamp;
+    }
+    measure("64-bit timestamps, about 1 us apart", stamps);
+
+    /* Small unsorted values: frame of reference on 10 bits */
+    std::vector<std::uint32_t> small(value_count);
+    for(std::uint32_t& value : small)
+    {
+        value = static_cast<std::uint32_t>(split_mix(state) % 1000);
+    }
+    measure("Random 32-bit values below 1000", small);
+
+    /* Nothing to compress: stored raw */
+    std::vector<std::uint32_t> noise(value_count);
+    for(std::uint32_t& value : noise)
+    {
+        value = static_cast<std::uint32_t>(split_mix(state));
+    }
+    measure("Random 32-bit values", noise);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file    container_base/src/bench/benchCowAdopt.cpp
+ *
+ * Handing a buffer of 8-byte integers produced elsewhere over to a cow_container, by adopting it
+ * against copying it in, across sizes. Each handoff first fills a fresh std::vector, as a producer
+ * would; the time of filling it alone is shown first for reference. Also times an adopt() and
+ * release() round trip of an allocator buffer, which moves no elements at all.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/cow_container.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/* Every measurement hands over about this many elements */
+constexpr std::size_t element_count = std::size_t{1} << 24;
+
+std::vector<std::uint64_t>
+produce(std::size_t size_)
+{
+    std::vector<std::uint64_t> produced(size_);
+    std::iota(produced.begin(), produced.end(), std::uint64_t{1});
+    return produced;
+}
+
+void
+measure(std::size_t size_)
+{
+    const std::size_t rounds = std::max<std::size_t>(element_count / size_, 1);
+    const std::size_t total  = rounds * size_;
+
+    const double fill = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            const std::vector<std::uint64_t> produced = produce(size_);
+            pel::bench::do_not_optimize(produced);
+        }
+    });
+    const double copied = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            const std::vector<std::uint64_t>  produced = produce(size_);
+            pel::cow_container<std::uint64_t> container;
+            container.resize_for_overwrite(produced.size());
+            std::ranges::copy(produced, container.begin().ptr());
+            pel::bench::do_not_optimize(container);
+        }
+    });
+    const double adopted = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            pel::cow_container<std::uint64_t> container;
+            container.adopt(produce(size_));
+            pel::bench::do_not_optimize(container);
+        }
+    });
+
+    /* The same buffer goes back and forth, so this is the handoff cost alone */
+    std::allocator<std::uint64_t> allocator;
+    std::uint64_t* const          items = allocator.allocate(size_);
+    std::uninitialized_fill_n(items, size_, std::uint64_t{1});
+    pel::cow_container<std::uint64_t>                  container;
+    pel::cow_container<std::uint64_t>::released_buffer buffer{items, size_, size_};
+
+    const double roundTrip = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            container.adopt(buffer.items, buffer.length, buffer.capacity);
+            pel::bench::do_not_optimize(container);
+            buffer = container.release();
+        }
+    });
+    allocator.deallocate(buffer.items, buffer.capacity);
+
+    pel::bench::print_result("fill std::vector alone", fill, total);
+    pel::bench::print_result("fill + copy into cow_container", copied, total);
+    pel::bench::print_result("fill + adopt(std::vector&&)", adopted, total, copied);
+    pel::bench::print_result("adopt + release round trip", roundTrip, rounds);
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 4>{1024, 65536, 1048576, 16777216})
+    {
+        pel::bench::print_title(std::to_string(size) + " 8-byte elements, per element " +
+                                "(round trip: per handoff)");
+        measure(size);
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file    container_base/src/bench/benchCowContainer.cpp
+ *
+ * Cost of copying a cow_container, and of the first write to the copy, against deep copies of a
+ * std::vector, across container sizes.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/cow_container.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* Every run copies about this many elements in total when copies are deep */
+constexpr std::size_t copied_elements = std::size_t{1} << 24;
+
+template<typename ContainerType>
+void
+copy_only(const ContainerType& source_, std::size_t copies_)
+{
+    for(std::size_t i = 0; i < copies_; ++i)
+    {
+        const ContainerType copy = source_;
+        pel::bench::do_not_optimize(copy);
+    }
+}
+
+template<typename ContainerType>
+void
+copy_and_write(const ContainerType& source_, std::size_t copies_)
+{
+    for(std::size_t i = 0; i < copies_; ++i)
+    {
+        ContainerType copy = source_;
+        copy[0]            = i;
+        pel::bench::do_not_optimize(copy);
+    }
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 4>{16, 1024, 65536, 1048576})
+    {
+        pel::bench::print_title(std::to_string(size) + " elements, per copy");
+
+        const std::vector<std::uint64_t>        vector(size, 7);
+        const pel::cow_container<std::uint64_t> cow(size, 7);
+        const std::size_t copies = std::max<std::size_t>(copied_elements / size, 16);
+
+        const double deep  = pel::bench::best_of(3, [&]() { copy_only(vector, copies); });
+        const double cheap = pel::bench::best_of(3, [&]() { copy_only(cow, copies); });
+        const double deepWrite =
+          pel::bench::best_of(3, [&]() { copy_and_write(vector, copies); });
+        const double cheapWrite = pel::bench::best_of(3, [&]() { copy_and_write(cow, copies); });
+        pel::bench::print_result("std::vector copy", deep, copies);
+        pel::bench::print_result("cow_container copy", cheap, copies, deep);
+        pel::bench::print_result("std::vector copy + write", deepWrite, copies);
+        pel::bench::print_result("cow_container copy + first write", cheapWrite, copies, deepWrite);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    container_base/src/bench/benchCowRanges.cpp
+ *
+ * Building a cow_container of 4-byte integers from a range with the from_range constructor and
+ * with append_range, against a push_back loop with and without reserve(), for a std::vector, a
+ * transform view, a std::list and an istream view as the source.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/cow_container.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/* Times building from the range made by makeRange_, which is made anew for every run */
+template<typename RangeMaker>
+void
+measure(const char* label_, std::size_t size_, RangeMaker makeRange_)
+{
+    const auto run = [&](auto build_) {
+        return pel::bench::best_of(3, [&]() {
+            auto                              range = makeRange_();
+            pel::cow_container<std::uint32_t> container;
+            build_(container, range);
+            pel::bench::do_not_optimize(container);
+        });
+    };
+
+    const double pushed = run([](auto& container_, auto& range_) {
+        for(const std::uint32_t item : range_)
+        {
+            container_.push_back(item);
+        }
+    });
+    const double reserved = run([size_](auto& container_, auto& range_) {
+        container_.reserve(size_);
+        for(const std::uint32_t item : range_)
+        {
+            container_.push_back(item);
+        }
+    });
+    const double constructed = run([](auto& container_, auto& range_) {
+        container_ = pel::cow_container<std::uint32_t>(pel::from_range, range_);
+    });
+    const double appended =
+      run([](auto& container_, auto& range_) { container_.append_range(range_); });
+
+    const std::string label(label_);
+    pel::bench::print_result(label + ", push_back", pushed, size_);
+    pel::bench::print_result(label + ", reserve + push_back", reserved, size_, pushed);
+    pel::bench::print_result(label + ", from_range", constructed, size_, pushed);
+    pel::bench::print_result(label + ", append_range", appended, size_, pushed);
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 2>{65536, std::size_t{1} << 22})
+    {
+        pel::bench::print_title(std::to_string(size) + " 4-byte elements, per element");
+
+        std::uint64_t              state = 1;
+        std::vector<std::uint32_t> items(size);
+        std::string                text;
+        for(std::uint32_t& item : items)
+        {
+            item = static_cast<std::uint32_t>(split_mix(state) % 1000000);
+            text += std::to_string(item) + ' ';
+        }
+        const std::list<std::uint32_t> listed(items.begin(), items.end());
+        const auto                     twice = [](std::uint32_t item_) { return 2 * item_; };
+
+        measure("std::vector", size, [&]() { return std::span<const std::uint32_t>(items); });
+        measure("transform view", size, [&]() { return items | std::views::transform(twice); });
+        measure("std::list", size, [&]() { return std::views::all(listed); });
+
+        /* The stream is the range's state, so it lives in the range maker's result */
+        struct parsed
+        {
+            std::istringstream                       stream;
+            std::ranges::istream_view<std::uint32_t> view{stream};
+
+            explicit parsed(const std::string& text_) : stream{text_} {}
+            auto begin() { return view.begin(); }
+            auto end() { return view.end(); }
+        };
+        measure("istream view", size, [&]() { return parsed(text); });
+    }
+    return 0;
+}
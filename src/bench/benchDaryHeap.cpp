@@ -0,0 +1,243 @@
+/**
+ * @file    container_base/src/bench/benchDaryHeap.cpp
+ *
+ * Dijkstra's shortest paths over random sparse graphs, with std::priority_queue and lazy deletion
+ * against dary_heap of arity 2, 4 and 8 used the same way, and against a position-tracking
+ * dary_heap using decrease_key. Also reports the largest queue each variant builds up.
+ *
+ * Graph traversal dominates the larger runs, so the heaps are also compared on their own with the
+ * hold model of event simulations: pop the first key and push a later one, at a constant size.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/dary_heap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t   edges_per_node = 8;
+constexpr std::uint64_t max_weight     = 1000;
+constexpr std::uint64_t unreached      = std::numeric_limits<std::uint64_t>::max();
+constexpr std::size_t   hold_count     = std::size_t{1} << 21;
+
+/* Distance first, so that std::greater orders entries by distance */
+using entry = std::pair<std::uint64_t, std::uint32_t>;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/* Compressed adjacency lists: the edges of node n are [offsets[n], offsets[n + 1]) */
+struct graph
+{
+    std::vector<std::size_t>   offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint64_t> weights;
+
+    [[nodiscard]] std::size_t node_count() const noexcept { return offsets.size() - 1; }
+};
+
+graph
+make_graph(std::size_t nodeCount_)
+{
+    graph         result;
+    std::uint64_t state = 1;
+    result.offsets.reserve(nodeCount_ + 1);
+    for(std::size_t node = 0; node < nodeCount_; ++node)
+    {
+        result.offsets.push_back(result.targets.size());
+        for(std::size_t e = 0; e < edges_per_node; ++e)
+        {
+            result.targets.push_back(static_cast<std::uint32_t>(split_mix(state) % nodeCount_));
+            result.weights.push_back(1 + split_mix(state) % max_weight);
+        }
+    }
+    result.offsets.push_back(result.targets.size());
+    return result;
+}
+
+/* Element count of std::priority_queue and of container_base alike */
+template<typename QueueType>
+std::size_t
+size_of(const QueueType& queue_)
+{
+    if constexpr(requires { queue_.length(); })
+    {
+        return queue_.length();
+    }
+    else
+    {
+        return queue_.size();
+    }
+}
+
+/* Lazy deletion: push every improvement, skip the entries a later improvement made stale */
+template<typename QueueType>
+std::uint64_t
+dijkstra_lazy(const graph& graph_, std::size_t& peak_)
+{
+    std::vector<std::uint64_t> distances(graph_.node_count(), unreached);
+    QueueType                  queue;
+    distances[0] = 0;
+    queue.push(entry{0, 0});
+    peak_ = 1;
+    while(size_of(queue) != 0)
+    {
+        const auto [distance, node] = queue.top();
+        queue.pop();
+        if(distance != distances[node])
+        {
+            continue;
+        }
+        for(std::size_t e = graph_.offsets[node]; e < graph_.offsets[node + 1]; ++e)
+        {
+            const std::uint64_t candidate = distance + graph_.weights[e];
+            const std::uint32_t target    = graph_.targets[e];
+            if(candidate < distances[target])
+            {
+                distances[target] = candidate;
+                queue.push(entry{candidate, target});
+            }
+        }
+        peak_ = std::max(peak_, size_of(queue));
+    }
+    return distances.back();
+}
+
+/* One queue entry per node at most, moved up by decrease_key when its distance improves */
+std::uint64_t
+dijkstra_decrease_key(const graph& graph_, std::size_t& peak_)
+{
+    using heap = pel::dary_heap<entry, 4, std::greater<>, true>;
+
+    std::vector<std::uint64_t>    distances(graph_.node_count(), unreached);
+    std::vector<pel::slot_handle> handles(graph_.node_count());
+    heap                          queue;
+    distances[0] = 0;
+    handles[0]   = queue.push(entry{0, 0});
+    peak_        = 1;
+    while(queue.is_not_empty())
+    {
+        const auto [distance, node] = queue.top();
+        queue.pop();
+        for(std::size_t e = graph_.offsets[node]; e < graph_.offsets[node + 1]; ++e)
+        {
+            const std::uint64_t candidate = distance + graph_.weights[e];
+            const std::uint32_t target    = graph_.targets[e];
+            if(candidate < distances[target])
+            {
+                if(distances[target] == unreached)
+                {
+                    handles[target] = queue.push(entry{candidate, target});
+                }
+                else
+                {
+                    queue.decrease_key(handles[target], entry{candidate, target});
+                }
+                distances[target] = candidate;
+            }
+        }
+        peak_ = std::max(peak_, queue.length());
+    }
+    return distances.back();
+}
+
+/* Pop the first key and push it back a random delay later, hold_count times */
+template<typename QueueType>
+double
+measure_hold(std::size_t size_)
+{
+    return pel::bench::best_of(3, [size_]() {
+        QueueType     queue;
+        std::uint64_t state = 3;
+        for(std::size_t i = 0; i < size_; ++i)
+        {
+            queue.push(split_mix(state) % max_weight);
+        }
+
+        std::uint64_t sum = 0;
+        for(std::size_t i = 0; i < hold_count; ++i)
+        {
+            const std::uint64_t first = queue.top();
+            queue.pop();
+            sum += first;
+            queue.push(first + split_mix(state) % max_weight);
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+}
+}        // namespace
+
+int
+main()
+{
+    using std_queue  = std::priority_queue<entry, std::vector<entry>, std::greater<>>;
+    using binary     = pel::dary_heap<entry, 2, std::greater<>>;
+    using quaternary = pel::dary_heap<entry, 4, std::greater<>>;
+    using octonary   = pel::dary_heap<entry, 8, std::greater<>>;
+
+    for(const std::size_t nodes : std::array<std::size_t, 4>{4096, 65536, 1048576, 4194304})
+    {
+        pel::bench::print_title(std::to_string(nodes) + " nodes, " +
+                                std::to_string(nodes * edges_per_node) + " edges, per edge");
+
+        const graph       network = make_graph(nodes);
+        const std::size_t edges   = network.targets.size();
+
+        std::array<std::size_t, 5> peaks{};
+        std::uint64_t              check = 0;
+        const auto run = [&check, &network](std::uint64_t (*dijkstra_)(const graph&, std::size_t&),
+                                            std::size_t& peak_) {
+            return pel::bench::best_of(3, [&]() { check ^= dijkstra_(network, peak_); });
+        };
+        const double stdLazy  = run(dijkstra_lazy<std_queue>, peaks[0]);
+        const double lazy2    = run(dijkstra_lazy<binary>, peaks[1]);
+        const double lazy4    = run(dijkstra_lazy<quaternary>, peaks[2]);
+        const double lazy8    = run(dijkstra_lazy<octonary>, peaks[3]);
+        const double tracking = run(dijkstra_decrease_key, peaks[4]);
+        pel::bench::do_not_optimize(check);
+
+        pel::bench::print_result("std::priority_queue, lazy", stdLazy, edges);
+        pel::bench::print_result("dary_heap<2>, lazy", lazy2, edges, stdLazy);
+        pel::bench::print_result("dary_heap<4>, lazy", lazy4, edges, stdLazy);
+        pel::bench::print_result("dary_heap<8>, lazy", lazy8, edges, stdLazy);
+        pel::bench::print_result("dary_heap<4>, decrease_key", tracking, edges, stdLazy);
+        std::cout << "  largest queue: " << peaks[0] << " entries with lazy deletion, "
+                  << peaks[4] << " with decrease_key\n";
+    }
+
+    using greater = std::greater<>;
+    for(const std::size_t size : std::array<std::size_t, 3>{1024, 65536, 1048576})
+    {
+        pel::bench::print_title("Hold model, " + std::to_string(size) + " keys, per pop + push");
+
+        using std_hold = std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, greater>;
+        const double stdHold = measure_hold<std_hold>(size);
+        const double hold2   = measure_hold<pel::dary_heap<std::uint64_t, 2, greater>>(size);
+        const double hold4   = measure_hold<pel::dary_heap<std::uint64_t, 4, greater>>(size);
+        const double hold8   = measure_hold<pel::dary_heap<std::uint64_t, 8, greater>>(size);
+        const double tracked = measure_hold<pel::dary_heap<std::uint64_t, 4, greater, true>>(size);
+        pel::bench::print_result("std::priority_queue", stdHold, hold_count);
+        pel::bench::print_result("dary_heap<2>", hold2, hold_count, stdHold);
+        pel::bench::print_result("dary_heap<4>", hold4, hold_count, stdHold);
+        pel::bench::print_result("dary_heap<8>", hold8, hold_count, stdHold);
+        pel::bench::print_result("dary_heap<4>, tracking positions", tracked, hold_count, stdHold);
+    }
+    return 0;
+}
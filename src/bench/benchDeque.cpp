@@ -0,0 +1,204 @@
+/**
+ * @file    container_base/src/bench/benchDeque.cpp
+ *
+ * Pushes and pops at both ends, a queue of steady size, random indexing and full scans of
+ * pel::deque against std::deque, across sizes. Scans go through the iterator, the segmented
+ * for_each() and copy(), and for_each_segment().
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/deque.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* Every measurement performs about this many operations */
+constexpr std::size_t operation_count = std::size_t{1} << 22;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+template<typename DequeType>
+void
+measure(const char* label_, std::size_t size_, std::array<double, 7>& baseline_)
+{
+    const std::size_t rounds = std::max<std::size_t>(operation_count / size_, 1);
+    const std::size_t total  = rounds * size_;
+
+    /* Fill from the back and drain from the front, as a FIFO queue */
+    const double fifo = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            DequeType deque;
+            for(std::uint64_t i = 0; i < size_; ++i)
+            {
+                deque.push_back(i);
+            }
+            for(std::size_t i = 0; i < size_; ++i)
+            {
+                deque.pop_front();
+            }
+            pel::bench::do_not_optimize(deque);
+        }
+    });
+    const double lifo = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            DequeType deque;
+            for(std::uint64_t i = 0; i < size_; ++i)
+            {
+                deque.push_front(i);
+            }
+            for(std::size_t i = 0; i < size_; ++i)
+            {
+                deque.pop_front();
+            }
+            pel::bench::do_not_optimize(deque);
+        }
+    });
+
+    DequeType deque;
+    for(std::uint64_t i = 0; i < size_; ++i)
+    {
+        deque.push_back(i);
+    }
+
+    /* The queue slides through memory, one chunk at a time */
+    const double steady = pel::bench::best_of(3, [&]() {
+        for(std::uint64_t i = 0; i < total; ++i)
+        {
+            deque.push_back(i);
+            deque.pop_front();
+        }
+        pel::bench::do_not_optimize(deque);
+    });
+
+    std::vector<std::size_t> indices(total);
+    std::uint64_t            state = 1;
+    for(std::size_t& index : indices)
+    {
+        index = split_mix(state) % size_;
+    }
+    const double random = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::size_t index : indices)
+        {
+            sum += deque[index];
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    const double iterate = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            for(const std::uint64_t item : deque)
+            {
+                sum += item;
+            }
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    /* Unqualified, so that pel::deque iterators find the segmented overloads */
+    const double forEach = pel::bench::best_of(3, [&]() {
+        using std::for_each;
+        std::uint64_t sum = 0;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            for_each(deque.begin(), deque.end(), [&sum](std::uint64_t item_) { sum += item_; });
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    std::vector<std::uint64_t> target(size_);
+    const double               copy = pel::bench::best_of(3, [&]() {
+        using std::copy;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            copy(deque.begin(), deque.end(), target.begin());
+            pel::bench::do_not_optimize(target);
+        }
+    });
+
+    const std::array<double, 7> results{fifo, lifo, steady, random, iterate, forEach, copy};
+    const bool                  isBaseline = baseline_[0] == 0.0;
+    if(isBaseline)
+    {
+        baseline_ = results;
+    }
+
+    constexpr std::array<const char*, 7> names{" push_back + pop_front",
+                                               " push_front + pop_front",
+                                               " steady queue",
+                                               " operator[] at random",
+                                               " range-for scan",
+                                               " for_each scan",
+                                               " copy"};
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        pel::bench::print_result(std::string(label_) + names[i],
+                                 results[i],
+                                 total,
+                                 isBaseline ? 0.0 : baseline_[i]);
+    }
+}
+
+/* for_each_segment() against the segmented for_each(), one span per chunk */
+double
+measure_segments(std::size_t size_)
+{
+    pel::deque<std::uint64_t> deque;
+    for(std::uint64_t i = 0; i < size_; ++i)
+    {
+        deque.push_back(i);
+    }
+
+    const std::size_t rounds = std::max<std::size_t>(operation_count / size_, 1);
+    return pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            deque.for_each_segment([&sum](std::span<const std::uint64_t> segment_) {
+                for(const std::uint64_t item : segment_)
+                {
+                    sum += item;
+                }
+            });
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 3>{1024, 65536, 1048576})
+    {
+        pel::bench::print_title(std::to_string(size) + " elements, per element");
+
+        std::array<double, 7> baseline{};
+        measure<std::deque<std::uint64_t>>("std::deque", size, baseline);
+        measure<pel::deque<std::uint64_t>>("pel::deque", size, baseline);
+
+        const std::size_t total = std::max<std::size_t>(operation_count / size, 1) * size;
+        pel::bench::print_result(
+          "pel::deque for_each_segment scan", measure_segments(size), total, baseline[4]);
+    }
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file    container_base/src/bench/benchErase.cpp
+ *
+ * erase_if and erase_indices on cow_container against std::erase_if on std::vector, for 4-byte,
+ * 8-byte and std::string elements, keeping 90%, 50% and 10% of them; and swap_erase against
+ * std::vector::erase. Every run erases from a fresh copy of the same elements, so the results
+ * include a copy; the time of a std::vector copy alone is shown first for reference.
+ *
+ * The packed erase_if path for 4-byte elements is only compiled in with AVX2 or AVX-512, e.g.
+ * with -DCMAKE_CXX_FLAGS=-march=native; the first line of the output says which path is used.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/cow_container.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* Every measurement erases from about this many elements */
+constexpr std::size_t element_count = std::size_t{1} << 24;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/* Elements are uniformly distributed, so erasing those below a threshold erases a known share */
+std::uint32_t
+make_item(std::uint64_t& state_, std::uint32_t* /*tag_*/)
+{
+    return static_cast<std::uint32_t>(split_mix(state_));
+}
+
+std::uint64_t
+make_item(std::uint64_t& state_, std::uint64_t* /*tag_*/)
+{
+    return split_mix(state_);
+}
+
+/* Ten digits, then enough padding to stay out of the small string buffer */
+std::string
+make_item(std::uint64_t& state_, std::string* /*tag_*/)
+{
+    std::string digits = std::to_string(split_mix(state_) % 10000000000ULL);
+    return std::string(10 - digits.size(), '0') + digits + std::string(20, '-');
+}
+
+std::uint32_t
+threshold(unsigned percent_, std::uint32_t* /*tag_*/)
+{
+    return static_cast<std::uint32_t>((std::uint64_t{1} << 32U) / 100 * percent_);
+}
+
+std::uint64_t
+threshold(unsigned percent_, std::uint64_t* /*tag_*/)
+{
+    return (std::uint64_t{1} << 63U) / 50 * percent_;
+}
+
+std::string
+threshold(unsigned percent_, std::string* /*tag_*/)
+{
+    return std::to_string(percent_) + std::string(8, '0');
+}
+
+template<typename ItemType>
+void
+measure(const char* label_, std::size_t size_)
+{
+    constexpr ItemType* tag    = nullptr;
+    const std::size_t   rounds = std::max<std::size_t>(element_count / size_, 1);
+    const std::size_t   total  = rounds * size_;
+
+    std::uint64_t                state = 1;
+    std::vector<ItemType>        items;
+    pel::cow_container<ItemType> source;
+    for(std::size_t i = 0; i < size_; ++i)
+    {
+        items.push_back(make_item(state, tag));
+        source.push_back(items.back());
+    }
+
+    /* Unsharing the copy of source copies the elements the same way */
+    const double copy = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            std::vector<ItemType> fresh = items;
+            pel::bench::do_not_optimize(fresh);
+        }
+    });
+
+    for(const unsigned percent : {10U, 50U, 90U})
+    {
+        pel::bench::print_title(std::string(label_) + ", " + std::to_string(size_) +
+                                " elements, " + std::to_string(percent) +
+                                "% erased, per element");
+
+        const ItemType limit    = threshold(percent, tag);
+        const auto     isErased = [&limit](const ItemType& item_) { return item_ < limit; };
+
+        std::vector<std::size_t> indices;
+        for(std::size_t i = 0; i < size_; ++i)
+        {
+            if(isErased(items[i]))
+            {
+                indices.push_back(i);
+            }
+        }
+
+        const double stdErase = pel::bench::best_of(3, [&]() {
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                std::vector<ItemType> fresh = items;
+                std::erase_if(fresh, isErased);
+                pel::bench::do_not_optimize(fresh);
+            }
+        });
+        const double pelErase = pel::bench::best_of(3, [&]() {
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                pel::cow_container<ItemType> fresh = source;
+                static_cast<void>(pel::erase_if(fresh, isErased));
+                pel::bench::do_not_optimize(fresh);
+            }
+        });
+        const double pelIndices = pel::bench::best_of(3, [&]() {
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                pel::cow_container<ItemType> fresh = source;
+                static_cast<void>(pel::erase_indices(fresh, indices));
+                pel::bench::do_not_optimize(fresh);
+            }
+        });
+
+        pel::bench::print_result("std::vector copy alone", copy, total);
+        pel::bench::print_result("copy + std::erase_if", stdErase, total);
+        pel::bench::print_result("copy + erase_if", pelErase, total, stdErase);
+        pel::bench::print_result("copy + erase_indices", pelIndices, total, stdErase);
+    }
+}
+
+/* Erase random elements one at a time, down to half of the elements */
+void
+measure_swap_erase(std::size_t size_)
+{
+    pel::bench::print_title(std::to_string(size_) + " 4-byte elements, erase half one at a time, " +
+                            "per erase");
+
+    std::uint64_t              state = 1;
+    std::vector<std::size_t>   positions;
+    std::vector<std::uint32_t> items;
+    for(std::size_t i = 0; i < size_; ++i)
+    {
+        items.push_back(static_cast<std::uint32_t>(i));
+    }
+    for(std::size_t length = size_; length > size_ / 2; --length)
+    {
+        positions.push_back(split_mix(state) % length);
+    }
+
+    pel::cow_container<std::uint32_t> source;
+    for(const std::uint32_t item : items)
+    {
+        source.push_back(item);
+    }
+
+    const double copy = pel::bench::best_of(3, [&]() {
+        std::vector<std::uint32_t> fresh = items;
+        pel::bench::do_not_optimize(fresh);
+    });
+    const double stdErase = pel::bench::best_of(3, [&]() {
+        std::vector<std::uint32_t> fresh = items;
+        for(const std::size_t position : positions)
+        {
+            fresh.erase(fresh.begin() + static_cast<std::ptrdiff_t>(position));
+        }
+        pel::bench::do_not_optimize(fresh);
+    });
+    const double swapErase = pel::bench::best_of(3, [&]() {
+        pel::cow_container<std::uint32_t> fresh = source;
+        for(const std::size_t position : positions)
+        {
+            pel::swap_erase(fresh, position);
+        }
+        pel::bench::do_not_optimize(fresh);
+    });
+
+    pel::bench::print_result("std::vector copy alone", copy, positions.size());
+    pel::bench::print_result("copy + std::vector::erase", stdErase, positions.size());
+    pel::bench::print_result("copy + swap_erase", swapErase, positions.size(), stdErase);
+}
+}        // namespace
+
+int
+main()
+{
+    std::cout << "erase_if packs 4-byte elements "
+              << (pel::compaction_block_words == 0
+                    ? std::string("one at a time (no AVX2 or AVX-512)")
+                    : std::to_string(pel::compaction_block_words) + " at a time")
+              << "\n";
+
+    for(const std::size_t size : std::array<std::size_t, 2>{65536, std::size_t{1} << 24})
+    {
+        measure<std::uint32_t>("4-byte", size);
+        measure<std::uint64_t>("8-byte", size);
+    }
+    for(const std::size_t size : std::array<std::size_t, 2>{65536, std::size_t{1} << 20})
+    {
+        measure<std::string>("std::string", size);
+    }
+    measure_swap_erase(65536);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file    container_base/src/bench/benchFlatHashMap.cpp
+ *
+ * Insertion, successful and failed lookups, iteration and erasure in flat_hash_map against
+ * std::unordered_map, across table sizes, for random and sequential integer keys.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/flat_hash_map.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+/* Every measurement performs about this many operations */
+constexpr std::size_t operation_count = std::size_t{1} << 20;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+std::vector<std::uint64_t>
+make_keys(std::size_t count_, bool random_, std::uint64_t seed_)
+{
+    std::vector<std::uint64_t> keys(count_);
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        keys[i] = random_ ? split_mix(seed_) : seed_ + i;
+    }
+    return keys;
+}
+
+template<typename MapType>
+void
+measure(const char*                       label_,
+        const std::vector<std::uint64_t>& keys_,
+        const std::vector<std::uint64_t>& missing_,
+        std::array<double, 5>&            baseline_)
+{
+    const std::size_t rounds = std::max<std::size_t>(operation_count / keys_.size(), 1);
+    const std::size_t total  = rounds * keys_.size();
+
+    const double insert = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            MapType map;
+            for(const std::uint64_t key : keys_)
+            {
+                map.emplace(key, key);
+            }
+            pel::bench::do_not_optimize(map);
+        }
+    });
+
+    MapType map;
+    for(const std::uint64_t key : keys_)
+    {
+        map.emplace(key, key);
+    }
+
+    const auto lookup = [&](const std::vector<std::uint64_t>& probes_) {
+        return pel::bench::best_of(3, [&]() {
+            std::uint64_t found = 0;
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                for(const std::uint64_t key : probes_)
+                {
+                    found += map.count(key);
+                }
+            }
+            pel::bench::do_not_optimize(found);
+        });
+    };
+    const double hit  = lookup(keys_);
+    const double miss = lookup(missing_);
+
+    const double iterate = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            for(const auto& [key, value] : map)
+            {
+                sum += value;
+            }
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    const double erase = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            MapType copy = map;
+            for(const std::uint64_t key : keys_)
+            {
+                copy.erase(key);
+            }
+            pel::bench::do_not_optimize(copy);
+        }
+    });
+
+    const std::array<double, 5> results{insert, hit, miss, iterate, erase};
+    const bool                  isBaseline = baseline_[0] == 0.0;
+    if(isBaseline)
+    {
+        baseline_ = results;
+    }
+
+    constexpr std::array<const char*, 5> names{
+      " insert", " find (hit)", " find (miss)", " iterate", " copy + erase all"};
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        pel::bench::print_result(std::string(label_) + names[i],
+                                 results[i],
+                                 total,
+                                 isBaseline ? 0.0 : baseline_[i]);
+    }
+}
+}        // namespace
+
+int
+main()
+{
+    for(const bool random : {true, false})
+    {
+        for(const std::size_t size : std::array<std::size_t, 3>{1024, 65536, 1048576})
+        {
+            pel::bench::print_title(std::to_string(size) + (random ? " random" : " sequential") +
+                                    " keys, per element");
+
+            const std::vector<std::uint64_t> keys    = make_keys(size, random, 1);
+            const std::vector<std::uint64_t> missing = make_keys(size, random, size + 2);
+
+            std::array<double, 5> baseline{};
+            measure<std::unordered_map<std::uint64_t, std::uint64_t>>(
+              "std::unordered_map", keys, missing, baseline);
+            measure<pel::flat_hash_map<std::uint64_t, std::uint64_t>>(
+              "flat_hash_map     ", keys, missing, baseline);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file    container_base/src/bench/benchFlatSortedTable.cpp
+ *
+ * Random lower_bound lookups in flat_set, with the sorted and Eytzinger layouts, against std::map
+ * and std::lower_bound over a sorted std::vector, from tables that fit in L1 to tables much larger
+ * than the last-level cache.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/flat_set.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t lookup_count = std::size_t{1} << 19;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/* Sum the keys found by lower_bound for every probe, or 0 past the end */
+template<typename LowerBoundType>
+double
+measure(const std::vector<std::uint64_t>& probes_, LowerBoundType&& lowerBound_)
+{
+    return pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::uint64_t probe : probes_)
+        {
+            sum += lowerBound_(probe);
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+}
+
+template<typename SetType>
+double
+measure_flat(const std::vector<std::uint64_t>& keys_, const std::vector<std::uint64_t>& probes_)
+{
+    const SetType set(keys_.begin(), keys_.end());
+    return measure(probes_, [&set](std::uint64_t probe_) -> std::uint64_t {
+        const auto found = set.lower_bound(probe_);
+        return found == set.end() ? 0 : *found;
+    });
+}
+}        // namespace
+
+int
+main()
+{
+    using sorted_set = pel::flat_set<std::uint64_t>;
+    using eytzinger_set =
+      pel::flat_set<std::uint64_t, std::less<>, std::allocator<std::uint64_t>,
+                    pel::flat_layout::eytzinger>;
+
+    for(const std::size_t size : std::array<std::size_t, 5>{256, 4096, 65536, 1048576, 4194304})
+    {
+        pel::bench::print_title(std::to_string(size) + " keys, random lower_bound");
+
+        /* Even keys, probed with random values so that half of the lookups miss */
+        std::vector<std::uint64_t> keys(size);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            keys[i] = 2 * i;
+        }
+        std::uint64_t              state = 1;
+        std::vector<std::uint64_t> probes(lookup_count);
+        for(std::uint64_t& probe : probes)
+        {
+            probe = split_mix(state) % (2 * size);
+        }
+
+        double tree = 0.0;
+        {
+            std::map<std::uint64_t, std::uint64_t> map;
+            for(const std::uint64_t key : keys)
+            {
+                map.emplace_hint(map.end(), key, key);
+            }
+            tree = measure(probes, [&map](std::uint64_t probe_) -> std::uint64_t {
+                const auto found = map.lower_bound(probe_);
+                return found == map.end() ? 0 : found->first;
+            });
+        }
+        const double binary = measure(probes, [&keys](std::uint64_t probe_) -> std::uint64_t {
+            const auto found = std::lower_bound(keys.begin(), keys.end(), probe_);
+            return found == keys.end() ? 0 : *found;
+        });
+        const double sorted    = measure_flat<sorted_set>(keys, probes);
+        const double eytzinger = measure_flat<eytzinger_set>(keys, probes);
+
+        pel::bench::print_result("std::map", tree, lookup_count);
+        pel::bench::print_result("std::lower_bound", binary, lookup_count, tree);
+        pel::bench::print_result("flat_set, sorted layout", sorted, lookup_count, tree);
+        pel::bench::print_result("flat_set, eytzinger layout", eytzinger, lookup_count, tree);
+    }
+    return 0;
+}
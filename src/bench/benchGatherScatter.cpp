@@ -0,0 +1,154 @@
+/**
+ * @file    container_base/src/bench/benchGatherScatter.cpp
+ *
+ * gather and scatter, without prefetching and at the default prefetch distance, against a plain
+ * indexed loop without bounds checks, for sequential, strided and random index patterns over
+ * tables that fit in L2 and tables much larger than the last-level cache. Also sums the elements
+ * through prefetched() against a plain indexed sum.
+ *
+ * Hardware gathers are only compiled in with AVX2 or AVX-512, e.g. with
+ * -DCMAKE_CXX_FLAGS=-march=native.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/cow_container.hpp"
+#include "src/gather_scatter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t index_count = std::size_t{1} << 22;
+
+/* One index per cache line of 8-byte elements */
+constexpr std::size_t stride = 8;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+std::vector<std::uint32_t>
+make_indices(const std::string& pattern_, std::size_t size_)
+{
+    std::vector<std::uint32_t> indices(index_count);
+    std::uint64_t              state = 1;
+    for(std::size_t i = 0; i < index_count; ++i)
+    {
+        /* Strided indices move over by one element each time they wrap around */
+        std::size_t index = split_mix(state) % size_;
+        if(pattern_ == "sequential")
+        {
+            index = i % size_;
+        }
+        else if(pattern_ == "strided")
+        {
+            index = (i * stride + i * stride / size_) % size_;
+        }
+        indices[i] = static_cast<std::uint32_t>(index);
+    }
+    return indices;
+}
+
+template<typename ItemType>
+void
+measure(const char* label_, std::size_t size_, const std::vector<std::uint32_t>& indices_)
+{
+    pel::cow_container<ItemType> table;
+    for(std::size_t i = 0; i < size_; ++i)
+    {
+        table.push_back(static_cast<ItemType>(i));
+    }
+    std::vector<ItemType> values(indices_.size());
+
+    const double gatherLoop = pel::bench::best_of(3, [&]() {
+        const ItemType* source = table.begin().ptr();
+        for(std::size_t i = 0; i < indices_.size(); ++i)
+        {
+            values[i] = source[indices_[i]];
+        }
+        pel::bench::do_not_optimize(values);
+    });
+    const auto gather = [&](std::size_t distance_) {
+        return pel::bench::best_of(3, [&]() {
+            static_cast<void>(pel::gather(table, indices_, values.begin(), distance_));
+            pel::bench::do_not_optimize(values);
+        });
+    };
+    const double gatherNear     = gather(0);
+    const double gatherPrefetch = gather(pel::default_prefetch_distance);
+
+    const double scatterLoop = pel::bench::best_of(3, [&]() {
+        ItemType* destination = table.begin().ptr();
+        for(std::size_t i = 0; i < indices_.size(); ++i)
+        {
+            destination[indices_[i]] = values[i];
+        }
+        pel::bench::do_not_optimize(table);
+    });
+    const auto scatter = [&](std::size_t distance_) {
+        return pel::bench::best_of(3, [&]() {
+            pel::scatter(table, indices_, values, distance_);
+            pel::bench::do_not_optimize(table);
+        });
+    };
+    const double scatterNear     = scatter(0);
+    const double scatterPrefetch = scatter(pel::default_prefetch_distance);
+
+    const double sumLoop = pel::bench::best_of(3, [&]() {
+        const ItemType* source = table.begin().ptr();
+        std::uint64_t   sum    = 0;
+        for(const std::uint32_t index : indices_)
+        {
+            sum += source[index];
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double sumPrefetched = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const ItemType item : pel::prefetched(std::as_const(table), indices_))
+        {
+            sum += item;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    const std::size_t count = indices_.size();
+    const std::string label(label_);
+    pel::bench::print_result(label + " indexed loop", gatherLoop, count);
+    pel::bench::print_result(label + " gather, no prefetch", gatherNear, count, gatherLoop);
+    pel::bench::print_result(label + " gather, prefetch", gatherPrefetch, count, gatherLoop);
+    pel::bench::print_result(label + " indexed store loop", scatterLoop, count);
+    pel::bench::print_result(label + " scatter, no prefetch", scatterNear, count, scatterLoop);
+    pel::bench::print_result(label + " scatter, prefetch", scatterPrefetch, count, scatterLoop);
+    pel::bench::print_result(label + " indexed sum", sumLoop, count);
+    pel::bench::print_result(label + " prefetched() sum", sumPrefetched, count, sumLoop);
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 2>{32768, std::size_t{1} << 25})
+    {
+        for(const char* pattern : {"sequential", "strided", "random"})
+        {
+            pel::bench::print_title(std::to_string(size) + " elements, " + pattern +
+                                    " indices, per index");
+
+            const std::vector<std::uint32_t> indices = make_indices(pattern, size);
+            measure<std::uint32_t>("4-byte", size, indices);
+            measure<std::uint64_t>("8-byte", size, indices);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file    container_base/src/bench/benchHashBytes.cpp
+ *
+ * Hashing buffers of 4-byte integers, from a 16-byte key to 1 MiB, with hash_bytes, byte_hasher
+ * fed one element at a time and hash_container, against combining std::hash of every element
+ * with the usual hash_combine step, and against std::hash<std::string_view> over the same bytes.
+ *
+ * The AVX2 path of hash_bytes is only compiled in with AVX2, e.g. with
+ * -DCMAKE_CXX_FLAGS=-march=native; SSE2 is used otherwise.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/container_hash.hpp"
+#include "src/cow_container.hpp"
+#include "src/hash_bytes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+/* Every measurement hashes about this many bytes */
+constexpr std::size_t byte_count = std::size_t{1} << 26;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/* Hash every element with std::hash, folding each into the running hash as boost does */
+std::size_t
+combine_elements(const std::uint32_t* items_, std::size_t count_)
+{
+    std::size_t seed = 0;
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        seed ^= std::hash<std::uint32_t>{}(items_[i]) + 0x9E3779B9U + (seed << 6U) + (seed >> 2U);
+    }
+    return seed;
+}
+
+void
+measure(std::size_t bytes_)
+{
+    const std::size_t count  = bytes_ / sizeof(std::uint32_t);
+    const std::size_t rounds = std::max<std::size_t>(byte_count / bytes_, 1);
+    const std::size_t total  = rounds * bytes_;
+
+    std::uint64_t                     state = 1;
+    std::vector<std::uint32_t>        items(count);
+    pel::cow_container<std::uint32_t> container;
+    for(std::uint32_t& item : items)
+    {
+        item = static_cast<std::uint32_t>(split_mix(state));
+        container.push_back(item);
+    }
+    const std::string_view view(reinterpret_cast<const char*>(items.data()), bytes_);
+
+    /* The keys are clobbered every round, so that the hash cannot be hoisted out of the loop */
+    const auto run = [&](auto hash_) {
+        return pel::bench::best_of(3, [&]() {
+            std::uint64_t sum = 0;
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                pel::bench::do_not_optimize(items);
+                pel::bench::do_not_optimize(container);
+                sum += hash_();
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+    };
+
+    const double combined = run([&]() { return combine_elements(items.data(), count); });
+    const double stdHash  = run([&]() { return std::hash<std::string_view>{}(view); });
+    const double oneShot  = run([&]() { return pel::hash_bytes(items.data(), bytes_); });
+    const double streamed = run([&]() {
+        pel::byte_hasher hasher;
+        for(const std::uint32_t item : items)
+        {
+            hasher.append(item);
+        }
+        return hasher.digest();
+    });
+    const double containerHash = run([&]() { return pel::hash_container(container); });
+
+    pel::bench::print_result("std::hash per element, combined", combined, total);
+    pel::bench::print_result("std::hash<std::string_view>", stdHash, total, combined);
+    pel::bench::print_result("hash_bytes", oneShot, total, combined);
+    pel::bench::print_result("byte_hasher, one element at a time", streamed, total, combined);
+    pel::bench::print_result("hash_container", containerHash, total, combined);
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t bytes : std::array<std::size_t, 6>{16, 64, 256, 4096, 65536, 1048576})
+    {
+        pel::bench::print_title(std::to_string(bytes) + "-byte keys of 4-byte integers, per byte");
+        measure(bytes);
+    }
+    return 0;
+}
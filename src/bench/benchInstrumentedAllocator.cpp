@@ -0,0 +1,205 @@
+/**
+ * @file    container_base/src/bench/benchInstrumentedAllocator.cpp
+ *
+ * Overhead of instrumented_allocator over the std::allocator it wraps, without and with lifetime
+ * tracking: a bare allocate/deallocate loop, then containers allocating one node per element
+ * (std::list, btree_map) and containers allocating in blocks (deque, flat_hash_map,
+ * persistent_vector). A ratio of 0.98x is a 2% overhead.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/btree_map.hpp"
+#include "src/deque.hpp"
+#include "src/flat_hash_map.hpp"
+#include "src/instrumented_allocator.hpp"
+#include "src/persistent_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t element_count = 200000;
+
+/* Runs are short and the machine noisy, so each result is the best of many */
+constexpr std::size_t repeats = 31;
+
+enum class tracking
+{
+    none,
+    counts,
+    lifetimes,
+};
+
+template<typename ItemType, tracking Tracking>
+using allocator_for = std::conditional_t<
+  Tracking == tracking::none,
+  std::allocator<ItemType>,
+  pel::instrumented_allocator<std::allocator<ItemType>, Tracking == tracking::lifetimes>>;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+const std::vector<std::uint64_t>&
+random_keys()
+{
+    static const std::vector<std::uint64_t> keys = []() {
+        std::uint64_t              state = 1;
+        std::vector<std::uint64_t> made(element_count);
+        for(std::uint64_t& key : made)
+        {
+            key = split_mix(state);
+        }
+        return made;
+    }();
+    return keys;
+}
+
+template<tracking Tracking>
+struct bare_pairs
+{
+    void operator()() const
+    {
+        allocator_for<std::uint64_t, Tracking> alloc;
+        for(std::size_t i = 0; i < element_count; ++i)
+        {
+            std::uint64_t* const items = alloc.allocate(5);
+            pel::bench::do_not_optimize(items);
+            alloc.deallocate(items, 5);
+        }
+    }
+};
+
+template<tracking Tracking>
+struct list_churn
+{
+    void operator()() const
+    {
+        std::list<std::uint64_t, allocator_for<std::uint64_t, Tracking>> list;
+        for(std::uint64_t i = 0; i < element_count; ++i)
+        {
+            list.push_back(i);
+        }
+        while(list.empty() == false)
+        {
+            pel::bench::do_not_optimize(list.front());
+            list.pop_front();
+        }
+    }
+};
+
+template<tracking Tracking>
+struct btree_churn
+{
+    void operator()() const
+    {
+        using value_type = std::pair<std::uint64_t, std::uint64_t>;
+        pel::btree_map<std::uint64_t,
+                       std::uint64_t,
+                       std::less<std::uint64_t>,
+                       allocator_for<value_type, Tracking>>
+          map;
+        for(const std::uint64_t key : random_keys())
+        {
+            map.insert({key, key});
+        }
+        for(const std::uint64_t key : random_keys())
+        {
+            pel::bench::do_not_optimize(map.erase(key));
+        }
+    }
+};
+
+template<tracking Tracking>
+struct deque_churn
+{
+    void operator()() const
+    {
+        pel::deque<std::uint64_t, allocator_for<std::uint64_t, Tracking>> deque;
+        for(std::uint64_t i = 0; i < element_count; ++i)
+        {
+            deque.push_back(i);
+        }
+        while(deque.is_not_empty())
+        {
+            pel::bench::do_not_optimize(deque.front());
+            deque.pop_front();
+        }
+    }
+};
+
+template<tracking Tracking>
+struct hash_map_inserts
+{
+    void operator()() const
+    {
+        using value_type = std::pair<const std::uint64_t, std::uint64_t>;
+        pel::flat_hash_map<std::uint64_t,
+                           std::uint64_t,
+                           std::hash<std::uint64_t>,
+                           std::equal_to<std::uint64_t>,
+                           allocator_for<value_type, Tracking>>
+          map;
+        for(const std::uint64_t key : random_keys())
+        {
+            map.insert_or_assign(key, key);
+        }
+        pel::bench::do_not_optimize(map);
+    }
+};
+
+template<tracking Tracking>
+struct persistent_appends
+{
+    void operator()() const
+    {
+        pel::persistent_vector<std::uint64_t, allocator_for<std::uint64_t, Tracking>> vector;
+        for(std::uint64_t i = 0; i < element_count; ++i)
+        {
+            vector = vector.push_back(i);
+        }
+        pel::bench::do_not_optimize(vector);
+    }
+};
+
+/* Workloads are class templates over the tracking mode, so that each is timed in all three */
+template<template<tracking> typename Workload>
+void
+measure(const char* label_)
+{
+    const double plain     = pel::bench::best_of(repeats, Workload<tracking::none>{});
+    const double counted   = pel::bench::best_of(repeats, Workload<tracking::counts>{});
+    const double lifetimes = pel::bench::best_of(repeats, Workload<tracking::lifetimes>{});
+
+    pel::bench::print_title(std::string(label_) + ", " + std::to_string(element_count) +
+                            " elements, per element");
+    pel::bench::print_result("std::allocator", plain, element_count);
+    pel::bench::print_result("instrumented_allocator", counted, element_count, plain);
+    pel::bench::print_result("instrumented, with lifetimes", lifetimes, element_count, plain);
+}
+}        // namespace
+
+int
+main()
+{
+    measure<bare_pairs>("allocate + deallocate");
+    measure<list_churn>("std::list push + pop");
+    measure<btree_churn>("btree_map insert + erase");
+    measure<deque_churn>("deque push + pop");
+    measure<hash_map_inserts>("flat_hash_map insert");
+    measure<persistent_appends>("persistent_vector push_back");
+    return 0;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file    container_base/src/bench/benchIntrusiveList.cpp
+ *
+ * Building, traversing and churning (erase an element, insert another one at a known position)
+ * intrusive_list with nodes from a node_pool against std::list, across sizes. Traversals run once
+ * over a list in allocation order and once over the same list with its links shuffled, as after a
+ * long run of inserts and erases.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/intrusive_list.hpp"
+#include "src/node_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/* Every measurement performs about this many operations */
+constexpr std::size_t operation_count = std::size_t{1} << 22;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+struct element : pel::intrusive_list_hook<>
+{
+    std::uint64_t value = 0;
+
+    explicit element(std::uint64_t value_) : value{value_} {}
+};
+
+/* std::list and intrusive_list + node_pool behind the same few calls */
+class std_list
+{
+public:
+    using handle = std::list<std::uint64_t>::iterator;
+
+    handle push_back(std::uint64_t value_)
+    {
+        m_items.push_back(value_);
+        return std::prev(m_items.end());
+    }
+
+    handle insert(handle position_, std::uint64_t value_)
+    {
+        return m_items.insert(position_, value_);
+    }
+
+    void erase(handle position_) { m_items.erase(position_); }
+
+    /* Relink the elements in the order of the handles */
+    void reorder(const std::vector<handle>& handles_)
+    {
+        std::list<std::uint64_t> reordered;
+        for(const handle position : handles_)
+        {
+            reordered.splice(reordered.end(), m_items, position);
+        }
+        m_items.swap(reordered);
+    }
+
+    [[nodiscard]] std::uint64_t sum() const
+    {
+        std::uint64_t sum = 0;
+        for(const std::uint64_t value : m_items)
+        {
+            sum += value;
+        }
+        return sum;
+    }
+
+private:
+    std::list<std::uint64_t> m_items;
+};
+
+class pooled_list
+{
+public:
+    using handle = element*;
+
+    pooled_list() = default;
+
+    pooled_list(const pooled_list& copy_)            = delete;
+    pooled_list& operator=(const pooled_list& copy_) = delete;
+
+    ~pooled_list()
+    {
+        m_items.clear_and_dispose([this](element* item_) { m_pool.destroy(item_); });
+    }
+
+    handle push_back(std::uint64_t value_)
+    {
+        element* created = m_pool.create(value_);
+        m_items.push_back(*created);
+        return created;
+    }
+
+    handle insert(handle position_, std::uint64_t value_)
+    {
+        element* created = m_pool.create(value_);
+        m_items.insert(m_items.iterator_to(*position_), *created);
+        return created;
+    }
+
+    void erase(handle position_)
+    {
+        m_items.erase(m_items.iterator_to(*position_));
+        m_pool.destroy(position_);
+    }
+
+    void reorder(const std::vector<handle>& handles_)
+    {
+        pel::intrusive_list<element> reordered;
+        for(const handle position : handles_)
+        {
+            reordered.splice(reordered.end(), m_items, m_items.iterator_to(*position));
+        }
+        m_items = std::move(reordered);
+    }
+
+    [[nodiscard]] std::uint64_t sum() const
+    {
+        std::uint64_t sum = 0;
+        for(const element& item : m_items)
+        {
+            sum += item.value;
+        }
+        return sum;
+    }
+
+private:
+    pel::node_pool<element>      m_pool;
+    pel::intrusive_list<element> m_items;
+};
+
+template<typename ListType>
+void
+measure(const char* label_, std::size_t size_, std::array<double, 4>& baseline_)
+{
+    const std::size_t rounds = std::max<std::size_t>(operation_count / size_, 1);
+    const std::size_t total  = rounds * size_;
+
+    const double build = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            ListType list;
+            for(std::uint64_t i = 0; i < size_; ++i)
+            {
+                static_cast<void>(list.push_back(i));
+            }
+            pel::bench::do_not_optimize(list);
+        }
+    });
+
+    ListType                                list;
+    std::vector<typename ListType::handle> handles;
+    handles.reserve(size_);
+    for(std::uint64_t i = 0; i < size_; ++i)
+    {
+        handles.push_back(list.push_back(i));
+    }
+
+    const auto traverse = [&]() {
+        return pel::bench::best_of(3, [&]() {
+            std::uint64_t sum = 0;
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                sum += list.sum();
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+    };
+    const double ordered = traverse();
+
+    std::uint64_t state = 1;
+    for(std::size_t i = size_ - 1; i > 0; --i)
+    {
+        std::swap(handles[i], handles[split_mix(state) % (i + 1)]);
+    }
+    list.reorder(handles);
+    const double shuffled = traverse();
+
+    /* Erase a random element, insert a new one before another random element */
+    const double churn = pel::bench::best_of(3, [&]() {
+        for(std::size_t i = 0; i < total; ++i)
+        {
+            const std::uint64_t random   = split_mix(state);
+            const std::size_t   erased   = random % size_;
+            std::size_t         position = (random >> 32U) % size_;
+            if(position == erased)
+            {
+                position = (position + 1) % size_;
+            }
+            list.erase(handles[erased]);
+            handles[erased] = list.insert(handles[position], random);
+        }
+        pel::bench::do_not_optimize(list);
+    });
+
+    const std::array<double, 4> results{build, ordered, shuffled, churn};
+    const bool                  isBaseline = baseline_[0] == 0.0;
+    if(isBaseline)
+    {
+        baseline_ = results;
+    }
+
+    constexpr std::array<const char*, 4> names{
+      " push_back", " traverse, in order", " traverse, shuffled", " erase + insert"};
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        pel::bench::print_result(std::string(label_) + names[i],
+                                 results[i],
+                                 total,
+                                 isBaseline ? 0.0 : baseline_[i]);
+    }
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 3>{1024, 65536, 1048576})
+    {
+        pel::bench::print_title(std::to_string(size) + " elements, per element");
+
+        std::array<double, 4> baseline{};
+        measure<std_list>("std::list     ", size, baseline);
+        measure<pooled_list>("intrusive_list", size, baseline);
+    }
+    return 0;
+}
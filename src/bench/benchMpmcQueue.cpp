@@ -0,0 +1,184 @@
+/**
+ * @file    container_base/src/bench/benchMpmcQueue.cpp
+ *
+ * Throughput of mpmc_queue against a std::deque guarded by a mutex and a condition variable,
+ * with 2 to 64 threads split evenly between producers and consumers.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/mpmc_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t item_count     = std::size_t{1} << 19;
+constexpr std::size_t queue_capacity = 1024;
+constexpr std::size_t batch_size     = 32;
+
+class locked_queue
+{
+public:
+    void push(std::uint64_t item_)
+    {
+        {
+            const std::scoped_lock lock(m_mutex);
+            m_queue.push_back(item_);
+        }
+        m_ready.notify_one();
+    }
+
+    void pop(std::uint64_t& item_)
+    {
+        std::unique_lock lock(m_mutex);
+        m_ready.wait(lock, [this]() { return m_queue.empty() == false; });
+        item_ = m_queue.front();
+        m_queue.pop_front();
+    }
+
+private:
+    std::mutex                m_mutex;
+    std::condition_variable   m_ready;
+    std::deque<std::uint64_t> m_queue;
+};
+
+/* Run as many producers as consumers, each handling an equal share of the items */
+template<typename ProducerType, typename ConsumerType>
+void
+run_threads(std::size_t threadCount_, ProducerType&& producer_, ConsumerType&& consumer_)
+{
+    const std::size_t        share = item_count / (threadCount_ / 2);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < threadCount_ / 2; ++i)
+    {
+        threads.emplace_back([&producer_, share]() { producer_(share); });
+        threads.emplace_back([&consumer_, share]() { consumer_(share); });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void
+run_locked(std::size_t threadCount_)
+{
+    locked_queue queue;
+    run_threads(
+      threadCount_,
+      [&queue](std::size_t count_) {
+          for(std::uint64_t i = 0; i < count_; ++i)
+          {
+              queue.push(i);
+          }
+      },
+      [&queue](std::size_t count_) {
+          std::uint64_t sum  = 0;
+          std::uint64_t item = 0;
+          for(std::size_t i = 0; i < count_; ++i)
+          {
+              queue.pop(item);
+              sum += item;
+          }
+          pel::bench::do_not_optimize(sum);
+      });
+}
+
+void
+run_mpmc(std::size_t threadCount_)
+{
+    pel::mpmc_queue<std::uint64_t> queue(queue_capacity);
+    run_threads(
+      threadCount_,
+      [&queue](std::size_t count_) {
+          for(std::uint64_t i = 0; i < count_; ++i)
+          {
+              queue.push(i);
+          }
+      },
+      [&queue](std::size_t count_) {
+          std::uint64_t sum  = 0;
+          std::uint64_t item = 0;
+          for(std::size_t i = 0; i < count_; ++i)
+          {
+              queue.pop(item);
+              sum += item;
+          }
+          pel::bench::do_not_optimize(sum);
+      });
+}
+
+void
+run_mpmc_bulk(std::size_t threadCount_)
+{
+    pel::mpmc_queue<std::uint64_t> queue(queue_capacity);
+    run_threads(
+      threadCount_,
+      [&queue](std::size_t count_) {
+          std::array<std::uint64_t, batch_size> batch{};
+          unsigned                              spins = 0;
+          for(std::size_t sent = 0; sent < count_;)
+          {
+              const std::size_t pushed =
+                queue.try_push_bulk(batch.begin(), std::min(batch_size, count_ - sent));
+              sent += pushed;
+              if(pushed != 0)
+              {
+                  spins = 0;
+              }
+              else
+              {
+                  pel::bench::spin_wait(spins);
+              }
+          }
+      },
+      [&queue](std::size_t count_) {
+          std::array<std::uint64_t, batch_size> batch{};
+          std::uint64_t                         sum   = 0;
+          unsigned                              spins = 0;
+          for(std::size_t received = 0; received < count_;)
+          {
+              const std::size_t popped =
+                queue.try_pop_bulk(batch.begin(), std::min(batch_size, count_ - received));
+              received += popped;
+              sum += batch[0];
+              if(popped != 0)
+              {
+                  spins = 0;
+              }
+              else
+              {
+                  pel::bench::spin_wait(spins);
+              }
+          }
+          pel::bench::do_not_optimize(sum);
+      });
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t threads : std::array<std::size_t, 6>{2, 4, 8, 16, 32, 64})
+    {
+        pel::bench::print_title(std::to_string(threads / 2) + " producers, " +
+                                std::to_string(threads / 2) + " consumers");
+
+        const double locked = pel::bench::best_of(3, [threads]() { run_locked(threads); });
+        const double mpmc   = pel::bench::best_of(3, [threads]() { run_mpmc(threads); });
+        const double bulk   = pel::bench::best_of(3, [threads]() { run_mpmc_bulk(threads); });
+        pel::bench::print_result("mutex + std::deque", locked, item_count);
+        pel::bench::print_result("mpmc_queue push/pop", mpmc, item_count, locked);
+        pel::bench::print_result("mpmc_queue bulk, 32 per call", bulk, item_count, locked);
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file    container_base/src/bench/benchNdarray.cpp
+ *
+ * Transpose, 5-point stencil and matrix product access patterns over 2D ndarrays of doubles in the
+ * row-major, column-major and tiled layouts, all through operator(), with loops written in the
+ * usual row-major order. Each pattern reads one operand along a dimension the row-major layout
+ * does not store contiguously, which is where the tiled layout is expected to pay off.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/ndarray.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace
+{
+using extents_2d = pel::ndarray_extents<2>;
+using tiled      = pel::layout_tiled<8, 8>;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+template<typename LayoutType>
+pel::ndarray<double, 2, LayoutType>
+make_matrix(std::size_t size_, std::uint64_t seed_)
+{
+    pel::ndarray<double, 2, LayoutType> matrix(extents_2d(size_, size_));
+    for(std::size_t i = 0; i < size_; ++i)
+    {
+        for(std::size_t j = 0; j < size_; ++j)
+        {
+            matrix(i, j) = static_cast<double>(split_mix(seed_) % 1024);
+        }
+    }
+    return matrix;
+}
+
+/* Transpose and stencil, per element */
+template<typename LayoutType>
+std::array<double, 2>
+measure_sweeps(std::size_t size_)
+{
+    const auto                          source = make_matrix<LayoutType>(size_, 1);
+    pel::ndarray<double, 2, LayoutType> target(extents_2d(size_, size_));
+
+    const double transpose = pel::bench::best_of(3, [&]() {
+        for(std::size_t i = 0; i < size_; ++i)
+        {
+            for(std::size_t j = 0; j < size_; ++j)
+            {
+                target(j, i) = source(i, j);
+            }
+        }
+        pel::bench::do_not_optimize(target);
+    });
+
+    const double stencil = pel::bench::best_of(3, [&]() {
+        for(std::size_t i = 1; i + 1 < size_; ++i)
+        {
+            for(std::size_t j = 1; j + 1 < size_; ++j)
+            {
+                target(i, j) = source(i - 1, j) + source(i + 1, j) + source(i, j - 1) +
+                               source(i, j + 1) - 4.0 * source(i, j);
+            }
+        }
+        pel::bench::do_not_optimize(target);
+    });
+    return {transpose, stencil};
+}
+
+/* Naive i-j-k product: the inner loop walks a row of the left operand, a column of the right */
+template<typename LayoutType>
+double
+measure_product(std::size_t size_)
+{
+    const auto                          left  = make_matrix<LayoutType>(size_, 2);
+    const auto                          right = make_matrix<LayoutType>(size_, 3);
+    pel::ndarray<double, 2, LayoutType> product(extents_2d(size_, size_));
+
+    return pel::bench::best_of(3, [&]() {
+        for(std::size_t i = 0; i < size_; ++i)
+        {
+            for(std::size_t j = 0; j < size_; ++j)
+            {
+                double sum = 0.0;
+                for(std::size_t k = 0; k < size_; ++k)
+                {
+                    sum += left(i, k) * right(k, j);
+                }
+                product(i, j) = sum;
+            }
+        }
+        pel::bench::do_not_optimize(product);
+    });
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 3>{256, 1024, 4096})
+    {
+        pel::bench::print_title(std::to_string(size) + "x" + std::to_string(size) +
+                                " doubles, per element");
+
+        const std::size_t elements = size * size;
+        const auto        rowMajor = measure_sweeps<pel::layout_row_major>(size);
+        const auto        colMajor = measure_sweeps<pel::layout_column_major>(size);
+        const auto        blocked  = measure_sweeps<tiled>(size);
+        pel::bench::print_result("transpose, row-major", rowMajor[0], elements);
+        pel::bench::print_result("transpose, column-major", colMajor[0], elements, rowMajor[0]);
+        pel::bench::print_result("transpose, tiled 8x8", blocked[0], elements, rowMajor[0]);
+        pel::bench::print_result("stencil, row-major", rowMajor[1], elements);
+        pel::bench::print_result("stencil, column-major", colMajor[1], elements, rowMajor[1]);
+        pel::bench::print_result("stencil, tiled 8x8", blocked[1], elements, rowMajor[1]);
+    }
+
+    for(const std::size_t size : std::array<std::size_t, 3>{128, 256, 512})
+    {
+        pel::bench::print_title("Matrix product, " + std::to_string(size) + "x" +
+                                std::to_string(size) + " doubles, per multiply-add");
+
+        const std::size_t operations = size * size * size;
+        const double      rowMajor   = measure_product<pel::layout_row_major>(size);
+        const double      colMajor   = measure_product<pel::layout_column_major>(size);
+        const double      blocked    = measure_product<tiled>(size);
+        pel::bench::print_result("row-major", rowMajor, operations);
+        pel::bench::print_result("column-major", colMajor, operations, rowMajor);
+        pel::bench::print_result("tiled 8x8", blocked, operations, rowMajor);
+    }
+    return 0;
+}
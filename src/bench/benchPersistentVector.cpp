@@ -0,0 +1,206 @@
+/**
+ * @file    container_base/src/bench/benchPersistentVector.cpp
+ *
+ * persistent_vector and transient_vector against std::vector with a full copy per snapshot, for
+ * 8-byte elements across sizes: single updates and batches of updates that each keep the previous
+ * version, appends, concatenation and iteration.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/persistent_vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* Updates per batch in the batched update measurements */
+constexpr std::size_t batch_size = 1000;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+using persistent = pel::persistent_vector<std::uint64_t>;
+
+persistent
+make_persistent(std::size_t size_)
+{
+    pel::transient_vector<std::uint64_t> building;
+    for(std::uint64_t i = 0; i < size_; ++i)
+    {
+        building.push_back(i);
+    }
+    return building.persistent();
+}
+
+/* One update or one batch of updates per snapshot; every snapshot is kept until the end */
+void
+measure_updates(std::size_t size_)
+{
+    const std::size_t          steps = std::max<std::size_t>((std::size_t{1} << 22) / size_, 16);
+    std::vector<std::size_t>   positions(steps * batch_size);
+    std::uint64_t              state = 1;
+    std::vector<std::uint64_t> items(size_);
+    for(std::size_t& position : positions)
+    {
+        position = split_mix(state) % size_;
+    }
+    for(std::uint64_t i = 0; i < size_; ++i)
+    {
+        items[i] = i;
+    }
+    const persistent source = make_persistent(size_);
+
+    const double copied = pel::bench::best_of(3, [&]() {
+        std::vector<std::vector<std::uint64_t>> snapshots{items};
+        for(std::size_t i = 0; i < steps; ++i)
+        {
+            snapshots.push_back(snapshots.back());
+            snapshots.back()[positions[i]] += 1;
+        }
+        pel::bench::do_not_optimize(snapshots);
+    });
+    const auto   increment = [](std::uint64_t& item_) { item_ += 1; };
+    const double updated   = pel::bench::best_of(3, [&]() {
+        std::vector<persistent> snapshots{source};
+        for(std::size_t i = 0; i < steps; ++i)
+        {
+            snapshots.push_back(snapshots.back().update(positions[i], increment));
+        }
+        pel::bench::do_not_optimize(snapshots);
+    });
+
+    const double copiedBatch = pel::bench::best_of(3, [&]() {
+        std::vector<std::vector<std::uint64_t>> snapshots{items};
+        for(std::size_t i = 0; i < steps; ++i)
+        {
+            snapshots.push_back(snapshots.back());
+            for(std::size_t j = i * batch_size; j < (i + 1) * batch_size; ++j)
+            {
+                snapshots.back()[positions[j]] += 1;
+            }
+        }
+        pel::bench::do_not_optimize(snapshots);
+    });
+    const double transientBatch = pel::bench::best_of(3, [&]() {
+        std::vector<persistent> snapshots{source};
+        for(std::size_t i = 0; i < steps; ++i)
+        {
+            pel::transient_vector<std::uint64_t> editing = snapshots.back().transient();
+            for(std::size_t j = i * batch_size; j < (i + 1) * batch_size; ++j)
+            {
+                editing.update(positions[j], increment);
+            }
+            snapshots.push_back(editing.persistent());
+        }
+        pel::bench::do_not_optimize(snapshots);
+    });
+
+    pel::bench::print_result("std::vector copy + 1 write", copied, steps);
+    pel::bench::print_result("persistent_vector update", updated, steps, copied);
+    pel::bench::print_result("std::vector copy + 1000 writes", copiedBatch, steps);
+    pel::bench::print_result("transient_vector, 1000 updates", transientBatch, steps, copiedBatch);
+}
+
+/* Appends, concatenation and iteration, none of which keep snapshots */
+void
+measure_bulk(std::size_t size_)
+{
+    const double vectorAppend = pel::bench::best_of(3, [&]() {
+        std::vector<std::uint64_t> appended;
+        for(std::uint64_t i = 0; i < size_; ++i)
+        {
+            appended.push_back(i);
+        }
+        pel::bench::do_not_optimize(appended);
+    });
+    const double persistentAppend = pel::bench::best_of(3, [&]() {
+        persistent appended;
+        for(std::uint64_t i = 0; i < size_; ++i)
+        {
+            appended = appended.push_back(i);
+        }
+        pel::bench::do_not_optimize(appended);
+    });
+    const double transientAppend = pel::bench::best_of(3, [&]() {
+        pel::bench::do_not_optimize(make_persistent(size_));
+    });
+
+    std::vector<std::uint64_t> items(size_);
+    for(std::uint64_t i = 0; i < size_; ++i)
+    {
+        items[i] = i;
+    }
+    const persistent source = make_persistent(size_);
+
+    const double vectorConcat = pel::bench::best_of(3, [&]() {
+        std::vector<std::uint64_t> joined = items;
+        joined.insert(joined.end(), items.begin(), items.end());
+        pel::bench::do_not_optimize(joined);
+    });
+    const double persistentConcat = pel::bench::best_of(3, [&]() {
+        pel::bench::do_not_optimize(source.concat(source));
+    });
+
+    const double vectorSum = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::uint64_t item : items)
+        {
+            sum += item;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double iteratorSum = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::uint64_t item : source)
+        {
+            sum += item;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double segmentSum = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        source.for_each_segment([&sum](std::span<const std::uint64_t> segment_) {
+            for(const std::uint64_t item : segment_)
+            {
+                sum += item;
+            }
+        });
+        pel::bench::do_not_optimize(sum);
+    });
+
+    pel::bench::print_result("std::vector push_back", vectorAppend, size_);
+    pel::bench::print_result("persistent_vector push_back", persistentAppend, size_, vectorAppend);
+    pel::bench::print_result("transient_vector push_back", transientAppend, size_, vectorAppend);
+    pel::bench::print_result("std::vector copy + insert", vectorConcat, 1);
+    pel::bench::print_result("persistent_vector concat", persistentConcat, 1, vectorConcat);
+    pel::bench::print_result("std::vector iteration", vectorSum, size_);
+    pel::bench::print_result("persistent_vector iterators", iteratorSum, size_, vectorSum);
+    pel::bench::print_result("persistent_vector for_each_segment", segmentSum, size_, vectorSum);
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 3>{1024, 65536, 1048576})
+    {
+        pel::bench::print_title(std::to_string(size) + " 8-byte elements, per snapshot");
+        measure_updates(size);
+
+        pel::bench::print_title(std::to_string(size) + " 8-byte elements, per element or concat");
+        measure_bulk(size);
+    }
+    return 0;
+}
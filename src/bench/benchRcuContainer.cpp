@@ -0,0 +1,159 @@
+/**
+ * @file    container_base/src/bench/benchRcuContainer.cpp
+ *
+ * Read-side cost of rcu_container against a std::shared_mutex and an
+ * std::atomic<std::shared_ptr>, from 1 to 8 reader threads, with and without a writer replacing
+ * the container in a loop.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/rcu_container.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t read_count     = std::size_t{1} << 20;
+constexpr std::size_t container_size = 64;
+
+using container = std::vector<std::uint64_t>;
+
+class locked_holder
+{
+public:
+    locked_holder() : m_items(container_size, 1) {}
+
+    [[nodiscard]] std::uint64_t read(std::size_t index_) const
+    {
+        const std::shared_lock lock(m_mutex);
+        return m_items[index_ % container_size];
+    }
+
+    void replace(std::uint64_t value_)
+    {
+        container              items(container_size, value_);
+        const std::scoped_lock lock(m_mutex);
+        m_items.swap(items);
+    }
+
+private:
+    mutable std::shared_mutex m_mutex;
+    container                 m_items;
+};
+
+class shared_pointer_holder
+{
+public:
+    [[nodiscard]] std::uint64_t read(std::size_t index_) const
+    {
+        const std::shared_ptr<const container> items = m_items.load(std::memory_order_acquire);
+        return (*items)[index_ % container_size];
+    }
+
+    void replace(std::uint64_t value_)
+    {
+        m_items.store(std::make_shared<const container>(container_size, value_),
+                      std::memory_order_release);
+    }
+
+private:
+    std::atomic<std::shared_ptr<const container>> m_items{
+      std::make_shared<const container>(container_size, 1)};
+};
+
+class rcu_holder
+{
+public:
+    [[nodiscard]] std::uint64_t read(std::size_t index_) const
+    {
+        const auto guard = m_items.read();
+        return (*guard)[index_ % container_size];
+    }
+
+    void replace(std::uint64_t value_)
+    {
+        m_items.publish(std::make_unique<container>(container_size, value_));
+    }
+
+private:
+    pel::rcu_container<container> m_items{std::make_unique<container>(container_size, 1)};
+};
+
+/* Share read_count reads between the readers, while an optional writer replaces the container */
+template<typename HolderType>
+void
+run_readers(std::size_t readerCount_, bool withWriter_)
+{
+    HolderType        holder;
+    std::atomic<bool> done{false};
+    std::thread       writer;
+    if(withWriter_)
+    {
+        writer = std::thread([&holder, &done]() {
+            for(std::uint64_t i = 0; done.load(std::memory_order_relaxed) == false; ++i)
+            {
+                holder.replace(i);
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    const std::size_t        share = read_count / readerCount_;
+    std::vector<std::thread> readers;
+    for(std::size_t r = 0; r < readerCount_; ++r)
+    {
+        readers.emplace_back([&holder, share]() {
+            std::uint64_t sum = 0;
+            for(std::size_t i = 0; i < share; ++i)
+            {
+                sum += holder.read(i);
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+    }
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    done.store(true, std::memory_order_relaxed);
+    if(writer.joinable())
+    {
+        writer.join();
+    }
+}
+}        // namespace
+
+int
+main()
+{
+    for(const bool withWriter : {false, true})
+    {
+        for(const std::size_t readers : std::array<std::size_t, 4>{1, 2, 4, 8})
+        {
+            pel::bench::print_title("Reader threads: " + std::to_string(readers) +
+                                    (withWriter ? ", one writer replacing the container" : ""));
+
+            const double locked = pel::bench::best_of(
+              3, [readers, withWriter]() { run_readers<locked_holder>(readers, withWriter); });
+            const double shared = pel::bench::best_of(3, [readers, withWriter]() {
+                run_readers<shared_pointer_holder>(readers, withWriter);
+            });
+            const double rcu = pel::bench::best_of(
+              3, [readers, withWriter]() { run_readers<rcu_holder>(readers, withWriter); });
+            pel::bench::print_result("std::shared_mutex", locked, read_count);
+            pel::bench::print_result("std::atomic<std::shared_ptr>", shared, read_count, locked);
+            pel::bench::print_result("rcu_container", rcu, read_count, locked);
+        }
+    }
+    return 0;
+}
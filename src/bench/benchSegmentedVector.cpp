@@ -0,0 +1,137 @@
+/**
+ * @file    container_base/src/bench/benchSegmentedVector.cpp
+ *
+ * Concurrent push_back throughput of segmented_vector against a std::vector guarded by a mutex,
+ * then the cost of reading everything back.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/segmented_vector.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t item_count = std::size_t{1} << 21;
+
+class locked_vector
+{
+public:
+    void push_back(std::uint64_t item_)
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_items.push_back(item_);
+    }
+
+    void reserve(std::size_t capacity_) { m_items.reserve(capacity_); }
+
+    [[nodiscard]] const std::vector<std::uint64_t>& items() const noexcept { return m_items; }
+
+private:
+    std::mutex                 m_mutex;
+    std::vector<std::uint64_t> m_items;
+};
+
+/* Split item_count pushes between a number of threads */
+template<typename PushType>
+void
+push_from_threads(std::size_t threadCount_, PushType&& push_)
+{
+    const std::size_t        share = item_count / threadCount_;
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < threadCount_; ++t)
+    {
+        threads.emplace_back([&push_, share]() {
+            for(std::uint64_t i = 0; i < share; ++i)
+            {
+                push_(i);
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+template<typename ContainerType>
+void
+push_all(std::size_t threadCount_, bool reserve_)
+{
+    ContainerType container;
+    if(reserve_)
+    {
+        container.reserve(item_count);
+    }
+    push_from_threads(threadCount_, [&container](std::uint64_t item_) {
+        static_cast<void>(container.push_back(item_));
+    });
+    pel::bench::do_not_optimize(container);
+}
+
+template<typename RangeType>
+std::uint64_t
+sum_of(const RangeType& range_)
+{
+    std::uint64_t sum = 0;
+    for(const std::uint64_t item : range_)
+    {
+        sum += item;
+    }
+    return sum;
+}
+}        // namespace
+
+int
+main()
+{
+    using segmented = pel::segmented_vector<std::uint64_t>;
+
+    for(const std::size_t threads : std::array<std::size_t, 4>{1, 2, 4, 8})
+    {
+        pel::bench::print_title("push_back from " + std::to_string(threads) + " threads");
+
+        const double locked =
+          pel::bench::best_of(3, [threads]() { push_all<locked_vector>(threads, false); });
+        const double lockedReserved =
+          pel::bench::best_of(3, [threads]() { push_all<locked_vector>(threads, true); });
+        const double segments =
+          pel::bench::best_of(3, [threads]() { push_all<segmented>(threads, false); });
+        const double segmentsReserved =
+          pel::bench::best_of(3, [threads]() { push_all<segmented>(threads, true); });
+        pel::bench::print_result("mutex + std::vector", locked, item_count);
+        pel::bench::print_result("mutex + std::vector, reserved", lockedReserved, item_count,
+                                 locked);
+        pel::bench::print_result("segmented_vector", segments, item_count, locked);
+        pel::bench::print_result("segmented_vector, reserved", segmentsReserved, item_count,
+                                 locked);
+    }
+
+    pel::bench::print_title("Reading every element once");
+    locked_vector vector;
+    segmented     segments;
+    for(std::uint64_t i = 0; i < item_count; ++i)
+    {
+        vector.push_back(i);
+        segments.push_back(i);
+    }
+    const double contiguous =
+      pel::bench::best_of(5, [&vector]() { pel::bench::do_not_optimize(sum_of(vector.items())); });
+    const double iterated =
+      pel::bench::best_of(5, [&segments]() { pel::bench::do_not_optimize(sum_of(segments)); });
+    const double spans = pel::bench::best_of(5, [&segments]() {
+        std::uint64_t sum = 0;
+        segments.for_each_segment([&sum](auto span_) { sum += sum_of(span_); });
+        pel::bench::do_not_optimize(sum);
+    });
+    pel::bench::print_result("std::vector", contiguous, item_count);
+    pel::bench::print_result("segmented_vector iterator", iterated, item_count, contiguous);
+    pel::bench::print_result("segmented_vector for_each_segment", spans, item_count, contiguous);
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file    container_base/src/bench/benchSlotMap.cpp
+ *
+ * Iteration, lookups through handles and churn (erase one, insert one) in slot_map against a
+ * std::unordered_map keyed by id and a std::vector with tombstones and a free list, across sizes.
+ * Half of the elements are erased before iterating, leaving holes in the tombstone vector.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/slot_map.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/* Every measurement performs about this many operations */
+constexpr std::size_t operation_count = std::size_t{1} << 21;
+
+struct entity
+{
+    double x  = 0.0;
+    double y  = 0.0;
+    double vx = 1.0;
+    double vy = 1.0;
+};
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/* The usual hand-rolled alternative: erased entries are flagged and their index reused */
+class tombstone_vector
+{
+public:
+    using HandleType = std::uint32_t;
+
+    HandleType insert(const entity& value_)
+    {
+        if(m_free.empty())
+        {
+            m_values.push_back(value_);
+            m_alive.push_back(1);
+            return static_cast<HandleType>(m_values.size() - 1);
+        }
+        const HandleType index = m_free.back();
+        m_free.pop_back();
+        m_values[index] = value_;
+        m_alive[index]  = 1;
+        return index;
+    }
+
+    void erase(HandleType handle_)
+    {
+        m_alive[handle_] = 0;
+        m_free.push_back(handle_);
+    }
+
+    [[nodiscard]] entity& operator[](HandleType handle_) { return m_values[handle_]; }
+
+    template<typename FunctionType>
+    void for_each(FunctionType&& function_)
+    {
+        for(std::size_t i = 0; i < m_values.size(); ++i)
+        {
+            if(m_alive[i] != 0)
+            {
+                function_(m_values[i]);
+            }
+        }
+    }
+
+private:
+    std::vector<entity>        m_values;
+    std::vector<std::uint8_t>  m_alive;
+    std::vector<std::uint32_t> m_free;
+};
+
+class hash_map
+{
+public:
+    using HandleType = std::uint64_t;
+
+    HandleType insert(const entity& value_)
+    {
+        m_values.emplace(m_next, value_);
+        return m_next++;
+    }
+
+    void erase(HandleType handle_) { m_values.erase(handle_); }
+
+    [[nodiscard]] entity& operator[](HandleType handle_) { return m_values[handle_]; }
+
+    template<typename FunctionType>
+    void for_each(FunctionType&& function_)
+    {
+        for(auto& [key, value] : m_values)
+        {
+            function_(value);
+        }
+    }
+
+private:
+    std::unordered_map<std::uint64_t, entity> m_values;
+    std::uint64_t                             m_next = 0;
+};
+
+class packed_slots
+{
+public:
+    using HandleType = pel::slot_handle;
+
+    HandleType insert(const entity& value_) { return m_values.insert(value_); }
+
+    void erase(HandleType handle_) { m_values.erase(handle_); }
+
+    [[nodiscard]] entity& operator[](HandleType handle_) { return m_values[handle_]; }
+
+    template<typename FunctionType>
+    void for_each(FunctionType&& function_)
+    {
+        for(entity& value : m_values)
+        {
+            function_(value);
+        }
+    }
+
+private:
+    pel::slot_map<entity> m_values;
+};
+
+template<typename MapType>
+void
+measure(const char* label_, std::size_t size_, std::array<double, 3>& baseline_)
+{
+    using HandleType = typename MapType::HandleType;
+
+    /* Insert twice the size, then erase every other element at random */
+    MapType                 map;
+    std::vector<HandleType> handles;
+    for(std::size_t i = 0; i < 2 * size_; ++i)
+    {
+        handles.push_back(map.insert(entity{}));
+    }
+    std::uint64_t state = 1;
+    for(std::size_t i = handles.size(); i > 1; --i)
+    {
+        std::swap(handles[i - 1], handles[split_mix(state) % i]);
+    }
+    for(std::size_t i = size_; i < 2 * size_; ++i)
+    {
+        map.erase(handles[i]);
+    }
+    handles.resize(size_);
+
+    const std::size_t rounds = std::max<std::size_t>(operation_count / size_, 1);
+    const std::size_t total  = rounds * size_;
+
+    const double iterate = pel::bench::best_of(3, [&]() {
+        for(std::size_t r = 0; r < rounds; ++r)
+        {
+            map.for_each([](entity& value_) {
+                value_.x += value_.vx;
+                value_.y += value_.vy;
+            });
+        }
+        pel::bench::do_not_optimize(map);
+    });
+
+    std::vector<std::size_t> order(operation_count);
+    for(std::size_t& index : order)
+    {
+        index = split_mix(state) % size_;
+    }
+    const double lookup = pel::bench::best_of(3, [&]() {
+        double sum = 0.0;
+        for(const std::size_t index : order)
+        {
+            sum += map[handles[index]].x;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    const double churn = pel::bench::best_of(3, [&]() {
+        for(const std::size_t index : order)
+        {
+            map.erase(handles[index]);
+            handles[index] = map.insert(entity{});
+        }
+        pel::bench::do_not_optimize(map);
+    });
+
+    const std::array<double, 3> results{iterate, lookup, churn};
+    const bool                  isBaseline = baseline_[0] == 0.0;
+    if(isBaseline)
+    {
+        baseline_ = results;
+    }
+
+    const std::array<std::size_t, 3>    operations{total, operation_count, operation_count};
+    constexpr std::array<const char*, 3> names{" iterate", " lookup", " erase + insert"};
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        pel::bench::print_result(std::string(label_) + names[i],
+                                 results[i],
+                                 operations[i],
+                                 isBaseline ? 0.0 : baseline_[i]);
+    }
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 3>{1024, 65536, 1048576})
+    {
+        pel::bench::print_title(std::to_string(size) + " live elements, per operation");
+
+        std::array<double, 3> baseline{};
+        measure<hash_map>("std::unordered_map", size, baseline);
+        measure<tombstone_vector>("tombstone vector  ", size, baseline);
+        measure<packed_slots>("slot_map          ", size, baseline);
+    }
+    return 0;
+}
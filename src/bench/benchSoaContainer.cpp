@@ -0,0 +1,171 @@
+/**
+ * @file    container_base/src/bench/benchSoaContainer.cpp
+ *
+ * Scans touching one field, updates touching a few fields and whole-record reads in
+ * soa_container against a std::vector of the same 64-byte records (array of structures), across
+ * container sizes.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/soa_container.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+/* Every measurement visits about this many records */
+constexpr std::size_t visited_records = std::size_t{1} << 23;
+
+struct body
+{
+    double        x    = 0.0;
+    double        y    = 0.0;
+    double        z    = 0.0;
+    double        vx   = 0.0;
+    double        vy   = 0.0;
+    double        vz   = 0.0;
+    double        mass = 0.0;
+    std::uint64_t id   = 0;
+};
+}        // namespace
+
+template<>
+struct pel::soa_fields<body>
+{
+    static constexpr auto members = std::tuple{
+      &body::x, &body::y, &body::z, &body::vx, &body::vy, &body::vz, &body::mass, &body::id};
+};
+
+namespace
+{
+using body_container = pel::soa_container<body>;
+
+body
+make_body(std::size_t index_)
+{
+    const auto value = static_cast<double>(index_);
+    return body{value, value, value, 1.0, 2.0, 3.0, value, index_};
+}
+
+void
+print_results(const char* operation_, double aos_, double soa_, std::size_t records_)
+{
+    pel::bench::print_result(std::string("std::vector,   ") + operation_, aos_, records_);
+    pel::bench::print_result(std::string("soa_container, ") + operation_, soa_, records_, aos_);
+}
+}        // namespace
+
+int
+main()
+{
+    for(const std::size_t size : std::array<std::size_t, 4>{1024, 16384, 262144, 4194304})
+    {
+        pel::bench::print_title(std::to_string(size) + " records of " +
+                                std::to_string(sizeof(body)) + " bytes, per record");
+
+        std::vector<body> aos;
+        body_container    soa;
+        aos.reserve(size);
+        soa.reserve(size);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            aos.push_back(make_body(i));
+            soa.push_back(make_body(i));
+        }
+        const std::size_t rounds  = std::max<std::size_t>(visited_records / size, 1);
+        const std::size_t records = rounds * size;
+
+        /* One field out of eight */
+        const double aosSum = pel::bench::best_of(3, [&]() {
+            double sum = 0.0;
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                for(const body& item : aos)
+                {
+                    sum += item.mass;
+                }
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+        const double soaSum = pel::bench::best_of(3, [&]() {
+            double sum = 0.0;
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                for(const double mass : soa.column<&body::mass>())
+                {
+                    sum += mass;
+                }
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+        print_results("sum of one field", aosSum, soaSum, records);
+
+        /* Six fields out of eight, three of them written */
+        const double aosMove = pel::bench::best_of(3, [&]() {
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                for(body& item : aos)
+                {
+                    item.x += item.vx;
+                    item.y += item.vy;
+                    item.z += item.vz;
+                }
+            }
+            pel::bench::do_not_optimize(aos);
+        });
+        const double soaMove = pel::bench::best_of(3, [&]() {
+            const auto xs  = soa.column<&body::x>();
+            const auto ys  = soa.column<&body::y>();
+            const auto zs  = soa.column<&body::z>();
+            const auto vxs = soa.column<&body::vx>();
+            const auto vys = soa.column<&body::vy>();
+            const auto vzs = soa.column<&body::vz>();
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    xs[i] += vxs[i];
+                    ys[i] += vys[i];
+                    zs[i] += vzs[i];
+                }
+            }
+            pel::bench::do_not_optimize(soa);
+        });
+        print_results("position update", aosMove, soaMove, records);
+
+        /* Every field: the proxies gather whole records */
+        const double aosRecords = pel::bench::best_of(3, [&]() {
+            std::uint64_t sum = 0;
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                for(const body& item : aos)
+                {
+                    sum += item.id + static_cast<std::uint64_t>(item.x + item.y + item.z + item.vx +
+                                                                item.vy + item.vz + item.mass);
+                }
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+        const double soaRecords = pel::bench::best_of(3, [&]() {
+            std::uint64_t sum = 0;
+            for(std::size_t r = 0; r < rounds; ++r)
+            {
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    const body item = soa.get(i);
+                    sum += item.id + static_cast<std::uint64_t>(item.x + item.y + item.z + item.vx +
+                                                                item.vy + item.vz + item.mass);
+                }
+            }
+            pel::bench::do_not_optimize(sum);
+        });
+        print_results("whole-record read", aosRecords, soaRecords, records);
+    }
+    return 0;
+}
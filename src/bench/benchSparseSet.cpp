@@ -0,0 +1,335 @@
+/**
+ * @file    container_base/src/bench/benchSparseSet.cpp
+ *
+ * Memory use, insertion, lookups, iteration and erasure of sparse_set and sparse_vector against a
+ * dense array indexed by key and against the standard hash containers, for keys drawn from a 2^24
+ * key range at several occupancies, either uniformly at random or in runs of consecutive keys.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/sparse_set.hpp"
+#include "src/sparse_vector.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t key_range = std::size_t{1} << 24;
+
+std::uint64_t
+split_mix(std::uint64_t& state_)
+{
+    std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+    value               = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value               = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/* Runs of consecutive keys, such as IDs handed out in batches */
+constexpr std::size_t run_length = 64;
+
+/* Distinct keys from the key range, at random or in runs starting at random keys */
+std::vector<std::uint32_t>
+make_keys(std::size_t count_, bool clustered_, std::uint64_t seed_)
+{
+    std::vector<bool>          taken(key_range, false);
+    std::vector<std::uint32_t> keys;
+    keys.reserve(count_);
+    while(keys.size() < count_)
+    {
+        const std::size_t start  = split_mix(seed_) % key_range;
+        const std::size_t length = clustered_ ? run_length : 1;
+        for(std::size_t key = start; key < start + length && key < key_range; ++key)
+        {
+            if(taken[key] == false && keys.size() < count_)
+            {
+                taken[key] = true;
+                keys.push_back(static_cast<std::uint32_t>(key));
+            }
+        }
+    }
+    return keys;
+}
+
+/* Nodes and bucket array of a libstdc++ hash container, without allocator overhead */
+template<typename HashType>
+std::size_t
+hash_bytes(const HashType& hash_, std::size_t valueBytes_)
+{
+    return hash_.bucket_count() * sizeof(void*) + hash_.size() * (sizeof(void*) + valueBytes_);
+}
+
+class dense_set
+{
+public:
+    dense_set() : m_present(key_range, false) {}
+
+    bool insert(std::uint32_t key_)
+    {
+        const bool inserted = m_present[key_] == false;
+        m_present[key_]     = true;
+        return inserted;
+    }
+
+    bool erase(std::uint32_t key_)
+    {
+        const bool erased = m_present[key_];
+        m_present[key_]   = false;
+        return erased;
+    }
+
+    [[nodiscard]] bool contains(std::uint32_t key_) const { return m_present[key_]; }
+
+    [[nodiscard]] std::uint64_t sum() const
+    {
+        std::uint64_t sum = 0;
+        for(std::size_t key = 0; key < key_range; ++key)
+        {
+            sum += m_present[key] ? key : 0;
+        }
+        return sum;
+    }
+
+    [[nodiscard]] std::size_t memory_bytes() const { return key_range / 8; }
+
+private:
+    std::vector<bool> m_present;
+};
+
+class hash_set
+{
+public:
+    bool insert(std::uint32_t key_) { return m_keys.insert(key_).second; }
+    bool erase(std::uint32_t key_) { return m_keys.erase(key_) != 0; }
+
+    [[nodiscard]] bool contains(std::uint32_t key_) const { return m_keys.contains(key_); }
+
+    [[nodiscard]] std::uint64_t sum() const
+    {
+        std::uint64_t sum = 0;
+        for(const std::uint32_t key : m_keys)
+        {
+            sum += key;
+        }
+        return sum;
+    }
+
+    [[nodiscard]] std::size_t memory_bytes() const
+    {
+        return hash_bytes(m_keys, sizeof(std::uint32_t));
+    }
+
+private:
+    std::unordered_set<std::uint32_t> m_keys;
+};
+
+class sparse_set
+{
+public:
+    bool insert(std::uint32_t key_) { return m_keys.insert(key_); }
+    bool erase(std::uint32_t key_) { return m_keys.erase(key_); }
+
+    [[nodiscard]] bool contains(std::uint32_t key_) const { return m_keys.contains(key_); }
+
+    [[nodiscard]] std::uint64_t sum() const
+    {
+        std::uint64_t sum = 0;
+        for(const std::uint32_t key : m_keys)
+        {
+            sum += key;
+        }
+        return sum;
+    }
+
+    [[nodiscard]] std::size_t memory_bytes() const { return m_keys.memory_bytes(); }
+
+private:
+    pel::sparse_set<std::uint32_t> m_keys;
+};
+
+template<typename SetType>
+void
+measure_set(const char*                       label_,
+            const std::vector<std::uint32_t>& keys_,
+            const std::vector<std::uint32_t>& probes_,
+            std::array<double, 4>&            baseline_)
+{
+    const double insert = pel::bench::best_of(3, [&]() {
+        SetType set;
+        for(const std::uint32_t key : keys_)
+        {
+            static_cast<void>(set.insert(key));
+        }
+        pel::bench::do_not_optimize(set);
+    });
+
+    SetType set;
+    for(const std::uint32_t key : keys_)
+    {
+        static_cast<void>(set.insert(key));
+    }
+    const double lookup = pel::bench::best_of(3, [&]() {
+        std::size_t found = 0;
+        for(const std::uint32_t probe : probes_)
+        {
+            found += set.contains(probe) ? 1U : 0U;
+        }
+        pel::bench::do_not_optimize(found);
+    });
+    const double iterate =
+      pel::bench::best_of(3, [&set]() { pel::bench::do_not_optimize(set.sum()); });
+    const double erase = pel::bench::best_of(3, [&]() {
+        SetType copy = set;
+        for(const std::uint32_t key : keys_)
+        {
+            static_cast<void>(copy.erase(key));
+        }
+        pel::bench::do_not_optimize(copy);
+    });
+
+    const std::array<double, 4> results{insert, lookup, iterate, erase};
+    const bool                  isBaseline = baseline_[0] == 0.0;
+    if(isBaseline)
+    {
+        baseline_ = results;
+    }
+
+    std::cout << "  " << label_ << " memory: " << std::fixed << std::setprecision(2)
+              << static_cast<double>(set.memory_bytes()) / static_cast<double>(keys_.size())
+              << " bytes per key\n";
+    constexpr std::array<const char*, 4> names{
+      " insert", " contains (half miss)", " iterate", " copy + erase all"};
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        pel::bench::print_result(std::string(label_) + names[i],
+                                 results[i],
+                                 i == 1 ? probes_.size() : keys_.size(),
+                                 isBaseline ? 0.0 : baseline_[i]);
+    }
+}
+
+/* Value lookups by key and a scan of the values, with 64-bit values */
+void
+measure_map(const std::vector<std::uint32_t>& keys_, const std::vector<std::uint32_t>& probes_)
+{
+    std::vector<std::uint64_t> dense(key_range, 0);
+    std::vector<bool>          present(key_range, false);
+
+    std::unordered_map<std::uint32_t, std::uint64_t> hash;
+    pel::sparse_vector<std::uint64_t>                sparse;
+    for(const std::uint32_t key : keys_)
+    {
+        dense[key]   = key;
+        present[key] = true;
+        hash.emplace(key, key);
+        static_cast<void>(sparse.insert(key, key));
+    }
+
+    const auto perKey = [&keys_](std::size_t bytes_) {
+        return static_cast<double>(bytes_) / static_cast<double>(keys_.size());
+    };
+    std::cout << "  value memory, bytes per key: dense " << std::fixed << std::setprecision(2)
+              << perKey(key_range * sizeof(std::uint64_t) + key_range / 8) << ", hash "
+              << perKey(hash_bytes(hash, sizeof(std::pair<const std::uint32_t, std::uint64_t>)))
+              << ", sparse_vector " << perKey(sparse.memory_bytes()) << "\n";
+
+    const double denseFind = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::uint32_t probe : probes_)
+        {
+            sum += present[probe] ? dense[probe] : 0;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double hashFind = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::uint32_t probe : probes_)
+        {
+            const auto found = hash.find(probe);
+            sum += found == hash.end() ? 0 : found->second;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double sparseFind = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::uint32_t probe : probes_)
+        {
+            const std::uint64_t* value = sparse.get(probe);
+            sum += value == nullptr ? 0 : *value;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    const double denseScan = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(std::size_t key = 0; key < key_range; ++key)
+        {
+            sum += present[key] ? dense[key] : 0;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double hashScan = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const auto& [key, value] : hash)
+        {
+            sum += value;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+    const double sparseScan = pel::bench::best_of(3, [&]() {
+        std::uint64_t sum = 0;
+        for(const std::uint64_t value : sparse)
+        {
+            sum += value;
+        }
+        pel::bench::do_not_optimize(sum);
+    });
+
+    pel::bench::print_result("dense array get", denseFind, probes_.size());
+    pel::bench::print_result("std::unordered_map get", hashFind, probes_.size(), denseFind);
+    pel::bench::print_result("sparse_vector get", sparseFind, probes_.size(), denseFind);
+    pel::bench::print_result("dense array scan", denseScan, keys_.size());
+    pel::bench::print_result("std::unordered_map scan", hashScan, keys_.size(), denseScan);
+    pel::bench::print_result("sparse_vector scan", sparseScan, keys_.size(), denseScan);
+}
+}        // namespace
+
+int
+main()
+{
+    for(const bool clustered : {false, true})
+    {
+        for(const std::size_t count : std::array<std::size_t, 4>{16384, 262144, 1048576, 4194304})
+        {
+            pel::bench::print_title(std::to_string(count) + (clustered ? " clustered" : " random") +
+                                    " keys out of " + std::to_string(key_range) +
+                                    ", per operation");
+
+            /* Probes are half keys present, half random keys that are almost all missing */
+            const std::vector<std::uint32_t> keys = make_keys(count, clustered, 1);
+            std::vector<std::uint32_t>       probes(count);
+            std::uint64_t                    state = 7;
+            for(std::uint32_t& probe : probes)
+            {
+                const std::uint64_t random = split_mix(state);
+                probe = (random & 1U) == 0 ? keys[random % count]
+                                           : static_cast<std::uint32_t>((random >> 1U) % key_range);
+            }
+
+            std::array<double, 4> baseline{};
+            measure_set<dense_set>("dense bitmap      ", keys, probes, baseline);
+            measure_set<hash_set>("std::unordered_set", keys, probes, baseline);
+            measure_set<sparse_set>("sparse_set        ", keys, probes, baseline);
+            measure_map(keys, probes);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+/**
+ * @file    container_base/src/bench/benchSpscRingBuffer.cpp
+ *
+ * Messages per second and hand-off latency between a producer and a consumer pinned to cores 0
+ * and 1, through spsc_ring_buffer and through a mutex-protected std::deque.
+ */
+
+#include "src/bench/benchUtilities.hpp"
+#include "src/spsc_ring_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t message_count   = std::size_t{1} << 21;
+constexpr std::size_t latency_count   = 20000;
+constexpr std::size_t buffer_capacity = 1024;
+constexpr std::size_t batch_size      = 64;
+
+struct message
+{
+    std::uint64_t sequence = 0;
+    std::int64_t  sentAt   = 0;
+};
+
+/* The queue pipeline threads hand batches through today */
+class mutex_queue
+{
+public:
+    void push(const message& message_)
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_queue.push_back(message_);
+    }
+
+    bool try_pop(message& message_)
+    {
+        const std::scoped_lock lock(m_mutex);
+        if(m_queue.empty())
+        {
+            return false;
+        }
+        message_ = m_queue.front();
+        m_queue.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex          m_mutex;
+    std::deque<message> m_queue;
+};
+
+std::int64_t
+now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             pel::bench::clock::now().time_since_epoch())
+      .count();
+}
+
+/* Run a producer on core 0 and a consumer on core 1 */
+template<typename ProducerType, typename ConsumerType>
+void
+run_pair(ProducerType&& producer_, ConsumerType&& consumer_)
+{
+    std::thread consumer([&consumer_]() {
+        static_cast<void>(pel::bench::pin_to_core(1));
+        consumer_();
+    });
+    static_cast<void>(pel::bench::pin_to_core(0));
+    producer_();
+    consumer.join();
+}
+
+void
+throughput_mutex()
+{
+    mutex_queue   queue;
+    std::uint64_t sum = 0;
+    run_pair(
+      [&queue]() {
+          for(std::size_t i = 0; i < message_count; ++i)
+          {
+              queue.push(message{i, 0});
+          }
+      },
+      [&queue, &sum]() {
+          message  received;
+          unsigned spins = 0;
+          for(std::size_t i = 0; i < message_count;)
+          {
+              if(queue.try_pop(received))
+              {
+                  sum += received.sequence;
+                  ++i;
+                  spins = 0;
+              }
+              else
+              {
+                  pel::bench::spin_wait(spins);
+              }
+          }
+      });
+    pel::bench::do_not_optimize(sum);
+}
+
+void
+throughput_spsc()
+{
+    pel::spsc_ring_buffer<message> buffer(buffer_capacity);
+    std::uint64_t                  sum = 0;
+    run_pair(
+      [&buffer]() {
+          unsigned spins = 0;
+          for(std::size_t i = 0; i < message_count;)
+          {
+              if(buffer.try_push(message{i, 0}))
+              {
+                  ++i;
+                  spins = 0;
+              }
+              else
+              {
+                  pel::bench::spin_wait(spins);
+              }
+          }
+      },
+      [&buffer, &sum]() {
+          message  received;
+          unsigned spins = 0;
+          for(std::size_t i = 0; i < message_count;)
+          {
+              if(buffer.try_pop(received))
+              {
+                  sum += received.sequence;
+                  ++i;
+                  spins = 0;
+              }
+              else
+              {
+                  pel::bench::spin_wait(spins);
+              }
+          }
+      });
+    pel::bench::do_not_optimize(sum);
+}
+
+void
+throughput_spsc_batched()
+{
+    pel::spsc_ring_buffer<message> buffer(buffer_capacity);
+    std::uint64_t                  sum = 0;
+    run_pair(
+      [&buffer]() {
+          unsigned    spins = 0;
+          std::size_t next  = 0;
+          while(next < message_count)
+          {
+              const std::size_t pushed =
+                buffer.push_n(std::min(batch_size, message_count - next),
+                              [&next](std::span<message> slots_) {
+                                  for(message& slot : slots_)
+                                  {
+                                      slot = message{next++, 0};
+                                  }
+                              });
+              if(pushed != 0)
+              {
+                  spins = 0;
+              }
+              else
+              {
+                  pel::bench::spin_wait(spins);
+              }
+          }
+      },
+      [&buffer, &sum]() {
+          unsigned spins = 0;
+          for(std::size_t i = 0; i < message_count;)
+          {
+              const std::size_t popped =
+                buffer.pop_n(batch_size, [&sum](std::span<message> messages_) {
+                    for(const message& received : messages_)
+                    {
+                        sum += received.sequence;
+                    }
+                });
+              if(popped != 0)
+              {
+                  i += popped;
+                  spins = 0;
+              }
+              else
+              {
+                  pel::bench::spin_wait(spins);
+              }
+          }
+      });
+    pel::bench::do_not_optimize(sum);
+}
+
+/* One message in flight at a time: the producer waits for each message to be consumed */
+template<typename PushType, typename PopType>
+std::vector<double>
+latencies(PushType&& push_, PopType&& pop_)
+{
+    std::vector<double>      samples(latency_count);
+    std::atomic<std::size_t> consumed{0};
+    run_pair(
+      [&push_, &consumed]() {
+        for(std::size_t i = 0; i < latency_count; ++i)
+        {
+            push_(message{i, now()});
+            unsigned spins = 0;
+            while(consumed.load(std::memory_order_acquire) == i)
+            {
+                pel::bench::spin_wait(spins);
+            }
+        }
+      },
+      [&pop_, &consumed, &samples]() {
+        message  received;
+        unsigned spins = 0;
+        for(std::size_t i = 0; i < latency_count;)
+        {
+            if(pop_(received))
+            {
+                samples[i] = static_cast<double>(now() - received.sentAt);
+                consumed.store(++i, std::memory_order_release);
+                spins = 0;
+            }
+            else
+            {
+                pel::bench::spin_wait(spins);
+            }
+        }
+      });
+
+    std::ranges::sort(samples);
+    return samples;
+}
+
+void
+print_latencies(const char* label_, const std::vector<double>& samples_)
+{
+    constexpr std::pair<const char*, double> percentiles[] = {
+      {"p50", 0.50}, {"p90", 0.90}, {"p99", 0.99}, {"p99.9", 0.999}};
+
+    std::cout << "  " << label_ << std::setprecision(0);
+    for(const auto& [name, fraction] : percentiles)
+    {
+        std::cout << "  " << name << " " << std::setw(6)
+                  << pel::bench::percentile(samples_, fraction) << " ns";
+    }
+    std::cout << "  max " << samples_.back() << " ns\n";
+}
+}        // namespace
+
+int
+main()
+{
+    if(std::thread::hardware_concurrency() < 2)
+    {
+        std::cout << "Fewer than two cores: producer and consumer share a core, results are not "
+                     "representative\n";
+    }
+
+    pel::bench::print_title("Throughput, one producer and one consumer");
+    const double baseline = pel::bench::best_of(3, throughput_mutex);
+    const double single   = pel::bench::best_of(3, throughput_spsc);
+    const double batched  = pel::bench::best_of(3, throughput_spsc_batched);
+    pel::bench::print_result("mutex + std::deque", baseline, message_count);
+    pel::bench::print_result("spsc_ring_buffer try_push/try_pop", single, message_count, baseline);
+    pel::bench::print_result("spsc_ring_buffer push_n/pop_n", batched, message_count, baseline);
+
+    pel::bench::print_title("Hand-off latency, one message in flight");
+    mutex_queue queue;
+    print_latencies("mutex + std::deque",
+                    latencies([&queue](const message& message_) { queue.push(message_); },
+                              [&queue](message& message_) { return queue.try_pop(message_); }));
+    pel::spsc_ring_buffer<message> buffer(buffer_capacity);
+    print_latencies("spsc_ring_buffer  ",
+                    latencies(
+                      [&buffer](const message& message_) {
+                          static_cast<void>(buffer.try_push(message_));
+                      },
+                      [&buffer](message& message_) { return buffer.try_pop(message_); }));
+    return 0;
+}
@@ -0,0 +1,220 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "src/hardware.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+
+namespace pel::bench
+{
+/*************************************************************************************************/
+/* Types --------------------------------------------------------------------------------------- */
+
+using clock = std::chrono::steady_clock;
+
+
+/*************************************************************************************************/
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Keep the optimizer from discarding a value, or the computation producing it.
+ *
+ * \param       value_: Value to keep alive.
+ *************************************************************************************************/
+template<typename ValueType>
+inline void
+do_not_optimize(const ValueType& value_) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value_) : "memory");
+#else
+    static const volatile void* volatile sink = nullptr;
+    sink                                       = &value_;
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Time a callable several times and keep the fastest run.
+ *
+ * \param       repeats_:  Number of runs.
+ * \param       function_: Callable to time.
+ * \retval      double:    Duration of the fastest run, in nanoseconds.
+ *************************************************************************************************/
+template<typename FunctionType>
+inline double
+best_of(std::size_t repeats_, FunctionType&& function_)
+{
+    double best = std::numeric_limits<double>::infinity();
+    for(std::size_t i = 0; i < repeats_; ++i)
+    {
+        const clock::time_point start = clock::now();
+        function_();
+        const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Pin the calling thread to a core.
+ *
+ * \param       core_: Index of the core.
+ * \retval      bool:  True when the thread is now pinned, false when the core does not exist or
+ *                     the platform does not support pinning.
+ *************************************************************************************************/
+inline bool
+pin_to_core(unsigned core_) noexcept
+{
+#if defined(__linux__)
+    if(core_ >= std::thread::hardware_concurrency() || core_ >= CPU_SETSIZE)
+    {
+        return false;
+    }
+
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(core_, &cores);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores) == 0;
+#else
+    static_cast<void>(core_);
+    return false;
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Wait a little while busy-waiting: pause for the first calls, then yield so that
+ *              waiting threads still make progress when there are fewer cores than threads.
+ *
+ * \param       spins_: Number of calls since the last progress, reset by the caller.
+ *************************************************************************************************/
+inline void
+spin_wait(unsigned& spins_) noexcept
+{
+    if(spins_ < 64)
+    {
+        ++spins_;
+        cpu_relax();
+    }
+    else
+    {
+        std::this_thread::yield();
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Value below which a fraction of the samples fall.
+ *
+ * \param       sorted_:   Samples, sorted in ascending order.
+ * \param       fraction_: Fraction of the samples, between 0 and 1.
+ * \retval      double:    Nearest-rank percentile, 0 when there are no samples.
+ *************************************************************************************************/
+inline double
+percentile(std::span<const double> sorted_, double fraction_) noexcept
+{
+    if(sorted_.empty())
+    {
+        return 0.0;
+    }
+
+    const auto rank = static_cast<std::size_t>(fraction_ * static_cast<double>(sorted_.size()));
+    return sorted_[std::min(rank, sorted_.size() - 1)];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Print the title of a group of results.
+ *
+ * \param       title_: Name of the group.
+ *************************************************************************************************/
+inline void
+print_title(std::string_view title_)
+{
+    std::cout << "\n" << title_ << "\n" << std::string(title_.size(), '-') << "\n";
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Print one result, as time per operation and relative to a baseline.
+ *
+ * \param       label_:       Name of the measured variant.
+ * \param       nanoseconds_: Total duration of the run.
+ * \param       operations_:  Number of operations performed by the run.
+ * \param       baseline_:    Duration of the baseline run for the same operations, or 0 to omit
+ *                            the comparison.
+ *************************************************************************************************/
+inline void
+print_result(std::string_view label_,
+             double           nanoseconds_,
+             std::size_t      operations_,
+             double           baseline_ = 0.0)
+{
+    const double perOperation = nanoseconds_ / static_cast<double>(operations_);
+    std::cout << "  " << std::left << std::setw(36) << label_ << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << perOperation << " ns/op"
+              << std::setw(10) << 1000.0 / perOperation << " Mops/s";
+    if(baseline_ > 0.0)
+    {
+        std::cout << std::setw(9) << baseline_ / nanoseconds_ << "x";
+    }
+    std::cout << "\n";
+}
+
+
+}        // namespace pel::bench
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,356 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Proxy standing for one bit of a bit_container: a word and the mask of the bit.
+ */
+class bit_reference
+{
+public:
+    using WordType = std::uint64_t;
+
+    constexpr bit_reference(WordType* word_, WordType mask_) noexcept : m_word{word_}, m_mask{mask_}
+    {
+    }
+    constexpr bit_reference(const bit_reference& copy_) noexcept = default;
+
+    /* Assignments write through to the bit, even on a const proxy */
+    constexpr const bit_reference& operator=(bool value_) const noexcept
+    {
+        *m_word = value_ ? (*m_word | m_mask) : (*m_word & ~m_mask);
+        return *this;
+    }
+    constexpr const bit_reference& operator=(const bit_reference& rhs_) const noexcept
+    {
+        return *this = static_cast<bool>(rhs_);
+    }
+
+    [[nodiscard]] constexpr operator bool() const noexcept
+    {
+        return (*m_word & m_mask) != 0;
+    }
+
+    constexpr void flip() const noexcept
+    {
+        *m_word ^= m_mask;
+    }
+
+    friend constexpr void swap(const bit_reference& lhs_, const bit_reference& rhs_) noexcept
+    {
+        const bool value = lhs_;
+        lhs_             = static_cast<bool>(rhs_);
+        rhs_             = value;
+    }
+
+private:
+    WordType* m_word;
+    WordType  m_mask;
+};
+
+
+/**
+ * \brief       Random-access iterator over the bits of a bit_container.
+ *              Keeps a word pointer and a bit offset, so stepping never divides; dereferencing
+ *              yields a bit_reference (or a bool when constant).
+ */
+template<bool IsConst>
+class bit_iterator
+{
+    template<bool>
+    friend class bit_iterator;
+
+public:
+    using WordType       = std::uint64_t;
+    using DifferenceType = std::ptrdiff_t;
+    using PointerType    = std::conditional_t<IsConst, const WordType*, WordType*>;
+
+    constexpr static const unsigned bits_per_word = 64;
+
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+    using value_type        = bool;
+    using difference_type   = DifferenceType;
+    using pointer           = void;
+    using reference         = std::conditional_t<IsConst, bool, bit_reference>;
+
+    constexpr bit_iterator() noexcept = default;
+    constexpr bit_iterator(PointerType word_, unsigned offset_) noexcept;
+
+    template<bool OtherIsConst>
+        requires(IsConst && OtherIsConst == false)
+    constexpr bit_iterator(const bit_iterator<OtherIsConst>& other_) noexcept;
+
+    [[nodiscard]] constexpr reference operator*() const noexcept;
+    [[nodiscard]] constexpr reference operator[](DifferenceType offset_) const noexcept;
+
+    constexpr bit_iterator& operator++() noexcept;
+    constexpr bit_iterator  operator++(int) noexcept;
+    constexpr bit_iterator& operator--() noexcept;
+    constexpr bit_iterator  operator--(int) noexcept;
+    constexpr bit_iterator& operator+=(DifferenceType offset_) noexcept;
+    constexpr bit_iterator& operator-=(DifferenceType offset_) noexcept;
+
+    [[nodiscard]] constexpr bit_iterator   operator+(DifferenceType offset_) const noexcept;
+    [[nodiscard]] constexpr bit_iterator   operator-(DifferenceType offset_) const noexcept;
+    [[nodiscard]] constexpr DifferenceType operator-(const bit_iterator& rhs_) const noexcept;
+
+    [[nodiscard]] friend constexpr bit_iterator operator+(DifferenceType      offset_,
+                                                          const bit_iterator& it_) noexcept
+    {
+        return it_ + offset_;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const bit_iterator& rhs_) const noexcept;
+    [[nodiscard]] constexpr std::strong_ordering
+    operator<=>(const bit_iterator& rhs_) const noexcept;
+
+    [[nodiscard]] constexpr PointerType word() const noexcept;
+    [[nodiscard]] constexpr unsigned    offset() const noexcept;
+
+private:
+    PointerType m_word   = nullptr;
+    unsigned    m_offset = 0;
+};
+
+
+/**
+ * \brief       Sequence of bits packed 64 to a word.
+ *
+ *              Takes an eighth of the memory of one bool per byte, and works a word at a time
+ *              wherever it can: the bitwise operators combine whole words, count() is a popcount
+ *              per word and find_first()/find_next() skip empty words and locate the bit with a
+ *              count of trailing zeros (tzcnt). Build a bit_rank_index over the container for
+ *              constant-time rank and select queries.
+ *
+ *              Bits are read and written through bit_reference proxies. The container offers the
+ *              familiar container_base surface (length, is_empty, at, front, back, comparisons),
+ *              but is not derived from it as no bool object is stored.
+ *              The bits past length() in the last word are always zero.
+ *
+ * \note        count() and find_first() compile to popcnt and tzcnt when the target has them
+ *              (e.g. -mpopcnt -mbmi, or -march=native); portable fallbacks are used otherwise.
+ */
+template<typename AllocatorType = std::allocator<bool>>
+class bit_container
+{
+    static_assert(std::is_same_v<bool, typename AllocatorType::value_type>,
+                  "Allocator must allocate bools");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using WordType          = std::uint64_t;
+    using AllocatorTraits   = std::allocator_traits<AllocatorType>;
+    using SizeType          = std::size_t;
+    using DifferenceType    = std::ptrdiff_t;
+    using ReferenceType     = bit_reference;
+    using IteratorType      = bit_iterator<false>;
+    using ConstIteratorType = bit_iterator<true>;
+
+    constexpr static const SizeType bits_per_word = 64;
+
+private:
+    using WordAllocatorType = typename AllocatorTraits::template rebind_alloc<WordType>;
+    using WordTraits        = std::allocator_traits<WordAllocatorType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit bit_container(const AllocatorType& alloc_ = AllocatorType{});
+    explicit bit_container(SizeType             length_,
+                           bool                 value_ = false,
+                           const AllocatorType& alloc_ = AllocatorType{});
+    bit_container(std::initializer_list<bool> values_,
+                  const AllocatorType&        alloc_ = AllocatorType{});
+
+    bit_container(const bit_container& copy_);
+    bit_container(bit_container&& move_) noexcept;
+    bit_container& operator=(const bit_container& copy_);
+    bit_container& operator=(bit_container&& move_) noexcept;
+
+    ~bit_container();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ReferenceType at(SizeType index_);
+    [[nodiscard]] bool          at(SizeType index_) const;
+
+    [[nodiscard]] ReferenceType front();
+    [[nodiscard]] ReferenceType back();
+    [[nodiscard]] bool          front() const;
+    [[nodiscard]] bool          back() const;
+
+    [[nodiscard]] bool test(SizeType index_) const noexcept;
+
+    [[nodiscard]] std::span<WordType>       words() noexcept;
+    [[nodiscard]] std::span<const WordType> words() const noexcept;
+    [[nodiscard]] SizeType                  word_count() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] ReferenceType operator[](SizeType index_) noexcept;
+    [[nodiscard]] bool          operator[](SizeType index_) const noexcept;
+
+    bit_container& operator&=(const bit_container& rhs_);
+    bit_container& operator|=(const bit_container& rhs_);
+    bit_container& operator^=(const bit_container& rhs_);
+    [[nodiscard]] bit_container operator~() const;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType      begin() noexcept;
+    [[nodiscard]] IteratorType      end() noexcept;
+    [[nodiscard]] ConstIteratorType begin() const noexcept;
+    [[nodiscard]] ConstIteratorType end() const noexcept;
+    [[nodiscard]] ConstIteratorType cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType cend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Bit queries ----------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType count() const noexcept;
+    [[nodiscard]] bool     all() const noexcept;
+    [[nodiscard]] bool     any() const noexcept;
+    [[nodiscard]] bool     none() const noexcept;
+
+    [[nodiscard]] SizeType find_first() const noexcept;
+    [[nodiscard]] SizeType find_next(SizeType index_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    void set() noexcept;
+    void set(SizeType index_, bool value_ = true);
+    void reset() noexcept;
+    void reset(SizeType index_);
+    void flip() noexcept;
+    void flip(SizeType index_);
+
+    void push_back(bool value_);
+    void pop_back();
+    void resize(SizeType newLength_, bool value_ = false);
+    void clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_not_empty() const noexcept;
+    [[nodiscard]] SizeType             capacity() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] static SizeType words_for(SizeType bits_) noexcept;
+    [[nodiscard]] static WordType mask_of(SizeType index_) noexcept;
+
+    void check_same_length(const bit_container& rhs_) const;
+    void clear_unused_bits() noexcept;
+    void reallocate(SizeType newWordCapacity_);
+    void release() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    WordType* m_words        = nullptr;
+    SizeType  m_length       = 0;
+    SizeType  m_wordCapacity = 0;
+
+    [[no_unique_address]] AllocatorType m_allocator{};
+};
+
+
+/* clang-format off */
+#define BIT_CONTAINER_OPERATOR_ARGUMENTS__                                                         \
+        const bit_container<AllocatorType>& lhs_, const bit_container<AllocatorType>& rhs_
+/* clang-format on */
+
+template<typename AllocatorType>
+[[nodiscard]] bit_container<AllocatorType> operator&(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<typename AllocatorType>
+[[nodiscard]] bit_container<AllocatorType> operator|(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<typename AllocatorType>
+[[nodiscard]] bit_container<AllocatorType> operator^(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+
+template<typename AllocatorType>
+[[nodiscard]] bool operator==(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<typename AllocatorType>
+[[nodiscard]] bool operator!=(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<typename AllocatorType>
+[[nodiscard]] bool operator<(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<typename AllocatorType>
+[[nodiscard]] bool operator<=(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<typename AllocatorType>
+[[nodiscard]] bool operator>(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<typename AllocatorType>
+[[nodiscard]] bool operator>=(BIT_CONTAINER_OPERATOR_ARGUMENTS__);
+
+
+}        // namespace pel
+
+#include "./bit_container.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
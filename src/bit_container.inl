@@ -0,0 +1,1064 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./bit_container.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define BIT_CONTAINER_TEMPLATE_DECLARATION__ typename AllocatorType
+#define BIT_CONTAINER_CLASS_SCOPE__          bit_container<AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst>::bit_iterator(PointerType word_, unsigned offset_) noexcept
+: m_word{word_}, m_offset{offset_}
+{
+}
+
+template<bool IsConst>
+template<bool OtherIsConst>
+    requires(IsConst && OtherIsConst == false)
+inline constexpr
+bit_iterator<IsConst>::bit_iterator(const bit_iterator<OtherIsConst>& other_) noexcept
+: m_word{other_.m_word}, m_offset{other_.m_offset}
+{
+}
+
+template<bool IsConst>
+inline constexpr typename bit_iterator<IsConst>::reference
+bit_iterator<IsConst>::operator*() const noexcept
+{
+    if constexpr(IsConst)
+    {
+        return ((*m_word >> m_offset) & 1) != 0;
+    }
+    else
+    {
+        return bit_reference(m_word, WordType{1} << m_offset);
+    }
+}
+
+template<bool IsConst>
+inline constexpr typename bit_iterator<IsConst>::reference
+bit_iterator<IsConst>::operator[](DifferenceType offset_) const noexcept
+{
+    return *(*this + offset_);
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst>& bit_iterator<IsConst>::operator++() noexcept
+{
+    if(++m_offset == bits_per_word)
+    {
+        m_offset = 0;
+        ++m_word;
+    }
+    return *this;
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst> bit_iterator<IsConst>::operator++(int) noexcept
+{
+    bit_iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst>& bit_iterator<IsConst>::operator--() noexcept
+{
+    if(m_offset-- == 0)
+    {
+        m_offset = bits_per_word - 1;
+        --m_word;
+    }
+    return *this;
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst> bit_iterator<IsConst>::operator--(int) noexcept
+{
+    bit_iterator previous = *this;
+    --*this;
+    return previous;
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst>&
+bit_iterator<IsConst>::operator+=(DifferenceType offset_) noexcept
+{
+    /* Floor division, so that stepping back across a word boundary lands on the previous word */
+    const DifferenceType bits      = static_cast<DifferenceType>(m_offset) + offset_;
+    const DifferenceType wordShift = bits >= 0 ? bits / DifferenceType{bits_per_word}
+                                               : (bits - DifferenceType{bits_per_word - 1})
+                                                   / DifferenceType{bits_per_word};
+    m_word += wordShift;
+    m_offset = static_cast<unsigned>(bits - wordShift * DifferenceType{bits_per_word});
+    return *this;
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst>&
+bit_iterator<IsConst>::operator-=(DifferenceType offset_) noexcept
+{
+    return *this += -offset_;
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst>
+bit_iterator<IsConst>::operator+(DifferenceType offset_) const noexcept
+{
+    bit_iterator it = *this;
+    return it += offset_;
+}
+
+template<bool IsConst>
+inline constexpr bit_iterator<IsConst>
+bit_iterator<IsConst>::operator-(DifferenceType offset_) const noexcept
+{
+    bit_iterator it = *this;
+    return it -= offset_;
+}
+
+template<bool IsConst>
+inline constexpr typename bit_iterator<IsConst>::DifferenceType
+bit_iterator<IsConst>::operator-(const bit_iterator& rhs_) const noexcept
+{
+    return (m_word - rhs_.m_word) * DifferenceType{bits_per_word}
+           + static_cast<DifferenceType>(m_offset) - static_cast<DifferenceType>(rhs_.m_offset);
+}
+
+template<bool IsConst>
+inline constexpr bool bit_iterator<IsConst>::operator==(const bit_iterator& rhs_) const noexcept
+{
+    return m_word == rhs_.m_word && m_offset == rhs_.m_offset;
+}
+
+template<bool IsConst>
+inline constexpr std::strong_ordering
+bit_iterator<IsConst>::operator<=>(const bit_iterator& rhs_) const noexcept
+{
+    if(m_word != rhs_.m_word)
+    {
+        return std::compare_three_way{}(m_word, rhs_.m_word);
+    }
+    return m_offset <=> rhs_.m_offset;
+}
+
+template<bool IsConst>
+inline constexpr typename bit_iterator<IsConst>::PointerType
+bit_iterator<IsConst>::word() const noexcept
+{
+    return m_word;
+}
+
+template<bool IsConst>
+inline constexpr unsigned bit_iterator<IsConst>::offset() const noexcept
+{
+    return m_offset;
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty container. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator, rebound to allocate the words.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__::bit_container(const AllocatorType& alloc_) : m_allocator{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a container of length_ bits, all set to value_.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__::bit_container(SizeType             length_,
+                                                  bool                 value_,
+                                                  const AllocatorType& alloc_)
+: m_allocator{alloc_}
+{
+    resize(length_, value_);
+}
+
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__::bit_container(std::initializer_list<bool> values_,
+                                                  const AllocatorType&        alloc_)
+: m_allocator{alloc_}
+{
+    reserve(values_.size());
+    for(bool value : values_)
+    {
+        push_back(value);
+    }
+}
+
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__::bit_container(const bit_container& copy_)
+: m_allocator{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)}
+{
+    reserve(copy_.m_length);
+    std::copy_n(copy_.m_words, copy_.word_count(), m_words);
+    m_length = copy_.m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the words of another container, leaving it empty.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__::bit_container(bit_container&& move_) noexcept
+: m_words{std::exchange(move_.m_words, nullptr)},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_wordCapacity{std::exchange(move_.m_wordCapacity, 0)},
+  m_allocator{move_.m_allocator}
+{
+}
+
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__&
+BIT_CONTAINER_CLASS_SCOPE__::operator=(const bit_container& copy_)
+{
+    if(this != &copy_)
+    {
+        bit_container copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__&
+BIT_CONTAINER_CLASS_SCOPE__::operator=(bit_container&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+        m_words        = std::exchange(move_.m_words, nullptr);
+        m_length       = std::exchange(move_.m_length, 0);
+        m_wordCapacity = std::exchange(move_.m_wordCapacity, 0);
+        m_allocator    = move_.m_allocator;
+    }
+    return *this;
+}
+
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__::~bit_container()
+{
+    release();
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access a bit, with bounds checking.
+ *
+ * \param       index_: Position of the bit.
+ * \retval      ReferenceType: Proxy standing for the bit.
+ * \throws      std::length_error if index_ is out of range.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ReferenceType
+BIT_CONTAINER_CLASS_SCOPE__::at(SizeType index_)
+{
+    if(index_ >= m_length)
+    {
+        throw std::length_error("Index out of range");
+    }
+    return (*this)[index_];
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::at(SizeType index_) const
+{
+    if(index_ >= m_length)
+    {
+        throw std::length_error("Index out of range");
+    }
+    return test(index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the first bit.
+ *
+ * \throws      std::length_error if the container is empty.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ReferenceType BIT_CONTAINER_CLASS_SCOPE__::front()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return (*this)[0];
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Access the last bit.
+ *
+ * \throws      std::length_error if the container is empty.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ReferenceType BIT_CONTAINER_CLASS_SCOPE__::back()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return (*this)[m_length - 1];
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::front() const
+{
+    return const_cast<bit_container*>(this)->front();
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::back() const
+{
+    return const_cast<bit_container*>(this)->back();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Read a bit, without bounds checking.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::test(SizeType index_) const noexcept
+{
+    return (m_words[index_ / bits_per_word] & mask_of(index_)) != 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the words holding the bits, bit i being bit (i % 64) of word (i / 64).
+ *              The bits past length() in the last word must be left to zero.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline std::span<typename BIT_CONTAINER_CLASS_SCOPE__::WordType>
+BIT_CONTAINER_CLASS_SCOPE__::words() noexcept
+{
+    return {m_words, word_count()};
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline std::span<const typename BIT_CONTAINER_CLASS_SCOPE__::WordType>
+BIT_CONTAINER_CLASS_SCOPE__::words() const noexcept
+{
+    return {m_words, word_count()};
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::SizeType
+BIT_CONTAINER_CLASS_SCOPE__::word_count() const noexcept
+{
+    return words_for(m_length);
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ReferenceType
+BIT_CONTAINER_CLASS_SCOPE__::operator[](SizeType index_) noexcept
+{
+    return ReferenceType(m_words + index_ / bits_per_word, mask_of(index_));
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::operator[](SizeType index_) const noexcept
+{
+    return test(index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Combine the bits of two containers of the same length, a word at a time.
+ *
+ * \throws      std::invalid_argument if the lengths differ.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__&
+BIT_CONTAINER_CLASS_SCOPE__::operator&=(const bit_container& rhs_)
+{
+    check_same_length(rhs_);
+    for(SizeType i = 0; i < word_count(); ++i)
+    {
+        m_words[i] &= rhs_.m_words[i];
+    }
+    return *this;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__&
+BIT_CONTAINER_CLASS_SCOPE__::operator|=(const bit_container& rhs_)
+{
+    check_same_length(rhs_);
+    for(SizeType i = 0; i < word_count(); ++i)
+    {
+        m_words[i] |= rhs_.m_words[i];
+    }
+    return *this;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__&
+BIT_CONTAINER_CLASS_SCOPE__::operator^=(const bit_container& rhs_)
+{
+    check_same_length(rhs_);
+    for(SizeType i = 0; i < word_count(); ++i)
+    {
+        m_words[i] ^= rhs_.m_words[i];
+    }
+    return *this;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline BIT_CONTAINER_CLASS_SCOPE__ BIT_CONTAINER_CLASS_SCOPE__::operator~() const
+{
+    bit_container inverted(*this);
+    inverted.flip();
+    return inverted;
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::IteratorType
+BIT_CONTAINER_CLASS_SCOPE__::begin() noexcept
+{
+    return IteratorType(m_words, 0);
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::IteratorType
+BIT_CONTAINER_CLASS_SCOPE__::end() noexcept
+{
+    return begin() + static_cast<DifferenceType>(m_length);
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+BIT_CONTAINER_CLASS_SCOPE__::begin() const noexcept
+{
+    return ConstIteratorType(m_words, 0);
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+BIT_CONTAINER_CLASS_SCOPE__::end() const noexcept
+{
+    return begin() + static_cast<DifferenceType>(m_length);
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+BIT_CONTAINER_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+BIT_CONTAINER_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+
+
+/*************************************************************************************************/
+/* BIT QUERIES --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Count the set bits, one popcount per word.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::SizeType
+BIT_CONTAINER_CLASS_SCOPE__::count() const noexcept
+{
+    SizeType total = 0;
+    for(SizeType i = 0; i < word_count(); ++i)
+    {
+        total += static_cast<SizeType>(std::popcount(m_words[i]));
+    }
+    return total;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Check whether every bit is set. True for an empty container.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::all() const noexcept
+{
+    const SizeType fullWords = m_length / bits_per_word;
+    for(SizeType i = 0; i < fullWords; ++i)
+    {
+        if(m_words[i] != ~WordType{0})
+        {
+            return false;
+        }
+    }
+    return fullWords == word_count() || m_words[fullWords] == mask_of(m_length) - 1;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::any() const noexcept
+{
+    return find_first() != m_length;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::none() const noexcept
+{
+    return !any();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first set bit, skipping empty words.
+ *
+ * \retval      SizeType: Position of the bit, or length() if no bit is set.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::SizeType
+BIT_CONTAINER_CLASS_SCOPE__::find_first() const noexcept
+{
+    for(SizeType i = 0; i < word_count(); ++i)
+    {
+        if(m_words[i] != 0)
+        {
+            return i * bits_per_word + static_cast<SizeType>(std::countr_zero(m_words[i]));
+        }
+    }
+    return m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first set bit after a given position.
+ *
+ * \param       index_: Position to search after.
+ * \retval      SizeType: Position of the bit, or length() if no later bit is set.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::SizeType
+BIT_CONTAINER_CLASS_SCOPE__::find_next(SizeType index_) const noexcept
+{
+    const SizeType start = index_ + 1;
+    if(start >= m_length)
+    {
+        return m_length;
+    }
+
+    SizeType wordIndex = start / bits_per_word;
+    WordType word      = m_words[wordIndex] & ~(mask_of(start) - 1);
+    while(word == 0)
+    {
+        if(++wordIndex == word_count())
+        {
+            return m_length;
+        }
+        word = m_words[wordIndex];
+    }
+    return wordIndex * bits_per_word + static_cast<SizeType>(std::countr_zero(word));
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Set every bit.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::set() noexcept
+{
+    std::fill_n(m_words, word_count(), ~WordType{0});
+    clear_unused_bits();
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Set a bit to a value.
+ *
+ * \throws      std::length_error if index_ is out of range.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::set(SizeType index_, bool value_)
+{
+    at(index_) = value_;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Clear every bit.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::reset() noexcept
+{
+    std::fill_n(m_words, word_count(), WordType{0});
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Clear a bit.
+ *
+ * \throws      std::length_error if index_ is out of range.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::reset(SizeType index_)
+{
+    at(index_) = false;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Invert every bit.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::flip() noexcept
+{
+    for(SizeType i = 0; i < word_count(); ++i)
+    {
+        m_words[i] = ~m_words[i];
+    }
+    clear_unused_bits();
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Invert a bit.
+ *
+ * \throws      std::length_error if index_ is out of range.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::flip(SizeType index_)
+{
+    at(index_).flip();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Append a bit, doubling the capacity when full.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::push_back(bool value_)
+{
+    if(m_length == capacity())
+    {
+        reallocate(std::max(SizeType{1}, m_wordCapacity * 2));
+    }
+
+    if(m_length % bits_per_word == 0)
+    {
+        m_words[m_length / bits_per_word] = 0;
+    }
+    ++m_length;
+    (*this)[m_length - 1] = value_;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Remove the last bit.
+ *
+ * \throws      std::length_error if the container is empty.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::pop_back()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    --m_length;
+    clear_unused_bits();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Change the number of bits, setting the new ones to value_.
+ *
+ * \param       newLength_: New number of bits.
+ * \param       value_:     Value of the added bits.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::resize(SizeType newLength_, bool value_)
+{
+    if(newLength_ <= m_length)
+    {
+        m_length = newLength_;
+        clear_unused_bits();
+        return;
+    }
+
+    reserve(newLength_);
+    const SizeType oldWords = word_count();
+    if(value_ && m_length % bits_per_word != 0)
+    {
+        m_words[oldWords - 1] |= ~(mask_of(m_length) - 1);
+    }
+    std::fill(m_words + oldWords, m_words + words_for(newLength_), value_ ? ~WordType{0} : 0);
+
+    m_length = newLength_;
+    clear_unused_bits();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove every bit. The words are kept for reuse.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::clear() noexcept
+{
+    m_length = 0;
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::SizeType
+BIT_CONTAINER_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool BIT_CONTAINER_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_length != 0;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Number of bits the container can hold without reallocating.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::SizeType
+BIT_CONTAINER_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_wordCapacity * bits_per_word;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline const AllocatorType& BIT_CONTAINER_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Make room for at least newCapacity_ bits.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > capacity())
+    {
+        reallocate(words_for(newCapacity_));
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Free the words past the last bit.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(m_length == 0)
+    {
+        release();
+    }
+    else if(word_count() < m_wordCapacity)
+    {
+        reallocate(word_count());
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline std::string BIT_CONTAINER_CLASS_SCOPE__::to_string() const
+{
+    std::stringstream ss;
+    ss << "[";
+    for(SizeType i = 0; i < m_length; ++i)
+    {
+        ss << (i == 0 ? "" : ", ") << (test(i) ? 1 : 0);
+    }
+    ss << "]";
+    return ss.str();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::SizeType
+BIT_CONTAINER_CLASS_SCOPE__::words_for(SizeType bits_) noexcept
+{
+    return (bits_ + bits_per_word - 1) / bits_per_word;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Mask selecting a bit within its word.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename BIT_CONTAINER_CLASS_SCOPE__::WordType
+BIT_CONTAINER_CLASS_SCOPE__::mask_of(SizeType index_) noexcept
+{
+    return WordType{1} << (index_ % bits_per_word);
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::check_same_length(const bit_container& rhs_) const
+{
+    if(m_length != rhs_.m_length)
+    {
+        throw std::invalid_argument("Containers must have the same length");
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Zero the bits past length() in the last word, so whole-word operations can ignore
+ *              the length.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::clear_unused_bits() noexcept
+{
+    if(m_length % bits_per_word != 0)
+    {
+        m_words[m_length / bits_per_word] &= mask_of(m_length) - 1;
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the words to a new allocation of newWordCapacity_ words.
+ *************************************************************************************************/
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::reallocate(SizeType newWordCapacity_)
+{
+    WordAllocatorType wordAllocator{m_allocator};
+    WordType*         newWords = WordTraits::allocate(wordAllocator, newWordCapacity_);
+    std::copy_n(m_words, word_count(), newWords);
+
+    const SizeType length = m_length;
+    release();
+    m_words        = newWords;
+    m_length       = length;
+    m_wordCapacity = newWordCapacity_;
+}
+
+template<BIT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void BIT_CONTAINER_CLASS_SCOPE__::release() noexcept
+{
+    if(m_words != nullptr)
+    {
+        WordAllocatorType wordAllocator{m_allocator};
+        WordTraits::deallocate(wordAllocator, m_words, m_wordCapacity);
+    }
+    m_words        = nullptr;
+    m_length       = 0;
+    m_wordCapacity = 0;
+}
+
+
+
+/*************************************************************************************************/
+/* BITWISE & COMPARISON OPERATORS -------------------------------------------------------------- */
+/*************************************************************************************************/
+template<typename AllocatorType>
+inline bit_container<AllocatorType> operator&(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    bit_container<AllocatorType> result(lhs_);
+    result &= rhs_;
+    return result;
+}
+
+template<typename AllocatorType>
+inline bit_container<AllocatorType> operator|(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    bit_container<AllocatorType> result(lhs_);
+    result |= rhs_;
+    return result;
+}
+
+template<typename AllocatorType>
+inline bit_container<AllocatorType> operator^(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    bit_container<AllocatorType> result(lhs_);
+    result ^= rhs_;
+    return result;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Two containers are equal when they have the same bits; compared a word at a time.
+ *************************************************************************************************/
+template<typename AllocatorType>
+inline bool operator==(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return lhs_.length() == rhs_.length() && std::ranges::equal(lhs_.words(), rhs_.words());
+}
+
+template<typename AllocatorType>
+inline bool operator!=(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ == rhs_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Lexicographical comparison of the bits, false before true.
+ *              The first differing bit is the lowest set bit of the xor of the first differing
+ *              words, so only words are compared.
+ *************************************************************************************************/
+template<typename AllocatorType>
+inline bool operator<(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    using WordType = typename bit_container<AllocatorType>::WordType;
+
+    const std::size_t common = std::min(lhs_.length(), rhs_.length());
+    const std::size_t words  = (common + 63) / 64;
+    for(std::size_t i = 0; i < words; ++i)
+    {
+        WordType difference = lhs_.words()[i] ^ rhs_.words()[i];
+        if(i == words - 1 && common % 64 != 0)
+        {
+            difference &= (WordType{1} << (common % 64)) - 1;
+        }
+        if(difference != 0)
+        {
+            return (rhs_.words()[i] & (difference & (~difference + 1))) != 0;
+        }
+    }
+    return lhs_.length() < rhs_.length();
+}
+
+template<typename AllocatorType>
+inline bool operator<=(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return !(rhs_ < lhs_);
+}
+
+template<typename AllocatorType>
+inline bool operator>(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return rhs_ < lhs_;
+}
+
+template<typename AllocatorType>
+inline bool operator>=(BIT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ < rhs_);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef BIT_CONTAINER_TEMPLATE_DECLARATION__
+#undef BIT_CONTAINER_CLASS_SCOPE__
+#undef BIT_CONTAINER_OPERATOR_ARGUMENTS__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
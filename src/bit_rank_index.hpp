@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Constant-time rank and select over the bits of a bit_container.
+ *
+ *              The bits are cut in blocks of 512 (8 words, one cache line). Each block records
+ *              the number of set bits before it, plus the seven counts before each of its words
+ *              packed 9 bits apiece in a second word, so rank() is two lookups and a popcount
+ *              (25% of the size of the bits). select() starts from the block of every 512th set
+ *              bit, narrows down with the block counts, then picks the bit within the word with
+ *              select_bit() (pdep with BMI2).
+ *
+ * \note        The index describes the bits as they were when built: call rebuild() after
+ *              modifying the container.
+ */
+template<typename ContainerType>
+class bit_rank_index
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType      = typename ContainerType::SizeType;
+    using WordType      = typename ContainerType::WordType;
+    using AllocatorType =
+      std::remove_cvref_t<decltype(std::declval<const ContainerType&>().get_allocator())>;
+
+    constexpr static const SizeType block_words    = 8;
+    constexpr static const SizeType block_bits     = block_words * ContainerType::bits_per_word;
+    constexpr static const SizeType select_samples = 512;
+
+private:
+    using CountAllocatorType =
+      typename std::allocator_traits<AllocatorType>::template rebind_alloc<std::uint64_t>;
+    using SampleAllocatorType =
+      typename std::allocator_traits<AllocatorType>::template rebind_alloc<SizeType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit bit_rank_index(const ContainerType& bits_);
+
+
+    /*********************************************************************************************/
+    /* Queries --------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType rank(SizeType index_) const;
+    [[nodiscard]] SizeType select(SizeType rank_) const;
+    [[nodiscard]] SizeType count() const noexcept;
+
+    void rebuild();
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] SizeType count_before_word(SizeType block_, SizeType word_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    const ContainerType* m_bits;
+
+    /* Per block: set bits before the block, then the packed counts before each of its words */
+    std::vector<std::uint64_t, CountAllocatorType> m_blocks;
+    /* Block holding set bit number k * select_samples */
+    std::vector<SizeType, SampleAllocatorType> m_samples;
+};
+
+
+}        // namespace pel
+
+#include "./bit_rank_index.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,224 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./bit_rank_index.hpp"
+
+#include <bit>
+#include <stdexcept>
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Index the bits of a container. The container must outlive the index.
+ *
+ * \param       bits_: Container to index.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline bit_rank_index<ContainerType>::bit_rank_index(const ContainerType& bits_)
+: m_bits{&bits_},
+  m_blocks{CountAllocatorType{bits_.get_allocator()}},
+  m_samples{SampleAllocatorType{bits_.get_allocator()}}
+{
+    rebuild();
+}
+
+
+
+/*************************************************************************************************/
+/* QUERIES ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Count the set bits before a position.
+ *
+ * \param       index_: Position, up to length() included.
+ * \retval      SizeType: Number of set bits in [0, index_).
+ * \throws      std::length_error if index_ is past length().
+ *************************************************************************************************/
+template<typename ContainerType>
+inline typename bit_rank_index<ContainerType>::SizeType
+bit_rank_index<ContainerType>::rank(SizeType index_) const
+{
+    if(index_ > m_bits->length())
+    {
+        throw std::length_error("Index out of range");
+    }
+
+    const SizeType word  = index_ / ContainerType::bits_per_word;
+    const SizeType bit   = index_ % ContainerType::bits_per_word;
+    SizeType       total = count_before_word(word / block_words, word % block_words);
+    if(bit != 0)
+    {
+        const WordType below = m_bits->words()[word] & ((WordType{1} << bit) - 1);
+        total += static_cast<SizeType>(std::popcount(below));
+    }
+    return total;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the position of a set bit from its rank.
+ *
+ * \param       rank_: Number of set bits before the one looked for.
+ * \retval      SizeType: Position of the bit.
+ * \throws      std::length_error if fewer than rank_ + 1 bits are set.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline typename bit_rank_index<ContainerType>::SizeType
+bit_rank_index<ContainerType>::select(SizeType rank_) const
+{
+    if(rank_ >= count())
+    {
+        throw std::length_error("Index out of range");
+    }
+
+    /* The block is between the blocks of the surrounding samples: binary search the counts */
+    const SizeType sample = rank_ / select_samples;
+    SizeType       first  = m_samples[sample];
+    SizeType       last   = m_blocks.size() / 2 - 1;
+    if(sample + 1 < m_samples.size())
+    {
+        last = m_samples[sample + 1];
+    }
+    while(first < last)
+    {
+        const SizeType middle = first + (last - first + 1) / 2;
+        if(m_blocks[2 * middle] <= rank_)
+        {
+            first = middle;
+        }
+        else
+        {
+            last = middle - 1;
+        }
+    }
+
+    /* Compare the rank left with the seven packed word counts at once (rank9 select) */
+    constexpr std::uint64_t field_ones = 0x0040201008040201ULL;
+    constexpr std::uint64_t field_msbs = field_ones << 8U;
+    const std::uint64_t     left       = rank_ - m_blocks[2 * first];
+    const std::uint64_t     counts     = m_blocks[2 * first + 1];
+    const std::uint64_t     lefts      = left * field_ones;
+    const std::uint64_t     atMost =
+      ((((lefts | field_msbs) - (counts & ~field_msbs)) | (counts ^ lefts)) ^ (counts & ~lefts))
+      & field_msbs;
+    const auto word = static_cast<SizeType>(std::popcount(atMost));
+
+    const SizeType remaining = rank_ - count_before_word(first, word);
+    const SizeType wordIndex = first * block_words + word;
+    return wordIndex * ContainerType::bits_per_word
+           + select_bit(m_bits->words()[wordIndex], static_cast<unsigned>(remaining));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of set bits in the container, when the index was built.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline typename bit_rank_index<ContainerType>::SizeType
+bit_rank_index<ContainerType>::count() const noexcept
+{
+    return static_cast<SizeType>(m_blocks[m_blocks.size() - 2]);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Recompute the index from the current bits of the container.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline void bit_rank_index<ContainerType>::rebuild()
+{
+    const auto     words      = m_bits->words();
+    const SizeType blockCount = (words.size() + block_words - 1) / block_words;
+
+    /* A last block holding the total lets rank() run past the end without a special case */
+    m_blocks.assign(2 * (blockCount + 1), 0);
+    m_samples.clear();
+
+    std::uint64_t total = 0;
+    for(SizeType block = 0; block < blockCount; ++block)
+    {
+        m_blocks[2 * block] = total;
+
+        std::uint64_t inBlock = 0;
+        std::uint64_t packed  = 0;
+        for(SizeType word = 0; word < block_words; ++word)
+        {
+            if(word != 0)
+            {
+                packed |= inBlock << (9 * (word - 1));
+            }
+            const SizeType index = block * block_words + word;
+            if(index < words.size())
+            {
+                inBlock += static_cast<std::uint64_t>(std::popcount(words[index]));
+            }
+        }
+        m_blocks[2 * block + 1] = packed;
+
+        while(m_samples.size() * select_samples < total + inBlock)
+        {
+            m_samples.push_back(block);
+        }
+        total += inBlock;
+    }
+    m_blocks[2 * blockCount] = total;
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Number of set bits before a word of a block.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline typename bit_rank_index<ContainerType>::SizeType
+bit_rank_index<ContainerType>::count_before_word(SizeType block_, SizeType word_) const noexcept
+{
+    const std::uint64_t inBlock =
+      word_ == 0 ? 0 : (m_blocks[2 * block_ + 1] >> (9 * (word_ - 1))) & 0x1FF;
+    return static_cast<SizeType>(m_blocks[2 * block_] + inBlock);
+}
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
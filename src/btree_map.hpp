@@ -0,0 +1,441 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./flat_search.hpp"
+#include "./hardware.hpp"
+#include "./transparent_key.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Bidirectional iterator over the entries of a btree_map, in key order.
+ *              Walks a leaf as an array, then follows the link to the next leaf.
+ */
+template<typename TreeType, bool IsConst>
+class btree_map_iterator
+{
+    template<typename, bool>
+    friend class btree_map_iterator;
+    friend TreeType;
+
+    using LeafType = typename TreeType::leaf_node;
+
+public:
+    using SizeType = typename TreeType::SizeType;
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = typename TreeType::ValueType;
+    using difference_type   = typename TreeType::DifferenceType;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    constexpr btree_map_iterator() noexcept = default;
+    btree_map_iterator(const TreeType* tree_, LeafType* leaf_, SizeType index_) noexcept;
+
+    template<bool OtherIsConst>
+        requires(IsConst && OtherIsConst == false)
+    btree_map_iterator(const btree_map_iterator<TreeType, OtherIsConst>& other_) noexcept;
+
+    [[nodiscard]] reference operator*() const noexcept;
+    [[nodiscard]] pointer   operator->() const noexcept;
+
+    btree_map_iterator& operator++() noexcept;
+    btree_map_iterator  operator++(int) noexcept;
+    btree_map_iterator& operator--() noexcept;
+    btree_map_iterator  operator--(int) noexcept;
+
+    [[nodiscard]] bool operator==(const btree_map_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator!=(const btree_map_iterator& rhs_) const noexcept;
+
+private:
+    const TreeType* m_tree  = nullptr;
+    LeafType*       m_leaf  = nullptr;
+    SizeType        m_index = 0;
+};
+
+
+/**
+ * \brief       Ordered map stored in a B+tree with wide, cache-friendly nodes.
+ *
+ *              Each node fits in NodeBytes bytes (a few cache lines by default) and starts on a
+ *              cache line, so the tree stays a handful of levels deep and each level costs a few
+ *              sequential cache misses rather than one per comparison as in a red-black tree.
+ *              Inner nodes only hold separator keys and child pointers; entries live in the
+ *              leaves, which are linked to each other so that iterating in order is a sequential
+ *              scan of the leaves.
+ *              Leaves are split in half when full, except when appending past the last key, where
+ *              the full leaf is left as is: ascending insertions fill every leaf. assign_sorted()
+ *              builds the whole tree bottom-up from sorted input in O(n).
+ *              Nodes are allocated through AllocatorType, rebound to the node types.
+ *
+ *              Offers the familiar container_base surface (length, is_empty, front, back,
+ *              comparisons), but no positional access: the tree is not contiguous.
+ *              Lookups accept any type the comparator accepts when it defines is_transparent.
+ *
+ *              Erasing from a node that falls under half full takes entries from a sibling, or
+ *              merges the node into it when the sibling cannot spare any.
+ *
+ * \note        Iterators are invalidated by insertions in their leaf, and by erasures in their leaf
+ *              or in one of its siblings.
+ */
+template<typename KeyType,
+         typename MappedType,
+         typename CompareType   = std::less<KeyType>,
+         typename AllocatorType = std::allocator<std::pair<KeyType, MappedType>>,
+         std::size_t NodeBytes  = 512>
+class btree_map
+{
+    static_assert(
+      std::is_same_v<std::pair<KeyType, MappedType>, typename AllocatorType::value_type>,
+      "Allocator must match value type");
+    static_assert(NodeBytes % cache_line_size == 0, "Nodes must be a whole number of cache lines");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType         = std::pair<KeyType, MappedType>;
+    using AllocatorTraits   = std::allocator_traits<AllocatorType>;
+    using SizeType          = std::size_t;
+    using DifferenceType    = std::ptrdiff_t;
+    using IteratorType      = btree_map_iterator<btree_map, false>;
+    using ConstIteratorType = btree_map_iterator<btree_map, true>;
+
+    constexpr static const bool is_transparent = requires {
+        typename CompareType::is_transparent;
+    };
+
+    /* Lookup argument: any type with a transparent comparator, KeyType otherwise */
+    template<typename LookupType>
+    using KeyArgType = transparent_key_t<is_transparent, LookupType, KeyType>;
+
+private:
+    /* Bytes before the entries of a leaf (count and links) and the separators of an inner node
+     * (count and children, plus the padding the alignment of KeyType may add) */
+    constexpr static const SizeType leaf_header =
+      (sizeof(SizeType) + 2 * sizeof(void*) + alignof(ValueType) - 1) / alignof(ValueType)
+      * alignof(ValueType);
+    constexpr static const SizeType inner_header =
+      sizeof(SizeType) + 2 * sizeof(void*)
+      + (alignof(KeyType) > alignof(void*) ? alignof(KeyType) - alignof(void*) : 0);
+
+public:
+    /* Entries per leaf and separator keys per inner node, each node keeping one spare slot */
+    constexpr static const SizeType leaf_capacity =
+      NodeBytes > leaf_header + sizeof(ValueType)
+        ? (NodeBytes - leaf_header) / sizeof(ValueType) - 1
+        : 0;
+    constexpr static const SizeType inner_capacity =
+      NodeBytes > inner_header + sizeof(KeyType)
+        ? (NodeBytes - inner_header - sizeof(KeyType)) / (sizeof(KeyType) + sizeof(void*))
+        : 0;
+
+    /* Below these counts, a node erased from takes entries from a sibling or merges with it */
+    constexpr static const SizeType leaf_minimum  = leaf_capacity / 2;
+    constexpr static const SizeType inner_minimum = inner_capacity / 2;
+
+    static_assert(leaf_capacity >= 3, "NodeBytes is too small to hold 3 entries per leaf");
+    static_assert(inner_capacity >= 3, "NodeBytes is too small to hold 3 keys per inner node");
+
+    constexpr static const SizeType max_height = 64;
+
+private:
+    friend IteratorType;
+    friend ConstIteratorType;
+
+    struct node_base
+    {
+        SizeType count = 0;
+    };
+
+    /* One spare slot lets a full node take the new entry before being split */
+    struct alignas(cache_line_size) leaf_node : node_base
+    {
+        leaf_node* previous = nullptr;
+        leaf_node* next     = nullptr;
+        alignas(ValueType) std::byte storage[(leaf_capacity + 1) * sizeof(ValueType)];
+
+        [[nodiscard]] ValueType* values() noexcept
+        {
+            return std::launder(reinterpret_cast<ValueType*>(storage));
+        }
+    };
+
+    struct alignas(cache_line_size) inner_node : node_base
+    {
+        node_base* children[inner_capacity + 2];
+        alignas(KeyType) std::byte storage[(inner_capacity + 1) * sizeof(KeyType)];
+
+        [[nodiscard]] KeyType* keys() noexcept
+        {
+            return std::launder(reinterpret_cast<KeyType*>(storage));
+        }
+    };
+
+    static_assert(sizeof(leaf_node) <= NodeBytes, "Leaf nodes must fit in NodeBytes");
+    static_assert(sizeof(inner_node) <= NodeBytes, "Inner nodes must fit in NodeBytes");
+
+    using LeafAllocatorType  = typename AllocatorTraits::template rebind_alloc<leaf_node>;
+    using LeafTraits         = std::allocator_traits<LeafAllocatorType>;
+    using InnerAllocatorType = typename AllocatorTraits::template rebind_alloc<inner_node>;
+    using InnerTraits        = std::allocator_traits<InnerAllocatorType>;
+    using KeyAllocatorType   = typename AllocatorTraits::template rebind_alloc<KeyType>;
+    using KeyTraits          = std::allocator_traits<KeyAllocatorType>;
+
+    /* Inner nodes visited on the way down to a leaf, and the child taken in each */
+    struct tree_path
+    {
+        std::array<inner_node*, max_height> nodes{};
+        std::array<SizeType, max_height>    children{};
+        SizeType                            depth = 0;
+    };
+
+    /* Inner nodes allocated before a split starts modifying the tree */
+    struct node_reserve
+    {
+        std::array<inner_node*, max_height + 1> nodes{};
+        SizeType                                count = 0;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit btree_map(const CompareType&   compare_ = CompareType{},
+                       const AllocatorType& alloc_   = AllocatorType{});
+    btree_map(std::initializer_list<ValueType> values_,
+              const CompareType&               compare_ = CompareType{},
+              const AllocatorType&             alloc_   = AllocatorType{});
+    template<typename InputIterator>
+    btree_map(InputIterator        first_,
+              InputIterator        last_,
+              const CompareType&   compare_ = CompareType{},
+              const AllocatorType& alloc_   = AllocatorType{});
+
+    btree_map(const btree_map& copy_);
+    btree_map(btree_map&& move_) noexcept;
+    btree_map& operator=(const btree_map& copy_);
+    btree_map& operator=(btree_map&& move_) noexcept;
+
+    ~btree_map();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    template<typename LookupType = KeyType>
+    [[nodiscard]] MappedType& at(const KeyArgType<LookupType>& key_);
+    template<typename LookupType = KeyType>
+    [[nodiscard]] const MappedType& at(const KeyArgType<LookupType>& key_) const;
+
+    [[nodiscard]] ValueType&       front();
+    [[nodiscard]] ValueType&       back();
+    [[nodiscard]] const ValueType& front() const;
+    [[nodiscard]] const ValueType& back() const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    MappedType& operator[](const KeyType& key_);
+    MappedType& operator[](KeyType&& key_);
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType      begin() noexcept;
+    [[nodiscard]] IteratorType      end() noexcept;
+    [[nodiscard]] ConstIteratorType begin() const noexcept;
+    [[nodiscard]] ConstIteratorType end() const noexcept;
+    [[nodiscard]] ConstIteratorType cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType cend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Lookup ---------------------------------------------------------------------------------- */
+    template<typename LookupType = KeyType>
+    [[nodiscard]] IteratorType find(const KeyArgType<LookupType>& key_);
+    template<typename LookupType = KeyType>
+    [[nodiscard]] ConstIteratorType find(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] bool contains(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] SizeType count(const KeyArgType<LookupType>& key_) const;
+
+    template<typename LookupType = KeyType>
+    [[nodiscard]] IteratorType lower_bound(const KeyArgType<LookupType>& key_);
+    template<typename LookupType = KeyType>
+    [[nodiscard]] ConstIteratorType lower_bound(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] IteratorType upper_bound(const KeyArgType<LookupType>& key_);
+    template<typename LookupType = KeyType>
+    [[nodiscard]] ConstIteratorType upper_bound(const KeyArgType<LookupType>& key_) const;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    std::pair<IteratorType, bool> insert(const ValueType& value_);
+    std::pair<IteratorType, bool> insert(ValueType&& value_);
+    template<typename InputIterator>
+    void insert(InputIterator first_, InputIterator last_);
+
+    template<typename... Args>
+    std::pair<IteratorType, bool> emplace(Args&&... args_);
+    template<typename... Args>
+    std::pair<IteratorType, bool> try_emplace(const KeyType& key_, Args&&... args_);
+    template<typename... Args>
+    std::pair<IteratorType, bool> try_emplace(KeyType&& key_, Args&&... args_);
+    template<typename ObjectType>
+    std::pair<IteratorType, bool> insert_or_assign(const KeyType& key_, ObjectType&& object_);
+
+    template<typename InputIterator>
+    void assign_sorted(InputIterator first_, InputIterator last_);
+
+    template<typename LookupType = KeyType>
+    SizeType     erase(const KeyArgType<LookupType>& key_);
+    IteratorType erase(ConstIteratorType position_);
+    IteratorType erase(IteratorType position_);
+
+    void clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_not_empty() const noexcept;
+    [[nodiscard]] SizeType             height() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+    [[nodiscard]] const CompareType&   key_comp() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    template<typename LookupType>
+    [[nodiscard]] leaf_node* descend(const LookupType& key_, tree_path* path_) const;
+    template<typename LookupType>
+    [[nodiscard]] SizeType child_index(inner_node* node_, const LookupType& key_) const;
+    template<typename LookupType>
+    [[nodiscard]] SizeType leaf_lower_bound(leaf_node* leaf_, const LookupType& key_) const;
+    template<typename LookupType>
+    [[nodiscard]] SizeType leaf_upper_bound(leaf_node* leaf_, const LookupType& key_) const;
+
+    std::pair<IteratorType, bool> insert_unique(ValueType&& value_);
+    void insert_into_leaf(leaf_node* leaf_, SizeType index_, ValueType&& value_);
+    void insert_into_parent(tree_path&    path_,
+                            node_reserve& reserve_,
+                            node_base*    left_,
+                            KeyType&&     separator_,
+                            node_base*    right_) noexcept;
+
+    IteratorType erase_at(leaf_node* leaf_, SizeType index_);
+    std::pair<leaf_node*, SizeType> rebalance_leaf(leaf_node* leaf_,
+                                                   SizeType   index_,
+                                                   tree_path& path_);
+    void rebalance_inner(tree_path& path_) noexcept;
+    void erase_child(inner_node* node_, SizeType child_) noexcept;
+
+    [[nodiscard]] leaf_node*  allocate_leaf();
+    [[nodiscard]] inner_node* allocate_inner();
+    void                      deallocate_leaf(leaf_node* leaf_) noexcept;
+    void                      deallocate_inner(inner_node* node_) noexcept;
+    void                      destroy_subtree(node_base* node_, SizeType level_) noexcept;
+    void                      build_inner_levels();
+
+    [[nodiscard]] IteratorType      make_iterator(leaf_node* leaf_, SizeType index_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    node_base* m_root      = nullptr;
+    leaf_node* m_firstLeaf = nullptr;
+    leaf_node* m_lastLeaf  = nullptr;
+    SizeType   m_height    = 0;
+    SizeType   m_length    = 0;
+
+    [[no_unique_address]] CompareType   m_compare{};
+    [[no_unique_address]] AllocatorType m_allocator{};
+};
+
+
+/* clang-format off */
+#define BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__                                                  \
+        typename KeyType,                                                                          \
+        typename MappedType,                                                                       \
+        typename CompareType,                                                                      \
+        typename AllocatorType,                                                                    \
+        std::size_t NodeBytes
+
+#define BTREE_MAP_OPERATOR_ARGUMENTS__                                                             \
+        const btree_map<KeyType, MappedType, CompareType, AllocatorType, NodeBytes>& lhs_,         \
+        const btree_map<KeyType, MappedType, CompareType, AllocatorType, NodeBytes>& rhs_
+/* clang-format on */
+
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator==(BTREE_MAP_OPERATOR_ARGUMENTS__);
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator!=(BTREE_MAP_OPERATOR_ARGUMENTS__);
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator<(BTREE_MAP_OPERATOR_ARGUMENTS__);
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator<=(BTREE_MAP_OPERATOR_ARGUMENTS__);
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator>(BTREE_MAP_OPERATOR_ARGUMENTS__);
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator>=(BTREE_MAP_OPERATOR_ARGUMENTS__);
+
+
+}        // namespace pel
+
+#include "./btree_map.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
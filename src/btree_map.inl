@@ -0,0 +1,1678 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./btree_map.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define BTREE_MAP_TEMPLATE_DECLARATION__ typename KeyType,                                         \
+                                         typename MappedType,                                      \
+                                         typename CompareType,                                     \
+                                         typename AllocatorType,                                   \
+                                         std::size_t NodeBytes
+
+#define BTREE_MAP_CLASS_SCOPE__          btree_map<KeyType,                                        \
+                                                   MappedType,                                     \
+                                                   CompareType,                                    \
+                                                   AllocatorType,                                  \
+                                                   NodeBytes>
+
+#define BTREE_MAP_ITERATOR_CLASS_SCOPE__ btree_map_iterator<TreeType, IsConst>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+template<typename TreeType, bool IsConst>
+inline BTREE_MAP_ITERATOR_CLASS_SCOPE__::btree_map_iterator(const TreeType* tree_,
+                                                            LeafType*       leaf_,
+                                                            SizeType        index_) noexcept
+: m_tree{tree_}, m_leaf{leaf_}, m_index{index_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Convert a mutable iterator into a constant one.
+ *************************************************************************************************/
+template<typename TreeType, bool IsConst>
+template<bool OtherIsConst>
+    requires(IsConst && OtherIsConst == false)
+inline BTREE_MAP_ITERATOR_CLASS_SCOPE__::btree_map_iterator(
+  const btree_map_iterator<TreeType, OtherIsConst>& other_) noexcept
+: m_tree{other_.m_tree}, m_leaf{other_.m_leaf}, m_index{other_.m_index}
+{
+}
+
+
+template<typename TreeType, bool IsConst>
+inline typename BTREE_MAP_ITERATOR_CLASS_SCOPE__::reference
+BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator*() const noexcept
+{
+    return m_leaf->values()[m_index];
+}
+
+template<typename TreeType, bool IsConst>
+inline typename BTREE_MAP_ITERATOR_CLASS_SCOPE__::pointer
+BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator->() const noexcept
+{
+    return m_leaf->values() + m_index;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move to the next entry, following the link to the next leaf at the end of a leaf.
+ *              Past the last leaf, the iterator becomes end().
+ *************************************************************************************************/
+template<typename TreeType, bool IsConst>
+inline BTREE_MAP_ITERATOR_CLASS_SCOPE__& BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator++() noexcept
+{
+    if(++m_index == m_leaf->count)
+    {
+        m_leaf  = m_leaf->next;
+        m_index = 0;
+    }
+    return *this;
+}
+
+template<typename TreeType, bool IsConst>
+inline BTREE_MAP_ITERATOR_CLASS_SCOPE__ BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator++(int) noexcept
+{
+    btree_map_iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move to the previous entry. Decrementing end() gives the last entry of the map.
+ *************************************************************************************************/
+template<typename TreeType, bool IsConst>
+inline BTREE_MAP_ITERATOR_CLASS_SCOPE__& BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator--() noexcept
+{
+    if(m_leaf == nullptr)
+    {
+        m_leaf  = m_tree->m_lastLeaf;
+        m_index = m_leaf->count - 1;
+    }
+    else if(m_index == 0)
+    {
+        m_leaf  = m_leaf->previous;
+        m_index = m_leaf->count - 1;
+    }
+    else
+    {
+        --m_index;
+    }
+    return *this;
+}
+
+template<typename TreeType, bool IsConst>
+inline BTREE_MAP_ITERATOR_CLASS_SCOPE__ BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator--(int) noexcept
+{
+    btree_map_iterator previous = *this;
+    --*this;
+    return previous;
+}
+
+
+template<typename TreeType, bool IsConst>
+inline bool
+BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator==(const btree_map_iterator& rhs_) const noexcept
+{
+    return m_leaf == rhs_.m_leaf && m_index == rhs_.m_index;
+}
+
+template<typename TreeType, bool IsConst>
+inline bool
+BTREE_MAP_ITERATOR_CLASS_SCOPE__::operator!=(const btree_map_iterator& rhs_) const noexcept
+{
+    return !(*this == rhs_);
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty map. Nothing is allocated.
+ *
+ * \param       compare_: Strict weak ordering of the keys.
+ * \param       alloc_:   Allocator, rebound to allocate the nodes.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline BTREE_MAP_CLASS_SCOPE__::btree_map(const CompareType& compare_, const AllocatorType& alloc_)
+: m_compare{compare_}, m_allocator{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a map from a list of values.
+ *              Of values with equivalent keys, only the first one is kept.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline BTREE_MAP_CLASS_SCOPE__::btree_map(std::initializer_list<ValueType> values_,
+                                          const CompareType&               compare_,
+                                          const AllocatorType&             alloc_)
+: btree_map(values_.begin(), values_.end(), compare_, alloc_)
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a map from a range of values, in any order.
+ *              Of values with equivalent keys, only the first one is kept.
+ *              Use assign_sorted() to build the map in linear time from sorted input.
+ *
+ * \param       first_: Iterator to the first value.
+ * \param       last_:  Iterator past the last value.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline BTREE_MAP_CLASS_SCOPE__::btree_map(InputIterator        first_,
+                                          InputIterator        last_,
+                                          const CompareType&   compare_,
+                                          const AllocatorType& alloc_)
+: btree_map(compare_, alloc_)
+{
+    /* The delegated constructor completed: the destructor cleans up if this throws */
+    insert(first_, last_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every entry of another map. The copy is bulk loaded, leaves filled up.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline BTREE_MAP_CLASS_SCOPE__::btree_map(const btree_map& copy_)
+: m_compare{copy_.m_compare},
+  m_allocator{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)}
+{
+    assign_sorted(copy_.begin(), copy_.end());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the nodes of another map, leaving it empty.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline BTREE_MAP_CLASS_SCOPE__::btree_map(btree_map&& move_) noexcept
+: m_root{std::exchange(move_.m_root, nullptr)},
+  m_firstLeaf{std::exchange(move_.m_firstLeaf, nullptr)},
+  m_lastLeaf{std::exchange(move_.m_lastLeaf, nullptr)},
+  m_height{std::exchange(move_.m_height, 0)},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_compare{move_.m_compare},
+  m_allocator{move_.m_allocator}
+{
+}
+
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline BTREE_MAP_CLASS_SCOPE__& BTREE_MAP_CLASS_SCOPE__::operator=(const btree_map& copy_)
+{
+    if(this != &copy_)
+    {
+        btree_map copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline BTREE_MAP_CLASS_SCOPE__& BTREE_MAP_CLASS_SCOPE__::operator=(btree_map&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        clear();
+        m_root      = std::exchange(move_.m_root, nullptr);
+        m_firstLeaf = std::exchange(move_.m_firstLeaf, nullptr);
+        m_lastLeaf  = std::exchange(move_.m_lastLeaf, nullptr);
+        m_height    = std::exchange(move_.m_height, 0);
+        m_length    = std::exchange(move_.m_length, 0);
+        m_compare   = move_.m_compare;
+        m_allocator = move_.m_allocator;
+    }
+    return *this;
+}
+
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline BTREE_MAP_CLASS_SCOPE__::~btree_map()
+{
+    clear();
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the value mapped to a key.
+ *
+ * \param       key_: Key to look for.
+ * \retval      MappedType&: Reference to the mapped value.
+ * \throws      std::out_of_range if the key is not in the map.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline MappedType& BTREE_MAP_CLASS_SCOPE__::at(const KeyArgType<LookupType>& key_)
+{
+    IteratorType it = find<LookupType>(key_);
+    if(it == end())
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return it->second;
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline const MappedType& BTREE_MAP_CLASS_SCOPE__::at(const KeyArgType<LookupType>& key_) const
+{
+    ConstIteratorType it = find<LookupType>(key_);
+    if(it == end())
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return it->second;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the entry with the smallest key.
+ *
+ * \retval      ValueType&: Reference to the first entry.
+ * \throws      std::length_error if the map is empty.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::ValueType& BTREE_MAP_CLASS_SCOPE__::front()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return m_firstLeaf->values()[0];
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Access the entry with the largest key.
+ *
+ * \retval      ValueType&: Reference to the last entry.
+ * \throws      std::length_error if the map is empty.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::ValueType& BTREE_MAP_CLASS_SCOPE__::back()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return m_lastLeaf->values()[m_lastLeaf->count - 1];
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline const typename BTREE_MAP_CLASS_SCOPE__::ValueType& BTREE_MAP_CLASS_SCOPE__::front() const
+{
+    return const_cast<btree_map*>(this)->front();
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline const typename BTREE_MAP_CLASS_SCOPE__::ValueType& BTREE_MAP_CLASS_SCOPE__::back() const
+{
+    return const_cast<btree_map*>(this)->back();
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the value mapped to a key, default-constructing it if the key is missing.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline MappedType& BTREE_MAP_CLASS_SCOPE__::operator[](const KeyType& key_)
+{
+    return try_emplace(key_).first->second;
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline MappedType& BTREE_MAP_CLASS_SCOPE__::operator[](KeyType&& key_)
+{
+    return try_emplace(std::move(key_)).first->second;
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType BTREE_MAP_CLASS_SCOPE__::begin() noexcept
+{
+    return make_iterator(m_firstLeaf, 0);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType BTREE_MAP_CLASS_SCOPE__::end() noexcept
+{
+    return make_iterator(nullptr, 0);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::ConstIteratorType
+BTREE_MAP_CLASS_SCOPE__::begin() const noexcept
+{
+    return make_iterator(m_firstLeaf, 0);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::ConstIteratorType
+BTREE_MAP_CLASS_SCOPE__::end() const noexcept
+{
+    return make_iterator(nullptr, 0);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::ConstIteratorType
+BTREE_MAP_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::ConstIteratorType
+BTREE_MAP_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+
+
+/*************************************************************************************************/
+/* LOOKUP -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find the entry with a given key.
+ *
+ * \param       key_: Key to look for.
+ * \retval      IteratorType: Iterator to the entry, or end() if there is none.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType
+BTREE_MAP_CLASS_SCOPE__::find(const KeyArgType<LookupType>& key_)
+{
+    if(m_root == nullptr)
+    {
+        return end();
+    }
+
+    leaf_node*     leaf  = descend(key_, nullptr);
+    const SizeType index = leaf_lower_bound(leaf, key_);
+    if(index == leaf->count || m_compare(key_, leaf->values()[index].first))
+    {
+        return end();
+    }
+    return make_iterator(leaf, index);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::ConstIteratorType
+BTREE_MAP_CLASS_SCOPE__::find(const KeyArgType<LookupType>& key_) const
+{
+    return const_cast<btree_map*>(this)->template find<LookupType>(key_);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline bool BTREE_MAP_CLASS_SCOPE__::contains(const KeyArgType<LookupType>& key_) const
+{
+    return find<LookupType>(key_) != end();
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::SizeType
+BTREE_MAP_CLASS_SCOPE__::count(const KeyArgType<LookupType>& key_) const
+{
+    return contains<LookupType>(key_) ? 1 : 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first entry whose key is not less than a given key.
+ *              Entries from there on are read in order by walking the linked leaves.
+ *
+ * \param       key_: Key to compare against.
+ * \retval      IteratorType: Iterator to the entry, or end() if every key is less than key_.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType
+BTREE_MAP_CLASS_SCOPE__::lower_bound(const KeyArgType<LookupType>& key_)
+{
+    if(m_root == nullptr)
+    {
+        return end();
+    }
+
+    leaf_node*     leaf  = descend(key_, nullptr);
+    const SizeType index = leaf_lower_bound(leaf, key_);
+    return index == leaf->count ? make_iterator(leaf->next, 0) : make_iterator(leaf, index);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::ConstIteratorType
+BTREE_MAP_CLASS_SCOPE__::lower_bound(const KeyArgType<LookupType>& key_) const
+{
+    return const_cast<btree_map*>(this)->template lower_bound<LookupType>(key_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first entry whose key is greater than a given key.
+ *
+ * \param       key_: Key to compare against.
+ * \retval      IteratorType: Iterator to the entry, or end() if no key is greater than key_.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType
+BTREE_MAP_CLASS_SCOPE__::upper_bound(const KeyArgType<LookupType>& key_)
+{
+    if(m_root == nullptr)
+    {
+        return end();
+    }
+
+    leaf_node*     leaf  = descend(key_, nullptr);
+    const SizeType index = leaf_upper_bound(leaf, key_);
+    return index == leaf->count ? make_iterator(leaf->next, 0) : make_iterator(leaf, index);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::ConstIteratorType
+BTREE_MAP_CLASS_SCOPE__::upper_bound(const KeyArgType<LookupType>& key_) const
+{
+    return const_cast<btree_map*>(this)->template upper_bound<LookupType>(key_);
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Insert a value, unless an entry with an equivalent key exists.
+ *
+ * \param       value_: Value to insert.
+ * \retval      std::pair<IteratorType, bool>: Iterator to the entry with that key, and whether
+ *              the value was inserted.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::IteratorType, bool>
+BTREE_MAP_CLASS_SCOPE__::insert(const ValueType& value_)
+{
+    return insert_unique(ValueType(value_));
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::IteratorType, bool>
+BTREE_MAP_CLASS_SCOPE__::insert(ValueType&& value_)
+{
+    return insert_unique(std::move(value_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Insert every value of a range, one at a time.
+ *              Of values with equivalent keys, only the first one is kept.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline void BTREE_MAP_CLASS_SCOPE__::insert(InputIterator first_, InputIterator last_)
+{
+    for(; first_ != last_; ++first_)
+    {
+        insert_unique(ValueType(*first_));
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct a value in place, and insert it unless its key is already in the map.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::IteratorType, bool>
+BTREE_MAP_CLASS_SCOPE__::emplace(Args&&... args_)
+{
+    return insert_unique(ValueType(std::forward<Args>(args_)...));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Insert a value constructed from args_ under key_, if key_ is not in the map yet.
+ *              Nothing is constructed when the key is already there.
+ *
+ * \param       key_:  Key of the entry.
+ * \param       args_: Arguments forwarded to the constructor of the mapped value.
+ * \retval      std::pair<IteratorType, bool>: Iterator to the entry with that key, and whether
+ *              it was inserted.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::IteratorType, bool>
+BTREE_MAP_CLASS_SCOPE__::try_emplace(const KeyType& key_, Args&&... args_)
+{
+    IteratorType it = find(key_);
+    if(it != end())
+    {
+        return {it, false};
+    }
+    return insert_unique(ValueType(std::piecewise_construct,
+                                   std::forward_as_tuple(key_),
+                                   std::forward_as_tuple(std::forward<Args>(args_)...)));
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::IteratorType, bool>
+BTREE_MAP_CLASS_SCOPE__::try_emplace(KeyType&& key_, Args&&... args_)
+{
+    IteratorType it = find(key_);
+    if(it != end())
+    {
+        return {it, false};
+    }
+    return insert_unique(ValueType(std::piecewise_construct,
+                                   std::forward_as_tuple(std::move(key_)),
+                                   std::forward_as_tuple(std::forward<Args>(args_)...)));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Map key_ to object_, replacing the current value if key_ is already in the map.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename ObjectType>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::IteratorType, bool>
+BTREE_MAP_CLASS_SCOPE__::insert_or_assign(const KeyType& key_, ObjectType&& object_)
+{
+    IteratorType it = find(key_);
+    if(it != end())
+    {
+        it->second = std::forward<ObjectType>(object_);
+        return {it, false};
+    }
+    return insert_unique(ValueType(key_, std::forward<ObjectType>(object_)));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the content of the map with a range sorted by key, in linear time.
+ *
+ *              The leaves are filled up one after the other and linked, then each level of inner
+ *              nodes is built over the one below, without a single key comparison beyond the
+ *              check that the input is sorted.
+ *              Of consecutive values with equivalent keys, only the first one is kept.
+ *
+ * \param       first_: Iterator to the first value.
+ * \param       last_:  Iterator past the last value.
+ * \throws      std::invalid_argument if the range is not sorted; the map is then left empty.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline void BTREE_MAP_CLASS_SCOPE__::assign_sorted(InputIterator first_, InputIterator last_)
+{
+    clear();
+
+    try
+    {
+        for(; first_ != last_; ++first_)
+        {
+            ValueType value(*first_);
+            if(m_lastLeaf != nullptr)
+            {
+                const KeyType& lastKey = m_lastLeaf->values()[m_lastLeaf->count - 1].first;
+                if(!m_compare(lastKey, value.first))
+                {
+                    if(m_compare(value.first, lastKey))
+                    {
+                        throw std::invalid_argument("Input is not sorted");
+                    }
+                    continue;
+                }
+            }
+
+            if(m_lastLeaf == nullptr || m_lastLeaf->count == leaf_capacity)
+            {
+                leaf_node* leaf = allocate_leaf();
+                leaf->previous  = m_lastLeaf;
+                (m_lastLeaf == nullptr ? m_firstLeaf : m_lastLeaf->next) = leaf;
+                m_lastLeaf = leaf;
+            }
+
+            AllocatorTraits::construct(
+              m_allocator, m_lastLeaf->values() + m_lastLeaf->count, std::move(value));
+            ++m_lastLeaf->count;
+            ++m_length;
+        }
+
+        build_inner_levels();
+    }
+    catch(...)
+    {
+        /* Without a root yet, clear() would not find the leaves */
+        for(leaf_node* leaf = m_firstLeaf; leaf != nullptr;)
+        {
+            leaf_node* next = leaf->next;
+            deallocate_leaf(leaf);
+            leaf = next;
+        }
+        if(m_root != m_firstLeaf && m_root != nullptr)
+        {
+            destroy_subtree(m_root, m_height);
+        }
+        m_root      = nullptr;
+        m_firstLeaf = nullptr;
+        m_lastLeaf  = nullptr;
+        m_height    = 0;
+        m_length    = 0;
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the entry with a given key, if there is one.
+ *
+ * \param       key_: Key of the entry to erase.
+ * \retval      SizeType: Number of entries erased (0 or 1).
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::SizeType
+BTREE_MAP_CLASS_SCOPE__::erase(const KeyArgType<LookupType>& key_)
+{
+    IteratorType it = find<LookupType>(key_);
+    if(it == end())
+    {
+        return 0;
+    }
+    erase_at(it.m_leaf, it.m_index);
+    return 1;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the entry an iterator points to.
+ *
+ * \param       position_: Iterator to the entry to erase.
+ * \retval      IteratorType: Iterator to the entry that followed the erased one.
+ * \throws      std::invalid_argument if position_ is end().
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType
+BTREE_MAP_CLASS_SCOPE__::erase(ConstIteratorType position_)
+{
+    if(position_.m_tree != this || position_.m_leaf == nullptr)
+    {
+        throw std::invalid_argument("Invalid iterator");
+    }
+    return erase_at(position_.m_leaf, position_.m_index);
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType
+BTREE_MAP_CLASS_SCOPE__::erase(IteratorType position_)
+{
+    return erase(ConstIteratorType(position_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every entry and free every node.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::clear() noexcept
+{
+    if(m_root != nullptr)
+    {
+        destroy_subtree(m_root, m_height);
+    }
+    m_root      = nullptr;
+    m_firstLeaf = nullptr;
+    m_lastLeaf  = nullptr;
+    m_height    = 0;
+    m_length    = 0;
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::SizeType BTREE_MAP_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline bool BTREE_MAP_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline bool BTREE_MAP_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_length != 0;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Number of inner levels above the leaves; 0 when the root is a leaf.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::SizeType BTREE_MAP_CLASS_SCOPE__::height() const noexcept
+{
+    return m_height;
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline const AllocatorType& BTREE_MAP_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline const CompareType& BTREE_MAP_CLASS_SCOPE__::key_comp() const noexcept
+{
+    return m_compare;
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline std::string BTREE_MAP_CLASS_SCOPE__::to_string() const
+{
+    std::stringstream ss;
+    ss << "[";
+    for(ConstIteratorType it = begin(); it != end(); ++it)
+    {
+        if(it != begin())
+        {
+            ss << ", ";
+        }
+        if constexpr(requires { ss << it->first << it->second; })
+        {
+            ss << it->first << ": " << it->second;
+        }
+        else
+        {
+            ss << "?";
+        }
+    }
+    ss << "]";
+    return ss.str();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Walk down from the root to the leaf whose range holds a key.
+ *
+ * \param       key_:  Key to look for.
+ * \param       path_: If not null, receives the inner nodes visited and the child taken in each.
+ * \retval      leaf_node*: Leaf where the key is, or would be inserted.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::leaf_node*
+BTREE_MAP_CLASS_SCOPE__::descend(const LookupType& key_, tree_path* path_) const
+{
+    node_base* node = m_root;
+    for(SizeType level = m_height; level > 0; --level)
+    {
+        inner_node*    inner = static_cast<inner_node*>(node);
+        const SizeType child = child_index(inner, key_);
+        if(path_ != nullptr)
+        {
+            path_->nodes[path_->depth]    = inner;
+            path_->children[path_->depth] = child;
+            ++path_->depth;
+        }
+        node = inner->children[child];
+        prefetch(node);
+    }
+    return static_cast<leaf_node*>(node);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Child of an inner node to follow for a key: the number of separators not greater
+ *              than the key, as each separator is the smallest key of the child to its right.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::SizeType
+BTREE_MAP_CLASS_SCOPE__::child_index(inner_node* node_, const LookupType& key_) const
+{
+    return branchless_partition_point(node_->keys(),
+                                      node_->count,
+                                      [&](const KeyType& separator_)
+                                      { return !m_compare(key_, separator_); });
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::SizeType
+BTREE_MAP_CLASS_SCOPE__::leaf_lower_bound(leaf_node* leaf_, const LookupType& key_) const
+{
+    return branchless_partition_point(leaf_->values(),
+                                      leaf_->count,
+                                      [&](const ValueType& value_)
+                                      { return m_compare(value_.first, key_); });
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename BTREE_MAP_CLASS_SCOPE__::SizeType
+BTREE_MAP_CLASS_SCOPE__::leaf_upper_bound(leaf_node* leaf_, const LookupType& key_) const
+{
+    return branchless_partition_point(leaf_->values(),
+                                      leaf_->count,
+                                      [&](const ValueType& value_)
+                                      { return !m_compare(key_, value_.first); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Insert a value in its leaf, splitting the leaf and its ancestors as needed.
+ *
+ *              A full leaf takes the value in its spare slot, then moves its upper half to a new
+ *              leaf. When the value was appended past the last key of the map, the new leaf only
+ *              receives that value instead: ascending insertions leave full leaves behind.
+ *              Every node the split needs is allocated before the tree is modified, so a failed
+ *              allocation leaves the map unchanged.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::IteratorType, bool>
+BTREE_MAP_CLASS_SCOPE__::insert_unique(ValueType&& value_)
+{
+    if(m_root == nullptr)
+    {
+        m_firstLeaf = allocate_leaf();
+        m_lastLeaf  = m_firstLeaf;
+        m_root      = m_firstLeaf;
+    }
+
+    tree_path      path;
+    leaf_node*     leaf   = descend(value_.first, &path);
+    ValueType*     values = leaf->values();
+    const SizeType index  = leaf_lower_bound(leaf, value_.first);
+    if(index != leaf->count && !m_compare(value_.first, values[index].first))
+    {
+        return {make_iterator(leaf, index), false};
+    }
+
+    if(leaf->count < leaf_capacity)
+    {
+        insert_into_leaf(leaf, index, std::move(value_));
+        return {make_iterator(leaf, index), true};
+    }
+
+    /* Every full ancestor splits too, and the root needs a new parent if it splits */
+    const bool     isAppend = leaf == m_lastLeaf && index == leaf_capacity;
+    const SizeType split    = isAppend ? leaf_capacity : (leaf_capacity + 1) / 2;
+    KeyType        separator(index < split    ? values[split - 1].first
+                             : index == split ? value_.first
+                                              : values[split].first);
+
+    node_reserve reserve;
+    SizeType     depth = path.depth;
+    while(depth != 0 && path.nodes[depth - 1]->count == inner_capacity)
+    {
+        --depth;
+    }
+    const SizeType innerCount = path.depth - depth + (depth == 0 ? 1 : 0);
+
+    leaf_node* right = allocate_leaf();
+    try
+    {
+        for(; reserve.count < innerCount; ++reserve.count)
+        {
+            reserve.nodes[reserve.count] = allocate_inner();
+        }
+    }
+    catch(...)
+    {
+        for(SizeType i = 0; i < reserve.count; ++i)
+        {
+            deallocate_inner(reserve.nodes[i]);
+        }
+        deallocate_leaf(right);
+        throw;
+    }
+
+    insert_into_leaf(leaf, index, std::move(value_));
+
+    ValueType* rightValues = right->values();
+    for(SizeType i = split; i < leaf->count; ++i)
+    {
+        AllocatorTraits::construct(m_allocator, rightValues + (i - split), std::move(values[i]));
+        AllocatorTraits::destroy(m_allocator, values + i);
+    }
+    right->count = leaf->count - split;
+    leaf->count  = split;
+
+    right->previous = leaf;
+    right->next     = leaf->next;
+    (leaf->next == nullptr ? m_lastLeaf : leaf->next->previous) = right;
+    leaf->next = right;
+
+    insert_into_parent(path, reserve, leaf, std::move(separator), right);
+
+    if(index < split)
+    {
+        return {make_iterator(leaf, index), true};
+    }
+    return {make_iterator(right, index - split), true};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Shift the entries of a leaf from index_ on by one slot, and put a value in the gap.
+ *              The leaf may be filled up to its spare slot.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::insert_into_leaf(leaf_node* leaf_,
+                                                      SizeType   index_,
+                                                      ValueType&& value_)
+{
+    ValueType* values = leaf_->values();
+    if(index_ == leaf_->count)
+    {
+        AllocatorTraits::construct(m_allocator, values + index_, std::move(value_));
+    }
+    else
+    {
+        AllocatorTraits::construct(
+          m_allocator, values + leaf_->count, std::move(values[leaf_->count - 1]));
+        std::move_backward(values + index_, values + leaf_->count - 1, values + leaf_->count);
+        values[index_] = std::move(value_);
+    }
+    ++leaf_->count;
+    ++m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Add a new right sibling to a node, splitting full inner nodes on the way up.
+ *
+ *              The parent takes the separator and the child in its spare slots; if it is then
+ *              over capacity, its middle separator moves up along with a new right sibling.
+ *              Splitting the root grows the tree by a level.
+ *
+ * \param       path_:      Inner nodes above left_, as recorded by descend().
+ * \param       reserve_:   Nodes allocated beforehand for the splits and the new root.
+ * \param       left_:      Node that was split.
+ * \param       separator_: Smallest key of right_.
+ * \param       right_:     New node, to be placed just after left_.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::insert_into_parent(tree_path&    path_,
+                                                        node_reserve& reserve_,
+                                                        node_base*    left_,
+                                                        KeyType&&     separator_,
+                                                        node_base*    right_) noexcept
+{
+    KeyAllocatorType keyAllocator{m_allocator};
+
+    while(path_.depth != 0)
+    {
+        --path_.depth;
+        inner_node*    parent = path_.nodes[path_.depth];
+        const SizeType child  = path_.children[path_.depth];
+        KeyType*       keys   = parent->keys();
+
+        if(child == parent->count)
+        {
+            KeyTraits::construct(keyAllocator, keys + child, std::move(separator_));
+        }
+        else
+        {
+            KeyTraits::construct(
+              keyAllocator, keys + parent->count, std::move(keys[parent->count - 1]));
+            std::move_backward(keys + child, keys + parent->count - 1, keys + parent->count);
+            keys[child] = std::move(separator_);
+        }
+        std::move_backward(parent->children + child + 1,
+                           parent->children + parent->count + 1,
+                           parent->children + parent->count + 2);
+        parent->children[child + 1] = right_;
+        ++parent->count;
+
+        if(parent->count <= inner_capacity)
+        {
+            return;
+        }
+
+        /* The middle separator moves up, those after it go to the new sibling */
+        inner_node*    sibling = reserve_.nodes[--reserve_.count];
+        const SizeType middle  = parent->count / 2;
+        for(SizeType i = middle + 1; i < parent->count; ++i)
+        {
+            KeyTraits::construct(
+              keyAllocator, sibling->keys() + (i - middle - 1), std::move(keys[i]));
+            KeyTraits::destroy(keyAllocator, keys + i);
+        }
+        std::copy(parent->children + middle + 1,
+                  parent->children + parent->count + 1,
+                  sibling->children);
+        sibling->count = parent->count - middle - 1;
+
+        separator_ = std::move(keys[middle]);
+        KeyTraits::destroy(keyAllocator, keys + middle);
+        parent->count = middle;
+
+        left_  = parent;
+        right_ = sibling;
+    }
+
+    inner_node* root = reserve_.nodes[--reserve_.count];
+    KeyTraits::construct(keyAllocator, root->keys(), std::move(separator_));
+    root->children[0] = left_;
+    root->children[1] = right_;
+    root->count       = 1;
+    m_root            = root;
+    ++m_height;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the entry at a position of a leaf, then rebalance the leaf if it fell under
+ *              leaf_minimum entries.
+ *
+ * \retval      IteratorType: Iterator to the entry that followed the erased one.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType
+BTREE_MAP_CLASS_SCOPE__::erase_at(leaf_node* leaf_, SizeType index_)
+{
+    ValueType* values = leaf_->values();
+
+    /* Find the path down to the leaf while the key is still there */
+    tree_path  path;
+    const bool isUnderflow = m_height != 0 && leaf_->count <= leaf_minimum;
+    if(isUnderflow)
+    {
+        std::ignore = descend(values[index_].first, &path);
+    }
+
+    std::move(values + index_ + 1, values + leaf_->count, values + index_);
+    AllocatorTraits::destroy(m_allocator, values + leaf_->count - 1);
+    --leaf_->count;
+    --m_length;
+
+    if(isUnderflow)
+    {
+        std::tie(leaf_, index_) = rebalance_leaf(leaf_, index_, path);
+    }
+    else if(leaf_->count == 0)
+    {
+        /* The root leaf held the last entry */
+        deallocate_leaf(leaf_);
+        m_root      = nullptr;
+        m_firstLeaf = nullptr;
+        m_lastLeaf  = nullptr;
+        return end();
+    }
+
+    return index_ == leaf_->count ? make_iterator(leaf_->next, 0) : make_iterator(leaf_, index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Bring a leaf that fell under leaf_minimum entries back in balance with a sibling.
+ *
+ *              A sibling above leaf_minimum gives the leaf half of the entries it has in excess,
+ *              and the separator between them is updated. Otherwise the two leaves hold at most
+ *              leaf_capacity entries together and the right one is merged into the left one,
+ *              which removes a child from the parent and may rebalance it in turn.
+ *
+ * \param       leaf_:  Leaf that was erased from.
+ * \param       index_: Position of an entry of the leaf.
+ * \param       path_:  Inner nodes above the leaf, as recorded by descend().
+ * \retval      std::pair<leaf_node*, SizeType>: Leaf and position where that entry now is.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline std::pair<typename BTREE_MAP_CLASS_SCOPE__::leaf_node*,
+                 typename BTREE_MAP_CLASS_SCOPE__::SizeType>
+BTREE_MAP_CLASS_SCOPE__::rebalance_leaf(leaf_node* leaf_, SizeType index_, tree_path& path_)
+{
+    inner_node*    parent = path_.nodes[path_.depth - 1];
+    const SizeType child  = path_.children[path_.depth - 1];
+    KeyType*       keys   = parent->keys();
+    ValueType*     values = leaf_->values();
+
+    leaf_node* left = child == 0 ? leaf_ : static_cast<leaf_node*>(parent->children[child - 1]);
+    leaf_node* right =
+      child == parent->count ? leaf_ : static_cast<leaf_node*>(parent->children[child + 1]);
+
+    /* A missing sibling is stood in for by the leaf itself, which never has entries to spare */
+    if(left->count > leaf_minimum)
+    {
+        /* Shift the entries up, constructing the slots past the end, then fill the front */
+        const SizeType moved      = (left->count - leaf_->count + 1) / 2;
+        ValueType*     leftValues = left->values() + (left->count - moved);
+        for(SizeType i = leaf_->count; i-- > 0;)
+        {
+            if(i + moved >= leaf_->count)
+            {
+                AllocatorTraits::construct(m_allocator, values + i + moved, std::move(values[i]));
+            }
+            else
+            {
+                values[i + moved] = std::move(values[i]);
+            }
+        }
+        for(SizeType i = 0; i < moved; ++i)
+        {
+            if(i < leaf_->count)
+            {
+                values[i] = std::move(leftValues[i]);
+            }
+            else
+            {
+                AllocatorTraits::construct(m_allocator, values + i, std::move(leftValues[i]));
+            }
+            AllocatorTraits::destroy(m_allocator, leftValues + i);
+        }
+        left->count -= moved;
+        leaf_->count += moved;
+        keys[child - 1] = values[0].first;
+        return {leaf_, index_ + moved};
+    }
+
+    if(right->count > leaf_minimum)
+    {
+        const SizeType moved       = (right->count - leaf_->count + 1) / 2;
+        ValueType*     rightValues = right->values();
+        for(SizeType i = 0; i < moved; ++i)
+        {
+            AllocatorTraits::construct(
+              m_allocator, values + leaf_->count + i, std::move(rightValues[i]));
+        }
+        std::move(rightValues + moved, rightValues + right->count, rightValues);
+        for(SizeType i = right->count - moved; i < right->count; ++i)
+        {
+            AllocatorTraits::destroy(m_allocator, rightValues + i);
+        }
+        right->count -= moved;
+        leaf_->count += moved;
+        keys[child] = rightValues[0].first;
+        return {leaf_, index_};
+    }
+
+    /* Merge the right leaf of the pair into the left one */
+    const SizeType mergedChild = child == 0 ? 1 : child;
+    if(child != 0)
+    {
+        index_ += left->count;
+        right = leaf_;
+        leaf_ = left;
+    }
+
+    ValueType* leftValues  = leaf_->values();
+    ValueType* rightValues = right->values();
+    for(SizeType i = 0; i < right->count; ++i)
+    {
+        AllocatorTraits::construct(
+          m_allocator, leftValues + leaf_->count + i, std::move(rightValues[i]));
+    }
+    leaf_->count += right->count;
+
+    leaf_->next = right->next;
+    (right->next == nullptr ? m_lastLeaf : right->next->previous) = leaf_;
+    deallocate_leaf(right);
+
+    erase_child(parent, mergedChild);
+    rebalance_inner(path_);
+    return {leaf_, index_};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Bring the inner nodes of a path back in balance, from the bottom one up.
+ *
+ *              A node under inner_minimum separators rotates one separator through its parent from
+ *              a sibling that has some to spare, or is merged with the sibling along with the
+ *              separator between them. A root left without separators is replaced by its only
+ *              child.
+ *
+ * \param       path_: Inner nodes from the root down to the last one that lost a child.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::rebalance_inner(tree_path& path_) noexcept
+{
+    KeyAllocatorType keyAllocator{m_allocator};
+
+    for(; path_.depth > 1; --path_.depth)
+    {
+        inner_node* node = path_.nodes[path_.depth - 1];
+        if(node->count >= inner_minimum)
+        {
+            return;
+        }
+
+        inner_node*    parent = path_.nodes[path_.depth - 2];
+        const SizeType child  = path_.children[path_.depth - 2];
+        KeyType*       keys   = parent->keys();
+
+        inner_node* left =
+          child == 0 ? node : static_cast<inner_node*>(parent->children[child - 1]);
+        inner_node* right =
+          child == parent->count ? node : static_cast<inner_node*>(parent->children[child + 1]);
+
+        /* A missing sibling is stood in for by the node itself, which never has keys to spare */
+        if(left->count > inner_minimum)
+        {
+            /* The separator comes down in front of the node, the last key of left goes up */
+            KeyType* nodeKeys = node->keys();
+            if(node->count == 0)
+            {
+                KeyTraits::construct(keyAllocator, nodeKeys, std::move(keys[child - 1]));
+            }
+            else
+            {
+                KeyTraits::construct(
+                  keyAllocator, nodeKeys + node->count, std::move(nodeKeys[node->count - 1]));
+                std::move_backward(nodeKeys, nodeKeys + node->count - 1, nodeKeys + node->count);
+                nodeKeys[0] = std::move(keys[child - 1]);
+            }
+            std::move_backward(
+              node->children, node->children + node->count + 1, node->children + node->count + 2);
+            node->children[0] = left->children[left->count];
+            ++node->count;
+
+            keys[child - 1] = std::move(left->keys()[left->count - 1]);
+            KeyTraits::destroy(keyAllocator, left->keys() + left->count - 1);
+            --left->count;
+            return;
+        }
+
+        if(right->count > inner_minimum)
+        {
+            /* The separator comes down after the node, the first key of right goes up */
+            KeyType* rightKeys = right->keys();
+            KeyTraits::construct(keyAllocator, node->keys() + node->count, std::move(keys[child]));
+            node->children[node->count + 1] = right->children[0];
+            ++node->count;
+
+            keys[child] = std::move(rightKeys[0]);
+            std::move(rightKeys + 1, rightKeys + right->count, rightKeys);
+            KeyTraits::destroy(keyAllocator, rightKeys + right->count - 1);
+            std::copy(right->children + 1, right->children + right->count + 1, right->children);
+            --right->count;
+            return;
+        }
+
+        /* Merge the right node of the pair into the left one, the separator between them first */
+        const SizeType mergedChild = child == 0 ? 1 : child;
+        if(child != 0)
+        {
+            right = node;
+            node  = left;
+        }
+
+        KeyType* nodeKeys = node->keys();
+        KeyTraits::construct(
+          keyAllocator, nodeKeys + node->count, std::move(keys[mergedChild - 1]));
+        for(SizeType i = 0; i < right->count; ++i)
+        {
+            KeyTraits::construct(
+              keyAllocator, nodeKeys + node->count + 1 + i, std::move(right->keys()[i]));
+        }
+        std::copy(right->children,
+                  right->children + right->count + 1,
+                  node->children + node->count + 1);
+        node->count += right->count + 1;
+        deallocate_inner(right);
+
+        erase_child(parent, mergedChild);
+    }
+
+    inner_node* root = static_cast<inner_node*>(m_root);
+    if(root->count == 0)
+    {
+        m_root = root->children[0];
+        deallocate_inner(root);
+        --m_height;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove a child from an inner node, along with the separator on its left.
+ *
+ * \param       node_:  Inner node.
+ * \param       child_: Index of the child to remove, at least 1.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::erase_child(inner_node* node_, SizeType child_) noexcept
+{
+    KeyAllocatorType keyAllocator{m_allocator};
+    KeyType*         keys = node_->keys();
+
+    std::move(keys + child_, keys + node_->count, keys + child_ - 1);
+    KeyTraits::destroy(keyAllocator, keys + node_->count - 1);
+    std::copy(node_->children + child_ + 1,
+              node_->children + node_->count + 1,
+              node_->children + child_);
+    --node_->count;
+}
+
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::leaf_node* BTREE_MAP_CLASS_SCOPE__::allocate_leaf()
+{
+    LeafAllocatorType leafAllocator{m_allocator};
+    leaf_node*        leaf = LeafTraits::allocate(leafAllocator, 1);
+    std::construct_at(leaf);
+    return leaf;
+}
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::inner_node* BTREE_MAP_CLASS_SCOPE__::allocate_inner()
+{
+    InnerAllocatorType innerAllocator{m_allocator};
+    inner_node*        node = InnerTraits::allocate(innerAllocator, 1);
+    std::construct_at(node);
+    return node;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the entries of a leaf and free it.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::deallocate_leaf(leaf_node* leaf_) noexcept
+{
+    for(SizeType i = 0; i < leaf_->count; ++i)
+    {
+        AllocatorTraits::destroy(m_allocator, leaf_->values() + i);
+    }
+
+    LeafAllocatorType leafAllocator{m_allocator};
+    std::destroy_at(leaf_);
+    LeafTraits::deallocate(leafAllocator, leaf_, 1);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the separators of an inner node and free it, leaving its children alone.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::deallocate_inner(inner_node* node_) noexcept
+{
+    KeyAllocatorType keyAllocator{m_allocator};
+    for(SizeType i = 0; i < node_->count; ++i)
+    {
+        KeyTraits::destroy(keyAllocator, node_->keys() + i);
+    }
+
+    InnerAllocatorType innerAllocator{m_allocator};
+    std::destroy_at(node_);
+    InnerTraits::deallocate(innerAllocator, node_, 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free a node and everything below it.
+ *
+ * \param       node_:  Root of the subtree.
+ * \param       level_: Height of node_ above the leaves.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::destroy_subtree(node_base* node_, SizeType level_) noexcept
+{
+    if(level_ == 0)
+    {
+        deallocate_leaf(static_cast<leaf_node*>(node_));
+        return;
+    }
+
+    inner_node* inner = static_cast<inner_node*>(node_);
+    for(SizeType i = 0; i <= inner->count; ++i)
+    {
+        destroy_subtree(inner->children[i], level_ - 1);
+    }
+    deallocate_inner(inner);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Build the inner levels over the linked leaves, bottom-up.
+ *
+ *              The nodes of each level are split as evenly as possible between parents of at most
+ *              inner_capacity + 1 children; the separator in front of each child is the first key
+ *              of its leftmost leaf, carried up along with the node.
+ *************************************************************************************************/
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline void BTREE_MAP_CLASS_SCOPE__::build_inner_levels()
+{
+    using LevelEntry     = std::pair<node_base*, const KeyType*>;
+    using LevelAllocator = typename AllocatorTraits::template rebind_alloc<LevelEntry>;
+    using LevelType      = std::vector<LevelEntry, LevelAllocator>;
+
+    if(m_firstLeaf == nullptr)
+    {
+        return;
+    }
+
+    LevelType level{LevelAllocator{m_allocator}};
+    for(leaf_node* leaf = m_firstLeaf; leaf != nullptr; leaf = leaf->next)
+    {
+        level.emplace_back(leaf, &leaf->values()[0].first);
+    }
+    m_root = m_firstLeaf;
+
+    KeyAllocatorType keyAllocator{m_allocator};
+    while(level.size() > 1)
+    {
+        const SizeType parentCount = (level.size() + inner_capacity) / (inner_capacity + 1);
+        const SizeType perParent   = level.size() / parentCount;
+        const SizeType remainder   = level.size() % parentCount;
+
+        LevelType parents{LevelAllocator{m_allocator}};
+        parents.reserve(parentCount);
+
+        SizeType next = 0;
+        for(SizeType p = 0; p < parentCount; ++p)
+        {
+            const SizeType childCount = perParent + (p < remainder ? 1 : 0);
+            inner_node*    parent     = allocate_inner();
+            parents.emplace_back(parent, level[next].second);
+
+            parent->children[0] = level[next].first;
+            for(SizeType c = 1; c < childCount; ++c)
+            {
+                KeyTraits::construct(
+                  keyAllocator, parent->keys() + (c - 1), *level[next + c].second);
+                parent->children[c] = level[next + c].first;
+                parent->count       = c;
+            }
+            next += childCount;
+        }
+
+        level  = std::move(parents);
+        m_root = level[0].first;
+        ++m_height;
+    }
+}
+
+
+template<BTREE_MAP_TEMPLATE_DECLARATION__>
+inline typename BTREE_MAP_CLASS_SCOPE__::IteratorType
+BTREE_MAP_CLASS_SCOPE__::make_iterator(leaf_node* leaf_, SizeType index_) const noexcept
+{
+    return IteratorType(this, leaf_, index_);
+}
+
+
+
+/*************************************************************************************************/
+/* COMPARISON OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Two maps are equal when they hold equal entries, in the same order.
+ *************************************************************************************************/
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator==(BTREE_MAP_OPERATOR_ARGUMENTS__)
+{
+    return lhs_.length() == rhs_.length() && std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+}
+
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator!=(BTREE_MAP_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ == rhs_);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Lexicographical comparison of the entries of two maps, in key order.
+ *************************************************************************************************/
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator<(BTREE_MAP_OPERATOR_ARGUMENTS__)
+{
+    return std::lexicographical_compare(lhs_.begin(), lhs_.end(), rhs_.begin(), rhs_.end());
+}
+
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator<=(BTREE_MAP_OPERATOR_ARGUMENTS__)
+{
+    return !(rhs_ < lhs_);
+}
+
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator>(BTREE_MAP_OPERATOR_ARGUMENTS__)
+{
+    return rhs_ < lhs_;
+}
+
+template<BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator>=(BTREE_MAP_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ < rhs_);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef BTREE_MAP_TEMPLATE_DECLARATION__
+#undef BTREE_MAP_CLASS_SCOPE__
+#undef BTREE_MAP_ITERATOR_CLASS_SCOPE__
+#undef BTREE_MAP_OPERATOR_TEMPLATE_DECLARATION__
+#undef BTREE_MAP_OPERATOR_ARGUMENTS__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,297 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Pack 128 values of width_ bits each into width_ * 4 words.
+ *
+ *              Value i goes to lane i % 4, the lanes being interleaved word by word, so that one
+ *              128-bit load feeds four values at a time when unpacking, and the four values come
+ *              out in order.
+ *
+ * \param       values_: 128 values, each below 2^width_.
+ * \param       width_:  Number of bits per value, from 1 to 32.
+ * \param       words_:  Destination, width_ * 4 zeroed words.
+ *************************************************************************************************/
+inline void
+bit_pack_128(const std::uint32_t* values_, unsigned width_, std::uint32_t* words_) noexcept;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unpack 128 values packed by bit_pack_128(), four at a time with SSE2.
+ *
+ * \param       words_:  width_ * 4 packed words.
+ * \param       width_:  Number of bits per value, from 1 to 32.
+ * \param       values_: Destination for the 128 values.
+ *************************************************************************************************/
+inline void
+bit_unpack_128(const std::uint32_t* words_, unsigned width_, std::uint32_t* values_) noexcept;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Extract a single value packed by bit_pack_128().
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint32_t
+bit_extract_128(const std::uint32_t* words_, unsigned width_, std::size_t index_) noexcept;
+
+
+/**
+ * \brief       Input iterator streaming the values of a compressed_int_container.
+ *              Decodes a whole block at a time into a buffer of its own.
+ */
+template<typename ContainerType>
+class compressed_int_iterator
+{
+public:
+    using SizeType = typename ContainerType::SizeType;
+
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = typename ContainerType::ValueType;
+    using difference_type   = typename ContainerType::DifferenceType;
+    using pointer           = const value_type*;
+    using reference         = const value_type&;
+
+    compressed_int_iterator() noexcept = default;
+    compressed_int_iterator(const ContainerType* container_, SizeType index_);
+
+    [[nodiscard]] reference operator*() const noexcept;
+    [[nodiscard]] pointer   operator->() const noexcept;
+
+    compressed_int_iterator& operator++();
+    compressed_int_iterator  operator++(int);
+
+    [[nodiscard]] SizeType index() const noexcept;
+
+    [[nodiscard]] bool operator==(const compressed_int_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator!=(const compressed_int_iterator& rhs_) const noexcept;
+
+private:
+    void load_block();
+
+    const ContainerType*                                      m_container = nullptr;
+    SizeType                                                  m_index     = 0;
+    std::array<value_type, ContainerType::values_per_block> m_buffer{};
+};
+
+
+/**
+ * \brief       Sequence of integers compressed in blocks of 128 values.
+ *
+ *              Each full block is stored with whichever encoding packs it in fewer bits:
+ *              - frame of reference: the offset of each value from the block minimum;
+ *              - delta: the difference of each value with the previous one, from the smallest
+ *                difference, which suits sorted IDs and slowly changing timestamps;
+ *              - raw, when neither fits in 32 bits.
+ *              Offsets are bit-packed in four interleaved lanes so that decode_block() unpacks
+ *              four values per instruction with SSE2 straight into the caller's buffer.
+ *
+ *              Values are appended to an uncompressed tail of up to 128 values, compressed once
+ *              full. Reading a value of a frame of reference block is constant time; a delta block
+ *              is decoded up to that value. Iterating decodes each block once.
+ *
+ *              Offers the familiar container_base surface (length, is_empty, at, front, back,
+ *              comparisons), but is not derived from it as the values are not stored as such:
+ *              accessors return values, and values cannot be modified in place.
+ */
+template<std::integral IntegerType, typename AllocatorType = std::allocator<IntegerType>>
+class compressed_int_container
+{
+    static_assert(std::is_same_v<IntegerType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(!std::is_same_v<IntegerType, bool>, "Use bit_container to store bools");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType         = IntegerType;
+    using AllocatorTraits   = std::allocator_traits<AllocatorType>;
+    using SizeType          = std::size_t;
+    using DifferenceType    = std::ptrdiff_t;
+    using ConstIteratorType = compressed_int_iterator<compressed_int_container>;
+
+    constexpr static const SizeType values_per_block = 128;
+
+private:
+    using UnsignedType = std::make_unsigned_t<IntegerType>;
+    using SignedType   = std::make_signed_t<IntegerType>;
+
+    enum class block_encoding : std::uint8_t
+    {
+        frame_of_reference,
+        delta,
+        raw,
+    };
+
+    struct block_header
+    {
+        UnsignedType   reference = 0;        /* Minimum, or first value for delta */
+        UnsignedType   minDelta  = 0;        /* Smallest difference, for delta */
+        SizeType       offset    = 0;        /* First word in the word stream */
+        std::uint8_t   width     = 0;        /* Bits per packed value */
+        block_encoding encoding  = block_encoding::frame_of_reference;
+    };
+
+    using HeaderAllocatorType = typename AllocatorTraits::template rebind_alloc<block_header>;
+    using WordAllocatorType   = typename AllocatorTraits::template rebind_alloc<std::uint32_t>;
+
+    /* Words a raw value takes in the word stream */
+    constexpr static const SizeType raw_words = (sizeof(IntegerType) + 3) / 4;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit compressed_int_container(const AllocatorType& alloc_ = AllocatorType{});
+    compressed_int_container(std::initializer_list<IntegerType> values_,
+                             const AllocatorType&               alloc_ = AllocatorType{});
+    template<typename InputIterator>
+    compressed_int_container(InputIterator        first_,
+                             InputIterator        last_,
+                             const AllocatorType& alloc_ = AllocatorType{});
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] IntegerType at(SizeType index_) const;
+    [[nodiscard]] IntegerType front() const;
+    [[nodiscard]] IntegerType back() const;
+
+    [[nodiscard]] SizeType block_count() const noexcept;
+    SizeType               decode_block(SizeType block_, std::span<IntegerType> values_) const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] IntegerType operator[](SizeType index_) const;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] ConstIteratorType begin() const;
+    [[nodiscard]] ConstIteratorType end() const;
+    [[nodiscard]] ConstIteratorType cbegin() const;
+    [[nodiscard]] ConstIteratorType cend() const;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    void push_back(IntegerType value_);
+    void pop_back();
+    void clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_not_empty() const noexcept;
+    [[nodiscard]] SizeType             compressed_bytes() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void compress_tail();
+
+    template<std::integral Type>
+    [[nodiscard]] static std::uint64_t difference(Type lhs_, Type rhs_) noexcept;
+    [[nodiscard]] static unsigned      width_of(std::uint64_t range_) noexcept;
+    [[nodiscard]] static IntegerType   raw_value(const std::uint32_t* words_,
+                                                 SizeType             index_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::vector<block_header, HeaderAllocatorType> m_headers;
+    std::vector<std::uint32_t, WordAllocatorType>  m_words;
+
+    std::array<IntegerType, values_per_block> m_tail{};
+    SizeType                                  m_tailLength = 0;
+
+    [[no_unique_address]] AllocatorType m_allocator{};
+};
+
+
+/* clang-format off */
+#define COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__                                              \
+        const compressed_int_container<IntegerType, AllocatorType>& lhs_,                          \
+        const compressed_int_container<IntegerType, AllocatorType>& rhs_
+/* clang-format on */
+
+template<std::integral IntegerType, typename AllocatorType>
+[[nodiscard]] bool operator==(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<std::integral IntegerType, typename AllocatorType>
+[[nodiscard]] bool operator!=(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<std::integral IntegerType, typename AllocatorType>
+[[nodiscard]] bool operator<(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<std::integral IntegerType, typename AllocatorType>
+[[nodiscard]] bool operator<=(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<std::integral IntegerType, typename AllocatorType>
+[[nodiscard]] bool operator>(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__);
+template<std::integral IntegerType, typename AllocatorType>
+[[nodiscard]] bool operator>=(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__);
+
+
+}        // namespace pel
+
+#include "./compressed_int_container.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,745 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./compressed_int_container.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__ std::integral IntegerType,                 \
+                                                        typename AllocatorType
+
+#define COMPRESSED_INT_CONTAINER_CLASS_SCOPE__          compressed_int_container<IntegerType,      \
+                                                                                 AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* BIT PACKING --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+inline void
+bit_pack_128(const std::uint32_t* values_, unsigned width_, std::uint32_t* words_) noexcept
+{
+    for(std::size_t i = 0; i < 128; ++i)
+    {
+        const std::size_t lane  = i % 4;
+        const std::size_t bit   = (i / 4) * width_;
+        const std::size_t word  = bit / 32;
+        const unsigned    shift = static_cast<unsigned>(bit % 32);
+
+        words_[4 * word + lane] |= values_[i] << shift;
+        if(shift + width_ > 32)
+        {
+            words_[4 * (word + 1) + lane] |= values_[i] >> (32 - shift);
+        }
+    }
+}
+
+inline void
+bit_unpack_128(const std::uint32_t* words_, unsigned width_, std::uint32_t* values_) noexcept
+{
+#if PEL_HAS_SSE2
+    /* Each lane holds 32 values on width_ words: the last value ends exactly on a word boundary */
+    const std::uint32_t mask  = width_ == 32 ? ~std::uint32_t{0} : (std::uint32_t{1} << width_) - 1;
+    const __m128i       masks = _mm_set1_epi32(static_cast<int>(mask));
+
+    const __m128i*      input   = reinterpret_cast<const __m128i*>(words_);
+    __m128i             current = _mm_loadu_si128(input++);
+    unsigned            shift   = 0;
+    for(std::size_t slot = 0; slot < 32; ++slot)
+    {
+        __m128i value = _mm_srl_epi32(current, _mm_cvtsi32_si128(static_cast<int>(shift)));
+        shift += width_;
+        if(shift >= 32 && slot != 31)
+        {
+            /* The value continues in the next word, or starts it when shift is back to 0 */
+            shift -= 32;
+            current = _mm_loadu_si128(input++);
+            if(shift != 0)
+            {
+                const __m128i carry = _mm_cvtsi32_si128(static_cast<int>(width_ - shift));
+                value               = _mm_or_si128(value, _mm_sll_epi32(current, carry));
+            }
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values_ + 4 * slot),
+                         _mm_and_si128(value, masks));
+    }
+#else
+    for(std::size_t i = 0; i < 128; ++i)
+    {
+        values_[i] = bit_extract_128(words_, width_, i);
+    }
+#endif
+}
+
+inline std::uint32_t
+bit_extract_128(const std::uint32_t* words_, unsigned width_, std::size_t index_) noexcept
+{
+    const std::size_t lane  = index_ % 4;
+    const std::size_t bit   = (index_ / 4) * width_;
+    const std::size_t word  = bit / 32;
+    const unsigned    shift = static_cast<unsigned>(bit % 32);
+
+    std::uint32_t value = words_[4 * word + lane] >> shift;
+    if(shift + width_ > 32)
+    {
+        value |= words_[4 * (word + 1) + lane] << (32 - shift);
+    }
+    return width_ == 32 ? value : value & ((std::uint32_t{1} << width_) - 1);
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<typename ContainerType>
+inline compressed_int_iterator<ContainerType>::compressed_int_iterator(
+  const ContainerType* container_, SizeType index_)
+: m_container{container_}, m_index{index_}
+{
+    if(m_index < m_container->length())
+    {
+        load_block();
+    }
+}
+
+template<typename ContainerType>
+inline typename compressed_int_iterator<ContainerType>::reference
+compressed_int_iterator<ContainerType>::operator*() const noexcept
+{
+    return m_buffer[m_index % ContainerType::values_per_block];
+}
+
+template<typename ContainerType>
+inline typename compressed_int_iterator<ContainerType>::pointer
+compressed_int_iterator<ContainerType>::operator->() const noexcept
+{
+    return &**this;
+}
+
+template<typename ContainerType>
+inline compressed_int_iterator<ContainerType>& compressed_int_iterator<ContainerType>::operator++()
+{
+    if(++m_index % ContainerType::values_per_block == 0 && m_index < m_container->length())
+    {
+        load_block();
+    }
+    return *this;
+}
+
+template<typename ContainerType>
+inline compressed_int_iterator<ContainerType>
+compressed_int_iterator<ContainerType>::operator++(int)
+{
+    compressed_int_iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+template<typename ContainerType>
+inline typename compressed_int_iterator<ContainerType>::SizeType
+compressed_int_iterator<ContainerType>::index() const noexcept
+{
+    return m_index;
+}
+
+template<typename ContainerType>
+inline bool compressed_int_iterator<ContainerType>::operator==(
+  const compressed_int_iterator& rhs_) const noexcept
+{
+    return m_index == rhs_.m_index;
+}
+
+template<typename ContainerType>
+inline bool compressed_int_iterator<ContainerType>::operator!=(
+  const compressed_int_iterator& rhs_) const noexcept
+{
+    return m_index != rhs_.m_index;
+}
+
+template<typename ContainerType>
+inline void compressed_int_iterator<ContainerType>::load_block()
+{
+    m_container->decode_block(m_index / ContainerType::values_per_block, m_buffer);
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::compressed_int_container(const AllocatorType& alloc_)
+: m_headers{HeaderAllocatorType{alloc_}}, m_words{WordAllocatorType{alloc_}}, m_allocator{alloc_}
+{
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::compressed_int_container(
+  std::initializer_list<IntegerType> values_, const AllocatorType& alloc_)
+: compressed_int_container(values_.begin(), values_.end(), alloc_)
+{
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::compressed_int_container(
+  InputIterator first_, InputIterator last_, const AllocatorType& alloc_)
+: compressed_int_container(alloc_)
+{
+    for(; first_ != last_; ++first_)
+    {
+        push_back(*first_);
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Decode the value at a position.
+ *
+ * \param       index_: Position of the value.
+ * \retval      IntegerType: Value at that position.
+ * \throws      std::length_error if index_ is past the end of the container.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline IntegerType COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::at(SizeType index_) const
+{
+    if(index_ >= length())
+    {
+        throw std::length_error("Index out of range");
+    }
+    return (*this)[index_];
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline IntegerType COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::front() const
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return (*this)[0];
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline IntegerType COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::back() const
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return (*this)[length() - 1];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of blocks, the last one being partial unless length() is a multiple of
+ *              values_per_block.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::SizeType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::block_count() const noexcept
+{
+    return m_headers.size() + (m_tailLength != 0 ? 1 : 0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Decode all the values of a block into a buffer.
+ *
+ * \param       block_:  Index of the block; values block_ * values_per_block and onwards.
+ * \param       values_: Buffer to decode into, of values_per_block values for a full block.
+ * \retval      SizeType: Number of values decoded; less than values_per_block for the last block.
+ * \throws      std::length_error if the block does not exist or the buffer is too small.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::SizeType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::decode_block(SizeType               block_,
+                                                     std::span<IntegerType> values_) const
+{
+    if(block_ >= block_count())
+    {
+        throw std::length_error("Index out of range");
+    }
+    const SizeType count = block_ < m_headers.size() ? values_per_block : m_tailLength;
+    if(values_.size() < count)
+    {
+        throw std::length_error("Buffer too small");
+    }
+
+    if(block_ == m_headers.size())
+    {
+        std::copy_n(m_tail.begin(), m_tailLength, values_.begin());
+        return count;
+    }
+
+    const block_header&  header = m_headers[block_];
+    const std::uint32_t* words  = m_words.data() + header.offset;
+    if(header.encoding == block_encoding::raw)
+    {
+        for(SizeType i = 0; i < values_per_block; ++i)
+        {
+            values_[i] = raw_value(words, i);
+        }
+        return count;
+    }
+
+    alignas(16) std::array<std::uint32_t, values_per_block> offsets{};
+    if(header.width != 0)
+    {
+        bit_unpack_128(words, header.width, offsets.data());
+    }
+
+    std::uint64_t running = header.reference;
+    if(header.encoding == block_encoding::frame_of_reference)
+    {
+        for(SizeType i = 0; i < values_per_block; ++i)
+        {
+            values_[i] = static_cast<IntegerType>(running + offsets[i]);
+        }
+    }
+    else
+    {
+        values_[0] = static_cast<IntegerType>(running);
+        for(SizeType i = 1; i < values_per_block; ++i)
+        {
+            running += std::uint64_t{header.minDelta} + offsets[i];
+            values_[i] = static_cast<IntegerType>(running);
+        }
+    }
+    return count;
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Decode the value at a position, without bounds checking.
+ *              Constant time, except in delta blocks which are summed up to the value.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline IntegerType COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::operator[](SizeType index_) const
+{
+    const SizeType block    = index_ / values_per_block;
+    const SizeType position = index_ % values_per_block;
+    if(block == m_headers.size())
+    {
+        return m_tail[position];
+    }
+
+    const block_header&  header = m_headers[block];
+    const std::uint32_t* words  = m_words.data() + header.offset;
+    if(header.encoding == block_encoding::raw)
+    {
+        return raw_value(words, position);
+    }
+    if(header.width == 0)
+    {
+        return static_cast<IntegerType>(
+          std::uint64_t{header.reference}
+          + (header.encoding == block_encoding::delta ? position * header.minDelta : SizeType{0}));
+    }
+
+    std::uint64_t running = header.reference;
+    if(header.encoding == block_encoding::frame_of_reference)
+    {
+        return static_cast<IntegerType>(running + bit_extract_128(words, header.width, position));
+    }
+
+    /* Unpacking the whole block is cheaper than extracting the offsets one by one */
+    alignas(16) std::array<std::uint32_t, values_per_block> offsets{};
+    bit_unpack_128(words, header.width, offsets.data());
+    running += position * std::uint64_t{header.minDelta};
+    for(SizeType i = 1; i <= position; ++i)
+    {
+        running += offsets[i];
+    }
+    return static_cast<IntegerType>(running);
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::begin() const
+{
+    return ConstIteratorType(this, 0);
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::end() const
+{
+    return ConstIteratorType(this, length());
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::cbegin() const
+{
+    return begin();
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::cend() const
+{
+    return end();
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Append a value, compressing the tail block once it is full.
+ *
+ * \param       value_: Value to append.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::push_back(IntegerType value_)
+{
+    m_tail[m_tailLength++] = value_;
+    if(m_tailLength == values_per_block)
+    {
+        try
+        {
+            compress_tail();
+        }
+        catch(...)
+        {
+            --m_tailLength;
+            throw;
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove the last value, decompressing the last block when the tail is empty.
+ *
+ * \throws      std::length_error if the container is empty.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::pop_back()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+
+    if(m_tailLength == 0)
+    {
+        decode_block(m_headers.size() - 1, m_tail);
+        m_words.resize(m_headers.back().offset);
+        m_headers.pop_back();
+        m_tailLength = values_per_block;
+    }
+    --m_tailLength;
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::clear() noexcept
+{
+    m_headers.clear();
+    m_words.clear();
+    m_tailLength = 0;
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::SizeType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::length() const noexcept
+{
+    return m_headers.size() * values_per_block + m_tailLength;
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return length() == 0;
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return length() != 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Bytes taken by the values: block headers, packed words and uncompressed tail.
+ *              Compare with length() * sizeof(IntegerType) for the compression ratio.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::SizeType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::compressed_bytes() const noexcept
+{
+    return m_headers.size() * sizeof(block_header) + m_words.size() * sizeof(std::uint32_t)
+           + m_tailLength * sizeof(IntegerType);
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline const AllocatorType& COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::shrink_to_fit()
+{
+    m_headers.shrink_to_fit();
+    m_words.shrink_to_fit();
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline std::string COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::to_string() const
+{
+    std::stringstream ss;
+    ss << "[";
+    for(auto it = begin(); it != end(); ++it)
+    {
+        ss << (it.index() == 0 ? "" : ", ") << +*it;
+    }
+    ss << "]";
+    return ss.str();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Compress the full tail into a new block, with the encoding taking the fewest bits.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline void COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::compress_tail()
+{
+    const auto [lowest, highest] = std::minmax_element(m_tail.begin(), m_tail.end());
+
+    SignedType minDelta = std::numeric_limits<SignedType>::max();
+    SignedType maxDelta = std::numeric_limits<SignedType>::min();
+    for(SizeType i = 1; i < values_per_block; ++i)
+    {
+        const SignedType delta = static_cast<SignedType>(difference(m_tail[i], m_tail[i - 1]));
+        minDelta               = std::min(minDelta, delta);
+        maxDelta               = std::max(maxDelta, delta);
+    }
+
+    const unsigned referenceWidth = width_of(difference(*highest, *lowest));
+    const unsigned deltaWidth     = width_of(difference(maxDelta, minDelta));
+
+    /* Reserve first, so that the container is left unchanged if an allocation fails. Capacity
+     * doubles: reserving the exact size would copy every block on each append */
+    const bool     isRaw     = std::min(referenceWidth, deltaWidth) > 32;
+    const SizeType wordCount = isRaw ? raw_words * values_per_block
+                                     : 4 * std::size_t{std::min(referenceWidth, deltaWidth)};
+    if(m_headers.size() == m_headers.capacity())
+    {
+        m_headers.reserve(std::max<SizeType>(2 * m_headers.size(), 4));
+    }
+    if(m_words.capacity() - m_words.size() < wordCount)
+    {
+        m_words.reserve(std::max(2 * m_words.capacity(), m_words.size() + wordCount));
+    }
+
+    block_header header;
+    header.offset = m_words.size();
+    if(isRaw)
+    {
+        header.encoding = block_encoding::raw;
+        header.width    = static_cast<std::uint8_t>(raw_words * 32);
+        for(const IntegerType value : m_tail)
+        {
+            const std::uint64_t bits = static_cast<UnsignedType>(value);
+            for(SizeType word = 0; word < raw_words; ++word)
+            {
+                m_words.push_back(static_cast<std::uint32_t>(bits >> (32 * word)));
+            }
+        }
+    }
+    else
+    {
+        alignas(16) std::array<std::uint32_t, values_per_block> offsets{};
+        if(referenceWidth <= deltaWidth)
+        {
+            header.encoding  = block_encoding::frame_of_reference;
+            header.width     = static_cast<std::uint8_t>(referenceWidth);
+            header.reference = static_cast<UnsignedType>(*lowest);
+            for(SizeType i = 0; i < values_per_block; ++i)
+            {
+                offsets[i] = static_cast<std::uint32_t>(difference(m_tail[i], *lowest));
+            }
+        }
+        else
+        {
+            header.encoding  = block_encoding::delta;
+            header.width     = static_cast<std::uint8_t>(deltaWidth);
+            header.reference = static_cast<UnsignedType>(m_tail[0]);
+            header.minDelta  = static_cast<UnsignedType>(minDelta);
+            for(SizeType i = 1; i < values_per_block; ++i)
+            {
+                const auto delta = static_cast<SignedType>(difference(m_tail[i], m_tail[i - 1]));
+                offsets[i]       = static_cast<std::uint32_t>(difference(delta, minDelta));
+            }
+        }
+
+        m_words.resize(m_words.size() + 4 * header.width, 0);
+        if(header.width != 0)
+        {
+            bit_pack_128(offsets.data(), header.width, m_words.data() + header.offset);
+        }
+    }
+
+    m_headers.push_back(header);
+    m_tailLength = 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Difference of two values, modulo 2^N for N-bit integers.
+ *************************************************************************************************/
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+template<std::integral Type>
+inline std::uint64_t
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::difference(Type lhs_, Type rhs_) noexcept
+{
+    const std::uint64_t lhs = static_cast<std::make_unsigned_t<Type>>(lhs_);
+    const std::uint64_t rhs = static_cast<std::make_unsigned_t<Type>>(rhs_);
+    return (lhs - rhs) & std::numeric_limits<UnsignedType>::max();
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline unsigned COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::width_of(std::uint64_t range_) noexcept
+{
+    return static_cast<unsigned>(std::bit_width(range_));
+}
+
+template<COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__>
+inline IntegerType
+COMPRESSED_INT_CONTAINER_CLASS_SCOPE__::raw_value(const std::uint32_t* words_,
+                                                  SizeType             index_) noexcept
+{
+    std::uint64_t bits = 0;
+    for(SizeType word = 0; word < raw_words; ++word)
+    {
+        bits |= std::uint64_t{words_[index_ * raw_words + word]} << (32 * word);
+    }
+    return static_cast<IntegerType>(bits);
+}
+
+
+
+/*************************************************************************************************/
+/* COMPARISON OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<std::integral IntegerType, typename AllocatorType>
+inline bool operator==(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return lhs_.length() == rhs_.length() && std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+}
+
+template<std::integral IntegerType, typename AllocatorType>
+inline bool operator!=(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ == rhs_);
+}
+
+template<std::integral IntegerType, typename AllocatorType>
+inline bool operator<(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return std::lexicographical_compare(lhs_.begin(), lhs_.end(), rhs_.begin(), rhs_.end());
+}
+
+template<std::integral IntegerType, typename AllocatorType>
+inline bool operator<=(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return !(rhs_ < lhs_);
+}
+
+template<std::integral IntegerType, typename AllocatorType>
+inline bool operator>(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return rhs_ < lhs_;
+}
+
+template<std::integral IntegerType, typename AllocatorType>
+inline bool operator>=(COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ < rhs_);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef COMPRESSED_INT_CONTAINER_TEMPLATE_DECLARATION__
+#undef COMPRESSED_INT_CONTAINER_CLASS_SCOPE__
+#undef COMPRESSED_INT_CONTAINER_OPERATOR_ARGUMENTS__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
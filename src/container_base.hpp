@@ -26,17 +26,48 @@
 
 /*************************************************************************************************/
 /* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
 #include "./iterator_base.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 
 
 namespace pel
 {
+/**
+ * \brief       Range whose elements can be converted to the elements of a container, as C++23's
+ *              container-compatible-range.
+ */
+template<typename RangeType, typename ItemType>
+concept container_compatible_range =
+  std::ranges::input_range<RangeType>
+  && std::convertible_to<std::ranges::range_reference_t<RangeType>, ItemType>;
+
+/**
+ * \brief       Tag selecting the constructors that build a container from a range, standing in for
+ *              C++23's std::from_range_t.
+ */
+struct from_range_t
+{
+    explicit from_range_t() = default;
+};
+inline constexpr from_range_t from_range{};
+
+
 template<typename ItemType,
          typename IteratorType  = typename pel::iterator_base<ItemType>,
          typename AllocatorType = std::allocator<ItemType>>
@@ -112,6 +143,19 @@ public:
     [[nodiscard]] virtual std::string to_string() const = 0;
 
 
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+protected:
+    /* Not every container can drop elements without breaking its own invariants (heap order,
+     * handle tables, ...), so these are opted into by the derived containers that can */
+    template<typename PredicateType>
+    constexpr SizeType erase_if(PredicateType predicate_);
+    template<std::ranges::forward_range IndexRange>
+    constexpr SizeType erase_indices(const IndexRange& indices_)
+        requires(std::convertible_to<std::ranges::range_reference_t<const IndexRange>, SizeType>);
+    constexpr void swap_erase(SizeType index_);
+
+
     /*********************************************************************************************/
     /* Private methods ------------------------------------------------------------------------- */
 protected:
@@ -119,6 +163,7 @@ protected:
 
     constexpr void add_size(SizeType addedLength_);
     constexpr void change_size(SizeType newLength_);
+    constexpr void truncate(SizeType newLength_);
 
 
     /*********************************************************************************************/
@@ -129,6 +174,15 @@ protected:
     AllocatorType m_allocator{};
 
     constexpr static const bool container_safeness = true;
+
+    /* Elements that the erase_if compaction copies unconditionally instead of branching on */
+    constexpr static const bool branchless_compaction =
+      std::is_trivially_copyable_v<ItemType> && std::is_copy_assignable_v<ItemType> &&
+      sizeof(ItemType) <= 2 * sizeof(void*);
+
+    /* Of those, elements that it packs a block at a time with compact_words() */
+    constexpr static const bool vectorized_compaction =
+      branchless_compaction && sizeof(ItemType) == 4 && compaction_block_words != 0;
 };
 
 /* clang-format off */
@@ -168,6 +222,18 @@ template<CONTAINER_BASE_OPERATOR_TEMPLATE_DECLARATION__>
 [[nodiscard]] constexpr std::strong_ordering operator<=>(CONTAINER_BASE_OPERATOR_ARGUMENTS__);
 #endif
 
+template<typename ContainerType, typename PredicateType>
+constexpr typename ContainerType::SizeType erase_if(ContainerType& container_,
+                                                    PredicateType  predicate_)
+    requires(requires { container_.erase_if(predicate_); });
+template<typename ContainerType, std::ranges::forward_range IndexRange>
+constexpr typename ContainerType::SizeType erase_indices(ContainerType&    container_,
+                                                         const IndexRange& indices_)
+    requires(requires { container_.erase_indices(indices_); });
+template<typename ContainerType>
+constexpr void swap_erase(ContainerType& container_, typename ContainerType::SizeType index_)
+    requires(requires { container_.swap_erase(index_); });
+
 
 }        // namespace pel
 
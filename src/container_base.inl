@@ -295,6 +295,7 @@ template<CONTAINER_BASE_OPERATOR_TEMPLATE_DEFINITION__>
         bool isEqual = std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
         return isEqual;
     }
+    return false;
 }
 
 
@@ -612,6 +613,248 @@ CONTAINER_BASE_CLASS_SCOPE__::clear()
 }
 
 
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Erase every element for which a predicate returns true, keeping the order of the
+ *              others, and destroy the removed tail in one pass.
+ *
+ *              Small trivially copyable elements are compacted without branching: every element
+ *              is copied to the write position, which only moves forward when it is kept, so the
+ *              loop costs the same whatever the selectivity is. With AVX-512 or AVX2, 4-byte
+ *              elements go a block at a time instead: the predicate fills a mask of the kept
+ *              elements, which compact_words() packs with one compress or permutation and one
+ *              store. Other elements are moved over the erased ones through the underlying
+ *              pointers, as std::remove_if does.
+ *
+ * \param       predicate_: Called with a const reference to each element, returns true to erase.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *************************************************************************************************/
+template<CONTAINER_BASE_TEMPLATE_DECLARATION__>
+template<typename PredicateType>
+constexpr inline typename CONTAINER_BASE_CLASS_SCOPE__::SizeType
+CONTAINER_BASE_CLASS_SCOPE__::erase_if(PredicateType predicate_)
+{
+    ItemType* const first = begin().ptr();
+    ItemType* const last  = end().ptr();
+
+    auto isErased = [&predicate_](const ItemType& item_) -> bool {
+        return static_cast<bool>(std::invoke(predicate_, item_));
+    };
+
+    /* Kept elements before the first erased one stay where they are */
+    ItemType* output = std::find_if(first, last, isErased);
+    if(output == last)
+    {
+        return 0;
+    }
+
+    if constexpr(branchless_compaction == true)
+    {
+        ItemType* input = output + 1;
+        if constexpr(vectorized_compaction == true)
+        {
+            /* The output never passes the input, so each store stays within read elements */
+            constexpr SizeType lanes = compaction_block_words;
+            if(std::is_constant_evaluated() == false)
+            {
+                for(; static_cast<SizeType>(last - input) >= lanes; input += lanes)
+                {
+                    std::array<std::uint32_t, lanes> flags;
+                    for(SizeType lane = 0; lane < lanes; ++lane)
+                    {
+                        flags[lane] = isErased(input[lane]) ? 0U : ~0U;
+                    }
+                    const unsigned keep = compaction_mask(flags.data());
+                    compact_words(output, input, keep);
+                    output += std::popcount(keep);
+                }
+            }
+        }
+
+        for(; input != last; ++input)
+        {
+            const bool isKept = !isErased(*input);
+            *output           = *input;
+            output += static_cast<DifferenceType>(isKept);
+        }
+    }
+    else
+    {
+        for(ItemType* input = output + 1; input != last; ++input)
+        {
+            if(isErased(*input) == false)
+            {
+                *output = std::move(*input);
+                ++output;
+            }
+        }
+    }
+
+    const SizeType newLength = static_cast<SizeType>(output - first);
+    const SizeType erased    = length() - newLength;
+    truncate(newLength);
+    return erased;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the elements at a list of indices, keeping the order of the others.
+ *              The elements between two erased ones are moved down as a block, which is a single
+ *              memmove for trivially copyable elements.
+ *
+ * \param       indices_: Indices of the elements to erase, sorted in strictly increasing order.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *
+ * \throws      std::length_error("Index out of range"):
+ *              If an index is not below the length of the container.
+ * \throws      std::invalid_argument("Indices must be sorted and unique"):
+ *              If the indices are not in strictly increasing order.
+ *              The container is left untouched in both cases.
+ *************************************************************************************************/
+template<CONTAINER_BASE_TEMPLATE_DECLARATION__>
+template<std::ranges::forward_range IndexRange>
+constexpr inline typename CONTAINER_BASE_CLASS_SCOPE__::SizeType
+CONTAINER_BASE_CLASS_SCOPE__::erase_indices(const IndexRange& indices_)
+    requires(std::convertible_to<std::ranges::range_reference_t<const IndexRange>, SizeType>)
+{
+    const SizeType oldLength = length();
+
+    SizeType erased = 0;
+    SizeType next   = 0;
+    for(const SizeType index : indices_)
+    {
+        if constexpr(container_safeness == true)
+        {
+            if(index >= oldLength)
+            {
+                throw std::length_error("Index out of range");
+            }
+            if(index < next)
+            {
+                throw std::invalid_argument("Indices must be sorted and unique");
+            }
+        }
+        next = index + 1;
+        ++erased;
+    }
+
+    if(erased == 0)
+    {
+        return 0;
+    }
+
+    /* Each run of kept elements is moved down to the end of the previous one */
+    auto            index     = std::ranges::begin(indices_);
+    const SizeType  firstHole = *index;
+    ItemType* const items     = begin().ptr();
+    ItemType*       output    = items + firstHole;
+    SizeType        kept      = firstHole + 1;
+    for(++index; index != std::ranges::end(indices_); ++index)
+    {
+        const SizeType hole = *index;
+        output              = std::move(items + kept, items + hole, output);
+        kept                = hole + 1;
+    }
+    output = std::move(items + kept, items + oldLength, output);
+
+    truncate(static_cast<SizeType>(output - items));
+    return erased;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase an element in O(1) by moving the last element into its place.
+ *              The order of the elements is not kept.
+ *
+ * \param       index_: Index of the element to erase.
+ *
+ * \throws      std::length_error("Index out of range"): If the index is not below the length.
+ *************************************************************************************************/
+template<CONTAINER_BASE_TEMPLATE_DECLARATION__>
+constexpr inline void
+CONTAINER_BASE_CLASS_SCOPE__::swap_erase(SizeType index_)
+{
+    const SizeType oldLength = length();
+    if constexpr(container_safeness == true)
+    {
+        if(index_ >= oldLength)
+        {
+            throw std::length_error("Index out of range");
+        }
+    }
+
+    ItemType* const items = begin().ptr();
+    if(index_ != oldLength - 1)
+    {
+        items[index_] = std::move(items[oldLength - 1]);
+    }
+    truncate(oldLength - 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase every element of a container for which a predicate returns true.
+ *              Available for the containers that expose an erase_if member.
+ *
+ * \param       container_: Container to erase the elements from.
+ * \param       predicate_: Called with a const reference to each element, returns true to erase.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *************************************************************************************************/
+template<typename ContainerType, typename PredicateType>
+constexpr inline typename ContainerType::SizeType
+erase_if(ContainerType& container_, PredicateType predicate_)
+    requires(requires { container_.erase_if(predicate_); })
+{
+    return container_.erase_if(std::move(predicate_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the elements of a container at a sorted list of indices.
+ *              Available for the containers that expose an erase_indices member.
+ *
+ * \param       container_: Container to erase the elements from.
+ * \param       indices_:   Indices of the elements to erase, sorted in strictly increasing order.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *************************************************************************************************/
+template<typename ContainerType, std::ranges::forward_range IndexRange>
+constexpr inline typename ContainerType::SizeType
+erase_indices(ContainerType& container_, const IndexRange& indices_)
+    requires(requires { container_.erase_indices(indices_); })
+{
+    return container_.erase_indices(indices_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase an element of a container in O(1), without keeping the order of the others.
+ *              Available for the containers that expose a swap_erase member.
+ *
+ * \param       container_: Container to erase the element from.
+ * \param       index_:     Index of the element to erase.
+ *************************************************************************************************/
+template<typename ContainerType>
+constexpr inline void
+swap_erase(ContainerType& container_, typename ContainerType::SizeType index_)
+    requires(requires { container_.swap_erase(index_); })
+{
+    container_.swap_erase(index_);
+}
+
+
 /*************************************************************************************************/
 /* MISC ---------------------------------------------------------------------------------------- */
 /*************************************************************************************************/
@@ -634,7 +877,7 @@ template<CONTAINER_BASE_TEMPLATE_DECLARATION__>
 constexpr inline void
 CONTAINER_BASE_CLASS_SCOPE__::check_if_valid(IteratorType iterator_) const
 {
-    if constexpr(vector_safeness == true)
+    if constexpr(container_safeness == true)
     {
         if((iterator_ < cbegin()) || (iterator_ > cend()))
         {
@@ -672,6 +915,29 @@ CONTAINER_BASE_CLASS_SCOPE__::change_size(SizeType newLength_)
 }
 
 
+/**
+ **************************************************************************************************
+ * \brief       Destroy the elements past a new length and shrink the container to it.
+ *
+ * \param       newLength_: New length (in elements) of the container, at most the current one.
+ *************************************************************************************************/
+template<CONTAINER_BASE_TEMPLATE_DECLARATION__>
+constexpr inline void
+CONTAINER_BASE_CLASS_SCOPE__::truncate(SizeType newLength_)
+{
+    if constexpr(std::is_trivially_destructible_v<ItemType> == false)
+    {
+        ItemType* const items = begin().ptr();
+        for(SizeType index = newLength_; index < length(); ++index)
+        {
+            AllocatorTraits::destroy(m_allocator, items + index);
+        }
+    }
+
+    change_size(newLength_);
+}
+
+
 /*************************************************************************************************/
 /* Undefines ----------------------------------------------------------------------------------- */
 #undef CONTAINER_BASE_TEMPLATE_DECLARATION__
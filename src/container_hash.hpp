@@ -0,0 +1,103 @@
+﻿/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+#include "./hash_bytes.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Hash the elements of a container, in order, consistently with operator==.
+ *              Elements whose bytes are equal exactly when they are (integers, enumerations,
+ *              pointers, structures of them without padding) are hashed as one contiguous buffer
+ *              with hash_bytes. Others are hashed with std::hash, and the element hashes are then
+ *              hashed together.
+ *
+ * \param       container_: Container to hash.
+ * \param       seed_:      Value selecting one of the family of hash functions.
+ *
+ * \retval      std::uint64_t: Hash of the elements.
+ *************************************************************************************************/
+template<typename ItemType, typename IteratorType, typename AllocatorType>
+[[nodiscard]] inline std::uint64_t
+hash_container(const container_base<ItemType, IteratorType, AllocatorType>& container_,
+               std::uint64_t                                                seed_ = 0)
+    requires(bytewise_hashable<ItemType> || requires(const ItemType& item_) {
+        { std::hash<ItemType>{}(item_) } -> std::convertible_to<std::size_t>;
+    })
+{
+    if constexpr(bytewise_hashable<ItemType> && requires { container_.begin().ptr(); })
+    {
+        return hash_bytes(container_.begin().ptr(), container_.length() * sizeof(ItemType), seed_);
+    }
+    else
+    {
+        byte_hasher hasher(seed_);
+        for(const ItemType& item : container_)
+        {
+            const std::size_t itemHash = std::hash<ItemType>{}(item);
+            hasher.append(itemHash);
+        }
+        return hasher.digest();
+    }
+}
+
+
+/**
+ * \brief       Hasher for every container deriving from container_base whose elements can be
+ *              hashed, consistent with its operator==. See hash_container.
+ *
+ *              std::hash may only be specialized for types named in the specialization, not for
+ *              every type satisfying a constraint, so unordered containers keyed by containers
+ *              take this hasher instead: std::unordered_set<cow_container<int>, container_hasher>.
+ */
+struct container_hasher
+{
+    template<typename ContainerType>
+        requires(requires(const ContainerType& container_) { hash_container(container_); })
+    [[nodiscard]] std::size_t operator()(const ContainerType& container_) const
+    {
+        return hash_container(container_);
+    }
+};
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,258 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Copy-on-write contiguous container.
+ *
+ *              Copies share the element buffer and only bump an atomic reference count, so taking
+ *              a snapshot is O(1). The first access through a non-const accessor (operator[], at,
+ *              front, back, begin, end) or any modifier on a shared buffer makes a private copy
+ *              first. Const accessors are inherited from container_base untouched and never look
+ *              at the reference count.
+ *
+ *              Buffers produced elsewhere (a decoder's output, a malloc'ed block, a std::vector)
+ *              can be adopted without copying, and the buffer can be released back to the caller.
+ */
+template<typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+class cow_container : public container_base<ItemType, iterator_base<ItemType>, AllocatorType>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using BaseType        = container_base<ItemType, iterator_base<ItemType>, AllocatorType>;
+    using IteratorType    = iterator_base<ItemType>;
+    using AllocatorTraits = typename BaseType::AllocatorTraits;
+    using SizeType        = typename BaseType::SizeType;
+    using DifferenceType  = typename BaseType::DifferenceType;
+
+    /* Buffer handed back by release(), to be destroyed and deallocated through get_allocator() */
+    struct released_buffer
+    {
+        ItemType* items    = nullptr;
+        SizeType  length   = 0;
+        SizeType  capacity = 0;
+    };
+
+private:
+    struct control_block
+    {
+        std::atomic<SizeType> referenceCount{1};
+        SizeType              capacity = 0;
+
+        /* Only set on adopted buffers with a deleter, which then frees both the items and the
+         * block itself instead of the allocator */
+        void (*dispose)(control_block*, ItemType*, const AllocatorType&) noexcept = nullptr;
+    };
+
+    template<typename DeleterType>
+    struct adopted_control_block : control_block
+    {
+        explicit adopted_control_block(DeleterType&& deleter_) noexcept
+        : deleter{std::move(deleter_)}
+        {
+        }
+
+        [[no_unique_address]] DeleterType deleter;
+    };
+
+    using ControlAllocatorType = typename AllocatorTraits::template rebind_alloc<control_block>;
+    using ControlTraits        = std::allocator_traits<ControlAllocatorType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit cow_container(const AllocatorType& alloc_ = AllocatorType{});
+    cow_container(SizeType             count_,
+                  const ItemType&      value_,
+                  const AllocatorType& alloc_ = AllocatorType{});
+    cow_container(std::initializer_list<ItemType> items_,
+                  const AllocatorType&            alloc_ = AllocatorType{});
+    template<container_compatible_range<ItemType> RangeType>
+    cow_container(from_range_t,
+                  RangeType&&          range_,
+                  const AllocatorType& alloc_ = AllocatorType{});
+
+    cow_container(const cow_container& copy_) noexcept;
+    cow_container(cow_container&& move_) noexcept;
+    cow_container& operator=(const cow_container& copy_) noexcept;
+    cow_container& operator=(cow_container&& move_) noexcept;
+
+    ~cow_container() override;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    using BaseType::front;
+    using BaseType::back;
+    [[nodiscard]] ItemType& front();
+    [[nodiscard]] ItemType& back();
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&       operator[](SizeType index_) override;
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const override;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    using BaseType::begin;
+    using BaseType::end;
+    [[nodiscard]] IteratorType begin();
+    [[nodiscard]] IteratorType end();
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    template<typename... Args>
+    ItemType& emplace_back(Args&&... args_);
+    void      push_back(const ItemType& item_);
+    void      push_back(ItemType&& item_);
+    void      pop_back();
+
+    template<container_compatible_range<ItemType> RangeType>
+    void assign_range(RangeType&& range_);
+    template<container_compatible_range<ItemType> RangeType>
+    void append_range(RangeType&& range_);
+    template<container_compatible_range<ItemType> RangeType>
+    void insert_range(SizeType index_, RangeType&& range_);
+
+    template<typename PredicateType>
+    SizeType erase_if(PredicateType predicate_);
+    template<std::ranges::forward_range IndexRange>
+    SizeType erase_indices(const IndexRange& indices_)
+        requires(std::convertible_to<std::ranges::range_reference_t<const IndexRange>, SizeType>);
+    void swap_erase(SizeType index_);
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType capacity() const noexcept;
+    [[nodiscard]] SizeType use_count() const noexcept;
+    [[nodiscard]] bool     is_shared() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void resize_for_overwrite(SizeType newLength_)
+        requires(std::is_trivially_default_constructible_v<ItemType>
+                 && std::is_trivially_destructible_v<ItemType>);
+    void clear();
+
+    void adopt(ItemType* items_, SizeType length_, SizeType capacity_);
+    template<typename DeleterType>
+    void adopt(ItemType* items_, SizeType length_, SizeType capacity_, DeleterType deleter_)
+        requires(std::is_invocable_v<DeleterType&, ItemType*>
+                 && std::is_nothrow_move_constructible_v<DeleterType>);
+    template<typename VectorAllocatorType>
+    void adopt(std::vector<ItemType, VectorAllocatorType>&& vector_)
+        requires(std::is_trivially_destructible_v<ItemType>);
+    [[nodiscard]] released_buffer release();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const override;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void make_unique_owner();
+    void reallocate(SizeType newCapacity_);
+    void reserve_for_append(SizeType newLength_);
+
+    template<typename RangeType>
+    [[nodiscard]] static SizeType range_length(RangeType& range_);
+    template<typename RangeType>
+    void construct_from(RangeType& range_, ItemType* destination_, SizeType count_);
+    template<typename RangeType>
+    void construct_input_at_end(RangeType& range_);
+    void check_adoptable(const ItemType* items_, SizeType length_, SizeType capacity_) const;
+    void take_over(control_block* control_, ItemType* items_, SizeType length_) noexcept;
+    void drop_reference() noexcept;
+
+    template<typename DeleterType>
+    static void dispose_adopted(control_block*       control_,
+                                ItemType*            items_,
+                                const AllocatorType& alloc_) noexcept;
+
+    [[nodiscard]] ItemType* data() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    control_block* m_control = nullptr;
+
+    /* Elements copied with a single memcpy: trivially copyable, and an allocator that does not
+     * construct them itself */
+    constexpr static const bool bulk_copyable_items =
+      std::is_trivially_copyable_v<ItemType>
+      && !requires(AllocatorType& alloc_, ItemType* item_) { alloc_.construct(item_, *item_); };
+
+    /* Ranges whose length is known up front, so that they are stored with a single allocation */
+    template<typename RangeType>
+    constexpr static const bool sized_source =
+      std::ranges::sized_range<RangeType> || std::ranges::forward_range<RangeType>;
+
+    /* Ranges copied with a single memcpy: contiguous, of the same bulk-copyable elements */
+    template<typename RangeType>
+    constexpr static const bool bulk_copyable_source =
+      bulk_copyable_items && std::ranges::contiguous_range<RangeType>
+      && std::ranges::sized_range<RangeType>
+      && std::same_as<std::remove_cv_t<std::ranges::range_value_t<RangeType>>, ItemType>;
+
+    /* Bytes of elements the buffer grows by at a time when reading a range of unknown length */
+    constexpr static const SizeType input_chunk_size = 4096;
+};
+
+
+}        // namespace pel
+
+#include "./cow_container.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
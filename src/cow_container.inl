@@ -0,0 +1,1311 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./cow_container.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define COW_CONTAINER_TEMPLATE_DECLARATION__    typename ItemType,                                 \
+                                                typename AllocatorType
+
+#define COW_CONTAINER_CLASS_SCOPE__             cow_container<ItemType,                            \
+                                                              AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty container. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator used for the elements; rebound for the shared control block.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__::cow_container(const AllocatorType& alloc_) : BaseType{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a container holding a number of copies of a value.
+ *
+ * \param       count_: Number of elements.
+ * \param       value_: Value copied into every element.
+ * \param       alloc_: Allocator used for the elements.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__::cow_container(SizeType             count_,
+                                           const ItemType&      value_,
+                                           const AllocatorType& alloc_)
+: BaseType{alloc_}
+{
+    try
+    {
+        reserve(count_);
+        for(SizeType i = 0; i < count_; ++i)
+        {
+            emplace_back(value_);
+        }
+    }
+    catch(...)
+    {
+        drop_reference();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a container holding a copy of every item of a list.
+ *
+ * \param       items_: Items to copy.
+ * \param       alloc_: Allocator used for the elements.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__::cow_container(std::initializer_list<ItemType> items_,
+                                           const AllocatorType&            alloc_)
+: cow_container(from_range, items_, alloc_)
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a container holding a copy of every element of a range.
+ *              Sized and forward ranges are stored with a single allocation of their exact length,
+ *              input-only ranges are read in chunks.
+ *
+ * \param       range_: Elements to copy.
+ * \param       alloc_: Allocator used for the elements.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<container_compatible_range<ItemType> RangeType>
+COW_CONTAINER_CLASS_SCOPE__::cow_container(from_range_t,
+                                           RangeType&&          range_,
+                                           const AllocatorType& alloc_)
+: BaseType{alloc_}
+{
+    try
+    {
+        append_range(range_);
+    }
+    catch(...)
+    {
+        drop_reference();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Share the buffer of another container. O(1): only the reference count changes.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__::cow_container(const cow_container& copy_) noexcept
+: BaseType{copy_.m_allocator}, m_control{copy_.m_control}
+{
+    if(m_control != nullptr)
+    {
+        m_control->referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->m_beginIterator = copy_.m_beginIterator;
+    this->m_endIterator   = copy_.m_endIterator;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the buffer of another container, leaving it empty.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__::cow_container(cow_container&& move_) noexcept
+: BaseType{move_.m_allocator}, m_control{std::exchange(move_.m_control, nullptr)}
+{
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop the current buffer and share the buffer of another container.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__&
+COW_CONTAINER_CLASS_SCOPE__::operator=(const cow_container& copy_) noexcept
+{
+    if(this == &copy_)
+    {
+        return *this;
+    }
+
+    if(copy_.m_control != nullptr)
+    {
+        copy_.m_control->referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    drop_reference();
+
+    this->m_allocator     = copy_.m_allocator;
+    m_control             = copy_.m_control;
+    this->m_beginIterator = copy_.m_beginIterator;
+    this->m_endIterator   = copy_.m_endIterator;
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop the current buffer and take over the buffer of another container.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__&
+COW_CONTAINER_CLASS_SCOPE__::operator=(cow_container&& move_) noexcept
+{
+    if(this == &move_)
+    {
+        return *this;
+    }
+
+    drop_reference();
+
+    this->m_allocator     = move_.m_allocator;
+    m_control             = std::exchange(move_.m_control, nullptr);
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop this container's reference; the last owner destroys the buffer.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+COW_CONTAINER_CLASS_SCOPE__::~cow_container()
+{
+    drop_reference();
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get a modifiable reference to the element at the front of the container.
+ *              Makes the buffer private first if it is shared.
+ *
+ * \throw       std::length_error
+ *              If the container is empty.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType&
+COW_CONTAINER_CLASS_SCOPE__::front()
+{
+    make_unique_owner();
+    return BaseType::front();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a modifiable reference to the element at the back of the container.
+ *              Makes the buffer private first if it is shared.
+ *
+ * \throw       std::length_error
+ *              If the container is empty.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType&
+COW_CONTAINER_CLASS_SCOPE__::back()
+{
+    make_unique_owner();
+    return BaseType::back();
+}
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access a modifiable element at a specific index.
+ *              Makes the buffer private first if it is shared; at() goes through here as well.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType&
+COW_CONTAINER_CLASS_SCOPE__::operator[](SizeType index_)
+{
+    make_unique_owner();
+    return BaseType::operator[](index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access a const element at a specific index, without touching the reference count.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const ItemType&
+COW_CONTAINER_CLASS_SCOPE__::operator[](SizeType index_) const
+{
+    return BaseType::operator[](index_);
+}
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Returns an iterator to the beginning of a private copy of the data.
+ *              Use cbegin() (or a const container) to iterate without copying a shared buffer.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename COW_CONTAINER_CLASS_SCOPE__::IteratorType
+COW_CONTAINER_CLASS_SCOPE__::begin()
+{
+    make_unique_owner();
+    return BaseType::begin();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Returns an iterator to the end of a private copy of the data.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename COW_CONTAINER_CLASS_SCOPE__::IteratorType
+COW_CONTAINER_CLASS_SCOPE__::end()
+{
+    make_unique_owner();
+    return BaseType::end();
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in place at the end of the container.
+ *              Makes the buffer private first if it is shared.
+ *
+ * \param       args_: Arguments forwarded to the element's constructor.
+ *
+ * \retval      ItemType&: Reference to the new element.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline ItemType&
+COW_CONTAINER_CLASS_SCOPE__::emplace_back(Args&&... args_)
+{
+    const SizeType currentLength = this->length();
+
+    if(is_shared() || currentLength == capacity())
+    {
+        /* The arguments may refer to elements of the current buffer, so build the element before
+         * the buffer is replaced */
+        ItemType item(std::forward<Args>(args_)...);
+        reallocate(currentLength == capacity() ? std::max<SizeType>(1, capacity() * 2)
+                                               : capacity());
+        AllocatorTraits::construct(this->m_allocator, data() + currentLength, std::move(item));
+    }
+    else
+    {
+        AllocatorTraits::construct(this->m_allocator,
+                                   data() + currentLength,
+                                   std::forward<Args>(args_)...);
+    }
+
+    this->add_size(1);
+    return data()[currentLength];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy an element at the end of the container.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::push_back(const ItemType& item_)
+{
+    emplace_back(item_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element at the end of the container.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::push_back(ItemType&& item_)
+{
+    emplace_back(std::move(item_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the element at the end of the container.
+ *              Makes the buffer private first if it is shared.
+ *
+ * \throw       std::length_error
+ *              If the container is empty.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::pop_back()
+{
+    if(this->is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+
+    make_unique_owner();
+    AllocatorTraits::destroy(this->m_allocator, data() + this->length() - 1);
+    this->change_size(this->length() - 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the elements with a copy of every element of a range.
+ *              The buffer is reused when it is private and large enough, and otherwise replaced
+ *              by one of exactly the range's length when that length is known up front.
+ *
+ * \param       range_: Elements to copy. Cannot refer to the elements of this container.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<container_compatible_range<ItemType> RangeType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::assign_range(RangeType&& range_)
+{
+    if constexpr(sized_source<RangeType>)
+    {
+        const SizeType count = range_length(range_);
+        if(is_shared() || count > capacity())
+        {
+            drop_reference();
+            if(count != 0)
+            {
+                reallocate(count);
+            }
+        }
+        else
+        {
+            BaseType::clear();
+        }
+
+        if(count != 0)
+        {
+            construct_from(range_, data(), count);
+            this->add_size(count);
+        }
+    }
+    else
+    {
+        clear();
+        construct_input_at_end(range_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every element of a range at the end of the container.
+ *              Makes the buffer private first if it is shared. When the length of the range is
+ *              known up front, the buffer grows at most once.
+ *              Nothing is added if copying an element throws.
+ *
+ * \param       range_: Elements to copy. Cannot refer to the elements of this container.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<container_compatible_range<ItemType> RangeType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::append_range(RangeType&& range_)
+{
+    if constexpr(sized_source<RangeType>)
+    {
+        const SizeType count = range_length(range_);
+        if(count == 0)
+        {
+            return;
+        }
+
+        reserve_for_append(this->length() + count);
+        construct_from(range_, data() + this->length(), count);
+        this->add_size(count);
+    }
+    else
+    {
+        make_unique_owner();
+        construct_input_at_end(range_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every element of a range before the element at an index.
+ *              Makes the buffer private first if it is shared. Trivially copyable elements of a
+ *              range of known length are copied straight into a gap opened with memmove, others
+ *              are appended and rotated into place.
+ *
+ * \param       index_: Index of the first new element, at most length().
+ * \param       range_: Elements to copy. Cannot refer to the elements of this container.
+ *
+ * \throw       std::length_error
+ *              If the index is out of range.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<container_compatible_range<ItemType> RangeType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::insert_range(SizeType index_, RangeType&& range_)
+{
+    const SizeType currentLength = this->length();
+    if(index_ > currentLength)
+    {
+        throw std::length_error("Index out of range");
+    }
+
+    if constexpr(sized_source<RangeType> && std::is_trivially_copyable_v<ItemType>)
+    {
+        const SizeType count = range_length(range_);
+        if(count == 0)
+        {
+            return;
+        }
+
+        reserve_for_append(currentLength + count);
+        ItemType* const gap  = data() + index_;
+        const SizeType  tail = (currentLength - index_) * sizeof(ItemType);
+
+        std::memmove(gap + count, gap, tail);
+        try
+        {
+            construct_from(range_, gap, count);
+        }
+        catch(...)
+        {
+            std::memmove(gap, gap + count, tail);
+            throw;
+        }
+        this->add_size(count);
+    }
+    else
+    {
+        append_range(range_);
+        ItemType* const items = data();
+        if(items != nullptr)
+        {
+            std::rotate(items + index_, items + currentLength, items + this->length());
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase every element for which a predicate returns true, keeping the order of the
+ *              others. Makes the buffer private first if it is shared.
+ *
+ * \param       predicate_: Called with a const reference to each element, returns true to erase.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename PredicateType>
+inline typename COW_CONTAINER_CLASS_SCOPE__::SizeType
+COW_CONTAINER_CLASS_SCOPE__::erase_if(PredicateType predicate_)
+{
+    make_unique_owner();
+    return BaseType::erase_if(std::move(predicate_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the elements at a list of indices, keeping the order of the others.
+ *              Makes the buffer private first if it is shared.
+ *
+ * \param       indices_: Indices of the elements to erase, sorted in strictly increasing order.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *
+ * \throw       std::length_error
+ *              If an index is out of range.
+ * \throw       std::invalid_argument
+ *              If the indices are not sorted or not unique.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<std::ranges::forward_range IndexRange>
+inline typename COW_CONTAINER_CLASS_SCOPE__::SizeType
+COW_CONTAINER_CLASS_SCOPE__::erase_indices(const IndexRange& indices_)
+    requires(std::convertible_to<std::ranges::range_reference_t<const IndexRange>, SizeType>)
+{
+    make_unique_owner();
+    return BaseType::erase_indices(indices_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase an element in O(1) by moving the last element into its place.
+ *              Makes the buffer private first if it is shared.
+ *
+ * \param       index_: Index of the element to erase.
+ *
+ * \throw       std::length_error
+ *              If the index is out of range.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::swap_erase(SizeType index_)
+{
+    make_unique_owner();
+    BaseType::swap_erase(index_);
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of elements the buffer can hold.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename COW_CONTAINER_CLASS_SCOPE__::SizeType
+COW_CONTAINER_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_control == nullptr ? 0 : m_control->capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Return the number of containers sharing the buffer.
+ *
+ * \retval      SizeType: 0 if nothing is allocated.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename COW_CONTAINER_CLASS_SCOPE__::SizeType
+COW_CONTAINER_CLASS_SCOPE__::use_count() const noexcept
+{
+    return m_control == nullptr ? 0 : m_control->referenceCount.load(std::memory_order_acquire);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns true if another container shares the buffer.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+COW_CONTAINER_CLASS_SCOPE__::is_shared() const noexcept
+{
+    return use_count() > 1;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make sure the container holds a private buffer of at least a given capacity.
+ *
+ * \param       newCapacity_: Minimum number of elements the buffer must hold.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > capacity())
+    {
+        reallocate(newCapacity_);
+    }
+    else
+    {
+        make_unique_owner();
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Change the number of elements without initializing the new ones, which the caller
+ *              is expected to overwrite through begin().ptr() before reading them.
+ *              Lets bulk producers such as the sorted set operations write straight into the
+ *              buffer: size it to an upper bound, write, then shrink it to what was written.
+ *
+ * \param       newLength_: Number of elements the container holds afterwards.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::resize_for_overwrite(SizeType newLength_)
+    requires(std::is_trivially_default_constructible_v<ItemType>
+             && std::is_trivially_destructible_v<ItemType>)
+{
+    reserve(newLength_);
+    if(m_control != nullptr)
+    {
+        this->change_size(newLength_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove every element.
+ *              A shared buffer is simply let go of instead of being copied first.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::clear()
+{
+    if(is_shared())
+    {
+        drop_reference();
+    }
+    else
+    {
+        BaseType::clear();
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take ownership of a buffer allocated through get_allocator(), without copying it.
+ *              The current buffer is dropped. The container destroys the elements and deallocates
+ *              the buffer through its allocator once the last owner lets go of it.
+ *
+ * \param       items_:    First element of the buffer, allocated for capacity_ elements.
+ * \param       length_:   Number of constructed elements at the start of the buffer.
+ * \param       capacity_: Number of elements the buffer was allocated for.
+ *
+ * \throws      std::invalid_argument
+ *              If the length exceeds the capacity or the buffer is already this container's.
+ *              The caller keeps the buffer.
+ * \throws      std::bad_alloc
+ *              If the control block cannot be allocated. The buffer is freed before rethrowing.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::adopt(ItemType* items_, SizeType length_, SizeType capacity_)
+{
+    check_adoptable(items_, length_, capacity_);
+    if(items_ == nullptr)
+    {
+        drop_reference();
+        return;
+    }
+
+    ControlAllocatorType controlAllocator(this->m_allocator);
+    control_block*       control = nullptr;
+    try
+    {
+        control = ControlTraits::allocate(controlAllocator, 1);
+    }
+    catch(...)
+    {
+        for(SizeType i = 0; i < length_; ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items_ + i);
+        }
+        AllocatorTraits::deallocate(this->m_allocator, items_, capacity_);
+        throw;
+    }
+
+    ControlTraits::construct(controlAllocator, control);
+    control->capacity = capacity_;
+    take_over(control, items_, length_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take ownership of a buffer allocated elsewhere (a decoder, malloc, ...), without
+ *              copying it. The current buffer is dropped.
+ *              The container destroys the elements once the last owner lets go of the buffer,
+ *              then hands the storage to the deleter, which is kept next to the reference count.
+ *
+ * \param       items_:    First element of the buffer.
+ * \param       length_:   Number of constructed elements at the start of the buffer.
+ * \param       capacity_: Number of elements the buffer has room for.
+ * \param       deleter_:  Called once with items_ to free the storage only. Must not throw.
+ *
+ * \throws      std::invalid_argument
+ *              If the length exceeds the capacity or the buffer is already this container's.
+ *              The caller keeps the buffer.
+ * \throws      std::bad_alloc
+ *              If the control block cannot be allocated. The elements are destroyed and the
+ *              deleter is called before rethrowing.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename DeleterType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::adopt(ItemType*   items_,
+                                   SizeType    length_,
+                                   SizeType    capacity_,
+                                   DeleterType deleter_)
+    requires(std::is_invocable_v<DeleterType&, ItemType*>
+             && std::is_nothrow_move_constructible_v<DeleterType>)
+{
+    using BlockType          = adopted_control_block<DeleterType>;
+    using BlockAllocatorType = typename AllocatorTraits::template rebind_alloc<BlockType>;
+    using BlockTraits        = std::allocator_traits<BlockAllocatorType>;
+
+    check_adoptable(items_, length_, capacity_);
+    if(items_ == nullptr)
+    {
+        drop_reference();
+        return;
+    }
+
+    BlockAllocatorType blockAllocator(this->m_allocator);
+    BlockType*         block = nullptr;
+    try
+    {
+        block = BlockTraits::allocate(blockAllocator, 1);
+    }
+    catch(...)
+    {
+        for(SizeType i = 0; i < length_; ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items_ + i);
+        }
+        deleter_(items_);
+        throw;
+    }
+
+    BlockTraits::construct(blockAllocator, block, std::move(deleter_));
+    block->capacity = capacity_;
+    block->dispose  = &dispose_adopted<DeleterType>;
+    take_over(block, items_, length_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the buffer of a std::vector without copying it. The current buffer is
+ *              dropped and the vector is left empty.
+ *              The library offers no way to detach a buffer from a std::vector, so the vector
+ *              itself is moved next to the reference count and frees the buffer when destroyed.
+ *              Since it then destroys its own elements, only trivially destructible elements can
+ *              be adopted this way.
+ *
+ * \param       vector_: Vector whose buffer is taken over, including its spare capacity.
+ *
+ * \throws      std::bad_alloc
+ *              If the control block cannot be allocated. The vector's buffer is freed.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename VectorAllocatorType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::adopt(std::vector<ItemType, VectorAllocatorType>&& vector_)
+    requires(std::is_trivially_destructible_v<ItemType>)
+{
+    ItemType*      items    = vector_.data();
+    const SizeType length   = vector_.size();
+    const SizeType capacity = vector_.capacity();
+    if(capacity == 0)
+    {
+        drop_reference();
+        return;
+    }
+
+    /* Move construction hands the buffer over as is, so items stays valid */
+    adopt(items, length, capacity, [owner = std::move(vector_)](ItemType*) noexcept {});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Give up the buffer without destroying or freeing it.
+ *              The container is left empty, and the caller becomes responsible for destroying the
+ *              elements and deallocating the buffer through get_allocator().
+ *              A buffer shared with another container or adopted with a deleter cannot be handed
+ *              over as is, so it is first copied to a private buffer from the allocator.
+ *
+ * \retval      released_buffer: Items, length and capacity; all null when nothing is allocated.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename COW_CONTAINER_CLASS_SCOPE__::released_buffer
+COW_CONTAINER_CLASS_SCOPE__::release()
+{
+    if(m_control == nullptr)
+    {
+        return released_buffer{};
+    }
+    if(is_shared() || m_control->dispose != nullptr)
+    {
+        reallocate(capacity());
+    }
+
+    const released_buffer buffer{data(), this->length(), capacity()};
+
+    ControlAllocatorType controlAllocator(this->m_allocator);
+    ControlTraits::destroy(controlAllocator, m_control);
+    ControlTraits::deallocate(controlAllocator, m_control, 1);
+
+    m_control             = nullptr;
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+    return buffer;
+}
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the container as a string, such as "[1, 2, 3]".
+ *              Elements that cannot be written to a std::ostream are shown as "?".
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::string
+COW_CONTAINER_CLASS_SCOPE__::to_string() const
+{
+    std::ostringstream stream;
+    stream << '[';
+    for(SizeType i = 0; i < this->length(); ++i)
+    {
+        if(i != 0)
+        {
+            stream << ", ";
+        }
+
+        if constexpr(requires(std::ostream& os_, const ItemType& item_) { os_ << item_; })
+        {
+            stream << (*this)[i];
+        }
+        else
+        {
+            stream << '?';
+        }
+    }
+    stream << ']';
+    return stream.str();
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the buffer if it is shared, so that it can be modified.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::make_unique_owner()
+{
+    if(is_shared())
+    {
+        reallocate(capacity());
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements to a new private buffer.
+ *              Elements are moved out of a buffer owned by this container alone, and copied out of
+ *              a shared one. The old buffer is released either way.
+ *              Strong guarantee: if an allocation or an element copy throws, the container is left
+ *              unchanged.
+ *
+ * \param       newCapacity_: Capacity of the new buffer. Must hold at least length() elements.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::reallocate(SizeType newCapacity_)
+{
+    ControlAllocatorType controlAllocator(this->m_allocator);
+
+    const SizeType currentLength = this->length();
+    const bool     isOwner       = is_shared() == false;
+    ItemType*      oldData       = data();
+    ItemType*      newData       = nullptr;
+
+    /* Both allocations happen before any element is touched, so that a failure leaves the
+     * container as it was */
+    control_block* newControl  = ControlTraits::allocate(controlAllocator, 1);
+    SizeType       constructed = 0;
+    try
+    {
+        newData = AllocatorTraits::allocate(this->m_allocator, newCapacity_);
+        if constexpr(bulk_copyable_items)
+        {
+            if(currentLength != 0)
+            {
+                std::memcpy(newData, oldData, currentLength * sizeof(ItemType));
+            }
+        }
+        else
+        {
+            for(; constructed < currentLength; ++constructed)
+            {
+                if(isOwner)
+                {
+                    AllocatorTraits::construct(this->m_allocator,
+                                               newData + constructed,
+                                               std::move_if_noexcept(oldData[constructed]));
+                }
+                else
+                {
+                    AllocatorTraits::construct(this->m_allocator,
+                                               newData + constructed,
+                                               std::as_const(oldData[constructed]));
+                }
+            }
+        }
+    }
+    catch(...)
+    {
+        if(newData != nullptr)
+        {
+            for(SizeType i = 0; i < constructed; ++i)
+            {
+                AllocatorTraits::destroy(this->m_allocator, newData + i);
+            }
+            AllocatorTraits::deallocate(this->m_allocator, newData, newCapacity_);
+        }
+        ControlTraits::deallocate(controlAllocator, newControl, 1);
+        throw;
+    }
+
+    ControlTraits::construct(controlAllocator, newControl);
+    newControl->capacity = newCapacity_;
+
+    drop_reference();
+
+    m_control             = newControl;
+    this->m_beginIterator = IteratorType(newData);
+    this->m_endIterator   = IteratorType(newData + currentLength);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make sure the buffer is private and can hold a number of elements, at least
+ *              doubling its capacity when it has to grow. An empty buffer grows to the exact
+ *              length.
+ *
+ * \param       newLength_: Number of elements the buffer must hold.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::reserve_for_append(SizeType newLength_)
+{
+    if(newLength_ > capacity())
+    {
+        reallocate(std::max(newLength_, capacity() * 2));
+    }
+    else
+    {
+        make_unique_owner();
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the number of elements of a sized or forward range, walking the latter once.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename RangeType>
+[[nodiscard]] inline typename COW_CONTAINER_CLASS_SCOPE__::SizeType
+COW_CONTAINER_CLASS_SCOPE__::range_length(RangeType& range_)
+{
+    if constexpr(std::ranges::sized_range<RangeType>)
+    {
+        return static_cast<SizeType>(std::ranges::size(range_));
+    }
+    else
+    {
+        return static_cast<SizeType>(std::ranges::distance(range_));
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct the first elements of a range in uninitialized storage, with a single
+ *              memcpy when the elements can be copied as bytes. The length is left untouched.
+ *              The elements constructed so far are destroyed if copying one of them throws.
+ *
+ * \param       range_:       Range holding at least count_ elements.
+ * \param       destination_: Storage for count_ elements.
+ * \param       count_:       Number of elements to construct, at least 1.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename RangeType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::construct_from(RangeType& range_,
+                                            ItemType*  destination_,
+                                            SizeType   count_)
+{
+    if constexpr(bulk_copyable_source<RangeType>)
+    {
+        std::memcpy(destination_, std::ranges::data(range_), count_ * sizeof(ItemType));
+    }
+    else
+    {
+        SizeType constructed = 0;
+        try
+        {
+            for(auto iterator = std::ranges::begin(range_); constructed < count_;
+                ++iterator, ++constructed)
+            {
+                AllocatorTraits::construct(
+                  this->m_allocator, destination_ + constructed, *iterator);
+            }
+        }
+        catch(...)
+        {
+            for(SizeType i = 0; i < constructed; ++i)
+            {
+                AllocatorTraits::destroy(this->m_allocator, destination_ + i);
+            }
+            throw;
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every element of a range of unknown length at the end of the private buffer.
+ *              The buffer grows by chunks of at least input_chunk_size bytes, and each chunk is
+ *              filled without checking the capacity element by element.
+ *              Nothing is added if reading or copying an element throws.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename RangeType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::construct_input_at_end(RangeType& range_)
+{
+    constexpr SizeType chunkLength = std::max<SizeType>(1, input_chunk_size / sizeof(ItemType));
+
+    const SizeType firstNew = this->length();
+    auto           iterator = std::ranges::begin(range_);
+    const auto     last     = std::ranges::end(range_);
+    while(iterator != last)
+    {
+        if(this->length() == capacity())
+        {
+            reallocate(std::max(capacity() + chunkLength, capacity() * 2));
+        }
+
+        ItemType* const destination = data() + this->length();
+        const SizeType  spare       = capacity() - this->length();
+        SizeType        constructed = 0;
+        try
+        {
+            for(; constructed < spare && iterator != last; ++iterator, ++constructed)
+            {
+                AllocatorTraits::construct(this->m_allocator, destination + constructed, *iterator);
+            }
+        }
+        catch(...)
+        {
+            this->add_size(constructed);
+            this->truncate(firstNew);
+            throw;
+        }
+        this->add_size(constructed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop this container's reference to its buffer and leave it empty.
+ *              The last owner destroys the elements and frees the buffer.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::drop_reference() noexcept
+{
+    if(m_control != nullptr
+       && m_control->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        ItemType* items = data();
+
+        for(SizeType i = 0; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items + i);
+        }
+
+        if(m_control->dispose != nullptr)
+        {
+            m_control->dispose(m_control, items, this->m_allocator);
+        }
+        else
+        {
+            ControlAllocatorType controlAllocator(this->m_allocator);
+            AllocatorTraits::deallocate(this->m_allocator, items, m_control->capacity);
+
+            ControlTraits::destroy(controlAllocator, m_control);
+            ControlTraits::deallocate(controlAllocator, m_control, 1);
+        }
+    }
+
+    m_control             = nullptr;
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make sure a buffer can be adopted: its length must fit in its capacity, and it
+ *              cannot be the buffer this container already holds.
+ *
+ * \throws      std::invalid_argument
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::check_adoptable(const ItemType* items_,
+                                             SizeType        length_,
+                                             SizeType        capacity_) const
+{
+    if(length_ > capacity_)
+    {
+        throw std::invalid_argument("The adopted length cannot exceed the adopted capacity");
+    }
+    if(items_ == nullptr && capacity_ != 0)
+    {
+        throw std::invalid_argument("Cannot adopt a null buffer with a capacity");
+    }
+    if(items_ != nullptr && items_ == data())
+    {
+        throw std::invalid_argument("The container cannot adopt its own buffer");
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop the current buffer and point the container at an adopted one.
+ *
+ * \param       control_: Freshly constructed control block of the adopted buffer.
+ * \param       items_:   First element of the adopted buffer.
+ * \param       length_:  Number of constructed elements in the adopted buffer.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::take_over(control_block* control_,
+                                       ItemType*      items_,
+                                       SizeType       length_) noexcept
+{
+    drop_reference();
+
+    m_control             = control_;
+    this->m_beginIterator = IteratorType(items_);
+    this->m_endIterator   = IteratorType(items_ + length_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free an adopted buffer through its deleter, then free its control block.
+ *              The elements have already been destroyed by the last owner.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename DeleterType>
+inline void
+COW_CONTAINER_CLASS_SCOPE__::dispose_adopted(control_block*       control_,
+                                             ItemType*            items_,
+                                             const AllocatorType& alloc_) noexcept
+{
+    using BlockType          = adopted_control_block<DeleterType>;
+    using BlockAllocatorType = typename AllocatorTraits::template rebind_alloc<BlockType>;
+    using BlockTraits        = std::allocator_traits<BlockAllocatorType>;
+
+    BlockAllocatorType blockAllocator(alloc_);
+    BlockType*         block = static_cast<BlockType*>(control_);
+
+    block->deleter(items_);
+    BlockTraits::destroy(blockAllocator, block);
+    BlockTraits::deallocate(blockAllocator, block, 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain a pointer to the first element of the buffer.
+ *************************************************************************************************/
+template<COW_CONTAINER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType*
+COW_CONTAINER_CLASS_SCOPE__::data() const noexcept
+{
+    return BaseType::begin().ptr();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef COW_CONTAINER_TEMPLATE_DECLARATION__
+#undef COW_CONTAINER_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,214 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+#include "./slot_table.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Priority queue stored as a d-ary heap in one contiguous buffer.
+ *
+ *              The elements are the container_base range, in heap order: the children of position
+ *              i are at positions Arity * i + 1 to Arity * i + Arity. With an arity of 4 or 8, the
+ *              children of a node share one or two cache lines and the heap is half or a third as
+ *              deep as a binary one, which makes pop cheaper than with std::priority_queue.
+ *              As with std::priority_queue, top() is the element that no other element is greater
+ *              than according to CompareType: use std::greater for a min-heap.
+ *
+ *              With TrackPositions, each element gets a slot_handle that follows it as it moves in
+ *              the heap, so that it can be updated or erased in O(log n) with decrease_key(),
+ *              update() and erase().
+ *
+ * \warning     Elements must not be modified through the positional accessors or iterators.
+ */
+template<typename ItemType,
+         std::size_t Arity      = 4,
+         typename CompareType   = std::less<ItemType>,
+         bool TrackPositions    = false,
+         typename AllocatorType = std::allocator<ItemType>>
+class dary_heap : public container_base<ItemType, iterator_base<ItemType>, AllocatorType>
+{
+    static_assert(Arity >= 2, "A heap node needs at least two children");
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType       = ItemType;
+    using HandleType      = slot_handle;
+    using IteratorType    = iterator_base<ValueType>;
+    using BaseType        = container_base<ValueType, IteratorType, AllocatorType>;
+    using AllocatorTraits = typename BaseType::AllocatorTraits;
+    using SizeType        = typename BaseType::SizeType;
+    using DifferenceType  = typename BaseType::DifferenceType;
+
+    /* What push() returns: a handle to the element when tracking positions, nothing otherwise */
+    using PushResultType = std::conditional_t<TrackPositions, HandleType, void>;
+
+    constexpr static const std::size_t arity           = Arity;
+    constexpr static const bool        track_positions = TrackPositions;
+
+private:
+    constexpr static const std::uint32_t no_slot = slot_table<AllocatorType>::no_slot;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit dary_heap(const CompareType&   compare_ = CompareType{},
+                       const AllocatorType& alloc_   = AllocatorType{});
+    dary_heap(std::initializer_list<ValueType> values_,
+              const CompareType&               compare_ = CompareType{},
+              const AllocatorType&             alloc_   = AllocatorType{});
+
+    dary_heap(const dary_heap& copy_);
+    dary_heap(dary_heap&& move_) noexcept;
+    dary_heap& operator=(const dary_heap& copy_);
+    dary_heap& operator=(dary_heap&& move_) noexcept;
+
+    ~dary_heap() override;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    using BaseType::at;
+
+    [[nodiscard]] const ValueType& top() const;
+    [[nodiscard]] HandleType       top_handle() const
+        requires(TrackPositions);
+
+    [[nodiscard]] const ValueType& at(HandleType handle_) const
+        requires(TrackPositions);
+    [[nodiscard]] const ValueType* get(HandleType handle_) const noexcept
+        requires(TrackPositions);
+    [[nodiscard]] bool contains(HandleType handle_) const noexcept
+        requires(TrackPositions);
+    [[nodiscard]] HandleType handle_at(SizeType index_) const
+        requires(TrackPositions);
+
+    [[nodiscard]] const CompareType& value_comp() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    PushResultType push(const ValueType& value_);
+    PushResultType push(ValueType&& value_);
+    template<typename... Args>
+    PushResultType emplace(Args&&... args_);
+
+    template<std::ranges::input_range Range>
+    void push_range(Range&& range_)
+        requires(TrackPositions == false);
+    template<std::ranges::input_range Range, std::output_iterator<slot_handle> OutputIterator>
+    OutputIterator push_range(Range&& range_, OutputIterator handles_)
+        requires(TrackPositions);
+
+    void pop();
+
+    template<typename UpdateType>
+    void decrease_key(HandleType handle_, UpdateType&& value_)
+        requires(TrackPositions);
+    template<typename UpdateType>
+    void update(HandleType handle_, UpdateType&& value_)
+        requires(TrackPositions);
+    bool erase(HandleType handle_)
+        requires(TrackPositions);
+
+    void clear();
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const override;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    template<typename... Args>
+    HandleType append(Args&&... args_);
+    void       restore_range(SizeType first_);
+    void       heapify();
+    void       sift_up(SizeType index_);
+    void       sift_down(SizeType index_);
+    void       sift_down_to_leaf(SizeType index_);
+    void       restore(SizeType index_);
+    void       erase_at(SizeType index_);
+
+    [[nodiscard]] SizeType best_child(SizeType firstChild_, SizeType length_) const noexcept;
+
+    void                        move_element(SizeType to_, SizeType from_);
+    void                        place(SizeType index_, ValueType&& value_, std::uint32_t slot_);
+    [[nodiscard]] std::uint32_t owner(SizeType index_) const noexcept;
+
+    void reallocate(SizeType newCapacity_);
+    void release() noexcept;
+
+    [[nodiscard]] ValueType* data() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    SizeType m_capacity = 0;
+
+    [[no_unique_address]] CompareType m_compare{};
+
+    /* Only used with TrackPositions, as in slot_map */
+    slot_table<AllocatorType> m_slots;
+};
+
+
+}        // namespace pel
+
+#include "./dary_heap.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
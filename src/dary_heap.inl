@@ -0,0 +1,1001 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./dary_heap.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define DARY_HEAP_TEMPLATE_DECLARATION__ typename ItemType,                                        \
+                                         std::size_t Arity,                                        \
+                                         typename CompareType,                                     \
+                                         bool TrackPositions,                                      \
+                                         typename AllocatorType
+#define DARY_HEAP_CLASS_SCOPE__          dary_heap<ItemType,                                       \
+                                                   Arity,                                          \
+                                                   CompareType,                                    \
+                                                   TrackPositions,                                 \
+                                                   AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty heap. Nothing is allocated.
+ *
+ * \param       compare_: Ordering of the elements. top() is an element no other is greater than.
+ * \param       alloc_:   Allocator used for the elements and the slots.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline DARY_HEAP_CLASS_SCOPE__::dary_heap(const CompareType& compare_, const AllocatorType& alloc_)
+: BaseType{alloc_},
+  m_compare{compare_},
+  m_slots{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a heap from a list of values, heapified in O(n).
+ *              When tracking positions, their handles can be read back with handle_at().
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline DARY_HEAP_CLASS_SCOPE__::dary_heap(std::initializer_list<ValueType> values_,
+                                          const CompareType&               compare_,
+                                          const AllocatorType&             alloc_)
+: dary_heap(compare_, alloc_)
+{
+    /* The delegated constructor completed: the destructor cleans up if this throws */
+    reserve(values_.size());
+    for(const ValueType& value : values_)
+    {
+        static_cast<void>(append(value));
+    }
+    heapify();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every element of another heap, in the same order. The handles of the other
+ *              heap are valid in the copy, and refer to the copies of their elements.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline DARY_HEAP_CLASS_SCOPE__::dary_heap(const dary_heap& copy_)
+: BaseType{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)},
+  m_compare{copy_.m_compare},
+  m_slots{copy_.m_slots}
+{
+    try
+    {
+        reserve(copy_.length());
+        for(const ValueType& value : copy_)
+        {
+            AllocatorTraits::construct(this->m_allocator, data() + this->length(), value);
+            this->add_size(1);
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the elements and slots of another heap, leaving it empty.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline DARY_HEAP_CLASS_SCOPE__::dary_heap(dary_heap&& move_) noexcept
+: BaseType{move_.m_allocator},
+  m_capacity{std::exchange(move_.m_capacity, 0)},
+  m_compare{move_.m_compare},
+  m_slots{std::move(move_.m_slots)}
+{
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline DARY_HEAP_CLASS_SCOPE__& DARY_HEAP_CLASS_SCOPE__::operator=(const dary_heap& copy_)
+{
+    if(this != &copy_)
+    {
+        dary_heap copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline DARY_HEAP_CLASS_SCOPE__& DARY_HEAP_CLASS_SCOPE__::operator=(dary_heap&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+
+        this->m_allocator     = move_.m_allocator;
+        m_capacity            = std::exchange(move_.m_capacity, 0);
+        m_compare             = move_.m_compare;
+        m_slots               = std::move(move_.m_slots);
+        this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+        this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+    }
+    return *this;
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline DARY_HEAP_CLASS_SCOPE__::~dary_heap()
+{
+    release();
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element that comes first: no other element is greater than it.
+ *
+ * \throw       std::length_error
+ *              If the heap is empty.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename DARY_HEAP_CLASS_SCOPE__::ValueType&
+DARY_HEAP_CLASS_SCOPE__::top() const
+{
+    return BaseType::front();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the handle of the element that comes first.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If the heap is empty.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename DARY_HEAP_CLASS_SCOPE__::HandleType
+DARY_HEAP_CLASS_SCOPE__::top_handle() const
+    requires(TrackPositions)
+{
+    return handle_at(0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element a handle refers to.
+ *
+ * \param       handle_: Handle returned when pushing the element.
+ *
+ * \throws      std::out_of_range("Invalid handle")
+ *              If the element was popped or erased, or the handle is not from this heap.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename DARY_HEAP_CLASS_SCOPE__::ValueType&
+DARY_HEAP_CLASS_SCOPE__::at(HandleType handle_) const
+    requires(TrackPositions)
+{
+    const ValueType* value = get(handle_);
+    if(value == nullptr)
+    {
+        throw std::out_of_range("Invalid handle");
+    }
+    return *value;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the element a handle refers to.
+ *
+ * \retval      const ValueType*: The element, or nullptr if it left the heap.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename DARY_HEAP_CLASS_SCOPE__::ValueType*
+DARY_HEAP_CLASS_SCOPE__::get(HandleType handle_) const noexcept
+    requires(TrackPositions)
+{
+    return contains(handle_) ? data() + m_slots.position(handle_) : nullptr;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check if a handle refers to an element of the heap.
+ *              Generations are odd while the slot holds an element, as in slot_map.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool DARY_HEAP_CLASS_SCOPE__::contains(HandleType handle_) const noexcept
+    requires(TrackPositions)
+{
+    return m_slots.contains(handle_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the handle of the element at a position.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If there is no element at that position.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename DARY_HEAP_CLASS_SCOPE__::HandleType
+DARY_HEAP_CLASS_SCOPE__::handle_at(SizeType index_) const
+    requires(TrackPositions)
+{
+    if(index_ >= this->length())
+    {
+        throw std::length_error("Index out of range");
+    }
+
+    return m_slots.handle_at(index_);
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const CompareType& DARY_HEAP_CLASS_SCOPE__::value_comp() const noexcept
+{
+    return m_compare;
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copy a value into the heap.
+ *
+ * \retval      PushResultType: Handle to the new element when tracking positions.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline typename DARY_HEAP_CLASS_SCOPE__::PushResultType
+DARY_HEAP_CLASS_SCOPE__::push(const ValueType& value_)
+{
+    return emplace(value_);
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline typename DARY_HEAP_CLASS_SCOPE__::PushResultType
+DARY_HEAP_CLASS_SCOPE__::push(ValueType&& value_)
+{
+    return emplace(std::move(value_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in the heap, in O(log n).
+ *
+ * \param       args_: Arguments forwarded to the element's constructor. They may refer to
+ *                     elements of the heap.
+ *
+ * \retval      PushResultType: Handle to the new element when tracking positions.
+ *
+ * \throws      std::length_error("Too many elements")
+ *              If every one of the 2^32 - 1 slots is in use.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline typename DARY_HEAP_CLASS_SCOPE__::PushResultType
+DARY_HEAP_CLASS_SCOPE__::emplace(Args&&... args_)
+{
+    const HandleType handle = append(std::forward<Args>(args_)...);
+    sift_up(this->length() - 1);
+
+    if constexpr(TrackPositions)
+    {
+        return handle;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Push every value of a range.
+ *              A batch at least as large as the heap is appended and heapified in O(n); a smaller
+ *              one is sifted up element by element.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+template<std::ranges::input_range Range>
+inline void DARY_HEAP_CLASS_SCOPE__::push_range(Range&& range_)
+    requires(TrackPositions == false)
+{
+    const SizeType firstNew = this->length();
+    if constexpr(std::ranges::sized_range<Range>)
+    {
+        reserve(firstNew + static_cast<SizeType>(std::ranges::size(range_)));
+    }
+
+    try
+    {
+        for(auto&& value : range_)
+        {
+            static_cast<void>(append(std::forward<decltype(value)>(value)));
+        }
+    }
+    catch(...)
+    {
+        restore_range(firstNew);
+        throw;
+    }
+    restore_range(firstNew);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Push every value of a range, as push_range() without tracking.
+ *
+ * \param       handles_: Receives the handle of each new element, in the order of the range.
+ *
+ * \retval      OutputIterator: Past the last handle written.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+template<std::ranges::input_range Range, std::output_iterator<slot_handle> OutputIterator>
+inline OutputIterator DARY_HEAP_CLASS_SCOPE__::push_range(Range&& range_, OutputIterator handles_)
+    requires(TrackPositions)
+{
+    const SizeType firstNew = this->length();
+    if constexpr(std::ranges::sized_range<Range>)
+    {
+        reserve(firstNew + static_cast<SizeType>(std::ranges::size(range_)));
+    }
+
+    try
+    {
+        for(auto&& value : range_)
+        {
+            *handles_++ = append(std::forward<decltype(value)>(value));
+        }
+    }
+    catch(...)
+    {
+        restore_range(firstNew);
+        throw;
+    }
+    restore_range(firstNew);
+    return handles_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove the element that comes first, in O(Arity * log n).
+ *
+ * \throw       std::length_error
+ *              If the heap is empty.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::pop()
+{
+    if constexpr(BaseType::container_safeness == true)
+    {
+        if(this->is_empty())
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    erase_at(0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Give an element a value that does not come after its current one, such as a
+ *              shorter distance in a min-heap ordered by std::greater, and move it towards the
+ *              top in O(log n). Use update() when the value may go either way.
+ *
+ * \throws      std::out_of_range("Invalid handle")
+ *              If the element left the heap, or the handle is not from this heap.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+template<typename UpdateType>
+inline void DARY_HEAP_CLASS_SCOPE__::decrease_key(HandleType handle_, UpdateType&& value_)
+    requires(TrackPositions)
+{
+    if(contains(handle_) == false)
+    {
+        throw std::out_of_range("Invalid handle");
+    }
+
+    const SizeType index = m_slots.position(handle_);
+    data()[index]        = std::forward<UpdateType>(value_);
+    sift_up(index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Give an element any new value and move it to its place in O(Arity * log n).
+ *
+ * \throws      std::out_of_range("Invalid handle")
+ *              If the element left the heap, or the handle is not from this heap.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+template<typename UpdateType>
+inline void DARY_HEAP_CLASS_SCOPE__::update(HandleType handle_, UpdateType&& value_)
+    requires(TrackPositions)
+{
+    if(contains(handle_) == false)
+    {
+        throw std::out_of_range("Invalid handle");
+    }
+
+    const SizeType index = m_slots.position(handle_);
+    data()[index]        = std::forward<UpdateType>(value_);
+    restore(index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove the element a handle refers to, in O(Arity * log n).
+ *
+ * \retval      bool: True if the element was erased, false if the handle was not valid.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline bool DARY_HEAP_CLASS_SCOPE__::erase(HandleType handle_)
+    requires(TrackPositions)
+{
+    if(contains(handle_) == false)
+    {
+        return false;
+    }
+
+    erase_at(m_slots.position(handle_));
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase every element, invalidating all the handles. The buffer stays allocated.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::clear()
+{
+    m_slots.clear();
+
+    BaseType::clear();
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of elements the buffer can hold.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename DARY_HEAP_CLASS_SCOPE__::SizeType
+DARY_HEAP_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > m_capacity)
+    {
+        reallocate(newCapacity_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Shrink the buffer to the number of elements.
+ *              The slots are kept, as handles to removed elements must still be rejected.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(this->is_empty())
+    {
+        release();
+    }
+    else if(this->length() < m_capacity)
+    {
+        reallocate(this->length());
+    }
+    m_slots.shrink_to_fit();
+}
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the elements as a string, such as "[3, 1, 2]", in heap order.
+ *              Elements that cannot be written to a std::ostream are shown as "?".
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::string DARY_HEAP_CLASS_SCOPE__::to_string() const
+{
+    std::ostringstream stream;
+    stream << '[';
+    for(SizeType i = 0; i < this->length(); ++i)
+    {
+        if(i != 0)
+        {
+            stream << ", ";
+        }
+
+        if constexpr(requires(std::ostream& os_) { os_ << data()[i]; })
+        {
+            stream << data()[i];
+        }
+        else
+        {
+            stream << '?';
+        }
+    }
+    stream << ']';
+    return stream.str();
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element at the end of the buffer, without moving it to its place in
+ *              the heap. The heap is left unchanged if this throws.
+ *
+ * \retval      HandleType: Handle to the new element when tracking positions.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline typename DARY_HEAP_CLASS_SCOPE__::HandleType
+DARY_HEAP_CLASS_SCOPE__::append(Args&&... args_)
+{
+    std::uint32_t slotIndex = no_slot;
+    if constexpr(TrackPositions)
+    {
+        slotIndex = m_slots.acquire();
+    }
+
+    const SizeType currentLength = this->length();
+    if(currentLength == m_capacity)
+    {
+        /* Build the element before the buffer moves, as the arguments may refer to it */
+        ValueType value(std::forward<Args>(args_)...);
+        reallocate(std::max<SizeType>(1, m_capacity * 2));
+        AllocatorTraits::construct(this->m_allocator, data() + currentLength, std::move(value));
+    }
+    else
+    {
+        AllocatorTraits::construct(
+          this->m_allocator, data() + currentLength, std::forward<Args>(args_)...);
+    }
+
+    HandleType handle{};
+    if constexpr(TrackPositions)
+    {
+        /* Never reallocates: the owners are reserved along with the elements */
+        handle = m_slots.occupy(slotIndex);
+    }
+    this->add_size(1);
+    return handle;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements appended from a position on to their place in the heap.
+ *              Heapifying everything is O(n) while sifting each one up is O(k log n), so the
+ *              former is used once the new elements are as many as the old ones.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::restore_range(SizeType first_)
+{
+    const SizeType currentLength = this->length();
+    if(currentLength - first_ >= first_)
+    {
+        heapify();
+        return;
+    }
+
+    for(SizeType i = first_; i < currentLength; ++i)
+    {
+        sift_up(i);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Turn the whole buffer into a heap by sifting down every internal node, from the
+ *              last one to the root (Floyd's method).
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::heapify()
+{
+    const SizeType currentLength = this->length();
+    if(currentLength < 2)
+    {
+        return;
+    }
+
+    for(SizeType i = (currentLength - 2) / Arity + 1; i > 0; --i)
+    {
+        sift_down(i - 1);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element up to its place. Parents are moved down into the hole rather than
+ *              swapped, so each level costs one move.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::sift_up(SizeType index_)
+{
+    ValueType*          items     = data();
+    ValueType           value     = std::move(items[index_]);
+    const std::uint32_t slotIndex = owner(index_);
+
+    while(index_ > 0)
+    {
+        const SizeType parent = (index_ - 1) / Arity;
+        if(m_compare(items[parent], value) == false)
+        {
+            break;
+        }
+
+        move_element(index_, parent);
+        index_ = parent;
+    }
+    place(index_, std::move(value), slotIndex);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element down to its place. The children of a node are contiguous, so
+ *              finding the greatest one reads Arity adjacent elements.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::sift_down(SizeType index_)
+{
+    ValueType*          items         = data();
+    const SizeType      currentLength = this->length();
+    ValueType           value         = std::move(items[index_]);
+    const std::uint32_t slotIndex     = owner(index_);
+
+    while(true)
+    {
+        const SizeType firstChild = index_ * Arity + 1;
+        if(firstChild >= currentLength)
+        {
+            break;
+        }
+
+        const SizeType best = best_child(firstChild, currentLength);
+        if(m_compare(value, items[best]) == false)
+        {
+            break;
+        }
+
+        move_element(index_, best);
+        index_ = best;
+    }
+    place(index_, std::move(value), slotIndex);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element taken from the bottom of the heap down to its place, as done by
+ *              std::pop_heap: the hole goes all the way down to a leaf without comparing against
+ *              the element, which then sifts up the few levels it usually needs. This saves one
+ *              comparison per level over sift_down().
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::sift_down_to_leaf(SizeType index_)
+{
+    ValueType*          items         = data();
+    const SizeType      currentLength = this->length();
+    const SizeType      top           = index_;
+    ValueType           value         = std::move(items[index_]);
+    const std::uint32_t slotIndex     = owner(index_);
+
+    while(true)
+    {
+        const SizeType firstChild = index_ * Arity + 1;
+        if(firstChild >= currentLength)
+        {
+            break;
+        }
+
+        const SizeType best = best_child(firstChild, currentLength);
+        move_element(index_, best);
+        index_ = best;
+    }
+
+    while(index_ > top)
+    {
+        const SizeType parent = (index_ - 1) / Arity;
+        if(m_compare(items[parent], value) == false)
+        {
+            break;
+        }
+
+        move_element(index_, parent);
+        index_ = parent;
+    }
+    place(index_, std::move(value), slotIndex);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the greatest of the children starting at a position. The loop over a full
+ *              set of children has a constant trip count, which lets it unroll.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename DARY_HEAP_CLASS_SCOPE__::SizeType
+DARY_HEAP_CLASS_SCOPE__::best_child(SizeType firstChild_, SizeType length_) const noexcept
+{
+    const ValueType* items     = data();
+    const SizeType   lastChild = firstChild_ + Arity <= length_ ? firstChild_ + Arity : length_;
+    SizeType         best      = firstChild_;
+    if(lastChild == firstChild_ + Arity)
+    {
+        for(SizeType offset = 1; offset < Arity; ++offset)
+        {
+            if(m_compare(items[best], items[firstChild_ + offset]))
+            {
+                best = firstChild_ + offset;
+            }
+        }
+    }
+    else
+    {
+        for(SizeType child = firstChild_ + 1; child < lastChild; ++child)
+        {
+            if(m_compare(items[best], items[child]))
+            {
+                best = child;
+            }
+        }
+    }
+    return best;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element that may be out of place in either direction.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::restore(SizeType index_)
+{
+    if(index_ > 0 && m_compare(data()[(index_ - 1) / Arity], data()[index_]))
+    {
+        sift_up(index_);
+    }
+    else
+    {
+        sift_down(index_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Remove the element at a position by moving the last element over it, then moving
+ *              that one to its place. Frees the slot of the removed element.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::erase_at(SizeType index_)
+{
+    const SizeType      last      = this->length() - 1;
+    const std::uint32_t slotIndex = owner(index_);
+
+    if(index_ != last)
+    {
+        move_element(index_, last);
+    }
+    AllocatorTraits::destroy(this->m_allocator, data() + last);
+    this->change_size(last);
+
+    if constexpr(TrackPositions)
+    {
+        m_slots.release(slotIndex);
+    }
+
+    /* The element moved in comes from the bottom, where it most likely belongs again */
+    if(index_ != last)
+    {
+        if(index_ > 0 && m_compare(data()[(index_ - 1) / Arity], data()[index_]))
+        {
+            sift_up(index_);
+        }
+        else
+        {
+            sift_down_to_leaf(index_);
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element to another position, keeping its slot up to date.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::move_element(SizeType to_, SizeType from_)
+{
+    data()[to_] = std::move(data()[from_]);
+    if constexpr(TrackPositions)
+    {
+        m_slots.move(to_, from_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Put an element taken out by a sift back at its final position.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::place(SizeType index_, ValueType&& value_, std::uint32_t slot_)
+{
+    data()[index_] = std::move(value_);
+    if constexpr(TrackPositions)
+    {
+        m_slots.place(index_, slot_);
+    }
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::uint32_t DARY_HEAP_CLASS_SCOPE__::owner(SizeType index_) const noexcept
+{
+    if constexpr(TrackPositions)
+    {
+        return m_slots.owner(index_);
+    }
+    else
+    {
+        static_cast<void>(index_);
+        return no_slot;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements to a new buffer.
+ *
+ * \param       newCapacity_: Capacity of the new buffer. Must hold at least length() elements.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::reallocate(SizeType newCapacity_)
+{
+    if constexpr(TrackPositions)
+    {
+        m_slots.reserve(newCapacity_);
+    }
+
+    const SizeType currentLength = this->length();
+    ValueType*     oldItems      = data();
+    ValueType*     newItems      = AllocatorTraits::allocate(this->m_allocator, newCapacity_);
+
+    for(SizeType i = 0; i < currentLength; ++i)
+    {
+        AllocatorTraits::construct(this->m_allocator, newItems + i, std::move(oldItems[i]));
+        AllocatorTraits::destroy(this->m_allocator, oldItems + i);
+    }
+    if(oldItems != nullptr)
+    {
+        AllocatorTraits::deallocate(this->m_allocator, oldItems, m_capacity);
+    }
+
+    m_capacity            = newCapacity_;
+    this->m_beginIterator = IteratorType(newItems);
+    this->m_endIterator   = IteratorType(newItems + currentLength);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element and free the buffer. The slots are left as they are.
+ *************************************************************************************************/
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+inline void DARY_HEAP_CLASS_SCOPE__::release() noexcept
+{
+    ValueType* items = data();
+    if(items != nullptr)
+    {
+        for(SizeType i = 0; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items + i);
+        }
+        AllocatorTraits::deallocate(this->m_allocator, items, m_capacity);
+    }
+
+    m_capacity            = 0;
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+}
+
+
+template<DARY_HEAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename DARY_HEAP_CLASS_SCOPE__::ValueType*
+DARY_HEAP_CLASS_SCOPE__::data() const noexcept
+{
+    return BaseType::begin().ptr();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef DARY_HEAP_TEMPLATE_DECLARATION__
+#undef DARY_HEAP_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,364 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Chunk size of a deque by default: about one page, and at least 16 elements.
+ */
+template<typename ItemType>
+constexpr std::size_t default_deque_chunk_bits =
+  std::bit_width(std::max<std::size_t>(16, 4096 / sizeof(ItemType))) - 1;
+
+
+/**
+ * \brief       Random-access iterator over a deque.
+ *
+ *              Holds a pointer to the element, to the start of its chunk and to the chunk's entry
+ *              in the chunk map, so that stepping within a chunk is a pointer increment, and +=
+ *              and differences are O(1) arithmetic on chunk and element offsets.
+ */
+template<typename ContainerType, bool IsConst>
+class deque_iterator
+{
+    template<typename, bool>
+    friend class deque_iterator;
+    friend ContainerType;
+
+    using ChunkPointer = typename ContainerType::ValueType* const*;
+
+public:
+    using SizeType = typename ContainerType::SizeType;
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename ContainerType::ValueType;
+    using difference_type   = typename ContainerType::DifferenceType;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+    using SpanType          = std::span<std::remove_reference_t<reference>>;
+
+    constexpr static const SizeType chunk_size = ContainerType::chunk_size;
+
+    constexpr deque_iterator() noexcept = default;
+
+    template<bool OtherIsConst>
+        requires(IsConst && OtherIsConst == false)
+    deque_iterator(const deque_iterator<ContainerType, OtherIsConst>& other_) noexcept;
+
+    [[nodiscard]] reference operator*() const noexcept;
+    [[nodiscard]] pointer   operator->() const noexcept;
+    [[nodiscard]] reference operator[](difference_type offset_) const noexcept;
+
+    deque_iterator& operator++() noexcept;
+    deque_iterator  operator++(int) noexcept;
+    deque_iterator& operator--() noexcept;
+    deque_iterator  operator--(int) noexcept;
+
+    deque_iterator& operator+=(difference_type offset_) noexcept;
+    deque_iterator& operator-=(difference_type offset_) noexcept;
+
+    [[nodiscard]] deque_iterator  operator+(difference_type offset_) const noexcept;
+    [[nodiscard]] deque_iterator  operator-(difference_type offset_) const noexcept;
+    [[nodiscard]] difference_type operator-(const deque_iterator& rhs_) const noexcept;
+
+    [[nodiscard]] friend deque_iterator operator+(difference_type       offset_,
+                                                  const deque_iterator& iterator_) noexcept
+    {
+        return iterator_ + offset_;
+    }
+
+    [[nodiscard]] bool operator==(const deque_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator!=(const deque_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator<(const deque_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator<=(const deque_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator>(const deque_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator>=(const deque_iterator& rhs_) const noexcept;
+
+    template<typename FunctionType>
+    friend void for_each_segment(deque_iterator first_,
+                                 deque_iterator last_,
+                                 FunctionType&& function_)
+    {
+        first_.visit_segments(last_, function_);
+    }
+
+private:
+    deque_iterator(ChunkPointer chunk_, pointer current_) noexcept;
+
+    template<typename FunctionType>
+    void visit_segments(const deque_iterator& last_, FunctionType& function_) const;
+
+    pointer      m_current = nullptr;
+    pointer      m_first   = nullptr;
+    ChunkPointer m_chunk   = nullptr;
+};
+
+
+/**
+ * \brief       Double-ended queue storing its elements in fixed-size chunks.
+ *
+ *              A chunk holds 2^ChunkBits elements, about a page by default, and a map of chunk
+ *              pointers keeps them in order with free entries on both sides. Pushing or popping at
+ *              either end is O(1) and never moves any element, so references to the elements stay
+ *              valid until they are popped; only the map of pointers is occasionally recentered or
+ *              grown. Chunks and the map are allocated through AllocatorType, and the last chunk
+ *              emptied is kept aside for the next one needed, so a queue that stays about the same
+ *              size does not allocate.
+ *
+ *              Offers the familiar container_base surface (length, is_empty, at, front, back,
+ *              comparisons) with random-access iterators. Algorithms that run over a whole range,
+ *              such as for_each() and copy(), are overloaded for these iterators and run as one
+ *              tight loop per chunk; for_each_segment() gives the chunks as spans to any other.
+ *
+ * \note        Pushing and popping invalidate iterators, but not references, to other elements.
+ */
+template<typename ItemType,
+         typename AllocatorType = std::allocator<ItemType>,
+         std::size_t ChunkBits  = default_deque_chunk_bits<ItemType>>
+class deque
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(ChunkBits < 32, "Chunks are too large");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using AllocatorTraits    = std::allocator_traits<AllocatorType>;
+    using SizeType           = std::size_t;
+    using DifferenceType     = std::ptrdiff_t;
+    using ValueType          = ItemType;
+    using IteratorType       = deque_iterator<deque, false>;
+    using ConstIteratorType  = deque_iterator<deque, true>;
+    using RIteratorType      = std::reverse_iterator<IteratorType>;
+    using ConstRIteratorType = std::reverse_iterator<ConstIteratorType>;
+    using SpanType           = std::span<ItemType>;
+    using ConstSpanType      = std::span<const ItemType>;
+
+    constexpr static const SizeType chunk_size = SizeType{1} << ChunkBits;
+
+private:
+    using MapAllocatorType = typename AllocatorTraits::template rebind_alloc<ItemType*>;
+    using MapTraits        = std::allocator_traits<MapAllocatorType>;
+
+    constexpr static const SizeType chunk_mask   = chunk_size - 1;
+    constexpr static const SizeType min_map_size = 8;
+
+    friend IteratorType;
+    friend ConstIteratorType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit deque(const AllocatorType& alloc_ = AllocatorType{});
+    deque(std::initializer_list<ValueType> values_, const AllocatorType& alloc_ = AllocatorType{});
+    template<typename InputIterator>
+    deque(InputIterator first_, InputIterator last_, const AllocatorType& alloc_ = AllocatorType{});
+
+    deque(const deque& copy_);
+    deque(deque&& move_) noexcept;
+    deque& operator=(const deque& copy_);
+    deque& operator=(deque&& move_) noexcept;
+
+    ~deque();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&         at(SizeType index_);
+    [[nodiscard]] const ItemType&   at(SizeType index_) const;
+    [[nodiscard]] IteratorType      iterator_at(SizeType index_) noexcept;
+    [[nodiscard]] ConstIteratorType iterator_at(SizeType index_) const noexcept;
+
+    [[nodiscard]] ItemType&       front();
+    [[nodiscard]] ItemType&       back();
+    [[nodiscard]] const ItemType& front() const;
+    [[nodiscard]] const ItemType& back() const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&       operator[](SizeType index_) noexcept;
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType       begin() noexcept;
+    [[nodiscard]] IteratorType       end() noexcept;
+    [[nodiscard]] ConstIteratorType  begin() const noexcept;
+    [[nodiscard]] ConstIteratorType  end() const noexcept;
+    [[nodiscard]] ConstIteratorType  cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType  cend() const noexcept;
+    [[nodiscard]] RIteratorType      rbegin() noexcept;
+    [[nodiscard]] RIteratorType      rend() noexcept;
+    [[nodiscard]] ConstRIteratorType rbegin() const noexcept;
+    [[nodiscard]] ConstRIteratorType rend() const noexcept;
+
+    template<typename FunctionType>
+    void for_each_segment(FunctionType&& function_);
+    template<typename FunctionType>
+    void for_each_segment(FunctionType&& function_) const;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    template<typename... Args>
+    ItemType& emplace_back(Args&&... args_);
+    ItemType& push_back(const ItemType& item_);
+    ItemType& push_back(ItemType&& item_);
+
+    template<typename... Args>
+    ItemType& emplace_front(Args&&... args_);
+    ItemType& push_front(const ItemType& item_);
+    ItemType& push_front(ItemType&& item_);
+
+    void pop_back();
+    void pop_front();
+
+    void clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_not_empty() const noexcept;
+    [[nodiscard]] SizeType             chunk_count() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] ItemType*         element_pointer(SizeType position_) const noexcept;
+    [[nodiscard]] IteratorType      make_iterator(SizeType position_) const noexcept;
+    [[nodiscard]] ConstIteratorType make_const_iterator(SizeType position_) const noexcept;
+
+    template<typename... Args>
+    ItemType& emplace_back_in_new_chunk(Args&&... args_);
+    template<typename... Args>
+    ItemType& emplace_front_in_new_chunk(Args&&... args_);
+
+    void                    initialize_map();
+    void                    make_room(bool atFront_);
+    [[nodiscard]] ItemType* acquire_chunk();
+    void                    release_chunk(ItemType* chunk_) noexcept;
+    void                    release() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    /* Chunk pointers; those of the chunks holding elements, and of the chunk where the next
+     * push_back() goes, are never null */
+    ItemType** m_map     = nullptr;
+    SizeType   m_mapSize = 0;
+
+    /* Position of the first element, counted in elements from the start of the map */
+    SizeType m_start  = 0;
+    SizeType m_length = 0;
+
+    /* Last chunk emptied, kept to be reused by the next chunk needed */
+    ItemType* m_spareChunk = nullptr;
+
+    [[no_unique_address]] AllocatorType m_allocator{};
+
+    constexpr static const bool container_safeness = true;
+};
+
+
+/*************************************************************************************************/
+/* Segmented algorithms ------------------------------------------------------------------------ */
+template<typename ContainerType, bool IsConst, typename FunctionType>
+FunctionType for_each(deque_iterator<ContainerType, IsConst> first_,
+                      deque_iterator<ContainerType, IsConst> last_,
+                      FunctionType                           function_);
+
+template<typename ContainerType, bool IsConst, typename OutputIterator>
+OutputIterator copy(deque_iterator<ContainerType, IsConst> first_,
+                    deque_iterator<ContainerType, IsConst> last_,
+                    OutputIterator                         destination_);
+
+
+/* clang-format off */
+#define DEQUE_OPERATOR_TEMPLATE_DECLARATION__                                                      \
+        typename ItemType,                                                                         \
+        typename AllocatorType,                                                                    \
+        std::size_t ChunkBits
+
+#define DEQUE_OPERATOR_ARGUMENTS__                                                                 \
+        const deque<ItemType, AllocatorType, ChunkBits>& lhs_,                                     \
+        const deque<ItemType, AllocatorType, ChunkBits>& rhs_
+/* clang-format on */
+
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator==(DEQUE_OPERATOR_ARGUMENTS__);
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator!=(DEQUE_OPERATOR_ARGUMENTS__);
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator<(DEQUE_OPERATOR_ARGUMENTS__);
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator<=(DEQUE_OPERATOR_ARGUMENTS__);
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator>(DEQUE_OPERATOR_ARGUMENTS__);
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator>=(DEQUE_OPERATOR_ARGUMENTS__);
+
+
+}        // namespace pel
+
+#include "./deque.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,1247 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./deque.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define DEQUE_TEMPLATE_DECLARATION__ typename ItemType,                                            \
+                                     typename AllocatorType,                                       \
+                                     std::size_t ChunkBits
+#define DEQUE_CLASS_SCOPE__          deque<ItemType, AllocatorType, ChunkBits>
+#define DEQUE_ITERATOR_CLASS_SCOPE__ deque_iterator<ContainerType, IsConst>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__::deque_iterator(ChunkPointer chunk_, pointer current_) noexcept
+: m_current{current_}, m_first{*chunk_}, m_chunk{chunk_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Convert a mutable iterator into a constant one.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+template<bool OtherIsConst>
+    requires(IsConst && OtherIsConst == false)
+inline DEQUE_ITERATOR_CLASS_SCOPE__::deque_iterator(
+  const deque_iterator<ContainerType, OtherIsConst>& other_) noexcept
+: m_current{other_.m_current}, m_first{other_.m_first}, m_chunk{other_.m_chunk}
+{
+}
+
+
+template<typename ContainerType, bool IsConst>
+inline typename DEQUE_ITERATOR_CLASS_SCOPE__::reference
+DEQUE_ITERATOR_CLASS_SCOPE__::operator*() const noexcept
+{
+    return *m_current;
+}
+
+template<typename ContainerType, bool IsConst>
+inline typename DEQUE_ITERATOR_CLASS_SCOPE__::pointer
+DEQUE_ITERATOR_CLASS_SCOPE__::operator->() const noexcept
+{
+    return m_current;
+}
+
+template<typename ContainerType, bool IsConst>
+inline typename DEQUE_ITERATOR_CLASS_SCOPE__::reference
+DEQUE_ITERATOR_CLASS_SCOPE__::operator[](difference_type offset_) const noexcept
+{
+    return *(*this + offset_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move to the next element, entering the next chunk at the end of a chunk.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__& DEQUE_ITERATOR_CLASS_SCOPE__::operator++() noexcept
+{
+    if(++m_current == m_first + chunk_size)
+    {
+        ++m_chunk;
+        m_first   = *m_chunk;
+        m_current = m_first;
+    }
+    return *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__ DEQUE_ITERATOR_CLASS_SCOPE__::operator++(int) noexcept
+{
+    deque_iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move to the previous element, entering the previous chunk at the start of a chunk.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__& DEQUE_ITERATOR_CLASS_SCOPE__::operator--() noexcept
+{
+    if(m_current == m_first)
+    {
+        --m_chunk;
+        m_first   = *m_chunk;
+        m_current = m_first + chunk_size;
+    }
+    --m_current;
+    return *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__ DEQUE_ITERATOR_CLASS_SCOPE__::operator--(int) noexcept
+{
+    deque_iterator previous = *this;
+    --*this;
+    return previous;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move by any number of elements in O(1): within the chunk, the pointer is simply
+ *              moved, otherwise the target chunk and offset are computed from the distance.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__&
+DEQUE_ITERATOR_CLASS_SCOPE__::operator+=(difference_type offset_) noexcept
+{
+    constexpr difference_type chunkLength = static_cast<difference_type>(chunk_size);
+
+    const difference_type offset = (m_current - m_first) + offset_;
+    if(offset >= 0 && offset < chunkLength)
+    {
+        m_current += offset_;
+    }
+    else
+    {
+        const difference_type chunkOffset =
+          offset >= 0 ? offset / chunkLength : -((-offset - 1) / chunkLength) - 1;
+        m_chunk += chunkOffset;
+        m_first   = *m_chunk;
+        m_current = m_first + (offset - chunkOffset * chunkLength);
+    }
+    return *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__&
+DEQUE_ITERATOR_CLASS_SCOPE__::operator-=(difference_type offset_) noexcept
+{
+    return *this += -offset_;
+}
+
+
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__
+DEQUE_ITERATOR_CLASS_SCOPE__::operator+(difference_type offset_) const noexcept
+{
+    deque_iterator moved = *this;
+    moved += offset_;
+    return moved;
+}
+
+template<typename ContainerType, bool IsConst>
+inline DEQUE_ITERATOR_CLASS_SCOPE__
+DEQUE_ITERATOR_CLASS_SCOPE__::operator-(difference_type offset_) const noexcept
+{
+    deque_iterator moved = *this;
+    moved -= offset_;
+    return moved;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements between two iterators of the same deque, in O(1).
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline typename DEQUE_ITERATOR_CLASS_SCOPE__::difference_type
+DEQUE_ITERATOR_CLASS_SCOPE__::operator-(const deque_iterator& rhs_) const noexcept
+{
+    return (m_chunk - rhs_.m_chunk) * static_cast<difference_type>(chunk_size)
+           + (m_current - m_first) - (rhs_.m_current - rhs_.m_first);
+}
+
+
+template<typename ContainerType, bool IsConst>
+inline bool DEQUE_ITERATOR_CLASS_SCOPE__::operator==(const deque_iterator& rhs_) const noexcept
+{
+    return m_current == rhs_.m_current;
+}
+
+template<typename ContainerType, bool IsConst>
+inline bool DEQUE_ITERATOR_CLASS_SCOPE__::operator!=(const deque_iterator& rhs_) const noexcept
+{
+    return !(*this == rhs_);
+}
+
+template<typename ContainerType, bool IsConst>
+inline bool DEQUE_ITERATOR_CLASS_SCOPE__::operator<(const deque_iterator& rhs_) const noexcept
+{
+    return m_chunk == rhs_.m_chunk ? m_current < rhs_.m_current : m_chunk < rhs_.m_chunk;
+}
+
+template<typename ContainerType, bool IsConst>
+inline bool DEQUE_ITERATOR_CLASS_SCOPE__::operator<=(const deque_iterator& rhs_) const noexcept
+{
+    return !(rhs_ < *this);
+}
+
+template<typename ContainerType, bool IsConst>
+inline bool DEQUE_ITERATOR_CLASS_SCOPE__::operator>(const deque_iterator& rhs_) const noexcept
+{
+    return rhs_ < *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline bool DEQUE_ITERATOR_CLASS_SCOPE__::operator>=(const deque_iterator& rhs_) const noexcept
+{
+    return !(*this < rhs_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function with the elements up to another iterator, as one span per chunk.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+template<typename FunctionType>
+inline void DEQUE_ITERATOR_CLASS_SCOPE__::visit_segments(const deque_iterator& last_,
+                                                         FunctionType&         function_) const
+{
+    if(m_current == last_.m_current)
+    {
+        return;
+    }
+    if(m_chunk == last_.m_chunk)
+    {
+        function_(SpanType(m_current, last_.m_current));
+        return;
+    }
+
+    function_(SpanType(m_current, m_first + chunk_size));
+    for(ChunkPointer chunk = m_chunk + 1; chunk != last_.m_chunk; ++chunk)
+    {
+        function_(SpanType(*chunk, chunk_size));
+    }
+    if(last_.m_current != last_.m_first)
+    {
+        function_(SpanType(last_.m_first, last_.m_current));
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty deque. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator, rebound to allocate the chunk map.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline DEQUE_CLASS_SCOPE__::deque(const AllocatorType& alloc_) : m_allocator{alloc_}
+{
+}
+
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline DEQUE_CLASS_SCOPE__::deque(std::initializer_list<ValueType> values_,
+                                  const AllocatorType&             alloc_)
+: deque(values_.begin(), values_.end(), alloc_)
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a deque holding a copy of every element of a range, in order.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline DEQUE_CLASS_SCOPE__::deque(InputIterator        first_,
+                                  InputIterator        last_,
+                                  const AllocatorType& alloc_)
+: m_allocator{alloc_}
+{
+    try
+    {
+        for(; first_ != last_; ++first_)
+        {
+            emplace_back(*first_);
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline DEQUE_CLASS_SCOPE__::deque(const deque& copy_)
+: m_allocator{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)}
+{
+    try
+    {
+        copy_.for_each_segment([this](ConstSpanType segment_) {
+            for(const ItemType& item : segment_)
+            {
+                emplace_back(item);
+            }
+        });
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the chunks of another deque, leaving it empty.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline DEQUE_CLASS_SCOPE__::deque(deque&& move_) noexcept
+: m_map{std::exchange(move_.m_map, nullptr)},
+  m_mapSize{std::exchange(move_.m_mapSize, 0)},
+  m_start{std::exchange(move_.m_start, 0)},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_spareChunk{std::exchange(move_.m_spareChunk, nullptr)},
+  m_allocator{move_.m_allocator}
+{
+}
+
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline DEQUE_CLASS_SCOPE__& DEQUE_CLASS_SCOPE__::operator=(const deque& copy_)
+{
+    if(this != &copy_)
+    {
+        deque copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline DEQUE_CLASS_SCOPE__& DEQUE_CLASS_SCOPE__::operator=(deque&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+        m_map        = std::exchange(move_.m_map, nullptr);
+        m_mapSize    = std::exchange(move_.m_mapSize, 0);
+        m_start      = std::exchange(move_.m_start, 0);
+        m_length     = std::exchange(move_.m_length, 0);
+        m_spareChunk = std::exchange(move_.m_spareChunk, nullptr);
+        m_allocator  = move_.m_allocator;
+    }
+    return *this;
+}
+
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline DEQUE_CLASS_SCOPE__::~deque()
+{
+    release();
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element at a position, checking the position.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If there is no element at that position.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::at(SizeType index_)
+{
+    if(index_ >= m_length)
+    {
+        throw std::length_error("Index out of range");
+    }
+    return *element_pointer(m_start + index_);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline const ItemType& DEQUE_CLASS_SCOPE__::at(SizeType index_) const
+{
+    if(index_ >= m_length)
+    {
+        throw std::length_error("Index out of range");
+    }
+    return *element_pointer(m_start + index_);
+}
+
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::IteratorType
+DEQUE_CLASS_SCOPE__::iterator_at(SizeType index_) noexcept
+{
+    return make_iterator(m_start + index_);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstIteratorType
+DEQUE_CLASS_SCOPE__::iterator_at(SizeType index_) const noexcept
+{
+    return make_const_iterator(m_start + index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the first or last element.
+ *
+ * \throw       std::length_error
+ *              If the deque is empty.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::front()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(m_start);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::back()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(m_start + m_length - 1);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline const ItemType& DEQUE_CLASS_SCOPE__::front() const
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(m_start);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline const ItemType& DEQUE_CLASS_SCOPE__::back() const
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(m_start + m_length - 1);
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::operator[](SizeType index_) noexcept
+{
+    return *element_pointer(m_start + index_);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline const ItemType& DEQUE_CLASS_SCOPE__::operator[](SizeType index_) const noexcept
+{
+    return *element_pointer(m_start + index_);
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::IteratorType DEQUE_CLASS_SCOPE__::begin() noexcept
+{
+    return make_iterator(m_start);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::IteratorType DEQUE_CLASS_SCOPE__::end() noexcept
+{
+    return make_iterator(m_start + m_length);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstIteratorType DEQUE_CLASS_SCOPE__::begin() const noexcept
+{
+    return make_const_iterator(m_start);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstIteratorType DEQUE_CLASS_SCOPE__::end() const noexcept
+{
+    return make_const_iterator(m_start + m_length);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstIteratorType DEQUE_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstIteratorType DEQUE_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::RIteratorType DEQUE_CLASS_SCOPE__::rbegin() noexcept
+{
+    return RIteratorType(end());
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::RIteratorType DEQUE_CLASS_SCOPE__::rend() noexcept
+{
+    return RIteratorType(begin());
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstRIteratorType DEQUE_CLASS_SCOPE__::rbegin() const noexcept
+{
+    return ConstRIteratorType(end());
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstRIteratorType DEQUE_CLASS_SCOPE__::rend() const noexcept
+{
+    return ConstRIteratorType(begin());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function with every element, as one span per chunk, from front to back.
+ *
+ * \param       function_: Callable taking a SpanType (a ConstSpanType on a constant deque).
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void DEQUE_CLASS_SCOPE__::for_each_segment(FunctionType&& function_)
+{
+    begin().visit_segments(end(), function_);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void DEQUE_CLASS_SCOPE__::for_each_segment(FunctionType&& function_) const
+{
+    begin().visit_segments(end(), function_);
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in place after the last one, in O(1).
+ *              The deque is left unchanged if this throws.
+ *
+ * \param       args_: Arguments forwarded to the element's constructor. They may refer to
+ *                     elements of the deque, which never move.
+ *
+ * \retval      ItemType&: Reference to the new element. It stays valid until it is popped.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline ItemType& DEQUE_CLASS_SCOPE__::emplace_back(Args&&... args_)
+{
+    /* Inlined part: the new element and end() both stay in the last chunk. The length is read
+     * before constructing the element, which the compiler cannot prove does not overwrite it */
+    const SizeType currentLength = m_length;
+    const SizeType position      = m_start + currentLength;
+    if(m_map != nullptr && ((position + 1) & chunk_mask) != 0)
+    {
+        ItemType* item = element_pointer(position);
+        AllocatorTraits::construct(m_allocator, item, std::forward<Args>(args_)...);
+        m_length = currentLength + 1;
+        return *item;
+    }
+    return emplace_back_in_new_chunk(std::forward<Args>(args_)...);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       emplace_back() when the map is missing, or when end() moves on to the next chunk,
+ *              which must be acquired first. Kept out of line so that emplace_back() inlines.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+PEL_NOINLINE inline ItemType& DEQUE_CLASS_SCOPE__::emplace_back_in_new_chunk(Args&&... args_)
+{
+    if(m_map == nullptr)
+    {
+        initialize_map();
+    }
+
+    /* Filling a chunk allocates the next one, where end() points */
+    if(((m_start + m_length + 1) & chunk_mask) == 0
+       && ((m_start + m_length + 1) >> ChunkBits) >= m_mapSize)
+    {
+        make_room(false);
+    }
+
+    const SizeType position   = m_start + m_length;
+    const SizeType nextChunk  = (position + 1) >> ChunkBits;
+    const bool     needsChunk = ((position + 1) & chunk_mask) == 0;
+    if(needsChunk)
+    {
+        m_map[nextChunk] = acquire_chunk();
+    }
+
+    ItemType* item = element_pointer(position);
+    try
+    {
+        AllocatorTraits::construct(m_allocator, item, std::forward<Args>(args_)...);
+    }
+    catch(...)
+    {
+        if(needsChunk)
+        {
+            release_chunk(std::exchange(m_map[nextChunk], nullptr));
+        }
+        throw;
+    }
+
+    ++m_length;
+    return *item;
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::push_back(const ItemType& item_)
+{
+    return emplace_back(item_);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::push_back(ItemType&& item_)
+{
+    return emplace_back(std::move(item_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in place before the first one, in O(1).
+ *              The deque is left unchanged if this throws.
+ *
+ * \param       args_: Arguments forwarded to the element's constructor. They may refer to
+ *                     elements of the deque, which never move.
+ *
+ * \retval      ItemType&: Reference to the new element. It stays valid until it is popped.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline ItemType& DEQUE_CLASS_SCOPE__::emplace_front(Args&&... args_)
+{
+    /* Inlined part: the new element goes in the first chunk */
+    const SizeType currentStart  = m_start;
+    const SizeType currentLength = m_length;
+    if(m_map != nullptr && (currentStart & chunk_mask) != 0)
+    {
+        ItemType* item = element_pointer(currentStart - 1);
+        AllocatorTraits::construct(m_allocator, item, std::forward<Args>(args_)...);
+        m_start  = currentStart - 1;
+        m_length = currentLength + 1;
+        return *item;
+    }
+    return emplace_front_in_new_chunk(std::forward<Args>(args_)...);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       emplace_front() when the map is missing, or when the first chunk is full and the
+ *              previous one must be acquired first. Kept out of line so that emplace_front()
+ *              inlines.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+PEL_NOINLINE inline ItemType& DEQUE_CLASS_SCOPE__::emplace_front_in_new_chunk(Args&&... args_)
+{
+    if(m_map == nullptr)
+    {
+        initialize_map();
+    }
+
+    if((m_start & chunk_mask) == 0 && (m_start >> ChunkBits) == 0)
+    {
+        make_room(true);
+    }
+
+    const SizeType position   = m_start - 1;
+    const SizeType chunk      = position >> ChunkBits;
+    const bool     needsChunk = (m_start & chunk_mask) == 0;
+    if(needsChunk)
+    {
+        m_map[chunk] = acquire_chunk();
+    }
+
+    ItemType* item = element_pointer(position);
+    try
+    {
+        AllocatorTraits::construct(m_allocator, item, std::forward<Args>(args_)...);
+    }
+    catch(...)
+    {
+        if(needsChunk)
+        {
+            release_chunk(std::exchange(m_map[chunk], nullptr));
+        }
+        throw;
+    }
+
+    m_start = position;
+    ++m_length;
+    return *item;
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::push_front(const ItemType& item_)
+{
+    return emplace_front(item_);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType& DEQUE_CLASS_SCOPE__::push_front(ItemType&& item_)
+{
+    return emplace_front(std::move(item_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the last element, in O(1). A chunk left without elements is released.
+ *
+ * \throw       std::length_error
+ *              If the deque is empty.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::pop_back()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+
+    const SizeType oldEnd = m_start + m_length;
+    AllocatorTraits::destroy(m_allocator, element_pointer(oldEnd - 1));
+    --m_length;
+
+    /* end() moved back into the previous chunk */
+    if((oldEnd & chunk_mask) == 0)
+    {
+        release_chunk(std::exchange(m_map[oldEnd >> ChunkBits], nullptr));
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the first element, in O(1). A chunk left without elements is released.
+ *
+ * \throw       std::length_error
+ *              If the deque is empty.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::pop_front()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+
+    AllocatorTraits::destroy(m_allocator, element_pointer(m_start));
+    ++m_start;
+    --m_length;
+
+    if((m_start & chunk_mask) == 0)
+    {
+        release_chunk(std::exchange(m_map[(m_start >> ChunkBits) - 1], nullptr));
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element. The map and one chunk stay allocated.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::clear() noexcept
+{
+    if(m_map == nullptr)
+    {
+        return;
+    }
+
+    for_each_segment([this](SpanType segment_) {
+        for(ItemType& item : segment_)
+        {
+            AllocatorTraits::destroy(m_allocator, &item);
+        }
+    });
+
+    const SizeType firstChunk = m_start >> ChunkBits;
+    const SizeType lastChunk  = (m_start + m_length) >> ChunkBits;
+    for(SizeType chunk = firstChunk + 1; chunk <= lastChunk; ++chunk)
+    {
+        release_chunk(std::exchange(m_map[chunk], nullptr));
+    }
+
+    m_start  = (firstChunk << ChunkBits) + chunk_size / 2;
+    m_length = 0;
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::SizeType DEQUE_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline bool DEQUE_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline bool DEQUE_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_length != 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of chunks in use, including the one end() points into.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::SizeType DEQUE_CLASS_SCOPE__::chunk_count() const noexcept
+{
+    if(m_map == nullptr)
+    {
+        return 0;
+    }
+    return ((m_start + m_length) >> ChunkBits) - (m_start >> ChunkBits) + 1;
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline const AllocatorType& DEQUE_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free the spare chunk, and everything else if the deque is empty.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(m_spareChunk != nullptr)
+    {
+        AllocatorTraits::deallocate(m_allocator, std::exchange(m_spareChunk, nullptr), chunk_size);
+    }
+    if(m_length == 0)
+    {
+        release();
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline std::string DEQUE_CLASS_SCOPE__::to_string() const
+{
+    std::stringstream ss;
+    ss << "[";
+    for(ConstIteratorType it = begin(); it != end(); ++it)
+    {
+        if(it != begin())
+        {
+            ss << ", ";
+        }
+        if constexpr(requires { ss << *it; })
+        {
+            ss << *it;
+        }
+        else
+        {
+            ss << "?";
+        }
+    }
+    ss << "]";
+    return ss.str();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Address of the element at a position counted from the start of the map.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType* DEQUE_CLASS_SCOPE__::element_pointer(SizeType position_) const noexcept
+{
+    return m_map[position_ >> ChunkBits] + (position_ & chunk_mask);
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::IteratorType
+DEQUE_CLASS_SCOPE__::make_iterator(SizeType position_) const noexcept
+{
+    if(m_map == nullptr)
+    {
+        return IteratorType();
+    }
+    return IteratorType(m_map + (position_ >> ChunkBits), element_pointer(position_));
+}
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline typename DEQUE_CLASS_SCOPE__::ConstIteratorType
+DEQUE_CLASS_SCOPE__::make_const_iterator(SizeType position_) const noexcept
+{
+    return make_iterator(position_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate the map and its first chunk, starting halfway through both so that the
+ *              first pushes at either end need neither.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::initialize_map()
+{
+    MapAllocatorType mapAllocator{m_allocator};
+    ItemType**       map = MapTraits::allocate(mapAllocator, min_map_size);
+    std::fill_n(map, min_map_size, nullptr);
+
+    try
+    {
+        map[min_map_size / 2] = acquire_chunk();
+    }
+    catch(...)
+    {
+        MapTraits::deallocate(mapAllocator, map, min_map_size);
+        throw;
+    }
+
+    m_map     = map;
+    m_mapSize = min_map_size;
+    m_start   = ((min_map_size / 2) << ChunkBits) + chunk_size / 2;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make room in the map for one more chunk at one end.
+ *              The chunks in use are moved back to the middle of the map if it is at most half
+ *              full, otherwise to the middle of a map twice as large. Only chunk pointers move.
+ *
+ * \param       atFront_: True to make room before the first chunk, false after the last one.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::make_room(bool atFront_)
+{
+    const SizeType firstChunk   = m_start >> ChunkBits;
+    const SizeType usedChunks   = ((m_start + m_length) >> ChunkBits) - firstChunk + 1;
+    const SizeType neededChunks = usedChunks + 1;
+
+    SizeType newFirst = 0;
+    if(m_mapSize >= 2 * neededChunks)
+    {
+        newFirst = (m_mapSize - neededChunks) / 2 + (atFront_ ? 1 : 0);
+        if(newFirst < firstChunk)
+        {
+            std::copy(m_map + firstChunk, m_map + firstChunk + usedChunks, m_map + newFirst);
+        }
+        else
+        {
+            std::copy_backward(
+              m_map + firstChunk, m_map + firstChunk + usedChunks, m_map + newFirst + usedChunks);
+        }
+        std::fill(m_map, m_map + newFirst, nullptr);
+        std::fill(m_map + newFirst + usedChunks, m_map + m_mapSize, nullptr);
+    }
+    else
+    {
+        const SizeType   newSize = std::max(m_mapSize * 2, neededChunks * 2);
+        MapAllocatorType mapAllocator{m_allocator};
+        ItemType**       newMap = MapTraits::allocate(mapAllocator, newSize);
+
+        newFirst = (newSize - neededChunks) / 2 + (atFront_ ? 1 : 0);
+        std::fill_n(newMap, newSize, nullptr);
+        std::copy(m_map + firstChunk, m_map + firstChunk + usedChunks, newMap + newFirst);
+        MapTraits::deallocate(mapAllocator, m_map, m_mapSize);
+
+        m_map     = newMap;
+        m_mapSize = newSize;
+    }
+
+    m_start = (newFirst << ChunkBits) + (m_start & chunk_mask);
+}
+
+
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline ItemType* DEQUE_CLASS_SCOPE__::acquire_chunk()
+{
+    if(m_spareChunk != nullptr)
+    {
+        return std::exchange(m_spareChunk, nullptr);
+    }
+    return AllocatorTraits::allocate(m_allocator, chunk_size);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Keep an empty chunk as the spare one, or free it if there already is one.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::release_chunk(ItemType* chunk_) noexcept
+{
+    if(m_spareChunk == nullptr)
+    {
+        m_spareChunk = chunk_;
+    }
+    else
+    {
+        AllocatorTraits::deallocate(m_allocator, chunk_, chunk_size);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element and free the chunks and the map.
+ *************************************************************************************************/
+template<DEQUE_TEMPLATE_DECLARATION__>
+inline void DEQUE_CLASS_SCOPE__::release() noexcept
+{
+    if(m_map != nullptr)
+    {
+        clear();
+        AllocatorTraits::deallocate(m_allocator, m_map[m_start >> ChunkBits], chunk_size);
+
+        MapAllocatorType mapAllocator{m_allocator};
+        MapTraits::deallocate(mapAllocator, m_map, m_mapSize);
+    }
+    if(m_spareChunk != nullptr)
+    {
+        AllocatorTraits::deallocate(m_allocator, m_spareChunk, chunk_size);
+    }
+
+    m_map        = nullptr;
+    m_mapSize    = 0;
+    m_start      = 0;
+    m_length     = 0;
+    m_spareChunk = nullptr;
+}
+
+
+
+/*************************************************************************************************/
+/* SEGMENTED ALGORITHMS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       std::for_each over deque iterators, as one plain loop per chunk.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst, typename FunctionType>
+inline FunctionType for_each(deque_iterator<ContainerType, IsConst> first_,
+                             deque_iterator<ContainerType, IsConst> last_,
+                             FunctionType                           function_)
+{
+    for_each_segment(first_, last_, [&function_](auto segment_) {
+        for(auto& item : segment_)
+        {
+            function_(item);
+        }
+    });
+    return function_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       std::copy from deque iterators, one chunk at a time, so that copying trivially
+ *              copyable elements to a pointer is one memmove per chunk.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst, typename OutputIterator>
+inline OutputIterator copy(deque_iterator<ContainerType, IsConst> first_,
+                           deque_iterator<ContainerType, IsConst> last_,
+                           OutputIterator                         destination_)
+{
+    for_each_segment(first_, last_, [&destination_](auto segment_) {
+        destination_ = std::copy(segment_.begin(), segment_.end(), destination_);
+    });
+    return destination_;
+}
+
+
+
+/*************************************************************************************************/
+/* COMPARISON OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Two deques are equal when they hold equal elements, in the same order.
+ *************************************************************************************************/
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator==(DEQUE_OPERATOR_ARGUMENTS__)
+{
+    return lhs_.length() == rhs_.length() && std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+}
+
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator!=(DEQUE_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ == rhs_);
+}
+
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator<(DEQUE_OPERATOR_ARGUMENTS__)
+{
+    return std::lexicographical_compare(lhs_.begin(), lhs_.end(), rhs_.begin(), rhs_.end());
+}
+
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator<=(DEQUE_OPERATOR_ARGUMENTS__)
+{
+    return !(rhs_ < lhs_);
+}
+
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator>(DEQUE_OPERATOR_ARGUMENTS__)
+{
+    return rhs_ < lhs_;
+}
+
+template<DEQUE_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator>=(DEQUE_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ < rhs_);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef DEQUE_TEMPLATE_DECLARATION__
+#undef DEQUE_CLASS_SCOPE__
+#undef DEQUE_ITERATOR_CLASS_SCOPE__
+#undef DEQUE_OPERATOR_TEMPLATE_DECLARATION__
+#undef DEQUE_OPERATOR_ARGUMENTS__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,334 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Process-wide epoch tracker used to reclaim memory that lock-free readers may still
+ *              be looking at.
+ *
+ *              Each thread that reads gets its own cache-line sized slot, in which it announces the
+ *              global epoch it observed while inside a read section. Writers unlink an object,
+ *              advance the global epoch, and may free the object once every announced epoch is past
+ *              the one it was unlinked in. Readers never write to a shared cache line.
+ *              Slots come in blocks chained together; a new block is appended whenever every slot
+ *              is taken, so any number of threads may read at the same time.
+ */
+class epoch_domain
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType  = std::size_t;
+    using EpochType = std::uint64_t;
+
+    constexpr static const SizeType  slots_per_block = 64;
+    constexpr static const EpochType idle_epoch      = 0;
+
+private:
+    struct alignas(cache_line_size) reader_slot
+    {
+        std::atomic<EpochType> epoch{idle_epoch};
+        std::atomic<bool>      isOwned{false};
+        SizeType               depth = 0;
+    };
+
+    struct slot_block
+    {
+        std::array<reader_slot, slots_per_block> slots{};
+        std::atomic<slot_block*>                 next{nullptr};
+    };
+
+    struct thread_registration
+    {
+        reader_slot* slot = nullptr;
+        ~thread_registration();
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+private:
+    epoch_domain() = default;
+
+public:
+    ~epoch_domain();
+
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+    epoch_domain(epoch_domain&&)                 = delete;
+    epoch_domain& operator=(epoch_domain&&) = delete;
+
+    [[nodiscard]] static epoch_domain& global() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Readers --------------------------------------------------------------------------------- */
+    void enter();
+    void leave() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Writers --------------------------------------------------------------------------------- */
+    [[nodiscard]] EpochType advance() noexcept;
+    [[nodiscard]] EpochType oldest_active() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] reader_slot&                 local_slot();
+    [[nodiscard]] static slot_block*           append_block(slot_block& last_);
+    [[nodiscard]] static thread_registration& registration() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    alignas(cache_line_size) std::atomic<EpochType> m_epoch{1};
+    slot_block m_firstBlock{};
+};
+
+
+/*************************************************************************/
+/* IMPLEMENTATION OF METHODS                                             */
+/*************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the domain shared by every rcu_container of the process.
+ *************************************************************************************************/
+[[nodiscard]] inline epoch_domain&
+epoch_domain::global() noexcept
+{
+    static epoch_domain domain;
+    return domain;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Release the reader slot blocks appended after the first one.
+ *************************************************************************************************/
+inline epoch_domain::~epoch_domain()
+{
+    slot_block* block = m_firstBlock.next.load(std::memory_order_acquire);
+    while(block != nullptr)
+    {
+        slot_block* next = block->next.load(std::memory_order_relaxed);
+        delete block;
+        block = next;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Start a read section on the calling thread.
+ *              Read sections nest; only the outermost one announces an epoch.
+ *
+ * \throws      std::bad_alloc
+ *              If every slot is taken on the thread's first read, and a new block of slots could
+ *              not be allocated.
+ *************************************************************************************************/
+inline void
+epoch_domain::enter()
+{
+    reader_slot& slot = local_slot();
+    if(slot.depth++ == 0)
+    {
+        /* Sequentially consistent so that the writer's scan either sees this epoch, or this
+         * thread sees everything the writer unlinked before advancing */
+        slot.epoch.store(m_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       End a read section started with enter() on the same thread.
+ *************************************************************************************************/
+inline void
+epoch_domain::leave() noexcept
+{
+    reader_slot& slot = *registration().slot;
+    if(--slot.depth == 0)
+    {
+        slot.epoch.store(idle_epoch, std::memory_order_release);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the domain to a new epoch.
+ *              Called by a writer right after unlinking an object.
+ *
+ * \retval      EpochType: The epoch the object was unlinked in. It can be reclaimed once
+ *                         oldest_active() is greater than this value.
+ *************************************************************************************************/
+[[nodiscard]] inline epoch_domain::EpochType
+epoch_domain::advance() noexcept
+{
+    return m_epoch.fetch_add(1, std::memory_order_seq_cst);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the oldest epoch announced by a thread currently in a read section.
+ *
+ * \retval      EpochType: Oldest active epoch, or the maximum value if no thread is reading.
+ *************************************************************************************************/
+[[nodiscard]] inline epoch_domain::EpochType
+epoch_domain::oldest_active() const noexcept
+{
+    EpochType oldest = std::numeric_limits<EpochType>::max();
+    const slot_block* block = &m_firstBlock;
+    while(block != nullptr)
+    {
+        for(const reader_slot& slot : block->slots)
+        {
+            const EpochType epoch = slot.epoch.load(std::memory_order_seq_cst);
+            if(epoch != idle_epoch && epoch < oldest)
+            {
+                oldest = epoch;
+            }
+        }
+        block = block->next.load(std::memory_order_acquire);
+    }
+    return oldest;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the slot of the calling thread, claiming a free one on first use.
+ *              The slot is handed back when the thread exits.
+ *
+ * \throws      std::bad_alloc
+ *              If every slot is taken and a new block could not be allocated.
+ *************************************************************************************************/
+[[nodiscard]] inline epoch_domain::reader_slot&
+epoch_domain::local_slot()
+{
+    thread_registration& local = registration();
+    if(local.slot != nullptr)
+    {
+        return *local.slot;
+    }
+
+    slot_block* block = &m_firstBlock;
+    for(;;)
+    {
+        for(reader_slot& slot : block->slots)
+        {
+            bool isOwned = false;
+            if(slot.isOwned.load(std::memory_order_relaxed) == false
+               && slot.isOwned.compare_exchange_strong(isOwned, true, std::memory_order_acquire))
+            {
+                local.slot = &slot;
+                return slot;
+            }
+        }
+
+        slot_block* next = block->next.load(std::memory_order_acquire);
+        block            = next != nullptr ? next : append_block(*block);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Chain a new block of slots after the last one.
+ *              Threads racing to append each allocate a block; the losers free theirs and carry
+ *              on with the winner's.
+ *
+ * \param       last_: Block whose successor is missing.
+ *
+ * \retval      slot_block*: Block now following last_.
+ *
+ * \throws      std::bad_alloc
+ *************************************************************************************************/
+[[nodiscard]] inline epoch_domain::slot_block*
+epoch_domain::append_block(slot_block& last_)
+{
+    slot_block* newBlock = new slot_block{};
+    slot_block* expected = nullptr;
+    if(last_.next.compare_exchange_strong(expected, newBlock, std::memory_order_acq_rel))
+    {
+        return newBlock;
+    }
+
+    delete newBlock;
+    return expected;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the calling thread's registration with the global domain.
+ *************************************************************************************************/
+[[nodiscard]] inline epoch_domain::thread_registration&
+epoch_domain::registration() noexcept
+{
+    static thread_local thread_registration local;
+    return local;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Hand the thread's slot back to the domain when the thread exits.
+ *************************************************************************************************/
+inline epoch_domain::thread_registration::~thread_registration()
+{
+    if(slot != nullptr)
+    {
+        slot->epoch.store(idle_epoch, std::memory_order_release);
+        slot->isOwned.store(false, std::memory_order_release);
+    }
+}
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
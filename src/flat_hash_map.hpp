@@ -0,0 +1,125 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./flat_hash_table.hpp"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Describes how a flat_hash_map stores its entries: key and mapped value side by
+ *              side in each slot.
+ */
+template<typename MapKeyType, typename MapMappedType>
+struct flat_hash_map_policy
+{
+    using KeyType   = MapKeyType;
+    using ValueType = std::pair<const MapKeyType, MapMappedType>;
+
+    constexpr static const bool constant_iterators = false;
+
+    [[nodiscard]] constexpr static const KeyType& key_of(const ValueType& value_) noexcept
+    {
+        return value_.first;
+    }
+};
+
+
+/**
+ * \brief       Map of unique keys to values, stored in a single open-addressing slot array.
+ *              See flat_hash_table for the layout and probing scheme.
+ */
+template<typename KeyType,
+         typename MappedType,
+         typename HashType      = std::hash<KeyType>,
+         typename KeyEqualType  = std::equal_to<KeyType>,
+         typename AllocatorType = std::allocator<std::pair<const KeyType, MappedType>>>
+class flat_hash_map : public flat_hash_table<flat_hash_map_policy<KeyType, MappedType>,
+                                             HashType,
+                                             KeyEqualType,
+                                             AllocatorType>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using BaseType     = flat_hash_table<flat_hash_map_policy<KeyType, MappedType>,
+                                     HashType,
+                                     KeyEqualType,
+                                     AllocatorType>;
+    using IteratorType = typename BaseType::IteratorType;
+
+    template<typename LookupType>
+    using KeyArgType = typename BaseType::template KeyArgType<LookupType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    using BaseType::BaseType;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    template<typename LookupType = KeyType>
+    [[nodiscard]] MappedType& at(const KeyArgType<LookupType>& key_);
+    template<typename LookupType = KeyType>
+    [[nodiscard]] const MappedType& at(const KeyArgType<LookupType>& key_) const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    MappedType& operator[](const KeyType& key_);
+    MappedType& operator[](KeyType&& key_);
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    template<typename... Args>
+    std::pair<IteratorType, bool> try_emplace(const KeyType& key_, Args&&... args_);
+    template<typename... Args>
+    std::pair<IteratorType, bool> try_emplace(KeyType&& key_, Args&&... args_);
+
+    template<typename ObjectType>
+    std::pair<IteratorType, bool> insert_or_assign(const KeyType& key_, ObjectType&& object_);
+    template<typename ObjectType>
+    std::pair<IteratorType, bool> insert_or_assign(KeyType&& key_, ObjectType&& object_);
+};
+
+
+}        // namespace pel
+
+#include "./flat_hash_map.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,81 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./flat_hash_table.hpp"
+
+#include <functional>
+#include <memory>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Describes how a flat_hash_set stores its keys: the key is the whole value.
+ */
+template<typename SetKeyType>
+struct flat_hash_set_policy
+{
+    using KeyType   = SetKeyType;
+    using ValueType = SetKeyType;
+
+    constexpr static const bool constant_iterators = true;
+
+    [[nodiscard]] constexpr static const KeyType& key_of(const ValueType& value_) noexcept
+    {
+        return value_;
+    }
+};
+
+
+/**
+ * \brief       Set of unique keys stored in a single open-addressing slot array.
+ *              See flat_hash_table for the layout and probing scheme. Iterators only give const
+ *              access, since modifying a key in place would break the table.
+ */
+template<typename KeyType,
+         typename HashType      = std::hash<KeyType>,
+         typename KeyEqualType  = std::equal_to<KeyType>,
+         typename AllocatorType = std::allocator<KeyType>>
+class flat_hash_set
+: public flat_hash_table<flat_hash_set_policy<KeyType>, HashType, KeyEqualType, AllocatorType>
+{
+public:
+    using BaseType =
+      flat_hash_table<flat_hash_set_policy<KeyType>, HashType, KeyEqualType, AllocatorType>;
+
+    using BaseType::BaseType;
+};
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
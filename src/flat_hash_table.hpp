@@ -0,0 +1,329 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+#include "./transparent_key.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace pel
+{
+/**
+ * \brief       View over a group of control bytes of a flat_hash_table, matched all at once.
+ *
+ *              Every slot of a table has one control byte: empty, deleted, the end-of-table
+ *              sentinel, or, for a full slot, the 7 low bits of its hash. A lookup compares the
+ *              control bytes of a whole group against those 7 bits in a couple of SSE2
+ *              instructions (or a plain loop without SSE2) and only compares keys on a match.
+ */
+class flat_hash_group
+{
+public:
+    using ControlType = std::int8_t;
+    using MaskType    = std::uint32_t;
+
+    constexpr static const std::size_t width = 16;
+
+    constexpr static const ControlType empty_control    = -128;
+    constexpr static const ControlType deleted_control  = -2;
+    constexpr static const ControlType sentinel_control = -1;
+
+    explicit flat_hash_group(const ControlType* position_) noexcept;
+
+    [[nodiscard]] MaskType    match(ControlType hash_) const noexcept;
+    [[nodiscard]] MaskType    match_empty() const noexcept;
+    [[nodiscard]] MaskType    match_empty_or_deleted() const noexcept;
+    [[nodiscard]] std::size_t count_leading_empty_or_deleted() const noexcept;
+
+    [[nodiscard]] constexpr static bool is_full(ControlType control_) noexcept
+    {
+        return control_ >= 0;
+    }
+
+private:
+#if PEL_HAS_SSE2
+    __m128i m_control;
+#else
+    std::array<ControlType, width> m_control;
+#endif
+};
+
+
+/**
+ * \brief       Forward iterator over the full slots of a flat_hash_table.
+ *              Skips a whole group of empty slots at a time; the sentinel control byte stops it
+ *              at the end of the table.
+ */
+template<typename TableValueType, bool IsConst>
+class flat_hash_iterator
+{
+    template<typename, bool>
+    friend class flat_hash_iterator;
+    template<typename, typename, typename, typename>
+    friend class flat_hash_table;
+
+public:
+    using ControlType = flat_hash_group::ControlType;
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = TableValueType;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    constexpr flat_hash_iterator() noexcept = default;
+    flat_hash_iterator(const ControlType* control_, value_type* slot_) noexcept;
+
+    template<bool OtherIsConst>
+        requires(IsConst && OtherIsConst == false)
+    flat_hash_iterator(const flat_hash_iterator<TableValueType, OtherIsConst>& other_) noexcept;
+
+    [[nodiscard]] reference operator*() const noexcept;
+    [[nodiscard]] pointer   operator->() const noexcept;
+
+    flat_hash_iterator& operator++() noexcept;
+    flat_hash_iterator  operator++(int) noexcept;
+
+    [[nodiscard]] bool operator==(const flat_hash_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator!=(const flat_hash_iterator& rhs_) const noexcept;
+
+private:
+    void skip_empty_or_deleted() noexcept;
+
+    const ControlType* m_control = nullptr;
+    value_type*        m_slot    = nullptr;
+};
+
+
+/**
+ * \brief       Open-addressing hash table storing its elements in one contiguous slot array.
+ *
+ *              Shared implementation of flat_hash_map and flat_hash_set. The table has
+ *              2^n - 1 slots and as many control bytes, followed by a sentinel and a copy of the
+ *              first group of control bytes so that a group can be loaded at any slot without
+ *              wrapping around. Lookups probe group by group (triangular probing), so a miss
+ *              usually costs a single group comparison and no key comparison at all.
+ *              Erasing only leaves a tombstone when the slot may be in the middle of a probe
+ *              sequence; otherwise the slot becomes empty again.
+ *
+ *              Lookups accept any type the hasher and the key comparator accept when both define
+ *              is_transparent.
+ *
+ *              PolicyType provides KeyType, ValueType, constant_iterators and
+ *              key_of(const ValueType&).
+ *
+ * \warning     Inserting may move every element: pointers, references and iterators are
+ *              invalidated by insertions (not by erasures).
+ */
+template<typename PolicyType, typename HashType, typename KeyEqualType, typename AllocatorType>
+class flat_hash_table
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using KeyType           = typename PolicyType::KeyType;
+    using ValueType         = typename PolicyType::ValueType;
+    using AllocatorTraits   = std::allocator_traits<AllocatorType>;
+    using SizeType          = std::size_t;
+    using DifferenceType    = std::ptrdiff_t;
+    using ControlType       = flat_hash_group::ControlType;
+    using ConstIteratorType = flat_hash_iterator<ValueType, true>;
+    using IteratorType      = flat_hash_iterator<ValueType, PolicyType::constant_iterators>;
+
+    constexpr static const bool is_transparent = requires {
+        typename HashType::is_transparent;
+        typename KeyEqualType::is_transparent;
+    };
+
+    /* Lookup argument: any type with transparent functors, KeyType otherwise */
+    template<typename LookupType>
+    using KeyArgType = transparent_key_t<is_transparent, LookupType, KeyType>;
+
+    constexpr static const SizeType group_width = flat_hash_group::width;
+
+    static_assert(std::is_same_v<ValueType, typename AllocatorType::value_type>,
+                  "Allocator must match value type");
+
+private:
+    using ControlAllocatorType = typename AllocatorTraits::template rebind_alloc<ControlType>;
+    using ControlTraits        = std::allocator_traits<ControlAllocatorType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit flat_hash_table(SizeType             bucketCount_ = 0,
+                             const HashType&      hash_        = HashType{},
+                             const KeyEqualType&  equal_       = KeyEqualType{},
+                             const AllocatorType& alloc_       = AllocatorType{});
+    flat_hash_table(std::initializer_list<ValueType> values_,
+                    SizeType                         bucketCount_ = 0,
+                    const HashType&                  hash_        = HashType{},
+                    const KeyEqualType&              equal_       = KeyEqualType{},
+                    const AllocatorType&             alloc_       = AllocatorType{});
+
+    flat_hash_table(const flat_hash_table& copy_);
+    flat_hash_table(flat_hash_table&& move_) noexcept;
+    flat_hash_table& operator=(const flat_hash_table& copy_);
+    flat_hash_table& operator=(flat_hash_table&& move_) noexcept;
+
+    ~flat_hash_table();
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType      begin() noexcept;
+    [[nodiscard]] IteratorType      end() noexcept;
+    [[nodiscard]] ConstIteratorType begin() const noexcept;
+    [[nodiscard]] ConstIteratorType end() const noexcept;
+    [[nodiscard]] ConstIteratorType cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType cend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Lookup ---------------------------------------------------------------------------------- */
+    template<typename LookupType = KeyType>
+    [[nodiscard]] IteratorType find(const KeyArgType<LookupType>& key_);
+    template<typename LookupType = KeyType>
+    [[nodiscard]] ConstIteratorType find(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] bool contains(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] SizeType count(const KeyArgType<LookupType>& key_) const;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    std::pair<IteratorType, bool> insert(const ValueType& value_);
+    std::pair<IteratorType, bool> insert(ValueType&& value_);
+    template<typename InputIterator>
+    void insert(InputIterator first_, InputIterator last_);
+    void insert(std::initializer_list<ValueType> values_);
+
+    template<typename... Args>
+    std::pair<IteratorType, bool> emplace(Args&&... args_);
+
+    template<typename LookupType = KeyType>
+    SizeType     erase(const KeyArgType<LookupType>& key_);
+    IteratorType erase(ConstIteratorType position_);
+    IteratorType erase(IteratorType position_)
+        requires(std::is_same_v<IteratorType, ConstIteratorType> == false);
+
+    void clear() noexcept;
+    void swap(flat_hash_table& other_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType length() const noexcept;
+    [[nodiscard]] bool     is_empty() const noexcept;
+    [[nodiscard]] bool     is_not_empty() const noexcept;
+    [[nodiscard]] SizeType capacity() const noexcept;
+    [[nodiscard]] float    load_factor() const noexcept;
+
+    void reserve(SizeType count_);
+    void rehash(SizeType bucketCount_);
+
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+    [[nodiscard]] const HashType&      hash_function() const noexcept;
+    [[nodiscard]] const KeyEqualType&  key_eq() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] bool operator==(const flat_hash_table& rhs_) const;
+
+
+    /*********************************************************************************************/
+    /* Protected methods ----------------------------------------------------------------------- */
+protected:
+    template<typename LookupType, typename... Args>
+    std::pair<IteratorType, bool> emplace_key(const LookupType& key_, Args&&... args_);
+
+    template<typename LookupType>
+    [[nodiscard]] SizeType find_index(const LookupType& key_, SizeType hash_) const;
+
+    template<typename LookupType>
+    [[nodiscard]] SizeType hash_of(const LookupType& key_) const;
+
+    [[nodiscard]] IteratorType iterator_at(SizeType index_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] SizeType find_first_non_full(SizeType hash_) const noexcept;
+    [[nodiscard]] SizeType prepare_insert(SizeType hash_);
+    void                   commit_insert(SizeType index_, SizeType hash_) noexcept;
+    void                   erase_at(SizeType index_) noexcept;
+    void                   set_control(SizeType index_, ControlType control_) noexcept;
+
+    void grow();
+    void resize(SizeType newCapacity_);
+    void destroy_elements() noexcept;
+    void deallocate() noexcept;
+
+    [[nodiscard]] constexpr static SizeType    capacity_to_growth(SizeType capacity_) noexcept;
+    [[nodiscard]] constexpr static SizeType    required_capacity(SizeType count_) noexcept;
+    [[nodiscard]] constexpr static SizeType    probe_start(SizeType hash_) noexcept;
+    [[nodiscard]] constexpr static ControlType control_of(SizeType hash_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    ControlType* m_control    = nullptr;
+    ValueType*   m_slots      = nullptr;
+    SizeType     m_capacity   = 0;
+    SizeType     m_length     = 0;
+    SizeType     m_growthLeft = 0;
+
+    [[no_unique_address]] HashType      m_hash{};
+    [[no_unique_address]] KeyEqualType  m_equal{};
+    [[no_unique_address]] AllocatorType m_allocator{};
+};
+
+
+}        // namespace pel
+
+#include "./flat_hash_table.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,1204 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./flat_hash_table.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define FLAT_HASH_TABLE_TEMPLATE_DECLARATION__  typename PolicyType,                               \
+                                                typename HashType,                                 \
+                                                typename KeyEqualType,                             \
+                                                typename AllocatorType
+
+#define FLAT_HASH_TABLE_CLASS_SCOPE__           flat_hash_table<PolicyType,                        \
+                                                                HashType,                          \
+                                                                KeyEqualType,                      \
+                                                                AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* GROUP --------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Load the control bytes of the group starting at a slot.
+ *
+ * \param       position_: First control byte of the group. The following width - 1 bytes must be
+ *                         readable.
+ *************************************************************************************************/
+inline flat_hash_group::flat_hash_group(const ControlType* position_) noexcept
+{
+#if PEL_HAS_SSE2
+    m_control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position_));
+#else
+    std::copy_n(position_, width, m_control.begin());
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the slots of the group whose control byte is a given value.
+ *
+ * \param       hash_: Control byte to look for.
+ *
+ * \retval      MaskType: Bit i is set if slot i of the group matches.
+ *************************************************************************************************/
+[[nodiscard]] inline flat_hash_group::MaskType
+flat_hash_group::match(ControlType hash_) const noexcept
+{
+#if PEL_HAS_SSE2
+    return static_cast<MaskType>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash_), m_control)));
+#else
+    MaskType mask = 0;
+    for(std::size_t i = 0; i < width; ++i)
+    {
+        mask |= static_cast<MaskType>(m_control[i] == hash_) << i;
+    }
+    return mask;
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the empty slots of the group.
+ *************************************************************************************************/
+[[nodiscard]] inline flat_hash_group::MaskType
+flat_hash_group::match_empty() const noexcept
+{
+    return match(empty_control);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the slots of the group that can receive a new element.
+ *              Empty and deleted are the only control values below the sentinel.
+ *************************************************************************************************/
+[[nodiscard]] inline flat_hash_group::MaskType
+flat_hash_group::match_empty_or_deleted() const noexcept
+{
+#if PEL_HAS_SSE2
+    return static_cast<MaskType>(
+      _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(sentinel_control), m_control)));
+#else
+    MaskType mask = 0;
+    for(std::size_t i = 0; i < width; ++i)
+    {
+        mask |= static_cast<MaskType>(m_control[i] < sentinel_control) << i;
+    }
+    return mask;
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Count the empty or deleted slots at the start of the group.
+ *************************************************************************************************/
+[[nodiscard]] inline std::size_t
+flat_hash_group::count_leading_empty_or_deleted() const noexcept
+{
+    return static_cast<std::size_t>(std::countr_one(match_empty_or_deleted()));
+}
+
+
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+template<typename TableValueType, bool IsConst>
+inline flat_hash_iterator<TableValueType, IsConst>::flat_hash_iterator(const ControlType* control_,
+                                                                      value_type* slot_) noexcept
+: m_control{control_}, m_slot{slot_}
+{
+}
+
+template<typename TableValueType, bool IsConst>
+template<bool OtherIsConst>
+    requires(IsConst && OtherIsConst == false)
+inline flat_hash_iterator<TableValueType, IsConst>::flat_hash_iterator(
+  const flat_hash_iterator<TableValueType, OtherIsConst>& other_) noexcept
+: m_control{other_.m_control}, m_slot{other_.m_slot}
+{
+}
+
+template<typename TableValueType, bool IsConst>
+[[nodiscard]] inline typename flat_hash_iterator<TableValueType, IsConst>::reference
+flat_hash_iterator<TableValueType, IsConst>::operator*() const noexcept
+{
+    return *m_slot;
+}
+
+template<typename TableValueType, bool IsConst>
+[[nodiscard]] inline typename flat_hash_iterator<TableValueType, IsConst>::pointer
+flat_hash_iterator<TableValueType, IsConst>::operator->() const noexcept
+{
+    return m_slot;
+}
+
+template<typename TableValueType, bool IsConst>
+inline flat_hash_iterator<TableValueType, IsConst>&
+flat_hash_iterator<TableValueType, IsConst>::operator++() noexcept
+{
+    ++m_control;
+    ++m_slot;
+    skip_empty_or_deleted();
+    return *this;
+}
+
+template<typename TableValueType, bool IsConst>
+inline flat_hash_iterator<TableValueType, IsConst>
+flat_hash_iterator<TableValueType, IsConst>::operator++(int) noexcept
+{
+    flat_hash_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template<typename TableValueType, bool IsConst>
+[[nodiscard]] inline bool
+flat_hash_iterator<TableValueType, IsConst>::operator==(
+  const flat_hash_iterator& rhs_) const noexcept
+{
+    return m_control == rhs_.m_control;
+}
+
+template<typename TableValueType, bool IsConst>
+[[nodiscard]] inline bool
+flat_hash_iterator<TableValueType, IsConst>::operator!=(
+  const flat_hash_iterator& rhs_) const noexcept
+{
+    return m_control != rhs_.m_control;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Move forward until a full slot or the sentinel, a group at a time.
+ *************************************************************************************************/
+template<typename TableValueType, bool IsConst>
+inline void
+flat_hash_iterator<TableValueType, IsConst>::skip_empty_or_deleted() noexcept
+{
+    while(*m_control < flat_hash_group::sentinel_control)
+    {
+        const std::size_t skipped =
+          flat_hash_group(m_control).count_leading_empty_or_deleted();
+        m_control += skipped;
+        m_slot += skipped;
+    }
+}
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty table.
+ *
+ * \param       bucketCount_: Minimum number of slots to allocate up front. Nothing is allocated
+ *                            if 0.
+ * \param       hash_:        Hasher.
+ * \param       equal_:       Key comparator.
+ * \param       alloc_:       Allocator used for the slots; rebound for the control bytes.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_HASH_TABLE_CLASS_SCOPE__::flat_hash_table(SizeType             bucketCount_,
+                                                      const HashType&      hash_,
+                                                      const KeyEqualType&  equal_,
+                                                      const AllocatorType& alloc_)
+: m_hash{hash_}, m_equal{equal_}, m_allocator{alloc_}
+{
+    if(bucketCount_ != 0)
+    {
+        rehash(bucketCount_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a table holding the values of a list. Later duplicates are ignored.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_HASH_TABLE_CLASS_SCOPE__::flat_hash_table(std::initializer_list<ValueType> values_,
+                                                      SizeType             bucketCount_,
+                                                      const HashType&      hash_,
+                                                      const KeyEqualType&  equal_,
+                                                      const AllocatorType& alloc_)
+: flat_hash_table(std::max(bucketCount_, values_.size()), hash_, equal_, alloc_)
+{
+    insert(values_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every element of another table.
+ *              Keys are known to be unique, so elements are placed without any key comparison.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_HASH_TABLE_CLASS_SCOPE__::flat_hash_table(const flat_hash_table& copy_)
+: m_hash{copy_.m_hash},
+  m_equal{copy_.m_equal},
+  m_allocator{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)}
+{
+    reserve(copy_.m_length);
+
+    try
+    {
+        for(const ValueType& value : copy_)
+        {
+            const SizeType hash  = hash_of(PolicyType::key_of(value));
+            const SizeType index = find_first_non_full(hash);
+            AllocatorTraits::construct(m_allocator, m_slots + index, value);
+            commit_insert(index, hash);
+        }
+    }
+    catch(...)
+    {
+        destroy_elements();
+        deallocate();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the slots of another table, leaving it empty.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_HASH_TABLE_CLASS_SCOPE__::flat_hash_table(flat_hash_table&& move_) noexcept
+: m_control{std::exchange(move_.m_control, nullptr)},
+  m_slots{std::exchange(move_.m_slots, nullptr)},
+  m_capacity{std::exchange(move_.m_capacity, 0)},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_growthLeft{std::exchange(move_.m_growthLeft, 0)},
+  m_hash{move_.m_hash},
+  m_equal{move_.m_equal},
+  m_allocator{move_.m_allocator}
+{
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_HASH_TABLE_CLASS_SCOPE__&
+FLAT_HASH_TABLE_CLASS_SCOPE__::operator=(const flat_hash_table& copy_)
+{
+    if(this != &copy_)
+    {
+        flat_hash_table copy(copy_);
+        swap(copy);
+    }
+    return *this;
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_HASH_TABLE_CLASS_SCOPE__&
+FLAT_HASH_TABLE_CLASS_SCOPE__::operator=(flat_hash_table&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        flat_hash_table moved(std::move(move_));
+        swap(moved);
+    }
+    return *this;
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_HASH_TABLE_CLASS_SCOPE__::~flat_hash_table()
+{
+    destroy_elements();
+    deallocate();
+}
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::begin() noexcept
+{
+    if(m_length == 0)
+    {
+        return end();
+    }
+
+    IteratorType iterator(m_control, m_slots);
+    iterator.skip_empty_or_deleted();
+    return iterator;
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::end() noexcept
+{
+    return IteratorType(m_control + m_capacity, m_slots + m_capacity);
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::ConstIteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::begin() const noexcept
+{
+    return const_cast<flat_hash_table*>(this)->begin();
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::ConstIteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::end() const noexcept
+{
+    return const_cast<flat_hash_table*>(this)->end();
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::ConstIteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::ConstIteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+
+/*************************************************************************************************/
+/* LOOKUP -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find the element with a given key.
+ *
+ * \param       key_: Key to look for, or any type usable by transparent functors.
+ *
+ * \retval      IteratorType: Iterator to the element, or end() if there is none.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::find(const KeyArgType<LookupType>& key_)
+{
+    return iterator_at(find_index(key_, hash_of(key_)));
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::ConstIteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::find(const KeyArgType<LookupType>& key_) const
+{
+    return const_cast<flat_hash_table*>(this)->iterator_at(find_index(key_, hash_of(key_)));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check if an element with a given key is in the table.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline bool
+FLAT_HASH_TABLE_CLASS_SCOPE__::contains(const KeyArgType<LookupType>& key_) const
+{
+    return find_index(key_, hash_of(key_)) != m_capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Count the elements with a given key: 0 or 1.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::count(const KeyArgType<LookupType>& key_) const
+{
+    return contains<LookupType>(key_) ? 1 : 0;
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copy a value into the table, unless an element with the same key is already there.
+ *
+ * \retval      std::pair<IteratorType, bool>: Iterator to the element with that key, and true if
+ *                                             the value was inserted.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline std::pair<typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType, bool>
+FLAT_HASH_TABLE_CLASS_SCOPE__::insert(const ValueType& value_)
+{
+    return emplace_key(PolicyType::key_of(value_), value_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move a value into the table, unless an element with the same key is already there.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline std::pair<typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType, bool>
+FLAT_HASH_TABLE_CLASS_SCOPE__::insert(ValueType&& value_)
+{
+    return emplace_key(PolicyType::key_of(value_), std::move(value_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Insert every value of a range whose key is not already in the table.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::insert(InputIterator first_, InputIterator last_)
+{
+    if constexpr(std::is_base_of_v<std::forward_iterator_tag,
+                                   typename std::iterator_traits<InputIterator>::iterator_category>)
+    {
+        reserve(m_length + static_cast<SizeType>(std::distance(first_, last_)));
+    }
+
+    for(; first_ != last_; ++first_)
+    {
+        emplace(*first_);
+    }
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::insert(std::initializer_list<ValueType> values_)
+{
+    insert(values_.begin(), values_.end());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct a value and insert it, unless an element with the same key is already
+ *              there.
+ *              The value is built before the lookup, since its key is only known then.
+ *
+ * \param       args_: Arguments forwarded to the value's constructor.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType, bool>
+FLAT_HASH_TABLE_CLASS_SCOPE__::emplace(Args&&... args_)
+{
+    ValueType value(std::forward<Args>(args_)...);
+    return emplace_key(PolicyType::key_of(value), std::move(value));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element with a given key.
+ *
+ * \retval      SizeType: Number of erased elements: 0 or 1.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::erase(const KeyArgType<LookupType>& key_)
+{
+    const SizeType index = find_index(key_, hash_of(key_));
+    if(index == m_capacity)
+    {
+        return 0;
+    }
+
+    erase_at(index);
+    return 1;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element an iterator points to.
+ *
+ * \param       position_: Valid, dereferenceable iterator of this table.
+ *
+ * \retval      IteratorType: Iterator to the next element.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::erase(ConstIteratorType position_)
+{
+    const SizeType index = static_cast<SizeType>(position_.m_control - m_control);
+    erase_at(index);
+
+    IteratorType next = iterator_at(index);
+    ++next;
+    return next;
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::erase(IteratorType position_)
+    requires(std::is_same_v<IteratorType, ConstIteratorType> == false)
+{
+    return erase(ConstIteratorType(position_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element. The slots stay allocated.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::clear() noexcept
+{
+    if(m_capacity == 0)
+    {
+        return;
+    }
+
+    destroy_elements();
+    std::fill_n(m_control, m_capacity + group_width, flat_hash_group::empty_control);
+    m_control[m_capacity] = flat_hash_group::sentinel_control;
+
+    m_length     = 0;
+    m_growthLeft = capacity_to_growth(m_capacity);
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::swap(flat_hash_table& other_) noexcept
+{
+    std::swap(m_control, other_.m_control);
+    std::swap(m_slots, other_.m_slots);
+    std::swap(m_capacity, other_.m_capacity);
+    std::swap(m_length, other_.m_length);
+    std::swap(m_growthLeft, other_.m_growthLeft);
+    std::swap(m_hash, other_.m_hash);
+    std::swap(m_equal, other_.m_equal);
+    std::swap(m_allocator, other_.m_allocator);
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+FLAT_HASH_TABLE_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+FLAT_HASH_TABLE_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_length != 0;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of slots. Up to 7/8 of them are used before
+ *              the table grows.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline float
+FLAT_HASH_TABLE_CLASS_SCOPE__::load_factor() const noexcept
+{
+    return m_capacity == 0 ? 0.0f : static_cast<float>(m_length) / static_cast<float>(m_capacity);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make room for a number of elements, so that inserting up to that many elements
+ *              never rehashes.
+ *
+ * \param       count_: Total number of elements to make room for.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::reserve(SizeType count_)
+{
+    if(count_ > m_length + m_growthLeft)
+    {
+        resize(required_capacity(count_));
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Rebuild the table with at least a given number of slots, dropping every tombstone.
+ *              The table never shrinks below what its elements require.
+ *
+ * \param       bucketCount_: Minimum number of slots. 0 frees the slots of an empty table.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::rehash(SizeType bucketCount_)
+{
+    if(bucketCount_ == 0 && m_length == 0)
+    {
+        deallocate();
+        return;
+    }
+
+    const SizeType wanted = bucketCount_ == 0 ? 0 : std::bit_ceil(bucketCount_ + 1) - 1;
+    resize(std::max({wanted, required_capacity(m_length), group_width - 1}));
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const AllocatorType&
+FLAT_HASH_TABLE_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const HashType&
+FLAT_HASH_TABLE_CLASS_SCOPE__::hash_function() const noexcept
+{
+    return m_hash;
+}
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const KeyEqualType&
+FLAT_HASH_TABLE_CLASS_SCOPE__::key_eq() const noexcept
+{
+    return m_equal;
+}
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Check if two tables hold equal elements, in any order.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+FLAT_HASH_TABLE_CLASS_SCOPE__::operator==(const flat_hash_table& rhs_) const
+{
+    if(m_length != rhs_.m_length)
+    {
+        return false;
+    }
+
+    for(const ValueType& value : *this)
+    {
+        const KeyType& key   = PolicyType::key_of(value);
+        const SizeType index = rhs_.find_index(key, rhs_.hash_of(key));
+        if(index == rhs_.m_capacity || (rhs_.m_slots[index] == value) == false)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*************************************************************************************************/
+/* PROTECTED METHODS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct a value from arguments if its key is not in the table yet.
+ *              Nothing is constructed if the key is found.
+ *
+ * \param       key_:  Key of the value the arguments build.
+ * \param       args_: Arguments forwarded to the value's constructor.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType, typename... Args>
+inline std::pair<typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType, bool>
+FLAT_HASH_TABLE_CLASS_SCOPE__::emplace_key(const LookupType& key_, Args&&... args_)
+{
+    const SizeType hash  = hash_of(key_);
+    SizeType       index = find_index(key_, hash);
+    if(index != m_capacity)
+    {
+        return {iterator_at(index), false};
+    }
+
+    index = prepare_insert(hash);
+    AllocatorTraits::construct(m_allocator, m_slots + index, std::forward<Args>(args_)...);
+    commit_insert(index, hash);
+    return {iterator_at(index), true};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Probe the table for a key.
+ *
+ * \param       key_:  Key to look for.
+ * \param       hash_: Mixed hash of the key, from hash_of().
+ *
+ * \retval      SizeType: Slot of the element, or capacity() if there is none.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::find_index(const LookupType& key_, SizeType hash_) const
+{
+    if(m_capacity == 0)
+    {
+        return m_capacity;
+    }
+
+    const ControlType control = control_of(hash_);
+    SizeType          offset  = probe_start(hash_) & m_capacity;
+    SizeType          step    = 0;
+
+    while(true)
+    {
+        const flat_hash_group group(m_control + offset);
+
+        for(flat_hash_group::MaskType match = group.match(control); match != 0;
+            match &= match - 1)
+        {
+            const SizeType index =
+              (offset + static_cast<SizeType>(std::countr_zero(match))) & m_capacity;
+            if(m_equal(PolicyType::key_of(m_slots[index]), key_))
+            {
+                return index;
+            }
+        }
+
+        if(group.match_empty() != 0)
+        {
+            return m_capacity;
+        }
+
+        step += group_width;
+        offset = (offset + step) & m_capacity;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Hash a key and mix the result, since common hashers (like std::hash for integers)
+ *              leave the low bits, used as control bytes, poorly distributed.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::hash_of(const LookupType& key_) const
+{
+    constexpr SizeType multiplier = static_cast<SizeType>(0x9E3779B97F4A7C15ULL);
+
+    const SizeType hash = m_hash(key_) * multiplier;
+    return hash ^ (hash >> (sizeof(SizeType) * 4));
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_HASH_TABLE_CLASS_SCOPE__::iterator_at(SizeType index_) noexcept
+{
+    return IteratorType(m_control + index_, m_slots + index_);
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first empty or deleted slot on the probe sequence of a hash.
+ *              The table must have slots.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::find_first_non_full(SizeType hash_) const noexcept
+{
+    SizeType offset = probe_start(hash_) & m_capacity;
+    SizeType step   = 0;
+
+    while(true)
+    {
+        const flat_hash_group::MaskType mask =
+          flat_hash_group(m_control + offset).match_empty_or_deleted();
+        if(mask != 0)
+        {
+            return (offset + static_cast<SizeType>(std::countr_zero(mask))) & m_capacity;
+        }
+
+        step += group_width;
+        offset = (offset + step) & m_capacity;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the slot a new element with a given hash goes into, growing the table if
+ *              needed. The slot is only marked full by commit_insert().
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::prepare_insert(SizeType hash_)
+{
+    if(m_capacity == 0)
+    {
+        grow();
+        return find_first_non_full(hash_);
+    }
+
+    const SizeType index = find_first_non_full(hash_);
+
+    /* Reusing a tombstone does not consume growth */
+    if(m_growthLeft == 0 && m_control[index] != flat_hash_group::deleted_control)
+    {
+        grow();
+        return find_first_non_full(hash_);
+    }
+    return index;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Mark a slot returned by prepare_insert() as full, once its element is constructed.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::commit_insert(SizeType index_, SizeType hash_) noexcept
+{
+    if(m_control[index_] == flat_hash_group::empty_control)
+    {
+        --m_growthLeft;
+    }
+    set_control(index_, control_of(hash_));
+    ++m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the element of a slot.
+ *              The slot goes back to empty if no group-wide probe window covering it has ever been
+ *              entirely full, since no probe sequence could then have gone past it. Otherwise it
+ *              becomes a tombstone so that lookups keep probing through it.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::erase_at(SizeType index_) noexcept
+{
+    AllocatorTraits::destroy(m_allocator, m_slots + index_);
+    --m_length;
+
+    const SizeType before = (index_ - group_width) & m_capacity;
+
+    const flat_hash_group::MaskType emptyAfter  = flat_hash_group(m_control + index_).match_empty();
+    const flat_hash_group::MaskType emptyBefore = flat_hash_group(m_control + before).match_empty();
+
+    const bool wasNeverFull =
+      emptyBefore != 0 && emptyAfter != 0
+      && static_cast<SizeType>(std::countr_zero(emptyAfter)
+                               + std::countl_zero(static_cast<std::uint16_t>(emptyBefore)))
+           < group_width;
+
+    if(wasNeverFull)
+    {
+        set_control(index_, flat_hash_group::empty_control);
+        ++m_growthLeft;
+    }
+    else
+    {
+        set_control(index_, flat_hash_group::deleted_control);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write the control byte of a slot, and its copy past the sentinel for the slots of
+ *              the first group.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::set_control(SizeType index_, ControlType control_) noexcept
+{
+    m_control[index_] = control_;
+    m_control[((index_ - (group_width - 1)) & m_capacity) + (group_width - 1)] = control_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make room for one more element.
+ *              A table mostly filled with tombstones is rebuilt at the same size instead of
+ *              doubling.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::grow()
+{
+    if(m_capacity == 0)
+    {
+        resize(group_width - 1);
+    }
+    else if(m_capacity > group_width && m_length * 32 <= m_capacity * 25)
+    {
+        resize(m_capacity);
+    }
+    else
+    {
+        resize(m_capacity * 2 + 1);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move every element into a new set of slots.
+ *              Elements are moved when that cannot throw and copied otherwise, as in
+ *              std::vector. The old elements are only destroyed once every one of them is in
+ *              place, so a throwing copy leaves the table as it was.
+ *
+ * \param       newCapacity_: Number of slots, of the form 2^n - 1 and at least group_width - 1.
+ *
+ * \note        If the hasher throws while elements are being moved, the table is restored but
+ *              the elements moved so far are left in their moved-from state.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::resize(SizeType newCapacity_)
+{
+    ControlAllocatorType controlAllocator(m_allocator);
+
+    ControlType* newControl = ControlTraits::allocate(controlAllocator, newCapacity_ + group_width);
+    ValueType*   newSlots   = nullptr;
+    try
+    {
+        newSlots = AllocatorTraits::allocate(m_allocator, newCapacity_);
+    }
+    catch(...)
+    {
+        ControlTraits::deallocate(controlAllocator, newControl, newCapacity_ + group_width);
+        throw;
+    }
+
+    std::fill_n(newControl, newCapacity_ + group_width, flat_hash_group::empty_control);
+    newControl[newCapacity_] = flat_hash_group::sentinel_control;
+
+    ControlType*   oldControl  = std::exchange(m_control, newControl);
+    ValueType*     oldSlots    = std::exchange(m_slots, newSlots);
+    const SizeType oldCapacity = std::exchange(m_capacity, newCapacity_);
+
+    try
+    {
+        for(SizeType i = 0; i < oldCapacity; ++i)
+        {
+            if(flat_hash_group::is_full(oldControl[i]))
+            {
+                const SizeType hash  = hash_of(PolicyType::key_of(oldSlots[i]));
+                const SizeType index = find_first_non_full(hash);
+
+                AllocatorTraits::construct(
+                  m_allocator, m_slots + index, std::move_if_noexcept(oldSlots[i]));
+                set_control(index, control_of(hash));
+            }
+        }
+    }
+    catch(...)
+    {
+        destroy_elements();
+        AllocatorTraits::deallocate(m_allocator, m_slots, m_capacity);
+        ControlTraits::deallocate(controlAllocator, m_control, m_capacity + group_width);
+
+        m_control  = oldControl;
+        m_slots    = oldSlots;
+        m_capacity = oldCapacity;
+        throw;
+    }
+    m_growthLeft = capacity_to_growth(m_capacity) - m_length;
+
+    if(oldCapacity != 0)
+    {
+        for(SizeType i = 0; i < oldCapacity; ++i)
+        {
+            if(flat_hash_group::is_full(oldControl[i]))
+            {
+                AllocatorTraits::destroy(m_allocator, oldSlots + i);
+            }
+        }
+        AllocatorTraits::deallocate(m_allocator, oldSlots, oldCapacity);
+        ControlTraits::deallocate(controlAllocator, oldControl, oldCapacity + group_width);
+    }
+}
+
+
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::destroy_elements() noexcept
+{
+    for(SizeType i = 0; i < m_capacity; ++i)
+    {
+        if(flat_hash_group::is_full(m_control[i]))
+        {
+            AllocatorTraits::destroy(m_allocator, m_slots + i);
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free the slots and control bytes. Elements must already be destroyed.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_HASH_TABLE_CLASS_SCOPE__::deallocate() noexcept
+{
+    if(m_capacity != 0)
+    {
+        ControlAllocatorType controlAllocator(m_allocator);
+        AllocatorTraits::deallocate(m_allocator, m_slots, m_capacity);
+        ControlTraits::deallocate(controlAllocator, m_control, m_capacity + group_width);
+    }
+
+    m_control    = nullptr;
+    m_slots      = nullptr;
+    m_capacity   = 0;
+    m_length     = 0;
+    m_growthLeft = 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements a table with a given number of slots holds before growing.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::capacity_to_growth(SizeType capacity_) noexcept
+{
+    return capacity_ - capacity_ / 8;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Smallest valid number of slots that holds a number of elements without growing.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::required_capacity(SizeType count_) noexcept
+{
+    SizeType capacity = group_width - 1;
+    while(capacity_to_growth(capacity) < count_)
+    {
+        capacity = capacity * 2 + 1;
+    }
+    return capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       First slot probed for a hash: its bits above the control byte.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::SizeType
+FLAT_HASH_TABLE_CLASS_SCOPE__::probe_start(SizeType hash_) noexcept
+{
+    return hash_ >> 7;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Control byte of a full slot holding an element with a given hash: its low 7 bits.
+ *************************************************************************************************/
+template<FLAT_HASH_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename FLAT_HASH_TABLE_CLASS_SCOPE__::ControlType
+FLAT_HASH_TABLE_CLASS_SCOPE__::control_of(SizeType hash_) noexcept
+{
+    return static_cast<ControlType>(hash_ & 0x7F);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef FLAT_HASH_TABLE_TEMPLATE_DECLARATION__
+#undef FLAT_HASH_TABLE_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
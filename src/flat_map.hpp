@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./flat_sorted_table.hpp"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Describes how a flat_map stores its entries: key and mapped value side by side.
+ */
+template<typename MapKeyType, typename MapMappedType>
+struct flat_map_policy
+{
+    using KeyType   = MapKeyType;
+    using ValueType = std::pair<MapKeyType, MapMappedType>;
+
+    [[nodiscard]] constexpr static const KeyType& key_of(const ValueType& value_) noexcept
+    {
+        return value_.first;
+    }
+};
+
+
+/**
+ * \brief       Map of unique keys to values kept sorted by key in one contiguous buffer, for
+ *              read-mostly lookup tables. See flat_sorted_table for the search layouts.
+ *
+ *              As in every container_base, operator[] and at() are positional: they access the
+ *              n-th entry in key order. Key lookups go through find(), at_key(), try_emplace()
+ *              and insert_or_assign().
+ */
+template<typename KeyType,
+         typename MappedType,
+         typename CompareType   = std::less<KeyType>,
+         typename AllocatorType = std::allocator<std::pair<KeyType, MappedType>>,
+         flat_layout Layout     = flat_layout::sorted>
+class flat_map : public flat_sorted_table<flat_map_policy<KeyType, MappedType>,
+                                          CompareType,
+                                          AllocatorType,
+                                          Layout>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using BaseType     = flat_sorted_table<flat_map_policy<KeyType, MappedType>,
+                                       CompareType,
+                                       AllocatorType,
+                                       Layout>;
+    using IteratorType = typename BaseType::IteratorType;
+
+    template<typename LookupType>
+    using KeyArgType = typename BaseType::template KeyArgType<LookupType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+    using BaseType::BaseType;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    template<typename LookupType = KeyType>
+    [[nodiscard]] MappedType& at_key(const KeyArgType<LookupType>& key_);
+    template<typename LookupType = KeyType>
+    [[nodiscard]] const MappedType& at_key(const KeyArgType<LookupType>& key_) const;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    template<typename... Args>
+    std::pair<IteratorType, bool> try_emplace(const KeyType& key_, Args&&... args_);
+    template<typename... Args>
+    std::pair<IteratorType, bool> try_emplace(KeyType&& key_, Args&&... args_);
+
+    template<typename ObjectType>
+    std::pair<IteratorType, bool> insert_or_assign(const KeyType& key_, ObjectType&& object_);
+    template<typename ObjectType>
+    std::pair<IteratorType, bool> insert_or_assign(KeyType&& key_, ObjectType&& object_);
+};
+
+
+}        // namespace pel
+
+#include "./flat_map.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
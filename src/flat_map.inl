@@ -0,0 +1,187 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./flat_map.hpp"
+
+#include <stdexcept>
+#include <tuple>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define FLAT_MAP_TEMPLATE_DECLARATION__         typename KeyType,                                  \
+                                                typename MappedType,                               \
+                                                typename CompareType,                              \
+                                                typename AllocatorType,                            \
+                                                flat_layout Layout
+
+#define FLAT_MAP_CLASS_SCOPE__                  flat_map<KeyType,                                  \
+                                                         MappedType,                               \
+                                                         CompareType,                              \
+                                                         AllocatorType,                            \
+                                                         Layout>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the value mapped to a key.
+ *
+ * \param       key_: Key to look for, or any type usable by a transparent comparator.
+ *
+ * \throws      std::out_of_range("Key not found")
+ *************************************************************************************************/
+template<FLAT_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline MappedType&
+FLAT_MAP_CLASS_SCOPE__::at_key(const KeyArgType<LookupType>& key_)
+{
+    IteratorType iterator = this->template find<LookupType>(key_);
+    if(iterator == this->end())
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return iterator->second;
+}
+
+template<FLAT_MAP_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline const MappedType&
+FLAT_MAP_CLASS_SCOPE__::at_key(const KeyArgType<LookupType>& key_) const
+{
+    const IteratorType iterator = this->template find<LookupType>(key_);
+    if(iterator == this->end())
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return iterator->second;
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct the value mapped to a key, only if the key is not in the map yet.
+ *              Nothing is constructed (nor moved from) when the key is found.
+ *
+ * \param       key_:  Key of the new entry.
+ * \param       args_: Arguments forwarded to the mapped value's constructor.
+ *
+ * \retval      std::pair<IteratorType, bool>: Iterator to the entry with that key, and true if it
+ *                                             was inserted.
+ *************************************************************************************************/
+template<FLAT_MAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename FLAT_MAP_CLASS_SCOPE__::IteratorType, bool>
+FLAT_MAP_CLASS_SCOPE__::try_emplace(const KeyType& key_, Args&&... args_)
+{
+    const std::size_t index = this->lower_bound_index(key_);
+    if(this->is_match(index, key_))
+    {
+        return {this->iterator_at(static_cast<std::ptrdiff_t>(index)), false};
+    }
+
+    return {this->insert_at(index,
+                            std::piecewise_construct,
+                            std::forward_as_tuple(key_),
+                            std::forward_as_tuple(std::forward<Args>(args_)...)),
+            true};
+}
+
+template<FLAT_MAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename FLAT_MAP_CLASS_SCOPE__::IteratorType, bool>
+FLAT_MAP_CLASS_SCOPE__::try_emplace(KeyType&& key_, Args&&... args_)
+{
+    const std::size_t index = this->lower_bound_index(key_);
+    if(this->is_match(index, key_))
+    {
+        return {this->iterator_at(static_cast<std::ptrdiff_t>(index)), false};
+    }
+
+    return {this->insert_at(index,
+                            std::piecewise_construct,
+                            std::forward_as_tuple(std::move(key_)),
+                            std::forward_as_tuple(std::forward<Args>(args_)...)),
+            true};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Map a key to a value, replacing the value currently mapped to it if any.
+ *
+ * \retval      std::pair<IteratorType, bool>: Iterator to the entry, and true if it was inserted
+ *                                             rather than assigned.
+ *************************************************************************************************/
+template<FLAT_MAP_TEMPLATE_DECLARATION__>
+template<typename ObjectType>
+inline std::pair<typename FLAT_MAP_CLASS_SCOPE__::IteratorType, bool>
+FLAT_MAP_CLASS_SCOPE__::insert_or_assign(const KeyType& key_, ObjectType&& object_)
+{
+    std::pair<IteratorType, bool> result = try_emplace(key_, std::forward<ObjectType>(object_));
+    if(result.second == false)
+    {
+        result.first->second = std::forward<ObjectType>(object_);
+    }
+    return result;
+}
+
+template<FLAT_MAP_TEMPLATE_DECLARATION__>
+template<typename ObjectType>
+inline std::pair<typename FLAT_MAP_CLASS_SCOPE__::IteratorType, bool>
+FLAT_MAP_CLASS_SCOPE__::insert_or_assign(KeyType&& key_, ObjectType&& object_)
+{
+    std::pair<IteratorType, bool> result =
+      try_emplace(std::move(key_), std::forward<ObjectType>(object_));
+    if(result.second == false)
+    {
+        result.first->second = std::forward<ObjectType>(object_);
+    }
+    return result;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef FLAT_MAP_TEMPLATE_DECLARATION__
+#undef FLAT_MAP_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
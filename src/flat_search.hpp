@@ -0,0 +1,229 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Memory layout used by the sorted flat containers to answer lookups.
+ */
+enum class flat_layout
+{
+    /* Branchless binary search directly over the sorted elements. Best while the table fits in
+     * the cache. */
+    sorted,
+
+    /* Keys are also copied in breadth-first (Eytzinger) order, so that the next levels of the
+     * search sit in a few cache lines that can be prefetched early. Meant for tables much larger
+     * than the cache, although the sorted layout's own prefetching often keeps up: measure with
+     * benchFlatSortedTable before choosing it. */
+    eytzinger,
+};
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first element of a partitioned range for which a predicate is false,
+ *              without any data-dependent branch.
+ *              Every iteration halves the range with a conditional move, and prefetches both
+ *              halves the next iteration could look at.
+ *
+ * \param       first_:     Pointer to the first element.
+ * \param       count_:     Number of elements.
+ * \param       predicate_: Callable taking an element; true for a prefix of the range only.
+ *
+ * \retval      std::size_t: Index of the first element for which predicate_ is false, or count_.
+ *************************************************************************************************/
+template<typename ItemType, typename PredicateType>
+[[nodiscard]] inline std::size_t
+branchless_partition_point(const ItemType* first_, std::size_t count_, PredicateType&& predicate_)
+{
+    if(count_ == 0)
+    {
+        return 0;
+    }
+
+    const ItemType* base = first_;
+    while(count_ > 1)
+    {
+        const std::size_t half = count_ / 2;
+        prefetch(base + half / 2);
+        prefetch(base + half + half / 2);
+
+        base = predicate_(base[half]) ? base + half : base;
+        count_ -= half;
+    }
+    return static_cast<std::size_t>(base - first_) + (predicate_(*base) ? 1 : 0);
+}
+
+
+/**
+ * \brief       Copy of a sorted range of keys in Eytzinger (breadth-first) order.
+ *
+ *              Node k has its children at 2k and 2k + 1, so the top levels of every search share
+ *              the same few cache lines and the nodes visited a few levels down are contiguous:
+ *              the search prefetches the cache line holding the great-grandchildren of the current
+ *              node while comparing it.
+ */
+template<typename KeyType, typename AllocatorType = std::allocator<KeyType>>
+class eytzinger_index
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType = std::size_t;
+
+private:
+    using AllocatorTraits   = std::allocator_traits<AllocatorType>;
+    using KeyAllocatorType  = typename AllocatorTraits::template rebind_alloc<KeyType>;
+    using RankAllocatorType = typename AllocatorTraits::template rebind_alloc<SizeType>;
+
+    constexpr static const SizeType keys_per_line =
+      sizeof(KeyType) >= cache_line_size ? 1 : cache_line_size / sizeof(KeyType);
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit eytzinger_index(const AllocatorType& alloc_ = AllocatorType{})
+    : m_keys(KeyAllocatorType(alloc_)), m_ranks(RankAllocatorType(alloc_))
+    {
+    }
+
+
+    /*********************************************************************************************/
+    /* Methods --------------------------------------------------------------------------------- */
+
+    /**
+     **********************************************************************************************
+     * \brief   Rebuild the index from a sorted range.
+     *
+     * \param   first_: Pointer to the first element of the range.
+     * \param   count_: Number of elements.
+     * \param   keyOf_: Callable returning the key of an element.
+     **********************************************************************************************/
+    template<typename ItemType, typename KeyOfType>
+    void rebuild(const ItemType* first_, SizeType count_, KeyOfType&& keyOf_)
+    {
+        m_keys.clear();
+        m_ranks.clear();
+        if(count_ == 0)
+        {
+            return;
+        }
+
+        /* Slot 0 is unused so that children of node k are 2k and 2k + 1 */
+        m_keys.resize(count_ + 1, keyOf_(first_[0]));
+        m_ranks.resize(count_ + 1, 0);
+
+        SizeType rank = 0;
+        fill(first_, keyOf_, rank, 1);
+    }
+
+    void clear() noexcept
+    {
+        m_keys.clear();
+        m_ranks.clear();
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Find the first key of the sorted range for which a predicate is false.
+     *
+     * \param   predicate_: Callable taking a key; true for a prefix of the sorted keys only.
+     *
+     * \retval  SizeType: Index, in the sorted range, of the first key for which predicate_ is
+     *                    false, or the number of keys.
+     **********************************************************************************************/
+    template<typename PredicateType>
+    [[nodiscard]] SizeType partition_point(PredicateType&& predicate_) const
+    {
+        if(m_keys.empty())
+        {
+            return 0;
+        }
+
+        const SizeType       count = m_keys.size() - 1;
+        const KeyType*       keys  = m_keys.data();
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(keys);
+
+        SizeType node = 1;
+        while(node <= count)
+        {
+            /* Near the leaves the great-grandchildren lie past the keys: prefetch() never faults,
+             * so the address is left unclamped rather than adding a compare to every level */
+            prefetch(reinterpret_cast<const void*>(base + node * keys_per_line * sizeof(KeyType)));
+            node = 2 * node + static_cast<SizeType>(predicate_(keys[node]));
+        }
+
+        /* Undo the right turns taken after the last left turn: that node is the answer */
+        node >>= std::countr_one(node) + 1;
+        return node == 0 ? count : m_ranks[node];
+    }
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    template<typename ItemType, typename KeyOfType>
+    void fill(const ItemType* first_, KeyOfType& keyOf_, SizeType& rank_, SizeType node_)
+    {
+        if(node_ < m_keys.size())
+        {
+            fill(first_, keyOf_, rank_, 2 * node_);
+            m_keys[node_]  = keyOf_(first_[rank_]);
+            m_ranks[node_] = rank_++;
+            fill(first_, keyOf_, rank_, 2 * node_ + 1);
+        }
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::vector<KeyType, KeyAllocatorType>   m_keys;
+    std::vector<SizeType, RankAllocatorType> m_ranks;
+};
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
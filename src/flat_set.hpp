@@ -0,0 +1,78 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./flat_sorted_table.hpp"
+
+#include <functional>
+#include <memory>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Describes how a flat_set stores its keys: the key is the whole value.
+ */
+template<typename SetKeyType>
+struct flat_set_policy
+{
+    using KeyType   = SetKeyType;
+    using ValueType = SetKeyType;
+
+    [[nodiscard]] constexpr static const KeyType& key_of(const ValueType& value_) noexcept
+    {
+        return value_;
+    }
+};
+
+
+/**
+ * \brief       Set of unique keys kept sorted in one contiguous buffer, for read-mostly lookup
+ *              tables. See flat_sorted_table for the search layouts.
+ */
+template<typename KeyType,
+         typename CompareType   = std::less<KeyType>,
+         typename AllocatorType = std::allocator<KeyType>,
+         flat_layout Layout     = flat_layout::sorted>
+class flat_set
+: public flat_sorted_table<flat_set_policy<KeyType>, CompareType, AllocatorType, Layout>
+{
+public:
+    using BaseType =
+      flat_sorted_table<flat_set_policy<KeyType>, CompareType, AllocatorType, Layout>;
+
+    using BaseType::BaseType;
+};
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,248 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+#include "./flat_search.hpp"
+#include "./transparent_key.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Unique keys kept sorted in one contiguous buffer.
+ *
+ *              Shared implementation of flat_map and flat_set. Elements are ordered by key in the
+ *              container_base range, so iteration and positional access (operator[], at, front,
+ *              back) follow key order. Lookups use a branchless binary search with the sorted
+ *              layout, or a separate Eytzinger-ordered copy of the keys with the eytzinger layout.
+ *              Inserting or erasing a single element shifts the elements after it, and marks the
+ *              Eytzinger index stale: the next lookup rebuilds it, so a run of single-element
+ *              changes costs one rebuild, and insertions and erasures search the sorted elements
+ *              in the meantime. Bulk insertion sorts and merges the whole batch at once.
+ *
+ *              Lookups accept any type the comparator accepts when it defines is_transparent.
+ *
+ *              PolicyType provides KeyType, ValueType and key_of(const ValueType&).
+ *
+ * \warning     Keys must not be modified through the positional accessors or iterators.
+ */
+template<typename PolicyType, typename CompareType, typename AllocatorType, flat_layout Layout>
+class flat_sorted_table
+: public container_base<typename PolicyType::ValueType,
+                        iterator_base<typename PolicyType::ValueType>,
+                        AllocatorType>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using KeyType         = typename PolicyType::KeyType;
+    using ValueType       = typename PolicyType::ValueType;
+    using IteratorType    = iterator_base<ValueType>;
+    using BaseType        = container_base<ValueType, IteratorType, AllocatorType>;
+    using AllocatorTraits = typename BaseType::AllocatorTraits;
+    using SizeType        = typename BaseType::SizeType;
+    using DifferenceType  = typename BaseType::DifferenceType;
+
+    constexpr static const bool is_transparent = requires {
+        typename CompareType::is_transparent;
+    };
+    constexpr static const flat_layout layout = Layout;
+
+    /* Lookup argument: any type with a transparent comparator, KeyType otherwise */
+    template<typename LookupType>
+    using KeyArgType = transparent_key_t<is_transparent, LookupType, KeyType>;
+
+private:
+    struct no_index
+    {
+        explicit no_index(const AllocatorType&) noexcept {}
+    };
+
+    using IndexType = std::conditional_t<Layout == flat_layout::eytzinger,
+                                         eytzinger_index<KeyType, AllocatorType>,
+                                         no_index>;
+
+    /* Whether the Eytzinger index lags behind the elements, and the lock taken by the lookup
+     * rebuilding it, so that concurrent lookups stay safe */
+    struct index_state
+    {
+        std::atomic<bool> isStale{false};
+        std::mutex        lock;
+
+        index_state() noexcept = default;
+        index_state(const index_state& other_) noexcept
+        : isStale{other_.isStale.load(std::memory_order_relaxed)}
+        {
+        }
+        index_state& operator=(const index_state& other_) noexcept
+        {
+            isStale.store(other_.isStale.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+            return *this;
+        }
+        ~index_state() = default;
+    };
+
+    struct no_index_state
+    {
+    };
+
+    using IndexStateType =
+      std::conditional_t<Layout == flat_layout::eytzinger, index_state, no_index_state>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit flat_sorted_table(const CompareType&   compare_ = CompareType{},
+                               const AllocatorType& alloc_   = AllocatorType{});
+    flat_sorted_table(std::initializer_list<ValueType> values_,
+                      const CompareType&               compare_ = CompareType{},
+                      const AllocatorType&             alloc_   = AllocatorType{});
+    template<typename InputIterator>
+    flat_sorted_table(InputIterator        first_,
+                      InputIterator        last_,
+                      const CompareType&   compare_ = CompareType{},
+                      const AllocatorType& alloc_   = AllocatorType{});
+
+    flat_sorted_table(const flat_sorted_table& copy_);
+    flat_sorted_table(flat_sorted_table&& move_) noexcept;
+    flat_sorted_table& operator=(const flat_sorted_table& copy_);
+    flat_sorted_table& operator=(flat_sorted_table&& move_) noexcept;
+
+    ~flat_sorted_table() override;
+
+
+    /*********************************************************************************************/
+    /* Lookup ---------------------------------------------------------------------------------- */
+    template<typename LookupType = KeyType>
+    [[nodiscard]] IteratorType find(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] bool contains(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] SizeType count(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] IteratorType lower_bound(const KeyArgType<LookupType>& key_) const;
+    template<typename LookupType = KeyType>
+    [[nodiscard]] IteratorType upper_bound(const KeyArgType<LookupType>& key_) const;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    std::pair<IteratorType, bool> insert(const ValueType& value_);
+    std::pair<IteratorType, bool> insert(ValueType&& value_);
+    template<typename InputIterator>
+    void insert(InputIterator first_, InputIterator last_);
+    void insert(std::initializer_list<ValueType> values_);
+
+    template<typename... Args>
+    std::pair<IteratorType, bool> emplace(Args&&... args_);
+
+    template<typename LookupType = KeyType>
+    SizeType     erase(const KeyArgType<LookupType>& key_);
+    IteratorType erase(IteratorType position_);
+
+    template<typename PredicateType>
+    SizeType erase_if(PredicateType predicate_);
+    template<std::ranges::forward_range IndexRange>
+    SizeType erase_indices(const IndexRange& indices_)
+        requires(std::convertible_to<std::ranges::range_reference_t<const IndexRange>, SizeType>);
+
+    void clear();
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType           capacity() const noexcept;
+    [[nodiscard]] const CompareType& key_comp() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const override;
+
+
+    /*********************************************************************************************/
+    /* Protected methods ----------------------------------------------------------------------- */
+protected:
+    template<typename LookupType>
+    [[nodiscard]] SizeType lower_bound_index(const LookupType& key_) const;
+
+    template<typename LookupType>
+    [[nodiscard]] bool is_match(SizeType index_, const LookupType& key_) const;
+
+    template<typename... Args>
+    IteratorType insert_at(SizeType index_, Args&&... args_);
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void reallocate(SizeType newCapacity_);
+    void release() noexcept;
+    void rebuild_index();
+    void invalidate_index() noexcept;
+    void refresh_index() const;
+    void sort_and_merge(SizeType sortedLength_);
+
+    [[nodiscard]] ValueType* data() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    SizeType m_capacity = 0;
+
+    [[no_unique_address]] CompareType            m_compare{};
+    [[no_unique_address]] mutable IndexType      m_index;
+    [[no_unique_address]] mutable IndexStateType m_indexState{};
+};
+
+
+}        // namespace pel
+
+#include "./flat_sorted_table.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
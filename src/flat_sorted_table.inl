@@ -0,0 +1,942 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./flat_sorted_table.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__ typename PolicyType,                              \
+                                                 typename CompareType,                             \
+                                                 typename AllocatorType,                           \
+                                                 flat_layout Layout
+
+#define FLAT_SORTED_TABLE_CLASS_SCOPE__          flat_sorted_table<PolicyType,                     \
+                                                                   CompareType,                    \
+                                                                   AllocatorType,                  \
+                                                                   Layout>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty table. Nothing is allocated.
+ *
+ * \param       compare_: Strict weak ordering of the keys.
+ * \param       alloc_:   Allocator used for the elements (and the Eytzinger index).
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__::flat_sorted_table(const CompareType&   compare_,
+                                                          const AllocatorType& alloc_)
+: BaseType{alloc_}, m_compare{compare_}, m_index{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a table from a list of values, sorted once.
+ *              Of values with equivalent keys, only the first one is kept.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__::flat_sorted_table(std::initializer_list<ValueType> values_,
+                                                          const CompareType&   compare_,
+                                                          const AllocatorType& alloc_)
+: flat_sorted_table(values_.begin(), values_.end(), compare_, alloc_)
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a table from a range of values, sorted once.
+ *              Of values with equivalent keys, only the first one is kept.
+ *
+ * \param       first_: Iterator to the first value.
+ * \param       last_:  Iterator past the last value.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__::flat_sorted_table(InputIterator        first_,
+                                                          InputIterator        last_,
+                                                          const CompareType&   compare_,
+                                                          const AllocatorType& alloc_)
+: flat_sorted_table(compare_, alloc_)
+{
+    /* The delegated constructor completed: the destructor cleans up if this throws */
+    insert(first_, last_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every element of another table, and build the Eytzinger index of the copy.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__::flat_sorted_table(const flat_sorted_table& copy_)
+: BaseType{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)},
+  m_compare{copy_.m_compare},
+  m_index{this->m_allocator}
+{
+    try
+    {
+        reserve(copy_.length());
+        for(const ValueType& value : copy_)
+        {
+            AllocatorTraits::construct(this->m_allocator, data() + this->length(), value);
+            this->add_size(1);
+        }
+        rebuild_index();
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the buffer of another table, leaving it empty.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__::flat_sorted_table(flat_sorted_table&& move_) noexcept
+: BaseType{move_.m_allocator},
+  m_capacity{std::exchange(move_.m_capacity, 0)},
+  m_compare{move_.m_compare},
+  m_index{std::move(move_.m_index)},
+  m_indexState{move_.m_indexState}
+{
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+}
+
+
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__&
+FLAT_SORTED_TABLE_CLASS_SCOPE__::operator=(const flat_sorted_table& copy_)
+{
+    if(this != &copy_)
+    {
+        flat_sorted_table copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__&
+FLAT_SORTED_TABLE_CLASS_SCOPE__::operator=(flat_sorted_table&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+
+        this->m_allocator     = move_.m_allocator;
+        m_capacity            = std::exchange(move_.m_capacity, 0);
+        m_compare             = move_.m_compare;
+        m_index               = std::move(move_.m_index);
+        m_indexState          = move_.m_indexState;
+        this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+        this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+    }
+    return *this;
+}
+
+
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline FLAT_SORTED_TABLE_CLASS_SCOPE__::~flat_sorted_table()
+{
+    release();
+}
+
+
+/*************************************************************************************************/
+/* LOOKUP -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find the element with a given key.
+ *
+ * \param       key_: Key to look for, or any type usable by a transparent comparator.
+ *
+ * \retval      IteratorType: Iterator to the element, or end() if there is none.
+ *
+ * \throws      std::bad_alloc
+ *              If the Eytzinger index is stale and rebuilding it fails. This goes for every
+ *              lookup.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::find(const KeyArgType<LookupType>& key_) const
+{
+    refresh_index();
+    const SizeType index = lower_bound_index(key_);
+    return is_match(index, key_) ? IteratorType(data() + index) : this->end();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check if an element with a given key is in the table.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline bool
+FLAT_SORTED_TABLE_CLASS_SCOPE__::contains(const KeyArgType<LookupType>& key_) const
+{
+    refresh_index();
+    return is_match(lower_bound_index(key_), key_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Count the elements with a given key: 0 or 1.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::SizeType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::count(const KeyArgType<LookupType>& key_) const
+{
+    return contains<LookupType>(key_) ? 1 : 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first element whose key is not ordered before a given key.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::lower_bound(const KeyArgType<LookupType>& key_) const
+{
+    refresh_index();
+    return IteratorType(data() + lower_bound_index(key_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first element whose key is ordered after a given key.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::upper_bound(const KeyArgType<LookupType>& key_) const
+{
+    refresh_index();
+    SizeType index = 0;
+    if constexpr(Layout == flat_layout::eytzinger)
+    {
+        index = m_index.partition_point([this, &key_](const KeyType& candidate_) {
+            return m_compare(key_, candidate_) == false;
+        });
+    }
+    else
+    {
+        index = branchless_partition_point(
+          data(), this->length(), [this, &key_](const ValueType& candidate_) {
+              return m_compare(key_, PolicyType::key_of(candidate_)) == false;
+          });
+    }
+    return IteratorType(data() + index);
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copy a value into the table, unless an element with an equivalent key is there.
+ *
+ * \retval      std::pair<IteratorType, bool>: Iterator to the element with that key, and true if
+ *                                             the value was inserted.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline std::pair<typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType, bool>
+FLAT_SORTED_TABLE_CLASS_SCOPE__::insert(const ValueType& value_)
+{
+    const SizeType index = lower_bound_index(PolicyType::key_of(value_));
+    if(is_match(index, PolicyType::key_of(value_)))
+    {
+        return {IteratorType(data() + index), false};
+    }
+    return {insert_at(index, value_), true};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move a value into the table, unless an element with an equivalent key is there.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline std::pair<typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType, bool>
+FLAT_SORTED_TABLE_CLASS_SCOPE__::insert(ValueType&& value_)
+{
+    const SizeType index = lower_bound_index(PolicyType::key_of(value_));
+    if(is_match(index, PolicyType::key_of(value_)))
+    {
+        return {IteratorType(data() + index), false};
+    }
+    return {insert_at(index, std::move(value_)), true};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Insert a batch of values.
+ *              The batch is appended, sorted and merged with the current elements in
+ *              O((n + m) log m), instead of shifting the elements once per value.
+ *              Of values with equivalent keys, the one already in the table, then the first one
+ *              of the batch, is kept.
+ *
+ * \param       first_: Iterator to the first value.
+ * \param       last_:  Iterator past the last value.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::insert(InputIterator first_, InputIterator last_)
+{
+    const SizeType sortedLength = this->length();
+
+    if constexpr(std::is_base_of_v<std::forward_iterator_tag,
+                                   typename std::iterator_traits<InputIterator>::iterator_category>)
+    {
+        reserve(sortedLength + static_cast<SizeType>(std::distance(first_, last_)));
+    }
+
+    try
+    {
+        for(; first_ != last_; ++first_)
+        {
+            if(this->length() == m_capacity)
+            {
+                reallocate(std::max<SizeType>(1, m_capacity * 2));
+            }
+            AllocatorTraits::construct(this->m_allocator, data() + this->length(), *first_);
+            this->add_size(1);
+        }
+    }
+    catch(...)
+    {
+        /* Keep the table sorted: drop the part of the batch already appended */
+        ValueType* items = data();
+        for(SizeType i = sortedLength; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items + i);
+        }
+        if(items != nullptr)
+        {
+            this->change_size(sortedLength);
+        }
+        throw;
+    }
+
+    sort_and_merge(sortedLength);
+}
+
+
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::insert(std::initializer_list<ValueType> values_)
+{
+    insert(values_.begin(), values_.end());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct a value and insert it, unless an element with an equivalent key is
+ *              there.
+ *
+ * \param       args_: Arguments forwarded to the value's constructor.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType, bool>
+FLAT_SORTED_TABLE_CLASS_SCOPE__::emplace(Args&&... args_)
+{
+    return insert(ValueType(std::forward<Args>(args_)...));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element with a given key.
+ *
+ * \retval      SizeType: Number of erased elements: 0 or 1.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::SizeType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::erase(const KeyArgType<LookupType>& key_)
+{
+    const SizeType index = lower_bound_index(key_);
+    if(is_match(index, key_) == false)
+    {
+        return 0;
+    }
+
+    erase(IteratorType(data() + index));
+    return 1;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element an iterator points to, shifting the following elements.
+ *
+ * \param       position_: Valid, dereferenceable iterator of this table.
+ *
+ * \retval      IteratorType: Iterator to the element that followed the erased one.
+ *
+ * \throws      std::invalid_argument("Invalid iterator")
+ *              If the iterator is not within the table, or is end().
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::erase(IteratorType position_)
+{
+    this->check_if_valid(position_);
+    if(position_ == this->cend())
+    {
+        throw std::invalid_argument("Invalid iterator");
+    }
+
+    ValueType*     items = data();
+    const SizeType index = static_cast<SizeType>(position_.ptr() - items);
+
+    std::move(items + index + 1, items + this->length(), items + index);
+    AllocatorTraits::destroy(this->m_allocator, items + this->length() - 1);
+    this->change_size(this->length() - 1);
+
+    invalidate_index();
+    return IteratorType(items + index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase every element for which a predicate returns true.
+ *              The remaining elements stay sorted; the Eytzinger index is rebuilt once.
+ *
+ * \param       predicate_: Called with a const reference to each element, returns true to erase.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename PredicateType>
+inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::SizeType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::erase_if(PredicateType predicate_)
+{
+    const SizeType erased = BaseType::erase_if(std::move(predicate_));
+    if(erased != 0)
+    {
+        rebuild_index();
+    }
+    return erased;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the elements at a list of positions.
+ *              The remaining elements stay sorted; the Eytzinger index is rebuilt once.
+ *
+ * \param       indices_: Positions of the elements to erase, sorted in strictly increasing order.
+ *
+ * \retval      SizeType: Number of erased elements.
+ *
+ * \throws      std::length_error("Index out of range"): If a position is out of range.
+ * \throws      std::invalid_argument("Indices must be sorted and unique"):
+ *              If the positions are not in strictly increasing order.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<std::ranges::forward_range IndexRange>
+inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::SizeType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::erase_indices(const IndexRange& indices_)
+    requires(std::convertible_to<std::ranges::range_reference_t<const IndexRange>, SizeType>)
+{
+    const SizeType erased = BaseType::erase_indices(indices_);
+    if(erased != 0)
+    {
+        rebuild_index();
+    }
+    return erased;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element. The buffer stays allocated.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::clear()
+{
+    BaseType::clear();
+    rebuild_index();
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of elements the buffer can hold.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::SizeType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const CompareType&
+FLAT_SORTED_TABLE_CLASS_SCOPE__::key_comp() const noexcept
+{
+    return m_compare;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make sure the buffer can hold at least a given number of elements.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > m_capacity)
+    {
+        reallocate(newCapacity_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Shrink the buffer to the number of elements, e.g. once a lookup table is built.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(this->is_empty())
+    {
+        release();
+    }
+    else if(this->length() < m_capacity)
+    {
+        reallocate(this->length());
+    }
+}
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the table as a string, such as "[1, 2, 3]" or "[1: a, 2: b]".
+ *              Elements that cannot be written to a std::ostream are shown as "?".
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::string
+FLAT_SORTED_TABLE_CLASS_SCOPE__::to_string() const
+{
+    std::ostringstream stream;
+    stream << '[';
+    for(SizeType i = 0; i < this->length(); ++i)
+    {
+        const ValueType& value = (*this)[i];
+        if(i != 0)
+        {
+            stream << ", ";
+        }
+
+        if constexpr(requires(std::ostream& os_) { os_ << value; })
+        {
+            stream << value;
+        }
+        else if constexpr(requires(std::ostream& os_) { os_ << value.first << value.second; })
+        {
+            stream << value.first << ": " << value.second;
+        }
+        else
+        {
+            stream << '?';
+        }
+    }
+    stream << ']';
+    return stream.str();
+}
+
+
+/*************************************************************************************************/
+/* PROTECTED METHODS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find the position of the first element whose key is not ordered before a key,
+ *              using the search of the selected layout.
+ *              A stale Eytzinger index is not rebuilt: the sorted elements are searched instead.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::SizeType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::lower_bound_index(const LookupType& key_) const
+{
+    if constexpr(Layout == flat_layout::eytzinger)
+    {
+        if(m_indexState.isStale.load(std::memory_order_relaxed) == false)
+        {
+            return m_index.partition_point([this, &key_](const KeyType& candidate_) {
+                return m_compare(candidate_, key_);
+            });
+        }
+    }
+
+    return branchless_partition_point(
+      data(), this->length(), [this, &key_](const ValueType& candidate_) {
+          return m_compare(PolicyType::key_of(candidate_), key_);
+      });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check if the element at a position returned by lower_bound_index() has a key
+ *              equivalent to a given key.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename LookupType>
+[[nodiscard]] inline bool
+FLAT_SORTED_TABLE_CLASS_SCOPE__::is_match(SizeType index_, const LookupType& key_) const
+{
+    return index_ < this->length() && m_compare(key_, PolicyType::key_of(data()[index_])) == false;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element at a position, shifting the following elements back.
+ *              The caller is responsible for the position keeping the table sorted.
+ *
+ * \param       index_: Position of the new element.
+ * \param       args_:  Arguments forwarded to the element's constructor. They may refer to
+ *                      elements of the table.
+ *
+ * \retval      IteratorType: Iterator to the new element.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::IteratorType
+FLAT_SORTED_TABLE_CLASS_SCOPE__::insert_at(SizeType index_, Args&&... args_)
+{
+    const SizeType currentLength = this->length();
+
+    if(currentLength == m_capacity)
+    {
+        /* Build the new element in the new buffer while the arguments are still valid */
+        const SizeType newCapacity = std::max<SizeType>(1, m_capacity * 2);
+        ValueType*     oldItems    = data();
+        ValueType*     newItems    = AllocatorTraits::allocate(this->m_allocator, newCapacity);
+        try
+        {
+            AllocatorTraits::construct(
+              this->m_allocator, newItems + index_, std::forward<Args>(args_)...);
+        }
+        catch(...)
+        {
+            AllocatorTraits::deallocate(this->m_allocator, newItems, newCapacity);
+            throw;
+        }
+
+        for(SizeType i = 0; i < currentLength; ++i)
+        {
+            ValueType* target = newItems + (i < index_ ? i : i + 1);
+            AllocatorTraits::construct(this->m_allocator, target, std::move(oldItems[i]));
+            AllocatorTraits::destroy(this->m_allocator, oldItems + i);
+        }
+        if(oldItems != nullptr)
+        {
+            AllocatorTraits::deallocate(this->m_allocator, oldItems, m_capacity);
+        }
+
+        m_capacity            = newCapacity;
+        this->m_beginIterator = IteratorType(newItems);
+        this->m_endIterator   = IteratorType(newItems + currentLength);
+    }
+    else
+    {
+        ValueType  value(std::forward<Args>(args_)...);
+        ValueType* items = data();
+
+        if(index_ == currentLength)
+        {
+            AllocatorTraits::construct(this->m_allocator, items + currentLength, std::move(value));
+        }
+        else
+        {
+            AllocatorTraits::construct(
+              this->m_allocator, items + currentLength, std::move(items[currentLength - 1]));
+            std::move_backward(items + index_, items + currentLength - 1, items + currentLength);
+            items[index_] = std::move(value);
+        }
+    }
+
+    this->add_size(1);
+    invalidate_index();
+    return IteratorType(data() + index_);
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements to a new buffer.
+ *
+ * \param       newCapacity_: Capacity of the new buffer. Must hold at least length() elements.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::reallocate(SizeType newCapacity_)
+{
+    const SizeType currentLength = this->length();
+    ValueType*     oldItems      = data();
+    ValueType*     newItems      = AllocatorTraits::allocate(this->m_allocator, newCapacity_);
+
+    for(SizeType i = 0; i < currentLength; ++i)
+    {
+        AllocatorTraits::construct(this->m_allocator, newItems + i, std::move(oldItems[i]));
+        AllocatorTraits::destroy(this->m_allocator, oldItems + i);
+    }
+    if(oldItems != nullptr)
+    {
+        AllocatorTraits::deallocate(this->m_allocator, oldItems, m_capacity);
+    }
+
+    m_capacity            = newCapacity_;
+    this->m_beginIterator = IteratorType(newItems);
+    this->m_endIterator   = IteratorType(newItems + currentLength);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element, free the buffer and drop the index.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::release() noexcept
+{
+    ValueType* items = data();
+    if(items != nullptr)
+    {
+        for(SizeType i = 0; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items + i);
+        }
+        AllocatorTraits::deallocate(this->m_allocator, items, m_capacity);
+    }
+
+    if constexpr(Layout == flat_layout::eytzinger)
+    {
+        m_index.clear();
+        m_indexState.isStale.store(false, std::memory_order_relaxed);
+    }
+
+    m_capacity            = 0;
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Bring the Eytzinger index up to date with the elements. No-op with the sorted
+ *              layout.
+ *              Used by bulk operations, which are O(n) already. The index stays stale if this
+ *              throws.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::rebuild_index()
+{
+    if constexpr(Layout == flat_layout::eytzinger)
+    {
+        m_indexState.isStale.store(true, std::memory_order_relaxed);
+        m_index.rebuild(data(), this->length(), [](const ValueType& value_) -> const KeyType& {
+            return PolicyType::key_of(value_);
+        });
+        m_indexState.isStale.store(false, std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Mark the Eytzinger index as lagging behind the elements, after a single-element
+ *              change. The next lookup rebuilds it.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::invalidate_index() noexcept
+{
+    if constexpr(Layout == flat_layout::eytzinger)
+    {
+        m_indexState.isStale.store(true, std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Rebuild the Eytzinger index if it is stale, before a lookup.
+ *              Lookups may run concurrently: the first one to find the index stale rebuilds it
+ *              under a lock, and the others wait for it. Once the index is fresh, this is a
+ *              single load.
+ *
+ * \throws      std::bad_alloc
+ *              If the index could not be rebuilt. It stays stale.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::refresh_index() const
+{
+    if constexpr(Layout == flat_layout::eytzinger)
+    {
+        if(m_indexState.isStale.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> guard(m_indexState.lock);
+            if(m_indexState.isStale.load(std::memory_order_relaxed))
+            {
+                m_index.rebuild(
+                  data(), this->length(), [](const ValueType& value_) -> const KeyType& {
+                      return PolicyType::key_of(value_);
+                  });
+                m_indexState.isStale.store(false, std::memory_order_release);
+            }
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Sort the elements appended after a sorted prefix and merge them into it, then
+ *              drop the elements with a key equivalent to the one before them.
+ *
+ * \param       sortedLength_: Number of elements at the front that are already sorted and unique.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+inline void
+FLAT_SORTED_TABLE_CLASS_SCOPE__::sort_and_merge(SizeType sortedLength_)
+{
+    ValueType*     items         = data();
+    const SizeType currentLength = this->length();
+    if(currentLength == sortedLength_)
+    {
+        return;
+    }
+
+    const auto isOrdered = [this](const ValueType& lhs_, const ValueType& rhs_) {
+        return m_compare(PolicyType::key_of(lhs_), PolicyType::key_of(rhs_));
+    };
+
+    /* Stable, so that the first of equivalent values comes first and is the one kept */
+    std::stable_sort(items + sortedLength_, items + currentLength, isOrdered);
+    std::inplace_merge(items, items + sortedLength_, items + currentLength, isOrdered);
+
+    ValueType* last = std::unique(
+      items, items + currentLength, [&isOrdered](const ValueType& lhs_, const ValueType& rhs_) {
+          return isOrdered(lhs_, rhs_) == false;
+      });
+
+    const SizeType uniqueLength = static_cast<SizeType>(last - items);
+    for(SizeType i = uniqueLength; i < currentLength; ++i)
+    {
+        AllocatorTraits::destroy(this->m_allocator, items + i);
+    }
+    this->change_size(uniqueLength);
+
+    rebuild_index();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain a pointer to the first element of the buffer.
+ *************************************************************************************************/
+template<FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename FLAT_SORTED_TABLE_CLASS_SCOPE__::ValueType*
+FLAT_SORTED_TABLE_CLASS_SCOPE__::data() const noexcept
+{
+    return BaseType::begin().ptr();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef FLAT_SORTED_TABLE_TEMPLATE_DECLARATION__
+#undef FLAT_SORTED_TABLE_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
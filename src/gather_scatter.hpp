@@ -0,0 +1,529 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+#include "./prefetching_iterator.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Container whose elements are contiguous and reached through begin().ptr(), as with
+ *              every container_base.
+ */
+template<typename ContainerType>
+concept contiguous_container = requires(ContainerType& container_) {
+    { container_.begin().ptr() } -> std::convertible_to<const volatile void*>;
+    { container_.length() } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * \brief       Sized random-access range of integer indices.
+ */
+template<typename IndexRange>
+concept index_range = std::ranges::random_access_range<IndexRange>
+                      && std::ranges::sized_range<IndexRange>
+                      && std::integral<std::ranges::range_value_t<IndexRange>>
+                      && !std::same_as<std::ranges::range_value_t<IndexRange>, bool>;
+
+/* Element type of a contiguous container, const when the container is */
+template<contiguous_container ContainerType>
+using container_item_t = std::conditional_t<
+  std::is_const_v<ContainerType>,
+  const std::remove_pointer_t<decltype(std::declval<ContainerType&>().begin().ptr())>,
+  std::remove_pointer_t<decltype(std::declval<ContainerType&>().begin().ptr())>>;
+
+
+/*************************************************************************************************/
+/* Helpers ------------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Reinterpret an index as unsigned, so that negative indices become out-of-range ones.
+ *************************************************************************************************/
+template<std::integral IndexType>
+[[nodiscard]] constexpr std::make_unsigned_t<IndexType>
+index_as_unsigned(IndexType index_) noexcept
+{
+    if constexpr(std::is_signed_v<IndexType>)
+    {
+        return static_cast<std::make_unsigned_t<IndexType>>(index_);
+    }
+    else
+    {
+        return index_;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Prefetch the elements of a container at a range of positions in the indices.
+ *
+ * \param       source_:  Pointer to the first element of the container.
+ * \param       indices_: Iterator to the first index.
+ * \param       first_:   First position in the indices to prefetch.
+ * \param       last_:    Position past the last one to prefetch.
+ *************************************************************************************************/
+template<typename ItemType, std::random_access_iterator IndexIterator>
+inline void
+prefetch_indexed(const ItemType*                     source_,
+                 IndexIterator                       indices_,
+                 std::iter_difference_t<IndexIterator> first_,
+                 std::iter_difference_t<IndexIterator> last_) noexcept
+{
+    for(; first_ < last_; ++first_)
+    {
+        prefetch(source_ + indices_[first_]);
+    }
+}
+
+
+/* Whether gather can load several elements per instruction with AVX2 or AVX-512 */
+template<typename ItemType, typename IndexRange, typename OutputIterator>
+concept vectorizable_gather =
+  (PEL_HAS_AVX2 + PEL_HAS_AVX512F != 0) && std::is_trivially_copyable_v<ItemType>
+  && (sizeof(ItemType) == 4 || sizeof(ItemType) == 8) && std::ranges::contiguous_range<IndexRange>
+  && (sizeof(std::ranges::range_value_t<IndexRange>) == 4
+      || sizeof(std::ranges::range_value_t<IndexRange>) == 8)
+  && std::contiguous_iterator<OutputIterator>
+  && std::same_as<std::iter_value_t<OutputIterator>, ItemType>;
+
+
+/**
+ **************************************************************************************************
+ * \brief       Gather whole vectors of elements with the hardware gather instructions, prefetching
+ *              the vector Distance indices ahead.
+ *              Stops at the first vector holding an index that is not below the limit, and leaves
+ *              it to the scalar loop.
+ *
+ * \param       source_:   Pointer to the first element of the container.
+ * \param       indices_:  Pointer to the first index.
+ * \param       output_:   Pointer to the first output element.
+ * \param       count_:    Number of indices.
+ * \param       limit_:    Bound on the indices, at most the length of the container and at most
+ *                         the largest value of the signed index type, as the instructions read
+ *                         the indices as signed.
+ * \param       distance_: Number of indices ahead whose element is prefetched. 0 disables it.
+ *
+ * \retval      std::ptrdiff_t: Number of elements gathered, a multiple of the vector width.
+ *************************************************************************************************/
+template<typename ItemType, typename IndexType>
+inline std::ptrdiff_t
+gather_vectorized(const ItemType*  source_,
+                  const IndexType* indices_,
+                  ItemType*        output_,
+                  std::ptrdiff_t   count_,
+                  std::size_t      limit_,
+                  std::ptrdiff_t   distance_) noexcept
+{
+    std::ptrdiff_t done = 0;
+    if(limit_ == 0)
+    {
+        return done;
+    }
+
+#if PEL_HAS_AVX512F
+    constexpr std::ptrdiff_t lanes = (sizeof(ItemType) == 4 && sizeof(IndexType) == 4) ? 16 : 8;
+#elif PEL_HAS_AVX2
+    constexpr std::ptrdiff_t lanes = (sizeof(ItemType) == 4 && sizeof(IndexType) == 4) ? 8 : 4;
+#else
+    constexpr std::ptrdiff_t lanes = 1;
+    static_cast<void>(source_);
+    static_cast<void>(indices_);
+    static_cast<void>(output_);
+#endif
+
+    /* Largest valid index: unsigned comparisons against it also reject negative indices */
+    const std::uint64_t last = limit_ - 1;
+    static_cast<void>(last);
+
+    for(; done + lanes <= count_ && lanes > 1; done += lanes)
+    {
+        const IndexType* index  = indices_ + done;
+        ItemType*        output = output_ + done;
+#if PEL_HAS_AVX512F
+        if constexpr(sizeof(ItemType) == 4 && sizeof(IndexType) == 4)
+        {
+            const __m512i offsets = _mm512_loadu_si512(index);
+            const __m512i bound   = _mm512_set1_epi32(static_cast<int>(last));
+            if(_mm512_cmpgt_epu32_mask(offsets, bound) != 0)
+            {
+                break;
+            }
+            _mm512_storeu_si512(
+              output,
+              _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, offsets, source_, 4));
+        }
+        else if constexpr(sizeof(ItemType) == 8 && sizeof(IndexType) == 4)
+        {
+            const __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index));
+            const __m256i bounded =
+              _mm256_min_epu32(offsets, _mm256_set1_epi32(static_cast<int>(last)));
+            if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(bounded, offsets)) != -1)
+            {
+                break;
+            }
+            _mm512_storeu_si512(
+              output,
+              _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xFF, offsets, source_, 8));
+        }
+        else if constexpr(sizeof(ItemType) == 4 && sizeof(IndexType) == 8)
+        {
+            const __m512i offsets = _mm512_loadu_si512(index);
+            const __m512i bound   = _mm512_set1_epi64(static_cast<long long>(last));
+            if(_mm512_cmpgt_epu64_mask(offsets, bound) != 0)
+            {
+                break;
+            }
+            _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(output),
+              _mm512_mask_i64gather_epi32(_mm256_setzero_si256(), 0xFF, offsets, source_, 4));
+        }
+        else
+        {
+            const __m512i offsets = _mm512_loadu_si512(index);
+            const __m512i bound   = _mm512_set1_epi64(static_cast<long long>(last));
+            if(_mm512_cmpgt_epu64_mask(offsets, bound) != 0)
+            {
+                break;
+            }
+            _mm512_storeu_si512(
+              output,
+              _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xFF, offsets, source_, 8));
+        }
+#elif PEL_HAS_AVX2
+        /* AVX2 only compares signed integers: 32-bit indices are in range when their unsigned
+         * minimum with the last index is themselves, 64-bit ones when they are neither negative
+         * nor above the last index */
+        if constexpr(sizeof(ItemType) == 4 && sizeof(IndexType) == 4)
+        {
+            const __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index));
+            const __m256i bounded =
+              _mm256_min_epu32(offsets, _mm256_set1_epi32(static_cast<int>(last)));
+            if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(bounded, offsets)) != -1)
+            {
+                break;
+            }
+            _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(output),
+              _mm256_i32gather_epi32(reinterpret_cast<const int*>(source_), offsets, 4));
+        }
+        else if constexpr(sizeof(ItemType) == 8 && sizeof(IndexType) == 4)
+        {
+            const __m128i offsets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index));
+            const __m128i bounded = _mm_min_epu32(offsets, _mm_set1_epi32(static_cast<int>(last)));
+            if(_mm_movemask_epi8(_mm_cmpeq_epi32(bounded, offsets)) != 0xFFFF)
+            {
+                break;
+            }
+            _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(output),
+              _mm256_i32gather_epi64(reinterpret_cast<const long long*>(source_), offsets, 8));
+        }
+        else
+        {
+            const __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index));
+            const __m256i isNegative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), offsets);
+            const __m256i isAbove =
+              _mm256_cmpgt_epi64(offsets, _mm256_set1_epi64x(static_cast<long long>(last)));
+            if(_mm256_testz_si256(_mm256_or_si256(isNegative, isAbove), _mm256_set1_epi8(-1)) == 0)
+            {
+                break;
+            }
+
+            if constexpr(sizeof(ItemType) == 4)
+            {
+                _mm_storeu_si128(
+                  reinterpret_cast<__m128i*>(output),
+                  _mm256_i64gather_epi32(reinterpret_cast<const int*>(source_), offsets, 4));
+            }
+            else
+            {
+                _mm256_storeu_si256(
+                  reinterpret_cast<__m256i*>(output),
+                  _mm256_i64gather_epi64(reinterpret_cast<const long long*>(source_), offsets, 8));
+            }
+        }
+#else
+        static_cast<void>(index);
+        static_cast<void>(output);
+#endif
+
+        if(distance_ != 0)
+        {
+            prefetch_indexed(source_,
+                             indices_,
+                             std::min(done + distance_, count_),
+                             std::min(done + distance_ + lanes, count_));
+        }
+    }
+
+    return done;
+}
+
+
+/*************************************************************************************************/
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the elements of a container at a sequence of indices to an output iterator:
+ *              output[i] = source[indices[i]].
+ *
+ *              Each element Distance indices ahead is prefetched, so that more DRAM accesses are
+ *              in flight at once. With AVX2 or AVX-512, 4- and 8-byte trivially copyable elements
+ *              indexed by a contiguous range of 32- or 64-bit integers into a contiguous output
+ *              are loaded with the hardware gather instructions.
+ *
+ * \param       source_:           Container to read the elements from.
+ * \param       indices_:          Indices of the elements to read, in output order.
+ * \param       output_:           Iterator to the first output element.
+ * \param       prefetchDistance_: Number of indices ahead whose element is prefetched.
+ *                                 0 disables prefetching.
+ *
+ * \retval      OutputIterator: Iterator past the last output element.
+ *
+ * \throws      std::length_error("Index out of range"): If an index is negative or out of range.
+ *              The elements before it are already written.
+ *************************************************************************************************/
+template<contiguous_container ContainerType, index_range IndexRange, typename OutputIterator>
+    requires(std::output_iterator<OutputIterator, const container_item_t<const ContainerType>&>)
+inline OutputIterator
+gather(const ContainerType& source_,
+       const IndexRange&    indices_,
+       OutputIterator       output_,
+       std::size_t          prefetchDistance_ = default_prefetch_distance)
+{
+    using ItemType  = std::remove_const_t<container_item_t<const ContainerType>>;
+    using IndexType = std::ranges::range_value_t<IndexRange>;
+
+    const std::size_t    length   = source_.length();
+    const ItemType*      source   = source_.begin().ptr();
+    auto                 indices  = std::ranges::begin(indices_);
+    const std::ptrdiff_t count    = std::ranges::ssize(indices_);
+    const std::ptrdiff_t distance = static_cast<std::ptrdiff_t>(prefetchDistance_);
+
+    if(distance != 0)
+    {
+        prefetch_indexed(source, indices, 0, std::min(distance, count));
+    }
+
+    std::ptrdiff_t done = 0;
+    if constexpr(vectorizable_gather<ItemType, IndexRange, OutputIterator>)
+    {
+        const std::size_t limit =
+          std::min<std::size_t>(length, std::numeric_limits<std::make_signed_t<IndexType>>::max());
+        done = gather_vectorized(
+          source, std::ranges::data(indices_), std::to_address(output_), count, limit, distance);
+        output_ += done;
+    }
+
+    for(; done < count; ++done)
+    {
+        if(distance != 0 && done + distance < count)
+        {
+            prefetch(source + indices[done + distance]);
+        }
+
+        const IndexType index = indices[done];
+        if(index_as_unsigned(index) >= length)
+        {
+            throw std::length_error("Index out of range");
+        }
+        *output_ = source[index];
+        ++output_;
+    }
+    return output_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Assign values to the elements of a container at a sequence of indices:
+ *              destination[indices[i]] = values[i].
+ *
+ *              Each element Distance indices ahead is prefetched for writing. With repeated
+ *              indices, the last value wins.
+ *
+ * \note        AVX2 has no scatter instruction, and AVX-512 scatters are no faster than the scalar
+ *              stores once the destination misses the cache, so the stores stay scalar.
+ *
+ * \param       destination_:      Container to write the elements to. Taken through its
+ *                                 non-const begin(), so that copy-on-write containers unshare.
+ * \param       indices_:          Indices of the elements to write.
+ * \param       values_:           Values to write, one per index.
+ * \param       prefetchDistance_: Number of indices ahead whose element is prefetched.
+ *                                 0 disables prefetching.
+ *
+ * \throws      std::invalid_argument("Index and value counts differ"):
+ *              If there is not exactly one value per index. Nothing is written in that case.
+ * \throws      std::length_error("Index out of range"): If an index is negative or out of range.
+ *              The elements before it are already written.
+ *************************************************************************************************/
+template<contiguous_container ContainerType,
+         index_range          IndexRange,
+         std::ranges::input_range ValueRange>
+    requires(std::ranges::sized_range<ValueRange>
+             && std::is_assignable_v<container_item_t<ContainerType>&,
+                                     std::ranges::range_reference_t<ValueRange>>)
+inline void
+scatter(ContainerType&    destination_,
+        const IndexRange& indices_,
+        ValueRange&&      values_,
+        std::size_t       prefetchDistance_ = default_prefetch_distance)
+{
+    using ItemType = container_item_t<ContainerType>;
+
+    if(std::ranges::size(values_) != std::ranges::size(indices_))
+    {
+        throw std::invalid_argument("Index and value counts differ");
+    }
+
+    const std::size_t    length      = destination_.length();
+    ItemType*            destination = destination_.begin().ptr();
+    auto                 indices     = std::ranges::begin(indices_);
+    auto                 value       = std::ranges::begin(values_);
+    const std::ptrdiff_t count       = std::ranges::ssize(indices_);
+    const std::ptrdiff_t distance    = static_cast<std::ptrdiff_t>(prefetchDistance_);
+
+    for(std::ptrdiff_t done = 0; done < std::min(distance, count); ++done)
+    {
+        prefetch_for_write(destination + indices[done]);
+    }
+    for(std::ptrdiff_t done = 0; done < count; ++done, ++value)
+    {
+        if(distance != 0 && done + distance < count)
+        {
+            prefetch_for_write(destination + indices[done + distance]);
+        }
+
+        const auto index = indices[done];
+        if(index_as_unsigned(index) >= length)
+        {
+            throw std::length_error("Index out of range");
+        }
+        destination[index] = *value;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the elements of a container at a sequence of indices into a new vector.
+ *              Same as gather() into a vector of the right size, using the container's allocator.
+ *
+ * \param       source_:           Container to read the elements from.
+ * \param       indices_:          Indices of the elements to read, in output order.
+ * \param       prefetchDistance_: Number of indices ahead whose element is prefetched.
+ *                                 0 disables prefetching.
+ *
+ * \retval      std::vector: The elements, in the order of the indices.
+ *
+ * \throws      std::length_error("Index out of range"): If an index is out of range.
+ *************************************************************************************************/
+template<contiguous_container ContainerType, index_range IndexRange>
+[[nodiscard]] inline auto
+take(const ContainerType& source_,
+     const IndexRange&    indices_,
+     std::size_t          prefetchDistance_ = default_prefetch_distance)
+{
+    using ItemType      = std::remove_const_t<container_item_t<const ContainerType>>;
+    using AllocatorType = std::remove_cvref_t<decltype(source_.get_allocator())>;
+
+    if constexpr(std::is_default_constructible_v<ItemType>)
+    {
+        std::vector<ItemType, AllocatorType> taken(std::ranges::size(indices_),
+                                                   source_.get_allocator());
+        static_cast<void>(gather(source_, indices_, taken.begin(), prefetchDistance_));
+        return taken;
+    }
+    else
+    {
+        std::vector<ItemType, AllocatorType> taken(source_.get_allocator());
+        taken.reserve(std::ranges::size(indices_));
+        static_cast<void>(gather(source_, indices_, std::back_inserter(taken), prefetchDistance_));
+        return taken;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Range over the elements of a container at a sequence of indices, for loops that do
+ *              more than copy them; its iterators prefetch the element Distance indices ahead.
+ *              Indices are not checked.
+ *
+ * \param       container_:        Container to walk.
+ * \param       indices_:          Indices of the elements to visit, in order.
+ * \param       prefetchDistance_: Number of indices ahead whose element is prefetched.
+ *                                 0 disables prefetching.
+ *
+ * \retval      std::ranges::subrange: Range of prefetching_iterator.
+ *************************************************************************************************/
+template<contiguous_container ContainerType, index_range IndexRange>
+[[nodiscard]] inline auto
+prefetched(ContainerType&    container_,
+           const IndexRange& indices_,
+           std::size_t       prefetchDistance_ = default_prefetch_distance)
+{
+    using IteratorType =
+      prefetching_iterator<container_item_t<ContainerType>,
+                           std::ranges::iterator_t<const IndexRange>>;
+
+    return std::ranges::subrange<IteratorType>(
+      IteratorType(container_.begin(),
+                   std::ranges::begin(indices_),
+                   std::ranges::end(indices_),
+                   prefetchDistance_),
+      IteratorType(container_.begin(),
+                   std::ranges::end(indices_),
+                   std::ranges::end(indices_),
+                   0));
+}
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,316 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PEL_HAS_SSE2 1
+#else
+#define PEL_HAS_SSE2 0
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define PEL_HAS_SSE41 1
+#else
+#define PEL_HAS_SSE41 0
+#endif
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#define PEL_HAS_BMI2 1
+#else
+#define PEL_HAS_BMI2 0
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PEL_HAS_AVX2 1
+#else
+#define PEL_HAS_AVX2 0
+#endif
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define PEL_HAS_AVX512F 1
+#else
+#define PEL_HAS_AVX512F 0
+#endif
+
+/* Keeps a rarely taken path out of the inlined fast path of its caller */
+#if defined(__GNUC__) || defined(__clang__)
+#define PEL_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define PEL_NOINLINE __declspec(noinline)
+#else
+#define PEL_NOINLINE
+#endif
+
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* Constants ----------------------------------------------------------------------------------- */
+
+/**
+ * \brief       Size (in bytes) used to separate data written by different threads.
+ *
+ * \note        std::hardware_destructive_interference_size is not reliably provided (and warns
+ *              on GCC when used in headers), so the common x86-64/AArch64 value is used.
+ */
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * \brief       Number of elements ahead of the current one that indexed accesses prefetch.
+ *
+ * \note        At a few nanoseconds per element, 16 elements roughly cover one DRAM access.
+ */
+inline constexpr std::size_t default_prefetch_distance = 16;
+
+/**
+ * \brief       Number of 32-bit words compact_words() packs at a time: a 512-bit register with
+ *              AVX-512, a 256-bit one with AVX2, and 0 when neither is available.
+ */
+inline constexpr std::size_t compaction_block_words = PEL_HAS_AVX512F ? 16 : (PEL_HAS_AVX2 ? 8 : 0);
+
+/**
+ * \brief       Permutations of compact_words() with AVX2: entry m lists, in order, the words of
+ *              an 8-word block whose bit is set in m.
+ */
+inline constexpr auto compaction_permutations = [] {
+    std::array<std::array<std::uint32_t, 8>, 256> permutations{};
+    for(std::size_t mask = 0; mask < permutations.size(); ++mask)
+    {
+        std::size_t output = 0;
+        for(std::uint32_t word = 0; word < 8; ++word)
+        {
+            if(((mask >> word) & 1) != 0)
+            {
+                permutations[mask][output++] = word;
+            }
+        }
+    }
+    return permutations;
+}();
+
+
+/**
+ * \brief       Position of the n-th set bit of every byte, at [8 * byte + n], used by
+ *              select_bit() when pdep is not available. 8 for the bits a byte does not have.
+ */
+inline constexpr std::array<std::uint8_t, 256 * 8> select_in_byte = []()
+{
+    std::array<std::uint8_t, 256 * 8> positions{};
+    for(unsigned byte = 0; byte < 256; ++byte)
+    {
+        unsigned found = 0;
+        for(unsigned bit = 0; bit < 8; ++bit)
+        {
+            if((byte >> bit & 1U) != 0)
+            {
+                positions[8 * byte + found++] = static_cast<std::uint8_t>(bit);
+            }
+        }
+        for(; found < 8; ++found)
+        {
+            positions[8 * byte + found] = 8;
+        }
+    }
+    return positions;
+}();
+
+
+/*************************************************************************************************/
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Hint to the processor that the calling thread is busy-waiting.
+ *************************************************************************************************/
+inline void
+cpu_relax() noexcept
+{
+#if PEL_HAS_SSE2
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Hint to the processor that a memory location will soon be read.
+ *              Never faults, so the address does not have to be valid.
+ *
+ * \param       address_: Address to bring into the cache.
+ *************************************************************************************************/
+inline void
+prefetch(const void* address_) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address_);
+#elif PEL_HAS_SSE2
+    _mm_prefetch(static_cast<const char*>(address_), _MM_HINT_T0);
+#else
+    static_cast<void>(address_);
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Hint to the processor that a memory location will soon be written.
+ *              Never faults, so the address does not have to be valid.
+ *
+ * \param       address_: Address to bring into the cache, ready to be modified.
+ *************************************************************************************************/
+inline void
+prefetch_for_write(const void* address_) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address_, 1);
+#elif PEL_HAS_SSE2
+    _mm_prefetch(static_cast<const char*>(address_), _MM_HINT_T0);
+#else
+    static_cast<void>(address_);
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the position of the n-th set bit of a word (select).
+ *              A single pdep and tzcnt with BMI2. Otherwise, the byte holding the bit is found
+ *              from the running popcount of the bytes, and the bit from select_in_byte.
+ *
+ * \param       word_: Word to search.
+ * \param       n_:    Number of set bits to skip, counting from the least significant bit.
+ *                     Must be below 64.
+ * \retval      unsigned: Position of the bit, or 64 if the word has n_ or fewer set bits.
+ *************************************************************************************************/
+inline unsigned
+select_bit(std::uint64_t word_, unsigned n_) noexcept
+{
+#if PEL_HAS_BMI2
+    return static_cast<unsigned>(std::countr_zero(_pdep_u64(std::uint64_t{1} << n_, word_)));
+#else
+    constexpr std::uint64_t byte_ones = 0x0101010101010101ULL;
+    constexpr std::uint64_t byte_msbs = 0x8080808080808080ULL;
+
+    /* Set bits in bytes 0 to i, in byte i */
+    std::uint64_t counts = word_ - ((word_ >> 1U) & 0x5555555555555555ULL);
+    counts = (counts & 0x3333333333333333ULL) + ((counts >> 2U) & 0x3333333333333333ULL);
+    counts = ((counts + (counts >> 4U)) & 0x0F0F0F0F0F0F0F0FULL) * byte_ones;
+
+    /* Every count fits in 7 bits: the top bit of a byte survives the subtraction iff n_ >= count */
+    const auto byte =
+      static_cast<unsigned>(std::popcount(((n_ * byte_ones | byte_msbs) - counts) & byte_msbs));
+    if(byte == 8)
+    {
+        return 64;
+    }
+
+    const unsigned      shift  = 8 * byte;
+    const std::uint64_t before = ((counts << 8U) >> shift) & 0xFF;
+    return shift + select_in_byte[8 * ((word_ >> shift) & 0xFF) + (n_ - before)];
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Mask of the nonzero words of a block, for compact_words(). Filling the block with
+ *              one word per element, 0 or ~0, lets the compiler evaluate a simple predicate over
+ *              the whole block with vector compares, where building the mask bit by bit would
+ *              keep it to one element at a time.
+ *
+ * \param       flags_: compaction_block_words words, each 0 or ~0.
+ * \retval      unsigned: Bit i set when word i is not 0.
+ *************************************************************************************************/
+inline unsigned
+compaction_mask(const std::uint32_t* flags_) noexcept
+{
+#if PEL_HAS_AVX512F
+    const __m512i flags = _mm512_loadu_si512(flags_);
+    return static_cast<unsigned>(_mm512_test_epi32_mask(flags, flags));
+#elif PEL_HAS_AVX2
+    const __m256i flags = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags_));
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(flags)));
+#else
+    /* Never called: without a SIMD instruction set, blocks are empty */
+    static_cast<void>(flags_);
+    return 0;
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Pack the 32-bit words of a block selected by a mask at the start of the output, in
+ *              order. With AVX-512 this is a single compress, with AVX2 a permutation looked up
+ *              from the mask. Only does something when compaction_block_words is not 0.
+ *
+ * \param       output_: Where the kept words go. The whole block is stored, the words after the
+ *                       kept ones holding unspecified values, so compaction_block_words words
+ *                       must be writable from there.
+ * \param       block_:  compaction_block_words words to pack.
+ * \param       keep_:   Bit i set to keep word i.
+ *************************************************************************************************/
+inline void
+compact_words(void* output_, const void* block_, unsigned keep_) noexcept
+{
+#if PEL_HAS_AVX512F
+    const __m512i block = _mm512_loadu_si512(block_);
+    _mm512_storeu_si512(output_, _mm512_maskz_compress_epi32(static_cast<__mmask16>(keep_), block));
+#elif PEL_HAS_AVX2
+    const __m256i block       = _mm256_loadu_si256(static_cast<const __m256i*>(block_));
+    const __m256i permutation = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(compaction_permutations[keep_].data()));
+    _mm256_storeu_si256(static_cast<__m256i*>(output_),
+                        _mm256_permutevar8x32_epi32(block, permutation));
+#else
+    /* Never called: without a SIMD instruction set, blocks are empty */
+    static_cast<void>(output_);
+    static_cast<void>(block_);
+    static_cast<void>(keep_);
+#endif
+}
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
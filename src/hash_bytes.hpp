@@ -0,0 +1,574 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Type whose values are equal exactly when their bytes are, so that a buffer of them
+ *              can be hashed with hash_bytes. Excludes floating-point numbers and types with
+ *              padding.
+ */
+template<typename ItemType>
+concept bytewise_hashable =
+  std::is_trivially_copyable_v<ItemType> && std::has_unique_object_representations_v<ItemType>;
+
+
+/*************************************************************************************************/
+/* Constants ----------------------------------------------------------------------------------- */
+
+/**
+ * \brief       Inputs up to this many bytes are hashed with a chain of 64 x 64 -> 128-bit
+ *              multiplications, longer ones with 8 independent accumulators fed 64 bytes at a time
+ *              with SSE2 or AVX2.
+ */
+inline constexpr std::size_t hash_medium_limit = 128;
+
+/* Number of bytes fed to the 8 accumulators at a time */
+inline constexpr std::size_t hash_stripe_size = 64;
+
+/* Number of stripes after which the accumulators are scrambled, each one with its own keys */
+inline constexpr std::size_t hash_stripes_per_block = 16;
+
+/**
+ * \brief       Keys of the hash, drawn from splitmix64:
+ *              - 0 to 23:  stripe keys, stripe s of a block using keys s to s + 7 and the last
+ *                          stripe keys 16 to 23;
+ *              - 24 to 31: scramble keys;
+ *              - 32 to 39: keys folding the accumulators into the hash;
+ *              - 40 to 47: initial accumulators;
+ *              - 48 to 51: keys of the short and medium inputs.
+ */
+inline constexpr std::array<std::uint64_t, 52> hash_secret = [] {
+    std::array<std::uint64_t, 52> secret{};
+    std::uint64_t                 state = 0;
+    for(std::uint64_t& key : secret)
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+
+        std::uint64_t mixed = state;
+        mixed               = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        mixed               = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+        key                 = mixed ^ (mixed >> 31);
+    }
+    return secret;
+}();
+
+
+/*************************************************************************************************/
+/* Helpers ------------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Read an unaligned integer from a byte buffer, in native byte order.
+ *************************************************************************************************/
+template<typename IntegerType>
+[[nodiscard]] inline IntegerType
+hash_read(const std::byte* data_) noexcept
+{
+    IntegerType value;
+    std::memcpy(&value, data_, sizeof(IntegerType));
+    return value;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Multiply two 64-bit integers into 128 bits and fold the halves together.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+hash_multiply_fold(std::uint64_t lhs_, std::uint64_t rhs_) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs_) * rhs_;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t lowLow   = (lhs_ & 0xFFFFFFFFU) * (rhs_ & 0xFFFFFFFFU);
+    const std::uint64_t highLow  = (lhs_ >> 32) * (rhs_ & 0xFFFFFFFFU);
+    const std::uint64_t lowHigh  = (lhs_ & 0xFFFFFFFFU) * (rhs_ >> 32);
+    const std::uint64_t highHigh = (lhs_ >> 32) * (rhs_ >> 32);
+    const std::uint64_t middle   = (lowLow >> 32) + (highLow & 0xFFFFFFFFU) + lowHigh;
+    const std::uint64_t low      = (middle << 32) | (lowLow & 0xFFFFFFFFU);
+    const std::uint64_t high     = highHigh + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Spread every bit of a hash over all the others.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+hash_avalanche(std::uint64_t hash_) noexcept
+{
+    hash_ ^= hash_ >> 37;
+    hash_ *= 0x165667919E3779F9ULL;
+    return hash_ ^ (hash_ >> 32);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Hash up to hash_medium_limit bytes.
+ *              Up to 16 bytes are read as two (possibly overlapping) words multiplied together,
+ *              longer inputs go through one multiplication per 16 bytes.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+hash_short(const std::byte* data_, std::size_t length_, std::uint64_t seed_) noexcept
+{
+    std::uint64_t lhs = 0;
+    std::uint64_t rhs = 0;
+    if(length_ > 16)
+    {
+        seed_ ^= hash_secret[48];
+        for(std::size_t offset = 0; offset + 16 < length_; offset += 16)
+        {
+            seed_ = hash_multiply_fold(hash_read<std::uint64_t>(data_ + offset) ^ hash_secret[49],
+                                       hash_read<std::uint64_t>(data_ + offset + 8) ^ seed_);
+        }
+        lhs = hash_read<std::uint64_t>(data_ + length_ - 16);
+        rhs = hash_read<std::uint64_t>(data_ + length_ - 8);
+    }
+    else if(length_ >= 8)
+    {
+        lhs = hash_read<std::uint64_t>(data_);
+        rhs = hash_read<std::uint64_t>(data_ + length_ - 8);
+    }
+    else if(length_ >= 4)
+    {
+        lhs = hash_read<std::uint32_t>(data_);
+        rhs = hash_read<std::uint32_t>(data_ + length_ - 4);
+    }
+    else if(length_ > 0)
+    {
+        lhs = (std::to_integer<std::uint64_t>(data_[0]) << 16)
+              | (std::to_integer<std::uint64_t>(data_[length_ / 2]) << 8)
+              | std::to_integer<std::uint64_t>(data_[length_ - 1]);
+    }
+
+    return hash_avalanche(
+      hash_multiply_fold(lhs ^ hash_secret[50], rhs ^ hash_secret[51] ^ seed_) ^ length_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Set the 8 accumulators of a long input to their initial value.
+ *************************************************************************************************/
+inline void
+hash_initialize(std::uint64_t* accumulators_, std::uint64_t seed_) noexcept
+{
+    for(std::size_t lane = 0; lane < 8; ++lane)
+    {
+        accumulators_[lane] = hash_secret[40 + lane] ^ seed_;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Feed whole stripes of 64 bytes to the 8 accumulators, scrambling them at the end of
+ *              each block of hash_stripes_per_block stripes.
+ *              Each accumulator adds the product of the low and high halves of its 8 bytes xored
+ *              with a key, and the raw 8 bytes of its neighbour, so that no input is lost even
+ *              when the product is 0. This is 2 independent 32 x 32 -> 64-bit multiplications per
+ *              16 bytes, with SSE2 or AVX2 when available.
+ *
+ * \param       accumulators_: The 8 accumulators.
+ * \param       data_:         Pointer to the first stripe.
+ * \param       stripes_:      Number of stripes.
+ * \param       stripe_:       Index of the first stripe in its block, set to the index of the
+ *                             next one. The keys of a stripe depend on it.
+ *************************************************************************************************/
+inline void
+hash_accumulate(std::uint64_t*   accumulators_,
+                const std::byte* data_,
+                std::size_t      stripes_,
+                std::size_t&     stripe_) noexcept
+{
+    constexpr std::uint64_t scramble_multiplier = 0x9E3779B1U;
+
+#if PEL_HAS_AVX2
+    const auto load = [](const void* address_) {
+        return _mm256_loadu_si256(static_cast<const __m256i*>(address_));
+    };
+    const __m256i multiplier = _mm256_set1_epi64x(static_cast<long long>(scramble_multiplier));
+
+    const auto accumulate =
+      [&load](__m256i accumulator_, const std::byte* bytes_, std::size_t key_) {
+        const __m256i data    = load(bytes_);
+        const __m256i keyed   = _mm256_xor_si256(data, load(hash_secret.data() + key_));
+        const __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+        const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        return _mm256_add_epi64(accumulator_, _mm256_add_epi64(product, swapped));
+    };
+    const auto scramble = [&load, multiplier](__m256i accumulator_, std::size_t key_) {
+        const __m256i mixed = _mm256_xor_si256(
+          _mm256_xor_si256(accumulator_, _mm256_srli_epi64(accumulator_, 47)),
+          load(hash_secret.data() + key_));
+        const __m256i product = _mm256_mul_epu32(mixed, multiplier);
+        const __m256i carried = _mm256_mul_epu32(_mm256_srli_epi64(mixed, 32), multiplier);
+        return _mm256_add_epi64(product, _mm256_slli_epi64(carried, 32));
+    };
+
+    __m256i low  = load(accumulators_);
+    __m256i high = load(accumulators_ + 4);
+    for(std::size_t stripe = 0; stripe < stripes_; ++stripe, data_ += hash_stripe_size)
+    {
+        low  = accumulate(low, data_, stripe_);
+        high = accumulate(high, data_ + 32, stripe_ + 4);
+        if(++stripe_ == hash_stripes_per_block)
+        {
+            low     = scramble(low, 24);
+            high    = scramble(high, 28);
+            stripe_ = 0;
+        }
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators_), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators_ + 4), high);
+#elif PEL_HAS_SSE2
+    const auto load = [](const void* address_) {
+        return _mm_loadu_si128(static_cast<const __m128i*>(address_));
+    };
+    const __m128i multiplier = _mm_set1_epi64x(static_cast<long long>(scramble_multiplier));
+
+    __m128i accumulators[4];
+    for(std::size_t part = 0; part < 4; ++part)
+    {
+        accumulators[part] = load(accumulators_ + 2 * part);
+    }
+
+    for(std::size_t stripe = 0; stripe < stripes_; ++stripe, data_ += hash_stripe_size)
+    {
+        for(std::size_t part = 0; part < 4; ++part)
+        {
+            const __m128i data    = load(data_ + 16 * part);
+            const __m128i key     = load(hash_secret.data() + stripe_ + 2 * part);
+            const __m128i keyed   = _mm_xor_si128(data, key);
+            const __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+            const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            accumulators[part] = _mm_add_epi64(accumulators[part], _mm_add_epi64(product, swapped));
+        }
+        if(++stripe_ == hash_stripes_per_block)
+        {
+            for(std::size_t part = 0; part < 4; ++part)
+            {
+                const __m128i mixed = _mm_xor_si128(
+                  _mm_xor_si128(accumulators[part], _mm_srli_epi64(accumulators[part], 47)),
+                  load(hash_secret.data() + 24 + 2 * part));
+                const __m128i product = _mm_mul_epu32(mixed, multiplier);
+                const __m128i carried = _mm_mul_epu32(_mm_srli_epi64(mixed, 32), multiplier);
+                accumulators[part]    = _mm_add_epi64(product, _mm_slli_epi64(carried, 32));
+            }
+            stripe_ = 0;
+        }
+    }
+
+    for(std::size_t part = 0; part < 4; ++part)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulators_ + 2 * part), accumulators[part]);
+    }
+#else
+    for(std::size_t stripe = 0; stripe < stripes_; ++stripe, data_ += hash_stripe_size)
+    {
+        for(std::size_t lane = 0; lane < 8; ++lane)
+        {
+            const std::uint64_t data  = hash_read<std::uint64_t>(data_ + 8 * lane);
+            const std::uint64_t keyed = data ^ hash_secret[stripe_ + lane];
+
+            accumulators_[lane] += (keyed & 0xFFFFFFFFU) * (keyed >> 32);
+            accumulators_[lane ^ 1] += data;
+        }
+        if(++stripe_ == hash_stripes_per_block)
+        {
+            for(std::size_t lane = 0; lane < 8; ++lane)
+            {
+                const std::uint64_t accumulator = accumulators_[lane];
+                const std::uint64_t mixed =
+                  accumulator ^ (accumulator >> 47) ^ hash_secret[24 + lane];
+                accumulators_[lane] = mixed * scramble_multiplier;
+            }
+            stripe_ = 0;
+        }
+    }
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Feed the last 64 bytes of a long input to the accumulators and fold them into the
+ *              hash.
+ *
+ * \param       accumulators_: The 8 accumulators, fed every stripe before the last one.
+ * \param       lastStripe_:   Pointer to the last 64 bytes of the input, which may overlap the
+ *                             stripes already fed.
+ * \param       length_:       Number of bytes of the input.
+ * \param       seed_:         Seed of the hash.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+hash_finish(std::uint64_t*   accumulators_,
+            const std::byte* lastStripe_,
+            std::uint64_t    length_,
+            std::uint64_t    seed_) noexcept
+{
+    /* Starting past the keys of the block stripes gives the last stripe keys of its own, and
+     * leaves the accumulators unscrambled */
+    std::size_t lastKeys = hash_stripes_per_block;
+    hash_accumulate(accumulators_, lastStripe_, 1, lastKeys);
+
+    std::uint64_t hash = (length_ * 0x9E3779B97F4A7C15ULL) ^ seed_;
+    for(std::size_t lane = 0; lane < 8; lane += 2)
+    {
+        hash += hash_multiply_fold(accumulators_[lane] ^ hash_secret[32 + lane],
+                                   accumulators_[lane + 1] ^ hash_secret[33 + lane]);
+    }
+    return hash_avalanche(hash);
+}
+
+
+/*************************************************************************************************/
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Hash a buffer of bytes with a fast non-cryptographic hash.
+ *              Small inputs take a handful of multiplications; inputs longer than
+ *              hash_medium_limit bytes are fed 64 bytes at a time to 8 independent accumulators,
+ *              vectorized with SSE2 or AVX2, which runs at several bytes per cycle.
+ *
+ * \param       data_:   Pointer to the first byte. May be null if length_ is 0.
+ * \param       length_: Number of bytes.
+ * \param       seed_:   Value selecting one of the family of hash functions.
+ *
+ * \retval      std::uint64_t: Hash of the bytes, the same for any split of them fed to a
+ *                             byte_hasher.
+ *
+ * \warning     Not suited to untrusted keys that may be crafted to collide, nor to persistent
+ *              hashes: the value depends on the byte order of the machine.
+ *************************************************************************************************/
+[[nodiscard]] inline std::uint64_t
+hash_bytes(const void* data_, std::size_t length_, std::uint64_t seed_ = 0) noexcept
+{
+    const std::byte* data = static_cast<const std::byte*>(data_);
+    if(length_ <= hash_medium_limit)
+    {
+        return hash_short(data, length_, seed_);
+    }
+
+    alignas(32) std::uint64_t accumulators[8];
+    hash_initialize(accumulators, seed_);
+
+    std::size_t stripe = 0;
+    hash_accumulate(accumulators, data, (length_ - 1) / hash_stripe_size, stripe);
+    return hash_finish(accumulators, data + length_ - hash_stripe_size, length_, seed_);
+}
+
+
+/**
+ * \brief       Incremental form of hash_bytes, for data that arrives in pieces.
+ *
+ *              Appending the bytes of an input in any number of pieces gives the same digest as
+ *              hash_bytes over the whole input. Small pieces are buffered until a 256-byte buffer
+ *              is full, larger ones are fed to the accumulators straight from the caller's memory.
+ */
+class byte_hasher
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType = std::uint64_t;
+
+private:
+    constexpr static const std::size_t buffer_size = 4 * hash_stripe_size;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit byte_hasher(std::uint64_t seed_ = 0) noexcept : m_seed(seed_) {}
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+
+    /**
+     **********************************************************************************************
+     * \brief   Append bytes to the input.
+     *
+     * \param   data_:   Pointer to the first byte. May be null if length_ is 0.
+     * \param   length_: Number of bytes.
+     **********************************************************************************************/
+    void append(const void* data_, std::size_t length_) noexcept
+    {
+        if(length_ == 0)
+        {
+            return;
+        }
+
+        const std::byte* data = static_cast<const std::byte*>(data_);
+        if(m_length + length_ <= hash_medium_limit)
+        {
+            std::memcpy(pending() + m_buffered, data, length_);
+            m_buffered += length_;
+            m_length += length_;
+            return;
+        }
+
+        /* From here on the input is long: start the accumulators the first time */
+        if(m_length <= hash_medium_limit)
+        {
+            hash_initialize(m_accumulators, m_seed);
+            m_stripe = 0;
+        }
+        m_length += length_;
+
+        const std::size_t taken = std::min(length_, buffer_size - m_buffered);
+        std::memcpy(pending() + m_buffered, data, taken);
+        m_buffered += taken;
+        data += taken;
+        length_ -= taken;
+        if(length_ == 0)
+        {
+            return;
+        }
+
+        /* The buffer is full and more bytes follow, so none of its stripes is the last one. The
+         * last stripe fed is kept in front of the buffer, where the final stripe may reach into */
+        hash_accumulate(m_accumulators, pending(), buffer_size / hash_stripe_size, m_stripe);
+        if(length_ > hash_stripe_size)
+        {
+            const std::size_t stripes = (length_ - 1) / hash_stripe_size;
+            hash_accumulate(m_accumulators, data, stripes, m_stripe);
+            data += stripes * hash_stripe_size;
+            length_ -= stripes * hash_stripe_size;
+            std::memcpy(m_buffer.data(), data - hash_stripe_size, hash_stripe_size);
+        }
+        else
+        {
+            std::memcpy(
+              m_buffer.data(), pending() + buffer_size - hash_stripe_size, hash_stripe_size);
+        }
+
+        std::memcpy(pending(), data, length_);
+        m_buffered = length_;
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Append the bytes of a trivially copyable value to the input.
+     **********************************************************************************************/
+    template<typename ValueType>
+        requires(std::is_trivially_copyable_v<ValueType>)
+    void append(const ValueType& value_) noexcept
+    {
+        append(&value_, sizeof(ValueType));
+    }
+
+    /**
+     **********************************************************************************************
+     * \brief   Forget the input, and start over with a new seed.
+     **********************************************************************************************/
+    void reset(std::uint64_t seed_ = 0) noexcept
+    {
+        m_seed     = seed_;
+        m_length   = 0;
+        m_buffered = 0;
+    }
+
+
+    /*********************************************************************************************/
+    /* Accessors ------------------------------------------------------------------------------- */
+
+    /**
+     **********************************************************************************************
+     * \brief   Hash of the input appended so far. More bytes can still be appended afterwards.
+     **********************************************************************************************/
+    [[nodiscard]] std::uint64_t digest() const noexcept
+    {
+        if(m_length <= hash_medium_limit)
+        {
+            return hash_short(pending(), static_cast<std::size_t>(m_length), m_seed);
+        }
+
+        alignas(32) std::uint64_t accumulators[8];
+        std::memcpy(accumulators, m_accumulators, sizeof(accumulators));
+
+        std::size_t stripe = m_stripe;
+        hash_accumulate(accumulators, pending(), (m_buffered - 1) / hash_stripe_size, stripe);
+        return hash_finish(
+          accumulators, pending() + m_buffered - hash_stripe_size, m_length, m_seed);
+    }
+
+    [[nodiscard]] SizeType length() const noexcept { return m_length; }
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] std::byte*       pending() noexcept { return m_buffer.data() + hash_stripe_size; }
+    [[nodiscard]] const std::byte* pending() const noexcept
+    {
+        return m_buffer.data() + hash_stripe_size;
+    }
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::uint64_t m_seed     = 0;
+    SizeType      m_length   = 0;
+    std::size_t   m_buffered = 0;
+    std::size_t   m_stripe   = 0;
+
+    alignas(32) std::uint64_t m_accumulators[8] = {};
+
+    /* Last stripe fed, then the bytes not fed yet */
+    std::array<std::byte, hash_stripe_size + buffer_size> m_buffer = {};
+};
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,165 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./allocation_telemetry.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Allocator adaptor recording every allocation and deallocation of the allocator it
+ *              wraps into an allocation_telemetry.
+ *
+ *              Rebound copies, such as those containers make for their nodes, record into the same
+ *              telemetry. Lifetimes are opt-in: with TrackLifetimes, each block is allocated with a
+ *              header holding the time it was allocated at, which is how its lifetime is known
+ *              when it is freed. The header takes 8 bytes, or the alignment of the elements if
+ *              larger, and the sizes recorded never include it. Without it, blocks are the wrapped
+ *              allocator's own and the lifetime histogram stays empty.
+ *
+ * \tparam      AllocatorType:  Allocator to wrap, handing out raw pointers.
+ * \tparam      TrackLifetimes: Whether to record the lifetime distribution, at the cost of the
+ *                              header and of a clock read per sampled allocation.
+ */
+template<typename AllocatorType, bool TrackLifetimes = false>
+class instrumented_allocator
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+    using AllocatorTraits = std::allocator_traits<AllocatorType>;
+
+    template<typename, bool>
+    friend class instrumented_allocator;
+
+public:
+    using value_type      = typename AllocatorTraits::value_type;
+    using size_type       = typename AllocatorTraits::size_type;
+    using difference_type = typename AllocatorTraits::difference_type;
+
+    using propagate_on_container_copy_assignment =
+      typename AllocatorTraits::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment =
+      typename AllocatorTraits::propagate_on_container_move_assignment;
+    using propagate_on_container_swap = typename AllocatorTraits::propagate_on_container_swap;
+    using is_always_equal             = std::false_type;
+
+    template<typename OtherType>
+    struct rebind
+    {
+        using other =
+          instrumented_allocator<typename AllocatorTraits::template rebind_alloc<OtherType>,
+                                 TrackLifetimes>;
+    };
+
+    static_assert(std::is_same_v<typename AllocatorTraits::pointer, value_type*>,
+                  "Wrapped allocator must hand out raw pointers");
+
+private:
+    using TimestampType = allocation_telemetry::TimestampType;
+
+    constexpr static const std::size_t header_alignment =
+      alignof(value_type) > alignof(TimestampType) ? alignof(value_type) : alignof(TimestampType);
+
+    /* Unit in which blocks with a header are allocated, the header taking the first one */
+    struct alignas(header_alignment) header_unit
+    {
+        std::byte bytes[header_alignment];
+    };
+
+    using UnitAllocatorType = typename AllocatorTraits::template rebind_alloc<header_unit>;
+    using UnitTraits        = std::allocator_traits<UnitAllocatorType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    instrumented_allocator();
+    explicit instrumented_allocator(allocation_telemetry& telemetry_,
+                                    const AllocatorType&  alloc_ = AllocatorType{}) noexcept;
+
+    template<typename OtherAllocatorType>
+    instrumented_allocator(
+      const instrumented_allocator<OtherAllocatorType, TrackLifetimes>& other_) noexcept;
+
+    [[nodiscard]] instrumented_allocator select_on_container_copy_construction() const;
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] value_type* allocate(size_type count_);
+    void                      deallocate(value_type* items_, size_type count_) noexcept;
+
+    template<typename ObjectType, typename... Args>
+    void construct(ObjectType* object_, Args&&... args_);
+    template<typename ObjectType>
+    void destroy(ObjectType* object_) noexcept;
+
+    [[nodiscard]] size_type max_size() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] static size_type unit_count(size_type count_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Accessors ------------------------------------------------------------------------------- */
+public:
+    [[nodiscard]] allocation_telemetry& telemetry() const noexcept;
+    [[nodiscard]] const AllocatorType&  inner_allocator() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    template<typename OtherAllocatorType>
+    [[nodiscard]] bool operator==(
+      const instrumented_allocator<OtherAllocatorType, TrackLifetimes>& rhs_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    [[no_unique_address]] AllocatorType m_allocator{};
+    allocation_telemetry*               m_telemetry = nullptr;
+};
+
+
+}        // namespace pel
+
+#include "./instrumented_allocator.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
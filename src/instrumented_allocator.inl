@@ -0,0 +1,272 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./instrumented_allocator.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__ typename AllocatorType, bool TrackLifetimes
+
+#define INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__          instrumented_allocator<AllocatorType,        \
+                                                                             TrackLifetimes>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS -------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Wrap a default-constructed allocator, recording into allocation_telemetry::global().
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::instrumented_allocator()
+: m_telemetry{&allocation_telemetry::global()}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Wrap an allocator.
+ *
+ * \param       telemetry_: Statistics to record into. Must outlive every block allocated.
+ * \param       alloc_:     Allocator to wrap.
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::instrumented_allocator(
+  allocation_telemetry& telemetry_, const AllocatorType& alloc_) noexcept
+: m_allocator{alloc_}, m_telemetry{&telemetry_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Rebind another instrumented allocator, keeping its telemetry.
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+template<typename OtherAllocatorType>
+inline INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::instrumented_allocator(
+  const instrumented_allocator<OtherAllocatorType, TrackLifetimes>& other_) noexcept
+: m_allocator{other_.m_allocator}, m_telemetry{other_.m_telemetry}
+{
+}
+
+
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__
+INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::select_on_container_copy_construction() const
+{
+    return instrumented_allocator(
+      *m_telemetry, AllocatorTraits::select_on_container_copy_construction(m_allocator));
+}
+
+
+
+/*************************************************************************************************/
+/* ALLOCATION ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate storage for elements through the wrapped allocator, and record it.
+ *
+ * \param       count_: Number of elements.
+ *
+ * \throws      std::bad_array_new_length
+ *              If count_ is above max_size().
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline typename INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::value_type*
+INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::allocate(size_type count_)
+{
+    if constexpr(TrackLifetimes)
+    {
+        if(count_ > max_size())
+        {
+            throw std::bad_array_new_length();
+        }
+
+        UnitAllocatorType units(m_allocator);
+        header_unit*      block = UnitTraits::allocate(units, unit_count(count_));
+
+        const TimestampType timestamp = m_telemetry->record_allocation(count_ * sizeof(value_type));
+        std::memcpy(block->bytes, &timestamp, sizeof(timestamp));
+        return static_cast<value_type*>(static_cast<void*>(block + 1));
+    }
+    else
+    {
+        value_type* items = AllocatorTraits::allocate(m_allocator, count_);
+        m_telemetry->record_untimed_allocation(count_ * sizeof(value_type));
+        return items;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Record a deallocation, and hand the storage back to the wrapped allocator.
+ *
+ * \param       items_: Storage returned by allocate().
+ * \param       count_: Number of elements given to allocate().
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline void INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::deallocate(value_type* items_,
+                                                              size_type   count_) noexcept
+{
+    if constexpr(TrackLifetimes)
+    {
+        header_unit*  block     = static_cast<header_unit*>(static_cast<void*>(items_)) - 1;
+        TimestampType timestamp = allocation_telemetry::unsampled;
+        std::memcpy(&timestamp, block->bytes, sizeof(timestamp));
+
+        m_telemetry->record_deallocation(count_ * sizeof(value_type), timestamp);
+
+        UnitAllocatorType units(m_allocator);
+        UnitTraits::deallocate(units, block, unit_count(count_));
+    }
+    else
+    {
+        m_telemetry->record_deallocation(count_ * sizeof(value_type),
+                                         allocation_telemetry::unsampled);
+        AllocatorTraits::deallocate(m_allocator, items_, count_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an object through the wrapped allocator, for allocators that customize
+ *              construction.
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+template<typename ObjectType, typename... Args>
+inline void INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::construct(ObjectType* object_, Args&&... args_)
+{
+    AllocatorTraits::construct(m_allocator, object_, std::forward<Args>(args_)...);
+}
+
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+template<typename ObjectType>
+inline void INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::destroy(ObjectType* object_) noexcept
+{
+    AllocatorTraits::destroy(m_allocator, object_);
+}
+
+
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline typename INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::size_type
+INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::max_size() const noexcept
+{
+    if constexpr(TrackLifetimes)
+    {
+        const UnitAllocatorType units(m_allocator);
+        const size_type         fit =
+          (UnitTraits::max_size(units) - 1) * sizeof(header_unit) / sizeof(value_type);
+        return std::min(AllocatorTraits::max_size(m_allocator), fit);
+    }
+    else
+    {
+        return AllocatorTraits::max_size(m_allocator);
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Number of units holding the header and a number of elements.
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline typename INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::size_type
+INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::unit_count(size_type count_) noexcept
+{
+    return 1 + (count_ * sizeof(value_type) + sizeof(header_unit) - 1) / sizeof(header_unit);
+}
+
+
+
+/*************************************************************************************************/
+/* ACCESSORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline allocation_telemetry& INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::telemetry() const noexcept
+{
+    return *m_telemetry;
+}
+
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+inline const AllocatorType& INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::inner_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Two instrumented allocators are equal when their wrapped allocators are, and they
+ *              record into the same telemetry.
+ *************************************************************************************************/
+template<INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__>
+template<typename OtherAllocatorType>
+inline bool INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__::operator==(
+  const instrumented_allocator<OtherAllocatorType, TrackLifetimes>& rhs_) const noexcept
+{
+    return m_allocator == rhs_.m_allocator && m_telemetry == rhs_.m_telemetry;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef INSTRUMENTED_ALLOCATOR_TEMPLATE_DECLARATION__
+#undef INSTRUMENTED_ALLOCATOR_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,222 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./node_iterator_base.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Links of an element in an intrusive_list.
+ *
+ *              Elements derive from it once per list they can be in at the same time, with a
+ *              different TagType for each. Copying an element does not copy its links: the copy is
+ *              in no list.
+ */
+template<typename TagType = void>
+class intrusive_list_hook
+{
+public:
+    constexpr intrusive_list_hook() noexcept = default;
+    constexpr intrusive_list_hook(const intrusive_list_hook& copy_) noexcept;
+    constexpr intrusive_list_hook& operator=(const intrusive_list_hook& copy_) noexcept;
+    ~intrusive_list_hook() = default;
+
+    [[nodiscard]] constexpr bool                 is_linked() const noexcept;
+    [[nodiscard]] constexpr intrusive_list_hook* next() const noexcept;
+    [[nodiscard]] constexpr intrusive_list_hook* prev() const noexcept;
+
+private:
+    template<typename, typename>
+    friend class intrusive_list;
+
+    intrusive_list_hook* m_next = nullptr;
+    intrusive_list_hook* m_prev = nullptr;
+};
+
+
+/**
+ * \brief       Doubly-linked list of elements that hold their own links.
+ *
+ *              The list does not own nor allocate its elements: it links and unlinks objects that
+ *              derive from intrusive_list_hook<TagType>, wherever they live. Inserting and erasing
+ *              never allocate, an element's iterator is found from the element itself with
+ *              iterator_to(), and splicing moves any number of elements between lists by relinking
+ *              the two ends of the range. Erasing a range unlinks it as a whole before marking its
+ *              elements as unlinked.
+ *
+ *              Elements are typically created in a node_pool, so that neighbouring elements are
+ *              close in memory, and given back to it through the *_and_dispose() members.
+ *
+ * \note        An element must outlive its membership in the list.
+ */
+template<typename ItemType, typename TagType = void>
+class intrusive_list
+{
+    static_assert(std::is_base_of_v<intrusive_list_hook<TagType>, ItemType>,
+                  "Elements must derive from intrusive_list_hook<TagType>");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using HookType           = intrusive_list_hook<TagType>;
+    using SizeType           = std::size_t;
+    using DifferenceType     = std::ptrdiff_t;
+    using ValueType          = ItemType;
+    using IteratorType       = node_iterator_base<ItemType, HookType>;
+    using ConstIteratorType  = node_iterator_base<const ItemType, HookType>;
+    using RIteratorType      = std::reverse_iterator<IteratorType>;
+    using ConstRIteratorType = std::reverse_iterator<ConstIteratorType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    intrusive_list() noexcept;
+
+    intrusive_list(const intrusive_list& copy_) = delete;
+    intrusive_list(intrusive_list&& move_) noexcept;
+    intrusive_list& operator=(const intrusive_list& copy_) = delete;
+    intrusive_list& operator=(intrusive_list&& move_) noexcept;
+
+    ~intrusive_list();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&       front();
+    [[nodiscard]] ItemType&       back();
+    [[nodiscard]] const ItemType& front() const;
+    [[nodiscard]] const ItemType& back() const;
+
+    [[nodiscard]] IteratorType      iterator_to(ItemType& item_) noexcept;
+    [[nodiscard]] ConstIteratorType iterator_to(const ItemType& item_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType       begin() noexcept;
+    [[nodiscard]] IteratorType       end() noexcept;
+    [[nodiscard]] ConstIteratorType  begin() const noexcept;
+    [[nodiscard]] ConstIteratorType  end() const noexcept;
+    [[nodiscard]] ConstIteratorType  cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType  cend() const noexcept;
+    [[nodiscard]] RIteratorType      rbegin() noexcept;
+    [[nodiscard]] RIteratorType      rend() noexcept;
+    [[nodiscard]] ConstRIteratorType rbegin() const noexcept;
+    [[nodiscard]] ConstRIteratorType rend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    void push_front(ItemType& item_);
+    void push_back(ItemType& item_);
+    void pop_front();
+    void pop_back();
+
+    IteratorType insert(IteratorType position_, ItemType& item_);
+
+    IteratorType erase(IteratorType position_) noexcept;
+    IteratorType erase(IteratorType first_, IteratorType last_) noexcept;
+    template<typename DisposerType>
+    IteratorType erase_and_dispose(IteratorType position_, DisposerType&& disposer_);
+    template<typename DisposerType>
+    IteratorType erase_and_dispose(IteratorType   first_,
+                                   IteratorType   last_,
+                                   DisposerType&& disposer_);
+
+    template<typename PredicateType>
+    SizeType remove_if(PredicateType&& predicate_);
+    template<typename PredicateType, typename DisposerType>
+    SizeType remove_and_dispose_if(PredicateType&& predicate_, DisposerType&& disposer_);
+
+    void clear() noexcept;
+    template<typename DisposerType>
+    void clear_and_dispose(DisposerType&& disposer_);
+
+    void splice(IteratorType position_, intrusive_list& other_) noexcept;
+    void splice(IteratorType position_, intrusive_list& other_, IteratorType item_) noexcept;
+    void splice(IteratorType    position_,
+                intrusive_list& other_,
+                IteratorType    first_,
+                IteratorType    last_) noexcept;
+    void splice(IteratorType    position_,
+                intrusive_list& other_,
+                IteratorType    first_,
+                IteratorType    last_,
+                SizeType        count_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType length() const noexcept;
+    [[nodiscard]] bool     is_empty() const noexcept;
+    [[nodiscard]] bool     is_not_empty() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    static void link_before(HookType* position_, HookType* first_, HookType* last_) noexcept;
+    static void unlink_range(HookType* first_, HookType* last_) noexcept;
+
+    void reset_root() noexcept;
+    void take(intrusive_list& other_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    /* Sentinel: its next and previous nodes are the first and last elements, or itself */
+    HookType m_root;
+    SizeType m_length = 0;
+
+    constexpr static const bool container_safeness = true;
+};
+
+
+}        // namespace pel
+
+#include "./intrusive_list.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
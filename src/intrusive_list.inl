@@ -0,0 +1,727 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./intrusive_list.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define INTRUSIVE_LIST_TEMPLATE_DECLARATION__ typename ItemType, typename TagType
+#define INTRUSIVE_LIST_CLASS_SCOPE__          intrusive_list<ItemType, TagType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* HOOK ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<typename TagType>
+constexpr inline intrusive_list_hook<TagType>::intrusive_list_hook(
+  [[maybe_unused]] const intrusive_list_hook& copy_) noexcept
+{
+}
+
+template<typename TagType>
+constexpr inline intrusive_list_hook<TagType>&
+intrusive_list_hook<TagType>::operator=([[maybe_unused]] const intrusive_list_hook& copy_) noexcept
+{
+    return *this;
+}
+
+template<typename TagType>
+[[nodiscard]] constexpr inline bool intrusive_list_hook<TagType>::is_linked() const noexcept
+{
+    return m_next != nullptr;
+}
+
+template<typename TagType>
+[[nodiscard]] constexpr inline intrusive_list_hook<TagType>*
+intrusive_list_hook<TagType>::next() const noexcept
+{
+    return m_next;
+}
+
+template<typename TagType>
+[[nodiscard]] constexpr inline intrusive_list_hook<TagType>*
+intrusive_list_hook<TagType>::prev() const noexcept
+{
+    return m_prev;
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline INTRUSIVE_LIST_CLASS_SCOPE__::intrusive_list() noexcept
+{
+    reset_root();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the elements of another list, leaving it empty.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline INTRUSIVE_LIST_CLASS_SCOPE__::intrusive_list(intrusive_list&& move_) noexcept
+{
+    reset_root();
+    take(move_);
+}
+
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline INTRUSIVE_LIST_CLASS_SCOPE__&
+INTRUSIVE_LIST_CLASS_SCOPE__::operator=(intrusive_list&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        clear();
+        take(move_);
+    }
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unlink every element. The elements themselves are left alone.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline INTRUSIVE_LIST_CLASS_SCOPE__::~intrusive_list()
+{
+    clear();
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the first or last element.
+ *
+ * \throw       std::length_error
+ *              If the list is empty.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline ItemType& INTRUSIVE_LIST_CLASS_SCOPE__::front()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return static_cast<ItemType&>(*m_root.m_next);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline ItemType& INTRUSIVE_LIST_CLASS_SCOPE__::back()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return static_cast<ItemType&>(*m_root.m_prev);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline const ItemType& INTRUSIVE_LIST_CLASS_SCOPE__::front() const
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return static_cast<const ItemType&>(*m_root.m_next);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline const ItemType& INTRUSIVE_LIST_CLASS_SCOPE__::back() const
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return static_cast<const ItemType&>(*m_root.m_prev);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Iterator to an element of the list, in O(1).
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::iterator_to(ItemType& item_) noexcept
+{
+    return IteratorType(static_cast<HookType*>(&item_));
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::ConstIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::iterator_to(const ItemType& item_) const noexcept
+{
+    return ConstIteratorType(static_cast<const HookType*>(&item_));
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::begin() noexcept
+{
+    return IteratorType(m_root.m_next);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::end() noexcept
+{
+    return IteratorType(&m_root);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::ConstIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::begin() const noexcept
+{
+    return ConstIteratorType(m_root.m_next);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::ConstIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::end() const noexcept
+{
+    return ConstIteratorType(&m_root);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::ConstIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::ConstIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::RIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::rbegin() noexcept
+{
+    return RIteratorType(end());
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::RIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::rend() noexcept
+{
+    return RIteratorType(begin());
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::ConstRIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::rbegin() const noexcept
+{
+    return ConstRIteratorType(end());
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::ConstRIteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::rend() const noexcept
+{
+    return ConstRIteratorType(begin());
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::push_front(ItemType& item_)
+{
+    insert(begin(), item_);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::push_back(ItemType& item_)
+{
+    insert(end(), item_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unlink the first or last element.
+ *
+ * \throw       std::length_error
+ *              If the list is empty.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::pop_front()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    erase(begin());
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::pop_back()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(m_length == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    erase(IteratorType(m_root.m_prev));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Link an element before a position, in O(1).
+ *
+ * \param       position_: Element to insert before, or end().
+ * \param       item_:     Element to link. It must not be in a list using the same hook.
+ *
+ * \retval      IteratorType: Iterator to the element.
+ *
+ * \throws      std::invalid_argument("Element already in a list")
+ *              If the element's hook is already linked.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::insert(IteratorType position_, ItemType& item_)
+{
+    HookType* node = static_cast<HookType*>(&item_);
+    if constexpr(container_safeness == true)
+    {
+        if(node->is_linked())
+        {
+            throw std::invalid_argument("Element already in a list");
+        }
+    }
+
+    link_before(position_.node(), node, node);
+    ++m_length;
+    return IteratorType(node);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unlink an element, or a range of elements.
+ *
+ * \retval      IteratorType: Iterator to the element that followed the last one erased.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::erase(IteratorType position_) noexcept
+{
+    return erase_and_dispose(position_, [](ItemType*) noexcept {});
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::erase(IteratorType first_, IteratorType last_) noexcept
+{
+    return erase_and_dispose(first_, last_, [](ItemType*) noexcept {});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unlink an element, then give it to a disposer, for instance to destroy it.
+ *
+ * \param       position_: Element to erase.
+ * \param       disposer_: Callable taking an ItemType*, called once the element is unlinked.
+ *
+ * \retval      IteratorType: Iterator to the element that followed the one erased.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+template<typename DisposerType>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::erase_and_dispose(IteratorType position_, DisposerType&& disposer_)
+{
+    HookType* node = position_.node();
+    HookType* next = node->m_next;
+
+    unlink_range(node, node);
+    node->m_next = nullptr;
+    node->m_prev = nullptr;
+    --m_length;
+
+    disposer_(static_cast<ItemType*>(node));
+    return IteratorType(next);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unlink a range of elements at once, then mark each one as unlinked and give it to a
+ *              disposer.
+ *
+ * \param       first_:    First element to erase.
+ * \param       last_:     Element after the last one to erase, or end().
+ * \param       disposer_: Callable taking an ItemType*, called once per element.
+ *
+ * \retval      IteratorType: last_.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+template<typename DisposerType>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::IteratorType
+INTRUSIVE_LIST_CLASS_SCOPE__::erase_and_dispose(
+  IteratorType first_, IteratorType last_, DisposerType&& disposer_)
+{
+    if(first_ == last_)
+    {
+        return last_;
+    }
+
+    HookType* const end = last_.node();
+    unlink_range(first_.node(), end->m_prev);
+
+    for(HookType* node = first_.node(); node != end;)
+    {
+        HookType* next = node->m_next;
+        node->m_next   = nullptr;
+        node->m_prev   = nullptr;
+        --m_length;
+
+        disposer_(static_cast<ItemType*>(node));
+        node = next;
+    }
+    return last_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Unlink every element for which a predicate is true.
+ *
+ * \retval      SizeType: Number of elements erased.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+template<typename PredicateType>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::SizeType
+INTRUSIVE_LIST_CLASS_SCOPE__::remove_if(PredicateType&& predicate_)
+{
+    return remove_and_dispose_if(std::forward<PredicateType>(predicate_),
+                                 [](ItemType*) noexcept {});
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+template<typename PredicateType, typename DisposerType>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::SizeType
+INTRUSIVE_LIST_CLASS_SCOPE__::remove_and_dispose_if(PredicateType&& predicate_,
+                                                    DisposerType&&  disposer_)
+{
+    const SizeType oldLength = m_length;
+    for(IteratorType it = begin(); it != end();)
+    {
+        if(predicate_(*it))
+        {
+            it = erase_and_dispose(it, disposer_);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return oldLength - m_length;
+}
+
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::clear() noexcept
+{
+    clear_and_dispose([](ItemType*) noexcept {});
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+template<typename DisposerType>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::clear_and_dispose(DisposerType&& disposer_)
+{
+    erase_and_dispose(begin(), end(), disposer_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move every element of another list before a position, in O(1).
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void
+INTRUSIVE_LIST_CLASS_SCOPE__::splice(IteratorType position_, intrusive_list& other_) noexcept
+{
+    if(&other_ == this || other_.is_empty())
+    {
+        return;
+    }
+
+    HookType* first = other_.m_root.m_next;
+    HookType* last  = other_.m_root.m_prev;
+    other_.reset_root();
+    link_before(position_.node(), first, last);
+
+    m_length += std::exchange(other_.m_length, 0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move one element of a list, which may be this one, before a position, in O(1).
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::splice(IteratorType    position_,
+                                                 intrusive_list& other_,
+                                                 IteratorType    item_) noexcept
+{
+    HookType* node = item_.node();
+    if(node == position_.node() || node->m_next == position_.node())
+    {
+        return;
+    }
+
+    unlink_range(node, node);
+    link_before(position_.node(), node, node);
+
+    --other_.m_length;
+    ++m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move a range of elements of a list, which may be this one, before a position.
+ *              O(1) within a list; between lists, the range is walked once to count it, unless
+ *              the count is given.
+ *
+ * \param       position_: Element to move the range before, or end(). Not in the range.
+ * \param       other_:    List holding the range.
+ * \param       first_:    First element to move.
+ * \param       last_:     Element after the last one to move, or other_.end().
+ * \param       count_:    Number of elements in the range.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::splice(IteratorType    position_,
+                                                 intrusive_list& other_,
+                                                 IteratorType    first_,
+                                                 IteratorType    last_) noexcept
+{
+    const SizeType count =
+      &other_ == this ? 0 : static_cast<SizeType>(std::distance(first_, last_));
+    splice(position_, other_, first_, last_, count);
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::splice(IteratorType    position_,
+                                                 intrusive_list& other_,
+                                                 IteratorType    first_,
+                                                 IteratorType    last_,
+                                                 SizeType        count_) noexcept
+{
+    if(first_ == last_ || last_ == position_)
+    {
+        return;
+    }
+
+    HookType* first = first_.node();
+    HookType* last  = last_.node()->m_prev;
+    unlink_range(first, last);
+    link_before(position_.node(), first, last);
+
+    if(&other_ != this)
+    {
+        other_.m_length -= count_;
+        m_length += count_;
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline typename INTRUSIVE_LIST_CLASS_SCOPE__::SizeType
+INTRUSIVE_LIST_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline bool INTRUSIVE_LIST_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline bool INTRUSIVE_LIST_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_length != 0;
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline std::string INTRUSIVE_LIST_CLASS_SCOPE__::to_string() const
+{
+    std::stringstream ss;
+    ss << "[";
+    for(ConstIteratorType it = begin(); it != end(); ++it)
+    {
+        if(it != begin())
+        {
+            ss << ", ";
+        }
+        if constexpr(requires { ss << *it; })
+        {
+            ss << *it;
+        }
+        else
+        {
+            ss << "?";
+        }
+    }
+    ss << "]";
+    return ss.str();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Link the chain of nodes first_ to last_, inclusive, before a node.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::link_before(HookType* position_,
+                                                      HookType* first_,
+                                                      HookType* last_) noexcept
+{
+    HookType* previous = position_->m_prev;
+
+    previous->m_next  = first_;
+    first_->m_prev    = previous;
+    last_->m_next     = position_;
+    position_->m_prev = last_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take the nodes first_ to last_, inclusive, out of their list.
+ *              Their own links are left as they are.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::unlink_range(HookType* first_, HookType* last_) noexcept
+{
+    first_->m_prev->m_next = last_->m_next;
+    last_->m_next->m_prev  = first_->m_prev;
+}
+
+
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::reset_root() noexcept
+{
+    m_root.m_next = &m_root;
+    m_root.m_prev = &m_root;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements of another list into this empty one.
+ *************************************************************************************************/
+template<INTRUSIVE_LIST_TEMPLATE_DECLARATION__>
+inline void INTRUSIVE_LIST_CLASS_SCOPE__::take(intrusive_list& other_) noexcept
+{
+    if(other_.is_empty())
+    {
+        return;
+    }
+
+    m_root.m_next         = other_.m_root.m_next;
+    m_root.m_prev         = other_.m_root.m_prev;
+    m_root.m_next->m_prev = &m_root;
+    m_root.m_prev->m_next = &m_root;
+    m_length              = std::exchange(other_.m_length, 0);
+    other_.reset_root();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef INTRUSIVE_LIST_TEMPLATE_DECLARATION__
+#undef INTRUSIVE_LIST_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -2,8 +2,8 @@
  * @file    container_base/src/main.cpp
  */
 
-#include "src/container_base.h"
-#include "src/iterator_base.h"
+#include "src/container_base.hpp"
+#include "src/iterator_base.hpp"
 
 #include "test/testContainer.hpp"
 
@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Bounded lock-free queue for any number of producers and consumers.
+ *
+ *              Each slot carries a sequence number telling which lap of the ring it belongs to,
+ *              so producers and consumers only contend on the enqueue/dequeue counters and never
+ *              on a lock. The blocking operations spin for a short while before sleeping on the
+ *              sequence number of the slot they are waiting for (std::atomic::wait, which is backed
+ *              by a futex on Linux).
+ */
+template<typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+class mpmc_queue
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(std::is_nothrow_move_constructible_v<ItemType>,
+                  "A claimed slot must always be filled, so moving an element must not throw");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using AllocatorTraits = std::allocator_traits<AllocatorType>;
+    using SizeType        = std::size_t;
+    using DifferenceType  = std::ptrdiff_t;
+
+private:
+    struct slot_type
+    {
+        std::atomic<SizeType> sequence{0};
+        alignas(ItemType) std::byte storage[sizeof(ItemType)];
+    };
+
+    using SlotAllocatorType = typename AllocatorTraits::template rebind_alloc<slot_type>;
+    using SlotTraits        = std::allocator_traits<SlotAllocatorType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit mpmc_queue(SizeType capacity_, const AllocatorType& alloc_ = AllocatorType{});
+    ~mpmc_queue();
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+    mpmc_queue(mpmc_queue&&)                 = delete;
+    mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+
+    /*********************************************************************************************/
+    /* Non-blocking operations ----------------------------------------------------------------- */
+    template<typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args_);
+    [[nodiscard]] bool try_push(const ItemType& item_);
+    [[nodiscard]] bool try_push(ItemType&& item_);
+    [[nodiscard]] bool try_pop(ItemType& item_);
+
+    template<typename InputIterator>
+    SizeType try_push_bulk(InputIterator first_, SizeType count_);
+    template<typename OutputIterator>
+    SizeType try_pop_bulk(OutputIterator first_, SizeType maxCount_);
+
+
+    /*********************************************************************************************/
+    /* Blocking operations --------------------------------------------------------------------- */
+    template<typename... Args>
+    void emplace(Args&&... args_);
+    void push(const ItemType& item_);
+    void push(ItemType&& item_);
+    void pop(ItemType& item_);
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             capacity() const noexcept;
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] ItemType* item_of(slot_type& slot_) noexcept;
+
+    [[nodiscard]] SizeType claim_push(SizeType& position_, SizeType count_) noexcept;
+    [[nodiscard]] SizeType claim_pop(SizeType& position_, SizeType count_) noexcept;
+
+    void publish(slot_type& slot_, SizeType sequence_, std::atomic<std::uint32_t>& waiters_);
+    void notify(SizeType position_, SizeType count_, std::atomic<std::uint32_t>& waiters_) noexcept;
+    void wait_for_push() noexcept;
+    void wait_for_pop() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    alignas(cache_line_size) std::atomic<SizeType> m_enqueuePosition{0};
+    alignas(cache_line_size) std::atomic<SizeType> m_dequeuePosition{0};
+
+    /* Number of threads sleeping in push() and pop(), so the fast paths can skip notifying */
+    alignas(cache_line_size) std::atomic<std::uint32_t> m_pushWaiters{0};
+    std::atomic<std::uint32_t> m_popWaiters{0};
+
+    /* Read-only after construction */
+    alignas(cache_line_size) slot_type* m_slots = nullptr;
+    SizeType          m_capacity                = 0;
+    SizeType          m_mask                    = 0;
+    AllocatorType     m_allocator{};
+    SlotAllocatorType m_slotAllocator{};
+
+    constexpr static const SizeType spin_count = 64;
+};
+
+
+}        // namespace pel
+
+#include "./mpmc_queue.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,688 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./mpmc_queue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define MPMC_QUEUE_TEMPLATE_DECLARATION__       typename ItemType,                                 \
+                                                typename AllocatorType
+
+#define MPMC_QUEUE_CLASS_SCOPE__                mpmc_queue<ItemType,                               \
+                                                           AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate the slot array and stamp every slot with its first-lap sequence number.
+ *
+ * \param       capacity_: Minimum number of elements the queue must hold.
+ *                         Rounded up to the next power of two (and to at least 2).
+ * \param       alloc_:    Allocator used for the elements; rebound for the slot array.
+ *
+ * \throws      std::invalid_argument("Queue capacity must not be zero")
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+MPMC_QUEUE_CLASS_SCOPE__::mpmc_queue(SizeType capacity_, const AllocatorType& alloc_)
+: m_allocator{alloc_}, m_slotAllocator{alloc_}
+{
+    if(capacity_ == 0)
+    {
+        throw std::invalid_argument("Queue capacity must not be zero");
+    }
+
+    m_capacity = std::bit_ceil(std::max<SizeType>(capacity_, 2));
+    m_mask     = m_capacity - 1;
+    m_slots    = SlotTraits::allocate(m_slotAllocator, m_capacity);
+
+    for(SizeType i = 0; i < m_capacity; ++i)
+    {
+        SlotTraits::construct(m_slotAllocator, m_slots + i);
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the elements still in the queue and release the slot array.
+ *              No other thread may use the queue anymore.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+MPMC_QUEUE_CLASS_SCOPE__::~mpmc_queue()
+{
+    const SizeType enqueuePosition = m_enqueuePosition.load(std::memory_order_acquire);
+    for(SizeType position = m_dequeuePosition.load(std::memory_order_acquire);
+        position != enqueuePosition;
+        ++position)
+    {
+        AllocatorTraits::destroy(m_allocator, item_of(m_slots[position & m_mask]));
+    }
+
+    for(SizeType i = 0; i < m_capacity; ++i)
+    {
+        SlotTraits::destroy(m_slotAllocator, m_slots + i);
+    }
+    SlotTraits::deallocate(m_slotAllocator, m_slots, m_capacity);
+}
+
+
+/*************************************************************************************************/
+/* NON-BLOCKING OPERATIONS --------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in place at the back of the queue, if there is room.
+ *
+ * \param       args_: Arguments forwarded to the element's constructor.
+ *
+ * \retval      bool: False if the queue was full and nothing was pushed.
+ *
+ * \note        When the constructor may throw, the element is built before a slot is claimed so
+ *              that a claimed slot is always published.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+[[nodiscard]] inline bool
+MPMC_QUEUE_CLASS_SCOPE__::try_emplace(Args&&... args_)
+{
+    if constexpr(std::is_nothrow_constructible_v<ItemType, Args&&...>)
+    {
+        SizeType position = 0;
+        if(claim_push(position, 1) == 0)
+        {
+            return false;
+        }
+
+        slot_type& slot = m_slots[position & m_mask];
+        AllocatorTraits::construct(m_allocator, item_of(slot), std::forward<Args>(args_)...);
+        publish(slot, position + 1, m_popWaiters);
+        return true;
+    }
+    else
+    {
+        ItemType item(std::forward<Args>(args_)...);
+        return try_emplace(std::move(item));
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy an element at the back of the queue, if there is room.
+ *
+ * \retval      bool: False if the queue was full and nothing was pushed.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+MPMC_QUEUE_CLASS_SCOPE__::try_push(const ItemType& item_)
+{
+    return try_emplace(item_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element at the back of the queue, if there is room.
+ *
+ * \retval      bool: False if the queue was full and nothing was pushed.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+MPMC_QUEUE_CLASS_SCOPE__::try_push(ItemType&& item_)
+{
+    return try_emplace(std::move(item_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the element at the front of the queue out, if there is one.
+ *
+ * \param       item_: Destination of the element.
+ *
+ * \retval      bool: False if the queue was empty and nothing was popped.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+MPMC_QUEUE_CLASS_SCOPE__::try_pop(ItemType& item_)
+{
+    SizeType position = 0;
+    if(claim_pop(position, 1) == 0)
+    {
+        return false;
+    }
+
+    /* The slot is released before assigning to item_, which may throw */
+    slot_type& slot = m_slots[position & m_mask];
+    ItemType*  item = item_of(slot);
+    ItemType   popped(std::move(*item));
+    AllocatorTraits::destroy(m_allocator, item);
+    publish(slot, position + m_capacity, m_pushWaiters);
+
+    item_ = std::move(popped);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Push as many elements of a range as there is room for, claiming all the slots with a
+ *              single compare-and-swap.
+ *
+ * \param       first_: Start of the elements to push. Use std::make_move_iterator to move them.
+ * \param       count_: Number of elements available from first_.
+ *
+ * \retval      SizeType: Number of elements pushed; the first that many elements were consumed.
+ *
+ * \note        When constructing an element may throw, each element is built before its slot is
+ *              claimed, as try_emplace() does, and the slots are claimed one at a time.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline typename MPMC_QUEUE_CLASS_SCOPE__::SizeType
+MPMC_QUEUE_CLASS_SCOPE__::try_push_bulk(InputIterator first_, SizeType count_)
+{
+    if constexpr(std::is_nothrow_constructible_v<ItemType, std::iter_reference_t<InputIterator>>)
+    {
+        SizeType       position = 0;
+        const SizeType claimed  = count_ == 0 ? 0 : claim_push(position, count_);
+
+        for(SizeType i = 0; i < claimed; ++i, ++first_)
+        {
+            slot_type& slot = m_slots[(position + i) & m_mask];
+            AllocatorTraits::construct(m_allocator, item_of(slot), *first_);
+            slot.sequence.store(position + i + 1, std::memory_order_release);
+        }
+
+        notify(position, claimed, m_popWaiters);
+        return claimed;
+    }
+    else
+    {
+        SizeType pushed = 0;
+        for(; pushed < count_; ++pushed, ++first_)
+        {
+            if(try_emplace(*first_) == false)
+            {
+                break;
+            }
+        }
+        return pushed;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Pop up to a number of elements, claiming all the slots with a single
+ *              compare-and-swap.
+ *
+ * \param       first_:    Output iterator the elements are moved to.
+ * \param       maxCount_: Maximum number of elements to pop.
+ *
+ * \retval      SizeType: Number of elements popped.
+ *
+ * \note        If writing to the output throws, the element being written and the rest of the
+ *              claimed elements are dropped, so that every claimed slot is still released.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+template<typename OutputIterator>
+inline typename MPMC_QUEUE_CLASS_SCOPE__::SizeType
+MPMC_QUEUE_CLASS_SCOPE__::try_pop_bulk(OutputIterator first_, SizeType maxCount_)
+{
+    SizeType       position = 0;
+    const SizeType claimed  = maxCount_ == 0 ? 0 : claim_pop(position, maxCount_);
+    SizeType       released = 0;
+
+    try
+    {
+        while(released < claimed)
+        {
+            slot_type& slot = m_slots[(position + released) & m_mask];
+            ItemType*  item = item_of(slot);
+            ItemType   popped(std::move(*item));
+            AllocatorTraits::destroy(m_allocator, item);
+            slot.sequence.store(position + released + m_capacity, std::memory_order_release);
+            ++released;
+
+            *first_ = std::move(popped);
+            ++first_;
+        }
+    }
+    catch(...)
+    {
+        for(; released < claimed; ++released)
+        {
+            slot_type& slot = m_slots[(position + released) & m_mask];
+            AllocatorTraits::destroy(m_allocator, item_of(slot));
+            slot.sequence.store(position + released + m_capacity, std::memory_order_release);
+        }
+        notify(position, claimed, m_pushWaiters);
+        throw;
+    }
+
+    notify(position, claimed, m_pushWaiters);
+    return claimed;
+}
+
+
+/*************************************************************************************************/
+/* BLOCKING OPERATIONS ------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element at the back of the queue, waiting for room if it is full.
+ *
+ * \param       args_: Arguments forwarded to the element's constructor.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::emplace(Args&&... args_)
+{
+    ItemType item(std::forward<Args>(args_)...);
+    push(std::move(item));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy an element at the back of the queue, waiting for room if it is full.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::push(const ItemType& item_)
+{
+    push(ItemType(item_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element at the back of the queue, waiting for room if it is full.
+ *              Spins for a short while, then sleeps until a consumer frees the awaited slot.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::push(ItemType&& item_)
+{
+    for(SizeType spin = 0; try_emplace(std::move(item_)) == false; ++spin)
+    {
+        if(spin < spin_count)
+        {
+            cpu_relax();
+        }
+        else
+        {
+            wait_for_push();
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the element at the front of the queue out, waiting for one if it is empty.
+ *              Spins for a short while, then sleeps until a producer fills the awaited slot.
+ *
+ * \param       item_: Destination of the element.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::pop(ItemType& item_)
+{
+    for(SizeType spin = 0; try_pop(item_) == false; ++spin)
+    {
+        if(spin < spin_count)
+        {
+            cpu_relax();
+        }
+        else
+        {
+            wait_for_pop();
+        }
+    }
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of slots of the queue.
+ *
+ * \retval      SizeType: Capacity of the queue, always a power of two.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename MPMC_QUEUE_CLASS_SCOPE__::SizeType
+MPMC_QUEUE_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Return the number of claimed slots in the queue.
+ *
+ * \retval      SizeType: Approximate number of elements in the queue.
+ *
+ * \note        Only a snapshot while other threads are pushing or popping.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename MPMC_QUEUE_CLASS_SCOPE__::SizeType
+MPMC_QUEUE_CLASS_SCOPE__::length() const noexcept
+{
+    const SizeType dequeuePosition = m_dequeuePosition.load(std::memory_order_acquire);
+    const SizeType enqueuePosition = m_enqueuePosition.load(std::memory_order_acquire);
+
+    if(enqueuePosition <= dequeuePosition)
+    {
+        return 0;
+    }
+    return std::min(enqueuePosition - dequeuePosition, m_capacity);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns true if there are no elements in the queue.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+MPMC_QUEUE_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return length() == 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns a const reference to the queue's allocator.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const AllocatorType&
+MPMC_QUEUE_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain a pointer to the element storage of a slot.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType*
+MPMC_QUEUE_CLASS_SCOPE__::item_of(slot_type& slot_) noexcept
+{
+    return std::launder(reinterpret_cast<ItemType*>(slot_.storage));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Claim a run of consecutive free slots at the back of the queue.
+ *              Slots whose sequence number matches their position are free for this lap; as the
+ *              enqueue counter can only move past them through this compare-and-swap, checking
+ *              them before claiming is safe.
+ *
+ * \param       position_: Receives the position of the first claimed slot.
+ * \param       count_:    Maximum number of slots to claim.
+ *
+ * \retval      SizeType: Number of slots claimed. 0 if the queue is full.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename MPMC_QUEUE_CLASS_SCOPE__::SizeType
+MPMC_QUEUE_CLASS_SCOPE__::claim_push(SizeType& position_, SizeType count_) noexcept
+{
+    SizeType position = m_enqueuePosition.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        SizeType claimable = 0;
+        while(claimable < count_)
+        {
+            const slot_type& slot     = m_slots[(position + claimable) & m_mask];
+            const SizeType   sequence = slot.sequence.load(std::memory_order_acquire);
+            if(sequence != position + claimable)
+            {
+                break;
+            }
+            ++claimable;
+        }
+
+        if(claimable != 0)
+        {
+            if(m_enqueuePosition.compare_exchange_weak(position,
+                                                       position + claimable,
+                                                       std::memory_order_relaxed,
+                                                       std::memory_order_relaxed))
+            {
+                position_ = position;
+                return claimable;
+            }
+            continue;
+        }
+
+        const SizeType sequence =
+          m_slots[position & m_mask].sequence.load(std::memory_order_acquire);
+        if(static_cast<DifferenceType>(sequence - position) < 0)
+        {
+            /* The slot still holds an element from the previous lap */
+            return 0;
+        }
+        position = m_enqueuePosition.load(std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Claim a run of consecutive filled slots at the front of the queue.
+ *
+ * \param       position_: Receives the position of the first claimed slot.
+ * \param       count_:    Maximum number of slots to claim.
+ *
+ * \retval      SizeType: Number of slots claimed. 0 if the queue is empty.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename MPMC_QUEUE_CLASS_SCOPE__::SizeType
+MPMC_QUEUE_CLASS_SCOPE__::claim_pop(SizeType& position_, SizeType count_) noexcept
+{
+    SizeType position = m_dequeuePosition.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        SizeType claimable = 0;
+        while(claimable < count_)
+        {
+            const slot_type& slot     = m_slots[(position + claimable) & m_mask];
+            const SizeType   sequence = slot.sequence.load(std::memory_order_acquire);
+            if(sequence != position + claimable + 1)
+            {
+                break;
+            }
+            ++claimable;
+        }
+
+        if(claimable != 0)
+        {
+            if(m_dequeuePosition.compare_exchange_weak(position,
+                                                       position + claimable,
+                                                       std::memory_order_relaxed,
+                                                       std::memory_order_relaxed))
+            {
+                position_ = position;
+                return claimable;
+            }
+            continue;
+        }
+
+        const SizeType sequence =
+          m_slots[position & m_mask].sequence.load(std::memory_order_acquire);
+        if(static_cast<DifferenceType>(sequence - (position + 1)) < 0)
+        {
+            /* The slot has not been filled for this lap yet */
+            return 0;
+        }
+        position = m_dequeuePosition.load(std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Hand a slot over to the other side of the queue, waking sleepers if there are any.
+ *
+ * \param       slot_:     Slot that was filled or emptied.
+ * \param       sequence_: New sequence number of the slot.
+ * \param       waiters_:  Sleeper count of the side the slot is handed to.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::publish(slot_type&                  slot_,
+                                  SizeType                    sequence_,
+                                  std::atomic<std::uint32_t>& waiters_)
+{
+    slot_.sequence.store(sequence_, std::memory_order_release);
+
+    /* Pairs with the fence in wait_for_push() / wait_for_pop(): either the sleeper sees the new
+     * sequence number, or this thread sees the sleeper */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(waiters_.load(std::memory_order_relaxed) != 0)
+    {
+        slot_.sequence.notify_all();
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Wake the sleepers waiting on a run of slots handed over with plain stores, if there
+ *              are any.
+ *
+ * \param       position_: Position of the first slot of the run.
+ * \param       count_:    Number of slots in the run.
+ * \param       waiters_:  Sleeper count of the side the slots are handed to.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::notify(SizeType                    position_,
+                                 SizeType                    count_,
+                                 std::atomic<std::uint32_t>& waiters_) noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(waiters_.load(std::memory_order_relaxed) != 0)
+    {
+        for(SizeType i = 0; i < count_; ++i)
+        {
+            m_slots[(position_ + i) & m_mask].sequence.notify_all();
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Sleep until the slot at the back of the queue is freed by a consumer.
+ *              Returns immediately if it already is; callers retry in a loop.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::wait_for_push() noexcept
+{
+    const SizeType position = m_enqueuePosition.load(std::memory_order_relaxed);
+    slot_type&     slot     = m_slots[position & m_mask];
+    const SizeType sequence = slot.sequence.load(std::memory_order_acquire);
+    if(static_cast<DifferenceType>(sequence - position) >= 0)
+    {
+        return;
+    }
+
+    m_pushWaiters.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    slot.sequence.wait(sequence, std::memory_order_acquire);
+    m_pushWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Sleep until the slot at the front of the queue is filled by a producer.
+ *              Returns immediately if it already is; callers retry in a loop.
+ *************************************************************************************************/
+template<MPMC_QUEUE_TEMPLATE_DECLARATION__>
+inline void
+MPMC_QUEUE_CLASS_SCOPE__::wait_for_pop() noexcept
+{
+    const SizeType position = m_dequeuePosition.load(std::memory_order_relaxed);
+    slot_type&     slot     = m_slots[position & m_mask];
+    const SizeType sequence = slot.sequence.load(std::memory_order_acquire);
+    if(static_cast<DifferenceType>(sequence - (position + 1)) >= 0)
+    {
+        return;
+    }
+
+    m_popWaiters.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    slot.sequence.wait(sequence, std::memory_order_acquire);
+    m_popWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef MPMC_QUEUE_TEMPLATE_DECLARATION__
+#undef MPMC_QUEUE_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,247 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+#include "./ndarray_layout.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Non-owning view of a Rank-dimensional array: a data pointer and a layout mapping.
+ *
+ *              Mirrors the std::mdspan interface (extents(), mapping(), data_handle(), operator()
+ *              with one index per dimension), and adds bounds-checked at(), zero-copy slicing and
+ *              iteration over the indices. A view of const ElementType converts from a mutable one.
+ */
+template<typename ElementType, std::size_t Rank, typename LayoutType = layout_row_major>
+class ndarray_view
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using extents_type     = ndarray_extents<Rank>;
+    using layout_type      = LayoutType;
+    using mapping_type     = typename LayoutType::template mapping<extents_type>;
+    using element_type     = ElementType;
+    using value_type       = std::remove_cv_t<ElementType>;
+    using index_type       = typename extents_type::index_type;
+    using size_type        = typename extents_type::size_type;
+    using rank_type        = typename extents_type::rank_type;
+    using data_handle_type = ElementType*;
+    using reference        = ElementType&;
+
+    using IndexArrayType = std::array<index_type, Rank>;
+    using SliceType      = ndarray_view<ElementType, Rank, typename LayoutType::slice_layout>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    constexpr ndarray_view() noexcept = default;
+    constexpr ndarray_view(data_handle_type data_, const mapping_type& mapping_) noexcept;
+
+    template<typename OtherElementType>
+        requires(std::is_const_v<ElementType>
+                 && std::is_same_v<OtherElementType, std::remove_cv_t<ElementType>>)
+    constexpr ndarray_view(const ndarray_view<OtherElementType, Rank, LayoutType>& other_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    template<typename... Indices>
+    [[nodiscard]] constexpr reference operator()(Indices... indices_) const noexcept;
+    template<typename... Indices>
+    [[nodiscard]] constexpr reference at(Indices... indices_) const;
+    [[nodiscard]] constexpr reference at(const IndexArrayType& indices_) const;
+
+    [[nodiscard]] SliceType slice(const IndexArrayType& offsets_,
+                                  const IndexArrayType& extents_) const;
+
+
+    /*********************************************************************************************/
+    /* Extents --------------------------------------------------------------------------------- */
+    [[nodiscard]] constexpr static rank_type     rank() noexcept;
+    [[nodiscard]] constexpr const extents_type&  extents() const noexcept;
+    [[nodiscard]] constexpr index_type           extent(rank_type rank_) const noexcept;
+    [[nodiscard]] constexpr size_type            size() const noexcept;
+    [[nodiscard]] constexpr bool                 empty() const noexcept;
+    [[nodiscard]] constexpr data_handle_type     data_handle() const noexcept;
+    [[nodiscard]] constexpr const mapping_type&  mapping() const noexcept;
+    [[nodiscard]] constexpr bool                 is_exhaustive() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Iteration ------------------------------------------------------------------------------- */
+    template<typename FunctionType>
+    void for_each_index(FunctionType&& function_) const;
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    data_handle_type m_data = nullptr;
+    mapping_type     m_mapping{};
+
+    constexpr static const bool container_safeness = true;
+};
+
+
+/**
+ * \brief       Rank-dimensional array owning its elements in one container_base buffer.
+ *
+ *              The elements are laid out by LayoutType: layout_row_major, layout_column_major or
+ *              layout_tiled<...> for cache-friendly access along every dimension. The
+ *              container_base range is the raw buffer, in storage order and padding included;
+ *              view() and operator() give the logical, multi-dimensional access, and slice() a
+ *              zero-copy view of a sub-array.
+ */
+template<typename ItemType,
+         std::size_t Rank,
+         typename LayoutType    = layout_row_major,
+         typename AllocatorType = std::allocator<ItemType>>
+class ndarray : public container_base<ItemType, iterator_base<ItemType>, AllocatorType>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType       = ItemType;
+    using IteratorType    = iterator_base<ValueType>;
+    using BaseType        = container_base<ValueType, IteratorType, AllocatorType>;
+    using AllocatorTraits = typename BaseType::AllocatorTraits;
+    using SizeType        = typename BaseType::SizeType;
+    using DifferenceType  = typename BaseType::DifferenceType;
+
+    using ExtentsType    = ndarray_extents<Rank>;
+    using MappingType    = typename LayoutType::template mapping<ExtentsType>;
+    using IndexArrayType = std::array<SizeType, Rank>;
+    using ViewType       = ndarray_view<ValueType, Rank, LayoutType>;
+    using ConstViewType  = ndarray_view<const ValueType, Rank, LayoutType>;
+    using SliceType      = typename ViewType::SliceType;
+    using ConstSliceType = typename ConstViewType::SliceType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit ndarray(const AllocatorType& alloc_ = AllocatorType{});
+    explicit ndarray(const ExtentsType& extents_, const AllocatorType& alloc_ = AllocatorType{});
+    ndarray(const ExtentsType&   extents_,
+            const ValueType&     value_,
+            const AllocatorType& alloc_ = AllocatorType{});
+
+    ndarray(const ndarray& copy_);
+    ndarray(ndarray&& move_) noexcept;
+    ndarray& operator=(const ndarray& copy_);
+    ndarray& operator=(ndarray&& move_) noexcept;
+
+    ~ndarray() override;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    using BaseType::at;
+
+    template<typename... Indices>
+        requires(sizeof...(Indices) == Rank && Rank > 1)
+    [[nodiscard]] ValueType& at(Indices... indices_);
+    template<typename... Indices>
+        requires(sizeof...(Indices) == Rank && Rank > 1)
+    [[nodiscard]] const ValueType& at(Indices... indices_) const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    template<typename... Indices>
+    [[nodiscard]] ValueType& operator()(Indices... indices_) noexcept;
+    template<typename... Indices>
+    [[nodiscard]] const ValueType& operator()(Indices... indices_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Views ----------------------------------------------------------------------------------- */
+    [[nodiscard]] ViewType       view() noexcept;
+    [[nodiscard]] ConstViewType  view() const noexcept;
+    [[nodiscard]] SliceType      slice(const IndexArrayType& offsets_,
+                                       const IndexArrayType& extents_);
+    [[nodiscard]] ConstSliceType slice(const IndexArrayType& offsets_,
+                                       const IndexArrayType& extents_) const;
+
+    [[nodiscard]] const ExtentsType& extents() const noexcept;
+    [[nodiscard]] SizeType           extent(SizeType rank_) const noexcept;
+    [[nodiscard]] const MappingType& mapping() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    void fill(const ValueType& value_);
+    void clear();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const override;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    template<typename... Args>
+    void allocate_storage(const Args&... args_);
+    void release() noexcept;
+
+    [[nodiscard]] ValueType* data() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    MappingType m_mapping{};
+};
+
+
+}        // namespace pel
+
+#include "./ndarray.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
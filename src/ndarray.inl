@@ -0,0 +1,626 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./ndarray.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define NDARRAY_VIEW_TEMPLATE_DECLARATION__ typename ElementType,                                  \
+                                            std::size_t Rank,                                      \
+                                            typename LayoutType
+#define NDARRAY_VIEW_CLASS_SCOPE__          ndarray_view<ElementType, Rank, LayoutType>
+#define NDARRAY_TEMPLATE_DECLARATION__      typename ItemType,                                     \
+                                            std::size_t Rank,                                      \
+                                            typename LayoutType,                                   \
+                                            typename AllocatorType
+#define NDARRAY_CLASS_SCOPE__               ndarray<ItemType, Rank, LayoutType, AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* VIEW ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+constexpr inline NDARRAY_VIEW_CLASS_SCOPE__::ndarray_view(data_handle_type    data_,
+                                                          const mapping_type& mapping_) noexcept
+: m_data{data_}, m_mapping{mapping_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Convert a mutable view into a constant one.
+ *************************************************************************************************/
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+template<typename OtherElementType>
+    requires(std::is_const_v<ElementType>
+             && std::is_same_v<OtherElementType, std::remove_cv_t<ElementType>>)
+constexpr inline NDARRAY_VIEW_CLASS_SCOPE__::ndarray_view(
+  const ndarray_view<OtherElementType, Rank, LayoutType>& other_) noexcept
+: m_data{other_.data_handle()}, m_mapping{other_.mapping()}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access an element, given one index per dimension. The indices are not checked.
+ *************************************************************************************************/
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+template<typename... Indices>
+[[nodiscard]] constexpr inline typename NDARRAY_VIEW_CLASS_SCOPE__::reference
+NDARRAY_VIEW_CLASS_SCOPE__::operator()(Indices... indices_) const noexcept
+{
+    return m_data[m_mapping(indices_...)];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access an element, checking its indices.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If an index is not below the extent of its dimension.
+ *************************************************************************************************/
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+template<typename... Indices>
+[[nodiscard]] constexpr inline typename NDARRAY_VIEW_CLASS_SCOPE__::reference
+NDARRAY_VIEW_CLASS_SCOPE__::at(Indices... indices_) const
+{
+    static_assert(sizeof...(Indices) == Rank, "One index per dimension");
+    return at(IndexArrayType{ndarray_index_cast<index_type>(indices_)...});
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NDARRAY_VIEW_CLASS_SCOPE__::reference
+NDARRAY_VIEW_CLASS_SCOPE__::at(const IndexArrayType& indices_) const
+{
+    for(rank_type rank = 0; rank < Rank; ++rank)
+    {
+        if(indices_[rank] >= extent(rank))
+        {
+            throw std::length_error("Index out of range");
+        }
+    }
+    return m_data[m_mapping.offset_of(indices_)];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       View of a sub-array, sharing the elements of this one.
+ *
+ * \param       offsets_: Indices of the first element of the sub-array.
+ * \param       extents_: Extents of the sub-array.
+ *
+ * \retval      SliceType: Strided view for row-major and column-major arrays, tiled view with a
+ *                         moved origin for tiled ones.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If the sub-array does not fit in this one.
+ *************************************************************************************************/
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename NDARRAY_VIEW_CLASS_SCOPE__::SliceType
+NDARRAY_VIEW_CLASS_SCOPE__::slice(const IndexArrayType& offsets_,
+                                  const IndexArrayType& extents_) const
+{
+    if constexpr(container_safeness == true)
+    {
+        for(rank_type rank = 0; rank < Rank; ++rank)
+        {
+            if(offsets_[rank] > extent(rank) || extents_[rank] > extent(rank) - offsets_[rank])
+            {
+                throw std::length_error("Index out of range");
+            }
+        }
+    }
+
+    const auto [sliceMapping, offset] = m_mapping.sliced(offsets_, extents_type(extents_));
+    return SliceType(m_data + offset, sliceMapping);
+}
+
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NDARRAY_VIEW_CLASS_SCOPE__::rank_type
+NDARRAY_VIEW_CLASS_SCOPE__::rank() noexcept
+{
+    return Rank;
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline const typename NDARRAY_VIEW_CLASS_SCOPE__::extents_type&
+NDARRAY_VIEW_CLASS_SCOPE__::extents() const noexcept
+{
+    return m_mapping.extents();
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NDARRAY_VIEW_CLASS_SCOPE__::index_type
+NDARRAY_VIEW_CLASS_SCOPE__::extent(rank_type rank_) const noexcept
+{
+    return m_mapping.extents().extent(rank_);
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NDARRAY_VIEW_CLASS_SCOPE__::size_type
+NDARRAY_VIEW_CLASS_SCOPE__::size() const noexcept
+{
+    return m_mapping.extents().size();
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline bool NDARRAY_VIEW_CLASS_SCOPE__::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NDARRAY_VIEW_CLASS_SCOPE__::data_handle_type
+NDARRAY_VIEW_CLASS_SCOPE__::data_handle() const noexcept
+{
+    return m_data;
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline const typename NDARRAY_VIEW_CLASS_SCOPE__::mapping_type&
+NDARRAY_VIEW_CLASS_SCOPE__::mapping() const noexcept
+{
+    return m_mapping;
+}
+
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline bool NDARRAY_VIEW_CLASS_SCOPE__::is_exhaustive() const noexcept
+{
+    return m_mapping.is_exhaustive();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function with the indices of every element, the last index moving fastest.
+ *
+ * \param       function_: Callable taking a const IndexArrayType&.
+ *************************************************************************************************/
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void NDARRAY_VIEW_CLASS_SCOPE__::for_each_index(FunctionType&& function_) const
+{
+    if(empty())
+    {
+        return;
+    }
+
+    IndexArrayType indices{};
+    while(true)
+    {
+        function_(static_cast<const IndexArrayType&>(indices));
+
+        rank_type rank = Rank;
+        while(rank > 0 && ++indices[rank - 1] == extent(rank - 1))
+        {
+            indices[rank - 1] = 0;
+            --rank;
+        }
+        if(rank == 0)
+        {
+            return;
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Elements as nested lists, e.g. "[[1, 2], [3, 4]]".
+ *************************************************************************************************/
+template<NDARRAY_VIEW_TEMPLATE_DECLARATION__>
+inline std::string NDARRAY_VIEW_CLASS_SCOPE__::to_string() const
+{
+    if(empty())
+    {
+        return "[]";
+    }
+
+    std::stringstream ss;
+    bool              first = true;
+    for_each_index([this, &ss, &first](const IndexArrayType& indices_) {
+        if(first == false)
+        {
+            ss << ", ";
+        }
+        first = false;
+
+        for(rank_type rank = Rank; rank > 0 && indices_[rank - 1] == 0; --rank)
+        {
+            ss << "[";
+        }
+
+        if constexpr(requires { ss << m_data[0]; })
+        {
+            ss << m_data[m_mapping.offset_of(indices_)];
+        }
+        else
+        {
+            ss << "?";
+        }
+
+        for(rank_type rank = Rank; rank > 0 && indices_[rank - 1] == extent(rank - 1) - 1; --rank)
+        {
+            ss << "]";
+        }
+    });
+    return ss.str();
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__::ndarray(const AllocatorType& alloc_) : BaseType{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create an array of the given extents, with value-initialized elements.
+ *
+ * \param       extents_: Extent of each dimension.
+ * \param       alloc_:   Allocator of the buffer.
+ *************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__::ndarray(const ExtentsType& extents_, const AllocatorType& alloc_)
+: BaseType{alloc_}, m_mapping{extents_}
+{
+    allocate_storage();
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__::ndarray(const ExtentsType&   extents_,
+                                      const ValueType&     value_,
+                                      const AllocatorType& alloc_)
+: BaseType{alloc_}, m_mapping{extents_}
+{
+    allocate_storage(value_);
+}
+
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__::ndarray(const ndarray& copy_)
+: BaseType{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)},
+  m_mapping{copy_.m_mapping}
+{
+    if(copy_.is_empty())
+    {
+        return;
+    }
+
+    ValueType* items      = AllocatorTraits::allocate(this->m_allocator, copy_.length());
+    this->m_beginIterator = IteratorType(items);
+    this->m_endIterator   = IteratorType(items);
+
+    try
+    {
+        for(const ValueType& value : copy_)
+        {
+            AllocatorTraits::construct(this->m_allocator, data() + this->length(), value);
+            this->add_size(1);
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__::ndarray(ndarray&& move_) noexcept
+: BaseType{move_.m_allocator}, m_mapping{std::exchange(move_.m_mapping, MappingType{})}
+{
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+}
+
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__& NDARRAY_CLASS_SCOPE__::operator=(const ndarray& copy_)
+{
+    if(this != &copy_)
+    {
+        ndarray copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__& NDARRAY_CLASS_SCOPE__::operator=(ndarray&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+        this->m_allocator     = move_.m_allocator;
+        m_mapping             = std::exchange(move_.m_mapping, MappingType{});
+        this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+        this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+    }
+    return *this;
+}
+
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline NDARRAY_CLASS_SCOPE__::~ndarray()
+{
+    release();
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access an element, given one index per dimension, checking the indices.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If an index is not below the extent of its dimension.
+ *************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+template<typename... Indices>
+    requires(sizeof...(Indices) == Rank && Rank > 1)
+inline ItemType& NDARRAY_CLASS_SCOPE__::at(Indices... indices_)
+{
+    return view().at(indices_...);
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+template<typename... Indices>
+    requires(sizeof...(Indices) == Rank && Rank > 1)
+inline const ItemType& NDARRAY_CLASS_SCOPE__::at(Indices... indices_) const
+{
+    return view().at(indices_...);
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+template<typename... Indices>
+inline ItemType& NDARRAY_CLASS_SCOPE__::operator()(Indices... indices_) noexcept
+{
+    return data()[m_mapping(indices_...)];
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+template<typename... Indices>
+inline const ItemType& NDARRAY_CLASS_SCOPE__::operator()(Indices... indices_) const noexcept
+{
+    return data()[m_mapping(indices_...)];
+}
+
+
+
+/*************************************************************************************************/
+/* VIEWS --------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline typename NDARRAY_CLASS_SCOPE__::ViewType NDARRAY_CLASS_SCOPE__::view() noexcept
+{
+    return ViewType(data(), m_mapping);
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline typename NDARRAY_CLASS_SCOPE__::ConstViewType NDARRAY_CLASS_SCOPE__::view() const noexcept
+{
+    return ConstViewType(data(), m_mapping);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       View of a sub-array, sharing the elements of this array.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If the sub-array does not fit in this one.
+ *************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline typename NDARRAY_CLASS_SCOPE__::SliceType
+NDARRAY_CLASS_SCOPE__::slice(const IndexArrayType& offsets_, const IndexArrayType& extents_)
+{
+    return view().slice(offsets_, extents_);
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline typename NDARRAY_CLASS_SCOPE__::ConstSliceType
+NDARRAY_CLASS_SCOPE__::slice(const IndexArrayType& offsets_, const IndexArrayType& extents_) const
+{
+    return view().slice(offsets_, extents_);
+}
+
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline const typename NDARRAY_CLASS_SCOPE__::ExtentsType&
+NDARRAY_CLASS_SCOPE__::extents() const noexcept
+{
+    return m_mapping.extents();
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline typename NDARRAY_CLASS_SCOPE__::SizeType
+NDARRAY_CLASS_SCOPE__::extent(SizeType rank_) const noexcept
+{
+    return m_mapping.extents().extent(rank_);
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline const typename NDARRAY_CLASS_SCOPE__::MappingType&
+NDARRAY_CLASS_SCOPE__::mapping() const noexcept
+{
+    return m_mapping;
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Assign a value to every element of the buffer, padding included.
+ *************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline void NDARRAY_CLASS_SCOPE__::fill(const ValueType& value_)
+{
+    for(ValueType& item : *this)
+    {
+        item = value_;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element and free the buffer. The extents become zero, as for a
+ *              default-constructed array, so that they never describe elements that are gone.
+ *************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline void NDARRAY_CLASS_SCOPE__::clear()
+{
+    release();
+    m_mapping = MappingType{};
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline std::string NDARRAY_CLASS_SCOPE__::to_string() const
+{
+    return view().to_string();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate the buffer the mapping needs and construct every element from args_.
+ *************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline void NDARRAY_CLASS_SCOPE__::allocate_storage(const Args&... args_)
+{
+    const SizeType spanSize = m_mapping.required_span_size();
+    if(spanSize == 0)
+    {
+        return;
+    }
+
+    ValueType* items      = AllocatorTraits::allocate(this->m_allocator, spanSize);
+    this->m_beginIterator = IteratorType(items);
+    this->m_endIterator   = IteratorType(items);
+
+    try
+    {
+        for(SizeType i = 0; i < spanSize; ++i)
+        {
+            AllocatorTraits::construct(this->m_allocator, items + i, args_...);
+            this->add_size(1);
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the elements and free the buffer, which holds required_span_size() of
+ *              them once constructed.
+ *************************************************************************************************/
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline void NDARRAY_CLASS_SCOPE__::release() noexcept
+{
+    ValueType* items = data();
+    if(items != nullptr)
+    {
+        for(SizeType i = 0; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items + i);
+        }
+        AllocatorTraits::deallocate(this->m_allocator, items, m_mapping.required_span_size());
+    }
+
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+}
+
+template<NDARRAY_TEMPLATE_DECLARATION__>
+inline ItemType* NDARRAY_CLASS_SCOPE__::data() const noexcept
+{
+    return BaseType::begin().ptr();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef NDARRAY_VIEW_TEMPLATE_DECLARATION__
+#undef NDARRAY_VIEW_CLASS_SCOPE__
+#undef NDARRAY_TEMPLATE_DECLARATION__
+#undef NDARRAY_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,318 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Convert an index given by the user to the index type of an array.
+ */
+template<typename IndexType, typename ValueType>
+[[nodiscard]] constexpr IndexType ndarray_index_cast(ValueType value_) noexcept;
+
+
+/**
+ * \brief       Extents of a Rank-dimensional array, all known at run time.
+ *
+ *              Offers the part of the std::extents interface used by the ndarray layouts, which
+ *              only rely on rank(), extent() and construction from a std::array: the layouts also
+ *              work with std::dextents<std::size_t, Rank>, and so with std::mdspan.
+ */
+template<std::size_t Rank>
+class ndarray_extents
+{
+    static_assert(Rank > 0, "An array needs at least one dimension");
+
+public:
+    using index_type = std::size_t;
+    using size_type  = std::size_t;
+    using rank_type  = std::size_t;
+
+    constexpr ndarray_extents() noexcept = default;
+    constexpr explicit ndarray_extents(const std::array<index_type, Rank>& extents_) noexcept;
+    template<typename... Extents>
+        requires(sizeof...(Extents) == Rank && (std::is_convertible_v<Extents, std::size_t> && ...))
+    constexpr explicit ndarray_extents(Extents... extents_) noexcept;
+
+    [[nodiscard]] constexpr static rank_type rank() noexcept;
+    [[nodiscard]] constexpr static rank_type rank_dynamic() noexcept;
+    [[nodiscard]] constexpr static std::size_t static_extent(rank_type rank_) noexcept;
+
+    [[nodiscard]] constexpr index_type extent(rank_type rank_) const noexcept;
+    [[nodiscard]] constexpr size_type  size() const noexcept;
+    [[nodiscard]] constexpr const std::array<index_type, Rank>& values() const noexcept;
+
+    [[nodiscard]] constexpr bool operator==(const ndarray_extents& rhs_) const noexcept;
+
+private:
+    std::array<index_type, Rank> m_extents{};
+};
+
+
+/**
+ * \brief       Layout with an arbitrary stride per dimension (std::layout_stride).
+ *              Slices of row-major and column-major arrays use it.
+ *
+ *              Like the other layouts, follows the shape of a std::mdspan layout mapping policy,
+ *              with offset_of() and sliced() added; sliced() makes the mapping of a sub-array, and
+ *              the offset of its first element, without copying anything.
+ */
+class layout_strided
+{
+public:
+    using slice_layout = layout_strided;
+
+    template<typename ExtentsType>
+    class mapping
+    {
+    public:
+        using extents_type = ExtentsType;
+        using index_type   = typename ExtentsType::index_type;
+        using size_type    = std::size_t;
+        using rank_type    = std::size_t;
+        using layout_type  = layout_strided;
+
+        using IndexArrayType = std::array<index_type, ExtentsType::rank()>;
+
+        constexpr mapping() noexcept = default;
+        constexpr mapping(const extents_type& extents_, const IndexArrayType& strides_) noexcept;
+
+        [[nodiscard]] constexpr const extents_type&   extents() const noexcept;
+        [[nodiscard]] constexpr const IndexArrayType& strides() const noexcept;
+        [[nodiscard]] constexpr index_type            required_span_size() const noexcept;
+        [[nodiscard]] constexpr index_type            stride(rank_type rank_) const noexcept;
+        [[nodiscard]] constexpr index_type offset_of(const IndexArrayType& indices_) const noexcept;
+
+        template<typename... Indices>
+        [[nodiscard]] constexpr index_type operator()(Indices... indices_) const noexcept;
+
+        [[nodiscard]] constexpr static bool is_always_unique() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_always_exhaustive() noexcept { return false; }
+        [[nodiscard]] constexpr static bool is_always_strided() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_unique() noexcept { return true; }
+        [[nodiscard]] constexpr bool        is_exhaustive() const noexcept;
+        [[nodiscard]] constexpr static bool is_strided() noexcept { return true; }
+
+        [[nodiscard]] std::pair<mapping, index_type>
+        sliced(const IndexArrayType& offsets_, const extents_type& extents_) const noexcept;
+
+        [[nodiscard]] constexpr bool operator==(const mapping& rhs_) const noexcept;
+
+    private:
+        extents_type   m_extents{};
+        IndexArrayType m_strides{};
+    };
+};
+
+
+/**
+ * \brief       Row-major layout: the last index is contiguous (std::layout_right).
+ */
+class layout_row_major
+{
+public:
+    using slice_layout = layout_strided;
+
+    template<typename ExtentsType>
+    class mapping
+    {
+    public:
+        using extents_type = ExtentsType;
+        using index_type   = typename ExtentsType::index_type;
+        using size_type    = std::size_t;
+        using rank_type    = std::size_t;
+        using layout_type  = layout_row_major;
+
+        using IndexArrayType = std::array<index_type, ExtentsType::rank()>;
+
+        constexpr mapping() noexcept = default;
+        constexpr mapping(const extents_type& extents_) noexcept;
+
+        [[nodiscard]] constexpr const extents_type& extents() const noexcept;
+        [[nodiscard]] constexpr index_type          required_span_size() const noexcept;
+        [[nodiscard]] constexpr index_type          stride(rank_type rank_) const noexcept;
+        [[nodiscard]] constexpr index_type offset_of(const IndexArrayType& indices_) const noexcept;
+
+        template<typename... Indices>
+        [[nodiscard]] constexpr index_type operator()(Indices... indices_) const noexcept;
+
+        [[nodiscard]] constexpr static bool is_always_unique() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_always_exhaustive() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_always_strided() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_unique() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_exhaustive() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_strided() noexcept { return true; }
+
+        [[nodiscard]] std::pair<layout_strided::mapping<ExtentsType>, index_type>
+        sliced(const IndexArrayType& offsets_, const extents_type& extents_) const noexcept;
+
+        [[nodiscard]] constexpr bool operator==(const mapping& rhs_) const noexcept;
+
+    private:
+        extents_type m_extents{};
+    };
+};
+
+
+/**
+ * \brief       Column-major layout: the first index is contiguous (std::layout_left).
+ */
+class layout_column_major
+{
+public:
+    using slice_layout = layout_strided;
+
+    template<typename ExtentsType>
+    class mapping
+    {
+    public:
+        using extents_type = ExtentsType;
+        using index_type   = typename ExtentsType::index_type;
+        using size_type    = std::size_t;
+        using rank_type    = std::size_t;
+        using layout_type  = layout_column_major;
+
+        using IndexArrayType = std::array<index_type, ExtentsType::rank()>;
+
+        constexpr mapping() noexcept = default;
+        constexpr mapping(const extents_type& extents_) noexcept;
+
+        [[nodiscard]] constexpr const extents_type& extents() const noexcept;
+        [[nodiscard]] constexpr index_type          required_span_size() const noexcept;
+        [[nodiscard]] constexpr index_type          stride(rank_type rank_) const noexcept;
+        [[nodiscard]] constexpr index_type offset_of(const IndexArrayType& indices_) const noexcept;
+
+        template<typename... Indices>
+        [[nodiscard]] constexpr index_type operator()(Indices... indices_) const noexcept;
+
+        [[nodiscard]] constexpr static bool is_always_unique() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_always_exhaustive() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_always_strided() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_unique() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_exhaustive() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_strided() noexcept { return true; }
+
+        [[nodiscard]] std::pair<layout_strided::mapping<ExtentsType>, index_type>
+        sliced(const IndexArrayType& offsets_, const extents_type& extents_) const noexcept;
+
+        [[nodiscard]] constexpr bool operator==(const mapping& rhs_) const noexcept;
+
+    private:
+        extents_type m_extents{};
+    };
+};
+
+
+/**
+ * \brief       Tiled (blocked) layout: the array is cut into tiles of TileExtents elements, stored
+ *              one after the other in row-major order, each tile being row-major itself.
+ *
+ *              A tile of 8x8 doubles is 512 bytes, 64x64 floats 16 kiB: an access pattern that
+ *              moves along any dimension, as a transpose or the columns of a matrix product do,
+ *              stays in a few tiles instead of touching one cache line per step. The extents are
+ *              padded to whole tiles. Tile extents that are powers of two make the index math
+ *              shifts and masks.
+ *
+ *              A slice keeps the tiled mapping of the whole array, with an origin added to the
+ *              indices, so it does not move the data pointer and is not strided.
+ */
+template<std::size_t... TileExtents>
+class layout_tiled
+{
+    static_assert(sizeof...(TileExtents) > 0, "A tile needs at least one dimension");
+    static_assert(((TileExtents > 0) && ...), "Tiles cannot be empty");
+
+public:
+    using slice_layout = layout_tiled;
+
+    constexpr static const std::size_t tile_rank   = sizeof...(TileExtents);
+    constexpr static const std::size_t tile_volume = (TileExtents * ...);
+
+    constexpr static const std::array<std::size_t, tile_rank> tile_extents{TileExtents...};
+
+    template<typename ExtentsType>
+    class mapping
+    {
+        static_assert(ExtentsType::rank() == tile_rank, "Tile and array ranks must match");
+
+    public:
+        using extents_type = ExtentsType;
+        using index_type   = typename ExtentsType::index_type;
+        using size_type    = std::size_t;
+        using rank_type    = std::size_t;
+        using layout_type  = layout_tiled;
+
+        using IndexArrayType = std::array<index_type, ExtentsType::rank()>;
+
+        constexpr mapping() noexcept = default;
+        constexpr mapping(const extents_type& extents_) noexcept;
+
+        [[nodiscard]] constexpr const extents_type&   extents() const noexcept;
+        [[nodiscard]] constexpr const IndexArrayType& origin() const noexcept;
+        [[nodiscard]] constexpr const IndexArrayType& tile_counts() const noexcept;
+        [[nodiscard]] constexpr index_type            required_span_size() const noexcept;
+        [[nodiscard]] constexpr index_type offset_of(const IndexArrayType& indices_) const noexcept;
+
+        template<typename... Indices>
+        [[nodiscard]] constexpr index_type operator()(Indices... indices_) const noexcept;
+
+        [[nodiscard]] constexpr static bool is_always_unique() noexcept { return true; }
+        [[nodiscard]] constexpr static bool is_always_exhaustive() noexcept { return false; }
+        [[nodiscard]] constexpr static bool is_always_strided() noexcept { return false; }
+        [[nodiscard]] constexpr static bool is_unique() noexcept { return true; }
+        [[nodiscard]] constexpr bool        is_exhaustive() const noexcept;
+        [[nodiscard]] constexpr static bool is_strided() noexcept { return false; }
+
+        [[nodiscard]] std::pair<mapping, index_type>
+        sliced(const IndexArrayType& offsets_, const extents_type& extents_) const noexcept;
+
+        [[nodiscard]] constexpr bool operator==(const mapping& rhs_) const noexcept;
+
+    private:
+        extents_type   m_extents{};
+        IndexArrayType m_origin{};
+        IndexArrayType m_tileCounts{};
+    };
+};
+
+
+}        // namespace pel
+
+#include "./ndarray_layout.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,596 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./ndarray_layout.hpp"
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define ROW_MAJOR_MAPPING_SCOPE__    layout_row_major::mapping<ExtentsType>
+#define COLUMN_MAJOR_MAPPING_SCOPE__ layout_column_major::mapping<ExtentsType>
+#define STRIDED_MAPPING_SCOPE__      layout_strided::mapping<ExtentsType>
+#define TILED_MAPPING_SCOPE__        layout_tiled<TileExtents...>::mapping<ExtentsType>
+#define TILED_MAPPING_TYPE__         layout_tiled<TileExtents...>::template mapping<ExtentsType>
+/* clang-format on */
+
+
+namespace pel
+{
+/**
+ **************************************************************************************************
+ * \brief       Convert an index to IndexType. Nothing is cast if it already is one.
+ *************************************************************************************************/
+template<typename IndexType, typename ValueType>
+[[nodiscard]] constexpr inline IndexType ndarray_index_cast(ValueType value_) noexcept
+{
+    if constexpr(std::is_same_v<IndexType, ValueType>)
+    {
+        return value_;
+    }
+    else
+    {
+        return static_cast<IndexType>(value_);
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* EXTENTS ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<std::size_t Rank>
+constexpr inline ndarray_extents<Rank>::ndarray_extents(
+  const std::array<index_type, Rank>& extents_) noexcept
+: m_extents{extents_}
+{
+}
+
+template<std::size_t Rank>
+template<typename... Extents>
+    requires(sizeof...(Extents) == Rank && (std::is_convertible_v<Extents, std::size_t> && ...))
+constexpr inline ndarray_extents<Rank>::ndarray_extents(Extents... extents_) noexcept
+: m_extents{ndarray_index_cast<index_type>(extents_)...}
+{
+}
+
+
+template<std::size_t Rank>
+[[nodiscard]] constexpr inline typename ndarray_extents<Rank>::rank_type
+ndarray_extents<Rank>::rank() noexcept
+{
+    return Rank;
+}
+
+template<std::size_t Rank>
+[[nodiscard]] constexpr inline typename ndarray_extents<Rank>::rank_type
+ndarray_extents<Rank>::rank_dynamic() noexcept
+{
+    return Rank;
+}
+
+template<std::size_t Rank>
+[[nodiscard]] constexpr inline std::size_t
+ndarray_extents<Rank>::static_extent([[maybe_unused]] rank_type rank_) noexcept
+{
+    return std::dynamic_extent;
+}
+
+template<std::size_t Rank>
+[[nodiscard]] constexpr inline typename ndarray_extents<Rank>::index_type
+ndarray_extents<Rank>::extent(rank_type rank_) const noexcept
+{
+    return m_extents[rank_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements: the product of the extents.
+ *************************************************************************************************/
+template<std::size_t Rank>
+[[nodiscard]] constexpr inline typename ndarray_extents<Rank>::size_type
+ndarray_extents<Rank>::size() const noexcept
+{
+    size_type size = 1;
+    for(const index_type extent : m_extents)
+    {
+        size *= extent;
+    }
+    return size;
+}
+
+template<std::size_t Rank>
+[[nodiscard]] constexpr inline const std::array<typename ndarray_extents<Rank>::index_type, Rank>&
+ndarray_extents<Rank>::values() const noexcept
+{
+    return m_extents;
+}
+
+template<std::size_t Rank>
+[[nodiscard]] constexpr inline bool
+ndarray_extents<Rank>::operator==(const ndarray_extents& rhs_) const noexcept
+{
+    return m_extents == rhs_.m_extents;
+}
+
+
+
+/*************************************************************************************************/
+/* STRIDED LAYOUT ------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<typename ExtentsType>
+constexpr inline STRIDED_MAPPING_SCOPE__::mapping(const extents_type&   extents_,
+                                                  const IndexArrayType& strides_) noexcept
+: m_extents{extents_}, m_strides{strides_}
+{
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline const typename STRIDED_MAPPING_SCOPE__::extents_type&
+STRIDED_MAPPING_SCOPE__::extents() const noexcept
+{
+    return m_extents;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline const typename STRIDED_MAPPING_SCOPE__::IndexArrayType&
+STRIDED_MAPPING_SCOPE__::strides() const noexcept
+{
+    return m_strides;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       One past the largest offset of an element, 0 if there is none.
+ *************************************************************************************************/
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename STRIDED_MAPPING_SCOPE__::index_type
+STRIDED_MAPPING_SCOPE__::required_span_size() const noexcept
+{
+    index_type size = 1;
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        if(m_extents.extent(rank) == 0)
+        {
+            return 0;
+        }
+        size += (m_extents.extent(rank) - 1) * m_strides[rank];
+    }
+    return size;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename STRIDED_MAPPING_SCOPE__::index_type
+STRIDED_MAPPING_SCOPE__::stride(rank_type rank_) const noexcept
+{
+    return m_strides[rank_];
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename STRIDED_MAPPING_SCOPE__::index_type
+STRIDED_MAPPING_SCOPE__::offset_of(const IndexArrayType& indices_) const noexcept
+{
+    index_type offset = 0;
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        offset += indices_[rank] * m_strides[rank];
+    }
+    return offset;
+}
+
+template<typename ExtentsType>
+template<typename... Indices>
+[[nodiscard]] constexpr inline typename STRIDED_MAPPING_SCOPE__::index_type
+STRIDED_MAPPING_SCOPE__::operator()(Indices... indices_) const noexcept
+{
+    static_assert(sizeof...(Indices) == ExtentsType::rank(), "One index per dimension");
+    return offset_of(IndexArrayType{ndarray_index_cast<index_type>(indices_)...});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Whether the elements cover every offset below required_span_size().
+ *************************************************************************************************/
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline bool STRIDED_MAPPING_SCOPE__::is_exhaustive() const noexcept
+{
+    index_type size = 1;
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        size *= m_extents.extent(rank);
+    }
+    return size == required_span_size();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Mapping of a sub-array, and offset of its first element.
+ *
+ * \param       offsets_: Indices of the first element of the sub-array.
+ * \param       extents_: Extents of the sub-array.
+ *************************************************************************************************/
+template<typename ExtentsType>
+[[nodiscard]] inline std::pair<STRIDED_MAPPING_SCOPE__,
+                               typename STRIDED_MAPPING_SCOPE__::index_type>
+STRIDED_MAPPING_SCOPE__::sliced(const IndexArrayType& offsets_,
+                                const extents_type&   extents_) const noexcept
+{
+    return {mapping(extents_, m_strides), offset_of(offsets_)};
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline bool
+STRIDED_MAPPING_SCOPE__::operator==(const mapping& rhs_) const noexcept
+{
+    return m_extents == rhs_.m_extents && m_strides == rhs_.m_strides;
+}
+
+
+
+/*************************************************************************************************/
+/* ROW-MAJOR LAYOUT ---------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<typename ExtentsType>
+constexpr inline ROW_MAJOR_MAPPING_SCOPE__::mapping(const extents_type& extents_) noexcept
+: m_extents{extents_}
+{
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline const typename ROW_MAJOR_MAPPING_SCOPE__::extents_type&
+ROW_MAJOR_MAPPING_SCOPE__::extents() const noexcept
+{
+    return m_extents;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename ROW_MAJOR_MAPPING_SCOPE__::index_type
+ROW_MAJOR_MAPPING_SCOPE__::required_span_size() const noexcept
+{
+    index_type size = 1;
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        size *= m_extents.extent(rank);
+    }
+    return size;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename ROW_MAJOR_MAPPING_SCOPE__::index_type
+ROW_MAJOR_MAPPING_SCOPE__::stride(rank_type rank_) const noexcept
+{
+    index_type stride = 1;
+    for(rank_type rank = rank_ + 1; rank < ExtentsType::rank(); ++rank)
+    {
+        stride *= m_extents.extent(rank);
+    }
+    return stride;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename ROW_MAJOR_MAPPING_SCOPE__::index_type
+ROW_MAJOR_MAPPING_SCOPE__::offset_of(const IndexArrayType& indices_) const noexcept
+{
+    index_type offset = indices_[0];
+    for(rank_type rank = 1; rank < ExtentsType::rank(); ++rank)
+    {
+        offset = offset * m_extents.extent(rank) + indices_[rank];
+    }
+    return offset;
+}
+
+template<typename ExtentsType>
+template<typename... Indices>
+[[nodiscard]] constexpr inline typename ROW_MAJOR_MAPPING_SCOPE__::index_type
+ROW_MAJOR_MAPPING_SCOPE__::operator()(Indices... indices_) const noexcept
+{
+    static_assert(sizeof...(Indices) == ExtentsType::rank(), "One index per dimension");
+    return offset_of(IndexArrayType{ndarray_index_cast<index_type>(indices_)...});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Strided mapping of a sub-array, and offset of its first element.
+ *************************************************************************************************/
+template<typename ExtentsType>
+[[nodiscard]] inline std::pair<layout_strided::mapping<ExtentsType>,
+                               typename ROW_MAJOR_MAPPING_SCOPE__::index_type>
+ROW_MAJOR_MAPPING_SCOPE__::sliced(const IndexArrayType& offsets_,
+                                  const extents_type&   extents_) const noexcept
+{
+    IndexArrayType strides{};
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        strides[rank] = stride(rank);
+    }
+    return {layout_strided::mapping<ExtentsType>(extents_, strides), offset_of(offsets_)};
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline bool
+ROW_MAJOR_MAPPING_SCOPE__::operator==(const mapping& rhs_) const noexcept
+{
+    return m_extents == rhs_.m_extents;
+}
+
+
+
+/*************************************************************************************************/
+/* COLUMN-MAJOR LAYOUT ------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<typename ExtentsType>
+constexpr inline COLUMN_MAJOR_MAPPING_SCOPE__::mapping(const extents_type& extents_) noexcept
+: m_extents{extents_}
+{
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline const typename COLUMN_MAJOR_MAPPING_SCOPE__::extents_type&
+COLUMN_MAJOR_MAPPING_SCOPE__::extents() const noexcept
+{
+    return m_extents;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename COLUMN_MAJOR_MAPPING_SCOPE__::index_type
+COLUMN_MAJOR_MAPPING_SCOPE__::required_span_size() const noexcept
+{
+    index_type size = 1;
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        size *= m_extents.extent(rank);
+    }
+    return size;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename COLUMN_MAJOR_MAPPING_SCOPE__::index_type
+COLUMN_MAJOR_MAPPING_SCOPE__::stride(rank_type rank_) const noexcept
+{
+    index_type stride = 1;
+    for(rank_type rank = 0; rank < rank_; ++rank)
+    {
+        stride *= m_extents.extent(rank);
+    }
+    return stride;
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename COLUMN_MAJOR_MAPPING_SCOPE__::index_type
+COLUMN_MAJOR_MAPPING_SCOPE__::offset_of(const IndexArrayType& indices_) const noexcept
+{
+    index_type offset = indices_[ExtentsType::rank() - 1];
+    for(rank_type rank = ExtentsType::rank() - 1; rank > 0; --rank)
+    {
+        offset = offset * m_extents.extent(rank - 1) + indices_[rank - 1];
+    }
+    return offset;
+}
+
+template<typename ExtentsType>
+template<typename... Indices>
+[[nodiscard]] constexpr inline typename COLUMN_MAJOR_MAPPING_SCOPE__::index_type
+COLUMN_MAJOR_MAPPING_SCOPE__::operator()(Indices... indices_) const noexcept
+{
+    static_assert(sizeof...(Indices) == ExtentsType::rank(), "One index per dimension");
+    return offset_of(IndexArrayType{ndarray_index_cast<index_type>(indices_)...});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Strided mapping of a sub-array, and offset of its first element.
+ *************************************************************************************************/
+template<typename ExtentsType>
+[[nodiscard]] inline std::pair<layout_strided::mapping<ExtentsType>,
+                               typename COLUMN_MAJOR_MAPPING_SCOPE__::index_type>
+COLUMN_MAJOR_MAPPING_SCOPE__::sliced(const IndexArrayType& offsets_,
+                                     const extents_type&   extents_) const noexcept
+{
+    IndexArrayType strides{};
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        strides[rank] = stride(rank);
+    }
+    return {layout_strided::mapping<ExtentsType>(extents_, strides), offset_of(offsets_)};
+}
+
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline bool
+COLUMN_MAJOR_MAPPING_SCOPE__::operator==(const mapping& rhs_) const noexcept
+{
+    return m_extents == rhs_.m_extents;
+}
+
+
+
+/*************************************************************************************************/
+/* TILED LAYOUT -------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Mapping of a whole array: as many tiles as needed to cover each extent.
+ *************************************************************************************************/
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+constexpr inline TILED_MAPPING_SCOPE__::mapping(const extents_type& extents_) noexcept
+: m_extents{extents_}
+{
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        m_tileCounts[rank] = (m_extents.extent(rank) + tile_extents[rank] - 1) / tile_extents[rank];
+    }
+}
+
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline const typename TILED_MAPPING_TYPE__::extents_type&
+TILED_MAPPING_SCOPE__::extents() const noexcept
+{
+    return m_extents;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Indices, in the whole array, of the first element of this (sub-)array.
+ *************************************************************************************************/
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline const typename TILED_MAPPING_TYPE__::IndexArrayType&
+TILED_MAPPING_SCOPE__::origin() const noexcept
+{
+    return m_origin;
+}
+
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline const typename TILED_MAPPING_TYPE__::IndexArrayType&
+TILED_MAPPING_SCOPE__::tile_counts() const noexcept
+{
+    return m_tileCounts;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Size of the whole tiled buffer, padding included.
+ *************************************************************************************************/
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename TILED_MAPPING_TYPE__::index_type
+TILED_MAPPING_SCOPE__::required_span_size() const noexcept
+{
+    index_type size = tile_volume;
+    for(const index_type tileCount : m_tileCounts)
+    {
+        size *= tileCount;
+    }
+    return size;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Offset of an element: the tile it is in, in row-major order over the tiles, then
+ *              its position in the tile, in row-major order too.
+ *************************************************************************************************/
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline typename TILED_MAPPING_TYPE__::index_type
+TILED_MAPPING_SCOPE__::offset_of(const IndexArrayType& indices_) const noexcept
+{
+    index_type tileOffset   = 0;
+    index_type insideOffset = 0;
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        const index_type index = indices_[rank] + m_origin[rank];
+        tileOffset             = tileOffset * m_tileCounts[rank] + index / tile_extents[rank];
+        insideOffset           = insideOffset * tile_extents[rank] + index % tile_extents[rank];
+    }
+    return tileOffset * tile_volume + insideOffset;
+}
+
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+template<typename... Indices>
+[[nodiscard]] constexpr inline typename TILED_MAPPING_TYPE__::index_type
+TILED_MAPPING_SCOPE__::operator()(Indices... indices_) const noexcept
+{
+    static_assert(sizeof...(Indices) == ExtentsType::rank(), "One index per dimension");
+    return offset_of(IndexArrayType{ndarray_index_cast<index_type>(indices_)...});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Whether the array is whole and its extents are multiples of the tile extents.
+ *************************************************************************************************/
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline bool TILED_MAPPING_SCOPE__::is_exhaustive() const noexcept
+{
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        if(m_origin[rank] != 0 || m_extents.extent(rank) != m_tileCounts[rank] * tile_extents[rank])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Mapping of a sub-array: the same tiles, with the origin moved. The offset of the
+ *              first element is folded into the mapping, so the data pointer is kept.
+ *************************************************************************************************/
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] inline std::pair<typename TILED_MAPPING_TYPE__,
+                               typename TILED_MAPPING_TYPE__::index_type>
+TILED_MAPPING_SCOPE__::sliced(const IndexArrayType& offsets_,
+                              const extents_type&   extents_) const noexcept
+{
+    mapping slice   = *this;
+    slice.m_extents = extents_;
+    for(rank_type rank = 0; rank < ExtentsType::rank(); ++rank)
+    {
+        slice.m_origin[rank] += offsets_[rank];
+    }
+    return {slice, 0};
+}
+
+template<std::size_t... TileExtents>
+template<typename ExtentsType>
+[[nodiscard]] constexpr inline bool
+TILED_MAPPING_SCOPE__::operator==(const mapping& rhs_) const noexcept
+{
+    return m_extents == rhs_.m_extents && m_origin == rhs_.m_origin
+           && m_tileCounts == rhs_.m_tileCounts;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef ROW_MAJOR_MAPPING_SCOPE__
+#undef COLUMN_MAJOR_MAPPING_SCOPE__
+#undef STRIDED_MAPPING_SCOPE__
+#undef TILED_MAPPING_SCOPE__
+#undef TILED_MAPPING_TYPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,130 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Node of a doubly-linked structure: gives the next and the previous node.
+ */
+template<typename NodeType>
+concept linked_node = requires(const NodeType& node_) {
+    { node_.next() } -> std::convertible_to<NodeType*>;
+    { node_.prev() } -> std::convertible_to<NodeType*>;
+};
+
+
+/**
+ * \brief       Bidirectional iterator over linked nodes.
+ *
+ *              iterator_base walks contiguous memory with pointer arithmetic, and so claims random
+ *              access; this is its counterpart for node-based containers, which only step to the
+ *              next or previous node. The element is the node itself when ItemType derives from
+ *              NodeType, as in intrusive containers, and otherwise the node's value().
+ *
+ *              A constant iterator is a node_iterator_base over const ItemType, and converts from
+ *              the mutable one.
+ */
+template<typename ItemType, linked_node NodeType>
+class node_iterator_base
+{
+public:
+    /*------------------------------------*/
+    /* Typenames */
+    using IteratorType = node_iterator_base<ItemType, NodeType>;
+
+    using SizeType       = std::size_t;
+    using DifferenceType = std::ptrdiff_t;
+
+    using PointerType     = ItemType*;
+    using ReferenceType   = ItemType&;
+    using NodePointerType =
+      std::conditional_t<std::is_const_v<ItemType>, const NodeType*, NodeType*>;
+
+    /* Types for the STL */
+    using IteratorCategory  = std::bidirectional_iterator_tag;
+    using iterator_category = IteratorCategory;
+    using self_type         = IteratorType;
+    using value_type        = std::remove_const_t<ItemType>;
+    using reference         = ReferenceType;
+    using pointer           = PointerType;
+    using difference_type   = DifferenceType;
+    using size_type         = SizeType;
+
+    /*------------------------------------*/
+    /* Constructors */
+    constexpr node_iterator_base() noexcept = default;
+
+    constexpr explicit node_iterator_base(NodePointerType node_) noexcept;
+
+    template<typename OtherItemType>
+        requires(std::is_const_v<ItemType>
+                 && std::is_same_v<OtherItemType, std::remove_const_t<ItemType>>)
+    constexpr node_iterator_base(
+      const node_iterator_base<OtherItemType, NodeType>& other_) noexcept;
+
+    /*------------------------------------*/
+    /* Memory operators */
+    [[nodiscard]] constexpr ReferenceType   value() const noexcept;
+    [[nodiscard]] constexpr NodePointerType node() const noexcept;
+
+    [[nodiscard]] constexpr ReferenceType operator*() const noexcept;
+    [[nodiscard]] constexpr PointerType   operator->() const noexcept;
+
+    /*------------------------------------*/
+    /* Arithmetic operators */
+    constexpr node_iterator_base& operator++() noexcept;
+    constexpr node_iterator_base  operator++(int) noexcept;
+    constexpr node_iterator_base& operator--() noexcept;
+    constexpr node_iterator_base  operator--(int) noexcept;
+
+    /*------------------------------------*/
+    /* Comparison operators */
+    [[nodiscard]] constexpr bool operator==(const node_iterator_base& rhs_) const noexcept;
+    [[nodiscard]] constexpr bool operator!=(const node_iterator_base& rhs_) const noexcept;
+
+    /*------------------------------------*/
+protected:
+    NodePointerType m_node = nullptr;
+};
+
+
+}        // namespace pel
+
+#include "./node_iterator_base.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,174 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./node_iterator_base.hpp"
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define NODE_ITERATOR_TEMPLATE_DECLARATION__ typename ItemType, linked_node NodeType
+#define NODE_ITERATOR_CLASS_SCOPE__          node_iterator_base<ItemType, NodeType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS -------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+constexpr inline NODE_ITERATOR_CLASS_SCOPE__::node_iterator_base(NodePointerType node_) noexcept
+: m_node{node_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Convert a mutable iterator into a constant one.
+ *************************************************************************************************/
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+template<typename OtherItemType>
+    requires(std::is_const_v<ItemType>
+             && std::is_same_v<OtherItemType, std::remove_const_t<ItemType>>)
+constexpr inline NODE_ITERATOR_CLASS_SCOPE__::node_iterator_base(
+  const node_iterator_base<OtherItemType, NodeType>& other_) noexcept
+: m_node{other_.node()}
+{
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY OPERATORS ---------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Element of the node: the node itself if ItemType derives from NodeType, its value()
+ *              otherwise.
+ *************************************************************************************************/
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NODE_ITERATOR_CLASS_SCOPE__::ReferenceType
+NODE_ITERATOR_CLASS_SCOPE__::value() const noexcept
+{
+    if constexpr(std::is_base_of_v<NodeType, std::remove_const_t<ItemType>>)
+    {
+        return static_cast<ReferenceType>(*m_node);
+    }
+    else
+    {
+        return m_node->value();
+    }
+}
+
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NODE_ITERATOR_CLASS_SCOPE__::NodePointerType
+NODE_ITERATOR_CLASS_SCOPE__::node() const noexcept
+{
+    return m_node;
+}
+
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NODE_ITERATOR_CLASS_SCOPE__::ReferenceType
+NODE_ITERATOR_CLASS_SCOPE__::operator*() const noexcept
+{
+    return value();
+}
+
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename NODE_ITERATOR_CLASS_SCOPE__::PointerType
+NODE_ITERATOR_CLASS_SCOPE__::operator->() const noexcept
+{
+    return &value();
+}
+
+
+
+/*************************************************************************************************/
+/* ARITHMETIC OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+constexpr inline NODE_ITERATOR_CLASS_SCOPE__& NODE_ITERATOR_CLASS_SCOPE__::operator++() noexcept
+{
+    m_node = m_node->next();
+    return *this;
+}
+
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+constexpr inline NODE_ITERATOR_CLASS_SCOPE__ NODE_ITERATOR_CLASS_SCOPE__::operator++(int) noexcept
+{
+    node_iterator_base previous = *this;
+    m_node                      = m_node->next();
+    return previous;
+}
+
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+constexpr inline NODE_ITERATOR_CLASS_SCOPE__& NODE_ITERATOR_CLASS_SCOPE__::operator--() noexcept
+{
+    m_node = m_node->prev();
+    return *this;
+}
+
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+constexpr inline NODE_ITERATOR_CLASS_SCOPE__ NODE_ITERATOR_CLASS_SCOPE__::operator--(int) noexcept
+{
+    node_iterator_base previous = *this;
+    m_node                      = m_node->prev();
+    return previous;
+}
+
+
+
+/*************************************************************************************************/
+/* COMPARISON OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline bool
+NODE_ITERATOR_CLASS_SCOPE__::operator==(const node_iterator_base& rhs_) const noexcept
+{
+    return m_node == rhs_.m_node;
+}
+
+template<NODE_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline bool
+NODE_ITERATOR_CLASS_SCOPE__::operator!=(const node_iterator_base& rhs_) const noexcept
+{
+    return m_node != rhs_.m_node;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef NODE_ITERATOR_TEMPLATE_DECLARATION__
+#undef NODE_ITERATOR_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,153 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Number of nodes in a slab of a node_pool by default: about one page, and at least
+ *              16.
+ */
+template<typename ItemType>
+constexpr std::size_t default_node_pool_slab_length =
+  std::max<std::size_t>(16, 4096 / sizeof(ItemType));
+
+
+/**
+ * \brief       Slab allocator for nodes of a single type.
+ *
+ *              Nodes are carved, in address order, out of slabs of SlabLength nodes allocated
+ *              through AllocatorType, so that nodes created one after the other are next to each
+ *              other in memory rather than scattered over the heap. A destroyed node goes on a free
+ *              list and is the next one handed out, and slabs are only given back when the pool is
+ *              destroyed or released: creating and destroying a node is a few pointer moves.
+ *
+ * \warning     Nodes still alive when the pool is released or destroyed are not destroyed.
+ */
+template<typename ItemType,
+         typename AllocatorType = std::allocator<ItemType>,
+         std::size_t SlabLength = default_node_pool_slab_length<ItemType>>
+class node_pool
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(SlabLength > 0, "A slab must hold at least one node");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType = ItemType;
+    using SizeType  = std::size_t;
+
+    constexpr static const SizeType slab_length = SlabLength;
+
+private:
+    /* Storage for a node, or link to the next free one */
+    union slot
+    {
+        slot* next;
+        alignas(ItemType) std::byte storage[sizeof(ItemType)];
+    };
+
+    using SlotAllocatorType =
+      typename std::allocator_traits<AllocatorType>::template rebind_alloc<slot>;
+    using SlotTraits            = std::allocator_traits<SlotAllocatorType>;
+    using SlabListAllocatorType = typename SlotTraits::template rebind_alloc<slot*>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit node_pool(const AllocatorType& alloc_ = AllocatorType{});
+
+    node_pool(const node_pool& copy_) = delete;
+    node_pool(node_pool&& move_) noexcept;
+    node_pool& operator=(const node_pool& copy_) = delete;
+    node_pool& operator=(node_pool&& move_) noexcept;
+
+    ~node_pool();
+
+
+    /*********************************************************************************************/
+    /* Allocation ------------------------------------------------------------------------------ */
+    [[nodiscard]] ItemType* allocate();
+    void                    deallocate(ItemType* node_) noexcept;
+
+    template<typename... Args>
+    [[nodiscard]] ItemType* create(Args&&... args_);
+    void                    destroy(ItemType* node_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType length() const noexcept;
+    [[nodiscard]] SizeType capacity() const noexcept;
+    [[nodiscard]] SizeType slab_count() const noexcept;
+
+    void reserve(SizeType capacity_);
+    void release() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void add_slab();
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::vector<slot*, SlabListAllocatorType> m_slabs;
+
+    /* Nodes given back, then the part of the last slab never handed out */
+    slot* m_freeList  = nullptr;
+    slot* m_bumpFirst = nullptr;
+    slot* m_bumpLast  = nullptr;
+
+    SizeType m_length = 0;
+
+    [[no_unique_address]] SlotAllocatorType m_allocator{};
+};
+
+
+}        // namespace pel
+
+#include "./node_pool.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
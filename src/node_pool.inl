@@ -0,0 +1,309 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./node_pool.hpp"
+
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define NODE_POOL_TEMPLATE_DECLARATION__ typename ItemType,                                        \
+                                         typename AllocatorType,                                   \
+                                         std::size_t SlabLength
+#define NODE_POOL_CLASS_SCOPE__          node_pool<ItemType, AllocatorType, SlabLength>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty pool. No slab is allocated until the first node is.
+ *
+ * \param       alloc_: Allocator, rebound to allocate the slabs.
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline NODE_POOL_CLASS_SCOPE__::node_pool(const AllocatorType& alloc_)
+: m_slabs{SlabListAllocatorType{alloc_}}, m_allocator{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the slabs of another pool, leaving it empty.
+ *              Nodes created by the other pool now belong to this one.
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline NODE_POOL_CLASS_SCOPE__::node_pool(node_pool&& move_) noexcept
+: m_slabs{std::move(move_.m_slabs)},
+  m_freeList{std::exchange(move_.m_freeList, nullptr)},
+  m_bumpFirst{std::exchange(move_.m_bumpFirst, nullptr)},
+  m_bumpLast{std::exchange(move_.m_bumpLast, nullptr)},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_allocator{move_.m_allocator}
+{
+    move_.m_slabs.clear();
+}
+
+
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline NODE_POOL_CLASS_SCOPE__& NODE_POOL_CLASS_SCOPE__::operator=(node_pool&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+        m_slabs     = std::move(move_.m_slabs);
+        m_freeList  = std::exchange(move_.m_freeList, nullptr);
+        m_bumpFirst = std::exchange(move_.m_bumpFirst, nullptr);
+        m_bumpLast  = std::exchange(move_.m_bumpLast, nullptr);
+        m_length    = std::exchange(move_.m_length, 0);
+        m_allocator = move_.m_allocator;
+        move_.m_slabs.clear();
+    }
+    return *this;
+}
+
+
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline NODE_POOL_CLASS_SCOPE__::~node_pool()
+{
+    release();
+}
+
+
+
+/*************************************************************************************************/
+/* ALLOCATION ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get uninitialized storage for one node: the last node given back if any, otherwise
+ *              the one after the last handed out, in the last slab or a new one.
+ *
+ * \retval      ItemType*: Storage for a node, to be given back with deallocate().
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline ItemType* NODE_POOL_CLASS_SCOPE__::allocate()
+{
+    slot* node = nullptr;
+    if(m_freeList != nullptr)
+    {
+        node       = m_freeList;
+        m_freeList = node->next;
+    }
+    else
+    {
+        if(m_bumpFirst == m_bumpLast)
+        {
+            add_slab();
+        }
+        node = m_bumpFirst++;
+    }
+
+    ++m_length;
+    return static_cast<ItemType*>(static_cast<void*>(node->storage));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Give back the storage of a node allocated by this pool. It is not destroyed.
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline void NODE_POOL_CLASS_SCOPE__::deallocate(ItemType* node_) noexcept
+{
+    if(node_ == nullptr)
+    {
+        return;
+    }
+
+    slot* node = static_cast<slot*>(static_cast<void*>(node_));
+    node->next = m_freeList;
+    m_freeList = node;
+    --m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate a node and construct it in place.
+ *              The storage is given back if the constructor throws.
+ *
+ * \param       args_: Arguments forwarded to the node's constructor.
+ *
+ * \retval      ItemType*: The new node, to be destroyed with destroy().
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline ItemType* NODE_POOL_CLASS_SCOPE__::create(Args&&... args_)
+{
+    ItemType* node = allocate();
+    try
+    {
+        return std::construct_at(node, std::forward<Args>(args_)...);
+    }
+    catch(...)
+    {
+        deallocate(node);
+        throw;
+    }
+}
+
+
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline void NODE_POOL_CLASS_SCOPE__::destroy(ItemType* node_) noexcept
+{
+    if(node_ == nullptr)
+    {
+        return;
+    }
+
+    std::destroy_at(node_);
+    deallocate(node_);
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Number of nodes allocated and not given back.
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline typename NODE_POOL_CLASS_SCOPE__::SizeType NODE_POOL_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline typename NODE_POOL_CLASS_SCOPE__::SizeType NODE_POOL_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_slabs.size() * SlabLength;
+}
+
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline typename NODE_POOL_CLASS_SCOPE__::SizeType
+NODE_POOL_CLASS_SCOPE__::slab_count() const noexcept
+{
+    return m_slabs.size();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate slabs until the pool holds at least capacity_ nodes.
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline void NODE_POOL_CLASS_SCOPE__::reserve(SizeType capacity_)
+{
+    while(capacity() < capacity_)
+    {
+        add_slab();
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free every slab at once, without destroying the nodes still alive.
+ *              Meant for trivially destructible nodes, or nodes already destroyed.
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline void NODE_POOL_CLASS_SCOPE__::release() noexcept
+{
+    for(slot* slab : m_slabs)
+    {
+        SlotTraits::deallocate(m_allocator, slab, SlabLength);
+    }
+    m_slabs.clear();
+
+    m_freeList  = nullptr;
+    m_bumpFirst = nullptr;
+    m_bumpLast  = nullptr;
+    m_length    = 0;
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate a new slab and hand out its nodes from now on.
+ *              The nodes of the previous slab never handed out go on the free list, lowest address
+ *              first.
+ *************************************************************************************************/
+template<NODE_POOL_TEMPLATE_DECLARATION__>
+inline void NODE_POOL_CLASS_SCOPE__::add_slab()
+{
+    /* Make room for the slab first, so that it cannot be lost */
+    m_slabs.push_back(nullptr);
+    try
+    {
+        m_slabs.back() = SlotTraits::allocate(m_allocator, SlabLength);
+    }
+    catch(...)
+    {
+        m_slabs.pop_back();
+        throw;
+    }
+    slot* slab = m_slabs.back();
+
+    while(m_bumpLast != m_bumpFirst)
+    {
+        --m_bumpLast;
+        m_bumpLast->next = m_freeList;
+        m_freeList       = m_bumpLast;
+    }
+
+    m_bumpFirst = slab;
+    m_bumpLast  = slab + SlabLength;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef NODE_POOL_TEMPLATE_DECLARATION__
+#undef NODE_POOL_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
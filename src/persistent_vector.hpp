@@ -0,0 +1,449 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+
+
+
+namespace pel
+{
+template<typename ItemType, typename AllocatorType>
+class transient_vector;
+
+
+/**
+ * \brief       Random-access iterator over a persistent_vector.
+ *
+ *              Keeps a pointer to the leaf holding the current element, so that stepping within a
+ *              leaf is an index increment; the tree is only walked again when leaving the leaf.
+ */
+template<typename ContainerType>
+class persistent_vector_iterator
+{
+    friend ContainerType;
+
+public:
+    using SizeType = typename ContainerType::SizeType;
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename ContainerType::ValueType;
+    using difference_type   = typename ContainerType::DifferenceType;
+    using pointer           = const value_type*;
+    using reference         = const value_type&;
+
+    constexpr persistent_vector_iterator() noexcept = default;
+
+    [[nodiscard]] reference operator*() const noexcept;
+    [[nodiscard]] pointer   operator->() const noexcept;
+    [[nodiscard]] reference operator[](difference_type offset_) const noexcept;
+
+    persistent_vector_iterator& operator++() noexcept;
+    persistent_vector_iterator  operator++(int) noexcept;
+    persistent_vector_iterator& operator--() noexcept;
+    persistent_vector_iterator  operator--(int) noexcept;
+
+    persistent_vector_iterator& operator+=(difference_type offset_) noexcept;
+    persistent_vector_iterator& operator-=(difference_type offset_) noexcept;
+
+    [[nodiscard]] persistent_vector_iterator operator+(difference_type offset_) const noexcept;
+    [[nodiscard]] persistent_vector_iterator operator-(difference_type offset_) const noexcept;
+    [[nodiscard]] difference_type operator-(const persistent_vector_iterator& rhs_) const noexcept;
+
+    [[nodiscard]] friend persistent_vector_iterator
+    operator+(difference_type offset_, const persistent_vector_iterator& iterator_) noexcept
+    {
+        return iterator_ + offset_;
+    }
+
+    [[nodiscard]] bool operator==(const persistent_vector_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator!=(const persistent_vector_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator<(const persistent_vector_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator<=(const persistent_vector_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator>(const persistent_vector_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator>=(const persistent_vector_iterator& rhs_) const noexcept;
+
+private:
+    persistent_vector_iterator(const ContainerType* container_, SizeType index_) noexcept;
+
+    void seek() noexcept;
+
+    const ContainerType* m_container = nullptr;
+    SizeType             m_index     = 0;
+
+    /* Leaf holding the elements [m_leafStart, m_leafEnd); null past the end */
+    pointer  m_leaf      = nullptr;
+    SizeType m_leafStart = 0;
+    SizeType m_leafEnd   = 0;
+};
+
+
+/**
+ * \brief       Immutable sequence whose versions share their structure (an RRB-tree).
+ *
+ *              Elements are stored in leaves of 32, under a tree of 32-way inner nodes. Every
+ *              "modifier" leaves the vector untouched and returns a new version, which only copies
+ *              the path from the root to the leaf it changes, so that keeping many versions of a
+ *              large sequence differing by a few edits costs a few nodes per edit instead of full
+ *              copies. The last leaf is kept aside as the tail, which makes push_back() and
+ *              pop_back() amortized O(1).
+ *
+ *              Inner nodes are radix-balanced, searched with shifts and masks, until concat()
+ *              joins two vectors in O(log n): the nodes along the seam are then redistributed and
+ *              become relaxed, keeping a table of their subtree sizes that lookups go through.
+ *
+ *              Batches of edits go through a transient_vector, which modifies in place the nodes no
+ *              other version refers to. Nodes are reference counted and allocated through
+ *              AllocatorType, and versions can be read and copied from several threads.
+ *
+ *              Offers the familiar container_base read surface (length, is_empty, at, front, back,
+ *              comparisons) with random-access iterators, and for_each_segment() gives the leaves
+ *              as spans.
+ */
+template<typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+class persistent_vector
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using AllocatorTraits    = std::allocator_traits<AllocatorType>;
+    using SizeType           = std::size_t;
+    using DifferenceType     = std::ptrdiff_t;
+    using ValueType          = ItemType;
+    using IteratorType       = persistent_vector_iterator<persistent_vector>;
+    using ConstIteratorType  = IteratorType;
+    using RIteratorType      = std::reverse_iterator<IteratorType>;
+    using ConstRIteratorType = RIteratorType;
+    using SpanType           = std::span<const ItemType>;
+    using TransientType      = transient_vector<ItemType, AllocatorType>;
+
+    constexpr static const SizeType branching_bits = 5;
+    constexpr static const SizeType branching      = SizeType{1} << branching_bits;
+
+private:
+    struct node
+    {
+        std::atomic<std::uint32_t> referenceCount{1};
+        std::uint32_t              count = 0;
+    };
+
+    struct leaf_node : node
+    {
+        [[nodiscard]] ItemType*       items() noexcept;
+        [[nodiscard]] const ItemType* items() const noexcept;
+
+        alignas(ItemType) std::byte storage[branching * sizeof(ItemType)];
+    };
+
+    struct inner_node : node
+    {
+        /* Whether the children must be found through sizes instead of shifts and masks */
+        bool relaxed = false;
+
+        node* children[branching];
+
+        /* Number of elements in the first i + 1 children, kept up to date in every inner node */
+        SizeType sizes[branching];
+    };
+
+    struct leaf_location
+    {
+        const ItemType* items = nullptr;
+        SizeType        first = 0;
+        SizeType        count = 0;
+    };
+
+    using LeafAllocatorType  = typename AllocatorTraits::template rebind_alloc<leaf_node>;
+    using LeafTraits         = std::allocator_traits<LeafAllocatorType>;
+    using InnerAllocatorType = typename AllocatorTraits::template rebind_alloc<inner_node>;
+    using InnerTraits        = std::allocator_traits<InnerAllocatorType>;
+
+    friend IteratorType;
+    friend TransientType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit persistent_vector(const AllocatorType& alloc_ = AllocatorType{});
+    persistent_vector(std::initializer_list<ItemType> items_,
+                      const AllocatorType&            alloc_ = AllocatorType{});
+    template<container_compatible_range<ItemType> RangeType>
+    persistent_vector(from_range_t,
+                      RangeType&&          range_,
+                      const AllocatorType& alloc_ = AllocatorType{});
+
+    persistent_vector(const persistent_vector& copy_) noexcept;
+    persistent_vector(persistent_vector&& move_) noexcept;
+    persistent_vector& operator=(const persistent_vector& copy_) noexcept;
+    persistent_vector& operator=(persistent_vector&& move_) noexcept;
+
+    ~persistent_vector();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] const ItemType& at(SizeType index_) const;
+    [[nodiscard]] const ItemType& front() const;
+    [[nodiscard]] const ItemType& back() const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType  begin() const noexcept;
+    [[nodiscard]] IteratorType  end() const noexcept;
+    [[nodiscard]] IteratorType  cbegin() const noexcept;
+    [[nodiscard]] IteratorType  cend() const noexcept;
+    [[nodiscard]] RIteratorType rbegin() const noexcept;
+    [[nodiscard]] RIteratorType rend() const noexcept;
+
+    template<typename FunctionType>
+    void for_each_segment(FunctionType&& function_) const;
+
+
+    /*********************************************************************************************/
+    /* Versions -------------------------------------------------------------------------------- */
+    [[nodiscard]] persistent_vector push_back(const ItemType& item_) const;
+    [[nodiscard]] persistent_vector push_back(ItemType&& item_) const;
+    [[nodiscard]] persistent_vector pop_back() const;
+    [[nodiscard]] persistent_vector set(SizeType index_, const ItemType& item_) const;
+    [[nodiscard]] persistent_vector set(SizeType index_, ItemType&& item_) const;
+    template<typename FunctionType>
+    [[nodiscard]] persistent_vector update(SizeType index_, FunctionType&& function_) const;
+    [[nodiscard]] persistent_vector concat(const persistent_vector& rhs_) const;
+
+    [[nodiscard]] TransientType transient() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_not_empty() const noexcept;
+    [[nodiscard]] SizeType             depth() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    /* In-place edits, which copy the nodes shared with another version before changing them */
+    template<typename... Args>
+    void append_item(Args&&... args_);
+    void remove_last();
+    template<typename FunctionType>
+    void modify_item(SizeType index_, FunctionType& function_);
+    void append_vector(const persistent_vector& rhs_);
+
+    [[nodiscard]] leaf_location locate(SizeType index_) const noexcept;
+    [[nodiscard]] SizeType      tail_offset() const noexcept;
+    void                        check_index(SizeType index_) const;
+
+    void push_leaf(leaf_node* leaf_);
+    bool append_leaf(node*& slot_, SizeType shift_, leaf_node* leaf_);
+    [[nodiscard]] node*      new_path(SizeType shift_, leaf_node* leaf_);
+    [[nodiscard]] leaf_node* pop_leaf();
+    [[nodiscard]] leaf_node* remove_last_leaf(node*& slot_, SizeType shift_);
+    void                     collapse_root() noexcept;
+
+    [[nodiscard]] inner_node* concat_subtrees(node*    left_,
+                                              SizeType leftShift_,
+                                              node*    right_,
+                                              SizeType rightShift_);
+    [[nodiscard]] inner_node* rebalance(const inner_node* left_,
+                                        inner_node*       center_,
+                                        const inner_node* right_,
+                                        SizeType          shift_);
+
+    [[nodiscard]] leaf_node*  new_leaf();
+    [[nodiscard]] inner_node* new_inner();
+    [[nodiscard]] leaf_node*  copy_leaf(const leaf_node* source_, SizeType count_);
+    [[nodiscard]] inner_node* copy_inner(const inner_node* source_);
+    [[nodiscard]] leaf_node*  own_leaf(node*& slot_);
+    [[nodiscard]] inner_node* own_inner(node*& slot_, SizeType shift_);
+    void                      free_leaf(leaf_node* leaf_) noexcept;
+    void                      free_inner(inner_node* inner_) noexcept;
+    void                      release(node* node_, SizeType shift_) noexcept;
+    void                      release() noexcept;
+
+    template<typename FunctionType>
+    static void visit_leaves(const node* node_, SizeType shift_, FunctionType& function_);
+
+    static void                   retain(node* node_) noexcept;
+    [[nodiscard]] static bool     is_unique(const node* node_) noexcept;
+    [[nodiscard]] static bool     has_room(const node* node_, SizeType shift_) noexcept;
+    [[nodiscard]] static SizeType subtree_size(const node* node_, SizeType shift_) noexcept;
+    [[nodiscard]] static SizeType child_slot(const inner_node* inner_,
+                                             SizeType          shift_,
+                                             SizeType&         index_) noexcept;
+    static void                   seal(inner_node* inner_, SizeType shift_) noexcept;
+
+    [[nodiscard]] static leaf_node*        as_leaf(node* node_) noexcept;
+    [[nodiscard]] static const leaf_node*  as_leaf(const node* node_) noexcept;
+    [[nodiscard]] static inner_node*       as_inner(node* node_) noexcept;
+    [[nodiscard]] static const inner_node* as_inner(const node* node_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    /* Tree holding every element but those of the tail: a leaf when m_shift is 0, otherwise an
+     * inner node with at least 2 children. Null when the tail holds every element */
+    node*    m_root  = nullptr;
+    SizeType m_shift = 0;
+
+    /* Leaf holding the last 1 to 32 elements, null when the vector is empty */
+    node*    m_tail   = nullptr;
+    SizeType m_length = 0;
+
+    [[no_unique_address]] AllocatorType m_allocator{};
+
+    /* Number of nodes a rebalanced level may exceed the minimum needed to hold its slots by */
+    constexpr static const SizeType rebalance_extras = 2;
+};
+
+
+/**
+ * \brief       Mutable handle on a persistent_vector, for batches of edits.
+ *
+ *              Starts out sharing every node with the vector it comes from, and copies a node the
+ *              first time it changes it; the copies belong to the transient alone, so later edits
+ *              to them are done in place, without allocating. persistent() hands out the current
+ *              contents as a new version in O(1); the transient can keep being edited afterwards,
+ *              and copies again the nodes it now shares with that version.
+ */
+template<typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+class transient_vector
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using PersistentType = persistent_vector<ItemType, AllocatorType>;
+    using SizeType       = typename PersistentType::SizeType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit transient_vector(const AllocatorType& alloc_ = AllocatorType{});
+    explicit transient_vector(PersistentType vector_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] const ItemType& at(SizeType index_) const;
+    [[nodiscard]] const ItemType& front() const;
+    [[nodiscard]] const ItemType& back() const;
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    template<typename... Args>
+    void emplace_back(Args&&... args_);
+    void push_back(const ItemType& item_);
+    void push_back(ItemType&& item_);
+    void pop_back();
+    void set(SizeType index_, const ItemType& item_);
+    void set(SizeType index_, ItemType&& item_);
+    template<typename FunctionType>
+    void update(SizeType index_, FunctionType&& function_);
+    void append(const PersistentType& rhs_);
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType length() const noexcept;
+    [[nodiscard]] bool     is_empty() const noexcept;
+    [[nodiscard]] bool     is_not_empty() const noexcept;
+
+    [[nodiscard]] PersistentType persistent() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    PersistentType m_vector;
+};
+
+
+/* clang-format off */
+#define PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__                                          \
+        typename ItemType,                                                                         \
+        typename AllocatorType
+
+#define PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__                                                     \
+        const persistent_vector<ItemType, AllocatorType>& lhs_,                                    \
+        const persistent_vector<ItemType, AllocatorType>& rhs_
+/* clang-format on */
+
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator==(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__);
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator!=(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__);
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator<(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__);
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator<=(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__);
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator>(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__);
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] bool operator>=(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__);
+
+
+}        // namespace pel
+
+#include "./persistent_vector.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
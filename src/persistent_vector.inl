@@ -0,0 +1,2038 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./persistent_vector.hpp"
+
+#include <algorithm>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define PERSISTENT_VECTOR_TEMPLATE_DECLARATION__    typename ItemType, typename AllocatorType
+#define PERSISTENT_VECTOR_CLASS_SCOPE__             persistent_vector<ItemType, AllocatorType>
+#define PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__    persistent_vector_iterator<ContainerType>
+#define TRANSIENT_VECTOR_CLASS_SCOPE__              transient_vector<ItemType, AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::persistent_vector_iterator(
+  const ContainerType* container_, SizeType index_) noexcept
+: m_container{container_}, m_index{index_}
+{
+    seek();
+}
+
+
+template<typename ContainerType>
+inline typename PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::reference
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator*() const noexcept
+{
+    return m_leaf[m_index - m_leafStart];
+}
+
+template<typename ContainerType>
+inline typename PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::pointer
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator->() const noexcept
+{
+    return m_leaf + (m_index - m_leafStart);
+}
+
+template<typename ContainerType>
+inline typename PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::reference
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator[](difference_type offset_) const noexcept
+{
+    return *(*this + offset_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move to the next element, looking the next leaf up at the end of a leaf.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__&
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator++() noexcept
+{
+    if(++m_index == m_leafEnd)
+    {
+        seek();
+    }
+    return *this;
+}
+
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator++(int) noexcept
+{
+    persistent_vector_iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move to the previous element, looking the previous leaf up at the start of a leaf.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__&
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator--() noexcept
+{
+    if(m_index-- == m_leafStart)
+    {
+        seek();
+    }
+    return *this;
+}
+
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator--(int) noexcept
+{
+    persistent_vector_iterator previous = *this;
+    --*this;
+    return previous;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move by any number of elements; the tree is only walked when leaving the leaf.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__&
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator+=(difference_type offset_) noexcept
+{
+    m_index = static_cast<SizeType>(static_cast<difference_type>(m_index) + offset_);
+
+    /* Also true when m_index went below m_leafStart, since the difference then wraps around */
+    if(m_index - m_leafStart >= m_leafEnd - m_leafStart)
+    {
+        seek();
+    }
+    return *this;
+}
+
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__&
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator-=(difference_type offset_) noexcept
+{
+    return *this += -offset_;
+}
+
+
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator+(difference_type offset_) const noexcept
+{
+    persistent_vector_iterator moved = *this;
+    moved += offset_;
+    return moved;
+}
+
+template<typename ContainerType>
+inline PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator-(difference_type offset_) const noexcept
+{
+    persistent_vector_iterator moved = *this;
+    moved -= offset_;
+    return moved;
+}
+
+template<typename ContainerType>
+inline typename PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::difference_type
+PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator-(
+  const persistent_vector_iterator& rhs_) const noexcept
+{
+    return static_cast<difference_type>(m_index) - static_cast<difference_type>(rhs_.m_index);
+}
+
+
+template<typename ContainerType>
+inline bool PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator==(
+  const persistent_vector_iterator& rhs_) const noexcept
+{
+    return m_index == rhs_.m_index;
+}
+
+template<typename ContainerType>
+inline bool PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator!=(
+  const persistent_vector_iterator& rhs_) const noexcept
+{
+    return !(*this == rhs_);
+}
+
+template<typename ContainerType>
+inline bool PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator<(
+  const persistent_vector_iterator& rhs_) const noexcept
+{
+    return m_index < rhs_.m_index;
+}
+
+template<typename ContainerType>
+inline bool PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator<=(
+  const persistent_vector_iterator& rhs_) const noexcept
+{
+    return !(rhs_ < *this);
+}
+
+template<typename ContainerType>
+inline bool PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator>(
+  const persistent_vector_iterator& rhs_) const noexcept
+{
+    return rhs_ < *this;
+}
+
+template<typename ContainerType>
+inline bool PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::operator>=(
+  const persistent_vector_iterator& rhs_) const noexcept
+{
+    return !(*this < rhs_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Look up the leaf holding the current element, if there is one.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline void PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__::seek() noexcept
+{
+    if(m_index < m_container->length())
+    {
+        const auto location = m_container->locate(m_index);
+        m_leaf              = location.items;
+        m_leafStart         = location.first;
+        m_leafEnd           = location.first + location.count;
+    }
+    else
+    {
+        m_leaf      = nullptr;
+        m_leafStart = m_index;
+        m_leafEnd   = m_index;
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty vector. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator, rebound to allocate the nodes.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__::persistent_vector(const AllocatorType& alloc_)
+: m_allocator{alloc_}
+{
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__::persistent_vector(std::initializer_list<ItemType> items_,
+                                                          const AllocatorType&            alloc_)
+: persistent_vector(from_range, items_, alloc_)
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a vector holding a copy of every element of a range, in order.
+ *              The nodes belong to the new vector alone while it is built, so they are filled in
+ *              place.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<container_compatible_range<ItemType> RangeType>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__::persistent_vector(from_range_t,
+                                                          RangeType&&          range_,
+                                                          const AllocatorType& alloc_)
+: m_allocator{alloc_}
+{
+    try
+    {
+        for(auto&& item : range_)
+        {
+            append_item(std::forward<decltype(item)>(item));
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Share every node of another vector. O(1): only two reference counts change.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__::persistent_vector(const persistent_vector& copy_) noexcept
+: m_root{copy_.m_root},
+  m_shift{copy_.m_shift},
+  m_tail{copy_.m_tail},
+  m_length{copy_.m_length},
+  m_allocator{copy_.m_allocator}
+{
+    retain(m_root);
+    retain(m_tail);
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__::persistent_vector(persistent_vector&& move_) noexcept
+: m_root{std::exchange(move_.m_root, nullptr)},
+  m_shift{std::exchange(move_.m_shift, 0)},
+  m_tail{std::exchange(move_.m_tail, nullptr)},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_allocator{move_.m_allocator}
+{
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__&
+PERSISTENT_VECTOR_CLASS_SCOPE__::operator=(const persistent_vector& copy_) noexcept
+{
+    if(this == &copy_)
+    {
+        return *this;
+    }
+
+    retain(copy_.m_root);
+    retain(copy_.m_tail);
+    release();
+
+    m_root      = copy_.m_root;
+    m_shift     = copy_.m_shift;
+    m_tail      = copy_.m_tail;
+    m_length    = copy_.m_length;
+    m_allocator = copy_.m_allocator;
+    return *this;
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__&
+PERSISTENT_VECTOR_CLASS_SCOPE__::operator=(persistent_vector&& move_) noexcept
+{
+    if(this == &move_)
+    {
+        return *this;
+    }
+
+    release();
+
+    m_root      = std::exchange(move_.m_root, nullptr);
+    m_shift     = std::exchange(move_.m_shift, 0);
+    m_tail      = std::exchange(move_.m_tail, nullptr);
+    m_length    = std::exchange(move_.m_length, 0);
+    m_allocator = move_.m_allocator;
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop this version's references; the nodes no other version refers to are freed.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__::~persistent_vector()
+{
+    release();
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element at an index, in O(log32 n).
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& PERSISTENT_VECTOR_CLASS_SCOPE__::at(SizeType index_) const
+{
+    check_index(index_);
+    return (*this)[index_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the first element.
+ *
+ * \throw       std::length_error
+ *              If the vector is empty.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& PERSISTENT_VECTOR_CLASS_SCOPE__::front() const
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return (*this)[0];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the last element, which is always in the tail, in O(1).
+ *
+ * \throw       std::length_error
+ *              If the vector is empty.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& PERSISTENT_VECTOR_CLASS_SCOPE__::back() const
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return as_leaf(m_tail)->items()[m_tail->count - 1];
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element at an index without checking it, in O(log32 n).
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& PERSISTENT_VECTOR_CLASS_SCOPE__::operator[](SizeType index_) const noexcept
+{
+    const leaf_location location = locate(index_);
+    return location.items[index_ - location.first];
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::IteratorType
+PERSISTENT_VECTOR_CLASS_SCOPE__::begin() const noexcept
+{
+    return IteratorType(this, 0);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::IteratorType
+PERSISTENT_VECTOR_CLASS_SCOPE__::end() const noexcept
+{
+    return IteratorType(this, m_length);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::IteratorType
+PERSISTENT_VECTOR_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::IteratorType
+PERSISTENT_VECTOR_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::RIteratorType
+PERSISTENT_VECTOR_CLASS_SCOPE__::rbegin() const noexcept
+{
+    return RIteratorType(end());
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::RIteratorType
+PERSISTENT_VECTOR_CLASS_SCOPE__::rend() const noexcept
+{
+    return RIteratorType(begin());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function with the elements, as one span per leaf, in order.
+ *              Much faster than going through the iterators for loops over every element.
+ *
+ * \param       function_: Called with a SpanType for each leaf.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::for_each_segment(FunctionType&& function_) const
+{
+    if(m_root != nullptr)
+    {
+        visit_leaves(m_root, m_shift, function_);
+    }
+    if(m_tail != nullptr)
+    {
+        function_(SpanType(as_leaf(m_tail)->items(), m_tail->count));
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* VERSIONS ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Get a new version with an element added at the end.
+ *              Amortized O(1): the tail is copied, and once every 32 elements a full tail moves
+ *              into the tree along a new right edge.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_CLASS_SCOPE__::push_back(const ItemType& item_) const
+{
+    persistent_vector version(*this);
+    version.append_item(item_);
+    return version;
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_CLASS_SCOPE__::push_back(ItemType&& item_) const
+{
+    persistent_vector version(*this);
+    version.append_item(std::move(item_));
+    return version;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a new version without the last element.
+ *
+ * \throw       std::length_error
+ *              If the vector is empty.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__ PERSISTENT_VECTOR_CLASS_SCOPE__::pop_back() const
+{
+    persistent_vector version(*this);
+    version.remove_last();
+    return version;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a new version with another value at an index. Copies the leaf and the nodes
+ *              leading to it, in O(log32 n); everything else is shared.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_CLASS_SCOPE__::set(SizeType index_, const ItemType& item_) const
+{
+    return update(index_, [&item_](ItemType& target_) { target_ = item_; });
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_CLASS_SCOPE__::set(SizeType index_, ItemType&& item_) const
+{
+    return update(index_, [&item_](ItemType& target_) { target_ = std::move(item_); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a new version where the element at an index was changed by a function, as
+ *              set().
+ *
+ * \param       function_: Called once with a modifiable reference to the new version's element.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_CLASS_SCOPE__::update(SizeType index_, FunctionType&& function_) const
+{
+    persistent_vector version(*this);
+    version.modify_item(index_, function_);
+    return version;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a new version holding the elements of this vector followed by those of another,
+ *              in O(log32 n). Only the nodes along the seam are rebuilt; the others are shared by
+ *              all three vectors.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline PERSISTENT_VECTOR_CLASS_SCOPE__
+PERSISTENT_VECTOR_CLASS_SCOPE__::concat(const persistent_vector& rhs_) const
+{
+    persistent_vector version(*this);
+    version.append_vector(rhs_);
+    return version;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a transient_vector starting out with this version's elements, to apply a batch
+ *              of edits without copying the same nodes over and over.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::TransientType
+PERSISTENT_VECTOR_CLASS_SCOPE__::transient() const noexcept
+{
+    return TransientType(*this);
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::SizeType
+PERSISTENT_VECTOR_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline bool PERSISTENT_VECTOR_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline bool PERSISTENT_VECTOR_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_length != 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of levels of the tree, leaves included; the tail is not counted.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::SizeType
+PERSISTENT_VECTOR_CLASS_SCOPE__::depth() const noexcept
+{
+    return m_root == nullptr ? 0 : m_shift / branching_bits + 1;
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const AllocatorType& PERSISTENT_VECTOR_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the vector as a string, such as "[1, 2, 3]".
+ *              Elements that cannot be written to a std::ostream are shown as "?".
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline std::string PERSISTENT_VECTOR_CLASS_SCOPE__::to_string() const
+{
+    std::ostringstream stream;
+    bool               first = true;
+
+    stream << '[';
+    for_each_segment([&stream, &first](SpanType segment_) {
+        for(const ItemType& item : segment_)
+        {
+            if(first == false)
+            {
+                stream << ", ";
+            }
+            first = false;
+
+            if constexpr(requires(std::ostream& os_, const ItemType& item_) { os_ << item_; })
+            {
+                stream << item;
+            }
+            else
+            {
+                stream << '?';
+            }
+        }
+    });
+    stream << ']';
+    return stream.str();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline ItemType* PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node::items() noexcept
+{
+    return std::launder(reinterpret_cast<ItemType*>(storage));
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType* PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node::items() const noexcept
+{
+    return std::launder(reinterpret_cast<const ItemType*>(storage));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element at the end, in the tail. A full tail moves into the tree first.
+ *              Nothing changes if constructing the element throws.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::append_item(Args&&... args_)
+{
+    if(m_tail != nullptr && m_tail->count < branching)
+    {
+        leaf_node* tail = own_leaf(m_tail);
+        AllocatorTraits::construct(m_allocator,
+                                   tail->items() + tail->count,
+                                   std::forward<Args>(args_)...);
+        ++tail->count;
+    }
+    else
+    {
+        leaf_node* tail = new_leaf();
+        try
+        {
+            AllocatorTraits::construct(m_allocator, tail->items(), std::forward<Args>(args_)...);
+        }
+        catch(...)
+        {
+            free_leaf(tail);
+            throw;
+        }
+        tail->count = 1;
+
+        if(m_tail != nullptr)
+        {
+            try
+            {
+                push_leaf(as_leaf(m_tail));
+            }
+            catch(...)
+            {
+                release(tail, 0);
+                throw;
+            }
+        }
+        m_tail = tail;
+    }
+
+    ++m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the last element. When it is alone in the tail, the last leaf of the tree
+ *              becomes the tail.
+ *
+ * \throw       std::length_error
+ *              If the vector is empty.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::remove_last()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+
+    if(m_tail->count > 1)
+    {
+        if(is_unique(m_tail))
+        {
+            leaf_node* tail = as_leaf(m_tail);
+            --tail->count;
+            AllocatorTraits::destroy(m_allocator, tail->items() + tail->count);
+        }
+        else
+        {
+            leaf_node* tail = copy_leaf(as_leaf(m_tail), m_tail->count - 1);
+            release(m_tail, 0);
+            m_tail = tail;
+        }
+    }
+    else
+    {
+        leaf_node* tail = m_root == nullptr ? nullptr : pop_leaf();
+        release(m_tail, 0);
+        m_tail = tail;
+    }
+
+    --m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function on the element at an index, after copying the nodes leading to it
+ *              that are shared with another version.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::modify_item(SizeType index_, FunctionType& function_)
+{
+    check_index(index_);
+
+    const SizeType offset = tail_offset();
+    if(index_ >= offset)
+    {
+        function_(own_leaf(m_tail)->items()[index_ - offset]);
+        return;
+    }
+
+    node**   slot  = &m_root;
+    SizeType shift = m_shift;
+    for(; shift != 0; shift -= branching_bits)
+    {
+        inner_node* inner = own_inner(*slot, shift);
+        slot              = &inner->children[child_slot(inner, shift, index_)];
+    }
+    function_(own_leaf(*slot)->items()[index_ & (branching - 1)]);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Add the elements of another vector at the end.
+ *              A right-hand side made of a tail only is merged into the tail, or becomes the tail;
+ *              otherwise the tail is pushed into the tree, which is then concatenated with the
+ *              other tree, and the other tail becomes the tail.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::append_vector(const persistent_vector& rhs_)
+{
+    if(rhs_.is_empty())
+    {
+        return;
+    }
+    if(is_empty())
+    {
+        *this = rhs_;
+        return;
+    }
+
+    const SizeType newLength = m_length + rhs_.m_length;
+    node* const    rhsTail   = rhs_.m_tail;
+
+    if(rhs_.m_root == nullptr && m_tail->count + rhsTail->count <= branching)
+    {
+        leaf_node* const       tail      = own_leaf(m_tail);
+        const leaf_node* const source    = as_leaf(rhsTail);
+        const std::uint32_t    tailCount = tail->count;
+        try
+        {
+            for(std::uint32_t i = 0; i < source->count; ++i)
+            {
+                AllocatorTraits::construct(
+                  m_allocator, tail->items() + tail->count, source->items()[i]);
+                ++tail->count;
+            }
+        }
+        catch(...)
+        {
+            while(tail->count != tailCount)
+            {
+                --tail->count;
+                AllocatorTraits::destroy(m_allocator, tail->items() + tail->count);
+            }
+            throw;
+        }
+    }
+    else if(rhs_.m_root == nullptr)
+    {
+        push_leaf(as_leaf(m_tail));
+        retain(rhsTail);
+        m_tail = rhsTail;
+    }
+    else
+    {
+        /* Work on a copy, so that this vector is left untouched if an allocation fails */
+        persistent_vector left(*this);
+        left.push_leaf(as_leaf(left.m_tail));
+        left.m_tail = nullptr;
+
+        inner_node* const joined =
+          concat_subtrees(left.m_root, left.m_shift, rhs_.m_root, rhs_.m_shift);
+        const SizeType joinedShift = std::max(left.m_shift, rhs_.m_shift) + branching_bits;
+
+        retain(rhsTail);
+        release();
+        m_root  = joined;
+        m_shift = joinedShift;
+        m_tail  = rhsTail;
+        collapse_root();
+    }
+
+    m_length = newLength;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the leaf holding the element at an index, and the index of its first element.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_location
+PERSISTENT_VECTOR_CLASS_SCOPE__::locate(SizeType index_) const noexcept
+{
+    const SizeType offset = tail_offset();
+    if(index_ >= offset)
+    {
+        return leaf_location{as_leaf(m_tail)->items(), offset, m_tail->count};
+    }
+
+    const node* current  = m_root;
+    SizeType    relative = index_;
+    for(SizeType shift = m_shift; shift != 0; shift -= branching_bits)
+    {
+        const inner_node* inner = as_inner(current);
+        current                 = inner->children[child_slot(inner, shift, relative)];
+    }
+
+    const leaf_node* leaf = as_leaf(current);
+    return leaf_location{leaf->items(), index_ - (relative & (branching - 1)), leaf->count};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Index of the first element of the tail.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::SizeType
+PERSISTENT_VECTOR_CLASS_SCOPE__::tail_offset() const noexcept
+{
+    return m_tail == nullptr ? 0 : m_length - m_tail->count;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make sure an index refers to an element.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::check_index(SizeType index_) const
+{
+    if(index_ >= m_length)
+    {
+        throw std::length_error("Index out of range");
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move a leaf to the right edge of the tree, adding a level when the tree is full.
+ *
+ * \param       leaf_: Leaf whose reference the tree takes over. The caller keeps it on failure.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::push_leaf(leaf_node* leaf_)
+{
+    if(m_root == nullptr)
+    {
+        m_root  = leaf_;
+        m_shift = 0;
+        return;
+    }
+    if(m_shift != 0 && append_leaf(m_root, m_shift, leaf_))
+    {
+        return;
+    }
+
+    inner_node* root = new_inner();
+    try
+    {
+        root->children[1] = new_path(m_shift, leaf_);
+    }
+    catch(...)
+    {
+        free_inner(root);
+        throw;
+    }
+    root->children[0] = m_root;
+    root->count       = 2;
+
+    m_root = root;
+    m_shift += branching_bits;
+    seal(root, m_shift);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Add a leaf to the right edge of a subtree, if it has room for one.
+ *
+ * \param       slot_:  Reference to the inner node at the top of the subtree; replaced by a copy if
+ *                      the node is shared.
+ * \param       shift_: Level of the node.
+ * \param       leaf_:  Leaf whose reference the subtree takes over.
+ *
+ * \retval      bool: False, with nothing changed, if the subtree is full.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline bool
+PERSISTENT_VECTOR_CLASS_SCOPE__::append_leaf(node*& slot_, SizeType shift_, leaf_node* leaf_)
+{
+    if(has_room(slot_, shift_) == false)
+    {
+        return false;
+    }
+
+    inner_node* inner = own_inner(slot_, shift_);
+    node*&      last  = inner->children[inner->count - 1];
+    if(has_room(last, shift_ - branching_bits))
+    {
+        static_cast<void>(append_leaf(last, shift_ - branching_bits, leaf_));
+    }
+    else
+    {
+        inner->children[inner->count] = new_path(shift_ - branching_bits, leaf_);
+        ++inner->count;
+    }
+
+    seal(inner, shift_);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Build a chain of inner nodes down to a leaf.
+ *
+ * \param       shift_: Level of the top of the chain; the leaf itself is returned at level 0.
+ * \param       leaf_:  Leaf whose reference the chain takes over. The caller keeps it on failure.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::new_path(SizeType shift_, leaf_node* leaf_)
+{
+    if(shift_ == 0)
+    {
+        return leaf_;
+    }
+
+    inner_node* inner = new_inner();
+    try
+    {
+        inner->children[0] = new_path(shift_ - branching_bits, leaf_);
+    }
+    catch(...)
+    {
+        free_inner(inner);
+        throw;
+    }
+    inner->count = 1;
+    seal(inner, shift_);
+    return inner;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take the last leaf out of the tree, and lower the tree if its root is left with a
+ *              single child.
+ *
+ * \retval      leaf_node*: The leaf, whose reference the caller takes over.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::pop_leaf()
+{
+    if(m_shift == 0)
+    {
+        return as_leaf(std::exchange(m_root, nullptr));
+    }
+
+    leaf_node* leaf = remove_last_leaf(m_root, m_shift);
+    collapse_root();
+    return leaf;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take the last leaf out of a subtree, dropping the inner nodes left empty.
+ *
+ * \param       slot_:  Reference to the inner node at the top of the subtree; replaced by a copy if
+ *                      the node is shared.
+ * \param       shift_: Level of the node.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::remove_last_leaf(node*& slot_, SizeType shift_)
+{
+    inner_node* inner = own_inner(slot_, shift_);
+    node*&      last  = inner->children[inner->count - 1];
+    leaf_node*  leaf  = nullptr;
+
+    if(shift_ == branching_bits)
+    {
+        leaf = as_leaf(last);
+        --inner->count;
+    }
+    else
+    {
+        leaf = remove_last_leaf(last, shift_ - branching_bits);
+        if(last->count == 0)
+        {
+            free_inner(as_inner(last));
+            --inner->count;
+        }
+    }
+
+    if(inner->count != 0)
+    {
+        seal(inner, shift_);
+    }
+    return leaf;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the root by its child for as long as it has a single one.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::collapse_root() noexcept
+{
+    while(m_shift != 0 && m_root->count == 1)
+    {
+        node* child = as_inner(m_root)->children[0];
+        retain(child);
+        release(m_root, m_shift);
+
+        m_root = child;
+        m_shift -= branching_bits;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Join two subtrees, redistributing the nodes along the seam so that lookups in the
+ *              relaxed nodes stay within a couple of steps of the radix guess.
+ *              The subtrees are left untouched; the nodes away from the seam are shared.
+ *
+ * \retval      inner_node*: New node one level above the higher subtree, with 1 or 2 children.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::inner_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::concat_subtrees(node*    left_,
+                                                 SizeType leftShift_,
+                                                 node*    right_,
+                                                 SizeType rightShift_)
+{
+    if(leftShift_ > rightShift_)
+    {
+        const inner_node* left = as_inner(left_);
+        inner_node*       center = concat_subtrees(
+          left->children[left->count - 1], leftShift_ - branching_bits, right_, rightShift_);
+        return rebalance(left, center, nullptr, leftShift_);
+    }
+    if(leftShift_ < rightShift_)
+    {
+        const inner_node* right = as_inner(right_);
+        inner_node*       center =
+          concat_subtrees(left_, leftShift_, right->children[0], rightShift_ - branching_bits);
+        return rebalance(nullptr, center, right, rightShift_);
+    }
+    if(leftShift_ == 0)
+    {
+        inner_node* inner = new_inner();
+        retain(left_);
+        retain(right_);
+        inner->children[0] = left_;
+        inner->children[1] = right_;
+        inner->count       = 2;
+        seal(inner, branching_bits);
+        return inner;
+    }
+
+    const inner_node* left   = as_inner(left_);
+    const inner_node* right  = as_inner(right_);
+    inner_node*       center = concat_subtrees(left->children[left->count - 1],
+                                         leftShift_ - branching_bits,
+                                         right->children[0],
+                                         rightShift_ - branching_bits);
+    return rebalance(left, center, right, leftShift_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Regroup the children along the seam of a concatenation.
+ *              Gathers the children of the left node but its last, of the center and of the right
+ *              node but its first, then merges the short ones into their neighbours until there
+ *              are at most 2 more than the minimum needed to hold all their slots. Children that
+ *              are not merged are shared as they are.
+ *
+ * \param       left_:   Left node at level shift_, or null.
+ * \param       center_: Result of joining the nodes below, at level shift_. Released here.
+ * \param       right_:  Right node at level shift_, or null.
+ * \param       shift_:  Level of the nodes.
+ *
+ * \retval      inner_node*: New node at the level above, with 1 or 2 children.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::inner_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::rebalance(const inner_node* left_,
+                                           inner_node*       center_,
+                                           const inner_node* right_,
+                                           SizeType          shift_)
+{
+    const SizeType childShift = shift_ - branching_bits;
+
+    node*    children[2 * branching];
+    SizeType childCount = 0;
+    if(left_ != nullptr)
+    {
+        std::copy_n(left_->children, left_->count - 1, children);
+        childCount = left_->count - 1;
+    }
+    std::copy_n(center_->children, center_->count, children + childCount);
+    childCount += center_->count;
+    if(right_ != nullptr)
+    {
+        std::copy(right_->children + 1, right_->children + right_->count, children + childCount);
+        childCount += right_->count - 1;
+    }
+
+    /* Plan how many slots each new child gets */
+    SizeType counts[2 * branching];
+    SizeType slotCount = 0;
+    for(SizeType child = 0; child < childCount; ++child)
+    {
+        counts[child] = children[child]->count;
+        slotCount += counts[child];
+    }
+
+    const SizeType minimumCount = (slotCount + branching - 1) / branching;
+    SizeType       newCount     = childCount;
+    SizeType       i            = 0;
+    while(newCount > minimumCount + rebalance_extras)
+    {
+        while(counts[i] > branching - rebalance_extras / 2)
+        {
+            ++i;
+        }
+
+        /* Spread the short child over the next ones, which all move down by one */
+        SizeType remaining = counts[i];
+        do
+        {
+            const SizeType merged = std::min(remaining + counts[i + 1], branching);
+            remaining             = remaining + counts[i + 1] - merged;
+            counts[i]             = merged;
+            ++i;
+        } while(remaining > 0);
+
+        std::copy(counts + i + 1, counts + newCount, counts + i);
+        --newCount;
+        --i;
+    }
+
+    /* Build the new children, copying the slots of the merged ones */
+    node*    built[2 * branching] = {};
+    SizeType builtCount = 0;
+    SizeType source     = 0;
+    SizeType offset     = 0;
+    try
+    {
+        for(; builtCount < newCount; ++builtCount)
+        {
+            if(offset == 0 && children[source]->count == counts[builtCount])
+            {
+                retain(children[source]);
+                built[builtCount] = children[source++];
+                continue;
+            }
+
+            if(childShift == 0)
+            {
+                leaf_node* leaf   = new_leaf();
+                built[builtCount] = leaf;
+                while(leaf->count != counts[builtCount])
+                {
+                    const leaf_node* from = as_leaf(children[source]);
+                    const SizeType   take =
+                      std::min<SizeType>(counts[builtCount] - leaf->count, from->count - offset);
+                    for(SizeType item = 0; item < take; ++item)
+                    {
+                        AllocatorTraits::construct(
+                          m_allocator, leaf->items() + leaf->count, from->items()[offset + item]);
+                        ++leaf->count;
+                    }
+
+                    offset += take;
+                    if(offset == from->count)
+                    {
+                        ++source;
+                        offset = 0;
+                    }
+                }
+            }
+            else
+            {
+                inner_node* inner = new_inner();
+                built[builtCount] = inner;
+                while(inner->count != counts[builtCount])
+                {
+                    const inner_node* from = as_inner(children[source]);
+                    const SizeType    take =
+                      std::min<SizeType>(counts[builtCount] - inner->count, from->count - offset);
+                    for(SizeType child = 0; child < take; ++child)
+                    {
+                        retain(from->children[offset + child]);
+                        inner->children[inner->count++] = from->children[offset + child];
+                    }
+
+                    offset += take;
+                    if(offset == from->count)
+                    {
+                        ++source;
+                        offset = 0;
+                    }
+                }
+                seal(inner, childShift);
+            }
+        }
+    }
+    catch(...)
+    {
+        /* The child being built when the exception was thrown holds what was copied so far */
+        for(node* child : built)
+        {
+            release(child, childShift);
+        }
+        release(center_, shift_);
+        throw;
+    }
+
+    /* Group them under one or two nodes of this level, under a node of the level above */
+    inner_node* parent = nullptr;
+    inner_node* first  = nullptr;
+    inner_node* second = nullptr;
+    try
+    {
+        parent = new_inner();
+        first  = new_inner();
+        if(newCount > branching)
+        {
+            second = new_inner();
+        }
+    }
+    catch(...)
+    {
+        for(inner_node* inner : {parent, first})
+        {
+            if(inner != nullptr)
+            {
+                free_inner(inner);
+            }
+        }
+        for(node* child : built)
+        {
+            release(child, childShift);
+        }
+        release(center_, shift_);
+        throw;
+    }
+
+    const SizeType firstCount = std::min(newCount, branching);
+    std::copy_n(built, firstCount, first->children);
+    first->count = static_cast<std::uint32_t>(firstCount);
+    seal(first, shift_);
+    parent->children[0] = first;
+    parent->count       = 1;
+
+    if(second != nullptr)
+    {
+        std::copy(built + firstCount, built + newCount, second->children);
+        second->count = static_cast<std::uint32_t>(newCount - firstCount);
+        seal(second, shift_);
+        parent->children[1] = second;
+        parent->count       = 2;
+    }
+    seal(parent, shift_ + branching_bits);
+
+    release(center_, shift_);
+    return parent;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate an empty leaf. The elements are left unconstructed.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::new_leaf()
+{
+    LeafAllocatorType leafAllocator(m_allocator);
+    leaf_node*        leaf = LeafTraits::allocate(leafAllocator, 1);
+
+    /* Default-initialized rather than constructed through the allocator, which would zero the
+     * storage of the elements */
+    return ::new(static_cast<void*>(leaf)) leaf_node;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate an inner node without children.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::inner_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::new_inner()
+{
+    InnerAllocatorType innerAllocator(m_allocator);
+    inner_node*        inner = InnerTraits::allocate(innerAllocator, 1);
+    return ::new(static_cast<void*>(inner)) inner_node;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the first elements of a leaf to a new leaf.
+ *
+ * \param       source_: Leaf to copy.
+ * \param       count_:  Number of elements to copy, at most the number in the source.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::copy_leaf(const leaf_node* source_, SizeType count_)
+{
+    leaf_node* leaf = new_leaf();
+    try
+    {
+        for(; leaf->count < count_; ++leaf->count)
+        {
+            AllocatorTraits::construct(
+              m_allocator, leaf->items() + leaf->count, source_->items()[leaf->count]);
+        }
+    }
+    catch(...)
+    {
+        release(leaf, 0);
+        throw;
+    }
+    return leaf;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy an inner node, sharing its children.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::inner_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::copy_inner(const inner_node* source_)
+{
+    inner_node* inner = new_inner();
+    inner->count      = source_->count;
+    inner->relaxed    = source_->relaxed;
+    for(std::uint32_t i = 0; i < source_->count; ++i)
+    {
+        retain(source_->children[i]);
+        inner->children[i] = source_->children[i];
+    }
+    std::copy_n(source_->sizes, source_->count, inner->sizes);
+    return inner;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get a leaf that can be modified in place, copying it first if it is shared.
+ *
+ * \param       slot_: Reference to the leaf, replaced by the copy.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::own_leaf(node*& slot_)
+{
+    if(is_unique(slot_))
+    {
+        return as_leaf(slot_);
+    }
+
+    leaf_node* leaf = copy_leaf(as_leaf(slot_), slot_->count);
+    release(slot_, 0);
+    slot_ = leaf;
+    return leaf;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get an inner node that can be modified in place, copying it first if it is shared.
+ *
+ * \param       slot_:  Reference to the node, replaced by the copy.
+ * \param       shift_: Level of the node.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::inner_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::own_inner(node*& slot_, SizeType shift_)
+{
+    if(is_unique(slot_))
+    {
+        return as_inner(slot_);
+    }
+
+    inner_node* inner = copy_inner(as_inner(slot_));
+    release(slot_, shift_);
+    slot_ = inner;
+    return inner;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free a leaf whose elements were already destroyed.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::free_leaf(leaf_node* leaf_) noexcept
+{
+    LeafAllocatorType leafAllocator(m_allocator);
+    std::destroy_at(leaf_);
+    LeafTraits::deallocate(leafAllocator, leaf_, 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free an inner node without touching its children.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::free_inner(inner_node* inner_) noexcept
+{
+    InnerAllocatorType innerAllocator(m_allocator);
+    std::destroy_at(inner_);
+    InnerTraits::deallocate(innerAllocator, inner_, 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop a reference to a node. The last one destroys its elements, or drops its own
+ *              references to its children, and frees it.
+ *
+ * \param       node_:  Node to release, may be null.
+ * \param       shift_: Level of the node; 0 for a leaf.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::release(node* node_, SizeType shift_) noexcept
+{
+    if(node_ == nullptr || node_->referenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    if(shift_ == 0)
+    {
+        leaf_node* leaf = as_leaf(node_);
+        for(std::uint32_t i = 0; i < leaf->count; ++i)
+        {
+            AllocatorTraits::destroy(m_allocator, leaf->items() + i);
+        }
+        free_leaf(leaf);
+    }
+    else
+    {
+        inner_node* inner = as_inner(node_);
+        for(std::uint32_t i = 0; i < inner->count; ++i)
+        {
+            release(inner->children[i], shift_ - branching_bits);
+        }
+        free_inner(inner);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Drop this version's references to the tree and the tail, and leave it empty.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::release() noexcept
+{
+    release(m_root, m_shift);
+    release(m_tail, 0);
+
+    m_root   = nullptr;
+    m_shift  = 0;
+    m_tail   = nullptr;
+    m_length = 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function with the leaves of a subtree, in order.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::visit_leaves(const node*   node_,
+                                                          SizeType      shift_,
+                                                          FunctionType& function_)
+{
+    if(shift_ == 0)
+    {
+        function_(SpanType(as_leaf(node_)->items(), node_->count));
+        return;
+    }
+
+    const inner_node* inner = as_inner(node_);
+    for(std::uint32_t i = 0; i < inner->count; ++i)
+    {
+        visit_leaves(inner->children[i], shift_ - branching_bits, function_);
+    }
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::retain(node* node_) noexcept
+{
+    if(node_ != nullptr)
+    {
+        node_->referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Whether no other version or node refers to a node, which can then change in place.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline bool PERSISTENT_VECTOR_CLASS_SCOPE__::is_unique(const node* node_) noexcept
+{
+    return node_->referenceCount.load(std::memory_order_acquire) == 1;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Whether a leaf can be added to the right edge of a subtree without a new level.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline bool PERSISTENT_VECTOR_CLASS_SCOPE__::has_room(const node* node_, SizeType shift_) noexcept
+{
+    if(shift_ == 0)
+    {
+        return false;
+    }
+    return node_->count < branching
+           || has_room(as_inner(node_)->children[node_->count - 1], shift_ - branching_bits);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements in a subtree.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::SizeType
+PERSISTENT_VECTOR_CLASS_SCOPE__::subtree_size(const node* node_, SizeType shift_) noexcept
+{
+    return shift_ == 0 ? node_->count : as_inner(node_)->sizes[node_->count - 1];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the child of an inner node holding an element.
+ *              Regular nodes use the index bits of their level. Relaxed nodes start from the same
+ *              guess, which can only be too low, and scan their size table forward.
+ *
+ * \param       inner_:  Inner node.
+ * \param       shift_:  Level of the node.
+ * \param       index_:  Index of the element within the node, made relative to the child.
+ *
+ * \retval      SizeType: Index of the child.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::SizeType
+PERSISTENT_VECTOR_CLASS_SCOPE__::child_slot(const inner_node* inner_,
+                                            SizeType          shift_,
+                                            SizeType&         index_) noexcept
+{
+    if(inner_->relaxed == false)
+    {
+        return (index_ >> shift_) & (branching - 1);
+    }
+
+    SizeType slot = index_ >> shift_;
+    while(inner_->sizes[slot] <= index_)
+    {
+        ++slot;
+    }
+    if(slot != 0)
+    {
+        index_ -= inner_->sizes[slot - 1];
+    }
+    return slot;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Recompute the size table of an inner node after its children changed, and whether
+ *              it is relaxed: it stays regular while every child but the last is full and the last
+ *              one is regular.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void PERSISTENT_VECTOR_CLASS_SCOPE__::seal(inner_node* inner_, SizeType shift_) noexcept
+{
+    const SizeType fullSize = SizeType{1} << shift_;
+
+    SizeType total   = 0;
+    bool     relaxed = false;
+    for(std::uint32_t i = 0; i < inner_->count; ++i)
+    {
+        const SizeType size = subtree_size(inner_->children[i], shift_ - branching_bits);
+        total += size;
+        inner_->sizes[i] = total;
+        relaxed          = relaxed || (i + 1 < inner_->count && size != fullSize);
+    }
+
+    const node* last = inner_->children[inner_->count - 1];
+    inner_->relaxed  = relaxed || (shift_ > branching_bits && as_inner(last)->relaxed);
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::as_leaf(node* node_) noexcept
+{
+    return static_cast<leaf_node*>(node_);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const typename PERSISTENT_VECTOR_CLASS_SCOPE__::leaf_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::as_leaf(const node* node_) noexcept
+{
+    return static_cast<const leaf_node*>(node_);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename PERSISTENT_VECTOR_CLASS_SCOPE__::inner_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::as_inner(node* node_) noexcept
+{
+    return static_cast<inner_node*>(node_);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const typename PERSISTENT_VECTOR_CLASS_SCOPE__::inner_node*
+PERSISTENT_VECTOR_CLASS_SCOPE__::as_inner(const node* node_) noexcept
+{
+    return static_cast<const inner_node*>(node_);
+}
+
+
+
+/*************************************************************************************************/
+/* TRANSIENT ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline TRANSIENT_VECTOR_CLASS_SCOPE__::transient_vector(const AllocatorType& alloc_)
+: m_vector{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Start out with the elements of a version, sharing all of its nodes.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline TRANSIENT_VECTOR_CLASS_SCOPE__::transient_vector(PersistentType vector_) noexcept
+: m_vector{std::move(vector_)}
+{
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& TRANSIENT_VECTOR_CLASS_SCOPE__::at(SizeType index_) const
+{
+    return m_vector.at(index_);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& TRANSIENT_VECTOR_CLASS_SCOPE__::front() const
+{
+    return m_vector.front();
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& TRANSIENT_VECTOR_CLASS_SCOPE__::back() const
+{
+    return m_vector.back();
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline const ItemType& TRANSIENT_VECTOR_CLASS_SCOPE__::operator[](SizeType index_) const noexcept
+{
+    return m_vector[index_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element at the end, in place in the tail once it belongs to the
+ *              transient alone.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::emplace_back(Args&&... args_)
+{
+    m_vector.append_item(std::forward<Args>(args_)...);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::push_back(const ItemType& item_)
+{
+    m_vector.append_item(item_);
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::push_back(ItemType&& item_)
+{
+    m_vector.append_item(std::move(item_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the last element.
+ *
+ * \throw       std::length_error
+ *              If the vector is empty.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::pop_back()
+{
+    m_vector.remove_last();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Give the element at an index another value. Copies the nodes leading to it that are
+ *              still shared, the first time only.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::set(SizeType index_, const ItemType& item_)
+{
+    update(index_, [&item_](ItemType& target_) { target_ = item_; });
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::set(SizeType index_, ItemType&& item_)
+{
+    update(index_, [&item_](ItemType& target_) { target_ = std::move(item_); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Change the element at an index through a function, as set().
+ *
+ * \param       function_: Called once with a modifiable reference to the element.
+ *
+ * \throws      std::length_error("Index out of range")
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::update(SizeType index_, FunctionType&& function_)
+{
+    m_vector.modify_item(index_, function_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Add the elements of a version at the end, as persistent_vector::concat().
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline void TRANSIENT_VECTOR_CLASS_SCOPE__::append(const PersistentType& rhs_)
+{
+    m_vector.append_vector(rhs_);
+}
+
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename TRANSIENT_VECTOR_CLASS_SCOPE__::SizeType
+TRANSIENT_VECTOR_CLASS_SCOPE__::length() const noexcept
+{
+    return m_vector.length();
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline bool TRANSIENT_VECTOR_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_vector.is_empty();
+}
+
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline bool TRANSIENT_VECTOR_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_vector.is_not_empty();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the current elements as a new version, in O(1).
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_TEMPLATE_DECLARATION__>
+inline typename TRANSIENT_VECTOR_CLASS_SCOPE__::PersistentType
+TRANSIENT_VECTOR_CLASS_SCOPE__::persistent() const noexcept
+{
+    return m_vector;
+}
+
+
+
+/*************************************************************************************************/
+/* COMPARISON OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Two vectors are equal when they hold equal elements, in the same order.
+ *************************************************************************************************/
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator==(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__)
+{
+    return lhs_.length() == rhs_.length() && std::equal(lhs_.begin(), lhs_.end(), rhs_.begin());
+}
+
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator!=(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ == rhs_);
+}
+
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator<(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__)
+{
+    return std::lexicographical_compare(lhs_.begin(), lhs_.end(), rhs_.begin(), rhs_.end());
+}
+
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator<=(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__)
+{
+    return !(rhs_ < lhs_);
+}
+
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator>(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__)
+{
+    return rhs_ < lhs_;
+}
+
+template<PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__>
+inline bool operator>=(PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__)
+{
+    return !(lhs_ < rhs_);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef PERSISTENT_VECTOR_TEMPLATE_DECLARATION__
+#undef PERSISTENT_VECTOR_CLASS_SCOPE__
+#undef PERSISTENT_VECTOR_ITERATOR_CLASS_SCOPE__
+#undef TRANSIENT_VECTOR_CLASS_SCOPE__
+#undef PERSISTENT_VECTOR_OPERATOR_TEMPLATE_DECLARATION__
+#undef PERSISTENT_VECTOR_OPERATOR_ARGUMENTS__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+#include "./iterator_base.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Forward iterator over the elements of a contiguous container taken at a sequence of
+ *              indices, which prefetches the element a fixed number of indices ahead.
+ *
+ *              Once the container does not fit in the cache, visiting it in index order waits on
+ *              DRAM for nearly every element. This iterator keeps Distance loads in flight ahead
+ *              of the current one, so that user loops get the same overlap as pel::gather.
+ *              Nothing is prefetched past the end of the indices, and indices are not checked.
+ *
+ *              Two iterators are equal when they are at the same position in the indices.
+ */
+template<typename ItemType, std::random_access_iterator IndexIterator>
+class prefetching_iterator
+{
+public:
+    /*------------------------------------*/
+    /* Typenames */
+    using IteratorType = prefetching_iterator<ItemType, IndexIterator>;
+
+    using SizeType       = std::size_t;
+    using DifferenceType = std::iter_difference_t<IndexIterator>;
+
+    using PointerType   = ItemType*;
+    using ReferenceType = ItemType&;
+
+    /* Types for the STL */
+    using IteratorCategory  = std::forward_iterator_tag;
+    using iterator_category = IteratorCategory;
+    using self_type         = IteratorType;
+    using value_type        = std::remove_const_t<ItemType>;
+    using reference         = ReferenceType;
+    using pointer           = PointerType;
+    using difference_type   = DifferenceType;
+    using size_type         = SizeType;
+
+    /*------------------------------------*/
+    /* Constructors */
+    constexpr prefetching_iterator() noexcept = default;
+
+    prefetching_iterator(iterator_base<std::remove_const_t<ItemType>> first_,
+                         IndexIterator                                index_,
+                         IndexIterator                                last_,
+                         SizeType distance_ = default_prefetch_distance) noexcept;
+
+    /*------------------------------------*/
+    /* Memory operators */
+    [[nodiscard]] constexpr IndexIterator index_iterator() const noexcept;
+
+    [[nodiscard]] constexpr ReferenceType operator*() const noexcept;
+    [[nodiscard]] constexpr PointerType   operator->() const noexcept;
+
+    /*------------------------------------*/
+    /* Arithmetic operators */
+    prefetching_iterator& operator++() noexcept;
+    prefetching_iterator  operator++(int) noexcept;
+
+    /*------------------------------------*/
+    /* Comparison operators */
+    [[nodiscard]] constexpr bool operator==(const prefetching_iterator& rhs_) const noexcept;
+    [[nodiscard]] constexpr bool operator!=(const prefetching_iterator& rhs_) const noexcept;
+
+    /*------------------------------------*/
+protected:
+    PointerType    m_first = nullptr;
+    IndexIterator  m_index{};
+    IndexIterator  m_last{};
+    DifferenceType m_distance = 0;
+};
+
+
+}        // namespace pel
+
+#include "./prefetching_iterator.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
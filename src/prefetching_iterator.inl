@@ -0,0 +1,165 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./prefetching_iterator.hpp"
+
+#include <algorithm>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__ typename ItemType,                             \
+                                                    std::random_access_iterator IndexIterator
+#define PREFETCHING_ITERATOR_CLASS_SCOPE__          prefetching_iterator<ItemType, IndexIterator>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS -------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Start walking a container at a position in a sequence of indices.
+ *              The first Distance elements are prefetched right away.
+ *
+ * \param       first_:    Iterator to the first element of the container.
+ * \param       index_:    Position of the iterator in the indices.
+ * \param       last_:     End of the indices; nothing at or after it is read.
+ * \param       distance_: Number of indices ahead whose element is prefetched. 0 disables it.
+ *************************************************************************************************/
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+inline PREFETCHING_ITERATOR_CLASS_SCOPE__::prefetching_iterator(
+  iterator_base<std::remove_const_t<ItemType>> first_,
+  IndexIterator                                index_,
+  IndexIterator                                last_,
+  SizeType                                     distance_) noexcept
+: m_first{first_.ptr()},
+  m_index{index_},
+  m_last{last_},
+  m_distance{static_cast<DifferenceType>(distance_)}
+{
+    const DifferenceType warmUp = std::min(m_distance, m_last - m_index);
+    for(DifferenceType ahead = 0; ahead < warmUp; ++ahead)
+    {
+        prefetch(m_first + m_index[ahead]);
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY OPERATORS ---------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Position of the iterator in the indices.
+ *************************************************************************************************/
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline IndexIterator
+PREFETCHING_ITERATOR_CLASS_SCOPE__::index_iterator() const noexcept
+{
+    return m_index;
+}
+
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename PREFETCHING_ITERATOR_CLASS_SCOPE__::ReferenceType
+PREFETCHING_ITERATOR_CLASS_SCOPE__::operator*() const noexcept
+{
+    return m_first[*m_index];
+}
+
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename PREFETCHING_ITERATOR_CLASS_SCOPE__::PointerType
+PREFETCHING_ITERATOR_CLASS_SCOPE__::operator->() const noexcept
+{
+    return m_first + *m_index;
+}
+
+
+
+/*************************************************************************************************/
+/* ARITHMETIC OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Step to the next index, prefetching the element Distance indices ahead.
+ *************************************************************************************************/
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+inline PREFETCHING_ITERATOR_CLASS_SCOPE__& PREFETCHING_ITERATOR_CLASS_SCOPE__::operator++() noexcept
+{
+    if(m_distance != 0 && m_last - m_index > m_distance)
+    {
+        prefetch(m_first + m_index[m_distance]);
+    }
+    ++m_index;
+    return *this;
+}
+
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+inline PREFETCHING_ITERATOR_CLASS_SCOPE__
+PREFETCHING_ITERATOR_CLASS_SCOPE__::operator++(int) noexcept
+{
+    prefetching_iterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+
+
+/*************************************************************************************************/
+/* COMPARISON OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline bool
+PREFETCHING_ITERATOR_CLASS_SCOPE__::operator==(const prefetching_iterator& rhs_) const noexcept
+{
+    return m_index == rhs_.m_index;
+}
+
+template<PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline bool
+PREFETCHING_ITERATOR_CLASS_SCOPE__::operator!=(const prefetching_iterator& rhs_) const noexcept
+{
+    return m_index != rhs_.m_index;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef PREFETCHING_ITERATOR_TEMPLATE_DECLARATION__
+#undef PREFETCHING_ITERATOR_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
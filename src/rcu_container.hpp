@@ -0,0 +1,150 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./epoch_domain.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Read-mostly holder of a container, whose readers never lock nor touch a reference
+ *              count.
+ *
+ *              Readers open a read section (read() returns a guard) and get a plain pointer to the
+ *              current version of the container. Writers build a complete new version and publish
+ *              it with a single atomic exchange; the previous version is retired and destroyed once
+ *              every reader that could still see it has left its read section, as tracked by the
+ *              process-wide epoch_domain.
+ *
+ *              ContainerType is typically a container_base-derived container, but any type works.
+ */
+template<typename ContainerType>
+class rcu_container
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType    = std::size_t;
+    using PointerType = std::unique_ptr<ContainerType>;
+
+    /**
+     * \brief   Keeps a read section open and gives access to the version that was current when it
+     *          was opened. Must be destroyed on the thread that created it.
+     */
+    class read_guard
+    {
+    public:
+        explicit read_guard(const rcu_container& owner_);
+        ~read_guard();
+
+        read_guard(const read_guard&) = delete;
+        read_guard& operator=(const read_guard&) = delete;
+        read_guard(read_guard&&)                 = delete;
+        read_guard& operator=(read_guard&&) = delete;
+
+        [[nodiscard]] const ContainerType& operator*() const noexcept;
+        [[nodiscard]] const ContainerType* operator->() const noexcept;
+        [[nodiscard]] const ContainerType* get() const noexcept;
+
+    private:
+        const ContainerType* m_snapshot = nullptr;
+    };
+
+private:
+    struct retired_version
+    {
+        PointerType             version;
+        epoch_domain::EpochType epoch;
+    };
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit rcu_container(PointerType initial_ = std::make_unique<ContainerType>());
+    ~rcu_container();
+
+    rcu_container(const rcu_container&) = delete;
+    rcu_container& operator=(const rcu_container&) = delete;
+    rcu_container(rcu_container&&)                 = delete;
+    rcu_container& operator=(rcu_container&&) = delete;
+
+
+    /*********************************************************************************************/
+    /* Readers --------------------------------------------------------------------------------- */
+    [[nodiscard]] read_guard read() const;
+
+    template<typename FunctionType>
+    decltype(auto) read(FunctionType&& function_) const;
+
+
+    /*********************************************************************************************/
+    /* Writers --------------------------------------------------------------------------------- */
+    void publish(PointerType newVersion_);
+
+    template<typename FunctionType>
+    void update(FunctionType&& function_);
+
+    void synchronize();
+
+    [[nodiscard]] SizeType retired_count() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void exchange_locked(PointerType newVersion_);
+    void reclaim_locked();
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    alignas(cache_line_size) std::atomic<ContainerType*> m_current{nullptr};
+
+    /* Writer side only */
+    alignas(cache_line_size) mutable std::mutex m_writerLock;
+    std::vector<retired_version> m_retired;
+};
+
+
+}        // namespace pel
+
+#include "./rcu_container.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
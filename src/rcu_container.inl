@@ -0,0 +1,291 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./rcu_container.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* READ GUARD ---------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Open a read section and take a snapshot of the current version.
+ *
+ * \param       owner_: Container to read from.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline rcu_container<ContainerType>::read_guard::read_guard(const rcu_container& owner_)
+{
+    epoch_domain::global().enter();
+    m_snapshot = owner_.m_current.load(std::memory_order_seq_cst);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Close the read section; the snapshot may be reclaimed afterwards.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline rcu_container<ContainerType>::read_guard::~read_guard()
+{
+    epoch_domain::global().leave();
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline const ContainerType&
+rcu_container<ContainerType>::read_guard::operator*() const noexcept
+{
+    return *m_snapshot;
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline const ContainerType*
+rcu_container<ContainerType>::read_guard::operator->() const noexcept
+{
+    return m_snapshot;
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline const ContainerType*
+rcu_container<ContainerType>::read_guard::get() const noexcept
+{
+    return m_snapshot;
+}
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Take ownership of the first version of the container.
+ *
+ * \param       initial_: First version. Defaults to a default-constructed container.
+ *
+ * \throws      std::invalid_argument("Version must not be null")
+ *************************************************************************************************/
+template<typename ContainerType>
+inline rcu_container<ContainerType>::rcu_container(PointerType initial_)
+{
+    if(initial_ == nullptr)
+    {
+        throw std::invalid_argument("Version must not be null");
+    }
+    m_current.store(initial_.release(), std::memory_order_release);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the current and every retired version.
+ *              No thread may be reading the container anymore.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline rcu_container<ContainerType>::~rcu_container()
+{
+    delete m_current.load(std::memory_order_acquire);
+}
+
+
+/*************************************************************************************************/
+/* READERS ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Open a read section on the current version.
+ *              Costs one store to a thread-private cache line and one pointer load.
+ *
+ * \retval      read_guard: Access to the snapshot, valid until the guard is destroyed.
+ *************************************************************************************************/
+template<typename ContainerType>
+[[nodiscard]] inline typename rcu_container<ContainerType>::read_guard
+rcu_container<ContainerType>::read() const
+{
+    return read_guard(*this);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function on the current version, inside a read section.
+ *
+ * \param       function_: Callable taking a const ContainerType&.
+ *
+ * \retval      Whatever function_ returns. It must not keep references into the snapshot.
+ *************************************************************************************************/
+template<typename ContainerType>
+template<typename FunctionType>
+inline decltype(auto)
+rcu_container<ContainerType>::read(FunctionType&& function_) const
+{
+    const read_guard guard(*this);
+    return function_(*guard);
+}
+
+
+/*************************************************************************************************/
+/* WRITERS ------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the current version.
+ *              Readers that already hold a snapshot keep using the old version until they leave
+ *              their read section; new readers see the new version.
+ *
+ * \param       newVersion_: Fully built version to publish.
+ *
+ * \throws      std::invalid_argument("Version must not be null")
+ *************************************************************************************************/
+template<typename ContainerType>
+inline void
+rcu_container<ContainerType>::publish(PointerType newVersion_)
+{
+    if(newVersion_ == nullptr)
+    {
+        throw std::invalid_argument("Version must not be null");
+    }
+
+    const std::lock_guard lock(m_writerLock);
+    exchange_locked(std::move(newVersion_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the current version, let a function modify the copy, then publish it.
+ *              Concurrent updates are serialized, so none of them is lost.
+ *
+ * \param       function_: Callable taking a ContainerType& to the copy.
+ *************************************************************************************************/
+template<typename ContainerType>
+template<typename FunctionType>
+inline void
+rcu_container<ContainerType>::update(FunctionType&& function_)
+{
+    const std::lock_guard lock(m_writerLock);
+
+    PointerType copy = std::make_unique<ContainerType>(*m_current.load(std::memory_order_acquire));
+    function_(*copy);
+    exchange_locked(std::move(copy));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Wait until every retired version has been destroyed.
+ *
+ * \warning     Must not be called from inside a read section, which would wait on itself.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline void
+rcu_container<ContainerType>::synchronize()
+{
+    const std::lock_guard lock(m_writerLock);
+
+    reclaim_locked();
+    while(m_retired.empty() == false)
+    {
+        std::this_thread::yield();
+        reclaim_locked();
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Return the number of old versions still waiting for readers to move on.
+ *************************************************************************************************/
+template<typename ContainerType>
+[[nodiscard]] inline typename rcu_container<ContainerType>::SizeType
+rcu_container<ContainerType>::retired_count() const
+{
+    const std::lock_guard lock(m_writerLock);
+    return m_retired.size();
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Swap in a new version, retire the old one and reclaim what readers let go of.
+ *              The writer lock must be held.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline void
+rcu_container<ContainerType>::exchange_locked(PointerType newVersion_)
+{
+    /* Once unpublished, the old version must reach m_retired: a failed push_back would destroy it
+     * under the feet of its readers, so the room is made before anything is exchanged */
+    if(m_retired.size() == m_retired.capacity())
+    {
+        m_retired.reserve(std::max<SizeType>(2 * m_retired.size(), 4));
+    }
+
+    PointerType oldVersion(m_current.exchange(newVersion_.release(), std::memory_order_seq_cst));
+
+    const epoch_domain::EpochType epoch = epoch_domain::global().advance();
+    m_retired.push_back(retired_version{std::move(oldVersion), epoch});
+
+    reclaim_locked();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the retired versions no reader can still see.
+ *              A version retired in epoch E is unreachable once every active reader announced an
+ *              epoch greater than E. The writer lock must be held.
+ *************************************************************************************************/
+template<typename ContainerType>
+inline void
+rcu_container<ContainerType>::reclaim_locked()
+{
+    const epoch_domain::EpochType oldest = epoch_domain::global().oldest_active();
+
+    std::erase_if(m_retired, [oldest](const retired_version& retired_) {
+        return retired_.epoch < oldest;
+    });
+}
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,235 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+
+
+namespace pel
+{
+template<typename ItemType, typename AllocatorType, std::size_t FirstSegmentBits>
+class segmented_vector;
+
+
+/**
+ * \brief       Forward iterator over a segmented_vector.
+ *              Walks each segment as a plain pointer range and only looks up the segment table
+ *              when crossing into the next segment.
+ */
+template<typename ContainerType>
+class segmented_vector_iterator
+{
+public:
+    using SizeType       = typename ContainerType::SizeType;
+    using DifferenceType = typename ContainerType::DifferenceType;
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = typename ContainerType::ValueType;
+    using difference_type   = DifferenceType;
+    using pointer           = value_type*;
+    using reference         = value_type&;
+
+    constexpr segmented_vector_iterator() noexcept = default;
+    segmented_vector_iterator(const ContainerType* container_, SizeType index_) noexcept;
+
+    [[nodiscard]] reference operator*() const noexcept;
+    [[nodiscard]] pointer   operator->() const noexcept;
+
+    segmented_vector_iterator& operator++() noexcept;
+    segmented_vector_iterator  operator++(int) noexcept;
+
+    [[nodiscard]] SizeType index() const noexcept;
+
+    [[nodiscard]] bool operator==(const segmented_vector_iterator& rhs_) const noexcept;
+    [[nodiscard]] bool operator!=(const segmented_vector_iterator& rhs_) const noexcept;
+
+private:
+    void enter_segment() noexcept;
+
+    const ContainerType* m_container  = nullptr;
+    SizeType             m_index      = 0;
+    pointer              m_ptr        = nullptr;
+    pointer              m_segmentEnd = nullptr;
+};
+
+
+/**
+ * \brief       Append-only container whose elements never move, safe for concurrent push_back()
+ *              and reads.
+ *
+ *              Elements live in geometrically growing segments (segment k holds
+ *              2^(FirstSegmentBits + k) elements), so growing never relocates anything and
+ *              references stay valid for the container's lifetime.
+ *              push_back() reserves its index with a compare-and-swap, constructs the element,
+ *              then marks it ready; the published length() only covers a contiguous prefix of
+ *              ready elements and is advanced by whichever pusher completes that prefix, so no
+ *              thread ever waits on another one.
+ *              Nothing can fail once an index is reserved: its segment is allocated beforehand,
+ *              and elements whose constructor may throw are built before being moved in.
+ */
+template<typename ItemType,
+         typename AllocatorType       = std::allocator<ItemType>,
+         std::size_t FirstSegmentBits = 5>
+class segmented_vector
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(FirstSegmentBits < 32, "First segment is too large");
+    static_assert(std::is_nothrow_move_constructible_v<ItemType>,
+                  "Elements are moved into their reserved slot, which must not fail");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using AllocatorTraits = std::allocator_traits<AllocatorType>;
+    using SizeType        = std::size_t;
+    using DifferenceType  = std::ptrdiff_t;
+    using ValueType       = ItemType;
+    using IteratorType    = segmented_vector_iterator<segmented_vector>;
+    using SpanType        = std::span<ItemType>;
+
+    constexpr static const SizeType first_segment_size = SizeType{1} << FirstSegmentBits;
+    constexpr static const SizeType segment_count      = 64 - FirstSegmentBits;
+
+private:
+    using FlagType          = std::atomic<std::uint8_t>;
+    using FlagAllocatorType = typename AllocatorTraits::template rebind_alloc<FlagType>;
+    using FlagTraits        = std::allocator_traits<FlagAllocatorType>;
+
+    friend IteratorType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit segmented_vector(const AllocatorType& alloc_ = AllocatorType{});
+    ~segmented_vector();
+
+    segmented_vector(const segmented_vector&) = delete;
+    segmented_vector& operator=(const segmented_vector&) = delete;
+    segmented_vector(segmented_vector&&)                 = delete;
+    segmented_vector& operator=(segmented_vector&&) = delete;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&       at(SizeType index_);
+    [[nodiscard]] const ItemType& at(SizeType index_) const;
+    [[nodiscard]] IteratorType    iterator_at(SizeType index_) const noexcept;
+
+    [[nodiscard]] ItemType&       front();
+    [[nodiscard]] ItemType&       back();
+    [[nodiscard]] const ItemType& front() const;
+    [[nodiscard]] const ItemType& back() const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] ItemType&       operator[](SizeType index_);
+    [[nodiscard]] const ItemType& operator[](SizeType index_) const;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType begin() const noexcept;
+    [[nodiscard]] IteratorType end() const noexcept;
+    [[nodiscard]] IteratorType cbegin() const noexcept;
+    [[nodiscard]] IteratorType cend() const noexcept;
+
+    template<typename FunctionType>
+    void for_each_segment(FunctionType&& function_) const;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    template<typename... Args>
+    ItemType& emplace_back(Args&&... args_);
+    ItemType& push_back(const ItemType& item_);
+    ItemType& push_back(ItemType&& item_);
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_not_empty() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] constexpr static SizeType segment_of(SizeType index_) noexcept;
+    [[nodiscard]] constexpr static SizeType segment_start(SizeType segment_) noexcept;
+    [[nodiscard]] constexpr static SizeType segment_size(SizeType segment_) noexcept;
+
+    [[nodiscard]] ItemType* element_pointer(SizeType index_) const noexcept;
+    [[nodiscard]] ItemType* acquire_segment(SizeType segment_);
+    [[nodiscard]] SizeType  claim_index();
+    void                    publish(SizeType index_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    /* Number of indices handed out to pushers */
+    alignas(cache_line_size) std::atomic<SizeType> m_reserved{0};
+
+    /* Number of leading elements that are fully constructed */
+    alignas(cache_line_size) std::atomic<SizeType> m_length{0};
+
+    alignas(cache_line_size) std::array<std::atomic<ItemType*>, segment_count> m_segments{};
+    std::array<std::atomic<FlagType*>, segment_count> m_readyFlags{};
+
+    AllocatorType     m_allocator{};
+    FlagAllocatorType m_flagAllocator{};
+
+    constexpr static const bool container_safeness = true;
+};
+
+
+}        // namespace pel
+
+#include "./segmented_vector.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
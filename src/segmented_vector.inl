@@ -0,0 +1,787 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./segmented_vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SEGMENTED_VECTOR_TEMPLATE_DECLARATION__ typename ItemType,                                 \
+                                                typename AllocatorType,                            \
+                                                std::size_t FirstSegmentBits
+
+#define SEGMENTED_VECTOR_CLASS_SCOPE__          segmented_vector<ItemType,                         \
+                                                                 AllocatorType,                    \
+                                                                 FirstSegmentBits>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+template<typename ContainerType>
+inline segmented_vector_iterator<ContainerType>::segmented_vector_iterator(
+  const ContainerType* container_, SizeType index_) noexcept
+: m_container{container_}, m_index{index_}
+{
+    enter_segment();
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline typename segmented_vector_iterator<ContainerType>::reference
+segmented_vector_iterator<ContainerType>::operator*() const noexcept
+{
+    return *m_ptr;
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline typename segmented_vector_iterator<ContainerType>::pointer
+segmented_vector_iterator<ContainerType>::operator->() const noexcept
+{
+    return m_ptr;
+}
+
+template<typename ContainerType>
+inline segmented_vector_iterator<ContainerType>&
+segmented_vector_iterator<ContainerType>::operator++() noexcept
+{
+    ++m_index;
+    ++m_ptr;
+    if(m_ptr == m_segmentEnd)
+    {
+        enter_segment();
+    }
+    return *this;
+}
+
+template<typename ContainerType>
+inline segmented_vector_iterator<ContainerType>
+segmented_vector_iterator<ContainerType>::operator++(int) noexcept
+{
+    segmented_vector_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline typename segmented_vector_iterator<ContainerType>::SizeType
+segmented_vector_iterator<ContainerType>::index() const noexcept
+{
+    return m_index;
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline bool
+segmented_vector_iterator<ContainerType>::operator==(
+  const segmented_vector_iterator& rhs_) const noexcept
+{
+    return m_index == rhs_.m_index;
+}
+
+template<typename ContainerType>
+[[nodiscard]] inline bool
+segmented_vector_iterator<ContainerType>::operator!=(
+  const segmented_vector_iterator& rhs_) const noexcept
+{
+    return m_index != rhs_.m_index;
+}
+
+template<typename ContainerType>
+inline void
+segmented_vector_iterator<ContainerType>::enter_segment() noexcept
+{
+    const SizeType segment = ContainerType::segment_of(m_index);
+    pointer        base    = m_container->m_segments[segment].load(std::memory_order_acquire);
+
+    if(base == nullptr)
+    {
+        /* Past the last allocated segment: only reachable as an end iterator */
+        m_ptr        = nullptr;
+        m_segmentEnd = nullptr;
+        return;
+    }
+
+    m_ptr        = base + (m_index - ContainerType::segment_start(segment));
+    m_segmentEnd = base + ContainerType::segment_size(segment);
+}
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty container. No segment is allocated until the first push.
+ *
+ * \param       alloc_: Allocator used for the segments; rebound for the ready flags.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+SEGMENTED_VECTOR_CLASS_SCOPE__::segmented_vector(const AllocatorType& alloc_)
+: m_allocator{alloc_}, m_flagAllocator{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element and release every segment.
+ *              No other thread may use the container anymore.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+SEGMENTED_VECTOR_CLASS_SCOPE__::~segmented_vector()
+{
+    const SizeType length = m_length.load(std::memory_order_acquire);
+
+    for(SizeType segment = 0; segment < segment_count; ++segment)
+    {
+        ItemType* items = m_segments[segment].load(std::memory_order_acquire);
+        FlagType* flags = m_readyFlags[segment].load(std::memory_order_acquire);
+        const SizeType size  = segment_size(segment);
+        const SizeType start = segment_start(segment);
+
+        if(items != nullptr)
+        {
+            const SizeType constructed = length > start ? std::min(length - start, size) : 0;
+            for(SizeType i = 0; i < constructed; ++i)
+            {
+                AllocatorTraits::destroy(m_allocator, items + i);
+            }
+            AllocatorTraits::deallocate(m_allocator, items, size);
+        }
+        if(flags != nullptr)
+        {
+            FlagTraits::deallocate(m_flagAllocator, flags, size);
+        }
+    }
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain a reference to the element at a specified index in the container.
+ *
+ * \param       index_: Index of the element to get.
+ *
+ * \retval      ItemType&: Reference to the item at the specified index.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::at(SizeType index_)
+{
+    return this->operator[](index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain a constant reference to the element at a specified index in the container.
+ *
+ * \param       index_: Index of the element to get.
+ *
+ * \retval      ItemType&: Const reference to the item at the specified index.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::at(SizeType index_) const
+{
+    return this->operator[](index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the iterator to the element at the specified index.
+ *
+ * \param       index_: Index of the element to get.
+ *
+ * \retval      IteratorType: Iterator to the item at the specified index.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::IteratorType
+SEGMENTED_VECTOR_CLASS_SCOPE__::iterator_at(SizeType index_) const noexcept
+{
+    return IteratorType(this, index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the element at the front of the container.
+ *
+ * \throw       std::length_error
+ *              If the container is empty.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::front()
+{
+    if constexpr(container_safeness == true)
+    {
+        if(length() == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the last published element of the container.
+ *
+ * \throw       std::length_error
+ *              If the container is empty.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::back()
+{
+    const SizeType currentLength = length();
+    if constexpr(container_safeness == true)
+    {
+        if(currentLength == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(currentLength - 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the const element at the front of the container.
+ *
+ * \throw       std::length_error
+ *              If the container is empty.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::front() const
+{
+    if constexpr(container_safeness == true)
+    {
+        if(length() == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the last published const element of the container.
+ *
+ * \throw       std::length_error
+ *              If the container is empty.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::back() const
+{
+    const SizeType currentLength = length();
+    if constexpr(container_safeness == true)
+    {
+        if(currentLength == 0)
+        {
+            throw std::length_error("Could not access element - No memory allocated");
+        }
+    }
+    return *element_pointer(currentLength - 1);
+}
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the brackets[] operator to access an element at a specific index.
+ *
+ * \param       index_: Index of the element to access.
+ *
+ * \retval      ItemType&: Reference to the element at the index.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If the index is not within the published length of the container.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::operator[](SizeType index_)
+{
+    if constexpr(container_safeness == true)
+    {
+        if(index_ >= length())
+        {
+            throw std::length_error("Index out of range");
+        }
+    }
+
+    return *element_pointer(index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Overload of the brackets[] operator to access a const element at a specific index.
+ *
+ * \param       index_: Index of the element to access.
+ *
+ * \retval      ItemType&: Const reference to the element at the index.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If the index is not within the published length of the container.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::operator[](SizeType index_) const
+{
+    if constexpr(container_safeness == true)
+    {
+        if(index_ >= length())
+        {
+            throw std::length_error("Index out of range");
+        }
+    }
+
+    return *element_pointer(index_);
+}
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Returns an iterator to the first element of the container.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::IteratorType
+SEGMENTED_VECTOR_CLASS_SCOPE__::begin() const noexcept
+{
+    return IteratorType(this, 0);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Returns an iterator past the last element published when this is called.
+ *              Elements pushed afterwards are not part of the iterated range.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::IteratorType
+SEGMENTED_VECTOR_CLASS_SCOPE__::end() const noexcept
+{
+    return IteratorType(this, length());
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Returns a const iterator to the first element of the container.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::IteratorType
+SEGMENTED_VECTOR_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Returns a const iterator past the last element published when this is called.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::IteratorType
+SEGMENTED_VECTOR_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function on each published part of every segment, in order.
+ *              Preferred over iterators for hot loops: each call receives a contiguous span that
+ *              the compiler can vectorize over.
+ *
+ * \param       function_: Callable invoked with a SpanType per non-empty segment.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void
+SEGMENTED_VECTOR_CLASS_SCOPE__::for_each_segment(FunctionType&& function_) const
+{
+    const SizeType currentLength = length();
+
+    for(SizeType segment = 0; segment_start(segment) < currentLength; ++segment)
+    {
+        const SizeType start = segment_start(segment);
+        const SizeType count = std::min(segment_size(segment), currentLength - start);
+        function_(SpanType(m_segments[segment].load(std::memory_order_acquire), count));
+    }
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element in place at the end of the container.
+ *              Safe to call from any number of threads at once.
+ *
+ * \param       args_: Arguments forwarded to the element's constructor.
+ *
+ * \retval      ItemType&: Reference to the new element. It never moves.
+ *
+ * \note        The element becomes visible through length() once every element before it is
+ *              constructed too.
+ *              When the constructor may throw, the element is built before an index is reserved
+ *              so that a reserved index is always published.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::emplace_back(Args&&... args_)
+{
+    if constexpr(std::is_nothrow_constructible_v<ItemType, Args&&...>)
+    {
+        const SizeType index = claim_index();
+        ItemType*      item  = element_pointer(index);
+
+        AllocatorTraits::construct(m_allocator, item, std::forward<Args>(args_)...);
+        publish(index);
+        return *item;
+    }
+    else
+    {
+        ItemType item(std::forward<Args>(args_)...);
+        return emplace_back(std::move(item));
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy an element at the end of the container.
+ *              Safe to call from any number of threads at once.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+inline ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::push_back(const ItemType& item_)
+{
+    return emplace_back(item_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element at the end of the container.
+ *              Safe to call from any number of threads at once.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+inline ItemType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::push_back(ItemType&& item_)
+{
+    return emplace_back(std::move(item_));
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Return the number of elements visible to readers.
+ *
+ * \retval      SizeType: Length of the contiguous prefix of fully constructed elements.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::SizeType
+SEGMENTED_VECTOR_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length.load(std::memory_order_acquire);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns true if there are no elements in the container.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+SEGMENTED_VECTOR_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return length() == 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns true if there are elements in the container.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+SEGMENTED_VECTOR_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return !is_empty();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns a const reference to the container's allocator.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const AllocatorType&
+SEGMENTED_VECTOR_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate every segment needed to hold a number of elements, so that pushers never
+ *              hit the allocator on the hot path.
+ *
+ * \param       newCapacity_: Number of elements the container should be able to hold.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+inline void
+SEGMENTED_VECTOR_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    for(SizeType segment = 0; segment_start(segment) < newCapacity_; ++segment)
+    {
+        (void)acquire_segment(segment);
+    }
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find the segment holding an index.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::SizeType
+SEGMENTED_VECTOR_CLASS_SCOPE__::segment_of(SizeType index_) noexcept
+{
+    const SizeType shifted = index_ + first_segment_size;
+    const SizeType highestBit = 63 - static_cast<SizeType>(std::countl_zero(shifted));
+    return highestBit - FirstSegmentBits;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Index of the first element of a segment.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::SizeType
+SEGMENTED_VECTOR_CLASS_SCOPE__::segment_start(SizeType segment_) noexcept
+{
+    return segment_size(segment_) - first_segment_size;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements held by a segment.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] constexpr inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::SizeType
+SEGMENTED_VECTOR_CLASS_SCOPE__::segment_size(SizeType segment_) noexcept
+{
+    return first_segment_size << segment_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Address of the element at an index, whose segment must already exist.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType*
+SEGMENTED_VECTOR_CLASS_SCOPE__::element_pointer(SizeType index_) const noexcept
+{
+    const SizeType segment = segment_of(index_);
+    return m_segments[segment].load(std::memory_order_acquire) + (index_ - segment_start(segment));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Return the element storage of a segment, allocating it if needed.
+ *              Threads racing on a missing segment (or its ready flags) each allocate one and
+ *              install it with a compare-and-swap; the losers free theirs, so nobody waits.
+ *
+ * \param       segment_: Index of the segment.
+ *
+ * \retval      ItemType*: Start of the segment's element storage.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline ItemType*
+SEGMENTED_VECTOR_CLASS_SCOPE__::acquire_segment(SizeType segment_)
+{
+    const SizeType size  = segment_size(segment_);
+    ItemType*      items = m_segments[segment_].load(std::memory_order_acquire);
+
+    if(items == nullptr)
+    {
+        ItemType* newItems = AllocatorTraits::allocate(m_allocator, size);
+        if(m_segments[segment_].compare_exchange_strong(items, newItems, std::memory_order_acq_rel))
+        {
+            items = newItems;
+        }
+        else
+        {
+            AllocatorTraits::deallocate(m_allocator, newItems, size);
+        }
+    }
+
+    if(m_readyFlags[segment_].load(std::memory_order_seq_cst) == nullptr)
+    {
+        FlagType* newFlags = FlagTraits::allocate(m_flagAllocator, size);
+        for(SizeType i = 0; i < size; ++i)
+        {
+            FlagTraits::construct(m_flagAllocator, newFlags + i, std::uint8_t{0});
+        }
+
+        FlagType* expected = nullptr;
+        if(m_readyFlags[segment_].compare_exchange_strong(expected, newFlags) == false)
+        {
+            FlagTraits::deallocate(m_flagAllocator, newFlags, size);
+        }
+    }
+
+    return items;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Reserve the next index, allocating its segment before taking it.
+ *              If the allocation throws, nothing is reserved, so no index is ever left
+ *              unpublished.
+ *
+ * \retval      SizeType: Reserved index, whose segment exists.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SEGMENTED_VECTOR_CLASS_SCOPE__::SizeType
+SEGMENTED_VECTOR_CLASS_SCOPE__::claim_index()
+{
+    SizeType index = m_reserved.load(std::memory_order_relaxed);
+    do
+    {
+        static_cast<void>(acquire_segment(segment_of(index)));
+    } while(!m_reserved.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+    return index;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Mark an element as constructed and extend the published length over every ready
+ *              element following it.
+ *              Every pusher tries to advance the length after setting its own flag. The flag
+ *              stores and loads are sequentially consistent, so the last of two neighbouring
+ *              pushers to finish always sees the other's flag and no element is left unpublished.
+ *
+ * \param       index_: Index of the element that was just constructed.
+ *************************************************************************************************/
+template<SEGMENTED_VECTOR_TEMPLATE_DECLARATION__>
+inline void
+SEGMENTED_VECTOR_CLASS_SCOPE__::publish(SizeType index_) noexcept
+{
+    {
+        const SizeType segment = segment_of(index_);
+        FlagType*      flags   = m_readyFlags[segment].load(std::memory_order_seq_cst);
+        flags[index_ - segment_start(segment)].store(1, std::memory_order_seq_cst);
+    }
+
+    SizeType currentLength = m_length.load(std::memory_order_seq_cst);
+    for(;;)
+    {
+        const SizeType segment = segment_of(currentLength);
+        FlagType*      flags   = m_readyFlags[segment].load(std::memory_order_seq_cst);
+        if(flags == nullptr)
+        {
+            return;
+        }
+        if(flags[currentLength - segment_start(segment)].load(std::memory_order_seq_cst) == 0)
+        {
+            return;
+        }
+
+        /* On failure, currentLength is refreshed with the length published by another pusher */
+        if(m_length.compare_exchange_weak(currentLength,
+                                          currentLength + 1,
+                                          std::memory_order_seq_cst))
+        {
+            ++currentLength;
+        }
+    }
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SEGMENTED_VECTOR_TEMPLATE_DECLARATION__
+#undef SEGMENTED_VECTOR_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,160 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+#include "./slot_table.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Elements packed in one contiguous buffer, referenced by generational handles.
+ *
+ *              The elements are the container_base range, in no particular order, so iterating
+ *              over them is a plain array scan. Each element is reached from its handle through a
+ *              table of slots holding its position and a generation; erasing moves the last
+ *              element into the hole and updates its slot, so insertion and erasure are O(1) and
+ *              never invalidate the handles of other elements.
+ *              Erasing an element bumps the generation of its slot, so its handles are rejected
+ *              from then on; the slot is then reused by the next insertion.
+ *
+ * \note        Positions, pointers and iterators into the elements are invalidated by insertion
+ *              and erasure; only handles are stable.
+ */
+template<typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+class slot_map : public container_base<ItemType, iterator_base<ItemType>, AllocatorType>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType       = ItemType;
+    using HandleType      = slot_handle;
+    using IteratorType    = iterator_base<ValueType>;
+    using BaseType        = container_base<ValueType, IteratorType, AllocatorType>;
+    using AllocatorTraits = typename BaseType::AllocatorTraits;
+    using SizeType        = typename BaseType::SizeType;
+    using DifferenceType  = typename BaseType::DifferenceType;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit slot_map(const AllocatorType& alloc_ = AllocatorType{});
+    slot_map(std::initializer_list<ValueType> values_,
+             const AllocatorType&             alloc_ = AllocatorType{});
+
+    slot_map(const slot_map& copy_);
+    slot_map(slot_map&& move_) noexcept;
+    slot_map& operator=(const slot_map& copy_);
+    slot_map& operator=(slot_map&& move_) noexcept;
+
+    ~slot_map() override;
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    using BaseType::at;
+
+    [[nodiscard]] ValueType&       at(HandleType handle_);
+    [[nodiscard]] const ValueType& at(HandleType handle_) const;
+
+    [[nodiscard]] ValueType*       get(HandleType handle_) noexcept;
+    [[nodiscard]] const ValueType* get(HandleType handle_) const noexcept;
+    [[nodiscard]] bool             contains(HandleType handle_) const noexcept;
+
+    [[nodiscard]] HandleType handle_at(SizeType index_) const;
+    [[nodiscard]] HandleType handle_of(IteratorType position_) const;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    using BaseType::operator[];
+
+    [[nodiscard]] ValueType&       operator[](HandleType handle_) noexcept;
+    [[nodiscard]] const ValueType& operator[](HandleType handle_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    HandleType insert(const ValueType& value_);
+    HandleType insert(ValueType&& value_);
+    template<typename... Args>
+    HandleType emplace(Args&&... args_);
+
+    bool         erase(HandleType handle_);
+    IteratorType erase(IteratorType position_);
+
+    void clear();
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const override;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void erase_at(SizeType index_);
+    void reallocate(SizeType newCapacity_);
+    void release() noexcept;
+
+    [[nodiscard]] ValueType* data() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    SizeType m_capacity = 0;
+
+    slot_table<AllocatorType> m_slots;
+};
+
+
+}        // namespace pel
+
+#include "./slot_map.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
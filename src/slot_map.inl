@@ -0,0 +1,604 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./slot_map.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SLOT_MAP_TEMPLATE_DECLARATION__ typename ItemType, typename AllocatorType
+#define SLOT_MAP_CLASS_SCOPE__          slot_map<ItemType, AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty map. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator used for the elements and the slots.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline SLOT_MAP_CLASS_SCOPE__::slot_map(const AllocatorType& alloc_)
+: BaseType{alloc_}, m_slots{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a map from a list of values. Their handles are those of the positions
+ *              0, 1, 2... and can be read back with handle_at().
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline SLOT_MAP_CLASS_SCOPE__::slot_map(std::initializer_list<ValueType> values_,
+                                        const AllocatorType&             alloc_)
+: slot_map(alloc_)
+{
+    /* The delegated constructor completed: the destructor cleans up if this throws */
+    reserve(values_.size());
+    for(const ValueType& value : values_)
+    {
+        insert(value);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every element of another map. The handles of the other map are valid in the
+ *              copy, and refer to the copies of their elements.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline SLOT_MAP_CLASS_SCOPE__::slot_map(const slot_map& copy_)
+: BaseType{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)},
+  m_slots{copy_.m_slots}
+{
+    try
+    {
+        reserve(copy_.length());
+        for(const ValueType& value : copy_)
+        {
+            AllocatorTraits::construct(this->m_allocator, data() + this->length(), value);
+            this->add_size(1);
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the elements and slots of another map, leaving it empty.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline SLOT_MAP_CLASS_SCOPE__::slot_map(slot_map&& move_) noexcept
+: BaseType{move_.m_allocator},
+  m_capacity{std::exchange(move_.m_capacity, 0)},
+  m_slots{std::move(move_.m_slots)}
+{
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline SLOT_MAP_CLASS_SCOPE__& SLOT_MAP_CLASS_SCOPE__::operator=(const slot_map& copy_)
+{
+    if(this != &copy_)
+    {
+        slot_map copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline SLOT_MAP_CLASS_SCOPE__& SLOT_MAP_CLASS_SCOPE__::operator=(slot_map&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+
+        this->m_allocator     = move_.m_allocator;
+        m_capacity            = std::exchange(move_.m_capacity, 0);
+        m_slots               = std::move(move_.m_slots);
+        this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+        this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+    }
+    return *this;
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline SLOT_MAP_CLASS_SCOPE__::~slot_map()
+{
+    release();
+}
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element a handle refers to.
+ *
+ * \param       handle_: Handle returned when inserting the element.
+ *
+ * \retval      ValueType&: The element.
+ *
+ * \throws      std::out_of_range("Invalid handle")
+ *              If the element was erased, or the handle is not from this map.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_MAP_CLASS_SCOPE__::ValueType&
+SLOT_MAP_CLASS_SCOPE__::at(HandleType handle_)
+{
+    ValueType* value = get(handle_);
+    if(value == nullptr)
+    {
+        throw std::out_of_range("Invalid handle");
+    }
+    return *value;
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename SLOT_MAP_CLASS_SCOPE__::ValueType&
+SLOT_MAP_CLASS_SCOPE__::at(HandleType handle_) const
+{
+    const ValueType* value = get(handle_);
+    if(value == nullptr)
+    {
+        throw std::out_of_range("Invalid handle");
+    }
+    return *value;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the element a handle refers to.
+ *
+ * \retval      ValueType*: The element, or nullptr if it was erased.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_MAP_CLASS_SCOPE__::ValueType*
+SLOT_MAP_CLASS_SCOPE__::get(HandleType handle_) noexcept
+{
+    return contains(handle_) ? data() + m_slots.position(handle_) : nullptr;
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename SLOT_MAP_CLASS_SCOPE__::ValueType*
+SLOT_MAP_CLASS_SCOPE__::get(HandleType handle_) const noexcept
+{
+    return contains(handle_) ? data() + m_slots.position(handle_) : nullptr;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Check if a handle refers to an element of the map.
+ *              Generations are odd while the slot holds an element and even while it is free,
+ *              so a default handle, or one to an erased element, never matches.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool SLOT_MAP_CLASS_SCOPE__::contains(HandleType handle_) const noexcept
+{
+    return m_slots.contains(handle_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the handle of the element at a position.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If there is no element at that position.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_MAP_CLASS_SCOPE__::HandleType
+SLOT_MAP_CLASS_SCOPE__::handle_at(SizeType index_) const
+{
+    if(index_ >= this->length())
+    {
+        throw std::length_error("Index out of range");
+    }
+
+    return m_slots.handle_at(index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the handle of the element an iterator points to.
+ *
+ * \throws      std::invalid_argument("Invalid iterator")
+ *              If the iterator is not within the map, or is end().
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_MAP_CLASS_SCOPE__::HandleType
+SLOT_MAP_CLASS_SCOPE__::handle_of(IteratorType position_) const
+{
+    this->check_if_valid(position_);
+    if(position_ == this->cend())
+    {
+        throw std::invalid_argument("Invalid iterator");
+    }
+    return handle_at(static_cast<SizeType>(position_.ptr() - data()));
+}
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element a handle refers to, without checking the handle.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_MAP_CLASS_SCOPE__::ValueType&
+SLOT_MAP_CLASS_SCOPE__::operator[](HandleType handle_) noexcept
+{
+    return data()[m_slots.position(handle_)];
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename SLOT_MAP_CLASS_SCOPE__::ValueType&
+SLOT_MAP_CLASS_SCOPE__::operator[](HandleType handle_) const noexcept
+{
+    return data()[m_slots.position(handle_)];
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copy a value at the end of the elements.
+ *
+ * \retval      HandleType: Handle to the new element.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline typename SLOT_MAP_CLASS_SCOPE__::HandleType
+SLOT_MAP_CLASS_SCOPE__::insert(const ValueType& value_)
+{
+    return emplace(value_);
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline typename SLOT_MAP_CLASS_SCOPE__::HandleType
+SLOT_MAP_CLASS_SCOPE__::insert(ValueType&& value_)
+{
+    return emplace(std::move(value_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element at the end of the elements, in the first free slot.
+ *              The map is left unchanged if this throws.
+ *
+ * \param       args_: Arguments forwarded to the element's constructor. They may refer to
+ *                     elements of the map.
+ *
+ * \retval      HandleType: Handle to the new element.
+ *
+ * \throws      std::length_error("Too many elements")
+ *              If every one of the 2^32 - 1 slots is in use.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline typename SLOT_MAP_CLASS_SCOPE__::HandleType SLOT_MAP_CLASS_SCOPE__::emplace(Args&&... args_)
+{
+    const std::uint32_t slotIndex     = m_slots.acquire();
+    const SizeType      currentLength = this->length();
+
+    if(currentLength == m_capacity)
+    {
+        /* Build the element before the buffer moves, as the arguments may refer to it */
+        ValueType value(std::forward<Args>(args_)...);
+        reallocate(std::max<SizeType>(1, m_capacity * 2));
+        AllocatorTraits::construct(this->m_allocator, data() + currentLength, std::move(value));
+    }
+    else
+    {
+        AllocatorTraits::construct(
+          this->m_allocator, data() + currentLength, std::forward<Args>(args_)...);
+    }
+
+    /* Never reallocates: the owners are reserved along with the elements */
+    const HandleType handle = m_slots.occupy(slotIndex);
+    this->add_size(1);
+    return handle;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element a handle refers to, moving the last element in its place.
+ *
+ * \retval      bool: True if the element was erased, false if the handle was not valid.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline bool SLOT_MAP_CLASS_SCOPE__::erase(HandleType handle_)
+{
+    if(contains(handle_) == false)
+    {
+        return false;
+    }
+
+    erase_at(m_slots.position(handle_));
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element an iterator points to, moving the last element in its place.
+ *
+ * \param       position_: Valid, dereferenceable iterator of this map.
+ *
+ * \retval      IteratorType: Iterator to the same position, now holding the element that was
+ *                            last, or end() if the erased element was the last one.
+ *
+ * \throws      std::invalid_argument("Invalid iterator")
+ *              If the iterator is not within the map, or is end().
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline typename SLOT_MAP_CLASS_SCOPE__::IteratorType
+SLOT_MAP_CLASS_SCOPE__::erase(IteratorType position_)
+{
+    this->check_if_valid(position_);
+    if(position_ == this->cend())
+    {
+        throw std::invalid_argument("Invalid iterator");
+    }
+
+    const SizeType index = static_cast<SizeType>(position_.ptr() - data());
+    erase_at(index);
+    return IteratorType(data() + index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase every element, invalidating all the handles. The buffer stays allocated.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline void SLOT_MAP_CLASS_SCOPE__::clear()
+{
+    m_slots.clear();
+
+    BaseType::clear();
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of elements the buffer can hold.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_MAP_CLASS_SCOPE__::SizeType
+SLOT_MAP_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline void SLOT_MAP_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > m_capacity)
+    {
+        reallocate(newCapacity_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Shrink the buffer to the number of elements.
+ *              The slots are kept, as handles to erased elements must still be rejected.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline void SLOT_MAP_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(this->is_empty())
+    {
+        release();
+    }
+    else if(this->length() < m_capacity)
+    {
+        reallocate(this->length());
+    }
+    m_slots.shrink_to_fit();
+}
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the elements as a string, such as "[1, 2, 3]", in storage order.
+ *              Elements that cannot be written to a std::ostream are shown as "?".
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::string SLOT_MAP_CLASS_SCOPE__::to_string() const
+{
+    std::ostringstream stream;
+    stream << '[';
+    for(SizeType i = 0; i < this->length(); ++i)
+    {
+        if(i != 0)
+        {
+            stream << ", ";
+        }
+
+        if constexpr(requires(std::ostream& os_) { os_ << data()[i]; })
+        {
+            stream << data()[i];
+        }
+        else
+        {
+            stream << '?';
+        }
+    }
+    stream << ']';
+    return stream.str();
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element at a position by moving the last element over it, and free its
+ *              slot.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline void SLOT_MAP_CLASS_SCOPE__::erase_at(SizeType index_)
+{
+    ValueType*          items     = data();
+    const SizeType      last      = this->length() - 1;
+    const std::uint32_t slotIndex = m_slots.owner(index_);
+
+    if(index_ != last)
+    {
+        items[index_] = std::move(items[last]);
+        m_slots.move(index_, last);
+    }
+    AllocatorTraits::destroy(this->m_allocator, items + last);
+    this->change_size(last);
+    m_slots.release(slotIndex);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements to a new buffer.
+ *
+ * \param       newCapacity_: Capacity of the new buffer. Must hold at least length() elements.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline void SLOT_MAP_CLASS_SCOPE__::reallocate(SizeType newCapacity_)
+{
+    m_slots.reserve(newCapacity_);
+
+    const SizeType currentLength = this->length();
+    ValueType*     oldItems      = data();
+    ValueType*     newItems      = AllocatorTraits::allocate(this->m_allocator, newCapacity_);
+
+    for(SizeType i = 0; i < currentLength; ++i)
+    {
+        AllocatorTraits::construct(this->m_allocator, newItems + i, std::move(oldItems[i]));
+        AllocatorTraits::destroy(this->m_allocator, oldItems + i);
+    }
+    if(oldItems != nullptr)
+    {
+        AllocatorTraits::deallocate(this->m_allocator, oldItems, m_capacity);
+    }
+
+    m_capacity            = newCapacity_;
+    this->m_beginIterator = IteratorType(newItems);
+    this->m_endIterator   = IteratorType(newItems + currentLength);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element and free the buffer. The slots are left as they are.
+ *************************************************************************************************/
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+inline void SLOT_MAP_CLASS_SCOPE__::release() noexcept
+{
+    ValueType* items = data();
+    if(items != nullptr)
+    {
+        for(SizeType i = 0; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items + i);
+        }
+        AllocatorTraits::deallocate(this->m_allocator, items, m_capacity);
+    }
+
+    m_capacity            = 0;
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+}
+
+
+template<SLOT_MAP_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_MAP_CLASS_SCOPE__::ValueType*
+SLOT_MAP_CLASS_SCOPE__::data() const noexcept
+{
+    return BaseType::begin().ptr();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SLOT_MAP_TEMPLATE_DECLARATION__
+#undef SLOT_MAP_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
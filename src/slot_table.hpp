@@ -0,0 +1,142 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Stable reference to an element of a slot_map or of a dary_heap.
+ *
+ *              Stays valid until that element is erased, whatever else is inserted or erased.
+ *              The generation tells a handle to an erased element from one to the element that
+ *              reused its slot. A default handle is never valid.
+ */
+struct slot_handle
+{
+    std::uint32_t index      = 0;
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] constexpr bool operator==(const slot_handle& rhs_) const noexcept = default;
+};
+
+
+/**
+ * \brief       Handle half of slot_map and dary_heap: the position of every handled element.
+ *
+ *              Each slot holds the position of its element and a generation, odd while the slot
+ *              is in use; free slots are chained through their position. The owners are the
+ *              reverse mapping, the slot of the element at each position, so that the slot of an
+ *              element can be updated when the container moves it.
+ *              The container keeps the positions in sync by calling occupy() for each element it
+ *              appends, place() or move() when an element moves, and release() when it drops its
+ *              last position.
+ */
+template<typename AllocatorType>
+class slot_table
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType   = std::size_t;
+    using HandleType = slot_handle;
+
+    constexpr static const std::uint32_t no_slot = ~std::uint32_t{0};
+
+private:
+    /* Position of the element, or next free slot, and generation of the slot */
+    struct slot
+    {
+        std::uint32_t index;
+        std::uint32_t generation;
+    };
+
+    using AllocatorTraits    = std::allocator_traits<AllocatorType>;
+    using SlotAllocatorType  = typename AllocatorTraits::template rebind_alloc<slot>;
+    using OwnerAllocatorType = typename AllocatorTraits::template rebind_alloc<std::uint32_t>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit slot_table(const AllocatorType& alloc_);
+
+    slot_table(const slot_table& copy_) = default;
+    slot_table(slot_table&& move_) noexcept;
+    slot_table& operator=(const slot_table& copy_) = default;
+    slot_table& operator=(slot_table&& move_) noexcept;
+
+    ~slot_table() = default;
+
+
+    /*********************************************************************************************/
+    /* Lookup ---------------------------------------------------------------------------------- */
+    [[nodiscard]] bool          contains(HandleType handle_) const noexcept;
+    [[nodiscard]] SizeType      position(HandleType handle_) const noexcept;
+    [[nodiscard]] HandleType    handle_at(SizeType position_) const noexcept;
+    [[nodiscard]] std::uint32_t owner(SizeType position_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    [[nodiscard]] std::uint32_t acquire();
+    HandleType                  occupy(std::uint32_t slot_) noexcept;
+    void                        place(SizeType position_, std::uint32_t slot_) noexcept;
+    void                        move(SizeType to_, SizeType from_) noexcept;
+    void                        release(std::uint32_t slot_) noexcept;
+    void                        clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    void reserve(SizeType capacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::vector<slot, SlotAllocatorType>           m_slots;
+    std::vector<std::uint32_t, OwnerAllocatorType> m_owners;
+    std::uint32_t                                  m_freeSlot = no_slot;
+};
+
+
+}        // namespace pel
+
+#include "./slot_table.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
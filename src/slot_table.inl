@@ -0,0 +1,265 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./slot_table.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SLOT_TABLE_TEMPLATE_DECLARATION__ typename AllocatorType
+#define SLOT_TABLE_CLASS_SCOPE__          slot_table<AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline SLOT_TABLE_CLASS_SCOPE__::slot_table(const AllocatorType& alloc_)
+: m_slots{SlotAllocatorType{alloc_}}, m_owners{OwnerAllocatorType{alloc_}}
+{
+}
+
+
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline SLOT_TABLE_CLASS_SCOPE__::slot_table(slot_table&& move_) noexcept
+: m_slots{std::move(move_.m_slots)},
+  m_owners{std::move(move_.m_owners)},
+  m_freeSlot{std::exchange(move_.m_freeSlot, no_slot)}
+{
+    move_.m_slots.clear();
+    move_.m_owners.clear();
+}
+
+
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline SLOT_TABLE_CLASS_SCOPE__& SLOT_TABLE_CLASS_SCOPE__::operator=(slot_table&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        m_slots    = std::move(move_.m_slots);
+        m_owners   = std::move(move_.m_owners);
+        m_freeSlot = std::exchange(move_.m_freeSlot, no_slot);
+        move_.m_slots.clear();
+        move_.m_owners.clear();
+    }
+    return *this;
+}
+
+
+
+/*************************************************************************************************/
+/* LOOKUP -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Check if a handle refers to an element: its slot exists, is in use, and has not
+ *              been reused since.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool SLOT_TABLE_CLASS_SCOPE__::contains(HandleType handle_) const noexcept
+{
+    return handle_.index < m_slots.size() && (handle_.generation & 1) != 0
+           && m_slots[handle_.index].generation == handle_.generation;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Position of the element a handle refers to. The handle must be valid.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_TABLE_CLASS_SCOPE__::SizeType
+SLOT_TABLE_CLASS_SCOPE__::position(HandleType handle_) const noexcept
+{
+    return m_slots[handle_.index].index;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Handle to the element at a position. The position must hold an element.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SLOT_TABLE_CLASS_SCOPE__::HandleType
+SLOT_TABLE_CLASS_SCOPE__::handle_at(SizeType position_) const noexcept
+{
+    const std::uint32_t slotIndex = m_owners[position_];
+    return HandleType{slotIndex, m_slots[slotIndex].generation};
+}
+
+
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::uint32_t
+SLOT_TABLE_CLASS_SCOPE__::owner(SizeType position_) const noexcept
+{
+    return m_owners[position_];
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Make sure there is a free slot, adding one if needed.
+ *
+ * \retval      std::uint32_t: The first free slot. It stays on the free list until occupied, so
+ *                             nothing needs to be undone if building the element throws.
+ *
+ * \throws      std::length_error("Too many elements")
+ *              If every one of the 2^32 - 1 slots is in use.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline std::uint32_t SLOT_TABLE_CLASS_SCOPE__::acquire()
+{
+    if(m_freeSlot == no_slot)
+    {
+        if(m_slots.size() >= no_slot)
+        {
+            throw std::length_error("Too many elements");
+        }
+        m_slots.push_back(slot{no_slot, 0});
+        m_freeSlot = static_cast<std::uint32_t>(m_slots.size() - 1);
+    }
+    return m_freeSlot;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Give the slot returned by acquire() to an element appended after the others.
+ *              The owners must have room for it: reserve() them along with the elements.
+ *
+ * \retval      HandleType: Handle to the new element.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline typename SLOT_TABLE_CLASS_SCOPE__::HandleType
+SLOT_TABLE_CLASS_SCOPE__::occupy(std::uint32_t slot_) noexcept
+{
+    slot& newSlot = m_slots[slot_];
+    m_freeSlot    = newSlot.index;
+    newSlot.index = static_cast<std::uint32_t>(m_owners.size());
+    ++newSlot.generation;
+
+    m_owners.push_back(slot_);
+    return HandleType{slot_, newSlot.generation};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Record that the element of a slot is now at a position.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline void SLOT_TABLE_CLASS_SCOPE__::place(SizeType position_, std::uint32_t slot_) noexcept
+{
+    m_owners[position_]  = slot_;
+    m_slots[slot_].index = static_cast<std::uint32_t>(position_);
+}
+
+
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline void SLOT_TABLE_CLASS_SCOPE__::move(SizeType to_, SizeType from_) noexcept
+{
+    place(to_, m_owners[from_]);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free the slot of an erased element and drop the last position, which the
+ *              container emptied by moving its element over the erased one, or by erasing it.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline void SLOT_TABLE_CLASS_SCOPE__::release(std::uint32_t slot_) noexcept
+{
+    m_owners.pop_back();
+
+    ++m_slots[slot_].generation;
+    m_slots[slot_].index = m_freeSlot;
+    m_freeSlot           = slot_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free the slot of every element. The slots are kept, so that the handles to the
+ *              elements are rejected from then on.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline void SLOT_TABLE_CLASS_SCOPE__::clear() noexcept
+{
+    for(const std::uint32_t slotIndex : m_owners)
+    {
+        ++m_slots[slotIndex].generation;
+        m_slots[slotIndex].index = m_freeSlot;
+        m_freeSlot               = slotIndex;
+    }
+    m_owners.clear();
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline void SLOT_TABLE_CLASS_SCOPE__::reserve(SizeType capacity_)
+{
+    m_owners.reserve(capacity_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Shrink the owners to the number of elements.
+ *              The slots are kept, as handles to erased elements must still be rejected.
+ *************************************************************************************************/
+template<SLOT_TABLE_TEMPLATE_DECLARATION__>
+inline void SLOT_TABLE_CLASS_SCOPE__::shrink_to_fit()
+{
+    m_owners.shrink_to_fit();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SLOT_TABLE_TEMPLATE_DECLARATION__
+#undef SLOT_TABLE_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,417 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Lists the fields of a struct stored in a soa_container, one column each.
+ *
+ *              Specialize it for every struct stored that way, with a tuple of member pointers:
+ *
+ *                  template<>
+ *                  struct pel::soa_fields<particle>
+ *                  {
+ *                      static constexpr auto members = std::tuple{&particle::x, &particle::y};
+ *                  };
+ *
+ *              Fields left out of the tuple are not stored, and come back value-initialized.
+ */
+template<typename StructType>
+struct soa_fields;
+
+
+template<typename StructType, typename AllocatorType>
+class soa_container;
+
+
+/**
+ * \brief       Proxy standing for one record of a soa_container.
+ *
+ *              Converts to a StructType gathered from the columns, and assigning a StructType to
+ *              it scatters the fields back. get<Field>() reaches a single field without touching
+ *              the others, Field being a member pointer or a column index.
+ */
+template<typename ContainerType, bool IsConst>
+class soa_reference
+{
+public:
+    using ValueType = typename ContainerType::ValueType;
+    using SizeType  = typename ContainerType::SizeType;
+
+    soa_reference(std::conditional_t<IsConst, const ContainerType*, ContainerType*> container_,
+                  SizeType index_) noexcept;
+    soa_reference(const soa_reference& copy_) noexcept = default;
+
+    template<bool OtherIsConst>
+        requires(IsConst && OtherIsConst == false)
+    soa_reference(const soa_reference<ContainerType, OtherIsConst>& other_) noexcept;
+
+    /* Assignments write through to the record, even on a const proxy */
+    const soa_reference& operator=(const soa_reference& rhs_) const
+        requires(IsConst == false);
+    const soa_reference& operator=(const ValueType& value_) const
+        requires(IsConst == false);
+    const soa_reference& operator=(ValueType&& value_) const
+        requires(IsConst == false);
+
+    [[nodiscard]] operator ValueType() const;
+
+    template<auto Field>
+    [[nodiscard]] decltype(auto) get() const noexcept;
+
+    [[nodiscard]] SizeType index() const noexcept;
+
+    friend void swap(const soa_reference& lhs_, const soa_reference& rhs_)
+        requires(IsConst == false)
+    {
+        lhs_.m_container->swap_records(lhs_.m_index, rhs_.m_index);
+    }
+
+private:
+    template<typename, bool>
+    friend class soa_reference;
+
+    std::conditional_t<IsConst, const ContainerType*, ContainerType*> m_container;
+    SizeType                                                          m_index;
+};
+
+
+/**
+ * \brief       Random-access iterator over the records of a soa_container.
+ *              Dereferencing yields a soa_reference proxy, not a StructType&.
+ */
+template<typename ContainerType, bool IsConst>
+class soa_iterator
+{
+public:
+    using SizeType       = typename ContainerType::SizeType;
+    using DifferenceType = typename ContainerType::DifferenceType;
+    using PointerType = std::conditional_t<IsConst, const ContainerType*, ContainerType*>;
+
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+    using value_type        = typename ContainerType::ValueType;
+    using difference_type   = DifferenceType;
+    using pointer           = void;
+    using reference         = soa_reference<ContainerType, IsConst>;
+
+    constexpr soa_iterator() noexcept = default;
+    soa_iterator(PointerType container_, SizeType index_) noexcept;
+
+    template<bool OtherIsConst>
+        requires(IsConst && OtherIsConst == false)
+    soa_iterator(const soa_iterator<ContainerType, OtherIsConst>& other_) noexcept;
+
+    [[nodiscard]] reference operator*() const noexcept;
+    [[nodiscard]] reference operator[](DifferenceType offset_) const noexcept;
+
+    soa_iterator& operator++() noexcept;
+    soa_iterator  operator++(int) noexcept;
+    soa_iterator& operator--() noexcept;
+    soa_iterator  operator--(int) noexcept;
+    soa_iterator& operator+=(DifferenceType offset_) noexcept;
+    soa_iterator& operator-=(DifferenceType offset_) noexcept;
+
+    [[nodiscard]] soa_iterator   operator+(DifferenceType offset_) const noexcept;
+    [[nodiscard]] soa_iterator   operator-(DifferenceType offset_) const noexcept;
+    [[nodiscard]] DifferenceType operator-(const soa_iterator& rhs_) const noexcept;
+
+    [[nodiscard]] friend soa_iterator operator+(DifferenceType      offset_,
+                                                const soa_iterator& it_) noexcept
+    {
+        return it_ + offset_;
+    }
+
+    [[nodiscard]] bool                 operator==(const soa_iterator& rhs_) const noexcept;
+    [[nodiscard]] std::strong_ordering operator<=>(const soa_iterator& rhs_) const noexcept;
+
+    [[nodiscard]] SizeType index() const noexcept;
+
+private:
+    template<typename, bool>
+    friend class soa_iterator;
+
+    PointerType m_container = nullptr;
+    SizeType    m_index     = 0;
+};
+
+
+/**
+ * \brief       Sequence of structs stored field by field (structure of arrays).
+ *
+ *              Each field listed in soa_fields<StructType> gets its own contiguous column, so a
+ *              loop touching one or two fields only streams those fields through the cache
+ *              instead of whole records. All the columns share a single allocation, each one
+ *              starting on a cache line boundary (column_alignment) so that column<Field>() spans
+ *              can be handed to vectorized kernels directly.
+ *
+ *              Records are read and written through soa_reference proxies: generic code sees a
+ *              random-access range of StructType, and the proxies gather or scatter the fields.
+ *              push_back() and emplace_back() scatter a record, or take one value per field.
+ *
+ *              Offers the familiar container_base surface (length, is_empty, at, front, back,
+ *              comparisons), but is not derived from it as no StructType object is ever stored.
+ *
+ * \note        StructType must be default constructible: gathered records start out
+ *              value-initialized before their fields are filled in.
+ */
+template<typename StructType, typename AllocatorType = std::allocator<StructType>>
+class soa_container
+{
+    static_assert(std::is_same_v<StructType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(std::default_initializable<StructType>, "Records must be default constructible");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType              = StructType;
+    using AllocatorTraits        = std::allocator_traits<AllocatorType>;
+    using SizeType               = std::size_t;
+    using DifferenceType         = std::ptrdiff_t;
+    using ReferenceType          = soa_reference<soa_container, false>;
+    using ConstReferenceType     = soa_reference<soa_container, true>;
+    using IteratorType           = soa_iterator<soa_container, false>;
+    using ConstIteratorType      = soa_iterator<soa_container, true>;
+
+    constexpr static const auto        members          = soa_fields<StructType>::members;
+    constexpr static const SizeType    field_count      = std::tuple_size_v<decltype(members)>;
+    constexpr static const std::size_t column_alignment = cache_line_size;
+
+    static_assert(field_count > 0, "soa_fields must list at least one member");
+
+private:
+    template<auto Field, typename MemberType>
+    [[nodiscard]] constexpr static bool is_same_member(MemberType member_) noexcept;
+
+public:
+    /* Index of a column from its index or from a member pointer */
+    template<auto Field>
+    constexpr static const SizeType field_index = [] {
+        if constexpr(std::is_integral_v<decltype(Field)>)
+        {
+            return static_cast<SizeType>(Field);
+        }
+        else
+        {
+            return []<SizeType... Is>(std::index_sequence<Is...>)
+            {
+                SizeType index = field_count;
+                ((index = (index == field_count && is_same_member<Field>(std::get<Is>(members)))
+                            ? Is
+                            : index),
+                 ...);
+                return index;
+            }(std::make_index_sequence<field_count>{});
+        }
+    }();
+
+    template<SizeType Index>
+    using FieldType = std::remove_cvref_t<
+      decltype(std::declval<StructType&>().*std::get<Index>(members))>;
+
+    template<auto Field>
+    using SpanType = std::span<FieldType<field_index<Field>>>;
+    template<auto Field>
+    using ConstSpanType = std::span<const FieldType<field_index<Field>>>;
+
+private:
+    friend ReferenceType;
+    friend ConstReferenceType;
+
+    /* Unit of allocation, so that the block starts on a cache line */
+    struct alignas(column_alignment) block_type
+    {
+        std::byte bytes[column_alignment];
+    };
+
+    using BlockAllocatorType = typename AllocatorTraits::template rebind_alloc<block_type>;
+    using BlockTraits        = std::allocator_traits<BlockAllocatorType>;
+
+    template<SizeType... Is>
+    static std::tuple<FieldType<Is>*...> make_columns(std::index_sequence<Is...>);
+    using ColumnsType = decltype(make_columns(std::make_index_sequence<field_count>{}));
+
+    template<SizeType Index>
+    using FieldAllocatorType = typename AllocatorTraits::template rebind_alloc<FieldType<Index>>;
+    template<SizeType Index>
+    using FieldTraits = std::allocator_traits<FieldAllocatorType<Index>>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit soa_container(const AllocatorType& alloc_ = AllocatorType{});
+    explicit soa_container(SizeType length_, const AllocatorType& alloc_ = AllocatorType{});
+    soa_container(std::initializer_list<ValueType> values_,
+                  const AllocatorType&             alloc_ = AllocatorType{});
+    template<typename InputIterator>
+    soa_container(InputIterator        first_,
+                  InputIterator        last_,
+                  const AllocatorType& alloc_ = AllocatorType{});
+
+    soa_container(const soa_container& copy_);
+    soa_container(soa_container&& move_) noexcept;
+    soa_container& operator=(const soa_container& copy_);
+    soa_container& operator=(soa_container&& move_) noexcept;
+
+    ~soa_container();
+
+
+    /*********************************************************************************************/
+    /* Element accessors ----------------------------------------------------------------------- */
+    [[nodiscard]] ReferenceType      at(SizeType index_);
+    [[nodiscard]] ConstReferenceType at(SizeType index_) const;
+
+    [[nodiscard]] ReferenceType      front();
+    [[nodiscard]] ReferenceType      back();
+    [[nodiscard]] ConstReferenceType front() const;
+    [[nodiscard]] ConstReferenceType back() const;
+
+    [[nodiscard]] ValueType get(SizeType index_) const;
+    void                    set(SizeType index_, const ValueType& value_);
+    void                    set(SizeType index_, ValueType&& value_);
+
+    template<auto Field>
+    [[nodiscard]] SpanType<Field> column() noexcept;
+    template<auto Field>
+    [[nodiscard]] ConstSpanType<Field> column() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Operator overloads ---------------------------------------------------------------------- */
+    [[nodiscard]] ReferenceType      operator[](SizeType index_) noexcept;
+    [[nodiscard]] ConstReferenceType operator[](SizeType index_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Iterators ------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType      begin() noexcept;
+    [[nodiscard]] IteratorType      end() noexcept;
+    [[nodiscard]] ConstIteratorType begin() const noexcept;
+    [[nodiscard]] ConstIteratorType end() const noexcept;
+    [[nodiscard]] ConstIteratorType cbegin() const noexcept;
+    [[nodiscard]] ConstIteratorType cend() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    void push_back(const ValueType& value_);
+    void push_back(ValueType&& value_);
+    template<typename... Args>
+    void emplace_back(Args&&... fields_);
+    void pop_back();
+
+    IteratorType erase(ConstIteratorType position_);
+    void         swap_records(SizeType lhs_, SizeType rhs_);
+    void         resize(SizeType newLength_);
+    void         clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_not_empty() const noexcept;
+    [[nodiscard]] SizeType             capacity() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    template<typename FunctionType>
+    static void for_each_field(FunctionType&& function_);
+
+    [[nodiscard]] static SizeType block_count(SizeType capacity_) noexcept;
+    [[nodiscard]] static ColumnsType carve_columns(block_type* block_, SizeType capacity_) noexcept;
+
+    template<SizeType Index>
+    [[nodiscard]] FieldType<Index>* column_data() const noexcept;
+
+    template<typename... Args>
+    void construct_back(Args&&... fields_);
+    void destroy_tail(SizeType newLength_) noexcept;
+    void reallocate(SizeType newCapacity_);
+    void release() noexcept;
+    void grow_for(SizeType extra_);
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    block_type* m_block    = nullptr;
+    SizeType    m_length   = 0;
+    SizeType    m_capacity = 0;
+    ColumnsType m_columns{};
+
+    [[no_unique_address]] AllocatorType m_allocator{};
+};
+
+
+template<typename StructType, typename AllocatorType>
+[[nodiscard]] bool operator==(const soa_container<StructType, AllocatorType>& lhs_,
+                              const soa_container<StructType, AllocatorType>& rhs_);
+template<typename StructType, typename AllocatorType>
+[[nodiscard]] bool operator!=(const soa_container<StructType, AllocatorType>& lhs_,
+                              const soa_container<StructType, AllocatorType>& rhs_);
+
+
+}        // namespace pel
+
+#include "./soa_container.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,1162 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./soa_container.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SOA_CONTAINER_TEMPLATE_DECLARATION__ typename StructType, typename AllocatorType
+#define SOA_CONTAINER_CLASS_SCOPE__          soa_container<StructType, AllocatorType>
+
+#define SOA_REFERENCE_CLASS_SCOPE__          soa_reference<ContainerType, IsConst>
+#define SOA_ITERATOR_CLASS_SCOPE__           soa_iterator<ContainerType, IsConst>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* REFERENCE ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline SOA_REFERENCE_CLASS_SCOPE__::soa_reference(
+  std::conditional_t<IsConst, const ContainerType*, ContainerType*> container_,
+  SizeType                                                          index_) noexcept
+: m_container{container_}, m_index{index_}
+{
+}
+
+template<typename ContainerType, bool IsConst>
+template<bool OtherIsConst>
+    requires(IsConst && OtherIsConst == false)
+inline SOA_REFERENCE_CLASS_SCOPE__::soa_reference(
+  const soa_reference<ContainerType, OtherIsConst>& other_) noexcept
+: m_container{other_.m_container}, m_index{other_.m_index}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the record another proxy stands for into this one.
+ *              Like assigning through a StructType&, the proxy itself is not rebound.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline const SOA_REFERENCE_CLASS_SCOPE__&
+SOA_REFERENCE_CLASS_SCOPE__::operator=(const soa_reference& rhs_) const
+    requires(IsConst == false)
+{
+    if(m_container != rhs_.m_container || m_index != rhs_.m_index)
+    {
+        m_container->set(m_index, rhs_.m_container->get(rhs_.m_index));
+    }
+    return *this;
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Scatter the fields of a record into the columns.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline const SOA_REFERENCE_CLASS_SCOPE__&
+SOA_REFERENCE_CLASS_SCOPE__::operator=(const ValueType& value_) const
+    requires(IsConst == false)
+{
+    m_container->set(m_index, value_);
+    return *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline const SOA_REFERENCE_CLASS_SCOPE__&
+SOA_REFERENCE_CLASS_SCOPE__::operator=(ValueType&& value_) const
+    requires(IsConst == false)
+{
+    m_container->set(m_index, std::move(value_));
+    return *this;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Gather the fields of the record into a StructType.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline SOA_REFERENCE_CLASS_SCOPE__::operator ValueType() const
+{
+    return m_container->get(m_index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access a single field of the record.
+ *
+ * \tparam      Field: Member pointer listed in soa_fields, or index of the column.
+ * \retval      decltype(auto): Reference to the field, const if the proxy is.
+ *************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+template<auto Field>
+inline decltype(auto) SOA_REFERENCE_CLASS_SCOPE__::get() const noexcept
+{
+    return m_container->template column<Field>()[m_index];
+}
+
+template<typename ContainerType, bool IsConst>
+inline typename SOA_REFERENCE_CLASS_SCOPE__::SizeType
+SOA_REFERENCE_CLASS_SCOPE__::index() const noexcept
+{
+    return m_index;
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATOR ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__::soa_iterator(PointerType container_, SizeType index_) noexcept
+: m_container{container_}, m_index{index_}
+{
+}
+
+template<typename ContainerType, bool IsConst>
+template<bool OtherIsConst>
+    requires(IsConst && OtherIsConst == false)
+inline SOA_ITERATOR_CLASS_SCOPE__::soa_iterator(
+  const soa_iterator<ContainerType, OtherIsConst>& other_) noexcept
+: m_container{other_.m_container}, m_index{other_.m_index}
+{
+}
+
+template<typename ContainerType, bool IsConst>
+inline typename SOA_ITERATOR_CLASS_SCOPE__::reference
+SOA_ITERATOR_CLASS_SCOPE__::operator*() const noexcept
+{
+    return reference(m_container, m_index);
+}
+
+template<typename ContainerType, bool IsConst>
+inline typename SOA_ITERATOR_CLASS_SCOPE__::reference
+SOA_ITERATOR_CLASS_SCOPE__::operator[](DifferenceType offset_) const noexcept
+{
+    return *(*this + offset_);
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__& SOA_ITERATOR_CLASS_SCOPE__::operator++() noexcept
+{
+    ++m_index;
+    return *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__ SOA_ITERATOR_CLASS_SCOPE__::operator++(int) noexcept
+{
+    soa_iterator previous = *this;
+    ++m_index;
+    return previous;
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__& SOA_ITERATOR_CLASS_SCOPE__::operator--() noexcept
+{
+    --m_index;
+    return *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__ SOA_ITERATOR_CLASS_SCOPE__::operator--(int) noexcept
+{
+    soa_iterator previous = *this;
+    --m_index;
+    return previous;
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__&
+SOA_ITERATOR_CLASS_SCOPE__::operator+=(DifferenceType offset_) noexcept
+{
+    m_index = static_cast<SizeType>(static_cast<DifferenceType>(m_index) + offset_);
+    return *this;
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__&
+SOA_ITERATOR_CLASS_SCOPE__::operator-=(DifferenceType offset_) noexcept
+{
+    return *this += -offset_;
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__
+SOA_ITERATOR_CLASS_SCOPE__::operator+(DifferenceType offset_) const noexcept
+{
+    soa_iterator it = *this;
+    return it += offset_;
+}
+
+template<typename ContainerType, bool IsConst>
+inline SOA_ITERATOR_CLASS_SCOPE__
+SOA_ITERATOR_CLASS_SCOPE__::operator-(DifferenceType offset_) const noexcept
+{
+    soa_iterator it = *this;
+    return it -= offset_;
+}
+
+template<typename ContainerType, bool IsConst>
+inline typename SOA_ITERATOR_CLASS_SCOPE__::DifferenceType
+SOA_ITERATOR_CLASS_SCOPE__::operator-(const soa_iterator& rhs_) const noexcept
+{
+    return static_cast<DifferenceType>(m_index) - static_cast<DifferenceType>(rhs_.m_index);
+}
+
+template<typename ContainerType, bool IsConst>
+inline bool SOA_ITERATOR_CLASS_SCOPE__::operator==(const soa_iterator& rhs_) const noexcept
+{
+    return m_index == rhs_.m_index;
+}
+
+template<typename ContainerType, bool IsConst>
+inline std::strong_ordering
+SOA_ITERATOR_CLASS_SCOPE__::operator<=>(const soa_iterator& rhs_) const noexcept
+{
+    return m_index <=> rhs_.m_index;
+}
+
+template<typename ContainerType, bool IsConst>
+inline typename SOA_ITERATOR_CLASS_SCOPE__::SizeType
+SOA_ITERATOR_CLASS_SCOPE__::index() const noexcept
+{
+    return m_index;
+}
+
+
+
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty container. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator, rebound to allocate the columns.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__::soa_container(const AllocatorType& alloc_)
+: m_allocator{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a container of value-initialized records.
+ *
+ * \param       length_: Number of records.
+ * \param       alloc_:  Allocator, rebound to allocate the columns.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__::soa_container(SizeType length_, const AllocatorType& alloc_)
+: soa_container(alloc_)
+{
+    /* The delegated constructor completed: the destructor cleans up if this throws */
+    resize(length_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a container from a list of records, scattered into the columns.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__::soa_container(std::initializer_list<ValueType> values_,
+                                                  const AllocatorType&             alloc_)
+: soa_container(values_.begin(), values_.end(), alloc_)
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a container from a range of records, scattered into the columns.
+ *
+ * \param       first_: Iterator to the first record.
+ * \param       last_:  Iterator past the last record.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename InputIterator>
+inline SOA_CONTAINER_CLASS_SCOPE__::soa_container(InputIterator        first_,
+                                                  InputIterator        last_,
+                                                  const AllocatorType& alloc_)
+: soa_container(alloc_)
+{
+    if constexpr(std::forward_iterator<InputIterator>)
+    {
+        reserve(static_cast<SizeType>(std::distance(first_, last_)));
+    }
+    for(; first_ != last_; ++first_)
+    {
+        push_back(*first_);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy every column of another container.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__::soa_container(const soa_container& copy_)
+: soa_container(AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator))
+{
+    reserve(copy_.m_length);
+    for(SizeType i = 0; i < copy_.m_length; ++i)
+    {
+        std::apply([&](auto... columns_) { construct_back(columns_[i]...); }, copy_.m_columns);
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Take over the columns of another container, leaving it empty.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__::soa_container(soa_container&& move_) noexcept
+: m_block{std::exchange(move_.m_block, nullptr)},
+  m_length{std::exchange(move_.m_length, 0)},
+  m_capacity{std::exchange(move_.m_capacity, 0)},
+  m_columns{std::exchange(move_.m_columns, ColumnsType{})},
+  m_allocator{move_.m_allocator}
+{
+}
+
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__&
+SOA_CONTAINER_CLASS_SCOPE__::operator=(const soa_container& copy_)
+{
+    if(this != &copy_)
+    {
+        soa_container copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__&
+SOA_CONTAINER_CLASS_SCOPE__::operator=(soa_container&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+        m_block     = std::exchange(move_.m_block, nullptr);
+        m_length    = std::exchange(move_.m_length, 0);
+        m_capacity  = std::exchange(move_.m_capacity, 0);
+        m_columns   = std::exchange(move_.m_columns, ColumnsType{});
+        m_allocator = move_.m_allocator;
+    }
+    return *this;
+}
+
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline SOA_CONTAINER_CLASS_SCOPE__::~soa_container()
+{
+    release();
+}
+
+
+
+/*************************************************************************************************/
+/* ELEMENT ACCESSORS --------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Access a record, with bounds checking.
+ *
+ * \param       index_: Position of the record.
+ * \retval      ReferenceType: Proxy standing for the record.
+ * \throws      std::length_error if index_ is out of range.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ReferenceType
+SOA_CONTAINER_CLASS_SCOPE__::at(SizeType index_)
+{
+    if(index_ >= m_length)
+    {
+        throw std::length_error("Index out of range");
+    }
+    return ReferenceType(this, index_);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstReferenceType
+SOA_CONTAINER_CLASS_SCOPE__::at(SizeType index_) const
+{
+    if(index_ >= m_length)
+    {
+        throw std::length_error("Index out of range");
+    }
+    return ConstReferenceType(this, index_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the first record.
+ *
+ * \throws      std::length_error if the container is empty.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ReferenceType SOA_CONTAINER_CLASS_SCOPE__::front()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return ReferenceType(this, 0);
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Access the last record.
+ *
+ * \throws      std::length_error if the container is empty.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ReferenceType SOA_CONTAINER_CLASS_SCOPE__::back()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    return ReferenceType(this, m_length - 1);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstReferenceType
+SOA_CONTAINER_CLASS_SCOPE__::front() const
+{
+    return const_cast<soa_container*>(this)->front();
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstReferenceType
+SOA_CONTAINER_CLASS_SCOPE__::back() const
+{
+    return const_cast<soa_container*>(this)->back();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Gather the fields of a record into a StructType.
+ *              Fields not listed in soa_fields are left value-initialized.
+ *
+ * \param       index_: Position of the record.
+ * \retval      ValueType: Copy of the record.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ValueType
+SOA_CONTAINER_CLASS_SCOPE__::get(SizeType index_) const
+{
+    ValueType value{};
+    for_each_field([&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+                   { value.*std::get<Index>(members) = column_data<Index>()[index_]; });
+    return value;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Scatter the fields of a StructType into a record.
+ *
+ * \param       index_: Position of the record.
+ * \param       value_: New value of the record.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::set(SizeType index_, const ValueType& value_)
+{
+    for_each_field([&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+                   { column_data<Index>()[index_] = value_.*std::get<Index>(members); });
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::set(SizeType index_, ValueType&& value_)
+{
+    for_each_field([&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+                   { column_data<Index>()[index_] = std::move(value_.*std::get<Index>(members)); });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the column holding one field of every record.
+ *              The column starts on a cache line boundary (column_alignment).
+ *
+ * \tparam      Field: Member pointer listed in soa_fields, or index of the column.
+ * \retval      SpanType<Field>: Span over the field of each record, in order.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<auto Field>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::template SpanType<Field>
+SOA_CONTAINER_CLASS_SCOPE__::column() noexcept
+{
+    static_assert(field_index<Field> < field_count, "Field is not a column of the container");
+    return SpanType<Field>(column_data<field_index<Field>>(), m_length);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<auto Field>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::template ConstSpanType<Field>
+SOA_CONTAINER_CLASS_SCOPE__::column() const noexcept
+{
+    static_assert(field_index<Field> < field_count, "Field is not a column of the container");
+    return ConstSpanType<Field>(column_data<field_index<Field>>(), m_length);
+}
+
+
+
+/*************************************************************************************************/
+/* OPERATOR OVERLOADS -------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ReferenceType
+SOA_CONTAINER_CLASS_SCOPE__::operator[](SizeType index_) noexcept
+{
+    return ReferenceType(this, index_);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstReferenceType
+SOA_CONTAINER_CLASS_SCOPE__::operator[](SizeType index_) const noexcept
+{
+    return ConstReferenceType(this, index_);
+}
+
+
+
+/*************************************************************************************************/
+/* ITERATORS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::IteratorType
+SOA_CONTAINER_CLASS_SCOPE__::begin() noexcept
+{
+    return IteratorType(this, 0);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::IteratorType
+SOA_CONTAINER_CLASS_SCOPE__::end() noexcept
+{
+    return IteratorType(this, m_length);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+SOA_CONTAINER_CLASS_SCOPE__::begin() const noexcept
+{
+    return ConstIteratorType(this, 0);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+SOA_CONTAINER_CLASS_SCOPE__::end() const noexcept
+{
+    return ConstIteratorType(this, m_length);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+SOA_CONTAINER_CLASS_SCOPE__::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ConstIteratorType
+SOA_CONTAINER_CLASS_SCOPE__::cend() const noexcept
+{
+    return end();
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Append a record, scattering its fields into the columns.
+ *
+ * \param       value_: Record to append.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::push_back(const ValueType& value_)
+{
+    /* Growing first is safe: value_ is a StructType, never one of the columns */
+    grow_for(1);
+    std::apply([&](auto... members_) { construct_back(value_.*members_...); }, members);
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::push_back(ValueType&& value_)
+{
+    grow_for(1);
+    std::apply([&](auto... members_) { construct_back(std::move(value_.*members_)...); },
+               members);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Append a record given one value per field, without building a StructType.
+ *
+ * \param       fields_: Values (or constructor arguments) of each column, in soa_fields order.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline void SOA_CONTAINER_CLASS_SCOPE__::emplace_back(Args&&... fields_)
+{
+    static_assert(sizeof...(Args) == field_count, "Expected one value per field");
+
+    if(m_length < m_capacity)
+    {
+        construct_back(std::forward<Args>(fields_)...);
+        return;
+    }
+
+    /* The arguments may live in the columns about to be reallocated: build the fields first */
+    [&]<SizeType... Is>(std::index_sequence<Is...>)
+    {
+        std::tuple<FieldType<Is>...> fields(std::forward<Args>(fields_)...);
+        grow_for(1);
+        construct_back(std::move(std::get<Is>(fields))...);
+    }(std::make_index_sequence<field_count>{});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the last record.
+ *
+ * \throws      std::length_error if the container is empty.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::pop_back()
+{
+    if(is_empty())
+    {
+        throw std::length_error("Could not access element - No memory allocated");
+    }
+    destroy_tail(m_length - 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase a record, shifting every column after it by one.
+ *
+ * \param       position_: Iterator to the record to erase.
+ * \retval      IteratorType: Iterator to the record that followed the erased one.
+ * \throws      std::invalid_argument if position_ is not a record of this container.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::IteratorType
+SOA_CONTAINER_CLASS_SCOPE__::erase(ConstIteratorType position_)
+{
+    const SizeType index = position_.index();
+    if(index >= m_length)
+    {
+        throw std::invalid_argument("Invalid iterator");
+    }
+
+    for_each_field(
+      [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+      {
+          FieldType<Index>* data = column_data<Index>();
+          std::move(data + index + 1, data + m_length, data + index);
+      });
+    destroy_tail(m_length - 1);
+    return IteratorType(this, index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Exchange two records, field by field.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::swap_records(SizeType lhs_, SizeType rhs_)
+{
+    for_each_field(
+      [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+      {
+          using std::swap;
+          swap(column_data<Index>()[lhs_], column_data<Index>()[rhs_]);
+      });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Change the number of records, value-initializing the new ones.
+ *
+ * \param       newLength_: New number of records.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::resize(SizeType newLength_)
+{
+    if(newLength_ <= m_length)
+    {
+        destroy_tail(newLength_);
+        return;
+    }
+
+    reserve(newLength_);
+    while(m_length < newLength_)
+    {
+        [&]<SizeType... Is>(std::index_sequence<Is...>)
+        {
+            construct_back(FieldType<Is>{}...);
+        }(std::make_index_sequence<field_count>{});
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every record. The columns are kept for reuse.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::clear() noexcept
+{
+    destroy_tail(0);
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::SizeType
+SOA_CONTAINER_CLASS_SCOPE__::length() const noexcept
+{
+    return m_length;
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool SOA_CONTAINER_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return m_length == 0;
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline bool SOA_CONTAINER_CLASS_SCOPE__::is_not_empty() const noexcept
+{
+    return m_length != 0;
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::SizeType
+SOA_CONTAINER_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline const AllocatorType& SOA_CONTAINER_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make room for at least newCapacity_ records in every column.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > m_capacity)
+    {
+        reallocate(newCapacity_);
+    }
+}
+
+/**
+ **************************************************************************************************
+ * \brief       Shrink the columns to the number of records.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(m_length == 0)
+    {
+        release();
+    }
+    else if(m_length < m_capacity)
+    {
+        reallocate(m_length);
+    }
+}
+
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline std::string SOA_CONTAINER_CLASS_SCOPE__::to_string() const
+{
+    std::stringstream ss;
+    ss << "[";
+    for(SizeType i = 0; i < m_length; ++i)
+    {
+        ss << (i == 0 ? "{" : ", {");
+        for_each_field(
+          [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+          {
+              ss << (Index == 0 ? "" : ", ");
+              if constexpr(requires { ss << column_data<Index>()[i]; })
+              {
+                  ss << column_data<Index>()[i];
+              }
+              else
+              {
+                  ss << "?";
+              }
+          });
+        ss << "}";
+    }
+    ss << "]";
+    return ss.str();
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Check whether a member pointer listed in soa_fields is the Field looked up.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<auto Field, typename MemberType>
+inline constexpr bool SOA_CONTAINER_CLASS_SCOPE__::is_same_member(MemberType member_) noexcept
+{
+    if constexpr(std::is_same_v<MemberType, decltype(Field)>)
+    {
+        return member_ == Field;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Call a function once per column, with the index of the column as an
+ *              std::integral_constant.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename FunctionType>
+inline void SOA_CONTAINER_CLASS_SCOPE__::for_each_field(FunctionType&& function_)
+{
+    [&]<SizeType... Is>(std::index_sequence<Is...>)
+    {
+        (function_(std::integral_constant<SizeType, Is>{}), ...);
+    }(std::make_index_sequence<field_count>{});
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of cache lines taken by every column for a given capacity, each column
+ *              starting on a cache line of its own.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::SizeType
+SOA_CONTAINER_CLASS_SCOPE__::block_count(SizeType capacity_) noexcept
+{
+    SizeType blocks = 0;
+    for_each_field(
+      [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+      {
+          static_assert(alignof(FieldType<Index>) <= column_alignment,
+                        "Field is over-aligned for a column");
+          const SizeType bytes = capacity_ * sizeof(FieldType<Index>);
+          blocks += (bytes + column_alignment - 1) / column_alignment;
+      });
+    return blocks;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Split an allocation into one column per field.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::ColumnsType
+SOA_CONTAINER_CLASS_SCOPE__::carve_columns(block_type* block_, SizeType capacity_) noexcept
+{
+    ColumnsType columns{};
+    for_each_field(
+      [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+      {
+          std::get<Index>(columns) = reinterpret_cast<FieldType<Index>*>(block_);
+          const SizeType bytes     = capacity_ * sizeof(FieldType<Index>);
+          block_ += (bytes + column_alignment - 1) / column_alignment;
+      });
+    return columns;
+}
+
+
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename SOA_CONTAINER_CLASS_SCOPE__::SizeType Index>
+inline typename SOA_CONTAINER_CLASS_SCOPE__::template FieldType<Index>*
+SOA_CONTAINER_CLASS_SCOPE__::column_data() const noexcept
+{
+    return std::get<Index>(m_columns);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct a record past the end, one field per column. There must be room for it.
+ *              If a field throws, the fields already constructed are destroyed.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline void SOA_CONTAINER_CLASS_SCOPE__::construct_back(Args&&... fields_)
+{
+    SizeType constructed = 0;
+    try
+    {
+        [&]<SizeType... Is>(std::index_sequence<Is...>)
+        {
+            (
+              [&]
+              {
+                  FieldAllocatorType<Is> allocator{m_allocator};
+                  FieldTraits<Is>::construct(
+                    allocator, column_data<Is>() + m_length, std::forward<Args>(fields_));
+                  ++constructed;
+              }(),
+              ...);
+        }(std::make_index_sequence<field_count>{});
+    }
+    catch(...)
+    {
+        for_each_field(
+          [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+          {
+              if(Index < constructed)
+              {
+                  FieldAllocatorType<Index> allocator{m_allocator};
+                  FieldTraits<Index>::destroy(allocator, column_data<Index>() + m_length);
+              }
+          });
+        throw;
+    }
+    ++m_length;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy the records from newLength_ on.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::destroy_tail(SizeType newLength_) noexcept
+{
+    for_each_field(
+      [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+      {
+          FieldAllocatorType<Index> allocator{m_allocator};
+          for(SizeType i = newLength_; i < m_length; ++i)
+          {
+              FieldTraits<Index>::destroy(allocator, column_data<Index>() + i);
+          }
+      });
+    m_length = std::min(m_length, newLength_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move every column to a new allocation of newCapacity_ records.
+ *              If moving a field throws, the new allocation is freed and the container is left
+ *              unchanged (fields that cannot be moved without throwing are copied).
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::reallocate(SizeType newCapacity_)
+{
+    BlockAllocatorType blockAllocator{m_allocator};
+    const SizeType     newBlockCount = block_count(newCapacity_);
+    block_type*        newBlock      = BlockTraits::allocate(blockAllocator, newBlockCount);
+    ColumnsType        newColumns    = carve_columns(newBlock, newCapacity_);
+
+    SizeType movedFields = 0;
+    SizeType movedItems  = 0;
+    try
+    {
+        for_each_field(
+          [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+          {
+              FieldAllocatorType<Index> allocator{m_allocator};
+              for(movedItems = 0; movedItems < m_length; ++movedItems)
+              {
+                  FieldTraits<Index>::construct(
+                    allocator,
+                    std::get<Index>(newColumns) + movedItems,
+                    std::move_if_noexcept(column_data<Index>()[movedItems]));
+              }
+              ++movedFields;
+          });
+    }
+    catch(...)
+    {
+        for_each_field(
+          [&]<SizeType Index>(std::integral_constant<SizeType, Index>)
+          {
+              FieldAllocatorType<Index> allocator{m_allocator};
+              const SizeType count = Index < movedFields    ? m_length
+                                     : Index == movedFields ? movedItems
+                                                            : 0;
+              for(SizeType i = 0; i < count; ++i)
+              {
+                  FieldTraits<Index>::destroy(allocator, std::get<Index>(newColumns) + i);
+              }
+          });
+        BlockTraits::deallocate(blockAllocator, newBlock, newBlockCount);
+        throw;
+    }
+
+    const SizeType length = m_length;
+    release();
+    m_block    = newBlock;
+    m_length   = length;
+    m_capacity = newCapacity_;
+    m_columns  = newColumns;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every record and free the columns.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::release() noexcept
+{
+    destroy_tail(0);
+    if(m_block != nullptr)
+    {
+        BlockAllocatorType blockAllocator{m_allocator};
+        BlockTraits::deallocate(blockAllocator, m_block, block_count(m_capacity));
+    }
+    m_block    = nullptr;
+    m_capacity = 0;
+    m_columns  = ColumnsType{};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make room for extra_ more records, doubling the capacity when growing.
+ *************************************************************************************************/
+template<SOA_CONTAINER_TEMPLATE_DECLARATION__>
+inline void SOA_CONTAINER_CLASS_SCOPE__::grow_for(SizeType extra_)
+{
+    if(m_length + extra_ > m_capacity)
+    {
+        reallocate(std::max(m_length + extra_, m_capacity * 2));
+    }
+}
+
+
+/*************************************************************************************************/
+/* COMPARISON OPERATORS ------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Two containers are equal when they hold the same number of records and every
+ *              column compares equal, one column at a time.
+ *************************************************************************************************/
+template<typename StructType, typename AllocatorType>
+inline bool operator==(const soa_container<StructType, AllocatorType>& lhs_,
+                       const soa_container<StructType, AllocatorType>& rhs_)
+{
+    if(lhs_.length() != rhs_.length())
+    {
+        return false;
+    }
+
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+    {
+        return (std::ranges::equal(lhs_.template column<Is>(), rhs_.template column<Is>()) && ...);
+    }(std::make_index_sequence<soa_container<StructType, AllocatorType>::field_count>{});
+}
+
+template<typename StructType, typename AllocatorType>
+inline bool operator!=(const soa_container<StructType, AllocatorType>& lhs_,
+                       const soa_container<StructType, AllocatorType>& rhs_)
+{
+    return !(lhs_ == rhs_);
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SOA_CONTAINER_TEMPLATE_DECLARATION__
+#undef SOA_CONTAINER_CLASS_SCOPE__
+#undef SOA_REFERENCE_CLASS_SCOPE__
+#undef SOA_ITERATOR_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
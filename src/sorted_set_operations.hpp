@@ -0,0 +1,1012 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./flat_search.hpp"
+#include "./gather_scatter.hpp"
+#include "./hardware.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Contiguous container of integers, used as a sorted operand by the set operations.
+ */
+template<typename ContainerType>
+concept sorted_integral_container =
+  contiguous_container<const ContainerType>
+  && std::integral<std::remove_const_t<container_item_t<const ContainerType>>>
+  && !std::same_as<std::remove_const_t<container_item_t<const ContainerType>>, bool>;
+
+/**
+ * \brief       Contiguous container that can be sized without initializing its elements, so that
+ *              the set operations write their output straight into its buffer.
+ */
+template<typename ContainerType>
+concept overwritable_container =
+  contiguous_container<ContainerType> && requires(ContainerType& container_, std::size_t length_) {
+      container_.clear();
+      container_.resize_for_overwrite(length_);
+  };
+
+/**
+ * \brief       Two sorted operands and a destination holding the same type of integer.
+ */
+template<typename LhsType, typename RhsType, typename DestinationType>
+concept sorted_set_operands =
+  sorted_integral_container<LhsType> && sorted_integral_container<RhsType>
+  && overwritable_container<DestinationType>
+  && std::same_as<std::remove_const_t<container_item_t<const LhsType>>,
+                  std::remove_const_t<container_item_t<const RhsType>>>
+  && std::same_as<std::remove_const_t<container_item_t<const LhsType>>,
+                  container_item_t<DestinationType>>;
+
+
+/*************************************************************************************************/
+/* Constants ----------------------------------------------------------------------------------- */
+
+/**
+ * \brief       Size ratio between the operands from which the smaller one is walked, and the
+ *              larger one is galloped over instead of scanned.
+ *
+ * \note        A gallop costs about 2 log2(gap) comparisons for a gap of elements, against one
+ *              cheap comparison each for a linear scan, so it only wins on wide gaps.
+ */
+inline constexpr std::size_t galloping_ratio = 64;
+
+/**
+ * \brief       Size ratio between the operands from which the union, the merge and the difference
+ *              from the larger operand copy the runs of the larger one between the elements of the
+ *              smaller one, instead of stepping through both without branches.
+ *
+ * \note        The branch ending each run is then mostly predicted right.
+ */
+inline constexpr std::size_t skewed_ratio = 4;
+
+
+/*************************************************************************************************/
+/* Helpers ------------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Find the first element of a sorted range that is not less than a value, by
+ *              doubling the step from the front before searching the last step.
+ *              O(log d) for an answer d elements in, which is what walking the smaller of two
+ *              very different operands over the larger one needs.
+ *
+ * \param       first_: Pointer to the first element.
+ * \param       count_: Number of elements.
+ * \param       value_: Value to search for.
+ *
+ * \retval      std::size_t: Index of the first element not less than value_, or count_.
+ *************************************************************************************************/
+template<std::integral ItemType>
+[[nodiscard]] inline std::size_t
+gallop_lower_bound(const ItemType* first_, std::size_t count_, ItemType value_) noexcept
+{
+    std::size_t bound = 1;
+    while(bound < count_ && first_[bound - 1] < value_)
+    {
+        bound *= 2;
+    }
+
+    const std::size_t low  = bound / 2;
+    const std::size_t high = std::min(bound, count_);
+    return low + branchless_partition_point(
+                   first_ + low, high - low, [value_](ItemType item_) { return item_ < value_; });
+}
+
+
+/* Whether whole 4 x 4 blocks of elements are compared with SSE2 */
+template<typename ItemType>
+concept block_comparable_set = (PEL_HAS_SSE2 != 0) && (sizeof(ItemType) == 4);
+
+/* Whether the elements selected in a block of 4 are packed with a single SSE4.1 shuffle */
+template<typename ItemType>
+concept block_packable_set = (PEL_HAS_SSE41 != 0) && (sizeof(ItemType) == 4);
+
+/* Whether whole blocks of 4 elements are merged with an SSE4.1 min/max network */
+template<typename ItemType>
+concept block_mergeable_set = (PEL_HAS_SSE41 != 0) && (sizeof(ItemType) == 4);
+
+
+#if PEL_HAS_SSE41
+/* Byte shuffles packing the lanes of a block of 4 elements selected by each 4-bit mask */
+inline constexpr std::array<std::array<std::uint8_t, 16>, 16> lane_packing_shuffles = [] {
+    std::array<std::array<std::uint8_t, 16>, 16> shuffles{};
+    for(std::size_t mask = 0; mask < 16; ++mask)
+    {
+        shuffles[mask].fill(0x80);
+
+        std::size_t packed = 0;
+        for(std::size_t lane = 0; lane < 4; ++lane)
+        {
+            if(((mask >> lane) & 1U) != 0)
+            {
+                for(std::size_t byte = 0; byte < 4; ++byte)
+                {
+                    shuffles[mask][packed * 4 + byte] = static_cast<std::uint8_t>(lane * 4 + byte);
+                }
+                ++packed;
+            }
+        }
+    }
+    return shuffles;
+}();
+#endif
+
+
+#if PEL_HAS_SSE2
+/**
+ **************************************************************************************************
+ * \brief       Write the lanes of a block of 4 elements selected by a mask, packed together.
+ *              One byte shuffle and one store with SSE4.1, one store per lane otherwise.
+ *
+ * \param       output_:   Pointer to the first output element, with room for 4 elements.
+ * \param       block_:    Block of 4 elements.
+ * \param       selected_: Mask of the lanes to write, lane 0 in the lowest bit.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *************************************************************************************************/
+template<std::integral ItemType>
+inline std::size_t
+write_selected_lanes(ItemType* output_, __m128i block_, unsigned selected_) noexcept
+{
+    selected_ &= 0xFU;
+#if PEL_HAS_SSE41
+    const __m128i shuffle =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane_packing_shuffles[selected_].data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output_), _mm_shuffle_epi8(block_, shuffle));
+    return static_cast<std::size_t>(std::popcount(selected_));
+#else
+    alignas(16) ItemType lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), block_);
+
+    std::size_t written = 0;
+    for(unsigned lane = 0; lane < 4; ++lane)
+    {
+        output_[written] = lanes[lane];
+        written += (selected_ >> lane) & 1U;
+    }
+    return written;
+#endif
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Filter a sorted set by membership in another one, 4 x 4 elements at a time.
+ *              Each block of the left operand is compared to each overlapping block of the right
+ *              one with 4 equality comparisons against the rotations of the right block, which
+ *              replaces the unpredictable branches of a scalar merge by a single one per block.
+ *              Stops when either operand runs out of whole blocks.
+ *
+ * \param       lhs_:        Pointer to the first element of the set to filter.
+ * \param       lhsIndex_:   Set to the index of the first element of lhs_ left to filter.
+ * \param       lhsCount_:   Number of elements of lhs_.
+ * \param       rhs_:        Pointer to the first element of the set to test against.
+ * \param       rhsIndex_:   Set to the index of the first element of rhs_ not less than
+ *                           lhs_[lhsIndex_], where the filtering must resume.
+ * \param       rhsCount_:   Number of elements of rhs_.
+ * \param       output_:     Pointer to the first output element.
+ *
+ * \tparam      KeepMatches: Keep the elements found in rhs_ (intersection) or the others
+ *                           (difference).
+ *
+ * \retval      std::size_t: Number of elements written.
+ *************************************************************************************************/
+template<bool KeepMatches, std::integral ItemType>
+    requires(block_comparable_set<ItemType>)
+inline std::size_t
+filter_sorted_blocks(const ItemType* lhs_,
+                     std::size_t&    lhsIndex_,
+                     std::size_t     lhsCount_,
+                     const ItemType* rhs_,
+                     std::size_t&    rhsIndex_,
+                     std::size_t     rhsCount_,
+                     ItemType*       output_) noexcept
+{
+    std::size_t lhs     = 0;
+    std::size_t rhs     = 0;
+    std::size_t written = 0;
+
+    if(lhsCount_ >= 4 && rhsCount_ >= 4)
+    {
+        __m128i  lhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs_));
+        __m128i  rhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs_));
+        unsigned matches  = 0;
+        while(true)
+        {
+            const __m128i rotated1 = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(0, 3, 2, 1));
+            const __m128i rotated2 = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(1, 0, 3, 2));
+            const __m128i rotated3 = _mm_shuffle_epi32(rhsBlock, _MM_SHUFFLE(2, 1, 0, 3));
+            const __m128i equal =
+              _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(lhsBlock, rhsBlock),
+                                        _mm_cmpeq_epi32(lhsBlock, rotated1)),
+                           _mm_or_si128(_mm_cmpeq_epi32(lhsBlock, rotated2),
+                                        _mm_cmpeq_epi32(lhsBlock, rotated3)));
+            matches |= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+
+            const ItemType lhsLast = lhs_[lhs + 3];
+            const ItemType rhsLast = rhs_[rhs + 3];
+            if(lhsLast <= rhsLast)
+            {
+                /* Every element this block can match has been seen: write the kept ones */
+                written += write_selected_lanes<ItemType>(
+                  output_ + written, lhsBlock, KeepMatches ? matches : ~matches);
+                matches = 0;
+                lhs += 4;
+                if(lhs + 4 > lhsCount_)
+                {
+                    break;
+                }
+                lhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs_ + lhs));
+            }
+            if(rhsLast <= lhsLast)
+            {
+                rhs += 4;
+                if(rhs + 4 > rhsCount_)
+                {
+                    break;
+                }
+                rhsBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs_ + rhs));
+            }
+        }
+
+        /* The matches of a block left half-compared are forgotten: step back over the elements
+         * of rhs_ it may still match */
+        if(lhs < lhsCount_)
+        {
+            rhs = static_cast<std::size_t>(std::lower_bound(rhs_, rhs_ + rhs, lhs_[lhs]) - rhs_);
+        }
+    }
+
+    lhsIndex_ = lhs;
+    rhsIndex_ = rhs;
+    return written;
+}
+#endif
+
+
+#if PEL_HAS_SSE41
+/**
+ **************************************************************************************************
+ * \brief       Merge two sorted blocks of 4 elements with a min/max network.
+ *
+ * \param       low_:  One sorted block, set to the 4 smallest elements, sorted.
+ * \param       high_: The other sorted block, set to the 4 largest elements, sorted.
+ *************************************************************************************************/
+template<std::integral ItemType>
+inline void
+merge_blocks(__m128i& low_, __m128i& high_) noexcept
+{
+    const auto minimum = [](__m128i lhs_, __m128i rhs_) {
+        if constexpr(std::is_signed_v<ItemType>)
+        {
+            return _mm_min_epi32(lhs_, rhs_);
+        }
+        else
+        {
+            return _mm_min_epu32(lhs_, rhs_);
+        }
+    };
+    const auto maximum = [](__m128i lhs_, __m128i rhs_) {
+        if constexpr(std::is_signed_v<ItemType>)
+        {
+            return _mm_max_epi32(lhs_, rhs_);
+        }
+        else
+        {
+            return _mm_max_epu32(lhs_, rhs_);
+        }
+    };
+
+    /* Keep the lane-wise maximums in high_, and rotate the minimums by one lane to compare them
+     * with the next lane of high_: after one round per lane, both blocks are sorted */
+    __m128i rotated = minimum(low_, high_);
+    high_           = maximum(low_, high_);
+    for(int round = 0; round < 3; ++round)
+    {
+        rotated = _mm_shuffle_epi32(rotated, _MM_SHUFFLE(0, 3, 2, 1));
+        low_    = minimum(rotated, high_);
+        high_   = maximum(rotated, high_);
+        rotated = low_;
+    }
+    low_ = _mm_shuffle_epi32(low_, _MM_SHUFFLE(0, 3, 2, 1));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Merge two sorted ranges 4 elements at a time, with a single branch per block
+ *              to pick the operand to load next.
+ *              Stops when either operand runs out of whole blocks; the 4 largest elements merged
+ *              so far are then left in pending_, all other elements written are smaller.
+ *
+ * \param       lhs_:      Pointer to the first element of the first range.
+ * \param       lhsIndex_: Set to the index of the first element of lhs_ left to merge.
+ * \param       lhsCount_: Number of elements of lhs_.
+ * \param       rhs_:      Pointer to the first element of the second range.
+ * \param       rhsIndex_: Set to the index of the first element of rhs_ left to merge.
+ * \param       rhsCount_: Number of elements of rhs_.
+ * \param       output_:   Pointer to the first output element.
+ * \param       pending_:  Set to the 4 elements merged but not written, sorted.
+ *
+ * \tparam      Unique:    Drop the elements equal to the one before them (union of two sets).
+ *
+ * \retval      std::size_t: Number of elements written, 0 if either range has less than 4 elements.
+ *************************************************************************************************/
+template<bool Unique, std::integral ItemType>
+    requires(block_mergeable_set<ItemType>)
+inline std::size_t
+merge_sorted_blocks(const ItemType* lhs_,
+                    std::size_t&    lhsIndex_,
+                    std::size_t     lhsCount_,
+                    const ItemType* rhs_,
+                    std::size_t&    rhsIndex_,
+                    std::size_t     rhsCount_,
+                    ItemType*       output_,
+                    ItemType (&pending_)[4]) noexcept
+{
+    lhsIndex_ = 0;
+    rhsIndex_ = 0;
+    if(lhsCount_ < 4 || rhsCount_ < 4)
+    {
+        return 0;
+    }
+
+    std::size_t lhs     = 4;
+    std::size_t rhs     = 4;
+    std::size_t written = 0;
+    __m128i     low     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs_));
+    __m128i     high    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs_));
+
+    /* Last block written, whose last lane is the element before the next block. Lane 0 of the
+     * first block has nothing before it to be equal to */
+    __m128i  last      = _mm_setzero_si128();
+    unsigned firstLane = 1;
+    while(true)
+    {
+        merge_blocks<ItemType>(low, high);
+
+        if constexpr(Unique)
+        {
+            const __m128i previous =
+              _mm_or_si128(_mm_slli_si128(low, 4), _mm_srli_si128(last, 12));
+            const unsigned equal = static_cast<unsigned>(
+              _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(low, previous))));
+            written += write_selected_lanes<ItemType>(output_ + written, low, ~equal | firstLane);
+            last      = low;
+            firstLane = 0;
+        }
+        else
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output_ + written), low);
+            written += 4;
+        }
+
+        if(lhs + 4 > lhsCount_ || rhs + 4 > rhsCount_)
+        {
+            break;
+        }
+
+        /* The block with the smallest first element holds the next elements in order */
+        if(lhs_[lhs] <= rhs_[rhs])
+        {
+            low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs_ + lhs));
+            lhs += 4;
+        }
+        else
+        {
+            low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs_ + rhs));
+            rhs += 4;
+        }
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pending_), high);
+    lhsIndex_ = lhs;
+    rhsIndex_ = rhs;
+    return written;
+}
+#endif
+
+
+/**
+ **************************************************************************************************
+ * \brief       Merge two sorted ranges without data-dependent branches: each step writes the
+ *              smaller head and advances its operand with a conditional move.
+ *
+ * \param       lhs_:      Pointer to the first element of the first range.
+ * \param       lhsCount_: Number of elements of lhs_.
+ * \param       rhs_:      Pointer to the first element of the second range.
+ * \param       rhsCount_: Number of elements of rhs_.
+ * \param       output_:   Pointer to the first output element, with room for every element.
+ *
+ * \tparam      Unique:    Write equal heads once (union of two sets) instead of both (merge).
+ *
+ * \retval      std::size_t: Number of elements written.
+ *************************************************************************************************/
+template<bool Unique, std::integral ItemType>
+inline std::size_t
+merge_sorted_scalar(const ItemType* lhs_,
+                    std::size_t     lhsCount_,
+                    const ItemType* rhs_,
+                    std::size_t     rhsCount_,
+                    ItemType*       output_) noexcept
+{
+    std::size_t lhs     = 0;
+    std::size_t rhs     = 0;
+    std::size_t written = 0;
+    while(lhs < lhsCount_ && rhs < rhsCount_)
+    {
+        const ItemType lhsItem = lhs_[lhs];
+        const ItemType rhsItem = rhs_[rhs];
+        const bool     takeLhs = lhsItem <= rhsItem;
+
+        output_[written++] = std::min(lhsItem, rhsItem);
+        lhs += static_cast<std::size_t>(takeLhs);
+        if constexpr(Unique)
+        {
+            rhs += static_cast<std::size_t>(rhsItem <= lhsItem);
+        }
+        else
+        {
+            rhs += static_cast<std::size_t>(!takeLhs);
+        }
+    }
+
+    output_ = std::copy(lhs_ + lhs, lhs_ + lhsCount_, output_ + written);
+    std::copy(rhs_ + rhs, rhs_ + rhsCount_, output_);
+    return written + (lhsCount_ - lhs) + (rhsCount_ - rhs);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Merge a sorted range much smaller than the other one, by copying the run of the
+ *              larger range up to each element of the smaller one: a scan with a mostly predicted
+ *              branch, or a gallop and a block copy.
+ *
+ * \param       small_:      Pointer to the first element of the smaller range.
+ * \param       smallCount_: Number of elements of small_.
+ * \param       large_:      Pointer to the first element of the larger range.
+ * \param       largeCount_: Number of elements of large_.
+ * \param       output_:     Pointer to the first output element, with room for every element.
+ * \param       gallop_:     Gallop over the runs instead of scanning them, for runs long enough
+ *                           that a scan would cost more than the mispredicted branches of a search.
+ *
+ * \tparam      Unique:      Skip the elements of large_ equal to an element of small_.
+ * \tparam      KeepSmall:   Write the elements of small_ (merge or union) or leave them out
+ *                           (difference, with large_ as the set to take elements from).
+ *
+ * \retval      std::size_t: Number of elements written.
+ *************************************************************************************************/
+template<bool Unique, bool KeepSmall, std::integral ItemType>
+inline std::size_t
+merge_sorted_skewed(const ItemType* small_,
+                    std::size_t     smallCount_,
+                    const ItemType* large_,
+                    std::size_t     largeCount_,
+                    ItemType*       output_,
+                    bool            gallop_) noexcept
+{
+    ItemType* const first = output_;
+    std::size_t     large = 0;
+    for(std::size_t small = 0; small < smallCount_; ++small)
+    {
+        const ItemType item = small_[small];
+        if(gallop_)
+        {
+            const std::size_t run = gallop_lower_bound(large_ + large, largeCount_ - large, item);
+            output_               = std::copy(large_ + large, large_ + large + run, output_);
+            large += run;
+        }
+        else
+        {
+            while(large < largeCount_ && large_[large] < item)
+            {
+                *output_++ = large_[large++];
+            }
+        }
+
+        if constexpr(KeepSmall)
+        {
+            *output_++ = item;
+        }
+        if constexpr(Unique)
+        {
+            large += (large < largeCount_ && large_[large] == item) ? 1 : 0;
+        }
+    }
+
+    output_ = std::copy(large_ + large, large_ + largeCount_, output_);
+    return static_cast<std::size_t>(output_ - first);
+}
+
+
+/*************************************************************************************************/
+/* Kernels ------------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Write the elements common to two sorted sets.
+ *              Gallops over the larger set when one is galloping_ratio times larger than the other,
+ *              compares blocks of 4 elements with SSE2 for 4-byte integers, and otherwise steps
+ *              through both sets without data-dependent branches.
+ *
+ * \param       lhs_:      Pointer to the first element of the first set.
+ * \param       lhsCount_: Number of elements of lhs_.
+ * \param       rhs_:      Pointer to the first element of the second set.
+ * \param       rhsCount_: Number of elements of rhs_.
+ * \param       output_:   Pointer to the first output element, with room for the smaller set.
+ *                         Must not overlap either set.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *
+ * \warning     Both sets must be sorted in ascending order, without duplicates.
+ *************************************************************************************************/
+template<std::integral ItemType>
+inline std::size_t
+intersect_sorted(const ItemType* lhs_,
+                 std::size_t     lhsCount_,
+                 const ItemType* rhs_,
+                 std::size_t     rhsCount_,
+                 ItemType*       output_) noexcept
+{
+    /* Walk the smaller set, so that no write goes past its length */
+    if(lhsCount_ > rhsCount_)
+    {
+        std::swap(lhs_, rhs_);
+        std::swap(lhsCount_, rhsCount_);
+    }
+
+    std::size_t written = 0;
+    if(rhsCount_ / galloping_ratio > lhsCount_)
+    {
+        std::size_t rhs = 0;
+        for(std::size_t lhs = 0; lhs < lhsCount_; ++lhs)
+        {
+            const ItemType item = lhs_[lhs];
+            rhs += gallop_lower_bound(rhs_ + rhs, rhsCount_ - rhs, item);
+            if(rhs == rhsCount_)
+            {
+                break;
+            }
+            output_[written] = item;
+            written += rhs_[rhs] == item ? 1 : 0;
+        }
+        return written;
+    }
+
+    std::size_t lhs = 0;
+    std::size_t rhs = 0;
+    if constexpr(block_comparable_set<ItemType>)
+    {
+        written = filter_sorted_blocks<true>(lhs_, lhs, lhsCount_, rhs_, rhs, rhsCount_, output_);
+    }
+
+    while(lhs < lhsCount_ && rhs < rhsCount_)
+    {
+        const ItemType lhsItem = lhs_[lhs];
+        const ItemType rhsItem = rhs_[rhs];
+
+        output_[written] = lhsItem;
+        written += lhsItem == rhsItem ? 1 : 0;
+        lhs += lhsItem <= rhsItem ? 1 : 0;
+        rhs += rhsItem <= lhsItem ? 1 : 0;
+    }
+    return written;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write the elements of a sorted set that are not in another one.
+ *              Gallops over whichever set is galloping_ratio times larger than the other, compares
+ *              blocks of 4 elements with SSE2 for 4-byte integers, and otherwise steps through
+ *              both sets without data-dependent branches.
+ *
+ * \param       lhs_:      Pointer to the first element of the set to take elements from.
+ * \param       lhsCount_: Number of elements of lhs_.
+ * \param       rhs_:      Pointer to the first element of the set of elements to leave out.
+ * \param       rhsCount_: Number of elements of rhs_.
+ * \param       output_:   Pointer to the first output element, with room for lhsCount_ elements.
+ *                         Must not overlap either set.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *
+ * \warning     Both sets must be sorted in ascending order, without duplicates.
+ *************************************************************************************************/
+template<std::integral ItemType>
+inline std::size_t
+subtract_sorted(const ItemType* lhs_,
+                std::size_t     lhsCount_,
+                const ItemType* rhs_,
+                std::size_t     rhsCount_,
+                ItemType*       output_) noexcept
+{
+    std::size_t lhs     = 0;
+    std::size_t rhs     = 0;
+    std::size_t written = 0;
+
+    if(rhsCount_ / galloping_ratio > lhsCount_)
+    {
+        for(; lhs < lhsCount_; ++lhs)
+        {
+            const ItemType item = lhs_[lhs];
+            rhs += gallop_lower_bound(rhs_ + rhs, rhsCount_ - rhs, item);
+            output_[written] = item;
+            written += (rhs == rhsCount_ || rhs_[rhs] != item) ? 1 : 0;
+        }
+        return written;
+    }
+
+    /* Once the kept elements of the blocks are packed with a single shuffle, the blocks are as
+     * fast as a scan of the runs and only galloping is worth it over them */
+    const std::size_t runRatio = block_packable_set<ItemType> ? galloping_ratio : skewed_ratio;
+    if(lhsCount_ / runRatio > rhsCount_)
+    {
+        return merge_sorted_skewed<true, false>(
+          rhs_, rhsCount_, lhs_, lhsCount_, output_, lhsCount_ / galloping_ratio > rhsCount_);
+    }
+
+    if constexpr(block_comparable_set<ItemType>)
+    {
+        written = filter_sorted_blocks<false>(lhs_, lhs, lhsCount_, rhs_, rhs, rhsCount_, output_);
+    }
+
+    while(lhs < lhsCount_ && rhs < rhsCount_)
+    {
+        const ItemType lhsItem = lhs_[lhs];
+        const ItemType rhsItem = rhs_[rhs];
+
+        output_[written] = lhsItem;
+        written += lhsItem < rhsItem ? 1 : 0;
+        lhs += lhsItem <= rhsItem ? 1 : 0;
+        rhs += rhsItem <= lhsItem ? 1 : 0;
+    }
+    std::copy(lhs_ + lhs, lhs_ + lhsCount_, output_ + written);
+    return written + (lhsCount_ - lhs);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Merge two sorted ranges, keeping equal elements once (union) or all of them (merge).
+ *              Gallops over the larger range when one is galloping_ratio times larger than the
+ *              other, merges blocks of 4 elements with SSE4.1 for 4-byte integers, copies the runs
+ *              of the larger range when one is skewed_ratio times larger than the other, and
+ *              otherwise steps through both ranges without data-dependent branches.
+ *************************************************************************************************/
+template<bool Unique, std::integral ItemType>
+inline std::size_t
+merge_sorted_ranges(const ItemType* lhs_,
+                    std::size_t     lhsCount_,
+                    const ItemType* rhs_,
+                    std::size_t     rhsCount_,
+                    ItemType*       output_) noexcept
+{
+    /* The blocks merge faster than a scan of the runs, so only galloping is worth it over them */
+    const std::size_t runRatio = block_mergeable_set<ItemType> ? galloping_ratio : skewed_ratio;
+    if(rhsCount_ / runRatio > lhsCount_)
+    {
+        return merge_sorted_skewed<Unique, true>(
+          lhs_, lhsCount_, rhs_, rhsCount_, output_, rhsCount_ / galloping_ratio > lhsCount_);
+    }
+    if(lhsCount_ / runRatio > rhsCount_)
+    {
+        return merge_sorted_skewed<Unique, true>(
+          rhs_, rhsCount_, lhs_, lhsCount_, output_, lhsCount_ / galloping_ratio > rhsCount_);
+    }
+
+    if constexpr(block_mergeable_set<ItemType>)
+    {
+        std::size_t       lhs = 0;
+        std::size_t       rhs = 0;
+        ItemType          pending[4];
+        const std::size_t written =
+          merge_sorted_blocks<Unique>(lhs_, lhs, lhsCount_, rhs_, rhs, rhsCount_, output_, pending);
+        if(written != 0)
+        {
+            /* Merge the pending block with the operand left with less than a block, which leaves
+             * at most 7 elements to merge with the rest of the other operand */
+            const bool      lhsShort   = lhs + 4 > lhsCount_;
+            const ItemType*   shortRest  = lhsShort ? lhs_ + lhs : rhs_ + rhs;
+            const std::size_t shortCount = lhsShort ? lhsCount_ - lhs : rhsCount_ - rhs;
+            const ItemType* longRest   = lhsShort ? rhs_ + rhs : lhs_ + lhs;
+            std::size_t     longCount  = lhsShort ? rhsCount_ - rhs : lhsCount_ - lhs;
+
+            ItemType    tail[7];
+            std::size_t tailCount =
+              merge_sorted_scalar<false>(pending, 4, shortRest, shortCount, tail);
+            if constexpr(Unique)
+            {
+                /* The tail may repeat the last element written, and the pending block may hold
+                 * an element of each set that are equal */
+                const ItemType last = output_[written - 1];
+                tailCount = static_cast<std::size_t>(
+                  std::unique(tail, std::remove(tail, tail + tailCount, last)) - tail);
+                if(longCount != 0 && longRest[0] == last)
+                {
+                    ++longRest;
+                    --longCount;
+                }
+            }
+            return written
+                   + merge_sorted_scalar<Unique>(
+                     tail, tailCount, longRest, longCount, output_ + written);
+        }
+    }
+
+    return merge_sorted_scalar<Unique>(lhs_, lhsCount_, rhs_, rhsCount_, output_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write the elements of either of two sorted sets, once each.
+ *
+ * \param       lhs_:      Pointer to the first element of the first set.
+ * \param       lhsCount_: Number of elements of lhs_.
+ * \param       rhs_:      Pointer to the first element of the second set.
+ * \param       rhsCount_: Number of elements of rhs_.
+ * \param       output_:   Pointer to the first output element, with room for both sets.
+ *                         Must not overlap either set.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *
+ * \warning     Both sets must be sorted in ascending order, without duplicates.
+ *************************************************************************************************/
+template<std::integral ItemType>
+inline std::size_t
+unite_sorted(const ItemType* lhs_,
+             std::size_t     lhsCount_,
+             const ItemType* rhs_,
+             std::size_t     rhsCount_,
+             ItemType*       output_) noexcept
+{
+    return merge_sorted_ranges<true>(lhs_, lhsCount_, rhs_, rhsCount_, output_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Write every element of two sorted ranges, in order.
+ *
+ * \param       lhs_:      Pointer to the first element of the first range.
+ * \param       lhsCount_: Number of elements of lhs_.
+ * \param       rhs_:      Pointer to the first element of the second range.
+ * \param       rhsCount_: Number of elements of rhs_.
+ * \param       output_:   Pointer to the first output element, with room for both ranges.
+ *                         Must not overlap either range.
+ *
+ * \retval      std::size_t: Number of elements written, lhsCount_ + rhsCount_.
+ *
+ * \warning     Both ranges must be sorted in ascending order; they may hold duplicates.
+ *************************************************************************************************/
+template<std::integral ItemType>
+inline std::size_t
+merge_sorted(const ItemType* lhs_,
+             std::size_t     lhsCount_,
+             const ItemType* rhs_,
+             std::size_t     rhsCount_,
+             ItemType*       output_) noexcept
+{
+    return merge_sorted_ranges<false>(lhs_, lhsCount_, rhs_, rhsCount_, output_);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Size a destination to the largest output of a set operation, let the operation
+ *              write straight into its buffer, then shrink it to what was written.
+ *
+ * \param       destination_: Container to write to. Its previous elements are discarded.
+ * \param       bound_:       Largest number of elements the operation can write.
+ * \param       operation_:   Callable taking a pointer to the first output element and returning
+ *                            the number of elements written.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *************************************************************************************************/
+template<overwritable_container DestinationType, typename OperationType>
+inline std::size_t
+write_sorted_output(DestinationType& destination_, std::size_t bound_, OperationType&& operation_)
+{
+    destination_.clear();
+    if(bound_ == 0)
+    {
+        return 0;
+    }
+
+    destination_.resize_for_overwrite(bound_);
+    const std::size_t written = operation_(destination_.begin().ptr());
+    destination_.resize_for_overwrite(written);
+    return written;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Make sure the destination of a set operation is not one of its operands, whose
+ *              buffer it overwrites.
+ *
+ * \throws      std::invalid_argument("The destination cannot be an operand"): If it is.
+ *************************************************************************************************/
+inline void
+check_distinct_destination(const void* lhs_, const void* rhs_, const void* destination_)
+{
+    if(destination_ == lhs_ || destination_ == rhs_)
+    {
+        throw std::invalid_argument("The destination cannot be an operand");
+    }
+}
+
+
+/*************************************************************************************************/
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the elements of a container by the elements common to two sorted sets.
+ *              Gallops over the larger set when one is galloping_ratio times larger than the other,
+ *              and compares blocks of 4 elements with SSE2 for 4-byte integers.
+ *
+ * \param       lhs_:         First set.
+ * \param       rhs_:         Second set.
+ * \param       destination_: Container to write to, sized to the smaller set then shrunk to the
+ *                            result without initializing its elements first.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *
+ * \throws      std::invalid_argument("The destination cannot be an operand"): If it is.
+ *
+ * \warning     Both sets must be sorted in ascending order, without duplicates.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType, typename DestinationType>
+    requires(sorted_set_operands<LhsType, RhsType, DestinationType>)
+inline std::size_t
+set_intersection(const LhsType& lhs_, const RhsType& rhs_, DestinationType& destination_)
+{
+    check_distinct_destination(&lhs_, &rhs_, &destination_);
+    return write_sorted_output(
+      destination_, std::min<std::size_t>(lhs_.length(), rhs_.length()), [&](auto* output_) {
+          return intersect_sorted(
+            lhs_.begin().ptr(), lhs_.length(), rhs_.begin().ptr(), rhs_.length(), output_);
+      });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the elements of a container by the elements of either of two sorted sets.
+ *              Gallops over the larger set when one is galloping_ratio times larger than the other,
+ *              and merges blocks of 4 elements with SSE4.1 for 4-byte integers.
+ *
+ * \param       lhs_:         First set.
+ * \param       rhs_:         Second set.
+ * \param       destination_: Container to write to, sized to both sets then shrunk to the result
+ *                            without initializing its elements first.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *
+ * \throws      std::invalid_argument("The destination cannot be an operand"): If it is.
+ *
+ * \warning     Both sets must be sorted in ascending order, without duplicates.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType, typename DestinationType>
+    requires(sorted_set_operands<LhsType, RhsType, DestinationType>)
+inline std::size_t
+set_union(const LhsType& lhs_, const RhsType& rhs_, DestinationType& destination_)
+{
+    check_distinct_destination(&lhs_, &rhs_, &destination_);
+    return write_sorted_output(
+      destination_, std::size_t{lhs_.length()} + rhs_.length(), [&](auto* output_) {
+          return unite_sorted(
+            lhs_.begin().ptr(), lhs_.length(), rhs_.begin().ptr(), rhs_.length(), output_);
+      });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the elements of a container by the elements of a sorted set that are not
+ *              in another one.
+ *              Gallops over whichever set is galloping_ratio times larger than the other, and
+ *              compares blocks of 4 elements with SSE2 for 4-byte integers.
+ *
+ * \param       lhs_:         Set to take elements from.
+ * \param       rhs_:         Set of elements to leave out.
+ * \param       destination_: Container to write to, sized to lhs_ then shrunk to the result
+ *                            without initializing its elements first.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *
+ * \throws      std::invalid_argument("The destination cannot be an operand"): If it is.
+ *
+ * \warning     Both sets must be sorted in ascending order, without duplicates.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType, typename DestinationType>
+    requires(sorted_set_operands<LhsType, RhsType, DestinationType>)
+inline std::size_t
+set_difference(const LhsType& lhs_, const RhsType& rhs_, DestinationType& destination_)
+{
+    check_distinct_destination(&lhs_, &rhs_, &destination_);
+    return write_sorted_output(destination_, lhs_.length(), [&](auto* output_) {
+        return subtract_sorted(
+          lhs_.begin().ptr(), lhs_.length(), rhs_.begin().ptr(), rhs_.length(), output_);
+    });
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Replace the elements of a container by every element of two sorted ranges, in
+ *              order.
+ *              Gallops over the larger range when one is galloping_ratio times larger than the
+ *              other, and merges blocks of 4 elements with SSE4.1 for 4-byte integers.
+ *
+ * \param       lhs_:         First range.
+ * \param       rhs_:         Second range.
+ * \param       destination_: Container to write to, sized to both ranges without initializing
+ *                            its elements first.
+ *
+ * \retval      std::size_t: Number of elements written.
+ *
+ * \throws      std::invalid_argument("The destination cannot be an operand"): If it is.
+ *
+ * \warning     Both ranges must be sorted in ascending order; they may hold duplicates.
+ *************************************************************************************************/
+template<typename LhsType, typename RhsType, typename DestinationType>
+    requires(sorted_set_operands<LhsType, RhsType, DestinationType>)
+inline std::size_t
+merge(const LhsType& lhs_, const RhsType& rhs_, DestinationType& destination_)
+{
+    check_distinct_destination(&lhs_, &rhs_, &destination_);
+    return write_sorted_output(
+      destination_, std::size_t{lhs_.length()} + rhs_.length(), [&](auto* output_) {
+          return merge_sorted(
+            lhs_.begin().ptr(), lhs_.length(), rhs_.begin().ptr(), rhs_.length(), output_);
+      });
+}
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,147 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Sparse half of sparse_set and sparse_vector: the dense position of every key.
+ *
+ *              Keys are split in pages of 4096 positions (16 KiB), allocated on the first key of
+ *              the page and freed with its last key. Pages are reached through a two-level
+ *              directory: a directory covers 1024 consecutive pages (2^22 keys) and is allocated
+ *              and freed along with its pages, and the root only holds one pointer per directory
+ *              up to the highest key (at most 1024). A handful of keys spread over 2^32 thus only
+ *              takes a handful of pages and directories, whatever the highest key.
+ *              Looking up a key is three loads.
+ */
+template<std::unsigned_integral KeyType, typename AllocatorType>
+class sparse_page_table
+{
+    static_assert(sizeof(KeyType) <= sizeof(std::uint32_t), "Keys are limited to 32 bits");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using SizeType     = std::size_t;
+    using PositionType = std::uint32_t;
+
+    constexpr static const SizeType     page_bits      = 12;
+    constexpr static const SizeType     page_size      = SizeType{1} << page_bits;
+    constexpr static const SizeType     directory_bits = 10;
+    constexpr static const SizeType     directory_size = SizeType{1} << directory_bits;
+    constexpr static const PositionType npos           = ~PositionType{0};
+
+private:
+    /* Page pointers are kept apart from the key counts: lookups only touch the former */
+    struct directory
+    {
+        std::array<PositionType*, directory_size> pages{};
+        std::array<PositionType, directory_size>  keyCounts{};
+        SizeType                                  pageCount = 0;
+    };
+
+    using AllocatorTraits        = std::allocator_traits<AllocatorType>;
+    using PositionAllocatorType  = typename AllocatorTraits::template rebind_alloc<PositionType>;
+    using PositionTraits         = std::allocator_traits<PositionAllocatorType>;
+    using DirectoryAllocatorType = typename AllocatorTraits::template rebind_alloc<directory>;
+    using DirectoryTraits        = std::allocator_traits<DirectoryAllocatorType>;
+    using RootAllocatorType      = typename AllocatorTraits::template rebind_alloc<directory*>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit sparse_page_table(const AllocatorType& alloc_);
+
+    sparse_page_table(const sparse_page_table& copy_);
+    sparse_page_table(sparse_page_table&& move_) noexcept;
+    sparse_page_table& operator=(const sparse_page_table& copy_);
+    sparse_page_table& operator=(sparse_page_table&& move_) noexcept;
+
+    ~sparse_page_table();
+
+
+    /*********************************************************************************************/
+    /* Lookup ---------------------------------------------------------------------------------- */
+    [[nodiscard]] PositionType find(KeyType key_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    void acquire(KeyType key_);
+    void assign(KeyType key_, PositionType position_) noexcept;
+    void erase(KeyType key_) noexcept;
+    void clear() noexcept;
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType page_count() const noexcept;
+    [[nodiscard]] SizeType memory_bytes() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] static SizeType directory_of(KeyType key_) noexcept;
+    [[nodiscard]] static SizeType page_of(KeyType key_) noexcept;
+
+    [[nodiscard]] directory* find_directory(KeyType key_) const noexcept;
+    [[nodiscard]] directory* allocate_directory();
+    void                     free_page(directory& directory_, SizeType page_) noexcept;
+    void                     free_directory(SizeType index_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    std::vector<directory*, RootAllocatorType> m_directories;
+    SizeType                                   m_pageCount = 0;
+
+    [[no_unique_address]] PositionAllocatorType m_allocator;
+};
+
+
+}        // namespace pel
+
+#include "./sparse_page_table.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,393 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./sparse_page_table.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__ std::unsigned_integral KeyType,                   \
+                                                 typename AllocatorType
+
+#define SPARSE_PAGE_TABLE_CLASS_SCOPE__          sparse_page_table<KeyType, AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline SPARSE_PAGE_TABLE_CLASS_SCOPE__::sparse_page_table(const AllocatorType& alloc_)
+: m_directories{RootAllocatorType{alloc_}}, m_allocator{alloc_}
+{
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline SPARSE_PAGE_TABLE_CLASS_SCOPE__::sparse_page_table(const sparse_page_table& copy_)
+: m_directories(copy_.m_directories.size(), nullptr, copy_.m_directories.get_allocator()),
+  m_allocator{PositionTraits::select_on_container_copy_construction(copy_.m_allocator)}
+{
+    try
+    {
+        for(SizeType i = 0; i < m_directories.size(); ++i)
+        {
+            if(copy_.m_directories[i] == nullptr)
+            {
+                continue;
+            }
+
+            const directory& source = *copy_.m_directories[i];
+            directory&       target = *(m_directories[i] = allocate_directory());
+            for(SizeType j = 0; j < directory_size; ++j)
+            {
+                if(source.pages[j] != nullptr)
+                {
+                    target.pages[j]     = PositionTraits::allocate(m_allocator, page_size);
+                    target.keyCounts[j] = source.keyCounts[j];
+                    std::copy_n(source.pages[j], page_size, target.pages[j]);
+                    ++target.pageCount;
+                    ++m_pageCount;
+                }
+            }
+        }
+    }
+    catch(...)
+    {
+        clear();
+        throw;
+    }
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline SPARSE_PAGE_TABLE_CLASS_SCOPE__::sparse_page_table(sparse_page_table&& move_) noexcept
+: m_directories{std::move(move_.m_directories)},
+  m_pageCount{std::exchange(move_.m_pageCount, 0)},
+  m_allocator{move_.m_allocator}
+{
+    move_.m_directories.clear();
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline SPARSE_PAGE_TABLE_CLASS_SCOPE__&
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::operator=(const sparse_page_table& copy_)
+{
+    if(this != &copy_)
+    {
+        sparse_page_table copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline SPARSE_PAGE_TABLE_CLASS_SCOPE__&
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::operator=(sparse_page_table&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        clear();
+
+        m_directories = std::move(move_.m_directories);
+        m_pageCount   = std::exchange(move_.m_pageCount, 0);
+        m_allocator   = move_.m_allocator;
+        move_.m_directories.clear();
+    }
+    return *this;
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline SPARSE_PAGE_TABLE_CLASS_SCOPE__::~sparse_page_table()
+{
+    clear();
+}
+
+
+
+/*************************************************************************************************/
+/* LOOKUP -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Find the dense position of a key.
+ *
+ * \retval      PositionType: Position of the key, or npos if it is not present.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_PAGE_TABLE_CLASS_SCOPE__::PositionType
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::find(KeyType key_) const noexcept
+{
+    const directory* owner = find_directory(key_);
+    if(owner == nullptr || owner->pages[page_of(key_)] == nullptr)
+    {
+        return npos;
+    }
+    return owner->pages[page_of(key_)][key_ & (page_size - 1)];
+}
+
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Allocate the page of a key, and its directory, so that assign() cannot fail.
+ *              A page acquired for nothing is freed along with the next key erased from it.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline void SPARSE_PAGE_TABLE_CLASS_SCOPE__::acquire(KeyType key_)
+{
+    const SizeType directoryIndex = directory_of(key_);
+    if(directoryIndex >= m_directories.size())
+    {
+        m_directories.resize(directoryIndex + 1, nullptr);
+    }
+    if(m_directories[directoryIndex] == nullptr)
+    {
+        m_directories[directoryIndex] = allocate_directory();
+    }
+
+    directory&     owner  = *m_directories[directoryIndex];
+    PositionType*& target = owner.pages[page_of(key_)];
+    if(target == nullptr)
+    {
+        try
+        {
+            target = PositionTraits::allocate(m_allocator, page_size);
+        }
+        catch(...)
+        {
+            if(owner.pageCount == 0)
+            {
+                free_directory(directoryIndex);
+            }
+            throw;
+        }
+        std::uninitialized_fill_n(target, page_size, npos);
+        ++owner.pageCount;
+        ++m_pageCount;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Record the dense position of a key. Its page must have been acquired.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline void SPARSE_PAGE_TABLE_CLASS_SCOPE__::assign(KeyType key_, PositionType position_) noexcept
+{
+    directory&     owner = *m_directories[directory_of(key_)];
+    const SizeType page  = page_of(key_);
+    PositionType&  entry = owner.pages[page][key_ & (page_size - 1)];
+    if(entry == npos)
+    {
+        ++owner.keyCounts[page];
+    }
+    entry = position_;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Forget the position of a key, freeing its page if it was the last key of it, and
+ *              the directory of the page if it was its last page.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline void SPARSE_PAGE_TABLE_CLASS_SCOPE__::erase(KeyType key_) noexcept
+{
+    directory*     owner = find_directory(key_);
+    const SizeType page  = page_of(key_);
+    if(owner == nullptr || owner->pages[page] == nullptr)
+    {
+        return;
+    }
+
+    PositionType& entry = owner->pages[page][key_ & (page_size - 1)];
+    if(entry != npos)
+    {
+        entry = npos;
+        --owner->keyCounts[page];
+    }
+    if(owner->keyCounts[page] == 0)
+    {
+        free_page(*owner, page);
+        if(owner->pageCount == 0)
+        {
+            free_directory(directory_of(key_));
+        }
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free every page and directory. Cheaper than erasing the keys one by one.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline void SPARSE_PAGE_TABLE_CLASS_SCOPE__::clear() noexcept
+{
+    for(SizeType i = 0; i < m_directories.size(); ++i)
+    {
+        if(m_directories[i] != nullptr)
+        {
+            for(SizeType j = 0; j < directory_size; ++j)
+            {
+                free_page(*m_directories[i], j);
+            }
+            free_directory(i);
+        }
+    }
+    m_directories.clear();
+}
+
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_PAGE_TABLE_CLASS_SCOPE__::SizeType
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::page_count() const noexcept
+{
+    return m_pageCount;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Bytes taken by the allocated pages, their directories and the root directory.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_PAGE_TABLE_CLASS_SCOPE__::SizeType
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::memory_bytes() const noexcept
+{
+    const SizeType directoryCount = static_cast<SizeType>(
+      std::count_if(m_directories.begin(),
+                    m_directories.end(),
+                    [](const directory* directory_) { return directory_ != nullptr; }));
+
+    return m_pageCount * page_size * sizeof(PositionType) + directoryCount * sizeof(directory)
+           + m_directories.capacity() * sizeof(directory*);
+}
+
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+/**
+ **************************************************************************************************
+ * \brief       Index of the directory of a key in the root, and of its page in the directory.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_PAGE_TABLE_CLASS_SCOPE__::SizeType
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::directory_of(KeyType key_) noexcept
+{
+    return SizeType{key_} >> (page_bits + directory_bits);
+}
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_PAGE_TABLE_CLASS_SCOPE__::SizeType
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::page_of(KeyType key_) noexcept
+{
+    return (SizeType{key_} >> page_bits) & (directory_size - 1);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Directory holding the page of a key.
+ *
+ * \retval      directory*: The directory, or nullptr if none is allocated for the key.
+ *************************************************************************************************/
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_PAGE_TABLE_CLASS_SCOPE__::directory*
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::find_directory(KeyType key_) const noexcept
+{
+    const SizeType directoryIndex = directory_of(key_);
+    return directoryIndex < m_directories.size() ? m_directories[directoryIndex] : nullptr;
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_PAGE_TABLE_CLASS_SCOPE__::directory*
+SPARSE_PAGE_TABLE_CLASS_SCOPE__::allocate_directory()
+{
+    DirectoryAllocatorType directoryAllocator{m_allocator};
+    directory*             created = DirectoryTraits::allocate(directoryAllocator, 1);
+    std::construct_at(created);
+    return created;
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline void SPARSE_PAGE_TABLE_CLASS_SCOPE__::free_page(directory& directory_,
+                                                        SizeType   page_) noexcept
+{
+    if(directory_.pages[page_] != nullptr)
+    {
+        PositionTraits::deallocate(m_allocator, directory_.pages[page_], page_size);
+        directory_.pages[page_]     = nullptr;
+        directory_.keyCounts[page_] = 0;
+        --directory_.pageCount;
+        --m_pageCount;
+    }
+}
+
+
+template<SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__>
+inline void SPARSE_PAGE_TABLE_CLASS_SCOPE__::free_directory(SizeType index_) noexcept
+{
+    DirectoryAllocatorType directoryAllocator{m_allocator};
+    std::destroy_at(m_directories[index_]);
+    DirectoryTraits::deallocate(directoryAllocator, m_directories[index_], 1);
+    m_directories[index_] = nullptr;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SPARSE_PAGE_TABLE_TEMPLATE_DECLARATION__
+#undef SPARSE_PAGE_TABLE_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
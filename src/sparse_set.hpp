@@ -0,0 +1,141 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+#include "./sparse_page_table.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Set of integer keys from a large range, such as 32-bit IDs, of which few are
+ *              present.
+ *
+ *              The keys present are the container_base range, in no particular order, so
+ *              iterating over them is a plain array scan. A sparse_page_table maps each key to
+ *              its position in that range, which makes insert, erase and contains O(1) while only
+ *              allocating pages for the parts of the key range in use. Erasing moves the last key
+ *              into the hole.
+ *
+ * \warning     Keys must not be modified through the positional accessors or iterators.
+ */
+template<std::unsigned_integral KeyType = std::uint32_t,
+         typename AllocatorType        = std::allocator<KeyType>>
+class sparse_set : public container_base<KeyType, iterator_base<KeyType>, AllocatorType>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType       = KeyType;
+    using IteratorType    = iterator_base<KeyType>;
+    using BaseType        = container_base<KeyType, IteratorType, AllocatorType>;
+    using AllocatorTraits = typename BaseType::AllocatorTraits;
+    using SizeType        = typename BaseType::SizeType;
+    using DifferenceType  = typename BaseType::DifferenceType;
+    using PageTableType   = sparse_page_table<KeyType, AllocatorType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit sparse_set(const AllocatorType& alloc_ = AllocatorType{});
+    sparse_set(std::initializer_list<KeyType> keys_, const AllocatorType& alloc_ = AllocatorType{});
+
+    sparse_set(const sparse_set& copy_);
+    sparse_set(sparse_set&& move_) noexcept;
+    sparse_set& operator=(const sparse_set& copy_);
+    sparse_set& operator=(sparse_set&& move_) noexcept;
+
+    ~sparse_set() override;
+
+
+    /*********************************************************************************************/
+    /* Lookup ---------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType find(KeyType key_) const noexcept;
+    [[nodiscard]] bool         contains(KeyType key_) const noexcept;
+    [[nodiscard]] SizeType     count(KeyType key_) const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    bool         insert(KeyType key_);
+    bool         erase(KeyType key_);
+    IteratorType erase(IteratorType position_);
+
+    void clear();
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType capacity() const noexcept;
+    [[nodiscard]] SizeType page_count() const noexcept;
+    [[nodiscard]] SizeType memory_bytes() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const override;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void erase_at(SizeType index_) noexcept;
+    void reallocate(SizeType newCapacity_);
+    void release() noexcept;
+
+    [[nodiscard]] KeyType* data() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    SizeType      m_capacity = 0;
+    PageTableType m_pages;
+};
+
+
+}        // namespace pel
+
+#include "./sparse_set.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
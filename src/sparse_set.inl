@@ -0,0 +1,468 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./sparse_set.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SPARSE_SET_TEMPLATE_DECLARATION__ std::unsigned_integral KeyType, typename AllocatorType
+#define SPARSE_SET_CLASS_SCOPE__          sparse_set<KeyType, AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty set. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator used for the keys and the pages.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline SPARSE_SET_CLASS_SCOPE__::sparse_set(const AllocatorType& alloc_)
+: BaseType{alloc_}, m_pages{alloc_}
+{
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Create a set from a list of keys. Repeated keys are only inserted once.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline SPARSE_SET_CLASS_SCOPE__::sparse_set(std::initializer_list<KeyType> keys_,
+                                            const AllocatorType&           alloc_)
+: sparse_set(alloc_)
+{
+    /* The delegated constructor completed: the destructor cleans up if this throws */
+    reserve(keys_.size());
+    for(const KeyType key : keys_)
+    {
+        insert(key);
+    }
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline SPARSE_SET_CLASS_SCOPE__::sparse_set(const sparse_set& copy_)
+: BaseType{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)},
+  m_pages{copy_.m_pages}
+{
+    try
+    {
+        reserve(copy_.length());
+        for(const KeyType key : copy_)
+        {
+            AllocatorTraits::construct(this->m_allocator, data() + this->length(), key);
+            this->add_size(1);
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline SPARSE_SET_CLASS_SCOPE__::sparse_set(sparse_set&& move_) noexcept
+: BaseType{move_.m_allocator},
+  m_capacity{std::exchange(move_.m_capacity, 0)},
+  m_pages{std::move(move_.m_pages)}
+{
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline SPARSE_SET_CLASS_SCOPE__& SPARSE_SET_CLASS_SCOPE__::operator=(const sparse_set& copy_)
+{
+    if(this != &copy_)
+    {
+        sparse_set copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline SPARSE_SET_CLASS_SCOPE__& SPARSE_SET_CLASS_SCOPE__::operator=(sparse_set&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+
+        this->m_allocator     = move_.m_allocator;
+        m_capacity            = std::exchange(move_.m_capacity, 0);
+        m_pages               = std::move(move_.m_pages);
+        this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+        this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+    }
+    return *this;
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline SPARSE_SET_CLASS_SCOPE__::~sparse_set()
+{
+    release();
+}
+
+
+/*************************************************************************************************/
+/* LOOKUP -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find a key.
+ *
+ * \retval      IteratorType: Iterator to the key, or end() if it is not in the set.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_SET_CLASS_SCOPE__::IteratorType
+SPARSE_SET_CLASS_SCOPE__::find(KeyType key_) const noexcept
+{
+    const auto position = m_pages.find(key_);
+    return position == PageTableType::npos ? this->end() : IteratorType(data() + position);
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool SPARSE_SET_CLASS_SCOPE__::contains(KeyType key_) const noexcept
+{
+    return m_pages.find(key_) != PageTableType::npos;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Count the occurrences of a key: 0 or 1.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_SET_CLASS_SCOPE__::SizeType
+SPARSE_SET_CLASS_SCOPE__::count(KeyType key_) const noexcept
+{
+    return contains(key_) ? 1 : 0;
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Add a key at the end of the keys, unless it is already there.
+ *              The set is left unchanged if this throws.
+ *
+ * \retval      bool: True if the key was inserted.
+ *
+ * \throws      std::length_error("Too many elements")
+ *              If the set already holds 2^32 - 1 keys.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline bool SPARSE_SET_CLASS_SCOPE__::insert(KeyType key_)
+{
+    if(contains(key_))
+    {
+        return false;
+    }
+
+    const SizeType currentLength = this->length();
+    if(currentLength >= PageTableType::npos)
+    {
+        throw std::length_error("Too many elements");
+    }
+
+    m_pages.acquire(key_);
+    if(currentLength == m_capacity)
+    {
+        reallocate(std::max<SizeType>(1, m_capacity * 2));
+    }
+
+    AllocatorTraits::construct(this->m_allocator, data() + currentLength, key_);
+    m_pages.assign(key_, static_cast<typename PageTableType::PositionType>(currentLength));
+    this->add_size(1);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase a key, moving the last key in its place.
+ *
+ * \retval      bool: True if the key was erased, false if it was not in the set.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline bool SPARSE_SET_CLASS_SCOPE__::erase(KeyType key_)
+{
+    const auto position = m_pages.find(key_);
+    if(position == PageTableType::npos)
+    {
+        return false;
+    }
+
+    erase_at(position);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the key an iterator points to, moving the last key in its place.
+ *
+ * \param       position_: Valid, dereferenceable iterator of this set.
+ *
+ * \retval      IteratorType: Iterator to the same position, now holding the key that was last,
+ *                            or end() if the erased key was the last one.
+ *
+ * \throws      std::invalid_argument("Invalid iterator")
+ *              If the iterator is not within the set, or is end().
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline typename SPARSE_SET_CLASS_SCOPE__::IteratorType
+SPARSE_SET_CLASS_SCOPE__::erase(IteratorType position_)
+{
+    this->check_if_valid(position_);
+    if(position_ == this->cend())
+    {
+        throw std::invalid_argument("Invalid iterator");
+    }
+
+    const SizeType index = static_cast<SizeType>(position_.ptr() - data());
+    erase_at(index);
+    return IteratorType(data() + index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase every key and free the pages. The buffer stays allocated.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline void SPARSE_SET_CLASS_SCOPE__::clear()
+{
+    BaseType::clear();
+    m_pages.clear();
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of keys the buffer can hold.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_SET_CLASS_SCOPE__::SizeType
+SPARSE_SET_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of pages of the key range currently allocated.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_SET_CLASS_SCOPE__::SizeType
+SPARSE_SET_CLASS_SCOPE__::page_count() const noexcept
+{
+    return m_pages.page_count();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Bytes taken by the key buffer and the pages.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_SET_CLASS_SCOPE__::SizeType
+SPARSE_SET_CLASS_SCOPE__::memory_bytes() const noexcept
+{
+    return m_capacity * sizeof(KeyType) + m_pages.memory_bytes();
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline void SPARSE_SET_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > m_capacity)
+    {
+        reallocate(newCapacity_);
+    }
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline void SPARSE_SET_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(this->is_empty())
+    {
+        release();
+    }
+    else if(this->length() < m_capacity)
+    {
+        reallocate(this->length());
+    }
+}
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the keys as a string, such as "[3, 1, 2]", in storage order.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::string SPARSE_SET_CLASS_SCOPE__::to_string() const
+{
+    std::ostringstream stream;
+    stream << '[';
+    for(SizeType i = 0; i < this->length(); ++i)
+    {
+        stream << (i == 0 ? "" : ", ") << +data()[i];
+    }
+    stream << ']';
+    return stream.str();
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the key at a position by moving the last key over it.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline void SPARSE_SET_CLASS_SCOPE__::erase_at(SizeType index_) noexcept
+{
+    KeyType*       keys = data();
+    const SizeType last = this->length() - 1;
+    const KeyType  key  = keys[index_];
+
+    if(index_ != last)
+    {
+        keys[index_] = keys[last];
+        m_pages.assign(keys[index_], static_cast<typename PageTableType::PositionType>(index_));
+    }
+    AllocatorTraits::destroy(this->m_allocator, keys + last);
+    m_pages.erase(key);
+    this->change_size(last);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Copy the keys to a new buffer.
+ *
+ * \param       newCapacity_: Capacity of the new buffer. Must hold at least length() keys.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline void SPARSE_SET_CLASS_SCOPE__::reallocate(SizeType newCapacity_)
+{
+    const SizeType currentLength = this->length();
+    KeyType*       oldKeys       = data();
+    KeyType*       newKeys       = AllocatorTraits::allocate(this->m_allocator, newCapacity_);
+
+    for(SizeType i = 0; i < currentLength; ++i)
+    {
+        AllocatorTraits::construct(this->m_allocator, newKeys + i, oldKeys[i]);
+        AllocatorTraits::destroy(this->m_allocator, oldKeys + i);
+    }
+    if(oldKeys != nullptr)
+    {
+        AllocatorTraits::deallocate(this->m_allocator, oldKeys, m_capacity);
+    }
+
+    m_capacity            = newCapacity_;
+    this->m_beginIterator = IteratorType(newKeys);
+    this->m_endIterator   = IteratorType(newKeys + currentLength);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Free the key buffer. The pages are left as they are.
+ *************************************************************************************************/
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+inline void SPARSE_SET_CLASS_SCOPE__::release() noexcept
+{
+    KeyType* keys = data();
+    if(keys != nullptr)
+    {
+        for(SizeType i = 0; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, keys + i);
+        }
+        AllocatorTraits::deallocate(this->m_allocator, keys, m_capacity);
+    }
+
+    m_capacity            = 0;
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+}
+
+
+template<SPARSE_SET_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline KeyType* SPARSE_SET_CLASS_SCOPE__::data() const noexcept
+{
+    return BaseType::begin().ptr();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SPARSE_SET_TEMPLATE_DECLARATION__
+#undef SPARSE_SET_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
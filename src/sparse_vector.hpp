@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./container_base.hpp"
+#include "./sparse_page_table.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Elements indexed by integer keys from a large range, of which few are present.
+ *
+ *              Same layout as sparse_set: the elements are the container_base range, in no
+ *              particular order, with their keys in a parallel array, and a sparse_page_table maps
+ *              each key to its position. Lookup, insertion and erasure are O(1), iteration is a
+ *              plain array scan, and only the pages of the key range in use are allocated.
+ *              Erasing moves the last element into the hole.
+ *
+ *              The container_base accessors (operator[], at, front, back, iterators) are
+ *              positional; elements are reached by key with find(), get() and at_key().
+ */
+template<typename ItemType,
+         std::unsigned_integral KeyType = std::uint32_t,
+         typename AllocatorType         = std::allocator<ItemType>>
+class sparse_vector : public container_base<ItemType, iterator_base<ItemType>, AllocatorType>
+{
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using ValueType       = ItemType;
+    using IteratorType    = iterator_base<ValueType>;
+    using BaseType        = container_base<ValueType, IteratorType, AllocatorType>;
+    using AllocatorTraits = typename BaseType::AllocatorTraits;
+    using SizeType        = typename BaseType::SizeType;
+    using DifferenceType  = typename BaseType::DifferenceType;
+    using PageTableType   = sparse_page_table<KeyType, AllocatorType>;
+
+private:
+    using KeyAllocatorType = typename AllocatorTraits::template rebind_alloc<KeyType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit sparse_vector(const AllocatorType& alloc_ = AllocatorType{});
+
+    sparse_vector(const sparse_vector& copy_);
+    sparse_vector(sparse_vector&& move_) noexcept;
+    sparse_vector& operator=(const sparse_vector& copy_);
+    sparse_vector& operator=(sparse_vector&& move_) noexcept;
+
+    ~sparse_vector() override;
+
+
+    /*********************************************************************************************/
+    /* Lookup ---------------------------------------------------------------------------------- */
+    [[nodiscard]] IteratorType find(KeyType key_) const noexcept;
+    [[nodiscard]] bool         contains(KeyType key_) const noexcept;
+    [[nodiscard]] SizeType     count(KeyType key_) const noexcept;
+
+    [[nodiscard]] ValueType*       get(KeyType key_) noexcept;
+    [[nodiscard]] const ValueType* get(KeyType key_) const noexcept;
+    [[nodiscard]] ValueType&       at_key(KeyType key_);
+    [[nodiscard]] const ValueType& at_key(KeyType key_) const;
+
+    [[nodiscard]] KeyType                  key_at(SizeType index_) const;
+    [[nodiscard]] std::span<const KeyType> keys() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Modifiers ------------------------------------------------------------------------------- */
+    std::pair<IteratorType, bool> insert(KeyType key_, const ValueType& value_);
+    std::pair<IteratorType, bool> insert(KeyType key_, ValueType&& value_);
+    template<typename... Args>
+    std::pair<IteratorType, bool> emplace(KeyType key_, Args&&... args_);
+    template<typename MappedType>
+    std::pair<IteratorType, bool> insert_or_assign(KeyType key_, MappedType&& value_);
+
+    bool         erase(KeyType key_);
+    IteratorType erase(IteratorType position_);
+
+    void clear();
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType capacity() const noexcept;
+    [[nodiscard]] SizeType page_count() const noexcept;
+    [[nodiscard]] SizeType memory_bytes() const noexcept;
+
+    void reserve(SizeType newCapacity_);
+    void shrink_to_fit();
+
+
+    /*********************************************************************************************/
+    /* Misc ------------------------------------------------------------------------------------ */
+    [[nodiscard]] std::string to_string() const override;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    void erase_at(SizeType index_);
+    void reallocate(SizeType newCapacity_);
+    void release() noexcept;
+
+    [[nodiscard]] ValueType* data() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    SizeType m_capacity = 0;
+
+    /* Key of each element, to update the page table when the element moves */
+    std::vector<KeyType, KeyAllocatorType> m_keys;
+    PageTableType                          m_pages;
+};
+
+
+}        // namespace pel
+
+#include "./sparse_vector.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
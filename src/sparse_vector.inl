@@ -0,0 +1,630 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./sparse_vector.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SPARSE_VECTOR_TEMPLATE_DECLARATION__ typename ItemType,                                    \
+                                             std::unsigned_integral KeyType,                       \
+                                             typename AllocatorType
+#define SPARSE_VECTOR_CLASS_SCOPE__          sparse_vector<ItemType, KeyType, AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Create an empty vector. Nothing is allocated.
+ *
+ * \param       alloc_: Allocator used for the elements, the keys and the pages.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline SPARSE_VECTOR_CLASS_SCOPE__::sparse_vector(const AllocatorType& alloc_)
+: BaseType{alloc_}, m_keys{KeyAllocatorType{alloc_}}, m_pages{alloc_}
+{
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline SPARSE_VECTOR_CLASS_SCOPE__::sparse_vector(const sparse_vector& copy_)
+: BaseType{AllocatorTraits::select_on_container_copy_construction(copy_.m_allocator)},
+  m_keys{copy_.m_keys},
+  m_pages{copy_.m_pages}
+{
+    try
+    {
+        reserve(copy_.length());
+        for(const ValueType& value : copy_)
+        {
+            AllocatorTraits::construct(this->m_allocator, data() + this->length(), value);
+            this->add_size(1);
+        }
+    }
+    catch(...)
+    {
+        release();
+        throw;
+    }
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline SPARSE_VECTOR_CLASS_SCOPE__::sparse_vector(sparse_vector&& move_) noexcept
+: BaseType{move_.m_allocator},
+  m_capacity{std::exchange(move_.m_capacity, 0)},
+  m_keys{std::move(move_.m_keys)},
+  m_pages{std::move(move_.m_pages)}
+{
+    this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+    this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+    move_.m_keys.clear();
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline SPARSE_VECTOR_CLASS_SCOPE__&
+SPARSE_VECTOR_CLASS_SCOPE__::operator=(const sparse_vector& copy_)
+{
+    if(this != &copy_)
+    {
+        sparse_vector copy(copy_);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline SPARSE_VECTOR_CLASS_SCOPE__&
+SPARSE_VECTOR_CLASS_SCOPE__::operator=(sparse_vector&& move_) noexcept
+{
+    if(this != &move_)
+    {
+        release();
+
+        this->m_allocator     = move_.m_allocator;
+        m_capacity            = std::exchange(move_.m_capacity, 0);
+        m_keys                = std::move(move_.m_keys);
+        m_pages               = std::move(move_.m_pages);
+        this->m_beginIterator = std::exchange(move_.m_beginIterator, IteratorType(nullptr));
+        this->m_endIterator   = std::exchange(move_.m_endIterator, IteratorType(nullptr));
+        move_.m_keys.clear();
+    }
+    return *this;
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline SPARSE_VECTOR_CLASS_SCOPE__::~sparse_vector()
+{
+    release();
+}
+
+
+/*************************************************************************************************/
+/* LOOKUP -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Find the element with a given key.
+ *
+ * \retval      IteratorType: Iterator to the element, or end() if there is none.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::IteratorType
+SPARSE_VECTOR_CLASS_SCOPE__::find(KeyType key_) const noexcept
+{
+    const auto position = m_pages.find(key_);
+    return position == PageTableType::npos ? this->end() : IteratorType(data() + position);
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool SPARSE_VECTOR_CLASS_SCOPE__::contains(KeyType key_) const noexcept
+{
+    return m_pages.find(key_) != PageTableType::npos;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Count the elements with a given key: 0 or 1.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::SizeType
+SPARSE_VECTOR_CLASS_SCOPE__::count(KeyType key_) const noexcept
+{
+    return contains(key_) ? 1 : 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Find the element with a given key.
+ *
+ * \retval      ValueType*: The element, or nullptr if there is none.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::ValueType*
+SPARSE_VECTOR_CLASS_SCOPE__::get(KeyType key_) noexcept
+{
+    const auto position = m_pages.find(key_);
+    if(position == PageTableType::npos)
+    {
+        return nullptr;
+    }
+    return BaseType::begin().ptr() + position;
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename SPARSE_VECTOR_CLASS_SCOPE__::ValueType*
+SPARSE_VECTOR_CLASS_SCOPE__::get(KeyType key_) const noexcept
+{
+    const auto position = m_pages.find(key_);
+    if(position == PageTableType::npos)
+    {
+        return nullptr;
+    }
+    return BaseType::begin().ptr() + position;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Access the element with a given key.
+ *
+ * \throws      std::out_of_range("Key not found")
+ *              If no element has that key.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::ValueType&
+SPARSE_VECTOR_CLASS_SCOPE__::at_key(KeyType key_)
+{
+    ValueType* value = get(key_);
+    if(value == nullptr)
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return *value;
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const typename SPARSE_VECTOR_CLASS_SCOPE__::ValueType&
+SPARSE_VECTOR_CLASS_SCOPE__::at_key(KeyType key_) const
+{
+    const ValueType* value = get(key_);
+    if(value == nullptr)
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return *value;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Get the key of the element at a position.
+ *
+ * \throws      std::length_error("Index out of range")
+ *              If there is no element at that position.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline KeyType SPARSE_VECTOR_CLASS_SCOPE__::key_at(SizeType index_) const
+{
+    if(index_ >= this->length())
+    {
+        throw std::length_error("Index out of range");
+    }
+    return m_keys[index_];
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Keys of the elements, in the same order as the elements.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::span<const KeyType> SPARSE_VECTOR_CLASS_SCOPE__::keys() const noexcept
+{
+    return std::span<const KeyType>(m_keys.data(), m_keys.size());
+}
+
+
+/*************************************************************************************************/
+/* MODIFIERS ----------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copy a value at the end of the elements, unless an element has the same key.
+ *
+ * \retval      std::pair<IteratorType, bool>: Iterator to the element with that key, and true if
+ *                                             the value was inserted.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline std::pair<typename SPARSE_VECTOR_CLASS_SCOPE__::IteratorType, bool>
+SPARSE_VECTOR_CLASS_SCOPE__::insert(KeyType key_, const ValueType& value_)
+{
+    return emplace(key_, value_);
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline std::pair<typename SPARSE_VECTOR_CLASS_SCOPE__::IteratorType, bool>
+SPARSE_VECTOR_CLASS_SCOPE__::insert(KeyType key_, ValueType&& value_)
+{
+    return emplace(key_, std::move(value_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Construct an element at the end of the elements, unless an element has the same
+ *              key. The vector is left unchanged if this throws.
+ *
+ * \param       key_:  Key of the element.
+ * \param       args_: Arguments forwarded to the element's constructor. They may refer to
+ *                     elements of the vector.
+ *
+ * \throws      std::length_error("Too many elements")
+ *              If the vector already holds 2^32 - 1 elements.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+template<typename... Args>
+inline std::pair<typename SPARSE_VECTOR_CLASS_SCOPE__::IteratorType, bool>
+SPARSE_VECTOR_CLASS_SCOPE__::emplace(KeyType key_, Args&&... args_)
+{
+    const auto position = m_pages.find(key_);
+    if(position != PageTableType::npos)
+    {
+        return {IteratorType(data() + position), false};
+    }
+
+    const SizeType currentLength = this->length();
+    if(currentLength >= PageTableType::npos)
+    {
+        throw std::length_error("Too many elements");
+    }
+
+    m_pages.acquire(key_);
+    if(currentLength == m_capacity)
+    {
+        /* Build the element before the buffer moves, as the arguments may refer to it */
+        ValueType value(std::forward<Args>(args_)...);
+        reallocate(std::max<SizeType>(1, m_capacity * 2));
+        AllocatorTraits::construct(this->m_allocator, data() + currentLength, std::move(value));
+    }
+    else
+    {
+        AllocatorTraits::construct(
+          this->m_allocator, data() + currentLength, std::forward<Args>(args_)...);
+    }
+
+    /* Never reallocates: the keys are reserved along with the elements */
+    m_keys.push_back(key_);
+    m_pages.assign(key_, static_cast<typename PageTableType::PositionType>(currentLength));
+    this->add_size(1);
+    return {IteratorType(data() + currentLength), true};
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Assign a value to the element with a given key, inserting it if there is none.
+ *
+ * \retval      std::pair<IteratorType, bool>: Iterator to the element with that key, and true if
+ *                                             the value was inserted rather than assigned.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+template<typename MappedType>
+inline std::pair<typename SPARSE_VECTOR_CLASS_SCOPE__::IteratorType, bool>
+SPARSE_VECTOR_CLASS_SCOPE__::insert_or_assign(KeyType key_, MappedType&& value_)
+{
+    ValueType* existing = get(key_);
+    if(existing != nullptr)
+    {
+        *existing = std::forward<MappedType>(value_);
+        return {IteratorType(existing), false};
+    }
+    return emplace(key_, std::forward<MappedType>(value_));
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element with a given key, moving the last element in its place.
+ *
+ * \retval      bool: True if an element was erased.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline bool SPARSE_VECTOR_CLASS_SCOPE__::erase(KeyType key_)
+{
+    const auto position = m_pages.find(key_);
+    if(position == PageTableType::npos)
+    {
+        return false;
+    }
+
+    erase_at(position);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element an iterator points to, moving the last element in its place.
+ *
+ * \param       position_: Valid, dereferenceable iterator of this vector.
+ *
+ * \retval      IteratorType: Iterator to the same position, now holding the element that was
+ *                            last, or end() if the erased element was the last one.
+ *
+ * \throws      std::invalid_argument("Invalid iterator")
+ *              If the iterator is not within the vector, or is end().
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline typename SPARSE_VECTOR_CLASS_SCOPE__::IteratorType
+SPARSE_VECTOR_CLASS_SCOPE__::erase(IteratorType position_)
+{
+    this->check_if_valid(position_);
+    if(position_ == this->cend())
+    {
+        throw std::invalid_argument("Invalid iterator");
+    }
+
+    const SizeType index = static_cast<SizeType>(position_.ptr() - data());
+    erase_at(index);
+    return IteratorType(data() + index);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element and free the pages. The buffer stays allocated.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline void SPARSE_VECTOR_CLASS_SCOPE__::clear()
+{
+    BaseType::clear();
+    m_keys.clear();
+    m_pages.clear();
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of elements the buffer can hold.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::SizeType
+SPARSE_VECTOR_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of pages of the key range currently allocated.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::SizeType
+SPARSE_VECTOR_CLASS_SCOPE__::page_count() const noexcept
+{
+    return m_pages.page_count();
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Bytes taken by the element buffer, the keys and the pages.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::SizeType
+SPARSE_VECTOR_CLASS_SCOPE__::memory_bytes() const noexcept
+{
+    return m_capacity * sizeof(ValueType) + m_keys.capacity() * sizeof(KeyType)
+           + m_pages.memory_bytes();
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline void SPARSE_VECTOR_CLASS_SCOPE__::reserve(SizeType newCapacity_)
+{
+    if(newCapacity_ > m_capacity)
+    {
+        reallocate(newCapacity_);
+    }
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline void SPARSE_VECTOR_CLASS_SCOPE__::shrink_to_fit()
+{
+    if(this->is_empty())
+    {
+        release();
+    }
+    else if(this->length() < m_capacity)
+    {
+        reallocate(this->length());
+    }
+    m_keys.shrink_to_fit();
+}
+
+
+/*************************************************************************************************/
+/* MISC ---------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Represent the elements as a string, such as "[7: a, 3: b]", in storage order.
+ *              Elements that cannot be written to a std::ostream are shown as "?".
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline std::string SPARSE_VECTOR_CLASS_SCOPE__::to_string() const
+{
+    std::ostringstream stream;
+    stream << '[';
+    for(SizeType i = 0; i < this->length(); ++i)
+    {
+        stream << (i == 0 ? "" : ", ") << +m_keys[i] << ": ";
+        if constexpr(requires(std::ostream& os_) { os_ << data()[i]; })
+        {
+            stream << data()[i];
+        }
+        else
+        {
+            stream << '?';
+        }
+    }
+    stream << ']';
+    return stream.str();
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Erase the element at a position by moving the last element over it.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline void SPARSE_VECTOR_CLASS_SCOPE__::erase_at(SizeType index_)
+{
+    ValueType*     items = data();
+    const SizeType last  = this->length() - 1;
+    const KeyType  key   = m_keys[index_];
+
+    if(index_ != last)
+    {
+        items[index_]  = std::move(items[last]);
+        m_keys[index_] = m_keys[last];
+        m_pages.assign(m_keys[index_], static_cast<typename PageTableType::PositionType>(index_));
+    }
+    AllocatorTraits::destroy(this->m_allocator, items + last);
+    m_keys.pop_back();
+    m_pages.erase(key);
+    this->change_size(last);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move the elements to a new buffer.
+ *
+ * \param       newCapacity_: Capacity of the new buffer. Must hold at least length() elements.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline void SPARSE_VECTOR_CLASS_SCOPE__::reallocate(SizeType newCapacity_)
+{
+    m_keys.reserve(newCapacity_);
+
+    const SizeType currentLength = this->length();
+    ValueType*     oldItems      = data();
+    ValueType*     newItems      = AllocatorTraits::allocate(this->m_allocator, newCapacity_);
+
+    for(SizeType i = 0; i < currentLength; ++i)
+    {
+        AllocatorTraits::construct(this->m_allocator, newItems + i, std::move(oldItems[i]));
+        AllocatorTraits::destroy(this->m_allocator, oldItems + i);
+    }
+    if(oldItems != nullptr)
+    {
+        AllocatorTraits::deallocate(this->m_allocator, oldItems, m_capacity);
+    }
+
+    m_capacity            = newCapacity_;
+    this->m_beginIterator = IteratorType(newItems);
+    this->m_endIterator   = IteratorType(newItems + currentLength);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every element and free the buffer. The keys and pages are left as they
+ *              are.
+ *************************************************************************************************/
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+inline void SPARSE_VECTOR_CLASS_SCOPE__::release() noexcept
+{
+    ValueType* items = data();
+    if(items != nullptr)
+    {
+        for(SizeType i = 0; i < this->length(); ++i)
+        {
+            AllocatorTraits::destroy(this->m_allocator, items + i);
+        }
+        AllocatorTraits::deallocate(this->m_allocator, items, m_capacity);
+    }
+
+    m_capacity            = 0;
+    this->m_beginIterator = IteratorType(nullptr);
+    this->m_endIterator   = IteratorType(nullptr);
+}
+
+
+template<SPARSE_VECTOR_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPARSE_VECTOR_CLASS_SCOPE__::ValueType*
+SPARSE_VECTOR_CLASS_SCOPE__::data() const noexcept
+{
+    return BaseType::begin().ptr();
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SPARSE_VECTOR_TEMPLATE_DECLARATION__
+#undef SPARSE_VECTOR_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
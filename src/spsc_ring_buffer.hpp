@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include "./hardware.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Fixed-capacity, lock-free ring buffer for exactly one producer and one consumer.
+ *
+ *              Every slot is constructed once when the buffer is created, so the spans returned by
+ *              write_span() and read_span() always refer to live objects: producers assign into
+ *              them in place and consumers read or move out of them before committing.
+ *              The producer and consumer indices live on separate cache lines, and each side keeps
+ *              a cached copy of the other side's index to avoid touching the shared line on every
+ *              operation.
+ */
+template<typename ItemType, typename AllocatorType = std::allocator<ItemType>>
+class spsc_ring_buffer
+{
+    static_assert(std::is_same_v<ItemType, typename AllocatorType::value_type>,
+                  "Allocator must match element type");
+    static_assert(std::is_default_constructible_v<ItemType>,
+                  "Ring buffer slots are constructed up front and must be default constructible");
+
+
+    /*********************************************************************************************/
+    /* Type definitions ------------------------------------------------------------------------ */
+public:
+    using AllocatorTraits = std::allocator_traits<AllocatorType>;
+    using SizeType        = std::size_t;
+    using DifferenceType  = std::ptrdiff_t;
+    using SpanType        = std::span<ItemType>;
+
+
+    /*********************************************************************************************/
+    /* Constructors ---------------------------------------------------------------------------- */
+public:
+    explicit spsc_ring_buffer(SizeType capacity_, const AllocatorType& alloc_ = AllocatorType{});
+    ~spsc_ring_buffer();
+
+    spsc_ring_buffer(const spsc_ring_buffer&) = delete;
+    spsc_ring_buffer& operator=(const spsc_ring_buffer&) = delete;
+    spsc_ring_buffer(spsc_ring_buffer&&)                 = delete;
+    spsc_ring_buffer& operator=(spsc_ring_buffer&&) = delete;
+
+
+    /*********************************************************************************************/
+    /* Producer -------------------------------------------------------------------------------- */
+    [[nodiscard]] bool try_push(const ItemType& item_);
+    [[nodiscard]] bool try_push(ItemType&& item_);
+
+    [[nodiscard]] SpanType write_span(SizeType maxCount_) noexcept;
+    void                   commit_write(SizeType count_) noexcept;
+
+    template<typename WriterType>
+    SizeType push_n(SizeType count_, WriterType&& writer_);
+
+
+    /*********************************************************************************************/
+    /* Consumer -------------------------------------------------------------------------------- */
+    [[nodiscard]] bool try_pop(ItemType& item_);
+
+    [[nodiscard]] SpanType read_span(SizeType maxCount_) noexcept;
+    void                   commit_read(SizeType count_) noexcept;
+
+    template<typename ReaderType>
+    SizeType pop_n(SizeType count_, ReaderType&& reader_);
+
+
+    /*********************************************************************************************/
+    /* Memory ---------------------------------------------------------------------------------- */
+    [[nodiscard]] SizeType             capacity() const noexcept;
+    [[nodiscard]] SizeType             length() const noexcept;
+    [[nodiscard]] bool                 is_empty() const noexcept;
+    [[nodiscard]] bool                 is_full() const noexcept;
+    [[nodiscard]] const AllocatorType& get_allocator() const noexcept;
+
+
+    /*********************************************************************************************/
+    /* Private methods ------------------------------------------------------------------------- */
+private:
+    [[nodiscard]] SizeType free_slots(SizeType wanted_) noexcept;
+    [[nodiscard]] SizeType used_slots(SizeType wanted_) noexcept;
+
+
+    /*********************************************************************************************/
+    /* Variables ------------------------------------------------------------------------------- */
+private:
+    /* Producer side: next index to write, and the last observed consumer index */
+    alignas(cache_line_size) std::atomic<SizeType> m_tail{0};
+    SizeType m_cachedHead = 0;
+
+    /* Consumer side: next index to read, and the last observed producer index */
+    alignas(cache_line_size) std::atomic<SizeType> m_head{0};
+    SizeType m_cachedTail = 0;
+
+    /* Read-only after construction */
+    alignas(cache_line_size) ItemType* m_buffer = nullptr;
+    SizeType      m_capacity                    = 0;
+    SizeType      m_mask                        = 0;
+    AllocatorType m_allocator{};
+};
+
+
+}        // namespace pel
+
+#include "./spsc_ring_buffer.inl"
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
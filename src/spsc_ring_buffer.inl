@@ -0,0 +1,478 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "./spsc_ring_buffer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+
+/*************************************************************************************************/
+/* Defines ------------------------------------------------------------------------------------- */
+/* clang-format off */
+#define SPSC_RING_BUFFER_TEMPLATE_DECLARATION__ typename ItemType,                                 \
+                                                typename AllocatorType
+
+#define SPSC_RING_BUFFER_CLASS_SCOPE__          spsc_ring_buffer<ItemType,                         \
+                                                                 AllocatorType>
+/* clang-format on */
+
+
+namespace pel
+{
+/*************************************************************************************************/
+/* CONSTRUCTORS & DESTRUCTORS ------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Allocate and default-construct every slot of the ring buffer.
+ *
+ * \param       capacity_: Minimum number of elements the buffer must hold.
+ *                         Rounded up to the next power of two.
+ * \param       alloc_:    Allocator used for the slot array.
+ *
+ * \throws      std::invalid_argument("Ring buffer capacity must not be zero")
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+SPSC_RING_BUFFER_CLASS_SCOPE__::spsc_ring_buffer(SizeType capacity_, const AllocatorType& alloc_)
+: m_allocator{alloc_}
+{
+    if(capacity_ == 0)
+    {
+        throw std::invalid_argument("Ring buffer capacity must not be zero");
+    }
+
+    m_capacity = std::bit_ceil(capacity_);
+    m_mask     = m_capacity - 1;
+    m_buffer   = AllocatorTraits::allocate(m_allocator, m_capacity);
+
+    SizeType constructed = 0;
+    try
+    {
+        for(; constructed < m_capacity; ++constructed)
+        {
+            AllocatorTraits::construct(m_allocator, m_buffer + constructed);
+        }
+    }
+    catch(...)
+    {
+        std::destroy_n(m_buffer, constructed);
+        AllocatorTraits::deallocate(m_allocator, m_buffer, m_capacity);
+        throw;
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Destroy every slot and release the slot array.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+SPSC_RING_BUFFER_CLASS_SCOPE__::~spsc_ring_buffer()
+{
+    for(SizeType i = 0; i < m_capacity; ++i)
+    {
+        AllocatorTraits::destroy(m_allocator, m_buffer + i);
+    }
+    AllocatorTraits::deallocate(m_allocator, m_buffer, m_capacity);
+}
+
+
+/*************************************************************************************************/
+/* PRODUCER ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Copy an element into the buffer.
+ *              Must only be called from the producer thread.
+ *
+ * \param       item_: Element to copy.
+ *
+ * \retval      bool: False if the buffer was full and nothing was pushed.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+SPSC_RING_BUFFER_CLASS_SCOPE__::try_push(const ItemType& item_)
+{
+    SpanType span = write_span(1);
+    if(span.empty())
+    {
+        return false;
+    }
+
+    span.front() = item_;
+    commit_write(1);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Move an element into the buffer.
+ *              Must only be called from the producer thread.
+ *
+ * \param       item_: Element to move. Left untouched if the buffer is full.
+ *
+ * \retval      bool: False if the buffer was full and nothing was pushed.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+SPSC_RING_BUFFER_CLASS_SCOPE__::try_push(ItemType&& item_)
+{
+    SpanType span = write_span(1);
+    if(span.empty())
+    {
+        return false;
+    }
+
+    span.front() = std::move(item_);
+    commit_write(1);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the largest contiguous run of free slots, up to a maximum count.
+ *              The producer fills the slots in place, then publishes them with commit_write().
+ *              Must only be called from the producer thread.
+ *
+ * \param       maxCount_: Maximum number of slots wanted.
+ *
+ * \retval      SpanType: Writable slots. Empty if the buffer is full.
+ *
+ * \note        The run stops at the physical end of the slot array; call again after committing
+ *              to obtain the wrapped-around part.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SpanType
+SPSC_RING_BUFFER_CLASS_SCOPE__::write_span(SizeType maxCount_) noexcept
+{
+    const SizeType tail   = m_tail.load(std::memory_order_relaxed);
+    const SizeType offset = tail & m_mask;
+    const SizeType count  = std::min({free_slots(maxCount_), maxCount_, m_capacity - offset});
+
+    return SpanType(m_buffer + offset, count);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Publish slots previously obtained through write_span() to the consumer.
+ *              Must only be called from the producer thread.
+ *
+ * \param       count_: Number of slots written. Must not exceed the size of the last span.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+inline void
+SPSC_RING_BUFFER_CLASS_SCOPE__::commit_write(SizeType count_) noexcept
+{
+    const SizeType tail = m_tail.load(std::memory_order_relaxed);
+    m_tail.store(tail + count_, std::memory_order_release);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Push up to a number of elements by letting a writer fill the free slots in place.
+ *              All written slots are published with a single store once the writer returns.
+ *              Must only be called from the producer thread.
+ *
+ * \param       count_:  Maximum number of elements to push.
+ * \param       writer_: Callable invoked with a SpanType for each contiguous run of slots
+ *                       (at most twice, when the run wraps around the end of the slot array).
+ *                       It must assign every slot of the span it receives.
+ *
+ * \retval      SizeType: Number of elements pushed.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+template<typename WriterType>
+inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SizeType
+SPSC_RING_BUFFER_CLASS_SCOPE__::push_n(SizeType count_, WriterType&& writer_)
+{
+    const SizeType tail      = m_tail.load(std::memory_order_relaxed);
+    const SizeType total     = std::min(free_slots(count_), count_);
+    const SizeType offset    = tail & m_mask;
+    const SizeType firstRun  = std::min(total, m_capacity - offset);
+    const SizeType secondRun = total - firstRun;
+
+    if(firstRun != 0)
+    {
+        writer_(SpanType(m_buffer + offset, firstRun));
+    }
+    if(secondRun != 0)
+    {
+        writer_(SpanType(m_buffer, secondRun));
+    }
+
+    m_tail.store(tail + total, std::memory_order_release);
+    return total;
+}
+
+
+/*************************************************************************************************/
+/* CONSUMER ------------------------------------------------------------------------------------ */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Move the oldest element out of the buffer.
+ *              Must only be called from the consumer thread.
+ *
+ * \param       item_: Destination of the element.
+ *
+ * \retval      bool: False if the buffer was empty and nothing was popped.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+SPSC_RING_BUFFER_CLASS_SCOPE__::try_pop(ItemType& item_)
+{
+    SpanType span = read_span(1);
+    if(span.empty())
+    {
+        return false;
+    }
+
+    item_ = std::move(span.front());
+    commit_read(1);
+    return true;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Obtain the largest contiguous run of published elements, up to a maximum count.
+ *              The consumer reads (or moves out of) the elements in place, then releases the slots
+ *              with commit_read().
+ *              Must only be called from the consumer thread.
+ *
+ * \param       maxCount_: Maximum number of elements wanted.
+ *
+ * \retval      SpanType: Readable elements. Empty if the buffer is empty.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SpanType
+SPSC_RING_BUFFER_CLASS_SCOPE__::read_span(SizeType maxCount_) noexcept
+{
+    const SizeType head   = m_head.load(std::memory_order_relaxed);
+    const SizeType offset = head & m_mask;
+    const SizeType count  = std::min({used_slots(maxCount_), maxCount_, m_capacity - offset});
+
+    return SpanType(m_buffer + offset, count);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Release slots previously obtained through read_span() back to the producer.
+ *              Must only be called from the consumer thread.
+ *
+ * \param       count_: Number of elements consumed. Must not exceed the size of the last span.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+inline void
+SPSC_RING_BUFFER_CLASS_SCOPE__::commit_read(SizeType count_) noexcept
+{
+    const SizeType head = m_head.load(std::memory_order_relaxed);
+    m_head.store(head + count_, std::memory_order_release);
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Pop up to a number of elements by handing the published runs to a reader.
+ *              All read slots are released with a single store once the reader returns.
+ *              Must only be called from the consumer thread.
+ *
+ * \param       count_:  Maximum number of elements to pop.
+ * \param       reader_: Callable invoked with a SpanType for each contiguous run of elements
+ *                       (at most twice, when the run wraps around the end of the slot array).
+ *
+ * \retval      SizeType: Number of elements popped.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+template<typename ReaderType>
+inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SizeType
+SPSC_RING_BUFFER_CLASS_SCOPE__::pop_n(SizeType count_, ReaderType&& reader_)
+{
+    const SizeType head      = m_head.load(std::memory_order_relaxed);
+    const SizeType total     = std::min(used_slots(count_), count_);
+    const SizeType offset    = head & m_mask;
+    const SizeType firstRun  = std::min(total, m_capacity - offset);
+    const SizeType secondRun = total - firstRun;
+
+    if(firstRun != 0)
+    {
+        reader_(SpanType(m_buffer + offset, firstRun));
+    }
+    if(secondRun != 0)
+    {
+        reader_(SpanType(m_buffer, secondRun));
+    }
+
+    m_head.store(head + total, std::memory_order_release);
+    return total;
+}
+
+
+/*************************************************************************************************/
+/* MEMORY -------------------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, return the number of slots of the buffer.
+ *
+ * \retval      SizeType: Capacity of the buffer, always a power of two.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SizeType
+SPSC_RING_BUFFER_CLASS_SCOPE__::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Return the number of elements currently in the buffer.
+ *
+ * \retval      SizeType: Number of published elements not yet consumed.
+ *
+ * \note        Only a snapshot when called while the other side is running.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SizeType
+SPSC_RING_BUFFER_CLASS_SCOPE__::length() const noexcept
+{
+    const SizeType head = m_head.load(std::memory_order_acquire);
+    const SizeType tail = m_tail.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns true if there are no elements in the buffer.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+SPSC_RING_BUFFER_CLASS_SCOPE__::is_empty() const noexcept
+{
+    return length() == 0;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns true if every slot of the buffer is in use.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline bool
+SPSC_RING_BUFFER_CLASS_SCOPE__::is_full() const noexcept
+{
+    return length() == m_capacity;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Simple accessor, returns a const reference to the buffer's allocator.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline const AllocatorType&
+SPSC_RING_BUFFER_CLASS_SCOPE__::get_allocator() const noexcept
+{
+    return m_allocator;
+}
+
+
+/*************************************************************************************************/
+/* PRIVATE METHODS ----------------------------------------------------------------------------- */
+/*************************************************************************************************/
+
+/**
+ **************************************************************************************************
+ * \brief       Number of slots the producer may write to.
+ *              The consumer's index is only reloaded when the cached value cannot satisfy the
+ *              request, so the shared cache line is rarely touched.
+ *
+ * \param       wanted_: Number of slots the caller would like to write.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SizeType
+SPSC_RING_BUFFER_CLASS_SCOPE__::free_slots(SizeType wanted_) noexcept
+{
+    const SizeType tail = m_tail.load(std::memory_order_relaxed);
+
+    SizeType available = m_capacity - (tail - m_cachedHead);
+    if(available < wanted_)
+    {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        available    = m_capacity - (tail - m_cachedHead);
+    }
+    return available;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Number of elements the consumer may read.
+ *              The producer's index is only reloaded when the cached value cannot satisfy the
+ *              request, so the shared cache line is rarely touched.
+ *
+ * \param       wanted_: Number of elements the caller would like to read.
+ *************************************************************************************************/
+template<SPSC_RING_BUFFER_TEMPLATE_DECLARATION__>
+[[nodiscard]] inline typename SPSC_RING_BUFFER_CLASS_SCOPE__::SizeType
+SPSC_RING_BUFFER_CLASS_SCOPE__::used_slots(SizeType wanted_) noexcept
+{
+    const SizeType head = m_head.load(std::memory_order_relaxed);
+
+    SizeType available = m_cachedTail - head;
+    if(available < wanted_)
+    {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        available    = m_cachedTail - head;
+    }
+    return available;
+}
+
+
+/*************************************************************************************************/
+/* Undefines ----------------------------------------------------------------------------------- */
+#undef SPSC_RING_BUFFER_TEMPLATE_DECLARATION__
+#undef SPSC_RING_BUFFER_CLASS_SCOPE__
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
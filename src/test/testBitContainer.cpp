@@ -0,0 +1,189 @@
+/**
+ * @file    container_base/src/test/testBitContainer.cpp
+ */
+
+#include "src/bit_container.hpp"
+#include "src/bit_rank_index.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+/* Random bits, about one in density_ set */
+std::vector<bool>
+random_bits(std::size_t length_, unsigned density_, unsigned seed_)
+{
+    std::mt19937      rng(seed_);
+    std::vector<bool> bits(length_);
+    for(std::size_t i = 0; i < length_; ++i)
+    {
+        bits[i] = rng() % density_ == 0;
+    }
+    return bits;
+}
+
+pel::bit_container<>
+to_container(const std::vector<bool>& bits_)
+{
+    pel::bit_container<> container;
+    for(bool bit : bits_)
+    {
+        container.push_back(bit);
+    }
+    return container;
+}
+
+void
+bits_match_vector_bool()
+{
+    const std::vector<bool> expected  = random_bits(1000, 3, 1);
+    pel::bit_container<>    container = to_container(expected);
+
+    PEL_CHECK(container.length() == 1000);
+    PEL_CHECK(container.word_count() == 16);
+    PEL_CHECK(std::equal(container.begin(), container.end(), expected.begin(), expected.end()));
+    PEL_CHECK(container.count()
+              == static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)));
+
+    container[10] = !container[10];
+    container.flip(11);
+    PEL_CHECK(container.test(10) != expected[10]);
+    PEL_CHECK(container.test(11) != expected[11]);
+    PEL_CHECK_THROWS(container.at(1000), std::length_error);
+    PEL_CHECK_THROWS(pel::bit_container<>{}.front(), std::length_error);
+}
+
+void
+find_skips_empty_words()
+{
+    pel::bit_container<> container(10000);
+    PEL_CHECK(container.none() && container.find_first() == 10000);
+
+    container.set(4000);
+    container.set(4001);
+    container.set(9999);
+    PEL_CHECK(container.find_first() == 4000);
+    PEL_CHECK(container.find_next(4000) == 4001);
+    PEL_CHECK(container.find_next(4001) == 9999);
+    PEL_CHECK(container.find_next(9999) == 10000);
+    PEL_CHECK(container.any() && !container.all());
+
+    container.set();
+    PEL_CHECK(container.all() && container.count() == 10000);
+}
+
+void
+bitwise_operators_keep_the_tail_clear()
+{
+    pel::bit_container<> lhs(70, false);
+    pel::bit_container<> rhs(70, true);
+    lhs.set(3);
+
+    pel::bit_container<> inverted = ~lhs;
+    PEL_CHECK(inverted.count() == 69);
+    PEL_CHECK((inverted.words()[1] >> 6) == 0);
+
+    lhs |= rhs;
+    PEL_CHECK(lhs.all());
+    lhs ^= rhs;
+    PEL_CHECK(lhs.none());
+    lhs &= rhs;
+    PEL_CHECK(lhs.none());
+
+    pel::bit_container<> shorter(69);
+    PEL_CHECK_THROWS(lhs &= shorter, std::invalid_argument);
+
+    lhs.resize(200, true);
+    PEL_CHECK(lhs.count() == 130);
+    lhs.resize(100);
+    PEL_CHECK(lhs.count() == 30 && (lhs.words()[1] >> 36) == 0);
+}
+
+void
+rank_and_select_agree_with_a_scan()
+{
+    for(unsigned density : {1U, 2U, 50U, 5000U})
+    {
+        const std::vector<bool>                   expected  = random_bits(100000, density, density);
+        const pel::bit_container<>                container = to_container(expected);
+        const pel::bit_rank_index<pel::bit_container<>> index(container);
+
+        std::size_t rank = 0;
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if(i % 97 == 0)
+            {
+                PEL_CHECK(index.rank(i) == rank);
+            }
+            if(expected[i])
+            {
+                PEL_CHECK(index.select(rank) == i);
+                ++rank;
+            }
+        }
+        PEL_CHECK(index.rank(expected.size()) == rank);
+        PEL_CHECK(index.count() == rank);
+        PEL_CHECK_THROWS(index.select(rank), std::length_error);
+        PEL_CHECK_THROWS(index.rank(expected.size() + 1), std::length_error);
+    }
+}
+
+void
+select_bit_finds_every_set_bit()
+{
+    std::mt19937_64 rng(7);
+    for(int i = 0; i < 20000; ++i)
+    {
+        /* Sparse and dense words alike */
+        std::uint64_t word = rng();
+        for(int c = i % 4; c > 0; --c)
+        {
+            word &= rng();
+        }
+
+        unsigned n = 0;
+        for(unsigned bit = 0; bit < 64; ++bit)
+        {
+            if((word >> bit & 1U) != 0)
+            {
+                PEL_CHECK(pel::select_bit(word, n++) == bit);
+            }
+        }
+        PEL_CHECK(n == 64 || pel::select_bit(word, n) == 64);
+    }
+}
+
+void
+rebuild_follows_the_container()
+{
+    pel::bit_container<>                      container(4096);
+    pel::bit_rank_index<pel::bit_container<>> index(container);
+    PEL_CHECK(index.count() == 0);
+
+    container.set(100);
+    container.set(3000);
+    index.rebuild();
+    PEL_CHECK(index.count() == 2);
+    PEL_CHECK(index.rank(3000) == 1);
+    PEL_CHECK(index.select(1) == 3000);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"bits_match_vector_bool", bits_match_vector_bool},
+      {"find_skips_empty_words", find_skips_empty_words},
+      {"bitwise_operators_keep_the_tail_clear", bitwise_operators_keep_the_tail_clear},
+      {"rank_and_select_agree_with_a_scan", rank_and_select_agree_with_a_scan},
+      {"select_bit_finds_every_set_bit", select_bit_finds_every_set_bit},
+      {"rebuild_follows_the_container", rebuild_follows_the_container},
+    });
+}
@@ -0,0 +1,247 @@
+/**
+ * @file    container_base/src/test/testBtreeMap.cpp
+ */
+
+#include "src/btree_map.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/* Shared between every copy of a node_allocator */
+struct node_census
+{
+    std::size_t live       = 0;
+    std::size_t largest    = 0;
+    bool        misaligned = false;
+};
+
+/* Allocator counting the nodes alive and checking how they are laid out */
+template<typename ItemType>
+struct node_allocator
+{
+    using value_type = ItemType;
+
+    explicit node_allocator(node_census& census_) noexcept : census{&census_} {}
+    template<typename OtherType>
+    node_allocator(const node_allocator<OtherType>& other_) noexcept : census{other_.census}
+    {
+    }
+
+    ItemType* allocate(std::size_t count_)
+    {
+        ItemType* items = std::allocator<ItemType>{}.allocate(count_);
+        ++census->live;
+        census->largest = std::max(census->largest, count_ * sizeof(ItemType));
+        census->misaligned |= reinterpret_cast<std::uintptr_t>(items) % pel::cache_line_size != 0;
+        return items;
+    }
+    void deallocate(ItemType* items_, std::size_t count_) noexcept
+    {
+        --census->live;
+        std::allocator<ItemType>{}.deallocate(items_, count_);
+    }
+
+    template<typename OtherType>
+    bool operator==(const node_allocator<OtherType>& other_) const noexcept
+    {
+        return census == other_.census;
+    }
+
+    node_census* census;
+};
+
+template<std::size_t NodeBytes>
+using tracked_map = pel::btree_map<int,
+                                   std::string,
+                                   std::less<int>,
+                                   node_allocator<std::pair<int, std::string>>,
+                                   NodeBytes>;
+
+template<typename MapType>
+bool
+matches(const MapType& map_, const std::map<int, std::string>& expected_)
+{
+    if(map_.length() != expected_.size())
+    {
+        return false;
+    }
+    auto it = map_.begin();
+    for(const auto& [key, value] : expected_)
+    {
+        if(it == map_.end() || it->first != key || it->second != value)
+        {
+            return false;
+        }
+        ++it;
+    }
+    return it == map_.end();
+}
+
+template<std::size_t NodeBytes>
+void
+random_operations_match_std_map()
+{
+    node_census                census;
+    std::map<int, std::string> expected;
+    tracked_map<NodeBytes>     map{std::less<int>{},
+                               node_allocator<std::pair<int, std::string>>{census}};
+    std::mt19937               rng(static_cast<unsigned>(NodeBytes));
+
+    for(int step = 0; step < 40000; ++step)
+    {
+        const int key = static_cast<int>(rng() % 3000);
+        switch(rng() % 4)
+        {
+            case 0:
+            case 1:
+                PEL_CHECK(map.try_emplace(key, std::to_string(key)).second
+                          == expected.try_emplace(key, std::to_string(key)).second);
+                break;
+            case 2: PEL_CHECK(map.erase(key) == expected.erase(key)); break;
+            default:
+            {
+                auto it = map.find(key);
+                if(it != map.end())
+                {
+                    auto next         = map.erase(it);
+                    auto expectedNext = expected.erase(expected.find(key));
+                    PEL_CHECK((next == map.end()) == (expectedNext == expected.end()));
+                    PEL_CHECK(next == map.end() || next->first == expectedNext->first);
+                }
+                break;
+            }
+        }
+    }
+    PEL_CHECK(matches(map, expected));
+
+    while(!expected.empty())
+    {
+        PEL_CHECK(map.erase(expected.begin()->first) == 1);
+        expected.erase(expected.begin());
+    }
+    PEL_CHECK(map.is_empty());
+    PEL_CHECK(map.height() == 0);
+    PEL_CHECK(census.live == 0);
+}
+
+void
+nodes_fit_in_cache_lines()
+{
+    node_census      census;
+    tracked_map<256> small{std::less<int>{}, node_allocator<std::pair<int, std::string>>{census}};
+    tracked_map<512> large{std::less<int>{}, node_allocator<std::pair<int, std::string>>{census}};
+    for(int i = 0; i < 5000; ++i)
+    {
+        small.try_emplace(i * 7 % 5000, "x");
+        large.try_emplace(i * 7 % 5000, "x");
+    }
+
+    PEL_CHECK(!census.misaligned);
+    PEL_CHECK(census.largest <= 512);
+    PEL_CHECK(tracked_map<512>::leaf_capacity * sizeof(std::pair<int, std::string>) <= 512);
+}
+
+void
+erasing_merges_underfull_nodes()
+{
+    node_census      census;
+    tracked_map<512> map{std::less<int>{}, node_allocator<std::pair<int, std::string>>{census}};
+    const int        count = 100000;
+    for(int i = 0; i < count; ++i)
+    {
+        map.try_emplace(i, "x");
+    }
+
+    /* Keep one entry in 100: without merging, every leaf would stay allocated */
+    std::map<int, std::string> expected;
+    for(int i = 0; i < count; ++i)
+    {
+        if(i % 100 == 0)
+        {
+            expected.try_emplace(i, "x");
+        }
+        else
+        {
+            map.erase(i);
+        }
+    }
+
+    PEL_CHECK(matches(map, expected));
+    const std::size_t leafMinimum = tracked_map<512>::leaf_minimum;
+    PEL_CHECK(census.live <= 2 * (expected.size() / leafMinimum + 1));
+    PEL_CHECK(map.height() <= 2);
+}
+
+void
+erase_returns_the_next_entry()
+{
+    pel::btree_map<int, int, std::less<int>, std::allocator<std::pair<int, int>>, 64> map;
+    for(int i = 0; i < 2000; ++i)
+    {
+        map[i] = i;
+    }
+
+    /* Erase every other entry, walking with the returned iterators across rebalancing */
+    auto it = map.begin();
+    while(it != map.end())
+    {
+        it = map.erase(it);
+        if(it != map.end())
+        {
+            ++it;
+        }
+    }
+    PEL_CHECK(map.length() == 1000);
+
+    int key = 1;
+    for(const auto& entry : map)
+    {
+        PEL_CHECK(entry.first == key);
+        key += 2;
+    }
+}
+
+void
+assign_sorted_rejects_unsorted_input()
+{
+    std::vector<std::pair<int, int>> sorted;
+    for(int i = 0; i < 1000; ++i)
+    {
+        sorted.emplace_back(i, i);
+    }
+    pel::btree_map<int, int> map;
+    map.assign_sorted(sorted.begin(), sorted.end());
+    PEL_CHECK(map.length() == 1000);
+    PEL_CHECK(map.at(999) == 999);
+
+    std::vector<std::pair<int, int>> unsorted{{2, 0}, {1, 0}};
+    PEL_CHECK_THROWS(map.assign_sorted(unsorted.begin(), unsorted.end()), std::invalid_argument);
+    PEL_CHECK(map.is_empty());
+    PEL_CHECK_THROWS(map.at(3), std::out_of_range);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"random_operations_match_std_map<256>", random_operations_match_std_map<256>},
+      {"random_operations_match_std_map<512>", random_operations_match_std_map<512>},
+      {"random_operations_match_std_map<4096>", random_operations_match_std_map<4096>},
+      {"nodes_fit_in_cache_lines", nodes_fit_in_cache_lines},
+      {"erasing_merges_underfull_nodes", erasing_merges_underfull_nodes},
+      {"erase_returns_the_next_entry", erase_returns_the_next_entry},
+      {"assign_sorted_rejects_unsorted_input", assign_sorted_rejects_unsorted_input},
+    });
+}
@@ -0,0 +1,164 @@
+/**
+ * @file    container_base/src/test/testCompressedIntContainer.cpp
+ */
+
+#include "src/compressed_int_container.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+template<typename IntegerType>
+bool
+holds(const pel::compressed_int_container<IntegerType>& container_,
+      const std::vector<IntegerType>&                   expected_)
+{
+    if(container_.length() != expected_.size())
+    {
+        return false;
+    }
+    for(std::size_t i = 0; i < expected_.size(); i += 7)
+    {
+        if(container_.at(i) != expected_[i])
+        {
+            return false;
+        }
+    }
+
+    std::size_t index = 0;
+    for(IntegerType value : container_)
+    {
+        if(index >= expected_.size() || value != expected_[index++])
+        {
+            return false;
+        }
+    }
+    return index == expected_.size();
+}
+
+template<typename IntegerType>
+pel::compressed_int_container<IntegerType>
+compress(const std::vector<IntegerType>& values_)
+{
+    return pel::compressed_int_container<IntegerType>(values_.begin(), values_.end());
+}
+
+void
+packing_round_trips_every_width()
+{
+    std::mt19937 rng(1);
+    for(unsigned width = 1; width <= 32; ++width)
+    {
+        const std::uint32_t          mask = width == 32 ? ~0U : (1U << width) - 1;
+        std::array<std::uint32_t, 128> values{};
+        for(std::uint32_t& value : values)
+        {
+            value = static_cast<std::uint32_t>(rng()) & mask;
+        }
+
+        std::vector<std::uint32_t> words(width * 4, 0);
+        pel::bit_pack_128(values.data(), width, words.data());
+
+        std::array<std::uint32_t, 128> unpacked{};
+        pel::bit_unpack_128(words.data(), width, unpacked.data());
+        PEL_CHECK(unpacked == values);
+        PEL_CHECK(pel::bit_extract_128(words.data(), width, 77) == values[77]);
+    }
+}
+
+void
+sorted_ids_compress_with_deltas()
+{
+    std::vector<std::uint64_t> ids;
+    std::uint64_t              id = 1'000'000'000'000;
+    for(int i = 0; i < 10000; ++i)
+    {
+        id += 1 + static_cast<std::uint64_t>(i % 5);
+        ids.push_back(id);
+    }
+
+    const auto container = compress(ids);
+    PEL_CHECK(holds(container, ids));
+    PEL_CHECK(container.compressed_bytes() * 8 < ids.size() * sizeof(std::uint64_t));
+}
+
+void
+random_values_of_every_range()
+{
+    std::mt19937_64 rng(2);
+
+    std::vector<std::int64_t> wide;
+    std::vector<std::int32_t> narrow;
+    std::vector<std::int8_t>  bytes;
+    for(int i = 0; i < 5000; ++i)
+    {
+        wide.push_back(static_cast<std::int64_t>(rng()));
+        narrow.push_back(static_cast<std::int32_t>(rng() % 1000) - 500);
+        bytes.push_back(static_cast<std::int8_t>(rng()));
+    }
+    wide[10]  = std::numeric_limits<std::int64_t>::min();
+    wide[11]  = std::numeric_limits<std::int64_t>::max();
+    bytes[12] = std::numeric_limits<std::int8_t>::min();
+    bytes[13] = std::numeric_limits<std::int8_t>::max();
+
+    PEL_CHECK(holds(compress(wide), wide));
+    PEL_CHECK(holds(compress(narrow), narrow));
+    PEL_CHECK(holds(compress(bytes), bytes));
+}
+
+void
+decode_block_and_pop_back()
+{
+    std::vector<std::uint32_t> values;
+    for(std::uint32_t i = 0; i < 300; ++i)
+    {
+        values.push_back(i * i);
+    }
+    auto container = compress(values);
+    PEL_CHECK(container.block_count() == 3);
+
+    std::array<std::uint32_t, 128> buffer{};
+    PEL_CHECK(container.decode_block(1, buffer) == 128);
+    PEL_CHECK(buffer[0] == 128 * 128 && buffer[127] == 255 * 255);
+    PEL_CHECK(container.decode_block(2, buffer) == 44);
+    PEL_CHECK(buffer[43] == 299 * 299);
+    PEL_CHECK_THROWS(container.decode_block(3, buffer), std::length_error);
+    std::array<std::uint32_t, 16> small{};
+    PEL_CHECK_THROWS(container.decode_block(0, small), std::length_error);
+
+    /* Popping into a compressed block decompresses it into the tail */
+    while(container.length() > 200)
+    {
+        container.pop_back();
+        values.pop_back();
+    }
+    PEL_CHECK(container.block_count() == 2);
+    PEL_CHECK(holds(container, values));
+    container.push_back(7);
+    values.push_back(7);
+    PEL_CHECK(container.back() == 7 && holds(container, values));
+
+    container.clear();
+    PEL_CHECK(container.is_empty());
+    PEL_CHECK_THROWS(container.pop_back(), std::length_error);
+    PEL_CHECK_THROWS(container.at(0), std::length_error);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"packing_round_trips_every_width", packing_round_trips_every_width},
+      {"sorted_ids_compress_with_deltas", sorted_ids_compress_with_deltas},
+      {"random_values_of_every_range", random_values_of_every_range},
+      {"decode_block_and_pop_back", decode_block_and_pop_back},
+    });
+}
@@ -0,0 +1,392 @@
+/**
+ * @file    container_base/src/test/testCowContainer.cpp
+ */
+
+#include "src/cow_container.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <forward_list>
+#include <list>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* Shared between every copy of a budget_allocator */
+struct allocation_budget
+{
+    int remaining   = 1000;
+    int outstanding = 0;
+};
+
+/* Allocator failing once its budget of allocations is spent */
+template<typename ItemType>
+struct budget_allocator
+{
+    using value_type = ItemType;
+
+    explicit budget_allocator(allocation_budget& budget_) noexcept : budget{&budget_} {}
+    template<typename OtherType>
+    budget_allocator(const budget_allocator<OtherType>& other_) noexcept : budget{other_.budget}
+    {
+    }
+
+    ItemType* allocate(std::size_t count_)
+    {
+        if(budget->remaining-- <= 0)
+        {
+            throw std::bad_alloc();
+        }
+        ++budget->outstanding;
+        return std::allocator<ItemType>{}.allocate(count_);
+    }
+    void deallocate(ItemType* items_, std::size_t count_) noexcept
+    {
+        --budget->outstanding;
+        std::allocator<ItemType>{}.deallocate(items_, count_);
+    }
+
+    template<typename OtherType>
+    bool operator==(const budget_allocator<OtherType>& other_) const noexcept
+    {
+        return budget == other_.budget;
+    }
+
+    allocation_budget* budget;
+};
+
+template<typename ContainerType>
+bool
+holds(const ContainerType& container_, const std::vector<std::string>& expected_)
+{
+    if(container_.length() != expected_.size())
+    {
+        return false;
+    }
+    for(std::size_t i = 0; i < expected_.size(); ++i)
+    {
+        if(container_[i] != expected_[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+copies_share_until_written()
+{
+    pel::cow_container<std::string> original{"a", "b", "c"};
+    pel::cow_container<std::string> copy = original;
+    PEL_CHECK(original.use_count() == 2);
+    PEL_CHECK(copy.is_shared());
+
+    const pel::cow_container<std::string>& constCopy = copy;
+    PEL_CHECK(constCopy[1] == "b");
+    PEL_CHECK(original.use_count() == 2);
+
+    copy[0] = std::string("z");
+    PEL_CHECK(original.use_count() == 1);
+    PEL_CHECK(holds(original, {"a", "b", "c"}));
+    PEL_CHECK(holds(copy, {"z", "b", "c"}));
+}
+
+void
+modifiers_unshare()
+{
+    pel::cow_container<std::string> original{"a", "b", "c"};
+    pel::cow_container<std::string> grown = original;
+    grown.push_back(grown[0]);
+    PEL_CHECK(holds(grown, {"a", "b", "c", "a"}));
+    PEL_CHECK(original.length() == 3);
+
+    pel::cow_container<std::string> shrunk = original;
+    shrunk.pop_back();
+    shrunk.clear();
+    PEL_CHECK(shrunk.is_empty());
+    PEL_CHECK(holds(original, {"a", "b", "c"}));
+
+    pel::cow_container<int> numbers(5, 7);
+    for(int i = 0; i < 100; ++i)
+    {
+        numbers.push_back(i);
+    }
+    PEL_CHECK(numbers.length() == 105);
+    PEL_CHECK(numbers[104] == 99);
+    numbers.reserve(500);
+    PEL_CHECK(numbers.capacity() == 500);
+}
+
+void
+adopt_and_release()
+{
+    std::vector<std::size_t> source(1000, 3);
+    source.reserve(2000);
+    const std::size_t* items = source.data();
+
+    pel::cow_container<std::size_t> adopted;
+    adopted.adopt(std::move(source));
+    PEL_CHECK(adopted.cbegin().ptr() == items);
+    PEL_CHECK(adopted.capacity() == 2000);
+
+    auto released = adopted.release();
+    PEL_CHECK(released.length == 1000);
+    PEL_CHECK(adopted.is_empty());
+    std::allocator<std::size_t>{}.deallocate(released.items, released.capacity);
+}
+
+void
+adopted_buffers_are_freed_by_their_owner()
+{
+    /* Adopted with a deleter: called once, when the last sharer lets go */
+    std::allocator<std::string> allocator;
+    std::string* const          items   = allocator.allocate(4);
+    int                         deletes = 0;
+    std::construct_at(items, std::string(40, 'h'));
+    std::construct_at(items + 1, "i");
+    {
+        pel::cow_container<std::string> adopted{"dropped"};
+        adopted.adopt(items, 2, 4, [&](std::string* items_) noexcept {
+            ++deletes;
+            allocator.deallocate(items_, 4);
+        });
+        PEL_CHECK(adopted.cbegin().ptr() == items && adopted.capacity() == 4);
+        PEL_CHECK(holds(adopted, {std::string(40, 'h'), "i"}));
+
+        /* Growing within the capacity keeps the adopted buffer */
+        adopted.push_back("j");
+        PEL_CHECK(adopted.cbegin().ptr() == items);
+
+        pel::cow_container<std::string> sharer = adopted;
+        adopted.clear();
+        PEL_CHECK(deletes == 0 && sharer.cbegin().ptr() == items);
+
+        /* A deleter's buffer is copied out before being released */
+        auto released = sharer.release();
+        PEL_CHECK(deletes == 1 && released.items != items && released.length == 3);
+        PEL_CHECK(released.items[2] == "j" && sharer.is_empty());
+        std::destroy_n(released.items, released.length);
+        allocator.deallocate(released.items, released.capacity);
+    }
+    PEL_CHECK(deletes == 1);
+
+    /* Adopted from the allocator: released as is */
+    std::string* const owned = allocator.allocate(3);
+    std::construct_at(owned, "only");
+    pel::cow_container<std::string> adopted;
+    adopted.adopt(owned, 1, 3);
+    PEL_CHECK_THROWS(adopted.adopt(owned, 1, 3), std::invalid_argument);
+    auto released = adopted.release();
+    PEL_CHECK(released.items == owned && released.length == 1 && released.capacity == 3);
+    std::destroy_n(released.items, released.length);
+    allocator.deallocate(released.items, released.capacity);
+
+    PEL_CHECK(adopted.release().items == nullptr);
+}
+
+void
+adopt_rejects_bad_buffers()
+{
+    pel::cow_container<int> container{1, 2};
+    int                     buffer[8] = {};
+    auto                    keep      = [](int*) noexcept {};
+
+    PEL_CHECK_THROWS(container.adopt(buffer, 5, 4, keep), std::invalid_argument);
+    PEL_CHECK_THROWS(container.adopt(nullptr, 0, 4, keep), std::invalid_argument);
+    PEL_CHECK(container.to_string() == "[1, 2]");
+
+    /* Adopting nothing empties the container */
+    container.adopt(nullptr, 0, 0, keep);
+    PEL_CHECK(container.is_empty() && container.capacity() == 0);
+    container.adopt(std::vector<int>{});
+    PEL_CHECK(container.is_empty());
+
+    /* Failing to allocate the control block still frees the buffer */
+    using container_type = pel::cow_container<int, budget_allocator<int>>;
+
+    allocation_budget budget;
+    container_type    limited{budget_allocator<int>(budget)};
+    int               deletes = 0;
+
+    budget.remaining = 0;
+    PEL_CHECK_THROWS(limited.adopt(buffer, 2, 4, [&deletes](int*) noexcept { ++deletes; }),
+                     std::bad_alloc);
+    PEL_CHECK(deletes == 1 && limited.is_empty() && budget.outstanding == 0);
+
+    /* The vector's buffer is kept, spare capacity included */
+    std::vector<int> source(10, 4);
+    source.reserve(64);
+    const int* const data = source.data();
+    container.adopt(std::move(source));
+    PEL_CHECK(container.cbegin().ptr() == data && container.capacity() == 64);
+    for(int i = 0; i < 54; ++i)
+    {
+        container.push_back(i);
+    }
+    PEL_CHECK(container.cbegin().ptr() == data && container[63] == 53);
+}
+
+/* Element whose copies throw once a shared budget is spent */
+struct throwing_copy
+{
+    static inline int s_copies = 1000;
+
+    int value;
+
+    explicit throwing_copy(int value_) : value{value_} {}
+    throwing_copy(const throwing_copy& copy_) : value{copy_.value}
+    {
+        if(--s_copies < 0)
+        {
+            throw std::runtime_error("Copy failed");
+        }
+    }
+    throwing_copy& operator=(const throwing_copy&) = default;
+};
+
+void
+ranges()
+{
+    const std::vector<int>  source{1, 2, 3, 4, 5};
+    pel::cow_container<int> numbers(pel::from_range, source);
+    pel::cow_container<int> shared = numbers;
+
+    numbers.insert_range(1, std::vector<int>{9, 9});
+    numbers.append_range(source);
+    PEL_CHECK(numbers.length() == 12);
+    PEL_CHECK(numbers[1] == 9 && numbers[3] == 2 && numbers[11] == 5);
+    PEL_CHECK(shared.length() == 5);
+    PEL_CHECK_THROWS(numbers.insert_range(100, source), std::length_error);
+
+    numbers.assign_range(std::vector<int>{4, 5});
+    PEL_CHECK(numbers.length() == 2 && numbers[0] == 4);
+}
+
+void
+ranges_of_every_category()
+{
+    const std::vector<int> source{1, 2, 3, 4, 5};
+
+    /* Sized or forward ranges are allocated for once */
+    const auto              twice = [](int item_) { return 2 * item_; };
+    pel::cow_container<int> doubled(pel::from_range, source | std::views::transform(twice));
+    PEL_CHECK(doubled.to_string() == "[2, 4, 6, 8, 10]" && doubled.capacity() == 5);
+    const pel::cow_container<int> listed(pel::from_range, std::forward_list<int>{7, 8, 9});
+    PEL_CHECK(listed.to_string() == "[7, 8, 9]" && listed.capacity() == 3);
+
+    /* Input ranges grow as they are read */
+    std::istringstream      text("1 2 3 4 5 6 7 8 9 10");
+    pel::cow_container<int> read(pel::from_range, std::ranges::istream_view<int>(text));
+    PEL_CHECK(read.length() == 10 && read.back() == 10);
+
+    const pel::cow_container<int> shared = read;
+    std::istringstream            more("-1 -2");
+    read.insert_range(0, std::ranges::istream_view<int>(more));
+    read.insert_range(read.length(), std::span<const int>(source.data(), 2));
+    read.append_range(std::list<int>{0});
+    PEL_CHECK(read.to_string() == "[-1, -2, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 1, 2, 0]");
+    PEL_CHECK(shared.length() == 10 && shared.front() == 1);
+
+    /* Empty ranges */
+    pel::cow_container<int> empty(pel::from_range, std::vector<int>{});
+    PEL_CHECK(empty.is_empty() && empty.capacity() == 0);
+    empty.insert_range(0, std::vector<int>{});
+    std::istringstream nothing;
+    empty.append_range(std::ranges::istream_view<int>(nothing));
+    PEL_CHECK(empty.is_empty());
+
+    pel::cow_container<std::string> words(pel::from_range, std::vector<std::string>{"a", "b"});
+    words.insert_range(1, std::vector<std::string>{std::string(40, 'x'), "y"});
+    PEL_CHECK(holds(words, {"a", std::string(40, 'x'), "y", "b"}));
+    words.assign_range(std::vector<std::string>{"c", "d"} | std::views::reverse);
+    PEL_CHECK(holds(words, {"d", "c"}));
+}
+
+void
+failed_range_insertion_changes_nothing()
+{
+    std::vector<throwing_copy> source;
+    for(int i = 0; i < 10; ++i)
+    {
+        source.emplace_back(i);
+    }
+
+    const auto unchanged = [&source](const pel::cow_container<throwing_copy>& container_) {
+        bool same = container_.length() == source.size();
+        for(std::size_t i = 0; same && i < source.size(); ++i)
+        {
+            same = container_[i].value == source[i].value;
+        }
+        return same;
+    };
+
+    pel::cow_container<throwing_copy> container(pel::from_range, source);
+    for(int copies = 0; copies < 10; copies += 3)
+    {
+        throwing_copy::s_copies = copies;
+        PEL_CHECK_THROWS(container.append_range(source), std::runtime_error);
+        PEL_CHECK(unchanged(container));
+
+        throwing_copy::s_copies = copies;
+        PEL_CHECK_THROWS(container.insert_range(3, source), std::runtime_error);
+        PEL_CHECK(unchanged(container));
+    }
+    throwing_copy::s_copies = 1000;
+}
+
+void
+failed_reallocation_changes_nothing()
+{
+    using container_type = pel::cow_container<std::string, budget_allocator<std::string>>;
+
+    allocation_budget budget;
+    {
+        container_type owner({"a", "b", "c"}, budget_allocator<std::string>(budget));
+        container_type sharer = owner;
+        const int      before = budget.outstanding;
+
+        /* Out of memory for the control block, then for the element buffer */
+        for(int remaining = 0; remaining < 2; ++remaining)
+        {
+            budget.remaining = remaining;
+            PEL_CHECK_THROWS(sharer.push_back("d"), std::bad_alloc);
+            PEL_CHECK(budget.outstanding == before);
+            PEL_CHECK(sharer.use_count() == 2);
+            PEL_CHECK(holds(sharer, {"a", "b", "c"}));
+
+            budget.remaining = remaining;
+            PEL_CHECK_THROWS(owner.reserve(10), std::bad_alloc);
+            PEL_CHECK(budget.outstanding == before);
+            PEL_CHECK(holds(owner, {"a", "b", "c"}));
+        }
+
+        budget.remaining = 1000;
+        sharer.push_back("d");
+        PEL_CHECK(holds(sharer, {"a", "b", "c", "d"}));
+    }
+    PEL_CHECK(budget.outstanding == 0);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"copies_share_until_written", copies_share_until_written},
+      {"modifiers_unshare", modifiers_unshare},
+      {"adopt_and_release", adopt_and_release},
+      {"adopted_buffers_are_freed_by_their_owner", adopted_buffers_are_freed_by_their_owner},
+      {"adopt_rejects_bad_buffers", adopt_rejects_bad_buffers},
+      {"ranges", ranges},
+      {"ranges_of_every_category", ranges_of_every_category},
+      {"failed_range_insertion_changes_nothing", failed_range_insertion_changes_nothing},
+      {"failed_reallocation_changes_nothing", failed_reallocation_changes_nothing},
+    });
+}
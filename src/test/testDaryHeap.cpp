@@ -0,0 +1,218 @@
+/**
+ * @file    container_base/src/test/testDaryHeap.cpp
+ */
+
+#include "src/dary_heap.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+template<std::size_t Arity>
+void
+check_against_priority_queue()
+{
+    pel::dary_heap<int, Arity> heap;
+    std::priority_queue<int>   expected;
+
+    std::mt19937 rng(Arity);
+    for(int step = 0; step < 20000; ++step)
+    {
+        if(expected.empty() || rng() % 3 != 0)
+        {
+            const int value = static_cast<int>(rng() % 1000);
+            heap.push(value);
+            expected.push(value);
+        }
+        else
+        {
+            PEL_CHECK(heap.top() == expected.top());
+            heap.pop();
+            expected.pop();
+        }
+        PEL_CHECK(heap.length() == expected.size());
+    }
+
+    while(expected.empty() == false)
+    {
+        PEL_CHECK(heap.top() == expected.top());
+        heap.pop();
+        expected.pop();
+    }
+    PEL_CHECK(heap.is_empty());
+}
+
+void
+pops_in_priority_order()
+{
+    check_against_priority_queue<2>();
+    check_against_priority_queue<4>();
+    check_against_priority_queue<8>();
+
+    pel::dary_heap<int, 4, std::greater<int>> minHeap{5, 3, 9, 1, 7};
+    PEL_CHECK(minHeap.top() == 1);
+    minHeap.pop();
+    PEL_CHECK(minHeap.top() == 3);
+}
+
+void
+handles_follow_their_elements()
+{
+    using heap_type = pel::dary_heap<int, 4, std::greater<int>, true>;
+
+    heap_type                     heap;
+    std::vector<pel::slot_handle> handles;
+    std::map<std::size_t, int>    expected;
+    std::mt19937                  rng(7);
+    for(std::size_t i = 0; i < 2000; ++i)
+    {
+        const int value = static_cast<int>(rng() % 100000);
+        handles.push_back(heap.push(value));
+        expected[i] = value;
+    }
+
+    for(int step = 0; step < 3000; ++step)
+    {
+        const std::size_t victim = rng() % handles.size();
+        const bool        alive  = expected.contains(victim);
+        PEL_CHECK(heap.contains(handles[victim]) == alive);
+
+        switch(rng() % 3)
+        {
+            case 0:
+                if(alive)
+                {
+                    expected[victim] -= static_cast<int>(rng() % 1000);
+                    heap.decrease_key(handles[victim], expected[victim]);
+                }
+                break;
+            case 1:
+                if(alive)
+                {
+                    expected[victim] = static_cast<int>(rng() % 100000);
+                    heap.update(handles[victim], expected[victim]);
+                }
+                break;
+            default:
+                PEL_CHECK(heap.erase(handles[victim]) == alive);
+                expected.erase(victim);
+                break;
+        }
+    }
+
+    PEL_CHECK(heap.length() == expected.size());
+    for(std::size_t i = 0; i < handles.size(); ++i)
+    {
+        const auto it = expected.find(i);
+        PEL_CHECK(it == expected.end() || heap.at(handles[i]) == it->second);
+        PEL_CHECK(it != expected.end() || heap.get(handles[i]) == nullptr);
+    }
+
+    while(heap.is_empty() == false)
+    {
+        const pel::slot_handle top   = heap.top_handle();
+        std::size_t            owner = handles.size();
+        for(std::size_t i = 0; i < handles.size(); ++i)
+        {
+            if(handles[i] == top)
+            {
+                owner = i;
+            }
+        }
+        PEL_CHECK(owner < handles.size() && heap.top() == expected[owner]);
+        for(const auto& [index, value] : expected)
+        {
+            PEL_CHECK(heap.top() <= value);
+        }
+
+        expected.erase(owner);
+        heap.pop();
+        PEL_CHECK(heap.contains(top) == false);
+    }
+    PEL_CHECK(expected.empty());
+
+    PEL_CHECK_THROWS(heap.at(handles[0]), std::out_of_range);
+    PEL_CHECK_THROWS(heap.decrease_key(handles[0], 0), std::out_of_range);
+    PEL_CHECK_THROWS(heap.pop(), std::length_error);
+}
+
+void
+push_range_returns_handles()
+{
+    std::vector<int> values;
+    for(int i = 0; i < 500; ++i)
+    {
+        values.push_back((i * 37) % 500);
+    }
+
+    pel::dary_heap<int> plain{1, 2};
+    plain.push_range(values);
+    PEL_CHECK(plain.length() == 502);
+    int previous = plain.top();
+    while(plain.is_empty() == false)
+    {
+        PEL_CHECK(plain.top() <= previous);
+        previous = plain.top();
+        plain.pop();
+    }
+
+    pel::dary_heap<int, 8, std::less<int>, true> tracked;
+    tracked.push(10000);
+    std::vector<pel::slot_handle> handles;
+    tracked.push_range(values, std::back_inserter(handles));
+    PEL_CHECK(handles.size() == values.size());
+    for(std::size_t i = 0; i < handles.size(); ++i)
+    {
+        PEL_CHECK(tracked.at(handles[i]) == values[i]);
+    }
+    PEL_CHECK(tracked.top() == 10000);
+}
+
+void
+copies_keep_handles_and_clear_drops_them()
+{
+    pel::dary_heap<std::string, 4, std::less<std::string>, true> heap;
+    const pel::slot_handle first  = heap.push("alpha");
+    const pel::slot_handle second = heap.push(std::string(40, 'z'));
+
+    auto copy = heap;
+    PEL_CHECK(copy.at(first) == "alpha");
+    PEL_CHECK(copy.top_handle() == second);
+
+    auto moved = std::move(copy);
+    PEL_CHECK(moved.at(second) == std::string(40, 'z'));
+    PEL_CHECK(copy.is_empty() && copy.contains(first) == false);
+
+    heap.clear();
+    PEL_CHECK(heap.is_empty());
+    PEL_CHECK(heap.contains(first) == false && heap.contains(second) == false);
+    PEL_CHECK(moved.contains(first));
+
+    /* Freed slots are reused with a new generation */
+    const pel::slot_handle reused = heap.push("beta");
+    PEL_CHECK(reused != first && reused != second);
+    PEL_CHECK(heap.contains(first) == false);
+    PEL_CHECK(heap.at(reused) == "beta");
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"pops_in_priority_order", pops_in_priority_order},
+      {"handles_follow_their_elements", handles_follow_their_elements},
+      {"push_range_returns_handles", push_range_returns_handles},
+      {"copies_keep_handles_and_clear_drops_them", copies_keep_handles_and_clear_drops_them},
+    });
+}
@@ -0,0 +1,267 @@
+/**
+ * @file    container_base/src/test/testDeque.cpp
+ */
+
+#include "src/deque.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+std::size_t g_allocations = 0;
+
+template<typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator() = default;
+    template<typename U>
+    counting_allocator(const counting_allocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n_)
+    {
+        ++g_allocations;
+        return std::allocator<T>{}.allocate(n_);
+    }
+    void deallocate(T* p_, std::size_t n_) noexcept { std::allocator<T>{}.deallocate(p_, n_); }
+
+    template<typename U>
+    bool operator==(const counting_allocator<U>&) const noexcept
+    {
+        return true;
+    }
+};
+
+template<typename DequeType, typename ExpectedType>
+bool
+same_elements(const DequeType& deque_, const ExpectedType& expected_)
+{
+    if(deque_.length() != expected_.size())
+    {
+        return false;
+    }
+    for(std::size_t i = 0; i < expected_.size(); ++i)
+    {
+        if(deque_[i] != expected_[i] || deque_.at(i) != expected_[i])
+        {
+            return false;
+        }
+    }
+    return std::equal(deque_.begin(), deque_.end(), expected_.begin())
+           && std::equal(deque_.rbegin(), deque_.rend(), expected_.rbegin());
+}
+
+void
+matches_std_deque()
+{
+    /* Chunks of 4 elements, so that every operation crosses chunks and grows the map */
+    pel::deque<std::string, std::allocator<std::string>, 2> deque;
+    std::deque<std::string>                                 expected;
+
+    std::mt19937 rng(3);
+    for(int step = 0; step < 20000; ++step)
+    {
+        const std::size_t padding = static_cast<std::size_t>(step % 40);
+        const std::string value   = std::to_string(step) + std::string(padding, 'x');
+        switch(rng() % 5)
+        {
+            case 0:
+                deque.push_back(value);
+                expected.push_back(value);
+                break;
+            case 1:
+                deque.push_front(value);
+                expected.push_front(value);
+                break;
+            case 2:
+                if(expected.empty() == false)
+                {
+                    deque.pop_back();
+                    expected.pop_back();
+                }
+                break;
+            case 3:
+                if(expected.empty() == false)
+                {
+                    deque.pop_front();
+                    expected.pop_front();
+                }
+                break;
+            default:
+                deque.emplace_back(std::size_t{3}, 'e');
+                expected.emplace_back(std::size_t{3}, 'e');
+                break;
+        }
+        PEL_CHECK(deque.length() == expected.size());
+        PEL_CHECK(expected.empty() || (deque.front() == expected.front()
+                                       && deque.back() == expected.back()));
+    }
+    PEL_CHECK(same_elements(deque, expected));
+}
+
+void
+references_survive_pushes_at_both_ends()
+{
+    pel::deque<int, std::allocator<int>, 3> deque;
+    deque.push_back(0);
+    int* const first = &deque.front();
+
+    for(int i = 1; i < 5000; ++i)
+    {
+        deque.push_back(i);
+        deque.push_front(-i);
+    }
+    PEL_CHECK(first == &deque[4999]);
+    PEL_CHECK(*first == 0);
+
+    for(int i = 0; i < 4000; ++i)
+    {
+        deque.pop_front();
+        deque.pop_back();
+    }
+    PEL_CHECK(first == &deque[999]);
+    PEL_CHECK(deque.front() == -999 && deque.back() == 999);
+}
+
+void
+iterators_are_random_access()
+{
+    pel::deque<int, std::allocator<int>, 2> deque;
+    for(int i = 0; i < 100; ++i)
+    {
+        deque.push_back(i);
+    }
+
+    auto it = deque.begin();
+    it += 37;
+    PEL_CHECK(*it == 37 && it[5] == 42);
+    PEL_CHECK((it - 30)[0] == 7 && *(3 + it) == 40);
+    PEL_CHECK(it - deque.begin() == 37 && deque.end() - it == 63);
+    PEL_CHECK(it < deque.end() && deque.begin() <= it && it != deque.begin());
+    PEL_CHECK(deque.iterator_at(37) == it);
+    PEL_CHECK(*--it == 36 && *it++ == 36 && *it == 37);
+
+    pel::deque<int, std::allocator<int>, 2>::ConstIteratorType constIt = it;
+    PEL_CHECK(constIt == deque.cbegin() + 37);
+
+    std::vector<int> reversed(deque.rbegin(), deque.rend());
+    PEL_CHECK(reversed.size() == 100 && reversed.front() == 99 && reversed.back() == 0);
+}
+
+void
+segmented_algorithms_visit_every_element()
+{
+    pel::deque<int, std::allocator<int>, 3> deque;
+    for(int i = 0; i < 50; ++i)
+    {
+        deque.push_front(i);
+    }
+
+    std::vector<int> segments;
+    std::size_t      segmentCount = 0;
+    deque.for_each_segment([&](std::span<int> span_) {
+        PEL_CHECK(span_.size() <= decltype(deque)::chunk_size);
+        segments.insert(segments.end(), span_.begin(), span_.end());
+        ++segmentCount;
+    });
+    PEL_CHECK(segments == std::vector<int>(deque.begin(), deque.end()));
+    PEL_CHECK(segmentCount >= 50 / decltype(deque)::chunk_size);
+
+    int sum = 0;
+    pel::for_each(deque.begin() + 3, deque.end() - 4, [&sum](int value_) { sum += value_; });
+    int expectedSum = 0;
+    for(std::size_t i = 3; i < 46; ++i)
+    {
+        expectedSum += deque[i];
+    }
+    PEL_CHECK(sum == expectedSum);
+
+    std::vector<int> copied(43);
+    PEL_CHECK(pel::copy(deque.cbegin() + 3, deque.cend() - 4, copied.begin()) == copied.end());
+    PEL_CHECK(std::equal(copied.begin(), copied.end(), deque.begin() + 3));
+}
+
+void
+steady_queue_does_not_allocate()
+{
+    pel::deque<int, counting_allocator<int>, 4> deque;
+    for(int i = 0; i < 100; ++i)
+    {
+        deque.push_back(i);
+    }
+
+    /* The first chunk crossed allocates; the chunk emptied at the front is then reused */
+    for(int i = 0; i < 32; ++i)
+    {
+        deque.pop_front();
+        deque.push_back(i);
+    }
+    g_allocations = 0;
+    for(int i = 0; i < 100000; ++i)
+    {
+        deque.pop_front();
+        deque.push_back(i);
+    }
+    PEL_CHECK(g_allocations == 0);
+    PEL_CHECK(deque.length() == 100 && deque.back() == 99999);
+
+    deque.clear();
+    PEL_CHECK(deque.is_empty());
+    deque.shrink_to_fit();
+    PEL_CHECK(deque.chunk_count() <= 1);
+}
+
+void
+copies_comparisons_and_errors()
+{
+    pel::deque<std::string> deque{"a", "b", "c"};
+    pel::deque<std::string> copy = deque;
+    PEL_CHECK(copy == deque && (copy < deque) == false && copy <= deque);
+
+    copy.push_back("d");
+    PEL_CHECK(copy != deque && deque < copy && copy > deque);
+
+    pel::deque<std::string> moved = std::move(copy);
+    PEL_CHECK(moved.length() == 4 && copy.is_empty());
+    copy = moved;
+    PEL_CHECK(copy == moved);
+
+    const std::vector<std::string> source{"x", "y"};
+    pel::deque<std::string>        ranged(source.begin(), source.end());
+    PEL_CHECK(ranged.length() == 2 && ranged.back() == "y");
+    PEL_CHECK(ranged.to_string() == "[x, y]");
+
+    pel::deque<int> empty;
+    PEL_CHECK_THROWS(empty.at(0), std::length_error);
+    PEL_CHECK_THROWS(empty.front(), std::length_error);
+    PEL_CHECK_THROWS(empty.pop_back(), std::length_error);
+    PEL_CHECK_THROWS(deque.at(3), std::length_error);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"matches_std_deque", matches_std_deque},
+      {"references_survive_pushes_at_both_ends", references_survive_pushes_at_both_ends},
+      {"iterators_are_random_access", iterators_are_random_access},
+      {"segmented_algorithms_visit_every_element", segmented_algorithms_visit_every_element},
+      {"steady_queue_does_not_allocate", steady_queue_does_not_allocate},
+      {"copies_comparisons_and_errors", copies_comparisons_and_errors},
+    });
+}
@@ -0,0 +1,120 @@
+/**
+ * @file    container_base/src/test/testErase.cpp
+ */
+
+#include "src/cow_container.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct pair_of_shorts
+{
+    std::int16_t first  = 0;
+    std::int16_t second = 0;
+
+    bool operator==(const pair_of_shorts&) const = default;
+};
+
+/* make_ builds the element of an index, which index_of_ gives back */
+template<typename ItemType, typename MakeType, typename IndexOfType>
+void
+check_erase_if(MakeType make_, IndexOfType index_of_)
+{
+    std::mt19937 rng(11);
+
+    /* Lengths around the block sizes, so that both the blocks and the tail are exercised */
+    const std::vector<std::size_t> lengths{0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 100, 4099};
+    for(const std::size_t length : lengths)
+    {
+        for(unsigned percent : {0u, 10u, 50u, 90u, 100u})
+        {
+            std::vector<ItemType> items;
+            std::vector<bool>     erased;
+            for(std::size_t i = 0; i < length; ++i)
+            {
+                items.push_back(make_(i));
+                erased.push_back(rng() % 100 < percent);
+            }
+            const auto isErased = [&](const ItemType& item_) { return erased[index_of_(item_)]; };
+
+            pel::cow_container<ItemType> container;
+            for(const ItemType& item : items)
+            {
+                container.push_back(item);
+            }
+            const auto kept = std::ranges::remove_if(items, isErased).begin();
+            items.erase(kept, items.end());
+
+            PEL_CHECK(container.erase_if(isErased) == length - items.size());
+            PEL_CHECK(std::equal(container.begin(), container.end(), items.begin(), items.end()));
+        }
+    }
+}
+
+void
+erase_if_matches_remove_if()
+{
+    check_erase_if<int>([](std::size_t i_) { return static_cast<int>(i_) * 3 - 7; },
+                        [](int item_) { return static_cast<std::size_t>((item_ + 7) / 3); });
+    check_erase_if<std::uint64_t>([](std::size_t i_) { return (std::uint64_t{i_} << 33) | 1; },
+                                  [](std::uint64_t item_) { return item_ >> 33; });
+    check_erase_if<float>([](std::size_t i_) { return static_cast<float>(i_) + 0.5f; },
+                          [](float item_) { return static_cast<std::size_t>(item_); });
+    check_erase_if<pair_of_shorts>(
+      [](std::size_t i_) {
+          return pair_of_shorts{static_cast<std::int16_t>(i_), static_cast<std::int16_t>(-1)};
+      },
+      [](const pair_of_shorts& item_) { return static_cast<std::size_t>(item_.first); });
+    check_erase_if<std::string>(
+      [](std::size_t i_) { return std::to_string(i_) + std::string(30, 'a'); },
+      [](const std::string& item_) { return std::stoul(item_); });
+}
+
+void
+erase_if_on_a_shared_buffer_leaves_the_copy()
+{
+    pel::cow_container<int> container{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17};
+    const pel::cow_container<int> copy = container;
+
+    PEL_CHECK(container.erase_if([](int item_) { return item_ % 3 == 0; }) == 5);
+    PEL_CHECK(container.to_string() == "[1, 2, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17]");
+    PEL_CHECK(copy.length() == 17 && copy[16] == 17);
+}
+
+void
+erase_indices_and_swap_erase()
+{
+    pel::cow_container<std::string> container{"a", "b", "c", "d", "e", "f"};
+    PEL_CHECK(container.erase_indices(std::vector<std::size_t>{0, 2, 3}) == 3);
+    PEL_CHECK(container.to_string() == "[b, e, f]");
+    PEL_CHECK(container.erase_indices(std::vector<std::size_t>{}) == 0);
+
+    PEL_CHECK_THROWS(container.erase_indices(std::vector<std::size_t>{1, 1}),
+                     std::invalid_argument);
+    PEL_CHECK_THROWS(container.erase_indices(std::vector<std::size_t>{3}), std::length_error);
+    PEL_CHECK(container.length() == 3);
+
+    container.swap_erase(0);
+    PEL_CHECK(container.to_string() == "[f, e]");
+    PEL_CHECK_THROWS(container.swap_erase(2), std::length_error);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"erase_if_matches_remove_if", erase_if_matches_remove_if},
+      {"erase_if_on_a_shared_buffer_leaves_the_copy", erase_if_on_a_shared_buffer_leaves_the_copy},
+      {"erase_indices_and_swap_erase", erase_indices_and_swap_erase},
+    });
+}
@@ -0,0 +1,199 @@
+/**
+ * @file    container_base/src/test/testFlatHashTable.cpp
+ */
+
+#include "src/flat_hash_map.hpp"
+#include "src/flat_hash_set.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+/* Value whose copies throw once a budget is spent, and whose move may throw */
+struct fragile
+{
+    static inline int copyBudget = 1'000'000;
+
+    explicit fragile(int value_) : value{value_} {}
+    fragile(const fragile& other_) : value{other_.value}
+    {
+        if(--copyBudget < 0)
+        {
+            throw std::runtime_error("copy");
+        }
+    }
+    fragile(fragile&& other_) : value{other_.value} { other_.value = -1; }
+    fragile& operator=(const fragile&) = default;
+    fragile& operator=(fragile&&)      = default;
+    ~fragile()                         = default;
+
+    int value = 0;
+};
+
+struct string_hash
+{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view key_) const noexcept
+    {
+        return std::hash<std::string_view>{}(key_);
+    }
+};
+
+struct string_equal
+{
+    using is_transparent = void;
+    bool operator()(std::string_view lhs_, std::string_view rhs_) const noexcept
+    {
+        return lhs_ == rhs_;
+    }
+};
+
+void
+matches_unordered_map()
+{
+    pel::flat_hash_map<int, int>  map;
+    std::unordered_map<int, int>  reference;
+    std::mt19937                  random(1);
+    bool                          matches = true;
+
+    for(int round = 0; round < 50'000; ++round)
+    {
+        const int key = static_cast<int>(random() % 2000);
+        switch(random() % 4)
+        {
+            case 0:
+            case 1:
+                map[key]       = round;
+                reference[key] = round;
+                break;
+            case 2:
+                matches = matches && map.erase(key) == reference.erase(key);
+                break;
+            default:
+                matches = matches && map.contains(key) == (reference.count(key) == 1);
+                break;
+        }
+        matches = matches && map.length() == reference.size();
+    }
+    PEL_CHECK(matches);
+
+    std::size_t visited = 0;
+    for(const auto& [key, value] : map)
+    {
+        matches = matches && reference.at(key) == value;
+        ++visited;
+    }
+    PEL_CHECK(matches);
+    PEL_CHECK(visited == reference.size());
+}
+
+void
+copy_move_and_compare()
+{
+    pel::flat_hash_map<int, int> map{{1, 10}, {2, 20}};
+    auto                         copy = map;
+    PEL_CHECK(copy == map);
+    copy[3] = 30;
+    PEL_CHECK(!(copy == map));
+
+    auto moved = std::move(copy);
+    PEL_CHECK(moved.length() == 3);
+    PEL_CHECK(moved.at(3) == 30);
+    PEL_CHECK_THROWS(moved.at(4), std::out_of_range);
+
+    map.clear();
+    PEL_CHECK(map.is_empty());
+    PEL_CHECK(map.begin() == map.end());
+}
+
+void
+heterogeneous_lookup()
+{
+    pel::flat_hash_map<std::string, int, string_hash, string_equal> map{{"a", 1}, {"bb", 2}};
+    PEL_CHECK(map.at(std::string_view("bb")) == 2);
+    PEL_CHECK(map.count(std::string_view("zz")) == 0);
+
+    map.insert_or_assign("a", 5);
+    PEL_CHECK(map.at("a") == 5);
+    PEL_CHECK(map.try_emplace("c", 3).second);
+    PEL_CHECK(!map.try_emplace("c", 4).second);
+    PEL_CHECK(map.erase(std::string_view("a")) == 1);
+}
+
+void
+set_reserve_and_rehash()
+{
+    pel::flat_hash_set<int> set;
+    set.reserve(10'000);
+    const std::size_t capacity = set.capacity();
+    for(int i = 0; i < 10'000; ++i)
+    {
+        set.insert(i);
+    }
+    PEL_CHECK(set.capacity() == capacity);
+
+    for(int i = 0; i < 10'000; i += 2)
+    {
+        set.erase(i);
+    }
+    set.rehash(0);
+    PEL_CHECK(set.length() == 5000);
+    PEL_CHECK(set.contains(1) && !set.contains(2));
+}
+
+void
+throwing_copy_during_resize()
+{
+    pel::flat_hash_map<int, fragile> map;
+    int                              key = 0;
+    for(; map.length() < 14; ++key)
+    {
+        map.try_emplace(key, key);
+    }
+
+    /* Inserting until the table grows, with copies failing partway through the resize */
+    const std::size_t capacity = map.capacity();
+    fragile::copyBudget        = 3;
+    bool threw                 = false;
+    try
+    {
+        for(; map.capacity() == capacity; ++key)
+        {
+            map.try_emplace(key, key);
+        }
+    }
+    catch(const std::runtime_error&)
+    {
+        threw = true;
+    }
+    fragile::copyBudget = 1'000'000;
+
+    PEL_CHECK(threw);
+    PEL_CHECK(map.capacity() == capacity);
+    bool intact = true;
+    for(int i = 0; i < key; ++i)
+    {
+        intact = intact && map.contains(i) && map.at(i).value == i;
+    }
+    PEL_CHECK(intact);
+    PEL_CHECK(static_cast<int>(map.length()) == key);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"matches_unordered_map", matches_unordered_map},
+      {"copy_move_and_compare", copy_move_and_compare},
+      {"heterogeneous_lookup", heterogeneous_lookup},
+      {"set_reserve_and_rehash", set_reserve_and_rehash},
+      {"throwing_copy_during_resize", throwing_copy_during_resize},
+    });
+}
@@ -0,0 +1,179 @@
+/**
+ * @file    container_base/src/test/testFlatSortedTable.cpp
+ */
+
+#include "src/flat_map.hpp"
+#include "src/flat_set.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+template<pel::flat_layout Layout>
+using int_set = pel::flat_set<int, std::less<>, std::allocator<int>, Layout>;
+
+template<pel::flat_layout Layout>
+void
+matches_std_set()
+{
+    std::mt19937    random(7);
+    int_set<Layout> set;
+    std::set<int>   reference;
+    bool            matches = true;
+
+    for(int round = 0; round < 20'000; ++round)
+    {
+        const int key = static_cast<int>(random() % 3000);
+        switch(random() % 5)
+        {
+            case 0:
+            case 1:
+                matches = matches && set.insert(key).second == reference.insert(key).second;
+                break;
+            case 2:
+                matches = matches && set.erase(key) == reference.erase(key);
+                break;
+            default:
+            {
+                matches         = matches && set.contains(key) == (reference.count(key) == 1);
+                const auto lower = set.lower_bound(key);
+                const auto upper = set.upper_bound(key);
+                const auto expectedLower = reference.lower_bound(key);
+                const auto expectedUpper = reference.upper_bound(key);
+                matches = matches && (lower == set.end()) == (expectedLower == reference.end());
+                matches = matches && (upper == set.end()) == (expectedUpper == reference.end());
+                matches = matches && (lower == set.end() || *lower == *expectedLower);
+                matches = matches && (upper == set.end() || *upper == *expectedUpper);
+            }
+        }
+        matches = matches && set.length() == reference.size();
+    }
+    PEL_CHECK(matches);
+    PEL_CHECK(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+
+    std::vector<int> batch;
+    for(int i = 0; i < 5000; ++i)
+    {
+        batch.push_back(static_cast<int>(random() % 10'000));
+    }
+    set.insert(batch.begin(), batch.end());
+    reference.insert(batch.begin(), batch.end());
+    PEL_CHECK(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+    PEL_CHECK(set.contains(1L) == (reference.count(1) == 1));
+}
+
+template<pel::flat_layout Layout>
+void
+copy_and_clear()
+{
+    int_set<Layout> set{5, 3, 1, 3};
+    PEL_CHECK(set.length() == 3);
+    PEL_CHECK(set[0] == 1 && set[2] == 5);
+
+    int_set<Layout> copy = set;
+    PEL_CHECK(copy == set);
+    copy.erase(copy.begin());
+    PEL_CHECK(!(copy == set));
+    PEL_CHECK(!copy.contains(1) && copy.contains(3));
+
+    copy = set;
+    copy.clear();
+    PEL_CHECK(copy.is_empty());
+    PEL_CHECK(!copy.contains(1));
+
+    set.shrink_to_fit();
+    PEL_CHECK(set.capacity() == set.length());
+}
+
+void
+map_access()
+{
+    pel::flat_map<std::string, int> map{{"b", 2}, {"a", 1}, {"b", 3}};
+    PEL_CHECK(map.length() == 2);
+    PEL_CHECK(map[0].first == "a");
+    PEL_CHECK(map.at_key("b") == 2);
+
+    map.insert_or_assign("b", 9);
+    PEL_CHECK(map.at_key("b") == 9);
+    PEL_CHECK(map.try_emplace("c", 3).second);
+    PEL_CHECK(!map.try_emplace("c", 4).second);
+}
+
+void
+eytzinger_single_inserts_stay_linear()
+{
+    using map_type = pel::flat_map<int,
+                                   int,
+                                   std::less<int>,
+                                   std::allocator<std::pair<int, int>>,
+                                   pel::flat_layout::eytzinger>;
+
+    /* Ascending keys are appended without shifting anything, so only index rebuilds could make
+     * this quadratic */
+    constexpr int count = 200'000;
+    map_type      map;
+    map.reserve(count);
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 1; i <= count; ++i)
+    {
+        map.try_emplace(i, i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    PEL_CHECK(map.length() == count);
+    PEL_CHECK(map.find(count / 2)->second == count / 2);
+    PEL_CHECK(map.find(0) == map.end());
+    PEL_CHECK(elapsed < std::chrono::seconds(5));
+}
+
+void
+eytzinger_concurrent_lookups_after_insert()
+{
+    int_set<pel::flat_layout::eytzinger> set;
+    for(int i = 0; i < 10'000; ++i)
+    {
+        set.insert(i * 2);
+    }
+
+    std::vector<std::thread> readers;
+    std::vector<int>         found(4, 0);
+    for(std::size_t r = 0; r < found.size(); ++r)
+    {
+        readers.emplace_back([&, r] {
+            for(int i = 0; i < 20'000; ++i)
+            {
+                found[r] += set.contains(i) ? 1 : 0;
+            }
+        });
+    }
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    PEL_CHECK(std::all_of(found.begin(), found.end(), [](int count_) { return count_ == 10'000; }));
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"sorted_matches_std_set", matches_std_set<pel::flat_layout::sorted>},
+      {"eytzinger_matches_std_set", matches_std_set<pel::flat_layout::eytzinger>},
+      {"sorted_copy_and_clear", copy_and_clear<pel::flat_layout::sorted>},
+      {"eytzinger_copy_and_clear", copy_and_clear<pel::flat_layout::eytzinger>},
+      {"map_access", map_access},
+      {"eytzinger_single_inserts_stay_linear", eytzinger_single_inserts_stay_linear},
+      {"eytzinger_concurrent_lookups_after_insert", eytzinger_concurrent_lookups_after_insert},
+    });
+}
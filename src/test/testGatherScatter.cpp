@@ -0,0 +1,196 @@
+/**
+ * @file    container_base/src/test/testGatherScatter.cpp
+ */
+
+#include "src/cow_container.hpp"
+#include "src/gather_scatter.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct no_default
+{
+    int value;
+
+    explicit no_default(int value_) : value{value_} {}
+    bool operator==(const no_default&) const = default;
+};
+
+template<typename ItemType, typename IndexType>
+void
+check_gather(std::size_t prefetchDistance_)
+{
+    pel::cow_container<ItemType> source;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        source.push_back(static_cast<ItemType>(i * 7 + 1));
+    }
+
+    /* Lengths around the vector widths, so that both the vectors and the tail are exercised */
+    std::mt19937 rng(static_cast<unsigned>(sizeof(ItemType) + sizeof(IndexType)));
+    const std::vector<std::size_t> counts{0, 1, 3, 4, 8, 15, 16, 17, 100, 1001};
+    for(const std::size_t count : counts)
+    {
+        std::vector<IndexType> indices;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            indices.push_back(static_cast<IndexType>(rng() % source.length()));
+        }
+
+        std::vector<ItemType> output(count);
+        PEL_CHECK(pel::gather(source, indices, output.begin(), prefetchDistance_) == output.end());
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            PEL_CHECK(output[i] == source[static_cast<std::size_t>(indices[i])]);
+        }
+        PEL_CHECK(pel::take(source, indices, prefetchDistance_) == output);
+    }
+}
+
+void
+gather_matches_indexing()
+{
+    const std::vector<std::size_t> distances{0, 1, 16, 5000};
+    for(const std::size_t distance : distances)
+    {
+        check_gather<std::int32_t, std::int32_t>(distance);
+        check_gather<std::int32_t, std::uint64_t>(distance);
+        check_gather<std::uint64_t, std::uint32_t>(distance);
+        check_gather<double, std::int64_t>(distance);
+        check_gather<std::uint16_t, std::size_t>(distance);
+    }
+
+    /* Through a list: neither the indices nor the output are contiguous */
+    const pel::cow_container<std::string> words{"zero", "one", "two", "three"};
+    const std::vector<int>                indices{3, 0, 3, 1};
+    std::list<std::string>                output;
+    pel::gather(words, indices, std::back_inserter(output));
+    PEL_CHECK((output == std::list<std::string>{"three", "zero", "three", "one"}));
+}
+
+void
+gather_rejects_bad_indices()
+{
+    pel::cow_container<std::int32_t> source;
+    for(std::int32_t i = 0; i < 100; ++i)
+    {
+        source.push_back(i);
+    }
+
+    /* A bad index in a vector or in the tail stops the gather there */
+    const std::vector<std::size_t> positions{0, 5, 17, 38};
+    for(const std::size_t bad : positions)
+    {
+        const std::vector<std::int64_t> badIndices{100, -1, std::int64_t{1} << 40};
+        for(const std::int64_t badIndex : badIndices)
+        {
+            std::vector<std::int64_t> indices(40, 2);
+            indices[bad] = badIndex;
+
+            std::vector<std::int32_t> output(40, -5);
+            PEL_CHECK_THROWS(pel::gather(source, indices, output.begin()), std::length_error);
+            for(std::size_t i = 0; i < bad; ++i)
+            {
+                PEL_CHECK(output[i] == 2);
+            }
+            PEL_CHECK(output[bad] == -5);
+        }
+    }
+
+    const std::vector<std::int32_t> negative{1, -3};
+    PEL_CHECK_THROWS(static_cast<void>(pel::take(source, negative)), std::length_error);
+}
+
+void
+take_builds_non_default_constructible_elements()
+{
+    const pel::cow_container<no_default> source{no_default{4}, no_default{5}, no_default{6}};
+    const std::vector<std::size_t>       indices{2, 2, 0};
+
+    const auto taken = pel::take(source, indices);
+    PEL_CHECK((taken == std::vector<no_default>{no_default{6}, no_default{6}, no_default{4}}));
+}
+
+void
+scatter_writes_and_checks()
+{
+    pel::cow_container<std::string>       destination{"a", "b", "c", "d"};
+    const pel::cow_container<std::string> shared = destination;
+
+    const std::vector<std::size_t> indices{3, 1, 3};
+    const std::vector<std::string> values{"x", "y", "z"};
+    pel::scatter(destination, indices, values);
+    PEL_CHECK(destination.to_string() == "[a, y, c, z]");
+    PEL_CHECK(shared.to_string() == "[a, b, c, d]");
+
+    PEL_CHECK_THROWS(pel::scatter(destination, indices, std::vector<std::string>{"w"}),
+                     std::invalid_argument);
+    PEL_CHECK(destination.to_string() == "[a, y, c, z]");
+
+    const std::vector<int> bad{0, 4, 1};
+    PEL_CHECK_THROWS(pel::scatter(destination, bad, values, 0), std::length_error);
+    PEL_CHECK(destination.to_string() == "[x, y, c, z]");
+
+    /* Every element written once, in any order */
+    pel::cow_container<std::uint64_t> numbers(1000, 0);
+    std::vector<std::uint32_t>        permutation;
+    std::vector<std::uint64_t>        squares;
+    for(std::uint32_t i = 0; i < 1000; ++i)
+    {
+        permutation.push_back((i * 389) % 1000);
+        squares.push_back(std::uint64_t{permutation.back()} * permutation.back());
+    }
+    pel::scatter(numbers, permutation, squares);
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        PEL_CHECK(numbers[i] == i * i);
+    }
+}
+
+void
+prefetched_range_visits_the_indices()
+{
+    pel::cow_container<int>        container{10, 20, 30, 40, 50};
+    const std::vector<std::size_t> indices{4, 0, 4, 2};
+
+    std::vector<int> visited;
+    for(int& item : pel::prefetched(container, indices, 2))
+    {
+        visited.push_back(item);
+        item += 1;
+    }
+    PEL_CHECK((visited == std::vector<int>{50, 10, 51, 30}));
+    PEL_CHECK(container.to_string() == "[11, 20, 31, 40, 52]");
+
+    auto range = pel::prefetched(container, indices);
+    auto it    = range.begin();
+    PEL_CHECK(*it++ == 52 && *it == 11 && it.index_iterator() == indices.begin() + 1);
+    PEL_CHECK(std::ranges::distance(range) == 4);
+
+    const std::vector<std::size_t> none;
+    PEL_CHECK(pel::prefetched(container, none).empty());
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"gather_matches_indexing", gather_matches_indexing},
+      {"gather_rejects_bad_indices", gather_rejects_bad_indices},
+      {"take_builds_non_default_constructible_elements",
+       take_builds_non_default_constructible_elements},
+      {"scatter_writes_and_checks", scatter_writes_and_checks},
+      {"prefetched_range_visits_the_indices", prefetched_range_visits_the_indices},
+    });
+}
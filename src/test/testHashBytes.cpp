@@ -0,0 +1,138 @@
+/**
+ * @file    container_base/src/test/testHashBytes.cpp
+ */
+
+#include "src/container_hash.hpp"
+#include "src/cow_container.hpp"
+#include "src/hash_bytes.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+std::vector<std::uint8_t>
+random_bytes(std::size_t count_)
+{
+    std::mt19937              rng(static_cast<unsigned>(count_));
+    std::vector<std::uint8_t> bytes;
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(rng()));
+    }
+    return bytes;
+}
+
+void
+hash_bytes_separates_inputs()
+{
+    const std::vector<std::uint8_t> bytes = random_bytes(1000);
+
+    /* Every prefix, across the short, medium and striped paths */
+    std::set<std::uint64_t> hashes;
+    for(std::size_t length = 0; length <= bytes.size(); ++length)
+    {
+        const std::uint64_t hash = pel::hash_bytes(bytes.data(), length);
+        PEL_CHECK(hash == pel::hash_bytes(bytes.data(), length));
+        hashes.insert(hash);
+    }
+    PEL_CHECK(hashes.size() == bytes.size() + 1);
+
+    /* The seed and every single bit change the hash */
+    PEL_CHECK(pel::hash_bytes(bytes.data(), 100, 1) != pel::hash_bytes(bytes.data(), 100, 2));
+    std::vector<std::uint8_t> flipped = bytes;
+    for(std::size_t bit = 0; bit < 8 * 300; bit += 7)
+    {
+        flipped[bit / 8] ^= static_cast<std::uint8_t>(1U << (bit % 8));
+        PEL_CHECK(pel::hash_bytes(flipped.data(), 300) != pel::hash_bytes(bytes.data(), 300));
+        flipped[bit / 8] = bytes[bit / 8];
+    }
+}
+
+void
+byte_hasher_matches_hash_bytes()
+{
+    const std::vector<std::uint8_t> bytes = random_bytes(700);
+    std::mt19937                    rng(3);
+
+    for(std::size_t length : std::vector<std::size_t>{0, 1, 16, 17, 128, 129, 191, 256, 700})
+    {
+        /* Any split of the input gives the one-shot digest */
+        for(int attempt = 0; attempt < 20; ++attempt)
+        {
+            pel::byte_hasher hasher(42);
+            std::size_t      appended = 0;
+            while(appended < length)
+            {
+                const std::size_t piece = std::min<std::size_t>(rng() % 80, length - appended);
+                hasher.append(bytes.data() + appended, piece);
+                appended += piece;
+            }
+            PEL_CHECK(hasher.length() == length);
+            PEL_CHECK(hasher.digest() == pel::hash_bytes(bytes.data(), length, 42));
+        }
+    }
+
+    /* Appending after a digest continues the same input */
+    pel::byte_hasher hasher;
+    hasher.append(bytes.data(), 150);
+    static_cast<void>(hasher.digest());
+    hasher.append(bytes.data() + 150, 150);
+    PEL_CHECK(hasher.digest() == pel::hash_bytes(bytes.data(), 300));
+
+    hasher.reset(7);
+    hasher.append(std::uint32_t{0x01020304});
+    const std::uint32_t value = 0x01020304;
+    PEL_CHECK(hasher.length() == 4 && hasher.digest() == pel::hash_bytes(&value, 4, 7));
+}
+
+void
+container_hasher_follows_equality()
+{
+    static_assert(pel::bytewise_hashable<std::uint32_t>);
+    static_assert(pel::bytewise_hashable<double> == false);
+
+    const pel::container_hasher hasher;
+
+    pel::cow_container<int> built;
+    built.reserve(100);
+    for(int i = 0; i < 10; ++i)
+    {
+        built.push_back(i);
+    }
+    const pel::cow_container<int> listed{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    PEL_CHECK(built == listed && hasher(built) == hasher(listed));
+    PEL_CHECK(hasher(built) == pel::hash_container(listed));
+
+    built.back() = 10;
+    PEL_CHECK(hasher(built) != hasher(listed));
+
+    /* Elements hashed one by one */
+    const pel::cow_container<std::string> words{"alpha", std::string(40, 'b')};
+    const pel::cow_container<std::string> same{"alpha", std::string(40, 'b')};
+    const pel::cow_container<std::string> other{"alph", "a" + std::string(40, 'b')};
+    PEL_CHECK(hasher(words) == hasher(same) && hasher(words) != hasher(other));
+
+    std::unordered_set<pel::cow_container<int>, pel::container_hasher> set;
+    PEL_CHECK(set.insert(listed).second && set.insert(built).second);
+    PEL_CHECK(set.insert(pel::cow_container<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}).second == false);
+    PEL_CHECK(set.size() == 2 && set.contains(listed));
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"hash_bytes_separates_inputs", hash_bytes_separates_inputs},
+      {"byte_hasher_matches_hash_bytes", byte_hasher_matches_hash_bytes},
+      {"container_hasher_follows_equality", container_hasher_follows_equality},
+    });
+}
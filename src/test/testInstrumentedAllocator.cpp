@@ -0,0 +1,225 @@
+/**
+ * @file    container_base/src/test/testInstrumentedAllocator.cpp
+ */
+
+#include "src/allocation_telemetry.hpp"
+#include "src/instrumented_allocator.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+template<typename ItemType, bool TrackLifetimes = false>
+using allocator_type = pel::instrumented_allocator<std::allocator<ItemType>, TrackLifetimes>;
+
+std::uint64_t
+histogram_total(const pel::allocation_snapshot::HistogramType& histogram_)
+{
+    std::uint64_t total = 0;
+    for(const std::uint64_t count : histogram_)
+    {
+        total += count;
+    }
+    return total;
+}
+
+void
+counts_and_sizes_are_recorded()
+{
+    pel::allocation_telemetry telemetry("counts");
+    allocator_type<int>       alloc(telemetry);
+
+    int* small = alloc.allocate(3);
+    int* large = alloc.allocate(1000);
+    small[2]   = 7;
+    large[999] = 8;
+
+    pel::allocation_snapshot snapshot = telemetry.snapshot();
+    PEL_CHECK(snapshot.name == "counts" && snapshot.allocations == 2);
+    PEL_CHECK(snapshot.allocatedBytes == 1003 * sizeof(int) && snapshot.deallocations == 0);
+    PEL_CHECK(snapshot.liveBytes == 1003 * sizeof(int));
+    PEL_CHECK(snapshot.sizeHistogram[4] == 1 && snapshot.sizeHistogram[12] == 1);
+
+    alloc.deallocate(large, 1000);
+    alloc.deallocate(small, 3);
+    snapshot = telemetry.snapshot();
+    PEL_CHECK(snapshot.deallocations == 2 && snapshot.deallocatedBytes == 1003 * sizeof(int));
+    PEL_CHECK(snapshot.liveBytes == 0);
+
+    /* The peak only follows a thread once its live bytes drift by flush_threshold */
+    PEL_CHECK(snapshot.peakBytes == 0);
+    const auto count =
+      static_cast<std::size_t>(pel::allocation_telemetry::flush_threshold) / sizeof(int);
+    alloc.deallocate(alloc.allocate(count), count);
+    PEL_CHECK(telemetry.snapshot().peakBytes == count * sizeof(int));
+
+    /* Lifetimes are not tracked by default */
+    PEL_CHECK(snapshot.lifetimeSamples == 0);
+    PEL_CHECK(histogram_total(snapshot.lifetimeHistogram) == 0);
+}
+
+void
+rebound_copies_share_the_telemetry()
+{
+    pel::allocation_telemetry telemetry("nodes");
+    {
+        std::map<int, std::string, std::less<>, allocator_type<std::pair<const int, std::string>>>
+          map{allocator_type<std::pair<const int, std::string>>(telemetry)};
+        std::list<double, allocator_type<double>> list{allocator_type<double>(telemetry)};
+        for(int i = 0; i < 100; ++i)
+        {
+            map.emplace(i, std::to_string(i));
+            list.push_back(i);
+        }
+
+        const allocator_type<char> rebound(map.get_allocator());
+        PEL_CHECK(&rebound.telemetry() == &telemetry);
+        PEL_CHECK(allocator_type<double>(rebound) == list.get_allocator());
+        PEL_CHECK(allocator_type<double>() != list.get_allocator());
+        PEL_CHECK(telemetry.snapshot().allocations == 200);
+
+        /* Copied containers keep recording into the same telemetry */
+        const auto copy = list;
+        PEL_CHECK(&copy.get_allocator().telemetry() == &telemetry);
+        PEL_CHECK(telemetry.snapshot().allocations == 300);
+    }
+
+    const pel::allocation_snapshot snapshot = telemetry.snapshot();
+    PEL_CHECK(snapshot.deallocations == 300 && snapshot.liveBytes == 0);
+    PEL_CHECK(snapshot.allocatedBytes == snapshot.deallocatedBytes);
+}
+
+void
+lifetimes_are_sampled_when_tracked()
+{
+    pel::allocation_telemetry        telemetry("lifetimes");
+    allocator_type<long double, true> alloc(telemetry);
+
+    /* Every page counts as an allocation towards the sampling period, so large blocks sample */
+    const std::size_t pageItems = pel::allocation_telemetry::sample_page_size / sizeof(long double);
+    std::vector<long double*> blocks;
+    for(std::size_t i = 0; i < 200; ++i)
+    {
+        blocks.push_back(alloc.allocate(i % 2 == 0 ? 1 : pageItems * 64));
+        blocks.back()[0] = static_cast<long double>(i);
+    }
+    for(std::size_t i = 0; i < blocks.size(); ++i)
+    {
+        PEL_CHECK(blocks[i][0] == static_cast<long double>(i));
+        PEL_CHECK(reinterpret_cast<std::uintptr_t>(blocks[i]) % alignof(long double) == 0);
+        alloc.deallocate(blocks[i], i % 2 == 0 ? 1 : pageItems * 64);
+    }
+
+    const pel::allocation_snapshot snapshot = telemetry.snapshot();
+    PEL_CHECK(snapshot.allocations == 200 && snapshot.liveBytes == 0);
+    PEL_CHECK(snapshot.lifetimeSamples >= 100 && snapshot.lifetimeSamples <= 200);
+    PEL_CHECK(histogram_total(snapshot.lifetimeHistogram) == snapshot.lifetimeSamples);
+
+    PEL_CHECK(alloc.max_size() < allocator_type<long double>(telemetry).max_size());
+    PEL_CHECK_THROWS(static_cast<void>(alloc.allocate(alloc.max_size() + 1)),
+                     std::bad_array_new_length);
+}
+
+void
+threads_record_into_their_own_shards()
+{
+    pel::allocation_telemetry telemetry("threads");
+
+    /* Blocks freed on another thread than the one that allocated them */
+    std::vector<std::vector<int*>> blocks(8);
+    std::vector<std::thread>       threads;
+    for(std::size_t t = 0; t < blocks.size(); ++t)
+    {
+        threads.emplace_back([&telemetry, &blocks, t]() {
+            allocator_type<int> alloc(telemetry);
+            for(std::size_t i = 0; i < 5000; ++i)
+            {
+                blocks[t].push_back(alloc.allocate(i % 64 + 1));
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+
+    std::uint64_t bytes = 0;
+    for(std::size_t i = 0; i < 5000; ++i)
+    {
+        bytes += (i % 64 + 1) * sizeof(int);
+    }
+    pel::allocation_snapshot snapshot = telemetry.snapshot();
+    PEL_CHECK(snapshot.allocations == 40000 && snapshot.allocatedBytes == 8 * bytes);
+    PEL_CHECK(snapshot.liveBytes == 8 * bytes);
+
+    for(std::size_t t = 0; t < blocks.size(); ++t)
+    {
+        threads.emplace_back([&telemetry, &blocks, t]() {
+            allocator_type<int> alloc(telemetry);
+            const auto&         owned = blocks[blocks.size() - 1 - t];
+            for(std::size_t i = 0; i < owned.size(); ++i)
+            {
+                alloc.deallocate(owned[i], i % 64 + 1);
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    snapshot = telemetry.snapshot();
+    PEL_CHECK(snapshot.deallocations == 40000 && snapshot.liveBytes == 0);
+    PEL_CHECK(snapshot.peakBytes <= 8 * bytes);
+}
+
+void
+snapshots_are_exported()
+{
+    pel::allocation_telemetry telemetry("export \"quoted\"");
+    allocator_type<char>      alloc(telemetry);
+    alloc.deallocate(alloc.allocate(100), 100);
+
+    const std::string json = telemetry.snapshot().to_json();
+    PEL_CHECK(json.starts_with("{\"name\":\"export \\\"quoted\\\"\",\"allocations\":1,"));
+    PEL_CHECK(json.find("\"allocated_bytes\":100,") != std::string::npos);
+
+    const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "testInstrumentedAllocator.prom";
+    telemetry.export_prometheus(path);
+    std::stringstream contents;
+    contents << std::ifstream(path).rdbuf();
+    std::filesystem::remove(path);
+    PEL_CHECK(contents.str() == telemetry.snapshot().to_prometheus());
+    PEL_CHECK(contents.str().find("telemetry=\"export \\\"quoted\\\"\"") != std::string::npos);
+
+    PEL_CHECK_THROWS(telemetry.export_json(path / "missing" / "file.json"), std::runtime_error);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"counts_and_sizes_are_recorded", counts_and_sizes_are_recorded},
+      {"rebound_copies_share_the_telemetry", rebound_copies_share_the_telemetry},
+      {"lifetimes_are_sampled_when_tracked", lifetimes_are_sampled_when_tracked},
+      {"threads_record_into_their_own_shards", threads_record_into_their_own_shards},
+      {"snapshots_are_exported", snapshots_are_exported},
+    });
+}
@@ -0,0 +1,292 @@
+/**
+ * @file    container_base/src/test/testIntrusiveList.cpp
+ */
+
+#include "src/intrusive_list.hpp"
+#include "src/node_pool.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct second_list;
+
+struct item : pel::intrusive_list_hook<>, pel::intrusive_list_hook<second_list>
+{
+    int value = 0;
+
+    explicit item(int value_) : value{value_} {}
+
+    friend std::ostream& operator<<(std::ostream& os_, const item& item_)
+    {
+        return os_ << item_.value;
+    }
+};
+
+using list_type   = pel::intrusive_list<item>;
+using second_type = pel::intrusive_list<item, second_list>;
+
+bool
+is_in_first_list(const item& item_)
+{
+    return static_cast<const pel::intrusive_list_hook<>&>(item_).is_linked();
+}
+
+template<typename ListType>
+std::vector<int>
+values_of(const ListType& list_)
+{
+    std::vector<int> values;
+    for(const item& element : list_)
+    {
+        values.push_back(element.value);
+    }
+
+    /* Walking backwards gives the same elements */
+    std::vector<int> backwards;
+    for(auto it = list_.rbegin(); it != list_.rend(); ++it)
+    {
+        backwards.push_back(it->value);
+    }
+    std::ranges::reverse(backwards);
+    PEL_CHECK(backwards == values);
+    PEL_CHECK(values.size() == list_.length());
+    return values;
+}
+
+void
+matches_std_list()
+{
+    pel::node_pool<item> pool;
+    list_type            list;
+    std::list<int>       expected;
+
+    std::mt19937 rng(5);
+    for(int step = 0; step < 10000; ++step)
+    {
+        switch(rng() % 5)
+        {
+            case 0:
+                list.push_back(*pool.create(step));
+                expected.push_back(step);
+                break;
+            case 1:
+                list.push_front(*pool.create(step));
+                expected.push_front(step);
+                break;
+            case 2:
+                if(expected.empty() == false)
+                {
+                    item& last = list.back();
+                    list.pop_back();
+                    PEL_CHECK(is_in_first_list(last) == false);
+                    pool.destroy(&last);
+                    expected.pop_back();
+                }
+                break;
+            case 3:
+                if(expected.empty() == false)
+                {
+                    item& first = list.front();
+                    list.pop_front();
+                    pool.destroy(&first);
+                    expected.pop_front();
+                }
+                break;
+            default:
+            {
+                /* Insert in the middle */
+                const std::size_t offset = expected.empty() ? 0 : rng() % expected.size();
+                auto              it     = list.begin();
+                auto              ref    = expected.begin();
+                std::advance(it, static_cast<std::ptrdiff_t>(offset));
+                std::advance(ref, static_cast<std::ptrdiff_t>(offset));
+                PEL_CHECK(list.insert(it, *pool.create(-step))->value == -step);
+                expected.insert(ref, -step);
+                break;
+            }
+        }
+    }
+
+    PEL_CHECK(values_of(list) == std::vector<int>(expected.begin(), expected.end()));
+    PEL_CHECK(pool.length() == list.length());
+    list.clear_and_dispose([&pool](item* item_) { pool.destroy(item_); });
+    PEL_CHECK(list.is_empty() && pool.length() == 0);
+}
+
+void
+splices_move_links_only()
+{
+    std::vector<item> items;
+    for(int i = 0; i < 10; ++i)
+    {
+        items.emplace_back(i);
+    }
+
+    list_type left;
+    list_type right;
+    for(int i = 0; i < 5; ++i)
+    {
+        left.push_back(items[static_cast<std::size_t>(i)]);
+        right.push_back(items[static_cast<std::size_t>(i + 5)]);
+    }
+
+    /* One element */
+    left.splice(left.begin(), right, right.iterator_to(items[7]));
+    PEL_CHECK(values_of(left) == (std::vector<int>{7, 0, 1, 2, 3, 4}));
+    PEL_CHECK(values_of(right) == (std::vector<int>{5, 6, 8, 9}));
+
+    /* A range, counted or not */
+    left.splice(left.end(), right, right.begin(), right.iterator_to(items[8]));
+    PEL_CHECK(values_of(left) == (std::vector<int>{7, 0, 1, 2, 3, 4, 5, 6}));
+    right.splice(right.begin(), left, left.iterator_to(items[1]), left.iterator_to(items[4]), 3);
+    PEL_CHECK(values_of(left) == (std::vector<int>{7, 0, 4, 5, 6}));
+    PEL_CHECK(values_of(right) == (std::vector<int>{1, 2, 3, 8, 9}));
+
+    /* A whole list */
+    left.splice(left.iterator_to(items[4]), right);
+    PEL_CHECK(values_of(left) == (std::vector<int>{7, 0, 1, 2, 3, 8, 9, 4, 5, 6}));
+    PEL_CHECK(right.is_empty() && right.begin() == right.end());
+
+    left.clear();
+    for(const item& element : items)
+    {
+        PEL_CHECK(is_in_first_list(element) == false);
+    }
+}
+
+void
+erasures_unlink_and_dispose()
+{
+    pel::node_pool<item> pool;
+    list_type            list;
+    for(int i = 0; i < 10; ++i)
+    {
+        list.push_back(*pool.create(i));
+    }
+
+    item& third = *std::next(list.begin(), 2);
+    auto  next  = list.erase(list.iterator_to(third));
+    PEL_CHECK(next->value == 3 && is_in_first_list(third) == false);
+    pool.destroy(&third);
+
+    std::vector<item*> erased;
+    for(auto it = std::next(list.begin(), 3); it != std::next(list.begin(), 6); ++it)
+    {
+        erased.push_back(&*it);
+    }
+    next = list.erase(std::next(list.begin(), 3), std::next(list.begin(), 6));
+    PEL_CHECK(next->value == 7);
+    for(item* element : erased)
+    {
+        PEL_CHECK(is_in_first_list(*element) == false);
+        pool.destroy(element);
+    }
+    PEL_CHECK(values_of(list) == (std::vector<int>{0, 1, 3, 7, 8, 9}));
+
+    auto dispose = [&pool](item* item_) { pool.destroy(item_); };
+    next         = list.erase_and_dispose(list.begin(), dispose);
+    PEL_CHECK(next->value == 1 && pool.length() == 5);
+    PEL_CHECK(list.remove_and_dispose_if([](const item& item_) { return item_.value % 2 != 0; },
+                                         dispose)
+              == 4);
+    PEL_CHECK(values_of(list) == (std::vector<int>{8}));
+    PEL_CHECK(pool.length() == 1);
+
+    item& last = list.front();
+    PEL_CHECK(list.remove_if([](const item&) { return true; }) == 1);
+    PEL_CHECK(list.is_empty());
+    pool.destroy(&last);
+}
+
+void
+hooks_put_an_element_in_two_lists()
+{
+    item first(1);
+    item second(2);
+    {
+        list_type   all;
+        second_type some;
+        all.push_back(first);
+        all.push_back(second);
+        some.push_back(second);
+
+        PEL_CHECK(all.to_string() == "[1, 2]");
+        PEL_CHECK(some.to_string() == "[2]");
+        PEL_CHECK(&*some.iterator_to(second) == &second);
+
+        all.pop_back();
+        PEL_CHECK(some.front().value == 2);
+        PEL_CHECK_THROWS(some.push_front(second), std::invalid_argument);
+
+        list_type moved(std::move(all));
+        PEL_CHECK(all.is_empty() && moved.length() == 1 && &moved.front() == &first);
+    }
+
+    /* Destroying a list unlinks its elements */
+    PEL_CHECK(is_in_first_list(first) == false);
+    PEL_CHECK(static_cast<pel::intrusive_list_hook<second_list>&>(second).is_linked() == false);
+
+    list_type empty;
+    PEL_CHECK_THROWS(empty.front(), std::length_error);
+    PEL_CHECK_THROWS(empty.pop_back(), std::length_error);
+}
+
+/* A node that is not the element: iterators dereference to value() */
+struct value_node
+{
+    value_node* m_next  = nullptr;
+    value_node* m_prev  = nullptr;
+    int         m_value = 0;
+
+    [[nodiscard]] value_node* next() const noexcept { return m_next; }
+    [[nodiscard]] value_node* prev() const noexcept { return m_prev; }
+    [[nodiscard]] int&        value() noexcept { return m_value; }
+};
+
+void
+node_iterators_walk_both_ways()
+{
+    value_node nodes[3];
+    for(int i = 0; i < 3; ++i)
+    {
+        nodes[i].m_value = i * 10;
+        nodes[i].m_next  = i < 2 ? &nodes[i + 1] : nullptr;
+        nodes[i].m_prev  = i > 0 ? &nodes[i - 1] : nullptr;
+    }
+
+    using iterator = pel::node_iterator_base<int, value_node>;
+    static_assert(std::bidirectional_iterator<iterator>);
+
+    iterator it(&nodes[0]);
+    PEL_CHECK(*it == 0 && *++it == 10 && *it++ == 10 && *it == 20);
+    PEL_CHECK(*--it == 10 && it.node() == &nodes[1]);
+    *it = 11;
+    PEL_CHECK(nodes[1].m_value == 11);
+    PEL_CHECK(++(++it) == iterator(nullptr));
+
+    list_type::ConstIteratorType constEnd = list_type::IteratorType();
+    PEL_CHECK(constEnd == list_type::ConstIteratorType());
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"matches_std_list", matches_std_list},
+      {"splices_move_links_only", splices_move_links_only},
+      {"erasures_unlink_and_dispose", erasures_unlink_and_dispose},
+      {"hooks_put_an_element_in_two_lists", hooks_put_an_element_in_two_lists},
+      {"node_iterators_walk_both_ways", node_iterators_walk_both_ways},
+    });
+}
@@ -0,0 +1,181 @@
+/**
+ * @file    container_base/src/test/testMpmcQueue.cpp
+ */
+
+#include "src/mpmc_queue.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void
+capacity_rounds_up()
+{
+    pel::mpmc_queue<int> queue(5);
+    PEL_CHECK(queue.capacity() == 8);
+    PEL_CHECK(queue.is_empty());
+    PEL_CHECK_THROWS(pel::mpmc_queue<int>(0), std::invalid_argument);
+}
+
+void
+fifo_until_full()
+{
+    pel::mpmc_queue<std::string> queue(4);
+    for(int i = 0; i < 4; ++i)
+    {
+        PEL_CHECK(queue.try_emplace(std::to_string(i)));
+    }
+    PEL_CHECK(!queue.try_push(std::string(100, 'x')));
+    PEL_CHECK(queue.length() == 4);
+
+    std::string value;
+    for(int i = 0; i < 4; ++i)
+    {
+        PEL_CHECK(queue.try_pop(value) && value == std::to_string(i));
+    }
+    PEL_CHECK(!queue.try_pop(value));
+}
+
+void
+bulk_operations()
+{
+    pel::mpmc_queue<int> queue(8);
+    std::array<int, 10>  input{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    PEL_CHECK(queue.try_push_bulk(input.begin(), input.size()) == 8);
+
+    std::array<int, 10> output{};
+    PEL_CHECK(queue.try_pop_bulk(output.begin(), 3) == 3);
+    PEL_CHECK(output[0] == 0 && output[2] == 2);
+    PEL_CHECK(queue.try_pop_bulk(output.begin(), 10) == 5);
+    PEL_CHECK(output[0] == 3 && output[4] == 7);
+    PEL_CHECK(queue.is_empty());
+}
+
+/* Output iterator whose assignments throw once a number of elements were written */
+struct limited_output
+{
+    int*         out;
+    std::size_t* room;
+
+    limited_output& operator*() { return *this; }
+    limited_output& operator++() { return *this; }
+    limited_output& operator=(int value_)
+    {
+        if(*room == 0)
+        {
+            throw std::length_error("No room left");
+        }
+        --*room;
+        *out++ = value_;
+        return *this;
+    }
+};
+
+void
+bulk_operations_and_exceptions()
+{
+    /* std::string copies may throw, so those slots are claimed one element at a time */
+    pel::mpmc_queue<std::string>   strings(4);
+    const std::vector<std::string> input{"a", "b", "c", "d", "e"};
+    PEL_CHECK(strings.try_push_bulk(input.begin(), input.size()) == 4);
+    std::string value;
+    PEL_CHECK(strings.try_pop(value) && value == "a");
+
+    /* A throwing output drops the claimed elements but releases their slots */
+    pel::mpmc_queue<int> queue(8);
+    std::array<int, 6>   values{0, 1, 2, 3, 4, 5};
+    PEL_CHECK(queue.try_push_bulk(values.begin(), values.size()) == 6);
+    std::array<int, 8> output{};
+    std::size_t        room = 2;
+    PEL_CHECK_THROWS(queue.try_pop_bulk(limited_output{output.data(), &room}, 4),
+                     std::length_error);
+    PEL_CHECK(output[0] == 0 && output[1] == 1 && queue.length() == 2);
+    PEL_CHECK(queue.try_push_bulk(values.begin(), values.size()) == 6);
+    PEL_CHECK(queue.try_pop_bulk(output.begin(), 8) == 8);
+    PEL_CHECK(output[0] == 4 && output[1] == 5 && output[2] == 0 && output[5] == 3);
+}
+
+void
+many_producers_many_consumers()
+{
+    constexpr int         producers = 4;
+    constexpr int         consumers = 4;
+    constexpr long        count     = 3000;
+    pel::mpmc_queue<long> queue(64);
+    std::atomic<long>     sum{0};
+    std::atomic<long>     popped{0};
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&] {
+            for(long i = 1; i <= count; ++i)
+            {
+                queue.push(i);
+            }
+        });
+    }
+    for(int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            while(popped.load() < producers * count)
+            {
+                long value = 0;
+                if(queue.try_pop(value))
+                {
+                    sum += value;
+                    ++popped;
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    PEL_CHECK(sum.load() == producers * count * (count + 1) / 2);
+    PEL_CHECK(queue.is_empty());
+}
+
+void
+blocking_pop_waits()
+{
+    pel::mpmc_queue<std::string> queue(2);
+    bool                         inOrder = true;
+    std::thread                  consumer([&] {
+        for(int i = 0; i < 1000; ++i)
+        {
+            std::string value;
+            queue.pop(value);
+            inOrder = inOrder && value == std::to_string(i);
+        }
+    });
+    for(int i = 0; i < 1000; ++i)
+    {
+        queue.emplace(std::to_string(i));
+    }
+    consumer.join();
+    PEL_CHECK(inOrder);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"capacity_rounds_up", capacity_rounds_up},
+      {"fifo_until_full", fifo_until_full},
+      {"bulk_operations", bulk_operations},
+      {"bulk_operations_and_exceptions", bulk_operations_and_exceptions},
+      {"many_producers_many_consumers", many_producers_many_consumers},
+      {"blocking_pop_waits", blocking_pop_waits},
+    });
+}
@@ -0,0 +1,142 @@
+/**
+ * @file    container_base/src/test/testNdarray.cpp
+ */
+
+#include "src/ndarray.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <array>
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+using extents_2d = pel::ndarray_extents<2>;
+
+template<typename LayoutType>
+void
+check_layout()
+{
+    pel::ndarray<int, 2, LayoutType> array(extents_2d(7, 10));
+    PEL_CHECK(array.extent(0) == 7 && array.extent(1) == 10);
+    PEL_CHECK(array.length() == array.mapping().required_span_size());
+
+    std::set<std::size_t> offsets;
+    for(std::size_t i = 0; i < 7; ++i)
+    {
+        for(std::size_t j = 0; j < 10; ++j)
+        {
+            array(i, j) = static_cast<int>(i * 100 + j);
+            offsets.insert(array.mapping()(i, j));
+        }
+    }
+    PEL_CHECK(offsets.size() == 70 && *offsets.rbegin() < array.length());
+
+    const auto view = array.view();
+    for(std::size_t i = 0; i < 7; ++i)
+    {
+        for(std::size_t j = 0; j < 10; ++j)
+        {
+            PEL_CHECK(view(i, j) == static_cast<int>(i * 100 + j));
+            PEL_CHECK(array.at(i, j) == view(i, j));
+        }
+    }
+    PEL_CHECK_THROWS(array.at(7, 0), std::length_error);
+    PEL_CHECK_THROWS(array.at(0, 10), std::length_error);
+}
+
+void
+layouts_place_every_element_once()
+{
+    check_layout<pel::layout_row_major>();
+    check_layout<pel::layout_column_major>();
+    check_layout<pel::layout_tiled<4, 4>>();
+
+    pel::ndarray<int, 2> rowMajor(extents_2d(3, 5));
+    PEL_CHECK(rowMajor.mapping()(2, 1) == 11);
+    pel::ndarray<int, 2, pel::layout_column_major> columnMajor(extents_2d(3, 5));
+    PEL_CHECK(columnMajor.mapping()(2, 1) == 5);
+}
+
+void
+slices_share_the_elements()
+{
+    pel::ndarray<int, 2, pel::layout_tiled<4, 4>> array(extents_2d(9, 9), 0);
+    for(std::size_t i = 0; i < 9; ++i)
+    {
+        for(std::size_t j = 0; j < 9; ++j)
+        {
+            array(i, j) = static_cast<int>(i * 10 + j);
+        }
+    }
+
+    auto slice = array.slice({2, 3}, {3, 4});
+    PEL_CHECK(slice.extent(0) == 3 && slice.extent(1) == 4 && slice.size() == 12);
+    PEL_CHECK(slice(0, 0) == 23 && slice(2, 3) == 46);
+    PEL_CHECK_THROWS(slice.at(3, 0), std::length_error);
+
+    slice(1, 1) = -1;
+    PEL_CHECK(array(3, 4) == -1);
+
+    std::size_t visited = 0;
+    slice.for_each_index([&](const std::array<std::size_t, 2>& indices_) {
+        PEL_CHECK(indices_[0] == visited / 4 && indices_[1] == visited % 4);
+        ++visited;
+    });
+    PEL_CHECK(visited == 12);
+
+    const pel::ndarray<int, 2>& constArray = pel::ndarray<int, 2>(extents_2d(2, 2), 1);
+    PEL_CHECK(constArray.to_string() == "[[1, 1], [1, 1]]");
+}
+
+void
+copies_and_moves()
+{
+    pel::ndarray<std::string, 2> array(extents_2d(2, 3), std::string(30, 'a'));
+    array(1, 2) = "last";
+
+    pel::ndarray<std::string, 2> copy = array;
+    PEL_CHECK(copy.extents() == array.extents() && copy(1, 2) == "last");
+    copy(0, 0) = "changed";
+    PEL_CHECK(array(0, 0) == std::string(30, 'a'));
+
+    pel::ndarray<std::string, 2> moved = std::move(copy);
+    PEL_CHECK(moved(0, 0) == "changed");
+    PEL_CHECK(copy.is_empty() && copy.extents().size() == 0);
+
+    copy = moved;
+    PEL_CHECK(copy(1, 2) == "last");
+}
+
+void
+clear_resets_the_extents()
+{
+    pel::ndarray<std::string, 2, pel::layout_tiled<2, 2>> array(extents_2d(5, 3), "x");
+    PEL_CHECK(array.length() >= 15);
+
+    array.clear();
+    PEL_CHECK(array.is_empty() && array.length() == 0);
+    PEL_CHECK(array.extent(0) == 0 && array.extent(1) == 0);
+    PEL_CHECK(array.extents().size() == 0 && array.view().empty());
+    PEL_CHECK(array.to_string() == "[]");
+    PEL_CHECK_THROWS(array.at(0, 0), std::length_error);
+
+    array.clear();
+    array = pel::ndarray<std::string, 2, pel::layout_tiled<2, 2>>(extents_2d(1, 2), "y");
+    PEL_CHECK(array.to_string() == "[[y, y]]");
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"layouts_place_every_element_once", layouts_place_every_element_once},
+      {"slices_share_the_elements", slices_share_the_elements},
+      {"copies_and_moves", copies_and_moves},
+      {"clear_resets_the_extents", clear_resets_the_extents},
+    });
+}
@@ -0,0 +1,129 @@
+/**
+ * @file    container_base/src/test/testNodePool.cpp
+ */
+
+#include "src/node_pool.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct tracked
+{
+    static inline int s_alive = 0;
+
+    std::string text;
+
+    explicit tracked(std::string text_) : text{std::move(text_)} { ++s_alive; }
+    tracked(const tracked&)            = delete;
+    tracked& operator=(const tracked&) = delete;
+    ~tracked() { --s_alive; }
+};
+
+void
+nodes_are_carved_in_address_order()
+{
+    pel::node_pool<std::uint64_t, std::allocator<std::uint64_t>, 8> pool;
+    PEL_CHECK(pool.slab_count() == 0 && pool.capacity() == 0);
+
+    std::vector<std::uint64_t*> nodes;
+    for(std::size_t i = 0; i < 20; ++i)
+    {
+        nodes.push_back(pool.allocate());
+    }
+    PEL_CHECK(pool.length() == 20);
+    PEL_CHECK(pool.slab_count() == 3 && pool.capacity() == 24);
+
+    /* Within a slab, consecutive nodes are adjacent */
+    for(std::size_t i = 1; i < 8; ++i)
+    {
+        PEL_CHECK(nodes[i] == nodes[i - 1] + 1);
+        PEL_CHECK(nodes[8 + i] == nodes[8 + i - 1] + 1);
+    }
+    PEL_CHECK(std::set<std::uint64_t*>(nodes.begin(), nodes.end()).size() == nodes.size());
+
+    for(std::uint64_t* node : nodes)
+    {
+        pool.deallocate(node);
+    }
+    PEL_CHECK(pool.length() == 0 && pool.slab_count() == 3);
+}
+
+void
+freed_nodes_are_reused_first()
+{
+    pel::node_pool<int, std::allocator<int>, 16> pool;
+    int* const first  = pool.allocate();
+    int* const second = pool.allocate();
+    int* const third  = pool.allocate();
+
+    pool.deallocate(second);
+    PEL_CHECK(pool.allocate() == second);
+
+    pool.deallocate(first);
+    pool.deallocate(third);
+    PEL_CHECK(pool.allocate() == third);
+    PEL_CHECK(pool.allocate() == first);
+    PEL_CHECK(pool.allocate() > third);
+    PEL_CHECK(pool.length() == 4 && pool.slab_count() == 1);
+}
+
+void
+create_and_destroy_run_the_element()
+{
+    tracked::s_alive = 0;
+    {
+        pel::node_pool<tracked> pool;
+        tracked* const one = pool.create(std::string(40, 'a'));
+        tracked* const two = pool.create("two");
+        PEL_CHECK(tracked::s_alive == 2);
+        PEL_CHECK(one->text == std::string(40, 'a') && two->text == "two");
+
+        pool.destroy(one);
+        PEL_CHECK(tracked::s_alive == 1 && pool.length() == 1);
+        PEL_CHECK(pool.create("three") == one);
+        pool.destroy(one);
+        pool.destroy(two);
+    }
+    PEL_CHECK(tracked::s_alive == 0);
+}
+
+void
+reserve_move_and_release()
+{
+    pel::node_pool<double, std::allocator<double>, 10> pool;
+    pool.reserve(25);
+    PEL_CHECK(pool.slab_count() == 3 && pool.capacity() == 30 && pool.length() == 0);
+
+    double* const node = pool.create(1.5);
+    pel::node_pool<double, std::allocator<double>, 10> moved(std::move(pool));
+    PEL_CHECK(moved.length() == 1 && moved.slab_count() == 3);
+    PEL_CHECK(pool.length() == 0 && pool.slab_count() == 0);
+    PEL_CHECK(*node == 1.5);
+
+    pool = std::move(moved);
+    PEL_CHECK(pool.length() == 1 && moved.slab_count() == 0);
+
+    pool.release();
+    PEL_CHECK(pool.length() == 0 && pool.capacity() == 0);
+    PEL_CHECK(pool.allocate() != nullptr && pool.slab_count() == 1);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"nodes_are_carved_in_address_order", nodes_are_carved_in_address_order},
+      {"freed_nodes_are_reused_first", freed_nodes_are_reused_first},
+      {"create_and_destroy_run_the_element", create_and_destroy_run_the_element},
+      {"reserve_move_and_release", reserve_move_and_release},
+    });
+}
@@ -0,0 +1,226 @@
+/**
+ * @file    container_base/src/test/testPersistentVector.cpp
+ */
+
+#include "src/persistent_vector.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using vector_type = pel::persistent_vector<std::string>;
+using model_type  = std::vector<std::string>;
+
+/* Element counting its live instances, to find leaked or doubly destroyed nodes */
+struct counted
+{
+    static inline int s_alive = 0;
+
+    int value = 0;
+
+    explicit counted(int value_) : value{value_} { ++s_alive; }
+    counted(const counted& copy_) : value{copy_.value} { ++s_alive; }
+    counted& operator=(const counted&) = default;
+    ~counted() { --s_alive; }
+};
+
+bool
+matches(const vector_type& vector_, const model_type& model_)
+{
+    if(vector_.length() != model_.size()
+       || std::equal(vector_.begin(), vector_.end(), model_.begin(), model_.end()) == false
+       || std::equal(vector_.rbegin(), vector_.rend(), model_.rbegin(), model_.rend()) == false)
+    {
+        return false;
+    }
+
+    std::size_t visited = 0;
+    bool        same    = true;
+    vector_.for_each_segment([&](vector_type::SpanType segment_) {
+        for(const std::string& item : segment_)
+        {
+            same = same && item == model_[visited++];
+        }
+    });
+    for(std::size_t i = 0; same && i < model_.size(); i += 7)
+    {
+        same = vector_[i] == model_[i] && vector_.at(i) == model_[i]
+               && *(vector_.begin() + static_cast<std::ptrdiff_t>(i)) == model_[i];
+    }
+    return same && visited == model_.size();
+}
+
+void
+versions_match_a_copied_vector()
+{
+    /* Every operation starts from a random older version, which must stay intact */
+    std::mt19937                                    rng(42);
+    std::vector<std::pair<vector_type, model_type>> versions{{vector_type{}, model_type{}}};
+    for(int step = 0; step < 1500; ++step)
+    {
+        const auto& [base, baseModel] = versions[rng() % versions.size()];
+        vector_type vector            = base;
+        model_type  model             = baseModel;
+
+        switch(rng() % 6)
+        {
+            case 0:
+                for(std::size_t i = rng() % 100; i > 0; --i)
+                {
+                    const std::string item = std::to_string(rng());
+                    vector                 = vector.push_back(item);
+                    model.push_back(item);
+                }
+                break;
+            case 1:
+                for(std::size_t i = std::min<std::size_t>(rng() % 80, model.size()); i > 0; --i)
+                {
+                    vector = vector.pop_back();
+                    model.pop_back();
+                }
+                break;
+            case 2:
+                if(model.empty() == false)
+                {
+                    const std::size_t index = rng() % model.size();
+                    vector = vector.update(index, [](std::string& item_) { item_ += "!"; });
+                    model[index] += "!";
+                }
+                break;
+            case 3:
+            {
+                const auto& [other, otherModel] = versions[rng() % versions.size()];
+                vector                          = vector.concat(other);
+                model.insert(model.end(), otherModel.begin(), otherModel.end());
+                break;
+            }
+            case 4:
+            {
+                auto transient = vector.transient();
+                for(int i = static_cast<int>(rng() % 300); i > 0; --i)
+                {
+                    transient.push_back(std::to_string(i));
+                    model.push_back(std::to_string(i));
+                }
+                for(int i = 0; i < 20 && model.empty() == false; ++i)
+                {
+                    const std::size_t index = rng() % model.size();
+                    transient.set(index, "t");
+                    model[index] = "t";
+                }
+                vector = transient.persistent();
+                break;
+            }
+            default:
+                if(model.size() < 2000)
+                {
+                    const model_type copy = model;
+                    vector                = vector.concat(vector);
+                    model.insert(model.end(), copy.begin(), copy.end());
+                }
+                break;
+        }
+        PEL_CHECK(matches(vector, model));
+
+        if(model.size() < 8000)
+        {
+            if(versions.size() < 30)
+            {
+                versions.emplace_back(std::move(vector), std::move(model));
+            }
+            else
+            {
+                versions[rng() % versions.size()] = {std::move(vector), std::move(model)};
+            }
+        }
+    }
+
+    for(const auto& [vector, model] : versions)
+    {
+        PEL_CHECK(matches(vector, model));
+        PEL_CHECK(vector.depth() <= 3);
+    }
+}
+
+void
+transients_edit_in_place()
+{
+    const pel::persistent_vector<int> source{1, 2, 3};
+
+    pel::transient_vector<int> transient = source.transient();
+    for(int i = 4; i <= 1000; ++i)
+    {
+        transient.push_back(i);
+    }
+    transient.set(0, -1);
+    transient.update(1, [](int& item_) { item_ *= 10; });
+    transient.pop_back();
+    transient.append(source);
+    PEL_CHECK(transient.length() == 1002 && transient.back() == 3 && transient[1] == 20);
+
+    const pel::persistent_vector<int> snapshot = transient.persistent();
+    transient.set(2, 0);
+    PEL_CHECK(snapshot[2] == 3 && transient[2] == 0);
+    PEL_CHECK(source.to_string() == "[1, 2, 3]");
+    PEL_CHECK(snapshot.length() == 1002 && snapshot.front() == -1 && snapshot[998] == 999);
+}
+
+void
+nodes_are_freed_exactly_once()
+{
+    counted::s_alive = 0;
+    {
+        pel::persistent_vector<counted> vector;
+        for(int i = 0; i < 2000; ++i)
+        {
+            vector = vector.push_back(counted(i));
+        }
+        const auto half   = vector.concat(vector).pop_back();
+        const auto edited = half.set(1500, counted(-1));
+        PEL_CHECK(edited[1500].value == -1 && half[1500].value == 1500);
+        PEL_CHECK(half.length() == 3999 && half[2000].value == 0);
+
+        auto transient = edited.transient();
+        while(transient.is_not_empty())
+        {
+            transient.pop_back();
+        }
+        PEL_CHECK(transient.persistent().is_empty() && edited.length() == 3999);
+    }
+    PEL_CHECK(counted::s_alive == 0);
+}
+
+void
+comparisons_and_errors()
+{
+    const pel::persistent_vector<int> lhs{1, 2, 3};
+    const pel::persistent_vector<int> rhs(pel::from_range, std::vector<int>{1, 2, 4});
+    PEL_CHECK(lhs < rhs && lhs != rhs && lhs <= rhs && (lhs == lhs.set(0, 1)));
+    PEL_CHECK(lhs.to_string() == "[1, 2, 3]");
+
+    const pel::persistent_vector<int> empty;
+    PEL_CHECK(empty.is_empty() && empty.begin() == empty.end());
+    PEL_CHECK_THROWS(empty.front(), std::length_error);
+    PEL_CHECK_THROWS(empty.pop_back(), std::length_error);
+    PEL_CHECK_THROWS(lhs.at(3), std::length_error);
+    PEL_CHECK_THROWS(lhs.set(3, 0), std::length_error);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"versions_match_a_copied_vector", versions_match_a_copied_vector},
+      {"transients_edit_in_place", transients_edit_in_place},
+      {"nodes_are_freed_exactly_once", nodes_are_freed_exactly_once},
+      {"comparisons_and_errors", comparisons_and_errors},
+    });
+}
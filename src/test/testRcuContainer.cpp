@@ -0,0 +1,139 @@
+/**
+ * @file    container_base/src/test/testRcuContainer.cpp
+ */
+
+#include "src/epoch_domain.hpp"
+#include "src/rcu_container.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <atomic>
+#include <latch>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void
+read_after_publish_and_update()
+{
+    pel::rcu_container<std::vector<int>> container(std::make_unique<std::vector<int>>(3, 1));
+    PEL_CHECK(container.read()->size() == 3);
+
+    container.publish(std::make_unique<std::vector<int>>(5, 2));
+    PEL_CHECK(container.read([](const std::vector<int>& items_) { return items_.size(); }) == 5);
+
+    container.update([](std::vector<int>& items_) { items_.push_back(3); });
+    PEL_CHECK(container.read()->size() == 6);
+    PEL_CHECK(container.read()->back() == 3);
+
+    container.synchronize();
+    PEL_CHECK(container.retired_count() == 0);
+}
+
+void
+guard_keeps_old_version_alive()
+{
+    pel::rcu_container<std::vector<int>> container(std::make_unique<std::vector<int>>(1, 7));
+    {
+        auto guard = container.read();
+        container.publish(std::make_unique<std::vector<int>>(1, 8));
+        PEL_CHECK((*guard)[0] == 7);
+        PEL_CHECK(container.retired_count() == 1);
+    }
+    container.synchronize();
+    PEL_CHECK(container.retired_count() == 0);
+    PEL_CHECK(container.read()->front() == 8);
+}
+
+void
+readers_never_see_torn_versions()
+{
+    pel::rcu_container<std::vector<int>> container(std::make_unique<std::vector<int>>(100, 1));
+    std::atomic<bool>                    stop{false};
+    std::atomic<bool>                    torn{false};
+
+    std::vector<std::thread> readers;
+    for(int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&] {
+            while(!stop)
+            {
+                auto      guard = container.read();
+                const int first = guard->front();
+                for(int item : *guard)
+                {
+                    torn = torn || item != first;
+                }
+            }
+        });
+    }
+    for(int i = 2; i < 500; ++i)
+    {
+        if(i % 2 == 0)
+        {
+            container.publish(std::make_unique<std::vector<int>>(100, i));
+        }
+        else
+        {
+            container.update([i](std::vector<int>& items_) {
+                for(int& item : items_)
+                {
+                    item = i;
+                }
+            });
+        }
+    }
+    stop = true;
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    PEL_CHECK(!torn);
+    PEL_CHECK(container.read()->front() == 499);
+}
+
+void
+hundreds_of_concurrent_readers()
+{
+    constexpr int      readerCount = 300;
+    pel::epoch_domain& domain      = pel::epoch_domain::global();
+    std::latch         allInside(readerCount + 1);
+    std::latch         release(1);
+
+    std::vector<std::thread> readers;
+    for(int r = 0; r < readerCount; ++r)
+    {
+        readers.emplace_back([&] {
+            domain.enter();
+            allInside.count_down();
+            release.wait();
+            domain.leave();
+        });
+    }
+    allInside.arrive_and_wait();
+
+    const pel::epoch_domain::EpochType unlinked = domain.advance();
+    PEL_CHECK(domain.oldest_active() <= unlinked);
+
+    release.count_down();
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    PEL_CHECK(domain.oldest_active() == std::numeric_limits<pel::epoch_domain::EpochType>::max());
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"read_after_publish_and_update", read_after_publish_and_update},
+      {"guard_keeps_old_version_alive", guard_keeps_old_version_alive},
+      {"readers_never_see_torn_versions", readers_never_see_torn_versions},
+      {"hundreds_of_concurrent_readers", hundreds_of_concurrent_readers},
+    });
+}
@@ -0,0 +1,153 @@
+/**
+ * @file    container_base/src/test/testSegmentedVector.cpp
+ */
+
+#include "src/segmented_vector.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+/* Counts live instances, and throws on construction from a negative value */
+struct counted
+{
+    static inline int live = 0;
+
+    explicit counted(int value_) : value{value_}
+    {
+        if(value_ < 0)
+        {
+            throw std::runtime_error("negative");
+        }
+        ++live;
+    }
+    counted(counted&& other_) noexcept : value{other_.value} { ++live; }
+    counted(const counted&) = delete;
+    counted& operator=(const counted&) = delete;
+    counted& operator=(counted&&) = delete;
+    ~counted() { --live; }
+
+    int value = 0;
+};
+
+void
+push_and_access()
+{
+    pel::segmented_vector<std::string> vector;
+    for(int i = 0; i < 100; ++i)
+    {
+        vector.push_back(std::to_string(i));
+    }
+
+    PEL_CHECK(vector.length() == 100);
+    PEL_CHECK(vector.front() == "0");
+    PEL_CHECK(vector.back() == "99");
+    PEL_CHECK(vector[57] == "57");
+    PEL_CHECK_THROWS(vector.at(100), std::length_error);
+}
+
+void
+addresses_are_stable()
+{
+    pel::segmented_vector<int> vector;
+    const int*                 first = &vector.push_back(42);
+    for(int i = 0; i < 10'000; ++i)
+    {
+        vector.push_back(i);
+    }
+    PEL_CHECK(first == &vector.front());
+    PEL_CHECK(*first == 42);
+}
+
+void
+iteration_matches_segments()
+{
+    pel::segmented_vector<long> vector;
+    vector.reserve(1000);
+    for(long i = 0; i < 1000; ++i)
+    {
+        vector.push_back(i);
+    }
+
+    long iterated = 0;
+    for(long item : vector)
+    {
+        iterated += item;
+    }
+    long segmented = 0;
+    vector.for_each_segment([&](std::span<long> items_) {
+        for(long item : items_)
+        {
+            segmented += item;
+        }
+    });
+    PEL_CHECK(iterated == 999 * 1000 / 2);
+    PEL_CHECK(segmented == iterated);
+}
+
+void
+throwing_constructor_leaves_no_gap()
+{
+    {
+        pel::segmented_vector<counted> vector;
+        vector.emplace_back(1);
+        PEL_CHECK_THROWS(vector.emplace_back(-1), std::runtime_error);
+        vector.emplace_back(2);
+
+        PEL_CHECK(vector.length() == 2);
+        PEL_CHECK(vector[1].value == 2);
+        PEL_CHECK(counted::live == 2);
+    }
+    PEL_CHECK(counted::live == 0);
+}
+
+void
+concurrent_pushes()
+{
+    constexpr int               threadCount = 4;
+    constexpr long              count       = 20'000;
+    pel::segmented_vector<long> vector;
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&] {
+            for(long i = 0; i < count; ++i)
+            {
+                vector.push_back(i);
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    long sum = 0;
+    for(long item : vector)
+    {
+        sum += item;
+    }
+    PEL_CHECK(vector.length() == threadCount * count);
+    PEL_CHECK(sum == threadCount * count * (count - 1) / 2);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"push_and_access", push_and_access},
+      {"addresses_are_stable", addresses_are_stable},
+      {"iteration_matches_segments", iteration_matches_segments},
+      {"throwing_constructor_leaves_no_gap", throwing_constructor_leaves_no_gap},
+      {"concurrent_pushes", concurrent_pushes},
+    });
+}
@@ -0,0 +1,140 @@
+/**
+ * @file    container_base/src/test/testSlotMap.cpp
+ */
+
+#include "src/slot_map.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+void
+handles_survive_other_erasures()
+{
+    pel::slot_map<std::string>         map;
+    std::vector<pel::slot_handle>      handles;
+    std::map<std::size_t, std::string> expected;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        handles.push_back(map.insert(std::to_string(i)));
+        expected[i] = std::to_string(i);
+    }
+
+    std::mt19937 rng(1);
+    for(int step = 0; step < 700; ++step)
+    {
+        const std::size_t victim = rng() % handles.size();
+        PEL_CHECK(map.erase(handles[victim]) == (expected.erase(victim) == 1));
+    }
+
+    PEL_CHECK(map.length() == expected.size());
+    for(std::size_t i = 0; i < handles.size(); ++i)
+    {
+        const auto it = expected.find(i);
+        PEL_CHECK(map.contains(handles[i]) == (it != expected.end()));
+        PEL_CHECK(it == expected.end() || map.at(handles[i]) == it->second);
+        PEL_CHECK(it != expected.end() || map.get(handles[i]) == nullptr);
+    }
+}
+
+void
+reused_slots_reject_stale_handles()
+{
+    pel::slot_map<int>     map;
+    const pel::slot_handle first = map.insert(1);
+    PEL_CHECK(!map.contains(pel::slot_handle{}));
+
+    PEL_CHECK(map.erase(first));
+    PEL_CHECK(!map.erase(first));
+    const pel::slot_handle second = map.insert(2);
+
+    PEL_CHECK(second.index == first.index);
+    PEL_CHECK(second.generation != first.generation);
+    PEL_CHECK(!map.contains(first));
+    PEL_CHECK(map[second] == 2);
+    PEL_CHECK_THROWS(map.at(first), std::out_of_range);
+}
+
+void
+elements_stay_packed()
+{
+    pel::slot_map<int>            map;
+    std::vector<pel::slot_handle> handles;
+    for(int i = 0; i < 10; ++i)
+    {
+        handles.push_back(map.emplace(i));
+    }
+
+    /* The last element fills the hole */
+    auto it = map.erase(map.begin() + 2);
+    PEL_CHECK(*it == 9);
+    PEL_CHECK(map.length() == 9);
+    PEL_CHECK(map.handle_of(it) == handles[9]);
+    PEL_CHECK(map.handle_at(2) == handles[9]);
+    PEL_CHECK_THROWS(map.erase(map.end()), std::invalid_argument);
+    PEL_CHECK_THROWS(map.handle_at(9), std::length_error);
+
+    int sum = 0;
+    for(int value : map)
+    {
+        sum += value;
+    }
+    PEL_CHECK(sum == 45 - 2);
+}
+
+void
+clear_and_copies()
+{
+    pel::slot_map<std::string> map{"a", "b", "c"};
+    const pel::slot_handle     handle = map.handle_at(1);
+
+    pel::slot_map<std::string> copy = map;
+    PEL_CHECK(copy.at(handle) == "b");
+    copy.at(handle) = "changed";
+    PEL_CHECK(map.at(handle) == "b");
+
+    map.clear();
+    PEL_CHECK(map.is_empty() && !map.contains(handle));
+    PEL_CHECK(map.capacity() >= 3);
+    const pel::slot_handle reused = map.insert("d");
+    PEL_CHECK(!map.contains(handle) && map.contains(reused));
+
+    pel::slot_map<std::string> moved = std::move(copy);
+    PEL_CHECK(moved.at(handle) == "changed");
+    moved.shrink_to_fit();
+    PEL_CHECK(moved.capacity() == 3 && moved.at(handle) == "changed");
+}
+
+void
+emplace_may_refer_to_elements()
+{
+    pel::slot_map<std::string> map;
+    pel::slot_handle           handle = map.insert(std::string(40, 'x'));
+    for(int i = 0; i < 100; ++i)
+    {
+        /* Arguments into the map survive the buffer growing */
+        handle = map.emplace(map[handle]);
+    }
+    PEL_CHECK(map.length() == 101);
+    PEL_CHECK(map.at(handle) == std::string(40, 'x'));
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"handles_survive_other_erasures", handles_survive_other_erasures},
+      {"reused_slots_reject_stale_handles", reused_slots_reject_stale_handles},
+      {"elements_stay_packed", elements_stay_packed},
+      {"clear_and_copies", clear_and_copies},
+      {"emplace_may_refer_to_elements", emplace_may_refer_to_elements},
+    });
+}
@@ -0,0 +1,152 @@
+/**
+ * @file    container_base/src/test/testSoaContainer.cpp
+ */
+
+#include "src/soa_container.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace
+{
+struct particle
+{
+    float       x     = 0.0F;
+    float       y     = 0.0F;
+    std::string name;
+    int         scratch = 0;
+};
+}        // namespace
+
+/* scratch is left out: it is not stored */
+template<>
+struct pel::soa_fields<particle>
+{
+    static constexpr auto members = std::tuple{&particle::x, &particle::y, &particle::name};
+};
+
+namespace
+{
+using particle_container = pel::soa_container<particle>;
+
+void
+records_round_trip()
+{
+    particle_container container;
+    container.push_back(particle{1.0F, 2.0F, "first", 7});
+    container.emplace_back(3.0F, 4.0F, "second");
+
+    PEL_CHECK(container.length() == 2);
+    const particle first = container.get(0);
+    PEL_CHECK(first.x == 1.0F && first.y == 2.0F && first.name == "first");
+    PEL_CHECK(first.scratch == 0);
+
+    container[1] = particle{5.0F, 6.0F, "replaced", 0};
+    PEL_CHECK(container[1].get<&particle::name>() == "replaced");
+    PEL_CHECK(container.back().get<&particle::y>() == 6.0F);
+
+    container.set(0, particle{9.0F, 9.0F, "set", 0});
+    PEL_CHECK(static_cast<particle>(container.front()).name == "set");
+
+    PEL_CHECK_THROWS(container.at(2), std::length_error);
+    PEL_CHECK_THROWS(particle_container{}.front(), std::length_error);
+}
+
+void
+columns_are_contiguous_and_aligned()
+{
+    particle_container container;
+    for(int i = 0; i < 1000; ++i)
+    {
+        container.emplace_back(static_cast<float>(i), static_cast<float>(-i), std::to_string(i));
+    }
+
+    auto xs    = container.column<&particle::x>();
+    auto names = container.column<2>();
+    PEL_CHECK(xs.size() == 1000 && names.size() == 1000);
+    PEL_CHECK(reinterpret_cast<std::uintptr_t>(xs.data()) % particle_container::column_alignment
+              == 0);
+    PEL_CHECK(reinterpret_cast<std::uintptr_t>(names.data()) % particle_container::column_alignment
+              == 0);
+
+    float sum = 0.0F;
+    for(float x : xs)
+    {
+        sum += x;
+    }
+    PEL_CHECK(sum == 499500.0F);
+    PEL_CHECK(names[999] == "999");
+}
+
+void
+sorts_through_proxies()
+{
+    particle_container container{{3.0F, 0.0F, "c", 0}, {1.0F, 0.0F, "a", 0}, {2.0F, 0.0F, "b", 0}};
+    std::sort(container.begin(),
+              container.end(),
+              [](const particle& lhs_, const particle& rhs_) { return lhs_.x < rhs_.x; });
+
+    PEL_CHECK(container[0].get<&particle::name>() == "a");
+    PEL_CHECK(container[1].get<&particle::name>() == "b");
+    PEL_CHECK(container[2].get<&particle::name>() == "c");
+}
+
+void
+erase_resize_and_capacity()
+{
+    particle_container container(10);
+    PEL_CHECK(container.length() == 10 && container[9].get<&particle::x>() == 0.0F);
+
+    for(int i = 0; i < 10; ++i)
+    {
+        container[static_cast<std::size_t>(i)] = particle{static_cast<float>(i), 0.0F, "", 0};
+    }
+    auto next = container.erase(container.cbegin() + 3);
+    PEL_CHECK(container.length() == 9 && (*next).get<&particle::x>() == 4.0F);
+    PEL_CHECK_THROWS(container.erase(container.cend()), std::invalid_argument);
+
+    container.pop_back();
+    container.resize(4);
+    PEL_CHECK(container.length() == 4 && container.back().get<&particle::x>() == 4.0F);
+
+    container.reserve(100);
+    PEL_CHECK(container.capacity() >= 100 && container[0].get<&particle::x>() == 0.0F);
+    container.shrink_to_fit();
+    PEL_CHECK(container.capacity() == 4);
+
+    container.clear();
+    PEL_CHECK(container.is_empty());
+}
+
+void
+copies_are_independent()
+{
+    particle_container original{{1.0F, 1.0F, "one", 0}, {2.0F, 2.0F, "two", 0}};
+    particle_container copy = original;
+    PEL_CHECK(copy == original);
+
+    copy[0] = particle{1.0F, 1.0F, "changed", 0};
+    PEL_CHECK(copy != original);
+    PEL_CHECK(original[0].get<&particle::name>() == "one");
+
+    particle_container moved = std::move(copy);
+    PEL_CHECK(moved.length() == 2 && moved[0].get<&particle::name>() == "changed");
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"records_round_trip", records_round_trip},
+      {"columns_are_contiguous_and_aligned", columns_are_contiguous_and_aligned},
+      {"sorts_through_proxies", sorts_through_proxies},
+      {"erase_resize_and_capacity", erase_resize_and_capacity},
+      {"copies_are_independent", copies_are_independent},
+    });
+}
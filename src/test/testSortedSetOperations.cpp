@@ -0,0 +1,169 @@
+/**
+ * @file    container_base/src/test/testSortedSetOperations.cpp
+ */
+
+#include "src/cow_container.hpp"
+#include "src/sorted_set_operations.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+/* Sorted values drawn from the whole range of the type, so that signedness matters */
+template<typename ItemType>
+std::vector<ItemType>
+random_sorted(std::mt19937_64& rng_, std::size_t count_, bool unique_, std::uint64_t spread_)
+{
+    std::vector<ItemType> values;
+    for(std::size_t i = 0; i < count_; ++i)
+    {
+        const std::uint64_t draw = rng_() % spread_;
+        values.push_back(static_cast<ItemType>(
+          static_cast<std::uint64_t>(std::numeric_limits<ItemType>::min()) + draw * 4099));
+    }
+    std::ranges::sort(values);
+    if(unique_)
+    {
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+    return values;
+}
+
+template<typename ItemType>
+pel::cow_container<ItemType>
+make_container(const std::vector<ItemType>& values_)
+{
+    pel::cow_container<ItemType> container;
+    for(const ItemType& value : values_)
+    {
+        container.push_back(value);
+    }
+    return container;
+}
+
+template<typename ItemType>
+bool
+holds(const pel::cow_container<ItemType>& container_, const std::vector<ItemType>& expected_)
+{
+    return std::equal(container_.begin(), container_.end(), expected_.begin(), expected_.end());
+}
+
+template<typename ItemType>
+void
+check_operations()
+{
+    std::mt19937_64 rng(sizeof(ItemType));
+
+    /* Equal sizes for the block kernels, skewed ones for the runs and the galloping */
+    const std::vector<std::size_t> lhsCounts{0, 1, 3, 4, 5, 17, 300, 2000, 3, 20};
+    const std::vector<std::size_t> rhsCounts{9, 1, 4, 4, 7, 16, 280, 40, 1000, 5000};
+    for(std::size_t test = 0; test < lhsCounts.size(); ++test)
+    {
+        for(const std::uint64_t spread : {std::uint64_t{16}, std::uint64_t{4000}})
+        {
+            const auto lhsValues = random_sorted<ItemType>(rng, lhsCounts[test], true, spread);
+            const auto rhsValues = random_sorted<ItemType>(rng, rhsCounts[test], true, spread);
+            const pel::cow_container<ItemType> lhs = make_container(lhsValues);
+            const pel::cow_container<ItemType> rhs = make_container(rhsValues);
+
+            /* The destination starts with elements, which are discarded */
+            pel::cow_container<ItemType> destination{ItemType{1}, ItemType{2}};
+            std::vector<ItemType>        expected;
+
+            std::ranges::set_intersection(lhsValues, rhsValues, std::back_inserter(expected));
+            PEL_CHECK(pel::set_intersection(lhs, rhs, destination) == expected.size());
+            PEL_CHECK(holds(destination, expected));
+
+            expected.clear();
+            std::ranges::set_union(lhsValues, rhsValues, std::back_inserter(expected));
+            PEL_CHECK(pel::set_union(lhs, rhs, destination) == expected.size());
+            PEL_CHECK(holds(destination, expected));
+
+            expected.clear();
+            std::ranges::set_difference(lhsValues, rhsValues, std::back_inserter(expected));
+            PEL_CHECK(pel::set_difference(lhs, rhs, destination) == expected.size());
+            PEL_CHECK(holds(destination, expected));
+
+            expected.clear();
+            std::ranges::set_difference(rhsValues, lhsValues, std::back_inserter(expected));
+            PEL_CHECK(pel::set_difference(rhs, lhs, destination) == expected.size());
+            PEL_CHECK(holds(destination, expected));
+
+            /* Merge keeps the duplicates */
+            const auto lhsRun = random_sorted<ItemType>(rng, lhsCounts[test], false, spread);
+            const auto rhsRun = random_sorted<ItemType>(rng, rhsCounts[test], false, spread);
+            expected.clear();
+            std::ranges::merge(lhsRun, rhsRun, std::back_inserter(expected));
+            PEL_CHECK(pel::merge(make_container(lhsRun), make_container(rhsRun), destination)
+                      == expected.size());
+            PEL_CHECK(holds(destination, expected));
+        }
+    }
+}
+
+void
+operations_match_the_standard_algorithms()
+{
+    check_operations<std::int32_t>();
+    check_operations<std::uint32_t>();
+    check_operations<std::int64_t>();
+    check_operations<std::uint64_t>();
+    check_operations<std::int16_t>();
+}
+
+void
+extreme_values_compare_by_their_type()
+{
+    using limits = std::numeric_limits<std::uint32_t>;
+
+    const pel::cow_container<std::uint32_t> lhs{0, 1, 5, 0x7FFFFFFF, 0x80000000, limits::max()};
+    const pel::cow_container<std::uint32_t> rhs{1, 2, 0x80000000, 0x80000001, 0xFFFFFFF0,
+                                                limits::max()};
+    pel::cow_container<std::uint32_t>       destination;
+
+    PEL_CHECK(pel::set_intersection(lhs, rhs, destination) == 3);
+    PEL_CHECK(holds(destination, std::vector<std::uint32_t>{1, 0x80000000, limits::max()}));
+    PEL_CHECK(pel::set_union(lhs, rhs, destination) == 9);
+    PEL_CHECK(destination.back() == limits::max() && destination[3] == 5);
+    PEL_CHECK(pel::set_difference(lhs, rhs, destination) == 3);
+    PEL_CHECK(holds(destination, std::vector<std::uint32_t>{0, 5, 0x7FFFFFFF}));
+}
+
+void
+destination_cannot_be_an_operand()
+{
+    pel::cow_container<int>       lhs{1, 2, 3};
+    const pel::cow_container<int> rhs{2, 3, 4};
+
+    PEL_CHECK_THROWS(pel::set_intersection(lhs, rhs, lhs), std::invalid_argument);
+    PEL_CHECK_THROWS(pel::set_union(rhs, lhs, lhs), std::invalid_argument);
+    PEL_CHECK_THROWS(pel::merge(lhs, lhs, lhs), std::invalid_argument);
+    PEL_CHECK(lhs.to_string() == "[1, 2, 3]");
+
+    /* A copy shares the buffer but is another container, so it is written once unshared */
+    pel::cow_container<int> copy = lhs;
+    PEL_CHECK(pel::set_difference(lhs, rhs, copy) == 1);
+    PEL_CHECK(copy.to_string() == "[1]" && lhs.to_string() == "[1, 2, 3]");
+
+    const pel::cow_container<int> empty;
+    PEL_CHECK(pel::set_union(empty, empty, copy) == 0 && copy.is_empty());
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"operations_match_the_standard_algorithms", operations_match_the_standard_algorithms},
+      {"extreme_values_compare_by_their_type", extreme_values_compare_by_their_type},
+      {"destination_cannot_be_an_operand", destination_cannot_be_an_operand},
+    });
+}
@@ -0,0 +1,130 @@
+/**
+ * @file    container_base/src/test/testSparseSet.cpp
+ */
+
+#include "src/sparse_set.hpp"
+#include "src/sparse_vector.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+void
+set_matches_std_set()
+{
+    pel::sparse_set<>       set;
+    std::set<std::uint32_t> expected;
+    std::mt19937            rng(1);
+    for(int step = 0; step < 20000; ++step)
+    {
+        /* Keys clustered in a few pages, plus some anywhere in the 32-bit range */
+        const std::uint32_t key = step % 10 == 0 ? static_cast<std::uint32_t>(rng())
+                                                 : static_cast<std::uint32_t>(rng() % 20000);
+        if(rng() % 3 == 0)
+        {
+            PEL_CHECK(set.erase(key) == (expected.erase(key) == 1));
+        }
+        else
+        {
+            PEL_CHECK(set.insert(key) == expected.insert(key).second);
+        }
+    }
+
+    PEL_CHECK(set.length() == expected.size());
+    for(std::uint32_t key : set)
+    {
+        PEL_CHECK(expected.count(key) == 1);
+    }
+    for(std::uint32_t key = 0; key < 20000; ++key)
+    {
+        PEL_CHECK(set.contains(key) == (expected.count(key) == 1));
+    }
+}
+
+void
+highest_keys_take_little_memory()
+{
+    pel::sparse_set<> set;
+    PEL_CHECK(set.insert(0xFFFFFFFFU));
+    PEL_CHECK(set.insert(0));
+    PEL_CHECK(set.contains(0xFFFFFFFFU) && set.contains(0) && !set.contains(0xFFFFFFFEU));
+    PEL_CHECK(set.page_count() == 2);
+
+    /* Two pages and two directories, not a pointer per page up to the highest key */
+    PEL_CHECK(set.memory_bytes() < 128 * 1024);
+
+    PEL_CHECK(set.erase(0xFFFFFFFFU));
+    PEL_CHECK(set.erase(0));
+    PEL_CHECK(set.page_count() == 0);
+    PEL_CHECK(set.is_empty());
+}
+
+void
+pages_are_freed_with_their_last_key()
+{
+    pel::sparse_set<> set;
+    for(std::uint32_t key = 0; key < 3 * 4096; ++key)
+    {
+        PEL_CHECK(set.insert(key));
+    }
+    PEL_CHECK(set.page_count() == 3);
+
+    for(std::uint32_t key = 4096; key < 2 * 4096; ++key)
+    {
+        PEL_CHECK(set.erase(key));
+    }
+    PEL_CHECK(set.page_count() == 2);
+    PEL_CHECK(set.contains(4095) && !set.contains(4096) && set.contains(8192));
+
+    pel::sparse_set<> copy = set;
+    PEL_CHECK(copy.page_count() == 2 && copy.length() == 2 * 4096 && copy.contains(8192));
+    set.clear();
+    PEL_CHECK(set.page_count() == 0 && copy.contains(0));
+    PEL_CHECK_THROWS(copy.erase(copy.end()), std::invalid_argument);
+}
+
+void
+vector_maps_keys_to_values()
+{
+    pel::sparse_vector<std::string> vector;
+    PEL_CHECK(vector.insert(7, "seven").second);
+    PEL_CHECK(vector.emplace(0xFFFFFFFFU, std::size_t{3}, 'x').second);
+    PEL_CHECK(!vector.insert(7, "again").second);
+    PEL_CHECK(!vector.insert_or_assign(7, "replaced").second);
+
+    PEL_CHECK(vector.at_key(7) == "replaced");
+    const std::string* last = vector.get(0xFFFFFFFFU);
+    PEL_CHECK(last != nullptr && *last == "xxx");
+    PEL_CHECK(vector.get(8) == nullptr);
+    PEL_CHECK_THROWS(vector.at_key(8), std::out_of_range);
+    PEL_CHECK(vector.memory_bytes() < 128 * 1024);
+
+    /* The last element fills the hole, keys follow their values */
+    PEL_CHECK(vector.erase(7));
+    PEL_CHECK(vector.length() == 1 && vector.key_at(0) == 0xFFFFFFFFU);
+    PEL_CHECK(vector[0] == "xxx");
+    PEL_CHECK_THROWS(vector.key_at(1), std::length_error);
+
+    pel::sparse_vector<std::string> moved = std::move(vector);
+    PEL_CHECK(moved.at_key(0xFFFFFFFFU) == "xxx");
+    PEL_CHECK(vector.page_count() == 0);
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"set_matches_std_set", set_matches_std_set},
+      {"highest_keys_take_little_memory", highest_keys_take_little_memory},
+      {"pages_are_freed_with_their_last_key", pages_are_freed_with_their_last_key},
+      {"vector_maps_keys_to_values", vector_maps_keys_to_values},
+    });
+}
@@ -0,0 +1,118 @@
+/**
+ * @file    container_base/src/test/testSpscRingBuffer.cpp
+ */
+
+#include "src/spsc_ring_buffer.hpp"
+#include "src/test/testUtilities.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+void
+capacity_rounds_up()
+{
+    pel::spsc_ring_buffer<int> buffer(1000);
+    PEL_CHECK(buffer.capacity() == 1024);
+    PEL_CHECK(buffer.is_empty());
+    PEL_CHECK_THROWS(pel::spsc_ring_buffer<int>(0), std::invalid_argument);
+}
+
+void
+push_pop_in_order()
+{
+    pel::spsc_ring_buffer<int> buffer(4);
+    for(int i = 0; i < 4; ++i)
+    {
+        PEL_CHECK(buffer.try_push(i));
+    }
+    PEL_CHECK(buffer.is_full());
+    PEL_CHECK(!buffer.try_push(4));
+
+    int value = -1;
+    PEL_CHECK(buffer.try_pop(value) && value == 0);
+    PEL_CHECK(buffer.try_push(4));
+    for(int expected = 1; expected <= 4; ++expected)
+    {
+        PEL_CHECK(buffer.try_pop(value) && value == expected);
+    }
+    PEL_CHECK(!buffer.try_pop(value));
+}
+
+void
+spans_wrap_around()
+{
+    pel::spsc_ring_buffer<int> buffer(8);
+    for(int round = 0; round < 5; ++round)
+    {
+        int next = round * 6;
+        PEL_CHECK(buffer.push_n(6, [&](std::span<int> items_) {
+            for(int& item : items_)
+            {
+                item = next++;
+            }
+        }) == 6);
+
+        int expected = round * 6;
+        PEL_CHECK(buffer.pop_n(6, [&](std::span<int> items_) {
+            for(int item : items_)
+            {
+                PEL_CHECK(item == expected++);
+            }
+        }) == 6);
+    }
+    PEL_CHECK(buffer.is_empty());
+}
+
+void
+producer_consumer_threads()
+{
+    constexpr std::size_t              count = 200'000;
+    pel::spsc_ring_buffer<std::size_t> buffer(256);
+
+    std::thread producer([&] {
+        std::size_t next = 0;
+        while(next < count)
+        {
+            static_cast<void>(buffer.push_n(std::min<std::size_t>(37, count - next),
+                                            [&](std::span<std::size_t> items_) {
+                                                for(std::size_t& item : items_)
+                                                {
+                                                    item = next++;
+                                                }
+                                            }));
+        }
+    });
+
+    std::size_t expected = 0;
+    bool        inOrder  = true;
+    while(expected < count)
+    {
+        std::span<std::size_t> items = buffer.read_span(50);
+        for(std::size_t item : items)
+        {
+            inOrder = inOrder && item == expected++;
+        }
+        buffer.commit_read(items.size());
+    }
+    producer.join();
+
+    PEL_CHECK(inOrder);
+    PEL_CHECK(buffer.is_empty());
+}
+}        // namespace
+
+int
+main()
+{
+    return pel::test::run_tests({
+      {"capacity_rounds_up", capacity_rounds_up},
+      {"push_pop_in_order", push_pop_in_order},
+      {"spans_wrap_around", spans_wrap_around},
+      {"producer_consumer_threads", producer_consumer_threads},
+    });
+}
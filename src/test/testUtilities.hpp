@@ -0,0 +1,151 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <iostream>
+
+
+
+/*************************************************************************************************/
+/* Macros -------------------------------------------------------------------------------------- */
+
+/**
+ * \brief       Record a failure, with the expression and its location, if a condition is false.
+ */
+#define PEL_CHECK(condition_)                                                                     \
+    ::pel::test::check((condition_), #condition_, __FILE__, __LINE__)
+
+/**
+ * \brief       Record a failure if an expression does not throw an exception of a given type.
+ */
+#define PEL_CHECK_THROWS(expression_, exception_)                                                 \
+    do                                                                                            \
+    {                                                                                             \
+        bool threw = false;                                                                       \
+        try                                                                                       \
+        {                                                                                         \
+            [&]() -> decltype(auto) { return (expression_); }();                                   \
+        }                                                                                         \
+        catch(const exception_&)                                                                  \
+        {                                                                                         \
+            threw = true;                                                                         \
+        }                                                                                         \
+        ::pel::test::check(threw, #expression_ " throws " #exception_, __FILE__, __LINE__);       \
+    } while(false)
+
+
+
+namespace pel::test
+{
+/*************************************************************************************************/
+/* Types --------------------------------------------------------------------------------------- */
+
+/**
+ * \brief       Named test, run by run_tests().
+ */
+struct test_case
+{
+    const char* name;
+    void (*function)();
+};
+
+
+/*************************************************************************************************/
+/* Functions ----------------------------------------------------------------------------------- */
+
+/**
+ **************************************************************************************************
+ * \brief       Number of failed checks so far.
+ *************************************************************************************************/
+inline std::size_t&
+failure_count() noexcept
+{
+    static std::size_t failures = 0;
+    return failures;
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Record a failure if a condition is false. Used through PEL_CHECK.
+ *
+ * \param       condition_:  Result of the check.
+ * \param       expression_: Text of the checked expression.
+ * \param       file_:       File holding the check.
+ * \param       line_:       Line of the check.
+ *************************************************************************************************/
+inline void
+check(bool condition_, const char* expression_, const char* file_, int line_)
+{
+    if(!condition_)
+    {
+        ++failure_count();
+        std::cerr << file_ << ":" << line_ << ": check failed: " << expression_ << "\n";
+    }
+}
+
+
+/**
+ **************************************************************************************************
+ * \brief       Run every test, reporting failed checks and escaped exceptions.
+ *
+ * \param       tests_: Tests to run, in order.
+ * \retval      int:    Exit code of the test program, 0 when every check passed.
+ *************************************************************************************************/
+inline int
+run_tests(std::initializer_list<test_case> tests_)
+{
+    for(const test_case& test : tests_)
+    {
+        const std::size_t failuresBefore = failure_count();
+        try
+        {
+            test.function();
+        }
+        catch(const std::exception& exception)
+        {
+            ++failure_count();
+            std::cerr << test.name << ": unexpected exception: " << exception.what() << "\n";
+        }
+
+        std::cout << (failure_count() == failuresBefore ? "[ OK ] " : "[FAIL] ") << test.name
+                  << "\n";
+    }
+
+    return failure_count() == 0 ? 0 : 1;
+}
+
+
+}        // namespace pel::test
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/
@@ -0,0 +1,70 @@
+/**
+ * \file
+ * \author  Pascal-Emmanuel Lachance
+ * \p       https://www.github.com/Raesangur
+ * ------------------------------------------------------------------------------------------------
+ * MIT License
+ * Copyright (c) 2020 Pascal-Emmanuel Lachance | Ràësangür
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+
+/*************************************************************************************************/
+/* File includes ------------------------------------------------------------------------------- */
+#include <type_traits>
+
+
+
+namespace pel
+{
+/**
+ * \brief       Selects the argument type of the lookup functions of associative containers.
+ *
+ *              With transparent functors, lookups take whatever type they are called with and
+ *              hand it to the functors untouched; otherwise they take the container's key type,
+ *              converting the argument if needed. The alias resolves directly to the lookup type,
+ *              so that it can still be deduced from the call:
+ *
+ *                  template<typename LookupType = KeyType>
+ *                  IteratorType find(const transparent_key_t<IsTransparent, LookupType, KeyType>&);
+ */
+template<bool IsTransparent>
+struct transparent_key
+{
+    template<typename LookupType, typename KeyType>
+    using type = KeyType;
+};
+
+template<>
+struct transparent_key<true>
+{
+    template<typename LookupType, typename KeyType>
+    using type = LookupType;
+};
+
+template<bool IsTransparent, typename LookupType, typename KeyType>
+using transparent_key_t =
+  typename transparent_key<IsTransparent>::template type<LookupType, KeyType>;
+
+
+}        // namespace pel
+
+
+/*************************************************************************************************/
+/* END OF FILE --------------------------------------------------------------------------------- */
+/*************************************************************************************************/